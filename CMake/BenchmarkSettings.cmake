@@ -0,0 +1,32 @@
+# ############################################################################
+# BENCHMARK SETTINGS
+# ############################################################################
+
+# add the benchmark executable
+file(GLOB_RECURSE BENCHMARK_FILES   ${EMBEDDED_SYSTEM_SOURCE_DIR}/Tests/Benchmarks/*.c*
+                                    ${EMBEDDED_SYSTEM_SOURCE_DIR}/Tests/Benchmarks/*.h*
+)
+
+message(STATUS "BENCHMARK FILES -> ")
+
+foreach(file ${BENCHMARK_FILES})
+    message(STATUS ${file})
+endforeach()
+
+add_executable(benchmarks ${BENCHMARK_FILES})
+
+# link the benchmark executable with Google Benchmark and your project library
+target_link_libraries(benchmarks benchmark::benchmark benchmark::benchmark_main Embedded_System_Library)
+
+# Benchmarks are meaningless without optimization, keep them optimized in Debug builds as well
+target_compile_options(benchmarks PRIVATE -O2)
+
+# Run the benchmarks and keep the results as JSON, e.g. to compare two commits with
+# benchmark's tools/compare.py benchmarks <old.json> <new.json>
+set(BENCHMARK_RESULT_FILE ${CMAKE_BINARY_DIR}/benchmarks.json)
+add_custom_target(run_benchmarks
+    COMMAND benchmarks --benchmark_out=${BENCHMARK_RESULT_FILE} --benchmark_out_format=json
+    DEPENDS benchmarks
+    WORKING_DIRECTORY ${CMAKE_BINARY_DIR}
+    COMMENT "Running benchmarks, results in ${BENCHMARK_RESULT_FILE}"
+)
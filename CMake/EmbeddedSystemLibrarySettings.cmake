@@ -5,6 +5,12 @@
 # add the source files for your project
 file(GLOB_RECURSE SRC_FILES ${EMBEDDED_SYSTEM_SOURCE_DIR}/Library/*.c*
                             ${EMBEDDED_SYSTEM_SOURCE_DIR}/Library/*.h
+                            ${EMBEDDED_SYSTEM_SOURCE_DIR}/System/memoryPool.*
+                            ${EMBEDDED_SYSTEM_SOURCE_DIR}/System/metrics.*
+                            ${EMBEDDED_SYSTEM_SOURCE_DIR}/HAL/Common/*.c*
+                            ${EMBEDDED_SYSTEM_SOURCE_DIR}/HAL/Common/*.h*
+                            ${EMBEDDED_SYSTEM_SOURCE_DIR}/HAL/Platform/Linux/*.c*
+                            ${EMBEDDED_SYSTEM_SOURCE_DIR}/HAL/Platform/Linux/*.h*
                             # ${EMBEDDED_SYSTEM_SOURCE_DIR}/HAL/*.c*
                             # ${EMBEDDED_SYSTEM_SOURCE_DIR}/HAL/*.h
                             # ${EMBEDDED_SYSTEM_SOURCE_DIR}/Process/*.c* 
@@ -16,6 +22,14 @@ file(GLOB_RECURSE SRC_FILES ${EMBEDDED_SYSTEM_SOURCE_DIR}/Library/*.c*
                             )
 
 
+# Device code run on the host by the simKernel FreeRTOS shim (Library/Simulation/simFreeRTOS.h), the ESP-IDF and
+# FreeRTOS headers it includes are the fakes of Tests/Unit_Tests/Fake
+list(APPEND SRC_FILES   ${EMBEDDED_SYSTEM_SOURCE_DIR}/System/rtosObjects.cpp
+                        ${EMBEDDED_SYSTEM_SOURCE_DIR}/HAL/Platform/ESP32/io_gpio.cpp
+                        ${EMBEDDED_SYSTEM_SOURCE_DIR}/Process/Examples/Proc_Leds.cpp
+                        ${EMBEDDED_SYSTEM_SOURCE_DIR}/Process/Examples/Proc_Button.cpp
+)
+
 message(STATUS "EMBEDDED SYSTEM FILES -> ")
 foreach(file ${SRC_FILES})
 message(STATUS ${file})
@@ -28,3 +28,29 @@ FetchContent_Declare(
   SUBBUILD_DIR ${GTEST_SUBBUILD_DIR}
 )
 FetchContent_MakeAvailable(googletest)
+
+# #######################################################################################
+# Google Benchmark
+# #######################################################################################
+# Only the library is needed, its own tests would fetch a second googletest
+set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+
+# Set benchmark git tag as a variable
+set(BENCHMARK_GIT_TAG v1.8.3) # Replace with the release tag you want to use
+
+# Set the source and build directories
+set(BENCHMARK_SOURCE_DIR "${DEPENDENCIES_DIR}/benchmark-${BENCHMARK_GIT_TAG}-src")
+set(BENCHMARK_BINARY_DIR "${DEPENDENCIES_DIR}/benchmark-${BENCHMARK_GIT_TAG}-build")
+set(BENCHMARK_SUBBUILD_DIR "${DEPENDENCIES_DIR}/benchmark-${BENCHMARK_GIT_TAG}-subbuild")
+
+FetchContent_Declare(
+  benchmark
+  GIT_REPOSITORY https://github.com/google/benchmark.git
+  GIT_TAG ${BENCHMARK_GIT_TAG}
+  SOURCE_DIR ${BENCHMARK_SOURCE_DIR}
+  BINARY_DIR ${BENCHMARK_BINARY_DIR}
+  SUBBUILD_DIR ${BENCHMARK_SUBBUILD_DIR}
+)
+FetchContent_MakeAvailable(benchmark)
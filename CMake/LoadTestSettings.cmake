@@ -0,0 +1,19 @@
+# ############################################################################
+# LOAD TEST SETTINGS
+# ############################################################################
+
+# add the HTTP load harness executable
+file(GLOB_RECURSE LOAD_TEST_FILES   ${EMBEDDED_SYSTEM_SOURCE_DIR}/Tests/Load/*.c*
+                                    ${EMBEDDED_SYSTEM_SOURCE_DIR}/Tests/Load/*.h*
+)
+
+add_executable(http_load ${LOAD_TEST_FILES})
+
+# link the harness with your project library
+find_package(Threads REQUIRED)
+target_link_libraries(http_load Embedded_System_Library Threads::Threads)
+
+# Latency gates on the localhost server, a run exceeding them fails the test. The ceilings are generous so loaded
+# CI machines pass them: they catch stalls and lost requests, compare the printed percentiles between runs for regressions
+add_test(NAME http_load_welcome_keepalive COMMAND http_load --path /welcome --connections 16 --requests 20000 --max-p99-us 250000)
+add_test(NAME http_load_connect_close COMMAND http_load --method POST --path /connect --body "ssid=home&password=secret" --no-keepalive --requests 5000 --max-p99-us 500000)
@@ -0,0 +1,10 @@
+# ############################################################################
+# TOOL SETTINGS
+# ############################################################################
+
+# add the log store decoder, turns an image of the log partition back into text
+add_executable(log_decode ${EMBEDDED_SYSTEM_SOURCE_DIR}/Tools/logDecode.cpp)
+
+# link the tool with your project library
+find_package(Threads REQUIRED)
+target_link_libraries(log_decode Embedded_System_Library Threads::Threads)
@@ -0,0 +1,213 @@
+/**
+ * @file com_stream.cpp
+ * @brief Source file for com_stream
+ *
+ * This file contains definitions for the com_stream class and related data types and functions.
+ */
+
+#include "com_stream.hpp"
+
+namespace
+{
+// The half/full events split a ring in two, a single byte ring is rejected like any invalid size
+size_t streamRingSize(size_t size)
+{
+    return (size >= 2) ? size : 0;
+}
+} // namespace
+
+com_stream::com_stream(uint8_t* txStorage, size_t txSize, uint8_t* rxStorage, size_t rxSize)
+    : _txRing(txStorage, streamRingSize(txSize)), _rxRing(rxStorage, streamRingSize(rxSize)), _callback(nullptr), _callbackContext(nullptr), _rxReported(0), _rxStalled(false), _stats()
+{
+}
+
+com_stream::~com_stream()
+{
+    // destructor implementation
+}
+
+sys_error_t com_stream::sendData(const uint8_t* data, size_t length)
+{
+    if (data == nullptr && length > 0)
+    {
+        return ERROR_INVALID_ARG;
+    }
+    if (length > _txRing.capacity())
+    {
+        return ERROR_MESSAGE_TOO_LARGE;
+    }
+    if (length > _txRing.freeSpace())
+    {
+        return ERROR_BUSY;
+    }
+
+    _txRing.write(data, length);
+    kickTx();
+    return ERROR_SUCCESS;
+}
+
+sys_error_t com_stream::receiveData(uint8_t* data, size_t maxLength, size_t& receivedLength)
+{
+    if (data == nullptr && maxLength > 0)
+    {
+        return ERROR_INVALID_ARG;
+    }
+    receivedLength = _rxRing.read(data, maxLength);
+    if (receivedLength > 0)
+    {
+        rxFreed();
+    }
+    return ERROR_SUCCESS;
+}
+
+ringSpan_t com_stream::txAcquire()
+{
+    return _txRing.writeSpan();
+}
+
+sys_error_t com_stream::txCommit(size_t length)
+{
+    if (length > _txRing.freeSpace())
+    {
+        return ERROR_BUFFER_OVERFLOW;
+    }
+    _txRing.commit(length);
+    kickTx();
+    return ERROR_SUCCESS;
+}
+
+ringSpan_t com_stream::rxPeek()
+{
+    return _rxRing.readSpan();
+}
+
+void com_stream::rxRelease(size_t length)
+{
+    size_t available = _rxRing.size();
+    _rxRing.consume((length < available) ? length : available);
+    if (length > 0 && available > 0)
+    {
+        rxFreed();
+    }
+}
+
+void com_stream::setEventCallback(comEventCallback_t callback, void* context)
+{
+    _callbackContext = context;
+    _callback        = callback;
+}
+
+bool com_stream::isValid()
+{
+    return _txRing.isValid() && _rxRing.isValid();
+}
+
+size_t com_stream::rxAvailable()
+{
+    return _rxRing.size();
+}
+
+size_t com_stream::txFree()
+{
+    return _txRing.freeSpace();
+}
+
+comStats_t com_stream::getStats()
+{
+    return _stats;
+}
+
+ringSpan_t com_stream::rxDmaSpan()
+{
+    return _rxRing.writeSpan();
+}
+
+void com_stream::rxDmaComplete(size_t length)
+{
+    if (length == 0)
+    {
+        return;
+    }
+
+    size_t half   = _rxRing.capacity() / 2;
+    size_t before = _rxRing.writePosition();
+    _rxRing.commit(length);
+    size_t after = before + length;
+    _stats.rxBytes += length;
+
+    // Like the HT/TC interrupts of a circular DMA: report each time a half boundary is crossed
+    if (before / half != after / half)
+    {
+        _rxReported = after;
+        notify(((after / half) % 2 == 1) ? COM_EVENT_RX_HALF : COM_EVENT_RX_FULL);
+    }
+}
+
+void com_stream::rxIdle()
+{
+    size_t position = _rxRing.writePosition();
+    if (position != _rxReported)
+    {
+        _rxReported = position;
+        notify(COM_EVENT_RX_IDLE);
+    }
+}
+
+void com_stream::rxOverrun()
+{
+    _stats.rxOverruns++;
+    _rxStalled.store(true);
+    notify(COM_EVENT_RX_OVERRUN);
+}
+
+void com_stream::kickRx()
+{
+    kickTx();
+}
+
+void com_stream::rxFreed()
+{
+    // Without new input the engine is not woken by the port, the held back data would wait for the next byte
+    if (_rxStalled.exchange(false))
+    {
+        kickRx();
+    }
+}
+
+ringSpan_t com_stream::txDmaSpan()
+{
+    return _txRing.readSpan();
+}
+
+void com_stream::txDmaComplete(size_t length)
+{
+    if (length == 0)
+    {
+        return;
+    }
+
+    size_t half   = _txRing.capacity() / 2;
+    size_t before = _txRing.readPosition();
+    _txRing.consume(length);
+    size_t after = before + length;
+    _stats.txBytes += length;
+
+    if (_txRing.size() == 0)
+    {
+        notify(COM_EVENT_TX_DONE);
+    }
+    else if (before / half != after / half)
+    {
+        notify(COM_EVENT_TX_HALF);
+    }
+}
+
+void com_stream::notify(comEvent_t event)
+{
+    _stats.events++;
+    comEventCallback_t callback = _callback;
+    if (callback != nullptr)
+    {
+        callback(event, _callbackContext);
+    }
+}
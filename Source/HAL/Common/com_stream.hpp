@@ -0,0 +1,187 @@
+/**
+ * @file com_stream.hpp
+ * @brief Header file for com_stream
+ *
+ * This file contains declarations for the com_stream class and related data types and functions.
+ */
+
+#ifndef COM_STREAM_HPP
+#define COM_STREAM_HPP
+
+#include "HAL/IHal.h"
+#include "Library/Common/ringBuffer.h"
+#include <atomic>
+
+/**
+ * @brief Events reported by a com_stream
+ */
+typedef enum : uint8_t
+{
+    COM_EVENT_RX_HALF    = 0, // first half of the RX ring filled
+    COM_EVENT_RX_FULL    = 1, // second half of the RX ring filled
+    COM_EVENT_RX_IDLE    = 2, // line went idle with unreported data in the RX ring
+    COM_EVENT_RX_OVERRUN = 3, // RX ring full, incoming data is held back or lost
+    COM_EVENT_TX_HALF    = 4, // half of the TX ring drained, there is room to refill it
+    COM_EVENT_TX_DONE    = 5, // TX ring completely drained
+} comEvent_t;
+
+/**
+ * @brief Event callback, runs in the context of the port's transfer engine (ISR/DMA task or thread)
+ */
+typedef void (*comEventCallback_t)(comEvent_t event, void* context);
+
+/**
+ * @brief Transfer counters of a com_stream
+ */
+typedef struct
+{
+    uint32_t rxBytes;
+    uint32_t txBytes;
+    uint32_t rxOverruns;
+    uint32_t events;
+} comStats_t;
+
+/**
+ * @brief Streaming IHAL_COM base with lock-free TX/RX rings
+ *
+ * The application side and the transfer engine of the port (UART ISR/DMA task, host thread) only meet in
+ * two single producer / single consumer rings. Next to the copying sendData()/receiveData(), the rings are
+ * lent out directly: txAcquire()/txCommit() to build data in place and rxPeek()/rxRelease() to parse it in
+ * place. The engine fills the RX ring like a circular DMA buffer and raises half/full/idle events, so the
+ * application can process one half while the other one is being filled.
+ *
+ * Ports implement connect(), disconnect() and kickTx() and drive the protected engine methods. An engine that stops
+ * receiving on a full RX ring reports rxOverrun() and is woken through kickRx() once the application frees space.
+ */
+class com_stream : public IHAL_COM
+{
+private:
+    ringBuffer         _txRing;
+    ringBuffer         _rxRing;
+    comEventCallback_t _callback;
+    void*              _callbackContext;
+    size_t             _rxReported; // RX write position covered by the last RX event
+    std::atomic<bool>  _rxStalled;  // the engine left data in the port after an overrun
+    comStats_t         _stats;
+
+    void notify(comEvent_t event);
+    void rxFreed();
+
+protected:
+    /**
+     * @brief Free RX region the engine can receive into
+     */
+    ringSpan_t rxDmaSpan();
+
+    /**
+     * @brief Publish received bytes, raises COM_EVENT_RX_HALF/COM_EVENT_RX_FULL on half boundaries
+     */
+    void rxDmaComplete(size_t length);
+
+    /**
+     * @brief Line idle, raises COM_EVENT_RX_IDLE if data arrived since the last RX event
+     */
+    void rxIdle();
+
+    /**
+     * @brief RX ring is full while the line has more data, kickRx() follows once the application frees space
+     */
+    void rxOverrun();
+
+    /**
+     * @brief Pending TX region the engine can transmit from
+     */
+    ringSpan_t txDmaSpan();
+
+    /**
+     * @brief Release transmitted bytes, raises COM_EVENT_TX_HALF/COM_EVENT_TX_DONE
+     */
+    void txDmaComplete(size_t length);
+
+    /**
+     * @brief Tell the engine that new TX data is pending
+     */
+    virtual void kickTx() = 0;
+
+    /**
+     * @brief Tell the engine that RX space was freed after rxOverrun(), so it reads the data it held back
+     * The default wakes the engine like kickTx().
+     */
+    virtual void kickRx();
+
+public:
+    /**
+     * @brief Construct a new com_stream object
+     *
+     * @param txStorage - TX ring storage, owned by the caller
+     * @param txSize - TX ring size, power of two of at least 2, see isValid()
+     * @param rxStorage - RX ring storage, owned by the caller
+     * @param rxSize - RX ring size, power of two of at least 2, see isValid()
+     */
+    com_stream(uint8_t* txStorage, size_t txSize, uint8_t* rxStorage, size_t rxSize);
+    virtual ~com_stream();
+
+    /**
+     * @brief Queue data for transmission, all or nothing
+     *
+     * @return sys_error_t ERROR_BUSY if the TX ring has not enough room, ERROR_MESSAGE_TOO_LARGE if it never will
+     */
+    sys_error_t sendData(const uint8_t* data, size_t length) override;
+
+    /**
+     * @brief Copy received data, does not block
+     *
+     * @return sys_error_t receivedLength is 0 if nothing was received
+     */
+    sys_error_t receiveData(uint8_t* data, size_t maxLength, size_t& receivedLength) override;
+
+    /**
+     * @brief Lend the free contiguous TX region
+     *
+     * @return ringSpan_t
+     */
+    ringSpan_t txAcquire();
+
+    /**
+     * @brief Queue bytes written into the span returned by txAcquire()
+     *
+     * @param length - number of bytes written
+     * @return sys_error_t
+     */
+    sys_error_t txCommit(size_t length);
+
+    /**
+     * @brief Lend the contiguous received region
+     *
+     * @return ringSpan_t
+     */
+    ringSpan_t rxPeek();
+
+    /**
+     * @brief Release bytes of the span returned by rxPeek()
+     *
+     * @param length - number of processed bytes
+     */
+    void rxRelease(size_t length);
+
+    /**
+     * @brief Set the event callback
+     *
+     * @param callback - callback or nullptr
+     * @param context - passed to the callback
+     */
+    void setEventCallback(comEventCallback_t callback, void* context);
+
+    /**
+     * @brief Check the ring sizes given to the constructor, ports refuse to connect with invalid rings
+     *
+     * @return bool false if a ring size is not a power of two of at least 2
+     */
+    bool isValid();
+
+    size_t     rxAvailable();
+    size_t     txFree();
+    comStats_t getStats();
+};
+
+#endif /* COM_STREAM_HPP */
@@ -0,0 +1,84 @@
+/**
+ * @file io_mcp23017Port.cpp
+ * @brief Source file for io_mcp23017Port
+ *
+ * This file contains definitions for the io_mcp23017Port class and related data types and functions.
+ */
+
+#include "io_mcp23017Port.hpp"
+
+io_mcp23017Port::io_mcp23017Port(IHAL_I2C& bus, uint8_t address, uint16_t outputMask, uint16_t inputMask, bool pullUps)
+    : io_port(outputMask, inputMask), _bus(bus), _address(address), _pullUps(pullUps), _busErrors(0)
+{
+}
+
+io_mcp23017Port::~io_mcp23017Port()
+{
+    // destructor implementation
+}
+
+sys_error_t io_mcp23017Port::init()
+{
+    // Unused pins stay inputs, the power-on default
+    uint16_t directions = static_cast<uint16_t>(~getOutputMask());
+    uint16_t pullUps    = _pullUps ? static_cast<uint16_t>(getInputMask()) : 0;
+    uint8_t  iodir[]    = {MCP23017_IODIRA, static_cast<uint8_t>(directions), static_cast<uint8_t>(directions >> 8)};
+    uint8_t  gppu[]     = {MCP23017_GPPUA, static_cast<uint8_t>(pullUps), static_cast<uint8_t>(pullUps >> 8)};
+    uint8_t  latches[]  = {MCP23017_OLATA, 0, 0};
+
+    // Latches first, so the outputs come up low
+    RETURN_ON_ERROR(_bus.write(_address, latches, sizeof(latches)));
+    RETURN_ON_ERROR(_bus.write(_address, gppu, sizeof(gppu)));
+    RETURN_ON_ERROR(_bus.write(_address, iodir, sizeof(iodir)));
+    return ERROR_SUCCESS;
+}
+
+io_portMask_t io_mcp23017Port::readPins(io_portMask_t mask)
+{
+    uint8_t reg       = MCP23017_GPIOA;
+    uint8_t levels[2] = {};
+    if (_bus.writeRead(_address, &reg, 1, levels, sizeof(levels)) != ERROR_SUCCESS)
+    {
+        _busErrors++;
+        return getInputs(); // keep the last snapshot
+    }
+    return static_cast<io_portMask_t>(levels[0]) | (static_cast<io_portMask_t>(levels[1]) << 8);
+}
+
+sys_error_t io_mcp23017Port::writePins(io_portMask_t setBits, io_portMask_t clearBits, io_portMask_t levels)
+{
+    // Only the latches that change, still one transaction
+    io_portMask_t changed = setBits | clearBits;
+    uint8_t       data[3];
+    size_t        length;
+    if ((changed & 0xFF) == 0)
+    {
+        data[0] = MCP23017_OLATB;
+        data[1] = static_cast<uint8_t>(levels >> 8);
+        length  = 2;
+    }
+    else if ((changed & 0xFF00) == 0)
+    {
+        data[0] = MCP23017_OLATA;
+        data[1] = static_cast<uint8_t>(levels);
+        length  = 2;
+    }
+    else
+    {
+        data[0] = MCP23017_OLATA;
+        data[1] = static_cast<uint8_t>(levels);
+        data[2] = static_cast<uint8_t>(levels >> 8);
+        length  = 3;
+    }
+    sys_error_t error = _bus.write(_address, data, length);
+    if (error != ERROR_SUCCESS)
+    {
+        _busErrors++;
+    }
+    return error;
+}
+
+uint32_t io_mcp23017Port::getBusErrors()
+{
+    return _busErrors;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file io_mcp23017Port.hpp
+ * @brief Header file for io_mcp23017Port
+ *
+ * This file contains declarations for the io_mcp23017Port class and related data types and functions.
+ */
+
+#ifndef IO_MCP23017PORT_HPP
+#define IO_MCP23017PORT_HPP
+
+#include "io_port.hpp"
+
+#define MCP23017_PIN_COUNT 16
+
+/**
+ * @brief MCP23017 register addresses (IOCON.BANK = 0, sequential access)
+ */
+typedef enum : uint8_t
+{
+    MCP23017_IODIRA = 0x00,
+    MCP23017_IODIRB = 0x01,
+    MCP23017_GPPUA  = 0x0C,
+    MCP23017_GPPUB  = 0x0D,
+    MCP23017_GPIOA  = 0x12,
+    MCP23017_GPIOB  = 0x13,
+    MCP23017_OLATA  = 0x14,
+    MCP23017_OLATB  = 0x15,
+} mcp23017Register_t;
+
+/**
+ * @brief MCP23017 16-bit I2C GPIO expander as an io_port
+ * Bits 0-7 are GPA0-7, bits 8-15 GPB0-7. A read is one transaction of GPIOA/GPIOB, a write one transaction
+ * of the output latches that changed. Read once per scan and flush staged levels once per update cycle.
+ */
+class io_mcp23017Port : public io_port
+{
+private:
+    IHAL_I2C& _bus;
+    uint8_t   _address;
+    bool      _pullUps;
+    uint32_t  _busErrors;
+
+protected:
+    io_portMask_t readPins(io_portMask_t mask) override;
+    sys_error_t   writePins(io_portMask_t setBits, io_portMask_t clearBits, io_portMask_t levels) override;
+
+public:
+    /**
+     * @brief Construct a new io_mcp23017Port object
+     *
+     * @param bus - I2C bus of the expander
+     * @param address - 7-bit address, 0x20-0x27
+     * @param outputMask - output pins
+     * @param inputMask - input pins
+     * @param pullUps - enable the pull-ups of the inputs (default true, buttons to ground)
+     */
+    io_mcp23017Port(IHAL_I2C& bus, uint8_t address, uint16_t outputMask, uint16_t inputMask, bool pullUps = true);
+    ~io_mcp23017Port();
+
+    /**
+     * @brief Set the pin directions and pull-ups, clear the outputs
+     */
+    sys_error_t init() override;
+
+    uint32_t getBusErrors();
+};
+
+#endif /* IO_MCP23017PORT_HPP */
@@ -0,0 +1,91 @@
+/**
+ * @file io_pin.hpp
+ * @brief Header file for io_pin
+ *
+ * This file contains declarations for the io_pin class and related data types and functions.
+ */
+
+#ifndef IO_PIN_HPP
+#define IO_PIN_HPP
+
+#include "HAL/IHal.h"
+
+/**
+ * @brief Direction of a pin, fixed at compile time
+ */
+typedef enum : uint8_t
+{
+    IO_DIRECTION_INPUT = 0,
+    IO_DIRECTION_OUTPUT,
+} io_direction_t;
+
+/**
+ * @brief Statically dispatched pin (CRTP base)
+ *
+ * The platform class derives from io_pin<itself> and provides
+ *  - static constexpr io_direction_t direction
+ *  - static uint8_t readLevel()
+ *  - static void writeLevel(uint8_t level)
+ * with the pin number as a template parameter, so get()/set() inline down to a register access.
+ * Setting an input pin is a compile error instead of a runtime warning.
+ *
+ * @tparam Pin - the platform pin class
+ */
+template <typename Pin> class io_pin
+{
+public:
+    /**
+     * @brief Read the level of the pin
+     *
+     * @return uint8_t 0 or 1
+     */
+    static inline uint8_t get()
+    {
+        return Pin::readLevel();
+    }
+
+    /**
+     * @brief Drive the pin
+     *
+     * @param level - zero for low, anything else for high
+     */
+    static inline void set(uint8_t level)
+    {
+        static_assert(Pin::direction == IO_DIRECTION_OUTPUT, "io_pin: an input pin can not be set");
+        Pin::writeLevel((level != 0) ? 1 : 0);
+    }
+};
+
+/**
+ * @brief IHAL_IO adapter of a static pin, for code that picks its pins at runtime
+ * get() writes an int and set() reads an uint8_t, as io_gpio.
+ *
+ * @tparam Pin - the platform pin class
+ */
+template <typename Pin> class io_pinAdapter : public IHAL_IO
+{
+public:
+    void get(void* data) override
+    {
+        if (data != nullptr)
+        {
+            *reinterpret_cast<int*>(data) = Pin::readLevel();
+        }
+    }
+
+    sys_error_t set(void* data) override
+    {
+        if (data == nullptr)
+        {
+            return ERROR_NULL_POINTER;
+        }
+        if (Pin::direction != IO_DIRECTION_OUTPUT)
+        {
+            return ERROR_NOT_SUPPORTED;
+        }
+        Pin::writeLevel((*static_cast<uint8_t*>(data) != 0) ? 1 : 0);
+        return ERROR_SUCCESS;
+    }
+};
+
+#endif /* IO_PIN_HPP */
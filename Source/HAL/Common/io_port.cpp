@@ -0,0 +1,161 @@
+/**
+ * @file io_port.cpp
+ * @brief Source file for io_port
+ *
+ * This file contains definitions for the io_port class and related data types and functions.
+ */
+
+#include "io_port.hpp"
+
+io_port::io_port(io_portMask_t outputMask, io_portMask_t inputMask)
+    : _outputMask(outputMask), _inputMask(inputMask & ~outputMask), _outputs(0), _inputs(0), _stagedLevels(0), _staged(0), _stats()
+{
+}
+
+io_port::~io_port()
+{
+    // destructor implementation
+}
+
+sys_error_t io_port::init()
+{
+    return ERROR_SUCCESS;
+}
+
+sys_error_t io_port::apply(io_portMask_t levels, io_portMask_t mask)
+{
+    mask &= _outputMask;
+    _staged &= ~mask; // the newest level of a pin wins
+    io_portMask_t setBits   = mask & levels & ~_outputs;
+    io_portMask_t clearBits = mask & ~levels & _outputs;
+    if ((setBits | clearBits) == 0)
+    {
+        return ERROR_SUCCESS; // nothing changes, skip the access
+    }
+    _stats.writes++;
+    sys_error_t error = writePins(setBits, clearBits, (_outputs | setBits) & ~clearBits);
+    if (error != ERROR_SUCCESS)
+    {
+        // The pins may not have changed, keep them dirty for the next flush()
+        _stats.errors++;
+        stage(setBits | clearBits, levels);
+        return error;
+    }
+    _outputs = (_outputs | setBits) & ~clearBits;
+    return ERROR_SUCCESS;
+}
+
+sys_error_t io_port::set(io_portMask_t mask)
+{
+    return apply(~static_cast<io_portMask_t>(0), mask);
+}
+
+sys_error_t io_port::clear(io_portMask_t mask)
+{
+    return apply(0, mask);
+}
+
+sys_error_t io_port::toggle(io_portMask_t mask)
+{
+    return apply(~_outputs, mask);
+}
+
+sys_error_t io_port::write(io_portMask_t mask, io_portMask_t levels)
+{
+    return apply(levels, mask);
+}
+
+io_portMask_t io_port::read()
+{
+    if (_inputMask != 0)
+    {
+        _inputs = readPins(_inputMask) & _inputMask;
+        _stats.reads++;
+    }
+    return _inputs;
+}
+
+io_portMask_t io_port::getInputs()
+{
+    return _inputs;
+}
+
+io_portMask_t io_port::getOutputs()
+{
+    return _outputs;
+}
+
+void io_port::stage(io_portMask_t mask, io_portMask_t levels)
+{
+    mask &= _outputMask;
+    _stagedLevels = (_stagedLevels & ~mask) | (levels & mask);
+    _staged |= mask;
+}
+
+bool io_port::flush()
+{
+    uint32_t writes = _stats.writes;
+    return apply(_stagedLevels, _staged) == ERROR_SUCCESS && _stats.writes != writes;
+}
+
+io_portMask_t io_port::getOutputMask()
+{
+    return _outputMask;
+}
+
+io_portMask_t io_port::getInputMask()
+{
+    return _inputMask;
+}
+
+io_portStats_t io_port::getStats()
+{
+    return _stats;
+}
+
+void io_port::get(void* data)
+{
+    if (data != nullptr)
+    {
+        *static_cast<io_portMask_t*>(data) = read();
+    }
+}
+
+sys_error_t io_port::set(void* data)
+{
+    if (data == nullptr)
+    {
+        return ERROR_NULL_POINTER;
+    }
+    return apply(*static_cast<io_portMask_t*>(data), _outputMask);
+}
+
+io_portPin::io_portPin(io_port& port, uint8_t pin) : _port(port), _mask(IO_PORT_PIN(pin)) {}
+
+io_portPin::~io_portPin()
+{
+    // destructor implementation
+}
+
+void io_portPin::get(void* data)
+{
+    if (data != nullptr)
+    {
+        io_portMask_t levels          = ((_port.getOutputMask() & _mask) != 0) ? _port.getOutputs() : _port.getInputs();
+        *reinterpret_cast<int*>(data) = ((levels & _mask) != 0) ? 1 : 0;
+    }
+}
+
+sys_error_t io_portPin::set(void* data)
+{
+    if (data == nullptr)
+    {
+        return ERROR_NULL_POINTER;
+    }
+    if ((_port.getOutputMask() & _mask) == 0)
+    {
+        return ERROR_NOT_SUPPORTED;
+    }
+    _port.stage(_mask, (*static_cast<uint8_t*>(data) != 0) ? _mask : 0);
+    return ERROR_SUCCESS;
+}
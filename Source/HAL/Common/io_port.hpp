@@ -0,0 +1,174 @@
+/**
+ * @file io_port.hpp
+ * @brief Header file for io_port
+ *
+ * This file contains declarations for the io_port class and related data types and functions.
+ */
+
+#ifndef IO_PORT_HPP
+#define IO_PORT_HPP
+
+#include "HAL/IHal.h"
+
+/**
+ * @brief One bit per pin of a port, bit n is pin n of the backend
+ */
+typedef uint64_t io_portMask_t;
+
+#define IO_PORT_PIN(number) (static_cast<io_portMask_t>(1) << (number))
+
+/**
+ * @brief Backend accesses of a port
+ */
+typedef struct
+{
+    uint32_t reads;  // register reads / bus transactions for inputs
+    uint32_t writes; // register writes / bus transactions for outputs
+    uint32_t errors; // failed writes, their levels stay staged for the next flush()
+} io_portStats_t;
+
+/**
+ * @brief Group of pins read and written together with masks
+ *
+ * A port owns a set of output and input pins of one backend (native GPIO bank, host emulation, expander).
+ * set()/clear()/toggle()/write() change any number of owned outputs with a single backend write, read()
+ * takes a snapshot of all inputs with a single backend read. The port keeps the output levels itself,
+ * so toggling does not read the pins back.
+ *
+ * Writes can also be staged and coalesced with stage() and flushed once per update cycle with flush(),
+ * see io_portPin for the per-pin IHAL_IO view built on it. The output levels only change once the backend
+ * accepted the write; the levels of a failed write stay staged, so the next flush() retries them. A direct
+ * write replaces the staged levels of its pins.
+ *
+ * Through IHAL_IO the whole port is an io_portMask_t: get() reads the inputs, set() writes all outputs.
+ */
+class io_port : public IHAL_IO
+{
+private:
+    io_portMask_t  _outputMask;
+    io_portMask_t  _inputMask;
+    io_portMask_t  _outputs;      // levels driven on the outputs
+    io_portMask_t  _inputs;       // snapshot of the last read()
+    io_portMask_t  _stagedLevels; // levels of the staged outputs
+    io_portMask_t  _staged;       // outputs with a staged level
+    io_portStats_t _stats;
+
+    sys_error_t apply(io_portMask_t levels, io_portMask_t mask);
+
+protected:
+    /**
+     * @brief Read the levels of the pins in one access
+     *
+     * @param mask - pins of interest, the backend may skip registers without them
+     */
+    virtual io_portMask_t readPins(io_portMask_t mask) = 0;
+
+    /**
+     * @brief Drive pins in one access
+     *
+     * @param setBits - pins to drive high
+     * @param clearBits - pins to drive low, disjoint from setBits
+     * @param levels - all output levels after the write, for backends that write whole registers
+     * @return sys_error_t ERROR_SUCCESS once the pins are driven, the port keeps its output levels otherwise
+     */
+    virtual sys_error_t writePins(io_portMask_t setBits, io_portMask_t clearBits, io_portMask_t levels) = 0;
+
+public:
+    /**
+     * @brief Construct a new io_port object
+     *
+     * @param outputMask - pins driven by the port
+     * @param inputMask - pins read by the port
+     */
+    io_port(io_portMask_t outputMask, io_portMask_t inputMask);
+    virtual ~io_port();
+
+    // Delete copy constructor and assignment operator
+    io_port(const io_port&)            = delete;
+    io_port& operator=(const io_port&) = delete;
+
+    /**
+     * @brief Configure the pins of the port
+     */
+    virtual sys_error_t init();
+
+    /**
+     * @brief Drive the outputs in mask high
+     */
+    sys_error_t set(io_portMask_t mask);
+
+    /**
+     * @brief Drive the outputs in mask low
+     */
+    sys_error_t clear(io_portMask_t mask);
+
+    /**
+     * @brief Invert the outputs in mask
+     */
+    sys_error_t toggle(io_portMask_t mask);
+
+    /**
+     * @brief Drive the outputs in mask to the matching bits of levels
+     */
+    sys_error_t write(io_portMask_t mask, io_portMask_t levels);
+
+    /**
+     * @brief Take a snapshot of all inputs
+     *
+     * @return io_portMask_t input levels, zero for pins that are not inputs of the port
+     */
+    io_portMask_t read();
+
+    /**
+     * @brief Input levels of the last read(), without accessing the backend
+     */
+    io_portMask_t getInputs();
+
+    /**
+     * @brief Levels driven on the outputs, without staged levels
+     */
+    io_portMask_t getOutputs();
+
+    /**
+     * @brief Stage output levels, applied with the next flush()
+     *
+     * @param mask - outputs to change
+     * @param levels - their levels
+     */
+    void stage(io_portMask_t mask, io_portMask_t levels);
+
+    /**
+     * @brief Write the staged levels that differ from the outputs, in one access
+     *
+     * @return true if the backend was written, false if nothing changed or the write failed
+     */
+    bool flush();
+
+    io_portMask_t  getOutputMask();
+    io_portMask_t  getInputMask();
+    io_portStats_t getStats();
+
+    void        get(void* data) override;
+    sys_error_t set(void* data) override;
+};
+
+/**
+ * @brief A single pin of an io_port as IHAL_IO, to hand port pins to code written for io_gpio
+ * get() returns the level of the last io_port::read() for inputs and the driven level for outputs,
+ * set() stages the level until io_port::flush(). The owner of the port reads and flushes once per cycle.
+ */
+class io_portPin : public IHAL_IO
+{
+private:
+    io_port&      _port;
+    io_portMask_t _mask;
+
+public:
+    io_portPin(io_port& port, uint8_t pin);
+    ~io_portPin();
+
+    void        get(void* data) override;
+    sys_error_t set(void* data) override;
+};
+
+#endif /* IO_PORT_HPP */
@@ -0,0 +1,63 @@
+/**
+ * @file io_shiftRegisterPort.cpp
+ * @brief Source file for io_shiftRegisterPort
+ *
+ * This file contains definitions for the io_shiftRegisterPort class and related data types and functions.
+ */
+
+#include "io_shiftRegisterPort.hpp"
+
+namespace
+{
+size_t clampChain(size_t registers)
+{
+    return (registers > IO_SHIFT_REGISTER_MAX_CHAIN) ? IO_SHIFT_REGISTER_MAX_CHAIN : registers;
+}
+
+io_portMask_t chainMask(size_t registers)
+{
+    return (registers >= IO_SHIFT_REGISTER_MAX_CHAIN) ? ~static_cast<io_portMask_t>(0) : (IO_PORT_PIN(registers * 8) - 1);
+}
+} // namespace
+
+io_shiftRegisterPort::io_shiftRegisterPort(IHAL_SPI& bus, size_t registers)
+    : io_port(chainMask(clampChain(registers)), 0), _bus(bus), _registers(clampChain(registers)), _busErrors(0)
+{
+}
+
+io_shiftRegisterPort::~io_shiftRegisterPort()
+{
+    // destructor implementation
+}
+
+sys_error_t io_shiftRegisterPort::init()
+{
+    uint8_t chain[IO_SHIFT_REGISTER_MAX_CHAIN] = {};
+    return _bus.transfer(chain, nullptr, _registers);
+}
+
+io_portMask_t io_shiftRegisterPort::readPins(io_portMask_t mask)
+{
+    return 0; // output only
+}
+
+sys_error_t io_shiftRegisterPort::writePins(io_portMask_t setBits, io_portMask_t clearBits, io_portMask_t levels)
+{
+    // The first byte out travels to the far end of the chain
+    uint8_t chain[IO_SHIFT_REGISTER_MAX_CHAIN];
+    for (size_t i = 0; i < _registers; i++)
+    {
+        chain[_registers - 1 - i] = static_cast<uint8_t>(levels >> (i * 8));
+    }
+    sys_error_t error = _bus.transfer(chain, nullptr, _registers);
+    if (error != ERROR_SUCCESS)
+    {
+        _busErrors++;
+    }
+    return error;
+}
+
+uint32_t io_shiftRegisterPort::getBusErrors()
+{
+    return _busErrors;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file io_shiftRegisterPort.hpp
+ * @brief Header file for io_shiftRegisterPort
+ *
+ * This file contains declarations for the io_shiftRegisterPort class and related data types and functions.
+ */
+
+#ifndef IO_SHIFTREGISTERPORT_HPP
+#define IO_SHIFTREGISTERPORT_HPP
+
+#include "io_port.hpp"
+
+#define IO_SHIFT_REGISTER_MAX_CHAIN 8 // 64 outputs, the width of io_portMask_t
+
+/**
+ * @brief Chain of 74HC595-style shift registers as an output io_port
+ * The chain is on an SPI device whose chip select drives the latch (RCLK), so one transfer of the whole
+ * chain is one update of all outputs. Bit n of the port is output n%8 of register n/8, register 0 being
+ * the one wired to MOSI. Stage the levels and flush() once per update cycle to send the chain only once.
+ */
+class io_shiftRegisterPort : public io_port
+{
+private:
+    IHAL_SPI& _bus;
+    size_t    _registers;
+    uint32_t  _busErrors;
+
+protected:
+    io_portMask_t readPins(io_portMask_t mask) override;
+    sys_error_t   writePins(io_portMask_t setBits, io_portMask_t clearBits, io_portMask_t levels) override;
+
+public:
+    /**
+     * @brief Construct a new io_shiftRegisterPort object
+     *
+     * @param bus - SPI device of the chain
+     * @param registers - number of registers in the chain, at most IO_SHIFT_REGISTER_MAX_CHAIN
+     */
+    io_shiftRegisterPort(IHAL_SPI& bus, size_t registers);
+    ~io_shiftRegisterPort();
+
+    /**
+     * @brief Clear the whole chain
+     */
+    sys_error_t init() override;
+
+    uint32_t getBusErrors();
+};
+
+#endif /* IO_SHIFTREGISTERPORT_HPP */
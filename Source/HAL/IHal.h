@@ -11,9 +11,10 @@
 #ifndef FILE_IHAL_H
 #define FILE_IHAL_H
 
-#include "System/system.h"
-
 /** INCLUDES ******************************************************************/
+#include "System/error_definitions.h"
+#include <stddef.h>
+#include <stdint.h>
 
 /** CONSTANTS *****************************************************************/
 
@@ -91,6 +92,64 @@ public:
     virtual ~IHAL_COM() {}
 };
 
+/**
+ * @class IHAL_SPI
+ * @brief Interface for Hardware Abstraction Layer (HAL) SPI device operations.
+ */
+class IHAL_SPI
+{
+public:
+    /**
+     * @brief Run one transaction with the device, chip select is asserted for its whole length.
+     *
+     * @param txData Pointer to the data to be sent.
+     * @param rxData Pointer to the buffer for the received data, may be null.
+     * @param length The length of the transaction in bytes.
+     * @return sys_error_t The error code indicating the success or failure of the transaction.
+     */
+    virtual sys_error_t transfer(const uint8_t* txData, uint8_t* rxData, size_t length) = 0;
+
+    /**
+     * @brief Destructor for IHAL_SPI.
+     */
+    virtual ~IHAL_SPI() {}
+};
+
+/**
+ * @class IHAL_I2C
+ * @brief Interface for Hardware Abstraction Layer (HAL) I2C bus operations.
+ */
+class IHAL_I2C
+{
+public:
+    /**
+     * @brief Write to a device in one transaction.
+     *
+     * @param address The 7-bit device address.
+     * @param data Pointer to the data to be written.
+     * @param length The length of the data to be written.
+     * @return sys_error_t The error code indicating the success or failure of the transaction.
+     */
+    virtual sys_error_t write(uint8_t address, const uint8_t* data, size_t length) = 0;
+
+    /**
+     * @brief Write to a device and read its answer after a repeated start, in one transaction.
+     *
+     * @param address The 7-bit device address.
+     * @param txData Pointer to the data to be written, e.g. a register address.
+     * @param txLength The length of the data to be written.
+     * @param rxData Pointer to the buffer where the read data will be stored.
+     * @param rxLength The length of the data to be read.
+     * @return sys_error_t The error code indicating the success or failure of the transaction.
+     */
+    virtual sys_error_t writeRead(uint8_t address, const uint8_t* txData, size_t txLength, uint8_t* rxData, size_t rxLength) = 0;
+
+    /**
+     * @brief Destructor for IHAL_I2C.
+     */
+    virtual ~IHAL_I2C() {}
+};
+
 /**
  * @class IHAL_MEM
  * @brief Interface for Hardware Abstraction Layer (HAL) memory device operations.
@@ -132,6 +191,21 @@ public:
      */
     virtual bool erase() = 0;
 
+    /**
+     * @brief Erase the sector containing the given address (if applicable).
+     *
+     * @param address Any memory address inside the sector to erase.
+     * @return bool True if erase operation was successful, false otherwise.
+     */
+    virtual bool eraseSector(uint32_t address) = 0;
+
+    /**
+     * @brief Get the erase granularity of the memory device.
+     *
+     * @return size_t The sector size in bytes.
+     */
+    virtual size_t getSectorSize() = 0;
+
     /**
      * @brief Get the total size of the memory device.
      *
@@ -1,14 +1,40 @@
 #ifndef LOGIMPL_H
 #define LOGIMPL_H
 
+#include "Library/Storage/logStore.h"
 #include "System/ILog.h"
+#include "System/rtosObjects.h"
 #include "esp_log.h"
 #include <iostream>
 
+#define LOG_FLUSH_PERIOD_MS  2000 // records wait at most this long in RAM before they reach the log store
+#define LOG_FLUSH_STACK_SIZE 3072
+
 class logImpl : public ILog
 {
 private:
     const char* _tag;
+    logStore*   _store  = nullptr;
+    ILog*       _remote = nullptr;
+    rtosTimer   _flushTimer;
+
+    rtosTask<LOG_FLUSH_STACK_SIZE> _flushTask;
+
+    // Runs in the timer service task, which must not wait for flash: only wake the flush task
+    static void flushCallback(TimerHandle_t timer)
+    {
+        static_cast<logImpl*>(pvTimerGetTimerID(timer))->_flushTask.notify();
+    }
+
+    static void flushTask(void* arg)
+    {
+        logImpl& log = *static_cast<logImpl*>(arg);
+        for (;;)
+        {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            log._store->flush();
+        }
+    }
 
 public:
     // Delete copy constructor and assignment operator
@@ -32,6 +58,11 @@ public:
     void logInfo(const std::string& message) override
     {
         ESP_LOGI(_tag, "%s", message.c_str());
+        ILog* remote = __atomic_load_n(&_remote, __ATOMIC_ACQUIRE);
+        if (remote != nullptr)
+        {
+            remote->logInfo(message);
+        }
     }
 
     /**
@@ -42,6 +73,11 @@ public:
     void logWarning(const std::string& message) override
     {
         ESP_LOGW(_tag, "%s", message.c_str());
+        ILog* remote = __atomic_load_n(&_remote, __ATOMIC_ACQUIRE);
+        if (remote != nullptr)
+        {
+            remote->logWarning(message);
+        }
     }
 
     /**
@@ -52,19 +88,107 @@ public:
     void logError(const std::string& message) override
     {
         ESP_LOGE(_tag, "%s", message.c_str());
+        ILog* remote = __atomic_load_n(&_remote, __ATOMIC_ACQUIRE);
+        if (remote != nullptr)
+        {
+            remote->logError(message);
+        }
     }
 
+    /**
+     * @brief Logs a message to the console without copying it into a std::string.
+     *
+     * @param level The severity level of the message.
+     * @param message The message text, not null terminated.
+     * @param length The message length.
+     */
+    void log(LogLevel level, const char* message, size_t length) override
+    {
+        int printed = static_cast<int>(length);
+        switch (level)
+        {
+            case LogLevel::INFO:
+                ESP_LOGI(_tag, "%.*s", printed, message);
+                break;
+            case LogLevel::WARNING:
+                ESP_LOGW(_tag, "%.*s", printed, message);
+                break;
+            case LogLevel::ERROR:
+                ESP_LOGE(_tag, "%.*s", printed, message);
+                break;
+        }
+        ILog* remote = __atomic_load_n(&_remote, __ATOMIC_ACQUIRE);
+        if (remote != nullptr)
+        {
+            remote->log(level, message, length);
+        }
+    }
+
+    /**
+     * @brief Copy the console messages to a second sink, e.g. a syslogSink
+     *
+     * @param remote - the sink, must not block; nullptr to stop copying
+     */
+    void setRemote(ILog* remote)
+    {
+        __atomic_store_n(&_remote, remote, __ATOMIC_RELEASE);
+    }
+
+    /**
+     * @brief Keep the records of logToFile() in a log store
+     * A periodic timer wakes a background band task that flushes the store, so the flash erases and writes never
+     * run in the timer service task. A full block is written right away.
+     *
+     * @param store - mounted log store, must outlive the logger
+     * @return sys_error_t ERROR_OUT_OF_MEMORY if the flush task or timer could not be created
+     */
+    sys_error_t setStore(logStore* store)
+    {
+        _store = store;
+        if (_flushTask.getHandle() == NULL && _flushTask.create(flushTask, "log_flush", this, taskBandPriority(TASK_BAND_BACKGROUND)) != ERROR_SUCCESS)
+        {
+            return ERROR_OUT_OF_MEMORY;
+        }
+        if (_flushTimer.getHandle() == NULL && _flushTimer.create("log_flush", pdMS_TO_TICKS(LOG_FLUSH_PERIOD_MS), true, static_cast<void*>(this), flushCallback) == NULL)
+        {
+            return ERROR_OUT_OF_MEMORY;
+        }
+        xTimerStart(_flushTimer.getHandle(), portMAX_DELAY);
+        return ERROR_SUCCESS;
+    }
+
+    /**
+     * @brief Adds a record to the log store, decoded on the host with log_decode.
+     *
+     * @param filename Name of the log stream, stored as the tag of the record.
+     * @param level The severity level of the message.
+     * @param message The message to log.
+     */
     void logToFile(const std::string& filename, LogLevel level, const std::string& message) override
     {
-        ESP_LOGE(_tag, "LOG-TO-FILE Feature Not Implemented");
+        if (_store == nullptr)
+        {
+            ESP_LOGW(_tag, "No log store set, %s: %s", filename.c_str(), message.c_str());
+            return;
+        }
+        if (_store->logText(static_cast<uint8_t>(level), filename.c_str(), message.data(), message.size()) != ERROR_SUCCESS)
+        {
+            ESP_LOGW(_tag, "Log store write failed");
+        }
     }
 };
 
+// The logger implementation, e.g. to set its log store. Inline so every translation unit shares one instance.
+inline logImpl& loggerImpl()
+{
+    static logImpl logEsp("APP");
+    return logEsp;
+}
+
 // Public method to get the Singleton instance
-static LogHandler& logger()
+inline LogHandler& logger()
 {
-    static logImpl    logEsp("APP");
-    static LogHandler handler(&logEsp);
+    static LogHandler handler(&loggerImpl());
     return handler;
 }
 
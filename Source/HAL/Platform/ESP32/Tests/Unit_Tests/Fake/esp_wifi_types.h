@@ -11,6 +11,12 @@ typedef enum {
     WIFI_MODE_MAX,
 } wifi_mode_t;
 
+typedef enum {
+    WIFI_PS_NONE,
+    WIFI_PS_MIN_MODEM,
+    WIFI_PS_MAX_MODEM,
+} wifi_ps_type_t;
+
 typedef struct {
     uint8_t mac[6];
 } wifi_sta_info_t;
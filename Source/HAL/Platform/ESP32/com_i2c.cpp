@@ -0,0 +1,71 @@
+/**
+ * @file com_i2c.cpp
+ * @brief Source file for com_i2c
+ *
+ * This file contains definitions for the com_i2c class and related data types and functions.
+ */
+
+#include "com_i2c.hpp"
+#include "esp_log.h"
+
+#define TAG "I2C"
+
+namespace
+{
+sys_error_t toError(esp_err_t result)
+{
+    switch (result)
+    {
+        case ESP_OK:
+            return ERROR_SUCCESS;
+        case ESP_ERR_TIMEOUT:
+            return ERROR_TIMEOUT;
+        case ESP_FAIL: // no acknowledge
+            return ERROR_DEVICE_UNRESPONSIVE;
+        default:
+            return ERROR_TRANSMIT_FAILED;
+    }
+}
+} // namespace
+
+com_i2c::com_i2c(i2c_port_t port, int sdaPin, int sclPin, uint32_t clockHz, uint32_t timeoutMs)
+    : _port(port), _sdaPin(sdaPin), _sclPin(sclPin), _clockHz(clockHz), _timeout(pdMS_TO_TICKS(timeoutMs)), _installed(false)
+{
+}
+
+com_i2c::~com_i2c()
+{
+    if (_installed)
+    {
+        i2c_driver_delete(_port);
+    }
+}
+
+sys_error_t com_i2c::init()
+{
+    i2c_config_t config     = {};
+    config.mode             = I2C_MODE_MASTER;
+    config.sda_io_num       = _sdaPin;
+    config.scl_io_num       = _sclPin;
+    config.sda_pullup_en    = GPIO_PULLUP_ENABLE;
+    config.scl_pullup_en    = GPIO_PULLUP_ENABLE;
+    config.master.clk_speed = _clockHz;
+
+    if (i2c_param_config(_port, &config) != ESP_OK || i2c_driver_install(_port, I2C_MODE_MASTER, 0, 0, 0) != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Driver install failed!");
+        return ERROR_INIT_FAILED;
+    }
+    _installed = true;
+    return ERROR_SUCCESS;
+}
+
+sys_error_t com_i2c::write(uint8_t address, const uint8_t* data, size_t length)
+{
+    return toError(i2c_master_write_to_device(_port, address, data, length, _timeout));
+}
+
+sys_error_t com_i2c::writeRead(uint8_t address, const uint8_t* txData, size_t txLength, uint8_t* rxData, size_t rxLength)
+{
+    return toError(i2c_master_write_read_device(_port, address, txData, txLength, rxData, rxLength, _timeout));
+}
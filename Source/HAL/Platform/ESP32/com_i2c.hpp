@@ -0,0 +1,47 @@
+/**
+ * @file com_i2c.hpp
+ * @brief Header file for com_i2c
+ *
+ * This file contains declarations for the com_i2c class and related data types and functions.
+ */
+
+#ifndef COM_I2C_HPP
+#define COM_I2C_HPP
+
+#include "HAL/IHal.h"
+#include "System/system.h"
+#include "driver/i2c.h"
+
+/**
+ * @brief I2C master bus
+ * Each write()/writeRead() is one transaction with a single start and stop condition.
+ */
+class com_i2c : public IHAL_I2C
+{
+private:
+    i2c_port_t _port;
+    int        _sdaPin;
+    int        _sclPin;
+    uint32_t   _clockHz;
+    TickType_t _timeout;
+    bool       _installed;
+
+public:
+    /**
+     * @brief Construct a new com_i2c object
+     *
+     * @param port - I2C peripheral
+     * @param sdaPin - SDA gpio
+     * @param sclPin - SCL gpio
+     * @param clockHz - clock frequency (default 400 kHz)
+     * @param timeoutMs - transaction timeout (default 10 ms)
+     */
+    com_i2c(i2c_port_t port, int sdaPin, int sclPin, uint32_t clockHz = 400000, uint32_t timeoutMs = 10);
+    ~com_i2c();
+
+    sys_error_t init();
+    sys_error_t write(uint8_t address, const uint8_t* data, size_t length) override;
+    sys_error_t writeRead(uint8_t address, const uint8_t* txData, size_t txLength, uint8_t* rxData, size_t rxLength) override;
+};
+
+#endif /* COM_I2C_HPP */
@@ -0,0 +1,60 @@
+/**
+ * @file com_spi.cpp
+ * @brief Source file for com_spi
+ *
+ * This file contains definitions for the com_spi class and related data types and functions.
+ */
+
+#include "com_spi.hpp"
+#include "esp_log.h"
+
+#define TAG "SPI"
+
+com_spi::com_spi(spi_host_device_t host, const spi_bus_config_t& busConfig, int csPin, int clockHz)
+    : _host(host), _busConfig(busConfig), _csPin(csPin), _clockHz(clockHz), _device(NULL)
+{
+}
+
+com_spi::~com_spi()
+{
+    if (_device != NULL)
+    {
+        spi_bus_remove_device(_device);
+    }
+}
+
+sys_error_t com_spi::init()
+{
+    // Another device may have set up the bus already
+    esp_err_t result = spi_bus_initialize(_host, &_busConfig, SPI_DMA_DISABLED);
+    if (result != ESP_OK && result != ESP_ERR_INVALID_STATE)
+    {
+        ESP_LOGE(TAG, "Bus init failed!");
+        return ERROR_INIT_FAILED;
+    }
+
+    spi_device_interface_config_t device = {};
+    device.clock_speed_hz                = _clockHz;
+    device.mode                          = 0;
+    device.spics_io_num                  = _csPin;
+    device.queue_size                    = 1;
+    if (spi_bus_add_device(_host, &device, &_device) != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Adding the device failed!");
+        return ERROR_INIT_FAILED;
+    }
+    return ERROR_SUCCESS;
+}
+
+sys_error_t com_spi::transfer(const uint8_t* txData, uint8_t* rxData, size_t length)
+{
+    if (_device == NULL)
+    {
+        return ERROR_INIT_FAILED;
+    }
+    spi_transaction_t transaction = {};
+    transaction.length            = length * 8;
+    transaction.tx_buffer         = txData;
+    transaction.rx_buffer         = rxData;
+    return (spi_device_polling_transmit(_device, &transaction) == ESP_OK) ? ERROR_SUCCESS : ERROR_TRANSMIT_FAILED;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file com_spi.hpp
+ * @brief Header file for com_spi
+ *
+ * This file contains declarations for the com_spi class and related data types and functions.
+ */
+
+#ifndef COM_SPI_HPP
+#define COM_SPI_HPP
+
+#include "HAL/IHal.h"
+#include "System/system.h"
+#include "driver/spi_master.h"
+
+/**
+ * @brief Device on an SPI master bus
+ * The bus is initialized by the first device on it. Transfers are polled, the transactions of expanders
+ * and displays are a few bytes long and an interrupt round trip costs more than the transfer.
+ */
+class com_spi : public IHAL_SPI
+{
+private:
+    spi_host_device_t   _host;
+    spi_bus_config_t    _busConfig;
+    int                 _csPin;
+    int                 _clockHz;
+    spi_device_handle_t _device;
+
+public:
+    /**
+     * @brief Construct a new com_spi object
+     *
+     * @param host - SPI peripheral
+     * @param busConfig - bus pins
+     * @param csPin - chip select gpio, the latch of a shift register chain
+     * @param clockHz - clock frequency
+     */
+    com_spi(spi_host_device_t host, const spi_bus_config_t& busConfig, int csPin, int clockHz);
+    ~com_spi();
+
+    sys_error_t init();
+    sys_error_t transfer(const uint8_t* txData, uint8_t* rxData, size_t length) override;
+};
+
+#endif /* COM_SPI_HPP */
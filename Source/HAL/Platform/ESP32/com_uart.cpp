@@ -0,0 +1,167 @@
+/**
+ * @file com_uart.cpp
+ * @brief Source file for com_uart
+ *
+ * This file contains definitions for the com_uart class and related data types and functions.
+ */
+
+#include "com_uart.hpp"
+#include "esp_log.h"
+
+#define TAG "UART"
+
+namespace
+{
+constexpr int uartDriverBufferSize = 512; // driver stage in front of the RX/TX rings, must exceed the 128 byte FIFO
+constexpr int uartEventQueueSize   = 16;
+constexpr int uartRxTimeoutSymbols = 2; // idle after two character times without data
+} // namespace
+
+com_uart::com_uart(uart_port_t port, const uart_config_t& config, int txPin, int rxPin, uint8_t* txStorage, size_t txSize, uint8_t* rxStorage, size_t rxSize, uint8_t taskPriority)
+    : com_stream(txStorage, txSize, rxStorage, rxSize), _port(port), _config(config), _txPin(txPin), _rxPin(rxPin), _eventQueue(NULL), _taskPriority(taskPriority),
+      _rxPending(0), _rxIdlePending(false)
+{
+}
+
+com_uart::~com_uart()
+{
+    disconnect();
+}
+
+sys_error_t com_uart::connect()
+{
+    if (_task.getHandle() != NULL)
+    {
+        return ERROR_SUCCESS;
+    }
+    if (!isValid())
+    {
+        return ERROR_INVALID_CONFIG;
+    }
+
+    if (uart_driver_install(_port, uartDriverBufferSize, uartDriverBufferSize, uartEventQueueSize, &_eventQueue, 0) != ESP_OK)
+    {
+        ESP_LOGE(TAG, "UART driver install failed!");
+        return ERROR_INIT_FAILED;
+    }
+    if (uart_param_config(_port, &_config) != ESP_OK || uart_set_pin(_port, _txPin, _rxPin, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK ||
+        uart_set_rx_timeout(_port, uartRxTimeoutSymbols) != ESP_OK)
+    {
+        uart_driver_delete(_port);
+        return ERROR_INVALID_CONFIG;
+    }
+
+    _rxPending         = 0;
+    _rxIdlePending     = false;
+    sys_error_t result = _task.create(uartEngineTask, "uart_engine_task", static_cast<void*>(this), _taskPriority);
+    if (result != ERROR_SUCCESS)
+    {
+        uart_driver_delete(_port);
+    }
+    return result;
+}
+
+sys_error_t com_uart::disconnect()
+{
+    if (_task.getHandle() != NULL)
+    {
+        _task.remove();
+        uart_driver_delete(_port);
+        _eventQueue = NULL;
+    }
+    return ERROR_SUCCESS;
+}
+
+void com_uart::kickTx()
+{
+    // Wake the engine through its own event queue, UART_EVENT_MAX is never sent by the driver
+    uart_event_t kick = {};
+    kick.type         = UART_EVENT_MAX;
+    if (_eventQueue != NULL)
+    {
+        xQueueSend(_eventQueue, &kick, 0);
+    }
+}
+
+void com_uart::readDriver()
+{
+    // Read from the driver straight into the RX ring, no intermediate buffer
+    while (_rxPending > 0)
+    {
+        ringSpan_t span = rxDmaSpan();
+        if (span.length == 0)
+        {
+            // Left in the driver buffer, kickRx() wakes the engine once the application catches up
+            rxOverrun();
+            span = rxDmaSpan(); // drained before the overrun was flagged
+            if (span.length == 0)
+            {
+                return;
+            }
+        }
+        int received = uart_read_bytes(_port, span.data, (span.length < _rxPending) ? span.length : _rxPending, 0);
+        if (received <= 0)
+        {
+            _rxPending = 0; // the driver has less than it announced
+            break;
+        }
+        rxDmaComplete(received);
+        _rxPending -= received;
+    }
+    if (_rxIdlePending)
+    {
+        _rxIdlePending = false;
+        rxIdle();
+    }
+}
+
+void com_uart::uartEngineTask(void* arg)
+{
+    com_uart&    uart = *static_cast<com_uart*>(arg);
+    uart_event_t event;
+
+    for (;;)
+    {
+        if (xQueueReceive(uart._eventQueue, &event, portMAX_DELAY) != pdTRUE)
+        {
+            continue;
+        }
+
+        switch (event.type)
+        {
+            case UART_DATA:
+                uart._rxPending += event.size;
+                uart._rxIdlePending |= event.timeout_flag;
+                uart.readDriver();
+                break;
+
+            case UART_FIFO_OVF:
+            case UART_BUFFER_FULL:
+                ESP_LOGW(TAG, "UART RX overflow, input flushed");
+                uart.rxOverrun();
+                uart_flush_input(uart._port);
+                xQueueReset(uart._eventQueue);
+                uart._rxPending     = 0;
+                uart._rxIdlePending = false;
+                break;
+
+            default:
+                // Kick from kickTx()/kickRx(): retry the bytes held back by a full RX ring
+                uart.readDriver();
+                break;
+        }
+
+        // Hand the pending TX region to the driver
+        ringSpan_t span = uart.txDmaSpan();
+        while (span.length > 0)
+        {
+            int sent = uart_write_bytes(uart._port, span.data, span.length);
+            if (sent <= 0)
+            {
+                break;
+            }
+            uart.txDmaComplete(sent);
+            span = uart.txDmaSpan();
+        }
+    }
+}
@@ -0,0 +1,63 @@
+/**
+ * @file com_uart.hpp
+ * @brief Header file for com_uart
+ *
+ * This file contains declarations for the com_uart class and related data types and functions.
+ */
+
+#ifndef COM_UART_HPP
+#define COM_UART_HPP
+
+#include "HAL/Common/com_stream.hpp"
+#include "System/rtosObjects.h"
+#include "System/system.h"
+#include "driver/uart.h"
+
+#define COM_UART_STACK_SIZE 3072 // stack of the engine task
+
+/**
+ * @brief UART port on the lock-free com_stream rings
+ * A task serves the driver event queue: it reads straight into the RX ring and raises the half/full/idle
+ * events (idle comes from the UART RX timeout), and drains the TX ring into the driver. Bytes that do not fit a full
+ * RX ring stay in the driver buffer and are read once the application frees space (kickRx()).
+ */
+class com_uart : public com_stream
+{
+private:
+    uart_port_t   _port;
+    uart_config_t _config;
+    int           _txPin;
+    int           _rxPin;
+    QueueHandle_t _eventQueue;
+    uint8_t       _taskPriority;
+    size_t        _rxPending;     // bytes announced by the driver and not read yet, engine task only
+    bool          _rxIdlePending; // the line went idle while bytes were held back
+
+    rtosTask<COM_UART_STACK_SIZE> _task;
+
+    void        kickTx() override;
+    void        readDriver();
+    static void uartEngineTask(void* arg);
+
+public:
+    /**
+     * @brief Construct a new com_uart object
+     *
+     * @param port - UART port number
+     * @param config - UART configuration (baud rate, framing)
+     * @param txPin - TX gpio number
+     * @param rxPin - RX gpio number
+     * @param txStorage - TX ring storage, owned by the caller
+     * @param txSize - TX ring size, power of two
+     * @param rxStorage - RX ring storage, owned by the caller
+     * @param rxSize - RX ring size, power of two
+     * @param taskPriority - engine task priority (default 12)
+     */
+    com_uart(uart_port_t port, const uart_config_t& config, int txPin, int rxPin, uint8_t* txStorage, size_t txSize, uint8_t* rxStorage, size_t rxSize, uint8_t taskPriority = 12);
+    ~com_uart();
+
+    sys_error_t connect() override;
+    sys_error_t disconnect() override;
+};
+
+#endif /* COM_UART_HPP */
@@ -8,20 +8,43 @@
 #include "cpx_wifi.h"
 
 #include "esp_mac.h"
+#include "esp_timer.h"
 #include "esp_netif.h"
 #include "esp_system.h"
 #include "esp_wifi.h"
 #include <iostream>
-#include <sstream>
 #include <string>
 
 #include "HAL/Platform/ESP32/Library/logImpl.h"
-#include "Library/Common/helperConversions.h"
+#include "Library/Common/textFormat.h"
+#include "Library/Diagnostics/flightRecorder.h"
+#include "Library/Diagnostics/trace.h"
+#include "System/metrics.h"
 
 static void wifi_event_handler(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data);
 static void ip_event_handler(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data);
 
-cpx_wifi::cpx_wifi(void* config) : _wifiMode(WIFI_MODE_NULL) {}
+namespace
+{
+// Radio settings indexed by wifiPowerProfile_t
+const wifiPowerSettings_t powerSettings[] = {
+    {WIFI_PS_NONE, 1, 80},       // WIFI_POWER_LOW_LATENCY: 20 dBm
+    {WIFI_PS_MIN_MODEM, 3, 78},  // WIFI_POWER_BALANCED: 19.5 dBm, IDF default listen interval
+    {WIFI_PS_MAX_MODEM, 10, 60}, // WIFI_POWER_BATTERY: 15 dBm, wake up every 10th beacon
+};
+
+const uint64_t beaconIntervalUs = 102400; // 100 TU, the usual AP beacon interval
+
+metricCounter wifiConnections("wifi_connections_total", "Station connections to the AP, reconnections included");
+metricCounter wifiDisconnections("wifi_disconnections_total", "Station disconnections from the AP");
+metricGauge   wifiConnected("wifi_connected", "1 while the station is connected to the AP");
+metricCounter wifiLowLatencyRequests("wifi_low_latency_requests_total", "Low-latency boosts requested");
+} // namespace
+
+cpx_wifi::cpx_wifi(void* config)
+    : _wifiMode(WIFI_MODE_NULL), _powerProfile(WIFI_POWER_BALANCED), _lowLatencyRequests(0), _started(false), _wakePeriod(0), _wakePeriodStart(0), _wakeupsBefore(0)
+{
+}
 
 cpx_wifi::~cpx_wifi()
 {
@@ -37,9 +60,7 @@ sys_error_t cpx_wifi::start()
         {
             ESP_ERROR_CHECK(wifiInit());
             ESP_ERROR_CHECK(wifiStart());
-            std::stringstream ss;
-            ss << "WiFi Started!" << std::endl;
-            logger().log(ILog::LogLevel::WARNING, ss.str());
+            logger().log(ILog::LogLevel::WARNING, "WiFi Started!");
             return ERROR_SUCCESS;
         }
         break;
@@ -70,14 +91,141 @@ void cpx_wifi::set(void* data)
 sys_error_t cpx_wifi::stop()
 {
     ESP_ERROR_CHECK(esp_wifi_stop());
+    _started = false;
+    setWakePeriod(0);
     return ERROR_SUCCESS;
 }
 
+uint64_t cpx_wifi::getNextDeadline(uint64_t nowUs)
+{
+    if (!_started)
+    {
+        return POWER_NO_DEADLINE;
+    }
+    if (_wakePeriod == 0)
+    {
+        return nowUs; // the radio keeps the CPU awake
+    }
+    return _wakePeriodStart + (periodWakeups(nowUs) + 1) * _wakePeriod;
+}
+
+uint32_t cpx_wifi::getWakeups(uint64_t nowUs)
+{
+    return _wakeupsBefore + periodWakeups(nowUs);
+}
+
 void cpx_wifi::setWifiMode(wifi_mode_t mode)
 {
     _wifiMode = mode;
 }
 
+sys_error_t cpx_wifi::setPowerProfile(wifiPowerProfile_t profile)
+{
+    if (profile > WIFI_POWER_BATTERY)
+    {
+        return ERROR_INVALID_ARG;
+    }
+    _powerProfile = profile;
+
+    if (!_started)
+    {
+        return ERROR_SUCCESS; // applied by wifiStart()
+    }
+
+    if (esp_wifi_set_max_tx_power(powerSettings[_powerProfile].maxTxPower) != ESP_OK)
+    {
+        logger().log(ILog::LogLevel::WARNING, "WiFi TX power could not be set!");
+    }
+
+    // An active low-latency boost keeps the radio on until it is released
+    if (_lowLatencyRequests.load() > 0)
+    {
+        return ERROR_SUCCESS;
+    }
+    return applyPowerSave(powerSettings[_powerProfile].psType);
+}
+
+wifiPowerProfile_t cpx_wifi::getPowerProfile()
+{
+    return _powerProfile;
+}
+
+sys_error_t cpx_wifi::requestLowLatency()
+{
+    wifiLowLatencyRequests.inc();
+    if (_lowLatencyRequests.fetch_add(1) == 0)
+    {
+        return applyPowerSave(WIFI_PS_NONE);
+    }
+    return ERROR_SUCCESS;
+}
+
+sys_error_t cpx_wifi::releaseLowLatency()
+{
+    uint32_t requests = _lowLatencyRequests.load();
+    do
+    {
+        if (requests == 0)
+        {
+            return ERROR_INVALID_ARG; // unbalanced release
+        }
+    } while (!_lowLatencyRequests.compare_exchange_weak(requests, requests - 1));
+
+    if (requests == 1)
+    {
+        return applyPowerSave(powerSettings[_powerProfile].psType);
+    }
+    return ERROR_SUCCESS;
+}
+
+sys_error_t cpx_wifi::applyPowerSave(wifi_ps_type_t psType)
+{
+    TRACE_SCOPE(WIFI_POWER_SAVE, psType);
+    // Modem sleep is a station feature, the soft-AP always keeps the radio on
+    if (!_started || _wifiMode != WIFI_MODE_STA)
+    {
+        return ERROR_SUCCESS;
+    }
+
+    if (esp_wifi_set_ps(psType) != ESP_OK)
+    {
+        logger().log(ILog::LogLevel::ERROR, "WiFi power save could not be set!");
+        return ERROR_FAIL;
+    }
+
+    switch (psType)
+    {
+        case WIFI_PS_MIN_MODEM:
+            setWakePeriod(beaconIntervalUs);
+            break;
+        case WIFI_PS_MAX_MODEM:
+            setWakePeriod(beaconIntervalUs * powerSettings[_powerProfile].listenInterval);
+            break;
+        default:
+            setWakePeriod(0);
+            break;
+    }
+    return ERROR_SUCCESS;
+}
+
+void cpx_wifi::setWakePeriod(uint64_t period)
+{
+    uint64_t now = esp_timer_get_time();
+    _wakeupsBefore += periodWakeups(now);
+
+    _wakePeriod      = period;
+    _wakePeriodStart = now;
+}
+
+uint32_t cpx_wifi::periodWakeups(uint64_t nowUs)
+{
+    if (_wakePeriod == 0 || nowUs < _wakePeriodStart)
+    {
+        return 0;
+    }
+    return static_cast<uint32_t>((nowUs - _wakePeriodStart) / _wakePeriod);
+}
+
 sys_error_t cpx_wifi::wifiInit()
 {
     // Initialize TCP/IP Stack
@@ -90,18 +238,16 @@ sys_error_t cpx_wifi::wifiInit()
     {
         case WIFI_MODE_STA:
         {
-            std::stringstream ss;
-            ss << "WIFI SOFT STA Initializing...!" << std::endl << "SSID: " << _wifiConfig.sta.ssid << std::endl << "PASSWORD: " << _wifiConfig.sta.password << std::endl;
-            logger().log(ILog::LogLevel::INFO, ss.str());
+            logger().logFormat(ILog::LogLevel::INFO, "WIFI SOFT STA Initializing...!\nSSID: {}\nPASSWORD: {}\n", reinterpret_cast<const char*>(_wifiConfig.sta.ssid),
+                               reinterpret_cast<const char*>(_wifiConfig.sta.password));
             esp_netif_create_default_wifi_sta();
         }
         break;
 
         case WIFI_MODE_AP:
         {
-            std::stringstream ss;
-            ss << "WIFI SOFT AP Initializing... " << std::endl << "SSID: " << _wifiConfig.ap.ssid << std::endl << "PASSWORD: " << _wifiConfig.ap.password << std::endl;
-            logger().log(ILog::LogLevel::INFO, ss.str());
+            logger().logFormat(ILog::LogLevel::INFO, "WIFI SOFT AP Initializing... \nSSID: {}\nPASSWORD: {}\n", reinterpret_cast<const char*>(_wifiConfig.ap.ssid),
+                               reinterpret_cast<const char*>(_wifiConfig.ap.password));
             esp_netif_create_default_wifi_ap();
         }
         break;
@@ -129,9 +275,12 @@ sys_error_t cpx_wifi::wifiInit()
 
 sys_error_t cpx_wifi::wifiStart()
 {
+    const wifiPowerSettings_t& power = powerSettings[_powerProfile];
+
     ESP_ERROR_CHECK(esp_wifi_set_mode(_wifiMode));
     if (_wifiMode == WIFI_MODE_STA)
     {
+        _wifiConfig.sta.listen_interval = power.listenInterval;
         ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &_wifiConfig));
         ESP_ERROR_CHECK(esp_wifi_start());
         ESP_ERROR_CHECK(esp_wifi_connect());
@@ -141,11 +290,18 @@ sys_error_t cpx_wifi::wifiStart()
         ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_AP, &_wifiConfig));
         ESP_ERROR_CHECK(esp_wifi_start());
     }
-    return ERROR_SUCCESS;
+    _started = true;
+
+    // TX power can only be set once the radio is started
+    ESP_ERROR_CHECK(esp_wifi_set_max_tx_power(power.maxTxPower));
+    return applyPowerSave(_lowLatencyRequests.load() > 0 ? WIFI_PS_NONE : power.psType);
 }
 
 static void wifi_event_handler(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data)
 {
+    TRACE_SCOPE(WIFI_EVENT, event_id);
+    uint32_t reason = (event_id == WIFI_EVENT_STA_DISCONNECTED) ? static_cast<wifi_event_sta_disconnected_t*>(event_data)->reason : 0;
+    flight().record(FLIGHT_WIFI, static_cast<uint16_t>(event_id), reason, "wifi");
 
     switch (event_id)
     {
@@ -180,12 +336,16 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base, int32_t e
         case WIFI_EVENT_STA_CONNECTED: /**< Station connected to AP */
         {
             std::cout << "WIFI_EVENT_STA_CONNECTED: " << std::endl;
+            wifiConnections.inc();
+            wifiConnected.set(1);
         }
         break;
 
         case WIFI_EVENT_STA_DISCONNECTED: /**< Station disconnected from AP */
         {
             std::cout << "WIFI_EVENT_STA_DISCONNECTED: " << std::endl;
+            wifiDisconnections.inc();
+            wifiConnected.set(0);
         }
         break;
 
@@ -215,9 +375,9 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base, int32_t e
             std::cout << "WIFI_EVENT_AP_STACONNECTED: " << std::endl;
             wifi_event_ap_staconnected_t* event = (wifi_event_ap_staconnected_t*)event_data;
 
-            std::stringstream ss;
-            ss << "Station " << mac::convertToMac(event->mac) << std::uppercase << " join, AID= " << event->aid;
-            std::cout << ss.str() << std::endl;
+            format::fixedString<64> text;
+            format::formatTo(text, "Station {} join, AID= {}", format::mac(event->mac), event->aid);
+            std::cout << text.c_str() << std::endl;
         }
         break;
 
@@ -226,9 +386,9 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base, int32_t e
             std::cout << "WIFI_EVENT_AP_STADISCONNECTED: " << std::endl;
             wifi_event_ap_stadisconnected_t* event = (wifi_event_ap_stadisconnected_t*)event_data;
 
-            std::stringstream ss;
-            ss << "Station " << mac::convertToMac(event->mac) << std::uppercase << " leave, AID= " << event->aid;
-            std::cout << ss.str() << std::endl;
+            format::fixedString<64> text;
+            format::formatTo(text, "Station {} leave, AID= {}", format::mac(event->mac), event->aid);
+            std::cout << text.c_str() << std::endl;
         }
         break;
 
@@ -253,6 +413,9 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base, int32_t e
 
 static void ip_event_handler(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data)
 {
+    TRACE_SCOPE(WIFI_IP_EVENT, event_id);
+    uint32_t address = (event_id == IP_EVENT_STA_GOT_IP) ? static_cast<ip_event_got_ip_t*>(event_data)->ip_info.ip.addr : 0;
+    flight().record(FLIGHT_WIFI, static_cast<uint16_t>(event_id), address, "ip");
 
     switch (event_id)
     {
@@ -262,11 +425,10 @@ static void ip_event_handler(void* arg, esp_event_base_t event_base, int32_t eve
 
             std::cout << "IP_EVENT_STA_GOT_IP: " << std::endl;
 
-            char ipString[20];
-            sprintf(ipString, IPSTR, IP2STR(&event->ip_info.ip));
-            std::stringstream ss;
-            ss << "IP: " << std::string(ipString);
-            std::cout << ss.str() << std::endl;
+            // addr holds the address in network order, most significant byte first in memory
+            format::fixedString<4 + FORMAT_IPV4_SIZE> text;
+            format::formatTo(text, "IP: {}", format::ipv4(reinterpret_cast<const uint8_t*>(&event->ip_info.ip.addr)));
+            std::cout << text.c_str() << std::endl;
         }
         break;
 
@@ -9,21 +9,58 @@
 #define CPX_WIFI_HPP
 
 #include "HAL/IHal.h"
+#include "Library/Power/powerManager.h"
 #include "System/error_definitions.h"
 #include "esp_wifi_types.h"
+#include <atomic>
 #include <string>
 
-class cpx_wifi : public IHAL_CPX
+/**
+ * @brief Wi-Fi power profiles
+ */
+typedef enum : uint8_t
+{
+    WIFI_POWER_LOW_LATENCY = 0, // No power save, radio always on
+    WIFI_POWER_BALANCED    = 1, // Minimum modem sleep, wakes up every DTIM
+    WIFI_POWER_BATTERY     = 2, // Maximum modem sleep with a longer listen interval
+} wifiPowerProfile_t;
+
+/**
+ * @brief Radio settings applied for a power profile
+ */
+typedef struct
+{
+    wifi_ps_type_t psType;         // Modem sleep type
+    uint16_t       listenInterval; // Listen interval in AP beacon intervals (used in WIFI_PS_MAX_MODEM)
+    int8_t         maxTxPower;     // Maximum TX power in 0.25 dBm units
+} wifiPowerSettings_t;
+
+/**
+ * @brief Wi-Fi driver
+ * As a power client it reports the radio wakeups of modem sleep: every DTIM beacon (assumed every beacon) with
+ * minimum modem sleep, every listen interval with maximum modem sleep. Without modem sleep the radio keeps the
+ * CPU awake and the deadline is always now. The wakeups are estimated from these periods.
+ */
+class cpx_wifi : public IHAL_CPX, public IPowerClient
 {
 private:
-    std::string   _ssid;
-    std::string   _password;
-    wifi_mode_t   _wifiMode;
-    wifi_config_t _wifiConfig;
+    std::string           _ssid;
+    std::string           _password;
+    wifi_mode_t           _wifiMode;
+    wifi_config_t         _wifiConfig;
+    wifiPowerProfile_t    _powerProfile;
+    std::atomic<uint32_t> _lowLatencyRequests;
+    bool                  _started;
+    uint64_t              _wakePeriod;      // us between radio wakeups, 0 while the radio stays on
+    uint64_t              _wakePeriodStart; // us since boot
+    uint32_t              _wakeupsBefore;   // wakeups of the previous power save settings
 
 private:
     sys_error_t wifiInit();
     sys_error_t wifiStart();
+    sys_error_t applyPowerSave(wifi_ps_type_t psType);
+    void        setWakePeriod(uint64_t period);
+    uint32_t    periodWakeups(uint64_t nowUs);
 
 public:
     cpx_wifi(void* config);
@@ -37,6 +74,10 @@ public:
 
     sys_error_t stop() override;
 
+    uint64_t getNextDeadline(uint64_t nowUs) override;
+
+    uint32_t getWakeups(uint64_t nowUs) override;
+
 public:
     /**
      * @brief Set the Wifi Mode object
@@ -44,6 +85,40 @@ public:
      * @param mode
      */
     void setWifiMode(wifi_mode_t mode);
+
+    /**
+     * @brief Set the power profile
+     * Can be called before or after start(). While started, power save and TX power
+     * are applied immediately, the listen interval takes effect on the next association.
+     *
+     * @param profile
+     * @return sys_error_t
+     */
+    sys_error_t setPowerProfile(wifiPowerProfile_t profile);
+
+    /**
+     * @brief Get the power profile
+     *
+     * @return wifiPowerProfile_t
+     */
+    wifiPowerProfile_t getPowerProfile();
+
+    /**
+     * @brief Request a temporary low-latency boost
+     * Power save is disabled until every request is released by releaseLowLatency().
+     * Requests are reference counted, so each caller can hold its own boost.
+     *
+     * @return sys_error_t
+     */
+    sys_error_t requestLowLatency();
+
+    /**
+     * @brief Release a low-latency boost taken with requestLowLatency()
+     * The power save of the selected profile is restored when the last request is released.
+     *
+     * @return sys_error_t
+     */
+    sys_error_t releaseLowLatency();
 };
 
 #endif /* CPX_WIFI_HPP */
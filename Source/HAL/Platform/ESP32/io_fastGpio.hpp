@@ -0,0 +1,83 @@
+/**
+ * @file io_fastGpio.hpp
+ * @brief Header file for io_fastGpio
+ *
+ * This file contains declarations for the io_fastGpio class and related data types and functions.
+ */
+
+#ifndef IO_FASTGPIO_HPP
+#define IO_FASTGPIO_HPP
+
+#include "HAL/Common/io_pin.hpp"
+#include "driver/gpio.h"
+#include "soc/gpio_struct.h"
+
+/**
+ * @brief GPIO with the pin number and direction as template parameters
+ * get()/set() are single loads/stores of the GPIO registers (W1TS/W1TC for outputs), without the
+ * driver's argument checks, locking and the virtual call of io_gpio. The pin is configured once with init().
+ * Interrupts and debouncing stay with io_gpio.
+ *
+ * @tparam Number - GPIO number
+ * @tparam Direction - pin direction
+ */
+template <gpio_num_t Number, io_direction_t Direction> class io_fastGpio : public io_pin<io_fastGpio<Number, Direction>>
+{
+    static_assert(Number >= 0 && Number < GPIO_NUM_MAX, "io_fastGpio: invalid GPIO number");
+
+    static constexpr uint32_t mask = 1u << (Number & 31);
+
+public:
+    static constexpr io_direction_t direction = Direction;
+
+    /**
+     * @brief Configure the pin through the driver
+     *
+     * @param pullMode - pull resistors of an input
+     */
+    static sys_error_t init(gpio_pull_mode_t pullMode = GPIO_FLOATING)
+    {
+        if (gpio_reset_pin(Number) != ESP_OK || gpio_set_direction(Number, (Direction == IO_DIRECTION_OUTPUT) ? GPIO_MODE_OUTPUT : GPIO_MODE_INPUT) != ESP_OK)
+        {
+            return ERROR_INIT_FAILED;
+        }
+        if (Direction == IO_DIRECTION_INPUT && gpio_set_pull_mode(Number, pullMode) != ESP_OK)
+        {
+            return ERROR_INIT_FAILED;
+        }
+        return ERROR_SUCCESS;
+    }
+
+    static inline uint8_t readLevel()
+    {
+        return ((Number < 32) ? ((GPIO.in & mask) != 0) : ((GPIO.in1.data & mask) != 0)) ? 1 : 0;
+    }
+
+    static inline void writeLevel(uint8_t level)
+    {
+        if (Number < 32)
+        {
+            if (level != 0)
+            {
+                GPIO.out_w1ts = mask;
+            }
+            else
+            {
+                GPIO.out_w1tc = mask;
+            }
+        }
+        else
+        {
+            if (level != 0)
+            {
+                GPIO.out1_w1ts.val = mask;
+            }
+            else
+            {
+                GPIO.out1_w1tc.val = mask;
+            }
+        }
+    }
+};
+
+#endif /* IO_FASTGPIO_HPP */
@@ -6,6 +6,8 @@
  */
 
 #include "io_gpio.hpp"
+#include "Library/Diagnostics/trace.h"
+#include "System/metrics.h"
 #include "esp_log.h"
 
 #define TAG "GPIO"
@@ -13,15 +15,17 @@
 namespace
 {
 const uint32_t gpioIntBlockTime = 50; // ms
+
+metricCounter gpioInterrupts("gpio_interrupts_total", "GPIO interrupts, bounces included");
+metricCounter gpioEvents("gpio_events_total", "Debounced GPIO events queued");
+metricCounter gpioEventsDropped("gpio_events_dropped_total", "Debounced GPIO events lost to a full event queue");
 } // namespace
 
 /**
  * @brief GPIO interrupt handler
  *  This function is called when a GPIO interrupt is triggered.
- *  It disables the GPIO interrupts, starts a timer to wait for GPIO_INTR_BLOCK_TIME_MS ms,
- * and then re-enables the GPIO interrupts.
- *  The GPIO number is added to the event queue when the timer expires.
- *  The event queue is then processed by the gpioTask function.
+ *  It disables the GPIO interrupts and starts the debounce timer of the pin,
+ * the interrupts are re-enabled when the timer expires.
  *
  * @param arg Pointer to the io_gpio object
  */
@@ -30,38 +34,53 @@ static void IRAM_ATTR isrHandler(void* arg)
     io_gpio* gpioClass = static_cast<io_gpio*>(arg);
     if (gpioClass == nullptr)
     {
-        ESP_LOGE(TAG, "gpioClass can't be null!");
+        return;
     }
     gpio_intr_disable(gpioClass->getGpioNumber());
-
-    // Start a timer to wait for GPIO_INTR_BLOCK_TIME_MS ms
-    // After the timer expires, re-enable the GPIO interrupts
-    static TimerHandle_t timerHandle = NULL;
-    if (timerHandle == NULL)
+    gpioInterrupts.inc();
+    TRACE_INSTANT(GPIO_ISR, gpioClass->getGpioNumber());
+    TRACE_ASYNC_BEGIN(GPIO_LATENCY, gpioClass->getGpioNumber()); // ended by the listener of the event queue
+
+    // The timer is created in init(), timers must not be created from an interrupt
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    xTimerStartFromISR(gpioClass->getDebounceTimer(), &higherPriorityTaskWoken);
+    if (higherPriorityTaskWoken == pdTRUE)
     {
-        timerHandle = xTimerCreate("gpio_intr_block", pdMS_TO_TICKS(gpioIntBlockTime), pdFALSE, (void*)gpioClass,
-                                   [](TimerHandle_t xTimer)
-                                   {
-                                       io_gpio* gpioClass = static_cast<io_gpio*>(pvTimerGetTimerID(xTimer));
-                                       //    printf("GPIO[%d] intr, val: %d\n", gpioClass->getGpioNumber(), gpio_get_level(gpioClass->getGpioNumber()));
-
-                                       uint32_t gpioNumber = gpioClass->getGpioNumber();
-                                       // Add the GPIO inputs to the queue as a single event
-                                       xQueueSendFromISR(gpioClass->getEventQueue(), &gpioNumber, NULL);
-
-                                       // Re-enable the GPIO interrupts
-                                       gpio_intr_enable(gpioClass->getGpioNumber());
-                                   });
+        portYIELD_FROM_ISR();
     }
+}
+
+/**
+ * @brief Debounce timer callback
+ *  The GPIO number is added to the event queue and the GPIO interrupts are re-enabled.
+ *  The event queue is then processed by the gpioTask function.
+ *
+ * @param timer Timer handle, its id is the io_gpio object
+ */
+static void debounceTimerCallback(TimerHandle_t timer)
+{
+    io_gpio* gpioClass = static_cast<io_gpio*>(pvTimerGetTimerID(timer));
 
-    // Start the timer
-    if (xTimerStart(timerHandle, 0) != pdPASS)
+    uint32_t gpioNumber = gpioClass->getGpioNumber();
+    TRACE_SCOPE(GPIO_DEBOUNCE, gpioNumber);
+    // Add the GPIO inputs to the queue as a single event
+    if (xQueueSend(gpioClass->getEventQueue(), &gpioNumber, 0) == pdPASS)
     {
-        ESP_LOGE(TAG, "Failed to start timer!");
+        gpioEvents.inc();
     }
+    else
+    {
+        gpioEventsDropped.inc();
+    }
+
+    // Re-enable the GPIO interrupts
+    gpio_intr_enable(gpioClass->getGpioNumber());
 }
 
-io_gpio::io_gpio(gpio_num_t gpioNumber, void* config) : _gpioNumber(gpioNumber), _config((gpio_config_t*)config), _gpioEventQueue(xQueueCreate(5, sizeof(uint32_t))), _counter(0) {}
+io_gpio::io_gpio(gpio_num_t gpioNumber, void* config) : _gpioNumber(gpioNumber), _config((gpio_config_t*)config), _counter(0)
+{
+    _gpioEventQueue.create();
+}
 
 sys_error_t io_gpio::init()
 {
@@ -73,6 +92,12 @@ sys_error_t io_gpio::init()
 
     if (_config->mode == GPIO_MODE_INPUT)
     {
+        if (_debounceTimer.create("gpio_intr_block", pdMS_TO_TICKS(gpioIntBlockTime), false, static_cast<void*>(this), debounceTimerCallback) == NULL)
+        {
+            ESP_LOGE(TAG, "Failed to create debounce timer!");
+            return ERROR_OUT_OF_MEMORY;
+        }
+
         // install gpio isr service
         gpio_install_isr_service(ESP_INTR_FLAG_LEVEL1);
         // hook isr handler for specific gpio pin
@@ -108,7 +133,12 @@ sys_error_t io_gpio::set(void* data)
 
 QueueHandle_t io_gpio::getEventQueue()
 {
-    return _gpioEventQueue;
+    return _gpioEventQueue.getHandle();
+}
+
+TimerHandle_t io_gpio::getDebounceTimer()
+{
+    return _debounceTimer.getHandle();
 }
 
 gpio_num_t io_gpio::getGpioNumber()
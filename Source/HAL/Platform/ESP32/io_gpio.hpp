@@ -9,21 +9,27 @@
 #define IO_GPIO_HPP
 
 #include "HAL/IHal.h"
+#include "System/rtosObjects.h"
+#include "System/system.h"
 #include "driver/gpio.h"
 
 #define GPIO_HIGH 1
 #define GPIO_LOW  0
 
+#define GPIO_EVENT_QUEUE_LENGTH 5
+
 
 class io_gpio : public IHAL_IO
 {
 private:
     gpio_num_t     _gpioNumber;
     gpio_config_t* _config;
-    QueueHandle_t  _gpioEventQueue = NULL;
     uint32_t       _counter;
     int            _prevState;
 
+    rtosQueue<uint32_t, GPIO_EVENT_QUEUE_LENGTH> _gpioEventQueue;
+    rtosTimer                                    _debounceTimer; // interrupts of the pin stay off until it expires
+
 public:
     io_gpio(gpio_num_t gpioNo, void* config);
     ~io_gpio();
@@ -33,6 +39,7 @@ public:
     sys_error_t set(void* data) override;
 
     QueueHandle_t getEventQueue();
+    TimerHandle_t getDebounceTimer();
     gpio_num_t    getGpioNumber();
 };
 
@@ -0,0 +1,103 @@
+/**
+ * @file io_gpioPort.cpp
+ * @brief Source file for io_gpioPort
+ *
+ * This file contains definitions for the io_gpioPort class and related data types and functions.
+ */
+
+#include "io_gpioPort.hpp"
+#include "esp_log.h"
+#include "soc/gpio_struct.h"
+
+#define TAG "GPIO_PORT"
+
+namespace
+{
+constexpr io_portMask_t lowBank = 0xFFFFFFFFull;
+
+/**
+ * @brief Store one bank through W1TS and W1TC, the hardware applies each store atomically so no lock or read-back is needed
+ */
+inline void writeBank(volatile uint32_t& w1ts, volatile uint32_t& w1tc, uint32_t setBits, uint32_t clearBits)
+{
+    if (setBits != 0)
+    {
+        w1ts = setBits;
+    }
+    if (clearBits != 0)
+    {
+        w1tc = clearBits;
+    }
+}
+} // namespace
+
+io_gpioPort::io_gpioPort(io_portMask_t outputMask, io_portMask_t inputMask, gpio_pull_mode_t pullMode)
+    : io_port(outputMask & ((IO_PORT_PIN(GPIO_NUM_MAX)) - 1), inputMask & ((IO_PORT_PIN(GPIO_NUM_MAX)) - 1)), _pullMode(pullMode)
+{
+}
+
+io_gpioPort::~io_gpioPort()
+{
+    // destructor implementation
+}
+
+sys_error_t io_gpioPort::init()
+{
+    gpio_config_t config = {};
+    config.intr_type     = GPIO_INTR_DISABLE;
+
+    if (getOutputMask() != 0)
+    {
+        config.pin_bit_mask = getOutputMask();
+        config.mode         = GPIO_MODE_OUTPUT;
+        if (gpio_config(&config) != ESP_OK)
+        {
+            ESP_LOGE(TAG, "Failed to configure the outputs!");
+            return ERROR_INIT_FAILED;
+        }
+    }
+
+    if (getInputMask() != 0)
+    {
+        config.pin_bit_mask = getInputMask();
+        config.mode         = GPIO_MODE_INPUT;
+        config.pull_up_en   = (_pullMode == GPIO_PULLUP_ONLY || _pullMode == GPIO_PULLUP_PULLDOWN) ? GPIO_PULLUP_ENABLE : GPIO_PULLUP_DISABLE;
+        config.pull_down_en = (_pullMode == GPIO_PULLDOWN_ONLY || _pullMode == GPIO_PULLUP_PULLDOWN) ? GPIO_PULLDOWN_ENABLE : GPIO_PULLDOWN_DISABLE;
+        if (gpio_config(&config) != ESP_OK)
+        {
+            ESP_LOGE(TAG, "Failed to configure the inputs!");
+            return ERROR_INIT_FAILED;
+        }
+    }
+
+    // The port starts with all outputs low, make the pins match
+    writePins(0, getOutputMask(), 0);
+    return ERROR_SUCCESS;
+}
+
+io_portMask_t io_gpioPort::readPins(io_portMask_t mask)
+{
+    io_portMask_t levels = 0;
+    if ((mask & lowBank) != 0)
+    {
+        levels |= GPIO.in;
+    }
+    if ((mask >> 32) != 0)
+    {
+        levels |= static_cast<io_portMask_t>(GPIO.in1.data) << 32;
+    }
+    return levels;
+}
+
+sys_error_t io_gpioPort::writePins(io_portMask_t setBits, io_portMask_t clearBits, io_portMask_t levels)
+{
+    if (((setBits | clearBits) & lowBank) != 0)
+    {
+        writeBank(GPIO.out_w1ts, GPIO.out_w1tc, static_cast<uint32_t>(setBits), static_cast<uint32_t>(clearBits));
+    }
+    if (((setBits | clearBits) >> 32) != 0)
+    {
+        writeBank(GPIO.out1_w1ts.val, GPIO.out1_w1tc.val, static_cast<uint32_t>(setBits >> 32), static_cast<uint32_t>(clearBits >> 32));
+    }
+    return ERROR_SUCCESS;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file io_gpioPort.hpp
+ * @brief Header file for io_gpioPort
+ *
+ * This file contains declarations for the io_gpioPort class and related data types and functions.
+ */
+
+#ifndef IO_GPIOPORT_HPP
+#define IO_GPIOPORT_HPP
+
+#include "HAL/Common/io_port.hpp"
+#include "System/system.h"
+#include "driver/gpio.h"
+
+/**
+ * @brief Native GPIO pins as an io_port
+ * Pins 0-31 and 32-39 sit in two registers, each updated through its write-1-to-set and write-1-to-clear
+ * registers: the set pins change with one store, the cleared pins with the next, without a lock or read-back.
+ */
+class io_gpioPort : public io_port
+{
+private:
+    gpio_pull_mode_t _pullMode;
+
+protected:
+    io_portMask_t readPins(io_portMask_t mask) override;
+    sys_error_t   writePins(io_portMask_t setBits, io_portMask_t clearBits, io_portMask_t levels) override;
+
+public:
+    /**
+     * @brief Construct a new io_gpioPort object
+     *
+     * @param outputMask - output pins, bit n is GPIO n
+     * @param inputMask - input pins, bit n is GPIO n
+     * @param pullMode - pull resistors of the inputs (default GPIO_FLOATING)
+     */
+    io_gpioPort(io_portMask_t outputMask, io_portMask_t inputMask, gpio_pull_mode_t pullMode = GPIO_FLOATING);
+    ~io_gpioPort();
+
+    sys_error_t init() override;
+};
+
+#endif /* IO_GPIOPORT_HPP */
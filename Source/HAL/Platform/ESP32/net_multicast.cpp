@@ -0,0 +1,116 @@
+/**
+ * @file net_multicast.cpp
+ * @brief Source file for net_multicast
+ *
+ * This file contains definitions for the net_multicast class and related data types and functions.
+ */
+
+#include "net_multicast.hpp"
+#include "lwip/sockets.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+net_multicast::net_multicast(const char* group, uint16_t port) : _group(group), _port(port), _fd(-1) {}
+
+net_multicast::~net_multicast()
+{
+    disconnect();
+}
+
+sys_error_t net_multicast::connect()
+{
+    if (_fd >= 0)
+    {
+        return ERROR_SUCCESS;
+    }
+
+    struct ip_mreq membership       = {};
+    membership.imr_interface.s_addr = htonl(INADDR_ANY);
+    if (inet_pton(AF_INET, _group, &membership.imr_multiaddr) != 1)
+    {
+        return ERROR_INVALID_ARG;
+    }
+    struct sockaddr_in local = {};
+    local.sin_family         = AF_INET;
+    local.sin_port           = htons(_port);
+    local.sin_addr.s_addr    = htonl(INADDR_ANY);
+
+    _fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (_fd < 0)
+    {
+        return ERROR_CONNECTION_FAILED;
+    }
+
+    // Multicast DNS packets are sent with TTL 255, receivers drop others
+    int     enable = 1;
+    uint8_t ttl    = 255;
+    bool    ready  = setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) == 0;
+    ready          = ready && bind(_fd, reinterpret_cast<struct sockaddr*>(&local), sizeof(local)) == 0;
+    ready          = ready && setsockopt(_fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) == 0;
+    ready          = ready && setsockopt(_fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) == 0;
+    ready          = ready && fcntl(_fd, F_SETFL, fcntl(_fd, F_GETFL, 0) | O_NONBLOCK) == 0;
+    if (!ready)
+    {
+        disconnect();
+        return ERROR_CONNECTION_FAILED;
+    }
+    return ERROR_SUCCESS;
+}
+
+sys_error_t net_multicast::sendData(const uint8_t* data, size_t length)
+{
+    if (_fd < 0)
+    {
+        return ERROR_CONNECTION_CLOSED;
+    }
+    struct sockaddr_in group = {};
+    group.sin_family         = AF_INET;
+    group.sin_port           = htons(_port);
+    inet_pton(AF_INET, _group, &group.sin_addr);
+    if (sendto(_fd, data, length, 0, reinterpret_cast<struct sockaddr*>(&group), sizeof(group)) == static_cast<ssize_t>(length))
+    {
+        return ERROR_SUCCESS;
+    }
+    // ENOMEM: no pbuf, goes away without dropping the datagram
+    return (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOMEM || errno == ENOBUFS) ? ERROR_BUSY : ERROR_TRANSMIT_FAILED;
+}
+
+sys_error_t net_multicast::receiveData(uint8_t* data, size_t maxLength, size_t& receivedLength)
+{
+    receivedLength = 0;
+    if (_fd < 0)
+    {
+        return ERROR_CONNECTION_CLOSED;
+    }
+    ssize_t received = recv(_fd, data, maxLength, 0);
+    if (received < 0)
+    {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? ERROR_SUCCESS : ERROR_RECEIVE_FAILED;
+    }
+    receivedLength = static_cast<size_t>(received);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t net_multicast::disconnect()
+{
+    if (_fd >= 0)
+    {
+        close(_fd);
+        _fd = -1;
+    }
+    return ERROR_SUCCESS;
+}
+
+bool net_multicast::waitReadable(uint32_t timeoutMs)
+{
+    if (_fd < 0)
+    {
+        return false;
+    }
+    fd_set readable;
+    FD_ZERO(&readable);
+    FD_SET(_fd, &readable);
+    struct timeval timeout = {static_cast<time_t>(timeoutMs / 1000), static_cast<suseconds_t>((timeoutMs % 1000) * 1000)};
+    return select(_fd + 1, &readable, nullptr, nullptr, &timeout) == 1;
+}
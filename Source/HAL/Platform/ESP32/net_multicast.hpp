@@ -0,0 +1,55 @@
+/**
+ * @file net_multicast.hpp
+ * @brief Header file for net_multicast
+ *
+ * This file contains declarations for the net_multicast class and related data types and functions.
+ */
+
+#ifndef NET_MULTICAST_HPP
+#define NET_MULTICAST_HPP
+
+#include "HAL/IHal.h"
+#include "System/system.h"
+
+/**
+ * @brief lwIP UDP socket member of a multicast group
+ * The socket is bound to the group port and joined to the group on every interface that is up, connect() fails
+ * before the station has an address. sendData() sends one datagram to the group and never blocks: ERROR_BUSY if lwIP
+ * has no buffer for it. receiveData() returns one datagram, or nothing if none is waiting.
+ */
+class net_multicast : public IHAL_COM
+{
+private:
+    const char* _group;
+    uint16_t    _port;
+    int         _fd;
+
+public:
+    /**
+     * @brief Construct a new net_multicast object
+     *
+     * @param group - IPv4 multicast group, must stay valid
+     * @param port - UDP port of the group
+     */
+    net_multicast(const char* group, uint16_t port);
+    ~net_multicast();
+
+    // Delete copy constructor and assignment operator
+    net_multicast(const net_multicast&)            = delete;
+    net_multicast& operator=(const net_multicast&) = delete;
+
+    sys_error_t connect() override;
+    sys_error_t sendData(const uint8_t* data, size_t length) override;
+    sys_error_t receiveData(uint8_t* data, size_t maxLength, size_t& receivedLength) override;
+    sys_error_t disconnect() override;
+
+    /**
+     * @brief Wait until a datagram is waiting, the task blocks meanwhile
+     *
+     * @param timeoutMs - longest wait in milliseconds
+     * @return bool true if a datagram is waiting
+     */
+    bool waitReadable(uint32_t timeoutMs);
+};
+
+#endif /* NET_MULTICAST_HPP */
@@ -0,0 +1,184 @@
+/**
+ * @file net_tcp.cpp
+ * @brief Source file for net_tcp
+ *
+ * This file contains definitions for the net_tcp class and related data types and functions.
+ */
+
+#include "net_tcp.hpp"
+#include "esp_vfs_eventfd.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "lwip/netdb.h"
+#include "lwip/sockets.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+net_tcp::net_tcp(const char* host, uint16_t port) : _host(host), _port(port), _fd(-1), _wakeFd(-1) {}
+
+net_tcp::~net_tcp()
+{
+    disconnect();
+    if (_wakeFd >= 0)
+    {
+        close(_wakeFd);
+    }
+}
+
+sys_error_t net_tcp::connect()
+{
+    if (_fd >= 0)
+    {
+        return ERROR_SUCCESS;
+    }
+
+    char port[8];
+    snprintf(port, sizeof(port), "%u", static_cast<unsigned>(_port));
+    struct addrinfo  hints   = {};
+    struct addrinfo* results = nullptr;
+    hints.ai_family          = AF_INET;
+    hints.ai_socktype        = SOCK_STREAM;
+    if (getaddrinfo(_host, port, &hints, &results) != 0 || results == nullptr)
+    {
+        return ERROR_INVALID_ARG;
+    }
+
+    _fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    bool connected = (_fd >= 0 && ::connect(_fd, results->ai_addr, results->ai_addrlen) == 0);
+    freeaddrinfo(results);
+
+    // Small packets go out at once, PUBACKs and pings are not held back
+    int noDelay = 1;
+    if (!connected || setsockopt(_fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay)) != 0 || fcntl(_fd, F_SETFL, fcntl(_fd, F_GETFL, 0) | O_NONBLOCK) != 0)
+    {
+        disconnect();
+        return ERROR_CONNECTION_FAILED;
+    }
+    return ERROR_SUCCESS;
+}
+
+sys_error_t net_tcp::sendData(const uint8_t* data, size_t length)
+{
+    if (_fd < 0)
+    {
+        return ERROR_CONNECTION_CLOSED;
+    }
+
+    size_t sent = 0;
+    while (sent < length)
+    {
+        ssize_t result = send(_fd, data + sent, length - sent, 0);
+        if (result > 0)
+        {
+            sent += static_cast<size_t>(result);
+            continue;
+        }
+        // ENOMEM: lwIP ran out of pbufs, goes away like a full send buffer
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != ENOMEM)
+        {
+            return ERROR_TRANSMIT_FAILED;
+        }
+        if (sent == 0)
+        {
+            return ERROR_BUSY;
+        }
+        fd_set writable;
+        FD_ZERO(&writable);
+        FD_SET(_fd, &writable);
+        struct timeval timeout = {NET_TCP_SEND_TIMEOUT_MS / 1000, (NET_TCP_SEND_TIMEOUT_MS % 1000) * 1000};
+        if (select(_fd + 1, nullptr, &writable, nullptr, &timeout) != 1)
+        {
+            return ERROR_TRANSMIT_FAILED;
+        }
+    }
+    return ERROR_SUCCESS;
+}
+
+sys_error_t net_tcp::receiveData(uint8_t* data, size_t maxLength, size_t& receivedLength)
+{
+    receivedLength = 0;
+    if (_fd < 0)
+    {
+        return ERROR_CONNECTION_CLOSED;
+    }
+    ssize_t received = recv(_fd, data, maxLength, 0);
+    if (received == 0 && maxLength > 0)
+    {
+        return ERROR_CONNECTION_CLOSED;
+    }
+    if (received < 0)
+    {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? ERROR_SUCCESS : ERROR_RECEIVE_FAILED;
+    }
+    receivedLength = static_cast<size_t>(received);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t net_tcp::disconnect()
+{
+    if (_fd >= 0)
+    {
+        close(_fd);
+        _fd = -1;
+    }
+    return ERROR_SUCCESS;
+}
+
+sys_error_t net_tcp::initWake()
+{
+    if (_wakeFd >= 0)
+    {
+        return ERROR_SUCCESS;
+    }
+    // Registered once for all users, a second registration reports ESP_ERR_INVALID_STATE
+    esp_vfs_eventfd_config_t config = ESP_VFS_EVENTD_CONFIG_DEFAULT();
+    esp_err_t                result = esp_vfs_eventfd_register(&config);
+    if (result != ESP_OK && result != ESP_ERR_INVALID_STATE)
+    {
+        return ERROR_OUT_OF_MEMORY;
+    }
+    _wakeFd = eventfd(0, 0);
+    return (_wakeFd >= 0) ? ERROR_SUCCESS : ERROR_OUT_OF_MEMORY;
+}
+
+bool net_tcp::waitReadable(uint32_t timeoutMs)
+{
+    if (_fd < 0 && _wakeFd < 0)
+    {
+        vTaskDelay((timeoutMs == UINT32_MAX) ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs));
+        return false;
+    }
+
+    fd_set readable;
+    FD_ZERO(&readable);
+    int maxFd = -1;
+    if (_fd >= 0)
+    {
+        FD_SET(_fd, &readable);
+        maxFd = _fd;
+    }
+    if (_wakeFd >= 0)
+    {
+        FD_SET(_wakeFd, &readable);
+        maxFd = (_wakeFd > maxFd) ? _wakeFd : maxFd;
+    }
+    struct timeval timeout = {static_cast<time_t>(timeoutMs / 1000), static_cast<suseconds_t>((timeoutMs % 1000) * 1000)};
+    int            ready   = select(maxFd + 1, &readable, nullptr, nullptr, (timeoutMs == UINT32_MAX) ? nullptr : &timeout);
+    if (ready > 0 && _wakeFd >= 0 && FD_ISSET(_wakeFd, &readable))
+    {
+        uint64_t count;
+        read(_wakeFd, &count, sizeof(count));
+    }
+    return ready > 0;
+}
+
+void net_tcp::wake()
+{
+    if (_wakeFd >= 0)
+    {
+        uint64_t count = 1;
+        write(_wakeFd, &count, sizeof(count));
+    }
+}
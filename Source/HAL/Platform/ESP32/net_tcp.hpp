@@ -0,0 +1,73 @@
+/**
+ * @file net_tcp.hpp
+ * @brief Header file for net_tcp
+ *
+ * This file contains declarations for the net_tcp class and related data types and functions.
+ */
+
+#ifndef NET_TCP_HPP
+#define NET_TCP_HPP
+
+#include "HAL/IHal.h"
+#include "System/system.h"
+
+#define NET_TCP_SEND_TIMEOUT_MS 1000 // a started packet is completed within this time or the connection is failed
+
+/**
+ * @brief lwIP TCP client connection
+ * connect() blocks until the connection is established, the socket is non-blocking afterwards. sendData() sends
+ * the whole buffer or nothing: ERROR_BUSY if lwIP has no room for it, and once part of it is sent the rest is
+ * waited for, so a packet is never cut. receiveData() returns what is waiting, ERROR_CONNECTION_CLOSED once the
+ * peer closed the connection. waitReadable() blocks the calling task until data arrives, the timeout passes or
+ * another task calls wake().
+ */
+class net_tcp : public IHAL_COM
+{
+private:
+    const char* _host;
+    uint16_t    _port;
+    int         _fd;
+    int         _wakeFd; // eventfd wake() writes to
+
+public:
+    /**
+     * @brief Construct a new net_tcp object
+     *
+     * @param host - host name or IPv4 address of the peer, must stay valid
+     * @param port - TCP port of the peer
+     */
+    net_tcp(const char* host, uint16_t port);
+    ~net_tcp();
+
+    // Delete copy constructor and assignment operator
+    net_tcp(const net_tcp&)            = delete;
+    net_tcp& operator=(const net_tcp&) = delete;
+
+    sys_error_t connect() override;
+    sys_error_t sendData(const uint8_t* data, size_t length) override;
+    sys_error_t receiveData(uint8_t* data, size_t maxLength, size_t& receivedLength) override;
+    sys_error_t disconnect() override;
+
+    /**
+     * @brief Create the descriptor wake() signals, before the task calling waitReadable() starts
+     *
+     * @return sys_error_t ERROR_SUCCESS, ERROR_OUT_OF_MEMORY if the eventfd could not be created
+     */
+    sys_error_t initWake();
+
+    /**
+     * @brief Wait until data is waiting or wake() is called, the task blocks meanwhile
+     * Without a connection only wake() and the timeout end the wait.
+     *
+     * @param timeoutMs - longest wait in milliseconds, UINT32_MAX to wait forever
+     * @return bool true if data is waiting or the wait was woken
+     */
+    bool waitReadable(uint32_t timeoutMs);
+
+    /**
+     * @brief End the current or next waitReadable(), callable from any task
+     */
+    void wake();
+};
+
+#endif /* NET_TCP_HPP */
@@ -0,0 +1,87 @@
+/**
+ * @file net_udp.cpp
+ * @brief Source file for net_udp
+ *
+ * This file contains definitions for the net_udp class and related data types and functions.
+ */
+
+#include "net_udp.hpp"
+#include "lwip/sockets.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+net_udp::net_udp(const char* host, uint16_t port) : _host(host), _port(port), _fd(-1) {}
+
+net_udp::~net_udp()
+{
+    disconnect();
+}
+
+sys_error_t net_udp::connect()
+{
+    if (_fd >= 0)
+    {
+        return ERROR_SUCCESS;
+    }
+
+    struct sockaddr_in address = {};
+    address.sin_family         = AF_INET;
+    address.sin_port           = htons(_port);
+    if (inet_pton(AF_INET, _host, &address.sin_addr) != 1)
+    {
+        return ERROR_INVALID_ARG;
+    }
+
+    _fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (_fd < 0)
+    {
+        return ERROR_CONNECTION_FAILED;
+    }
+    if (fcntl(_fd, F_SETFL, fcntl(_fd, F_GETFL, 0) | O_NONBLOCK) != 0 || ::connect(_fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        disconnect();
+        return ERROR_CONNECTION_FAILED;
+    }
+    return ERROR_SUCCESS;
+}
+
+sys_error_t net_udp::sendData(const uint8_t* data, size_t length)
+{
+    if (_fd < 0)
+    {
+        return ERROR_CONNECTION_CLOSED;
+    }
+    if (send(_fd, data, length, 0) == static_cast<ssize_t>(length))
+    {
+        return ERROR_SUCCESS;
+    }
+    // ENOMEM: no pbuf, EHOSTUNREACH: no IP address yet, both go away without dropping the datagram
+    return (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOMEM || errno == ENOBUFS || errno == EHOSTUNREACH) ? ERROR_BUSY : ERROR_TRANSMIT_FAILED;
+}
+
+sys_error_t net_udp::receiveData(uint8_t* data, size_t maxLength, size_t& receivedLength)
+{
+    receivedLength = 0;
+    if (_fd < 0)
+    {
+        return ERROR_CONNECTION_CLOSED;
+    }
+    ssize_t received = recv(_fd, data, maxLength, 0);
+    if (received < 0)
+    {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? ERROR_SUCCESS : ERROR_RECEIVE_FAILED;
+    }
+    receivedLength = static_cast<size_t>(received);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t net_udp::disconnect()
+{
+    if (_fd >= 0)
+    {
+        close(_fd);
+        _fd = -1;
+    }
+    return ERROR_SUCCESS;
+}
@@ -0,0 +1,46 @@
+/**
+ * @file net_udp.hpp
+ * @brief Header file for net_udp
+ *
+ * This file contains declarations for the net_udp class and related data types and functions.
+ */
+
+#ifndef NET_UDP_HPP
+#define NET_UDP_HPP
+
+#include "HAL/IHal.h"
+#include "System/system.h"
+
+/**
+ * @brief lwIP UDP socket connected to one peer
+ * sendData() sends one datagram and never blocks: ERROR_BUSY if lwIP has no buffer for it. receiveData() returns
+ * one datagram, or nothing if none is waiting.
+ */
+class net_udp : public IHAL_COM
+{
+private:
+    const char* _host;
+    uint16_t    _port;
+    int         _fd;
+
+public:
+    /**
+     * @brief Construct a new net_udp object
+     *
+     * @param host - IPv4 address of the peer, must stay valid
+     * @param port - UDP port of the peer
+     */
+    net_udp(const char* host, uint16_t port);
+    ~net_udp();
+
+    // Delete copy constructor and assignment operator
+    net_udp(const net_udp&)            = delete;
+    net_udp& operator=(const net_udp&) = delete;
+
+    sys_error_t connect() override;
+    sys_error_t sendData(const uint8_t* data, size_t length) override;
+    sys_error_t receiveData(uint8_t* data, size_t maxLength, size_t& receivedLength) override;
+    sys_error_t disconnect() override;
+};
+
+#endif /* NET_UDP_HPP */
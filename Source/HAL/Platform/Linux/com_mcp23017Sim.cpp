@@ -0,0 +1,142 @@
+/**
+ * @file com_mcp23017Sim.cpp
+ * @brief Source file for com_mcp23017Sim
+ *
+ * This file contains definitions for the com_mcp23017Sim class and related data types and functions.
+ */
+
+#include "com_mcp23017Sim.hpp"
+#include "HAL/Common/io_mcp23017Port.hpp"
+
+#include <string.h>
+
+com_mcp23017Sim::com_mcp23017Sim() : _stats() {}
+
+com_mcp23017Sim::~com_mcp23017Sim()
+{
+    // destructor implementation
+}
+
+void com_mcp23017Sim::addDevice(uint8_t address)
+{
+    device_t device;
+    memset(&device, 0, sizeof(device));
+    device.address                    = address;
+    device.registers[MCP23017_IODIRA] = 0xFF; // all inputs after power-on
+    device.registers[MCP23017_IODIRB] = 0xFF;
+    _devices.push_back(device);
+}
+
+void com_mcp23017Sim::setInputs(uint8_t address, uint16_t mask, uint16_t levels)
+{
+    device_t* device = find(address);
+    if (device != nullptr)
+    {
+        device->connected |= mask;
+        device->levels = (device->levels & ~mask) | (levels & mask);
+    }
+}
+
+uint16_t com_mcp23017Sim::getOutputs(uint8_t address)
+{
+    device_t* device = find(address);
+    if (device == nullptr)
+    {
+        return 0;
+    }
+    return static_cast<uint16_t>(device->registers[MCP23017_OLATA] | (device->registers[MCP23017_OLATB] << 8));
+}
+
+sys_error_t com_mcp23017Sim::write(uint8_t address, const uint8_t* data, size_t length)
+{
+    _stats.transactions++;
+    _stats.bytes += static_cast<uint32_t>(length + 1);
+    device_t* device = find(address);
+    if (device == nullptr)
+    {
+        return ERROR_DEVICE_UNRESPONSIVE;
+    }
+    if (length == 0)
+    {
+        return ERROR_SUCCESS; // address probe
+    }
+
+    uint8_t reg = data[0];
+    for (size_t i = 1; i < length; i++, reg++)
+    {
+        if (reg >= MCP23017_SIM_REGISTER_COUNT)
+        {
+            return ERROR_INVALID_ARG;
+        }
+        // Writing GPIO writes the latch
+        uint8_t target            = (reg == MCP23017_GPIOA || reg == MCP23017_GPIOB) ? static_cast<uint8_t>(reg + 2) : reg;
+        device->registers[target] = data[i];
+    }
+    return ERROR_SUCCESS;
+}
+
+sys_error_t com_mcp23017Sim::writeRead(uint8_t address, const uint8_t* txData, size_t txLength, uint8_t* rxData, size_t rxLength)
+{
+    _stats.transactions++;
+    _stats.bytes += static_cast<uint32_t>(txLength + rxLength + 2);
+    device_t* device = find(address);
+    if (device == nullptr)
+    {
+        return ERROR_DEVICE_UNRESPONSIVE;
+    }
+    if (txLength != 1)
+    {
+        return ERROR_INVALID_ARG;
+    }
+
+    uint8_t reg = txData[0];
+    for (size_t i = 0; i < rxLength; i++, reg++)
+    {
+        if (reg >= MCP23017_SIM_REGISTER_COUNT)
+        {
+            return ERROR_INVALID_ARG;
+        }
+        rxData[i] = readRegister(*device, reg);
+    }
+    return ERROR_SUCCESS;
+}
+
+busStats_t com_mcp23017Sim::getStats()
+{
+    return _stats;
+}
+
+com_mcp23017Sim::device_t* com_mcp23017Sim::find(uint8_t address)
+{
+    for (device_t& device : _devices)
+    {
+        if (device.address == address)
+        {
+            return &device;
+        }
+    }
+    return nullptr;
+}
+
+uint16_t com_mcp23017Sim::readPins(device_t& device)
+{
+    uint16_t inputs  = static_cast<uint16_t>(device.registers[MCP23017_IODIRA] | (device.registers[MCP23017_IODIRB] << 8));
+    uint16_t pullUps = static_cast<uint16_t>(device.registers[MCP23017_GPPUA] | (device.registers[MCP23017_GPPUB] << 8));
+    uint16_t latches = static_cast<uint16_t>(device.registers[MCP23017_OLATA] | (device.registers[MCP23017_OLATB] << 8));
+
+    uint16_t external = (device.levels & device.connected) | (pullUps & ~device.connected);
+    return static_cast<uint16_t>((external & inputs) | (latches & ~inputs));
+}
+
+uint8_t com_mcp23017Sim::readRegister(device_t& device, uint8_t reg)
+{
+    if (reg == MCP23017_GPIOA)
+    {
+        return static_cast<uint8_t>(readPins(device));
+    }
+    if (reg == MCP23017_GPIOB)
+    {
+        return static_cast<uint8_t>(readPins(device) >> 8);
+    }
+    return device.registers[reg];
+}
@@ -0,0 +1,70 @@
+/**
+ * @file com_mcp23017Sim.hpp
+ * @brief Header file for com_mcp23017Sim
+ *
+ * This file contains declarations for the com_mcp23017Sim class and related data types and functions.
+ */
+
+#ifndef COM_MCP23017SIM_HPP
+#define COM_MCP23017SIM_HPP
+
+#include "com_shiftRegisterSim.hpp"
+
+#define MCP23017_SIM_REGISTER_COUNT 0x16
+
+/**
+ * @brief Host simulation of MCP23017 expanders on an I2C bus
+ * Covers the registers used by io_mcp23017Port with sequential addressing (IOCON = 0). An address
+ * without a device is not acknowledged. Pins read from GPIO are the external levels for inputs and
+ * the latches for outputs; unconnected inputs with a pull-up read high.
+ */
+class com_mcp23017Sim : public IHAL_I2C
+{
+private:
+    typedef struct
+    {
+        uint8_t  address;
+        uint8_t  registers[MCP23017_SIM_REGISTER_COUNT];
+        uint16_t levels;    // external levels driven on the pins
+        uint16_t connected; // pins with an external driver
+    } device_t;
+
+    std::vector<device_t> _devices;
+    busStats_t            _stats;
+
+    device_t* find(uint8_t address);
+    uint16_t  readPins(device_t& device);
+    uint8_t   readRegister(device_t& device, uint8_t reg);
+
+public:
+    com_mcp23017Sim();
+    ~com_mcp23017Sim();
+
+    /**
+     * @brief Put a device on the bus, with its power-on registers
+     *
+     * @param address - 7-bit address
+     */
+    void addDevice(uint8_t address);
+
+    /**
+     * @brief Drive the pins of a device from outside, e.g. buttons
+     *
+     * @param address - device address
+     * @param mask - pins to drive, the others are left floating
+     * @param levels - their levels
+     */
+    void setInputs(uint8_t address, uint16_t mask, uint16_t levels);
+
+    /**
+     * @brief Output latch of a device, OLATB:OLATA
+     */
+    uint16_t getOutputs(uint8_t address);
+
+    sys_error_t write(uint8_t address, const uint8_t* data, size_t length) override;
+    sys_error_t writeRead(uint8_t address, const uint8_t* txData, size_t txLength, uint8_t* rxData, size_t rxLength) override;
+
+    busStats_t getStats();
+};
+
+#endif /* COM_MCP23017SIM_HPP */
@@ -0,0 +1,222 @@
+/**
+ * @file com_pty.cpp
+ * @brief Source file for com_pty
+ *
+ * This file contains definitions for the com_pty class and related data types and functions.
+ */
+
+#include "com_pty.hpp"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace
+{
+speed_t toSpeed(uint32_t baudRate)
+{
+    switch (baudRate)
+    {
+        case 9600:
+            return B9600;
+        case 19200:
+            return B19200;
+        case 38400:
+            return B38400;
+        case 57600:
+            return B57600;
+        case 230400:
+            return B230400;
+        case 460800:
+            return B460800;
+        case 921600:
+            return B921600;
+        case 1000000:
+            return B1000000;
+        case 1500000:
+            return B1500000;
+        case 2000000:
+            return B2000000;
+        case 3000000:
+            return B3000000;
+        default:
+            return B115200;
+    }
+}
+
+bool makeRaw(int fd, uint32_t baudRate)
+{
+    struct termios settings;
+    if (tcgetattr(fd, &settings) != 0)
+    {
+        return false;
+    }
+    cfmakeraw(&settings);
+    cfsetspeed(&settings, toSpeed(baudRate));
+    return tcsetattr(fd, TCSANOW, &settings) == 0;
+}
+} // namespace
+
+com_pty::com_pty(uint8_t* txStorage, size_t txSize, uint8_t* rxStorage, size_t rxSize, const char* devicePath, uint32_t baudRate, uint32_t idleTimeoutMs)
+    : com_stream(txStorage, txSize, rxStorage, rxSize), _devicePath(devicePath != nullptr ? devicePath : ""), _baudRate(baudRate), _idleTimeoutMs(idleTimeoutMs), _fd(-1), _slaveFd(-1),
+      _wakePipe{-1, -1}, _running(false)
+{
+}
+
+com_pty::~com_pty()
+{
+    disconnect();
+}
+
+sys_error_t com_pty::connect()
+{
+    if (_running)
+    {
+        return ERROR_SUCCESS;
+    }
+    if (!isValid())
+    {
+        return ERROR_INVALID_CONFIG;
+    }
+
+    if (_devicePath.empty())
+    {
+        _fd = posix_openpt(O_RDWR | O_NOCTTY);
+        char name[64];
+        if (_fd < 0 || grantpt(_fd) != 0 || unlockpt(_fd) != 0 || ptsname_r(_fd, name, sizeof(name)) != 0)
+        {
+            closeAll();
+            return ERROR_CONNECTION_FAILED;
+        }
+        _slaveName = name;
+
+        // The line discipline sits on the slave side. Keeping it open also stops reads
+        // on the master from failing while the remote end is not attached.
+        _slaveFd = open(name, O_RDWR | O_NOCTTY);
+        if (_slaveFd < 0 || !makeRaw(_slaveFd, _baudRate))
+        {
+            closeAll();
+            return ERROR_CONNECTION_FAILED;
+        }
+    }
+    else
+    {
+        _fd = open(_devicePath.c_str(), O_RDWR | O_NOCTTY);
+        if (_fd < 0 || !makeRaw(_fd, _baudRate))
+        {
+            closeAll();
+            return ERROR_CONNECTION_FAILED;
+        }
+    }
+
+    if (fcntl(_fd, F_SETFL, fcntl(_fd, F_GETFL) | O_NONBLOCK) != 0 || pipe(_wakePipe) != 0)
+    {
+        closeAll();
+        return ERROR_CONNECTION_FAILED;
+    }
+    fcntl(_wakePipe[0], F_SETFL, O_NONBLOCK);
+    fcntl(_wakePipe[1], F_SETFL, O_NONBLOCK);
+
+    _running = true;
+    _engine  = std::thread(&com_pty::engineLoop, this);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t com_pty::disconnect()
+{
+    if (_running.exchange(false))
+    {
+        kickTx();
+        _engine.join();
+    }
+    closeAll();
+    return ERROR_SUCCESS;
+}
+
+const char* com_pty::getSlaveName()
+{
+    return _slaveName.c_str();
+}
+
+void com_pty::kickTx()
+{
+    uint8_t wake = 1;
+    if (write(_wakePipe[1], &wake, 1) < 0)
+    {
+        // pipe already full, the engine wakes up anyway
+    }
+}
+
+void com_pty::engineLoop()
+{
+    while (_running)
+    {
+        ringSpan_t rx = rxDmaSpan();
+        ringSpan_t tx = txDmaSpan();
+
+        struct pollfd fds[2];
+        fds[0].fd     = _fd;
+        fds[0].events = static_cast<short>((rx.length > 0 ? POLLIN : 0) | (tx.length > 0 ? POLLOUT : 0));
+        fds[1].fd     = _wakePipe[0];
+        fds[1].events = POLLIN;
+
+        // A full RX ring is only drained by the application, look again soon
+        int timeout = (rx.length > 0) ? static_cast<int>(_idleTimeoutMs) : 1;
+        int ready   = poll(fds, 2, timeout);
+        if (ready == 0)
+        {
+            rxIdle();
+            continue;
+        }
+        if (ready < 0 || (fds[0].revents & (POLLERR | POLLNVAL)) != 0)
+        {
+            break;
+        }
+
+        if ((fds[1].revents & POLLIN) != 0)
+        {
+            uint8_t drain[16];
+            while (read(_wakePipe[0], drain, sizeof(drain)) > 0)
+            {
+            }
+        }
+
+        if ((fds[0].revents & POLLIN) != 0)
+        {
+            ssize_t received = read(_fd, rx.data, rx.length);
+            if (received > 0)
+            {
+                rxDmaComplete(static_cast<size_t>(received));
+                if (rxDmaSpan().length == 0)
+                {
+                    rxOverrun();
+                }
+            }
+        }
+
+        if ((fds[0].revents & POLLOUT) != 0)
+        {
+            ssize_t sent = write(_fd, tx.data, tx.length);
+            if (sent > 0)
+            {
+                txDmaComplete(static_cast<size_t>(sent));
+            }
+        }
+    }
+}
+
+void com_pty::closeAll()
+{
+    int* fds[] = {&_fd, &_slaveFd, &_wakePipe[0], &_wakePipe[1]};
+    for (int* fd : fds)
+    {
+        if (*fd >= 0)
+        {
+            close(*fd);
+            *fd = -1;
+        }
+    }
+    _slaveName.clear();
+}
@@ -0,0 +1,64 @@
+/**
+ * @file com_pty.hpp
+ * @brief Header file for com_pty
+ *
+ * This file contains declarations for the com_pty class and related data types and functions.
+ */
+
+#ifndef COM_PTY_HPP
+#define COM_PTY_HPP
+
+#include "HAL/Common/com_stream.hpp"
+#include <atomic>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Host serial port on a pseudo terminal or a tty device
+ * Without a device path a pseudo terminal is created, its slave side (getSlaveName()) plays the remote device.
+ * A thread plays the UART DMA engine: it receives straight into the RX ring and transmits straight from the TX ring.
+ */
+class com_pty : public com_stream
+{
+private:
+    std::string       _devicePath;
+    std::string       _slaveName;
+    uint32_t          _baudRate;
+    uint32_t          _idleTimeoutMs;
+    int               _fd;
+    int               _slaveFd;
+    int               _wakePipe[2];
+    std::thread       _engine;
+    std::atomic<bool> _running;
+
+    void engineLoop();
+    void kickTx() override;
+    void closeAll();
+
+public:
+    /**
+     * @brief Construct a new com_pty object
+     *
+     * @param txStorage - TX ring storage, owned by the caller
+     * @param txSize - TX ring size, power of two
+     * @param rxStorage - RX ring storage, owned by the caller
+     * @param rxSize - RX ring size, power of two
+     * @param devicePath - tty device to open, nullptr creates a pseudo terminal (default)
+     * @param baudRate - line speed of a tty device (default 115200)
+     * @param idleTimeoutMs - silence after which COM_EVENT_RX_IDLE is raised (default 2 ms)
+     */
+    com_pty(uint8_t* txStorage, size_t txSize, uint8_t* rxStorage, size_t rxSize, const char* devicePath = nullptr, uint32_t baudRate = 115200, uint32_t idleTimeoutMs = 2);
+    ~com_pty();
+
+    sys_error_t connect() override;
+    sys_error_t disconnect() override;
+
+    /**
+     * @brief Get the slave device of the created pseudo terminal
+     *
+     * @return const char* empty if a tty device is used or not connected
+     */
+    const char* getSlaveName();
+};
+
+#endif /* COM_PTY_HPP */
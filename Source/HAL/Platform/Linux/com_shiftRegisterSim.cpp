@@ -0,0 +1,59 @@
+/**
+ * @file com_shiftRegisterSim.cpp
+ * @brief Source file for com_shiftRegisterSim
+ *
+ * This file contains definitions for the com_shiftRegisterSim class and related data types and functions.
+ */
+
+#include "com_shiftRegisterSim.hpp"
+
+com_shiftRegisterSim::com_shiftRegisterSim(size_t registers) : _shift(registers, 0), _outputs(registers, 0), _stats() {}
+
+com_shiftRegisterSim::~com_shiftRegisterSim()
+{
+    // destructor implementation
+}
+
+sys_error_t com_shiftRegisterSim::transfer(const uint8_t* txData, uint8_t* rxData, size_t length)
+{
+    if (txData == nullptr)
+    {
+        return ERROR_NULL_POINTER;
+    }
+    for (size_t i = 0; i < length; i++)
+    {
+        // Q7' of the last register falls off the chain, it is what MISO would see
+        uint8_t out = _shift.empty() ? txData[i] : _shift.back();
+        for (size_t stage = _shift.size(); stage > 1; stage--)
+        {
+            _shift[stage - 1] = _shift[stage - 2];
+        }
+        if (!_shift.empty())
+        {
+            _shift[0] = txData[i];
+        }
+        if (rxData != nullptr)
+        {
+            rxData[i] = out;
+        }
+    }
+    _outputs = _shift; // chip select rises, RCLK latches
+    _stats.transactions++;
+    _stats.bytes += static_cast<uint32_t>(length);
+    return ERROR_SUCCESS;
+}
+
+uint64_t com_shiftRegisterSim::getOutputs()
+{
+    uint64_t outputs = 0;
+    for (size_t i = 0; i < _outputs.size() && i < sizeof(outputs); i++)
+    {
+        outputs |= static_cast<uint64_t>(_outputs[i]) << (i * 8);
+    }
+    return outputs;
+}
+
+busStats_t com_shiftRegisterSim::getStats()
+{
+    return _stats;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file com_shiftRegisterSim.hpp
+ * @brief Header file for com_shiftRegisterSim
+ *
+ * This file contains declarations for the com_shiftRegisterSim class and related data types and functions.
+ */
+
+#ifndef COM_SHIFTREGISTERSIM_HPP
+#define COM_SHIFTREGISTERSIM_HPP
+
+#include "HAL/IHal.h"
+#include <vector>
+
+/**
+ * @brief Bus activity of a simulated device
+ */
+typedef struct
+{
+    uint32_t transactions;
+    uint32_t bytes;
+} busStats_t;
+
+/**
+ * @brief Host simulation of a 74HC595 chain on an SPI device, chip select driving the latch
+ * Bytes ripple through the chain while they are shifted in, the outputs change when the transaction ends.
+ */
+class com_shiftRegisterSim : public IHAL_SPI
+{
+private:
+    std::vector<uint8_t> _shift;   // shift stages, index 0 is the register on MOSI
+    std::vector<uint8_t> _outputs; // latched outputs
+    busStats_t           _stats;
+
+public:
+    /**
+     * @brief Construct a new com_shiftRegisterSim object
+     *
+     * @param registers - number of registers in the chain
+     */
+    explicit com_shiftRegisterSim(size_t registers);
+    ~com_shiftRegisterSim();
+
+    sys_error_t transfer(const uint8_t* txData, uint8_t* rxData, size_t length) override;
+
+    /**
+     * @brief Latched outputs, bit n is output n%8 of register n/8
+     */
+    uint64_t getOutputs();
+
+    busStats_t getStats();
+};
+
+#endif /* COM_SHIFTREGISTERSIM_HPP */
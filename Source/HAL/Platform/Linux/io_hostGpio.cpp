@@ -0,0 +1,25 @@
+/**
+ * @file io_hostGpio.cpp
+ * @brief Source file for io_hostGpio
+ *
+ * This file contains definitions for the io_hostGpio class and related data types and functions.
+ */
+
+#include "io_hostGpio.hpp"
+
+namespace
+{
+hostGpioRegisters_t registers = {0, 0, 0};
+} // namespace
+
+hostGpioRegisters_t& hostGpio()
+{
+    return registers;
+}
+
+void hostGpioReset()
+{
+    registers.in     = 0;
+    registers.out    = 0;
+    registers.writes = 0;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file io_hostGpio.hpp
+ * @brief Header file for io_hostGpio
+ *
+ * This file contains declarations for the io_hostGpio class and related data types and functions.
+ */
+
+#ifndef IO_HOSTGPIO_HPP
+#define IO_HOSTGPIO_HPP
+
+#include "HAL/Common/io_pin.hpp"
+
+#define HOST_GPIO_PIN_COUNT 64
+
+/**
+ * @brief Emulated GPIO registers of the host, one bit per pin
+ * Tests drive the inputs through "in" and observe the outputs in "out".
+ */
+typedef struct
+{
+    volatile uint64_t in;     // input levels
+    volatile uint64_t out;    // output levels
+    volatile uint32_t writes; // register writes, a write of several pins counts once
+} hostGpioRegisters_t;
+
+/**
+ * @brief The emulated register bank
+ */
+hostGpioRegisters_t& hostGpio();
+
+/**
+ * @brief Clear all levels and counters
+ */
+void hostGpioReset();
+
+/**
+ * @brief Host pin on the emulated registers, the counterpart of io_fastGpio
+ *
+ * @tparam Number - pin number
+ * @tparam Direction - pin direction
+ */
+template <uint8_t Number, io_direction_t Direction> class io_hostGpio : public io_pin<io_hostGpio<Number, Direction>>
+{
+    static_assert(Number < HOST_GPIO_PIN_COUNT, "io_hostGpio: invalid pin number");
+
+    static constexpr uint64_t mask = static_cast<uint64_t>(1) << Number;
+
+public:
+    static constexpr io_direction_t direction = Direction;
+
+    /**
+     * @brief Inputs read the "in" register, outputs read back what they drive
+     */
+    static inline uint8_t readLevel()
+    {
+        return (((Direction == IO_DIRECTION_OUTPUT) ? hostGpio().out : hostGpio().in) & mask) != 0 ? 1 : 0;
+    }
+
+    static inline void writeLevel(uint8_t level)
+    {
+        hostGpioRegisters_t& registers = hostGpio();
+        registers.out                  = (level != 0) ? (registers.out | mask) : (registers.out & ~mask);
+        registers.writes               = registers.writes + 1;
+    }
+};
+
+#endif /* IO_HOSTGPIO_HPP */
@@ -0,0 +1,28 @@
+/**
+ * @file io_hostGpioPort.cpp
+ * @brief Source file for io_hostGpioPort
+ *
+ * This file contains definitions for the io_hostGpioPort class and related data types and functions.
+ */
+
+#include "io_hostGpioPort.hpp"
+
+io_hostGpioPort::io_hostGpioPort(io_portMask_t outputMask, io_portMask_t inputMask) : io_port(outputMask, inputMask) {}
+
+io_hostGpioPort::~io_hostGpioPort()
+{
+    // destructor implementation
+}
+
+io_portMask_t io_hostGpioPort::readPins(io_portMask_t mask)
+{
+    return hostGpio().in;
+}
+
+sys_error_t io_hostGpioPort::writePins(io_portMask_t setBits, io_portMask_t clearBits, io_portMask_t levels)
+{
+    hostGpioRegisters_t& registers = hostGpio();
+    registers.out                  = (registers.out & ~clearBits) | setBits;
+    registers.writes               = registers.writes + 1;
+    return ERROR_SUCCESS;
+}
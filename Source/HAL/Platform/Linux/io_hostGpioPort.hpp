@@ -0,0 +1,29 @@
+/**
+ * @file io_hostGpioPort.hpp
+ * @brief Header file for io_hostGpioPort
+ *
+ * This file contains declarations for the io_hostGpioPort class and related data types and functions.
+ */
+
+#ifndef IO_HOSTGPIOPORT_HPP
+#define IO_HOSTGPIOPORT_HPP
+
+#include "HAL/Common/io_port.hpp"
+#include "io_hostGpio.hpp"
+
+/**
+ * @brief io_port on the emulated host GPIO bank, the counterpart of io_gpioPort
+ * Every write is a single store of the "out" register and counts once in hostGpio().writes.
+ */
+class io_hostGpioPort : public io_port
+{
+protected:
+    io_portMask_t readPins(io_portMask_t mask) override;
+    sys_error_t   writePins(io_portMask_t setBits, io_portMask_t clearBits, io_portMask_t levels) override;
+
+public:
+    io_hostGpioPort(io_portMask_t outputMask, io_portMask_t inputMask);
+    ~io_hostGpioPort();
+};
+
+#endif /* IO_HOSTGPIOPORT_HPP */
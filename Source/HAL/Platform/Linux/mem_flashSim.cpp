@@ -0,0 +1,232 @@
+/**
+ * @file mem_flashSim.cpp
+ * @brief Source file for mem_flashSim
+ *
+ * This file contains definitions for the mem_flashSim class and related data types and functions.
+ */
+
+#include "mem_flashSim.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <string.h>
+
+namespace
+{
+constexpr uint8_t erasedValue = 0xFF;
+
+uint64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+} // namespace
+
+memGeometry_t memDefaultGeometry(size_t size)
+{
+    memGeometry_t geometry = {size, 4096, 256, true};
+    return geometry;
+}
+
+memTiming_t memDefaultTiming()
+{
+    memTiming_t timing = {25, 700000, 45000000}; // 40 MB/s read, 0.7 ms page program, 45 ms sector erase
+    return timing;
+}
+
+mem_flashSim::mem_flashSim(const memGeometry_t& geometry, const memTiming_t& timing)
+    : _geometry(geometry), _timing(timing), _stats(), _memory(nullptr), _writesUntilFault(-1), _tornBytes(0), _erasesUntilFault(-1), _bitFlipAddress(0), _bitFlipMask(0)
+{
+    if (_geometry.sectorSize > 0)
+    {
+        _sectorErases.assign(_geometry.size / _geometry.sectorSize, 0);
+    }
+}
+
+mem_flashSim::~mem_flashSim()
+{
+    // destructor implementation
+}
+
+bool mem_flashSim::readData(uint32_t address, uint8_t* data, size_t length)
+{
+    if (data == nullptr || !isInRange(address, length))
+    {
+        return false;
+    }
+
+    uint64_t start = nowNs();
+    memcpy(data, _memory + address, length);
+    if (_bitFlipMask != 0 && _bitFlipAddress >= address && _bitFlipAddress - address < length)
+    {
+        data[_bitFlipAddress - address] ^= _bitFlipMask;
+    }
+
+    _stats.readOps++;
+    _stats.bytesRead += length;
+    _stats.simulatedNs += static_cast<uint64_t>(_timing.readNsPerByte) * length;
+    _stats.hostReadNs += nowNs() - start;
+    return true;
+}
+
+bool mem_flashSim::writeData(uint32_t address, const uint8_t* data, size_t length)
+{
+    if (data == nullptr || !isInRange(address, length))
+    {
+        return false;
+    }
+
+    uint64_t start = nowNs();
+    bool     fault = false;
+    if (_writesUntilFault == 0)
+    {
+        // Power loss in the middle of the write, only the first bytes make it
+        _writesUntilFault = -1;
+        fault             = true;
+        length            = (_tornBytes < length) ? _tornBytes : length;
+        _stats.injectedFaults++;
+    }
+    else if (_writesUntilFault > 0)
+    {
+        _writesUntilFault--;
+    }
+
+    program(address, data, length);
+    _stats.hostWriteNs += nowNs() - start;
+    return !fault;
+}
+
+bool mem_flashSim::erase()
+{
+    if (_memory == nullptr)
+    {
+        return false;
+    }
+    return eraseRange(0, _sectorErases.size());
+}
+
+bool mem_flashSim::eraseSector(uint32_t address)
+{
+    if (!isInRange(address, 1))
+    {
+        return false;
+    }
+    return eraseRange(address / _geometry.sectorSize, 1);
+}
+
+size_t mem_flashSim::getSize()
+{
+    return _geometry.size;
+}
+
+size_t mem_flashSim::getSectorSize()
+{
+    return _geometry.sectorSize;
+}
+
+size_t mem_flashSim::getPageSize()
+{
+    return _geometry.pageSize;
+}
+
+memStats_t mem_flashSim::getStats()
+{
+    return _stats;
+}
+
+void mem_flashSim::resetStats()
+{
+    memStats_t cleared = {};
+    _stats             = cleared;
+    std::fill(_sectorErases.begin(), _sectorErases.end(), 0);
+}
+
+uint32_t mem_flashSim::getSectorEraseCount(uint32_t sector)
+{
+    return (sector < _sectorErases.size()) ? _sectorErases[sector] : 0;
+}
+
+void mem_flashSim::injectWriteFault(uint32_t writesBeforeFault, size_t tornBytes)
+{
+    _writesUntilFault = static_cast<int32_t>(writesBeforeFault);
+    _tornBytes        = tornBytes;
+}
+
+void mem_flashSim::injectEraseFault(uint32_t erasesBeforeFault)
+{
+    _erasesUntilFault = static_cast<int32_t>(erasesBeforeFault);
+}
+
+void mem_flashSim::injectReadBitFlip(uint32_t address, uint8_t mask)
+{
+    _bitFlipAddress = address;
+    _bitFlipMask    = mask;
+}
+
+void mem_flashSim::clearFaults()
+{
+    _writesUntilFault = -1;
+    _erasesUntilFault = -1;
+    _bitFlipMask      = 0;
+}
+
+bool mem_flashSim::isInRange(uint32_t address, size_t length)
+{
+    return _memory != nullptr && address <= _geometry.size && length <= _geometry.size - address;
+}
+
+void mem_flashSim::program(uint32_t address, const uint8_t* data, size_t length)
+{
+    if (length == 0)
+    {
+        return;
+    }
+
+    uint8_t* target = _memory + address;
+    if (_geometry.norSemantics)
+    {
+        bool conflict = false;
+        for (size_t i = 0; i < length; i++)
+        {
+            conflict |= (data[i] & ~target[i]) != 0;
+            target[i] &= data[i];
+        }
+        _stats.bitConflicts += conflict ? 1 : 0;
+    }
+    else
+    {
+        memcpy(target, data, length);
+    }
+
+    size_t pageSize = (_geometry.pageSize > 0) ? _geometry.pageSize : _geometry.size;
+    size_t pages    = (address + length - 1) / pageSize - address / pageSize + 1;
+    _stats.writeOps++;
+    _stats.pagePrograms += pages;
+    _stats.bytesWritten += length;
+    _stats.simulatedNs += static_cast<uint64_t>(_timing.programNsPerPage) * pages;
+}
+
+bool mem_flashSim::eraseRange(uint32_t firstSector, size_t sectors)
+{
+    uint64_t start = nowNs();
+    if (_erasesUntilFault == 0)
+    {
+        _erasesUntilFault = -1;
+        _stats.injectedFaults++;
+        return false;
+    }
+    else if (_erasesUntilFault > 0)
+    {
+        _erasesUntilFault--;
+    }
+
+    memset(_memory + firstSector * _geometry.sectorSize, erasedValue, sectors * _geometry.sectorSize);
+    for (size_t sector = firstSector; sector < firstSector + sectors; sector++)
+    {
+        _sectorErases[sector]++;
+    }
+
+    _stats.eraseOps += sectors;
+    _stats.simulatedNs += static_cast<uint64_t>(_timing.eraseNsPerSector) * sectors;
+    _stats.hostEraseNs += nowNs() - start;
+    return true;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file mem_flashSim.hpp
+ * @brief Header file for mem_flashSim
+ *
+ * This file contains declarations for the mem_flashSim class and related data types and functions.
+ */
+
+#ifndef MEM_FLASHSIM_HPP
+#define MEM_FLASHSIM_HPP
+
+#include "HAL/IHal.h"
+#include <vector>
+
+/**
+ * @brief Geometry of a simulated memory device
+ */
+typedef struct
+{
+    size_t size;         // device size in bytes, multiple of sectorSize
+    size_t sectorSize;   // erase granularity in bytes
+    size_t pageSize;     // program granularity in bytes, used for page program counting and timing
+    bool   norSemantics; // writes can only clear bits (1 -> 0), only a sector erase sets them back
+} memGeometry_t;
+
+/**
+ * @brief Timing model of a simulated memory device
+ * The resulting time is accumulated in memStats_t::simulatedNs, nothing sleeps,
+ * so benchmarks on top of the device stay deterministic.
+ */
+typedef struct
+{
+    uint32_t readNsPerByte;    // SPI read throughput
+    uint32_t programNsPerPage; // page program time
+    uint32_t eraseNsPerSector; // sector erase time
+} memTiming_t;
+
+/**
+ * @brief Operation counters of a simulated memory device
+ */
+typedef struct
+{
+    uint32_t readOps;
+    uint32_t writeOps;
+    uint32_t eraseOps;       // sector erases, a full device erase counts every sector
+    uint32_t pagePrograms;   // pages touched by writes
+    uint32_t bitConflicts;   // writes that tried to turn a programmed 0 bit back into 1
+    uint32_t injectedFaults; // operations failed on purpose
+    uint64_t bytesRead;
+    uint64_t bytesWritten;
+    uint64_t hostReadNs;  // measured wall time spent in readData()
+    uint64_t hostWriteNs; // measured wall time spent in writeData()
+    uint64_t hostEraseNs; // measured wall time spent in erase()/eraseSector()
+    uint64_t simulatedNs; // time the operations would take according to memTiming_t
+} memStats_t;
+
+/**
+ * @brief Default geometry: 4 KiB sectors and 256 byte pages like the ESP32 SPI NOR flash
+ */
+memGeometry_t memDefaultGeometry(size_t size);
+
+/**
+ * @brief Default timing of a typical 80 MHz quad SPI NOR flash
+ */
+memTiming_t memDefaultTiming();
+
+/**
+ * @brief Host simulation of a NOR flash on top of a memory buffer
+ * Backends provide the buffer in initialize(). Erased memory reads as 0xFF.
+ * Faults can be injected to test power loss handling of storage code.
+ */
+class mem_flashSim : public IHAL_MEM
+{
+protected:
+    memGeometry_t         _geometry;
+    memTiming_t           _timing;
+    memStats_t            _stats;
+    uint8_t*              _memory; // set by the backend in initialize()
+    std::vector<uint32_t> _sectorErases;
+
+private:
+    int32_t  _writesUntilFault; // -1 = no fault armed
+    size_t   _tornBytes;
+    int32_t  _erasesUntilFault; // -1 = no fault armed
+    uint32_t _bitFlipAddress;
+    uint8_t  _bitFlipMask;
+
+    bool isInRange(uint32_t address, size_t length);
+    void program(uint32_t address, const uint8_t* data, size_t length);
+    bool eraseRange(uint32_t firstSector, size_t sectors);
+
+public:
+    /**
+     * @brief Construct a new mem_flashSim object
+     *
+     * @param geometry - device geometry
+     * @param timing - timing model (default memDefaultTiming())
+     */
+    mem_flashSim(const memGeometry_t& geometry, const memTiming_t& timing = memDefaultTiming());
+    virtual ~mem_flashSim();
+
+    bool   readData(uint32_t address, uint8_t* data, size_t length) override;
+    bool   writeData(uint32_t address, const uint8_t* data, size_t length) override;
+    bool   erase() override;
+    bool   eraseSector(uint32_t address) override;
+    size_t getSize() override;
+    size_t getSectorSize() override;
+
+    /**
+     * @brief Get the page size
+     *
+     * @return size_t
+     */
+    size_t getPageSize();
+
+    /**
+     * @brief Get the operation counters
+     *
+     * @return memStats_t
+     */
+    memStats_t getStats();
+
+    /**
+     * @brief Reset the operation counters, per sector erase counts included
+     */
+    void resetStats();
+
+    /**
+     * @brief Get how often a sector was erased
+     *
+     * @param sector - sector index
+     * @return uint32_t
+     */
+    uint32_t getSectorEraseCount(uint32_t sector);
+
+    /**
+     * @brief Fail a future write to simulate a power loss
+     *
+     * @param writesBeforeFault - number of writes that still succeed
+     * @param tornBytes - bytes of the failing write that are programmed before it fails
+     */
+    void injectWriteFault(uint32_t writesBeforeFault, size_t tornBytes = 0);
+
+    /**
+     * @brief Fail a future sector erase, the sector is left untouched
+     *
+     * @param erasesBeforeFault - number of erases that still succeed
+     */
+    void injectEraseFault(uint32_t erasesBeforeFault);
+
+    /**
+     * @brief Flip bits of one byte on every read, the stored data is not changed
+     *
+     * @param address - address of the byte
+     * @param mask - bits to flip, 0 disables the fault
+     */
+    void injectReadBitFlip(uint32_t address, uint8_t mask);
+
+    /**
+     * @brief Disarm all injected faults
+     */
+    void clearFaults();
+};
+
+#endif /* MEM_FLASHSIM_HPP */
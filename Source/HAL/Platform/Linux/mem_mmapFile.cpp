@@ -0,0 +1,94 @@
+/**
+ * @file mem_mmapFile.cpp
+ * @brief Source file for mem_mmapFile
+ *
+ * This file contains definitions for the mem_mmapFile class and related data types and functions.
+ */
+
+#include "mem_mmapFile.hpp"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+memGeometry_t fileGeometry(size_t size, size_t sectorSize)
+{
+    memGeometry_t geometry = memDefaultGeometry(size);
+    geometry.sectorSize    = sectorSize;
+    return geometry;
+}
+} // namespace
+
+mem_mmapFile::mem_mmapFile(const char* path, const memGeometry_t& geometry, const memTiming_t& timing) : mem_flashSim(geometry, timing), _path(path), _fd(-1) {}
+
+mem_mmapFile::mem_mmapFile(const char* path, size_t size, size_t sectorSize) : mem_flashSim(fileGeometry(size, sectorSize)), _path(path), _fd(-1) {}
+
+mem_mmapFile::~mem_mmapFile()
+{
+    if (_memory != nullptr)
+    {
+        msync(_memory, _geometry.size, MS_SYNC);
+        munmap(_memory, _geometry.size);
+    }
+    if (_fd >= 0)
+    {
+        close(_fd);
+    }
+}
+
+bool mem_mmapFile::initialize()
+{
+    if (_memory != nullptr)
+    {
+        return true;
+    }
+    if (_geometry.size == 0 || _geometry.sectorSize == 0 || (_geometry.size % _geometry.sectorSize) != 0)
+    {
+        return false;
+    }
+
+    _fd = open(_path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (_fd < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(_fd, &fileStat) != 0 || ftruncate(_fd, _geometry.size) != 0)
+    {
+        close(_fd);
+        _fd = -1;
+        return false;
+    }
+
+    void* memory = mmap(nullptr, _geometry.size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+    if (memory == MAP_FAILED)
+    {
+        close(_fd);
+        _fd = -1;
+        return false;
+    }
+    _memory = static_cast<uint8_t*>(memory);
+
+    // Newly created or grown regions read as erased flash
+    size_t existing = static_cast<size_t>(fileStat.st_size);
+    if (existing < _geometry.size)
+    {
+        memset(_memory + existing, 0xFF, _geometry.size - existing);
+    }
+    return true;
+}
+
+bool mem_mmapFile::sync()
+{
+    return _memory != nullptr && msync(_memory, _geometry.size, MS_SYNC) == 0;
+}
+
+uint8_t* mem_mmapFile::getMapping()
+{
+    return _memory;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file mem_mmapFile.hpp
+ * @brief Header file for mem_mmapFile
+ *
+ * This file contains declarations for the mem_mmapFile class and related data types and functions.
+ */
+
+#ifndef MEM_MMAPFILE_HPP
+#define MEM_MMAPFILE_HPP
+
+#include "mem_flashSim.hpp"
+#include <string>
+
+/**
+ * @brief Host flash simulation backed by a memory-mapped file
+ * The file keeps its content between runs, so storage built on IHAL_MEM survives a "reboot" of the host simulation.
+ */
+class mem_mmapFile : public mem_flashSim
+{
+private:
+    std::string _path;
+    int         _fd;
+
+public:
+    /**
+     * @brief Construct a new mem_mmapFile object
+     *
+     * @param path - backing file, created if it does not exist
+     * @param geometry - device geometry
+     * @param timing - timing model (default memDefaultTiming())
+     */
+    mem_mmapFile(const char* path, const memGeometry_t& geometry, const memTiming_t& timing = memDefaultTiming());
+
+    /**
+     * @brief Construct a new mem_mmapFile object with NOR semantics and 256 byte pages
+     *
+     * @param path - backing file, created if it does not exist
+     * @param size - device size in bytes, must be a multiple of sectorSize
+     * @param sectorSize - erase granularity in bytes (default 4096)
+     */
+    mem_mmapFile(const char* path, size_t size, size_t sectorSize = 4096);
+    ~mem_mmapFile();
+
+    // Delete copy constructor and assignment operator
+    mem_mmapFile(const mem_mmapFile&)            = delete;
+    mem_mmapFile& operator=(const mem_mmapFile&) = delete;
+
+    bool initialize() override;
+
+    /**
+     * @brief Flush the mapping to the backing file
+     *
+     * @return bool True if the file is in sync
+     */
+    bool sync();
+
+    /**
+     * @brief Get the mapping itself, e.g. as the retained region of the flight recorder
+     * Writes through it bypass the flash model; they still reach the file if the process crashes.
+     *
+     * @return uint8_t* nullptr before initialize()
+     */
+    uint8_t* getMapping();
+};
+
+#endif /* MEM_MMAPFILE_HPP */
@@ -0,0 +1,32 @@
+/**
+ * @file mem_ramDisk.cpp
+ * @brief Source file for mem_ramDisk
+ *
+ * This file contains definitions for the mem_ramDisk class and related data types and functions.
+ */
+
+#include "mem_ramDisk.hpp"
+
+mem_ramDisk::mem_ramDisk(const memGeometry_t& geometry, const memTiming_t& timing) : mem_flashSim(geometry, timing) {}
+
+mem_ramDisk::~mem_ramDisk()
+{
+    // destructor implementation
+}
+
+bool mem_ramDisk::initialize()
+{
+    if (_memory != nullptr)
+    {
+        return true;
+    }
+    if (_geometry.size == 0 || _geometry.sectorSize == 0 || (_geometry.size % _geometry.sectorSize) != 0)
+    {
+        return false;
+    }
+
+    // Starts out erased, allocated once so the content survives re-initialization
+    _storage.assign(_geometry.size, 0xFF);
+    _memory = _storage.data();
+    return true;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file mem_ramDisk.hpp
+ * @brief Header file for mem_ramDisk
+ *
+ * This file contains declarations for the mem_ramDisk class and related data types and functions.
+ */
+
+#ifndef MEM_RAMDISK_HPP
+#define MEM_RAMDISK_HPP
+
+#include "mem_flashSim.hpp"
+
+/**
+ * @brief Host flash simulation held in RAM
+ * The content lives as long as the object, so a storage layer can be "rebooted"
+ * by creating it again on the same device, e.g. after an injected fault.
+ */
+class mem_ramDisk : public mem_flashSim
+{
+private:
+    std::vector<uint8_t> _storage;
+
+public:
+    /**
+     * @brief Construct a new mem_ramDisk object
+     *
+     * @param geometry - device geometry
+     * @param timing - timing model (default memDefaultTiming())
+     */
+    mem_ramDisk(const memGeometry_t& geometry, const memTiming_t& timing = memDefaultTiming());
+    ~mem_ramDisk();
+
+    bool initialize() override;
+};
+
+#endif /* MEM_RAMDISK_HPP */
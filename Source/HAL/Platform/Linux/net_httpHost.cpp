@@ -0,0 +1,418 @@
+/**
+ * @file net_httpHost.cpp
+ * @brief Source file for net_httpHost
+ *
+ * This file contains definitions for the net_httpHost class and related data types and functions.
+ */
+
+#include "net_httpHost.hpp"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+constexpr size_t maxRequestSize = 64 * 1024; // headers and body, larger requests are rejected
+constexpr int    maxEvents      = 64;
+constexpr size_t readChunk      = 4096;
+
+const char* statusText(int status)
+{
+    switch (status)
+    {
+        case 200:
+            return "OK";
+        case 400:
+            return "Bad Request";
+        case 404:
+            return "Not Found";
+        case 408:
+            return "Request Timeout";
+        case 413:
+            return "Payload Too Large";
+        case 500:
+            return "Internal Server Error";
+        default:
+            return "Unknown";
+    }
+}
+
+void setNonBlocking(int fd)
+{
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+// Value of a header inside the header block, empty if missing
+std::string headerValue(const std::string& headers, const char* name)
+{
+    size_t nameLength = strlen(name);
+    size_t line       = headers.find("\r\n");
+    while (line != std::string::npos && line + 2 < headers.size())
+    {
+        size_t start = line + 2;
+        size_t end   = headers.find("\r\n", start);
+        if (end == std::string::npos)
+        {
+            end = headers.size();
+        }
+        if (end - start > nameLength && headers[start + nameLength] == ':' && strncasecmp(headers.c_str() + start, name, nameLength) == 0)
+        {
+            size_t value = headers.find_first_not_of(' ', start + nameLength + 1);
+            return (value < end) ? headers.substr(value, end - value) : std::string();
+        }
+        line = end;
+    }
+    return std::string();
+}
+} // namespace
+
+bool httpHostQueryValue(const std::string& query, const char* key, std::string& value)
+{
+    size_t keyLength = strlen(key);
+    size_t start     = 0;
+    while (start <= query.size())
+    {
+        size_t end = query.find('&', start);
+        if (end == std::string::npos)
+        {
+            end = query.size();
+        }
+        if (end - start > keyLength && query[start + keyLength] == '=' && query.compare(start, keyLength, key) == 0)
+        {
+            value = query.substr(start + keyLength + 1, end - start - keyLength - 1);
+            return true;
+        }
+        start = end + 1;
+    }
+    return false;
+}
+
+net_httpHost::net_httpHost(uint16_t port, size_t maxConnections) : _port(port), _maxConnections(maxConnections), _listenFd(-1), _epollFd(-1), _wakeFd(-1), _running(false), _stats() {}
+
+net_httpHost::~net_httpHost()
+{
+    stop();
+}
+
+sys_error_t net_httpHost::addUriHandler(const char* uri, const char* method, httpHostHandler_t handler)
+{
+    if (_running || uri == nullptr || method == nullptr)
+    {
+        return ERROR_INVALID_ARG;
+    }
+    route_t route = {method, uri, handler};
+    _routes.push_back(route);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t net_httpHost::start()
+{
+    if (_running)
+    {
+        return ERROR_SUCCESS;
+    }
+
+    _listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    int reuse = 1;
+    setsockopt(_listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in address = {};
+    address.sin_family         = AF_INET;
+    address.sin_port           = htons(_port);
+    address.sin_addr.s_addr    = htonl(INADDR_LOOPBACK);
+    if (bind(_listenFd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0 || listen(_listenFd, SOMAXCONN) != 0)
+    {
+        close(_listenFd);
+        _listenFd = -1;
+        return ERROR_CONNECTION_FAILED;
+    }
+    socklen_t length = sizeof(address);
+    getsockname(_listenFd, reinterpret_cast<struct sockaddr*>(&address), &length);
+    _port = ntohs(address.sin_port);
+    setNonBlocking(_listenFd);
+
+    _epollFd = epoll_create1(0);
+    _wakeFd  = eventfd(0, EFD_NONBLOCK);
+
+    struct epoll_event event = {};
+    event.events             = EPOLLIN;
+    event.data.ptr           = nullptr; // listening socket
+    epoll_ctl(_epollFd, EPOLL_CTL_ADD, _listenFd, &event);
+    event.data.ptr = this; // wake up
+    epoll_ctl(_epollFd, EPOLL_CTL_ADD, _wakeFd, &event);
+
+    _running = true;
+    _thread  = std::thread(&net_httpHost::serve, this);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t net_httpHost::stop()
+{
+    if (!_running)
+    {
+        return ERROR_SUCCESS;
+    }
+    _running       = false;
+    uint64_t value = 1;
+    if (write(_wakeFd, &value, sizeof(value)) < 0)
+    {
+        // the thread still sees _running on its next wake up
+    }
+    _thread.join();
+
+    close(_wakeFd);
+    close(_epollFd);
+    close(_listenFd);
+    _wakeFd   = -1;
+    _epollFd  = -1;
+    _listenFd = -1;
+    return ERROR_SUCCESS;
+}
+
+uint16_t net_httpHost::getPort()
+{
+    return _port;
+}
+
+httpHostStats_t net_httpHost::getStats()
+{
+    std::lock_guard<std::mutex> lock(_statsMutex);
+    return _stats;
+}
+
+void net_httpHost::serve()
+{
+    std::vector<connection_t*> connections;
+    struct epoll_event         events[maxEvents];
+
+    while (_running)
+    {
+        int count = epoll_wait(_epollFd, events, maxEvents, -1);
+        for (int i = 0; i < count && _running; i++)
+        {
+            if (events[i].data.ptr == nullptr)
+            {
+                acceptConnections(connections);
+                continue;
+            }
+            if (events[i].data.ptr == this)
+            {
+                continue;
+            }
+
+            connection_t& connection = *static_cast<connection_t*>(events[i].data.ptr);
+            bool          open       = (events[i].events & (EPOLLERR | EPOLLHUP)) == 0;
+            if (open && (events[i].events & EPOLLIN))
+            {
+                open = handleInput(connection);
+            }
+            if (open && (events[i].events & EPOLLOUT))
+            {
+                open = flushOutput(connection);
+            }
+            if (!open)
+            {
+                epoll_ctl(_epollFd, EPOLL_CTL_DEL, connection.fd, nullptr);
+                close(connection.fd);
+                connection.fd = -1;
+            }
+        }
+
+        // Connections are freed after the batch, a later event of the batch may still point to them
+        for (size_t i = 0; i < connections.size();)
+        {
+            if (connections[i]->fd < 0)
+            {
+                delete connections[i];
+                connections[i] = connections.back();
+                connections.pop_back();
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+
+    for (connection_t* connection : connections)
+    {
+        close(connection->fd);
+        delete connection;
+    }
+}
+
+void net_httpHost::acceptConnections(std::vector<connection_t*>& connections)
+{
+    for (;;)
+    {
+        int fd = accept(_listenFd, nullptr, nullptr);
+        if (fd < 0)
+        {
+            return;
+        }
+        if (connections.size() >= _maxConnections)
+        {
+            close(fd);
+            continue;
+        }
+        setNonBlocking(fd);
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        connection_t* connection = new connection_t{fd, std::string(), std::string(), 0, false};
+        connections.push_back(connection);
+
+        struct epoll_event event = {};
+        event.events             = EPOLLIN | EPOLLOUT | EPOLLET;
+        event.data.ptr           = connection;
+        epoll_ctl(_epollFd, EPOLL_CTL_ADD, fd, &event);
+
+        std::lock_guard<std::mutex> lock(_statsMutex);
+        _stats.connections++;
+    }
+}
+
+bool net_httpHost::handleInput(connection_t& connection)
+{
+    // Edge triggered: drain the socket
+    char buffer[readChunk];
+    for (;;)
+    {
+        ssize_t received = read(connection.fd, buffer, sizeof(buffer));
+        if (received > 0)
+        {
+            connection.input.append(buffer, static_cast<size_t>(received));
+            continue;
+        }
+        if (received == 0)
+        {
+            return false; // closed by the client
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            break;
+        }
+        return false;
+    }
+
+    // Answer every complete request, pipelined ones included
+    for (;;)
+    {
+        size_t headerEnd = connection.input.find("\r\n\r\n");
+        if (headerEnd == std::string::npos)
+        {
+            if (connection.input.size() > maxRequestSize)
+            {
+                break;
+            }
+            return flushOutput(connection);
+        }
+
+        std::string headers = connection.input.substr(0, headerEnd + 2);
+        size_t      lineEnd = headers.find("\r\n");
+        size_t      space1  = headers.find(' ');
+        size_t      space2  = (space1 < lineEnd) ? headers.find(' ', space1 + 1) : std::string::npos;
+        if (space2 == std::string::npos || space2 > lineEnd || !headerValue(headers, "Transfer-Encoding").empty())
+        {
+            break;
+        }
+
+        size_t contentLength = strtoul(headerValue(headers, "Content-Length").c_str(), nullptr, 10);
+        size_t requestSize   = headerEnd + 4 + contentLength;
+        if (contentLength > maxRequestSize)
+        {
+            break;
+        }
+        if (connection.input.size() < requestSize)
+        {
+            return flushOutput(connection); // body still on its way
+        }
+
+        httpHostRequest_t request;
+        std::string       target  = headers.substr(space1 + 1, space2 - space1 - 1);
+        size_t            query   = target.find('?');
+        request.method            = headers.substr(0, space1);
+        request.uri               = target.substr(0, query);
+        request.query             = (query != std::string::npos) ? target.substr(query + 1) : std::string();
+        request.body              = connection.input.substr(headerEnd + 4, contentLength);
+        std::string version       = headers.substr(space2 + 1, lineEnd - space2 - 1);
+        std::string connectionHdr = headerValue(headers, "Connection");
+        bool        keepAlive     = (version == "HTTP/1.1") ? strcasecmp(connectionHdr.c_str(), "close") != 0 : strcasecmp(connectionHdr.c_str(), "keep-alive") == 0;
+        connection.input.erase(0, requestSize);
+
+        dispatch(request, keepAlive, connection);
+        if (!keepAlive)
+        {
+            connection.input.clear();
+            return flushOutput(connection);
+        }
+    }
+
+    // Malformed or oversized, answer and close like httpd does
+    {
+        std::lock_guard<std::mutex> lock(_statsMutex);
+        _stats.badRequests++;
+    }
+    connection.output += "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    connection.closeAfterOutput = true;
+    connection.input.clear();
+    return flushOutput(connection);
+}
+
+bool net_httpHost::flushOutput(connection_t& connection)
+{
+    while (connection.outputSent < connection.output.size())
+    {
+        ssize_t sent = send(connection.fd, connection.output.data() + connection.outputSent, connection.output.size() - connection.outputSent, MSG_NOSIGNAL);
+        if (sent < 0)
+        {
+            return errno == EAGAIN || errno == EWOULDBLOCK; // EPOLLOUT resumes
+        }
+        connection.outputSent += static_cast<size_t>(sent);
+    }
+    connection.output.clear();
+    connection.outputSent = 0;
+    return !connection.closeAfterOutput;
+}
+
+void net_httpHost::dispatch(const httpHostRequest_t& request, bool keepAlive, connection_t& connection)
+{
+    httpHostResponse_t response = {200, "text/html", std::string()};
+    bool               found    = false;
+    for (const route_t& route : _routes)
+    {
+        if (route.uri == request.uri && route.method == request.method)
+        {
+            route.handler(request, response);
+            found = true;
+            break;
+        }
+    }
+    if (!found)
+    {
+        response.status      = 404;
+        response.contentType = "text/plain";
+        response.body        = "Nothing matches the given URI";
+    }
+
+    char header[256];
+    snprintf(header, sizeof(header), "HTTP/1.1 %d %s\r\nContent-Type: %s\r\nContent-Length: %zu\r\n%s\r\n", response.status, statusText(response.status), response.contentType,
+             response.body.size(), keepAlive ? "" : "Connection: close\r\n");
+    connection.output += header;
+    connection.output += response.body;
+    connection.closeAfterOutput = !keepAlive;
+
+    std::lock_guard<std::mutex> lock(_statsMutex);
+    _stats.requests++;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file net_httpHost.hpp
+ * @brief Header file for net_httpHost
+ *
+ * This file contains declarations for the net_httpHost class and related data types and functions.
+ */
+
+#ifndef NET_HTTPHOST_HPP
+#define NET_HTTPHOST_HPP
+
+#include "System/error_definitions.h"
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Request as seen by a net_httpHost handler
+ */
+typedef struct
+{
+    std::string method; // "GET", "POST", ...
+    std::string uri;    // path without the query
+    std::string query;  // text after '?', empty if none
+    std::string body;
+} httpHostRequest_t;
+
+/**
+ * @brief Response filled by a net_httpHost handler, 200 text/html by default
+ */
+typedef struct
+{
+    int         status;
+    const char* contentType;
+    std::string body;
+} httpHostResponse_t;
+
+typedef std::function<void(const httpHostRequest_t& request, httpHostResponse_t& response)> httpHostHandler_t;
+
+/**
+ * @brief Request and connection counters of a net_httpHost
+ */
+typedef struct
+{
+    uint32_t connections; // accepted
+    uint32_t requests;    // answered, 404 included
+    uint32_t badRequests; // malformed, the connection is closed
+} httpHostStats_t;
+
+/**
+ * @brief Find a key in a query string or an application/x-www-form-urlencoded body, like httpd_query_key_value()
+ *
+ * @param query - "key1=value1&key2=value2"
+ * @param key - key to look for
+ * @param value - raw (not decoded) value
+ * @return true if the key was found
+ */
+bool httpHostQueryValue(const std::string& query, const char* key, std::string& value);
+
+/**
+ * @brief Minimal HTTP/1.1 server for the host
+ *
+ * Stands in for esp_http_server on Linux: URI handlers are registered per method and path, one epoll thread
+ * serves all connections, keep-alive is honoured unless the client asks for "Connection: close" or speaks HTTP/1.0.
+ * Request bodies need a Content-Length, chunked requests are rejected.
+ */
+class net_httpHost
+{
+private:
+    typedef struct
+    {
+        std::string       method;
+        std::string       uri;
+        httpHostHandler_t handler;
+    } route_t;
+
+    typedef struct
+    {
+        int         fd;
+        std::string input;
+        std::string output;
+        size_t      outputSent;
+        bool        closeAfterOutput;
+    } connection_t;
+
+    uint16_t             _port;
+    size_t               _maxConnections;
+    int                  _listenFd;
+    int                  _epollFd;
+    int                  _wakeFd;
+    std::vector<route_t> _routes;
+    std::thread          _thread;
+    std::atomic<bool>    _running;
+    std::mutex           _statsMutex;
+    httpHostStats_t      _stats;
+
+    void serve();
+    void acceptConnections(std::vector<connection_t*>& connections);
+    bool handleInput(connection_t& connection);
+    bool flushOutput(connection_t& connection);
+    void dispatch(const httpHostRequest_t& request, bool keepAlive, connection_t& connection);
+
+public:
+    /**
+     * @brief Construct a new net_httpHost object
+     *
+     * @param port - TCP port on 127.0.0.1, 0 picks a free port (see getPort())
+     * @param maxConnections - open connections at a time, like max_open_sockets (default 64)
+     */
+    explicit net_httpHost(uint16_t port = 0, size_t maxConnections = 64);
+    ~net_httpHost();
+
+    // Delete copy constructor and assignment operator
+    net_httpHost(const net_httpHost&)            = delete;
+    net_httpHost& operator=(const net_httpHost&) = delete;
+
+    /**
+     * @brief Register a handler, before start()
+     *
+     * @param uri - exact path, e.g. "/welcome"
+     * @param method - "GET", "POST", "PUT", ...
+     * @param handler - called on the server thread
+     * @return sys_error_t ERROR_INVALID_ARG if the server is running
+     */
+    sys_error_t addUriHandler(const char* uri, const char* method, httpHostHandler_t handler);
+
+    /**
+     * @brief Bind, listen and start the server thread
+     *
+     * @return sys_error_t ERROR_CONNECTION_FAILED if the port can not be bound
+     */
+    sys_error_t start();
+
+    /**
+     * @brief Close all connections and stop the server thread
+     */
+    sys_error_t stop();
+
+    /**
+     * @brief Get the port the server listens on
+     */
+    uint16_t getPort();
+
+    httpHostStats_t getStats();
+};
+
+#endif /* NET_HTTPHOST_HPP */
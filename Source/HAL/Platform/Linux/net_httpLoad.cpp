@@ -0,0 +1,380 @@
+/**
+ * @file net_httpLoad.cpp
+ * @brief Source file for net_httpLoad
+ *
+ * This file contains definitions for the net_httpLoad class and related data types and functions.
+ */
+
+#include "net_httpLoad.hpp"
+
+#include <chrono>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+constexpr int    pollIntervalMs = 10; // timeout scan period
+constexpr size_t readChunk      = 16 * 1024;
+
+typedef enum : uint8_t
+{
+    CLIENT_IDLE,
+    CLIENT_CONNECTING,
+    CLIENT_SENDING,
+    CLIENT_RECEIVING,
+} clientState_t;
+
+typedef struct
+{
+    int           fd;
+    clientState_t state;
+    size_t        sent;
+    std::string   input;
+    uint64_t      startNs;
+    uint64_t      deadlineNs;
+} client_t;
+
+typedef enum : uint8_t
+{
+    RESPONSE_INCOMPLETE,
+    RESPONSE_COMPLETE,
+    RESPONSE_MALFORMED,
+} responseState_t;
+
+uint64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Walk the chunks starting at offset, true once the last chunk and the trailer are in
+bool chunkedComplete(const std::string& input, size_t offset)
+{
+    for (;;)
+    {
+        size_t lineEnd = input.find("\r\n", offset);
+        if (lineEnd == std::string::npos)
+        {
+            return false;
+        }
+        size_t chunkSize = strtoul(input.c_str() + offset, nullptr, 16);
+        if (chunkSize == 0)
+        {
+            // Optional trailer headers end with an empty line
+            return input.find("\r\n", lineEnd + 2) != std::string::npos && input.find("\r\n\r\n", lineEnd) != std::string::npos;
+        }
+        offset = lineEnd + 2 + chunkSize + 2;
+        if (offset > input.size())
+        {
+            return false;
+        }
+    }
+}
+
+// Parse what arrived so far; closed tells whether the server closed the connection
+responseState_t parseResponse(const std::string& input, bool closed, int& status, bool& serverCloses)
+{
+    size_t headerEnd = input.find("\r\n\r\n");
+    if (headerEnd == std::string::npos)
+    {
+        return closed ? RESPONSE_MALFORMED : RESPONSE_INCOMPLETE;
+    }
+    if (input.compare(0, 5, "HTTP/") != 0 || input.find(' ') == std::string::npos)
+    {
+        return RESPONSE_MALFORMED;
+    }
+    status = atoi(input.c_str() + input.find(' ') + 1);
+
+    long   contentLength = -1;
+    bool   chunked       = false;
+    size_t line          = input.find("\r\n");
+    serverCloses         = false;
+    while (line < headerEnd)
+    {
+        size_t      next   = input.find("\r\n", line + 2);
+        std::string header = input.substr(line + 2, next - line - 2);
+        if (strncasecmp(header.c_str(), "Content-Length:", 15) == 0)
+        {
+            contentLength = strtol(header.c_str() + 15, nullptr, 10);
+        }
+        else if (strncasecmp(header.c_str(), "Transfer-Encoding:", 18) == 0)
+        {
+            chunked = header.find("chunked") != std::string::npos;
+        }
+        else if (strncasecmp(header.c_str(), "Connection:", 11) == 0)
+        {
+            serverCloses = header.find("close") != std::string::npos;
+        }
+        line = next;
+    }
+
+    size_t bodyStart = headerEnd + 4;
+    if (chunked)
+    {
+        return chunkedComplete(input, bodyStart) ? RESPONSE_COMPLETE : (closed ? RESPONSE_MALFORMED : RESPONSE_INCOMPLETE);
+    }
+    if (contentLength >= 0)
+    {
+        if (input.size() >= bodyStart + static_cast<size_t>(contentLength))
+        {
+            return RESPONSE_COMPLETE;
+        }
+        return closed ? RESPONSE_MALFORMED : RESPONSE_INCOMPLETE;
+    }
+    // Delimited by the connection close
+    serverCloses = true;
+    return closed ? RESPONSE_COMPLETE : RESPONSE_INCOMPLETE;
+}
+} // namespace
+
+httpLoadConfig_t httpLoadDefaultConfig()
+{
+    httpLoadConfig_t config = {"127.0.0.1", 80, "GET", "/", nullptr, "application/x-www-form-urlencoded", 8, 1000, true, 5000};
+    return config;
+}
+
+net_httpLoad::net_httpLoad() : _result() {}
+
+net_httpLoad::~net_httpLoad()
+{
+    // destructor implementation
+}
+
+sys_error_t net_httpLoad::run(const httpLoadConfig_t& config)
+{
+    if (config.connections == 0 || config.requests == 0 || config.host == nullptr || config.path == nullptr || config.method == nullptr)
+    {
+        return ERROR_INVALID_ARG;
+    }
+
+    struct addrinfo  hints   = {};
+    struct addrinfo* address = nullptr;
+    hints.ai_family          = AF_INET;
+    hints.ai_socktype        = SOCK_STREAM;
+    char port[8];
+    snprintf(port, sizeof(port), "%u", static_cast<unsigned>(config.port));
+    if (getaddrinfo(config.host, port, &hints, &address) != 0 || address == nullptr)
+    {
+        return ERROR_DNS_LOOKUP_FAILED;
+    }
+
+    // The request is the same for the whole run, build it once
+    std::string request    = std::string(config.method) + " " + config.path + " HTTP/1.1\r\nHost: " + config.host + ":" + port + "\r\n";
+    size_t      bodyLength = (config.body != nullptr) ? strlen(config.body) : 0;
+    if (config.body != nullptr)
+    {
+        request += std::string("Content-Type: ") + config.contentType + "\r\nContent-Length: " + std::to_string(bodyLength) + "\r\n";
+    }
+    request += config.keepAlive ? "\r\n" : "Connection: close\r\n\r\n";
+    request.append((config.body != nullptr) ? config.body : "", bodyLength);
+
+    _histogram.reset();
+    _result           = httpLoadResult_t();
+    int      epollFd  = epoll_create1(0);
+    uint64_t timeout  = static_cast<uint64_t>(config.timeoutMs) * 1000000ull;
+    uint32_t issued   = 0;
+    uint32_t finished = 0;
+
+    std::vector<client_t> clients(config.connections < config.requests ? config.connections : config.requests);
+    for (client_t& client : clients)
+    {
+        client.fd    = -1;
+        client.state = CLIENT_IDLE;
+    }
+
+    auto watch = [epollFd](client_t& client, uint32_t events)
+    {
+        struct epoll_event event = {};
+        event.events             = events;
+        event.data.ptr           = &client;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, client.fd, &event);
+    };
+
+    auto closeClient = [epollFd](client_t& client)
+    {
+        if (client.fd >= 0)
+        {
+            epoll_ctl(epollFd, EPOLL_CTL_DEL, client.fd, nullptr);
+            close(client.fd);
+            client.fd = -1;
+        }
+        client.state = CLIENT_IDLE;
+    };
+
+    // Start the next request of the run on a client, reusing its connection if there is one
+    auto begin = [&](client_t& client)
+    {
+        if (issued >= config.requests)
+        {
+            closeClient(client);
+            return;
+        }
+        issued++;
+        client.input.clear();
+        client.sent       = 0;
+        client.startNs    = nowNs();
+        client.deadlineNs = client.startNs + timeout;
+        if (client.fd >= 0)
+        {
+            client.state = CLIENT_SENDING;
+            watch(client, EPOLLOUT);
+            return;
+        }
+
+        client.fd   = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        int noDelay = 1;
+        setsockopt(client.fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        _result.connects++;
+        client.state             = CLIENT_CONNECTING;
+        struct epoll_event event = {};
+        event.events             = EPOLLOUT;
+        event.data.ptr           = &client;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, client.fd, &event);
+        if (connect(client.fd, address->ai_addr, address->ai_addrlen) != 0 && errno != EINPROGRESS)
+        {
+            client.deadlineNs = 0; // failed at once, the timeout scan reports it
+        }
+    };
+
+    auto fail = [&](client_t& client)
+    {
+        _result.errors++;
+        finished++;
+        closeClient(client);
+        begin(client);
+    };
+
+    auto complete = [&](client_t& client, int status, bool serverCloses)
+    {
+        _histogram.record(nowNs() - client.startNs);
+        _result.completed++;
+        _result.non2xx += (status < 200 || status > 299) ? 1 : 0;
+        finished++;
+        if (!config.keepAlive || serverCloses)
+        {
+            closeClient(client);
+        }
+        begin(client);
+    };
+
+    uint64_t start = nowNs();
+    for (client_t& client : clients)
+    {
+        begin(client);
+    }
+
+    struct epoll_event events[64];
+    std::vector<char>  buffer(readChunk);
+    while (finished < config.requests)
+    {
+        int count = epoll_wait(epollFd, events, 64, pollIntervalMs);
+        for (int i = 0; i < count; i++)
+        {
+            client_t& client = *static_cast<client_t*>(events[i].data.ptr);
+            if (client.fd < 0)
+            {
+                continue;
+            }
+
+            if (client.state == CLIENT_CONNECTING)
+            {
+                int       error  = 0;
+                socklen_t length = sizeof(error);
+                getsockopt(client.fd, SOL_SOCKET, SO_ERROR, &error, &length);
+                if (error != 0)
+                {
+                    fail(client);
+                    continue;
+                }
+                client.state = CLIENT_SENDING;
+                if (config.keepAlive)
+                {
+                    client.startNs = nowNs(); // keep-alive latency leaves the connection setup out
+                }
+            }
+
+            if (client.state == CLIENT_SENDING)
+            {
+                ssize_t sent = send(client.fd, request.data() + client.sent, request.size() - client.sent, MSG_NOSIGNAL);
+                if (sent < 0 && errno != EAGAIN)
+                {
+                    fail(client);
+                    continue;
+                }
+                client.sent += (sent > 0) ? static_cast<size_t>(sent) : 0;
+                if (client.sent == request.size())
+                {
+                    client.state = CLIENT_RECEIVING;
+                    watch(client, EPOLLIN);
+                }
+                continue;
+            }
+
+            if (client.state == CLIENT_RECEIVING)
+            {
+                ssize_t received = recv(client.fd, buffer.data(), buffer.size(), 0);
+                if (received < 0 && errno == EAGAIN)
+                {
+                    continue;
+                }
+                bool closed = received <= 0;
+                if (received > 0)
+                {
+                    client.input.append(buffer.data(), static_cast<size_t>(received));
+                }
+
+                int             status       = 0;
+                bool            serverCloses = false;
+                responseState_t state        = parseResponse(client.input, closed, status, serverCloses);
+                if (state == RESPONSE_COMPLETE)
+                {
+                    complete(client, status, serverCloses || closed);
+                }
+                else if (state == RESPONSE_MALFORMED || closed)
+                {
+                    fail(client);
+                }
+            }
+        }
+
+        uint64_t now = nowNs();
+        for (client_t& client : clients)
+        {
+            if (client.state != CLIENT_IDLE && now >= client.deadlineNs)
+            {
+                fail(client);
+            }
+        }
+    }
+
+    _result.elapsedNs         = nowNs() - start;
+    _result.requestsPerSecond = (_result.elapsedNs > 0) ? _result.completed * 1e9 / static_cast<double>(_result.elapsedNs) : 0.0;
+
+    for (client_t& client : clients)
+    {
+        closeClient(client);
+    }
+    close(epollFd);
+    freeaddrinfo(address);
+    return ERROR_SUCCESS;
+}
+
+const latencyHistogram& net_httpLoad::getHistogram()
+{
+    return _histogram;
+}
+
+httpLoadResult_t net_httpLoad::getResult()
+{
+    return _result;
+}
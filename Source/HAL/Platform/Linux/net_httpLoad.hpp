@@ -0,0 +1,86 @@
+/**
+ * @file net_httpLoad.hpp
+ * @brief Header file for net_httpLoad
+ *
+ * This file contains declarations for the net_httpLoad class and related data types and functions.
+ */
+
+#ifndef NET_HTTPLOAD_HPP
+#define NET_HTTPLOAD_HPP
+
+#include "Library/Diagnostics/latencyHistogram.h"
+#include "System/error_definitions.h"
+#include <stdint.h>
+#include <string>
+
+/**
+ * @brief What a net_httpLoad run sends and how
+ */
+typedef struct
+{
+    const char* host;        // IPv4 address or host name
+    uint16_t    port;        // TCP port
+    const char* method;      // "GET", "POST", ...
+    const char* path;        // request target, query included
+    const char* body;        // request body, nullptr for none
+    const char* contentType; // sent with a body
+    uint32_t    connections; // concurrent connections
+    uint32_t    requests;    // total requests of the run
+    bool        keepAlive;   // reuse connections, otherwise every request opens a new one ("Connection: close")
+    uint32_t    timeoutMs;   // per request, a timed out request counts as an error and its connection is reopened
+} httpLoadConfig_t;
+
+/**
+ * @brief Outcome of a net_httpLoad run, latencies are in the histogram
+ */
+typedef struct
+{
+    uint32_t completed; // responses received, any status
+    uint32_t non2xx;    // completed responses with a status outside 200..299
+    uint32_t errors;    // connect failures, resets, timeouts and malformed responses
+    uint32_t connects;  // connections opened
+    uint64_t elapsedNs;
+    double   requestsPerSecond; // completed / elapsed
+} httpLoadResult_t;
+
+/**
+ * @brief Default: GET / on 127.0.0.1:80 with 8 keep-alive connections, 1000 requests, 5 s timeout
+ */
+httpLoadConfig_t httpLoadDefaultConfig();
+
+/**
+ * @brief Closed-loop HTTP/1.1 load generator
+ *
+ * Keeps config.connections requests in flight on one epoll thread, each connection sends its next request as soon
+ * as the previous response is complete. The latency of a request runs from the first byte sent (keep-alive) or from
+ * the connect() call (non keep-alive) to the last byte of the response, recorded in nanoseconds.
+ * Responses are delimited by Content-Length, chunked encoding or the connection close.
+ */
+class net_httpLoad
+{
+private:
+    latencyHistogram _histogram;
+    httpLoadResult_t _result;
+
+public:
+    net_httpLoad();
+    ~net_httpLoad();
+
+    // Delete copy constructor and assignment operator
+    net_httpLoad(const net_httpLoad&)            = delete;
+    net_httpLoad& operator=(const net_httpLoad&) = delete;
+
+    /**
+     * @brief Run the load, blocks until all requests are answered or failed
+     *
+     * @param config - load description
+     * @return sys_error_t ERROR_DNS_LOOKUP_FAILED if the host can not be resolved, ERROR_INVALID_ARG for an empty run;
+     * request failures are counted in the result, not returned
+     */
+    sys_error_t run(const httpLoadConfig_t& config);
+
+    const latencyHistogram& getHistogram();
+    httpLoadResult_t        getResult();
+};
+
+#endif /* NET_HTTPLOAD_HPP */
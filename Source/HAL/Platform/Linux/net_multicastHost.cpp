@@ -0,0 +1,121 @@
+/**
+ * @file net_multicastHost.cpp
+ * @brief Source file for net_multicastHost
+ *
+ * This file contains definitions for the net_multicastHost class and related data types and functions.
+ */
+
+#include "net_multicastHost.hpp"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+net_multicastHost::net_multicastHost(const char* group, uint16_t port, const char* interfaceAddress) : _group(group), _port(port), _interface(interfaceAddress), _fd(-1) {}
+
+net_multicastHost::~net_multicastHost()
+{
+    disconnect();
+}
+
+sys_error_t net_multicastHost::connect()
+{
+    if (_fd >= 0)
+    {
+        return ERROR_SUCCESS;
+    }
+
+    ip_mreq membership = {};
+    if (inet_pton(AF_INET, _group.c_str(), &membership.imr_multiaddr) != 1 || inet_pton(AF_INET, _interface.c_str(), &membership.imr_interface) != 1)
+    {
+        return ERROR_INVALID_ARG;
+    }
+    sockaddr_in local     = {};
+    local.sin_family      = AF_INET;
+    local.sin_port        = htons(_port);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    _fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (_fd < 0)
+    {
+        return ERROR_CONNECTION_FAILED;
+    }
+
+    // Multicast DNS packets are sent with TTL 255, receivers drop others
+    int     enable = 1;
+    uint8_t ttl    = 255;
+    uint8_t loop   = 1;
+    bool    ready  = setsockopt(_fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) == 0;
+#ifdef SO_REUSEPORT
+    ready = ready && setsockopt(_fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) == 0;
+#endif
+    ready = ready && bind(_fd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) == 0;
+    ready = ready && setsockopt(_fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) == 0;
+    ready = ready && setsockopt(_fd, IPPROTO_IP, IP_MULTICAST_IF, &membership.imr_interface, sizeof(membership.imr_interface)) == 0;
+    ready = ready && setsockopt(_fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) == 0;
+    ready = ready && setsockopt(_fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) == 0;
+    ready = ready && fcntl(_fd, F_SETFL, fcntl(_fd, F_GETFL, 0) | O_NONBLOCK) == 0;
+    if (!ready)
+    {
+        disconnect();
+        return ERROR_CONNECTION_FAILED;
+    }
+    return ERROR_SUCCESS;
+}
+
+sys_error_t net_multicastHost::sendData(const uint8_t* data, size_t length)
+{
+    if (_fd < 0)
+    {
+        return ERROR_CONNECTION_CLOSED;
+    }
+    sockaddr_in group = {};
+    group.sin_family  = AF_INET;
+    group.sin_port    = htons(_port);
+    inet_pton(AF_INET, _group.c_str(), &group.sin_addr);
+    if (sendto(_fd, data, length, 0, reinterpret_cast<sockaddr*>(&group), sizeof(group)) == static_cast<ssize_t>(length))
+    {
+        return ERROR_SUCCESS;
+    }
+    return (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) ? ERROR_BUSY : ERROR_TRANSMIT_FAILED;
+}
+
+sys_error_t net_multicastHost::receiveData(uint8_t* data, size_t maxLength, size_t& receivedLength)
+{
+    receivedLength = 0;
+    if (_fd < 0)
+    {
+        return ERROR_CONNECTION_CLOSED;
+    }
+    ssize_t received = recv(_fd, data, maxLength, 0);
+    if (received < 0)
+    {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? ERROR_SUCCESS : ERROR_RECEIVE_FAILED;
+    }
+    receivedLength = static_cast<size_t>(received);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t net_multicastHost::disconnect()
+{
+    if (_fd >= 0)
+    {
+        close(_fd);
+        _fd = -1;
+    }
+    return ERROR_SUCCESS;
+}
+
+bool net_multicastHost::waitReadable(uint32_t timeoutMs)
+{
+    if (_fd < 0)
+    {
+        return false;
+    }
+    pollfd entry = {_fd, POLLIN, 0};
+    return ::poll(&entry, 1, static_cast<int>(timeoutMs > INT32_MAX ? INT32_MAX : timeoutMs)) == 1;
+}
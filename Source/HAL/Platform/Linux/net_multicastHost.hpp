@@ -0,0 +1,58 @@
+/**
+ * @file net_multicastHost.hpp
+ * @brief Header file for net_multicastHost
+ *
+ * This file contains declarations for the net_multicastHost class and related data types and functions.
+ */
+
+#ifndef NET_MULTICASTHOST_HPP
+#define NET_MULTICASTHOST_HPP
+
+#include "HAL/IHal.h"
+#include <string>
+
+/**
+ * @brief Host UDP socket member of a multicast group
+ * The socket is bound to the group port, shared with other processes listening on it (e.g. avahi on 5353), and
+ * joined to the group on one interface. sendData() sends one datagram to the group and never blocks: ERROR_BUSY if
+ * the socket buffer is full. receiveData() returns one datagram, or nothing if none is waiting; own datagrams are
+ * looped back.
+ */
+class net_multicastHost : public IHAL_COM
+{
+private:
+    std::string _group;
+    uint16_t    _port;
+    std::string _interface;
+    int         _fd;
+
+public:
+    /**
+     * @brief Construct a new net_multicastHost object
+     *
+     * @param group - IPv4 multicast group, e.g. 224.0.0.251
+     * @param port - UDP port of the group
+     * @param interfaceAddress - IPv4 address of the interface, "0.0.0.0" for the default one
+     */
+    net_multicastHost(const char* group, uint16_t port, const char* interfaceAddress = "0.0.0.0");
+    ~net_multicastHost();
+
+    // Delete copy constructor and assignment operator
+    net_multicastHost(const net_multicastHost&)            = delete;
+    net_multicastHost& operator=(const net_multicastHost&) = delete;
+
+    sys_error_t connect() override;
+    sys_error_t sendData(const uint8_t* data, size_t length) override;
+    sys_error_t receiveData(uint8_t* data, size_t maxLength, size_t& receivedLength) override;
+    sys_error_t disconnect() override;
+
+    /**
+     * @brief Wait until a datagram is waiting
+     *
+     * @param timeoutMs - longest wait in milliseconds
+     * @return bool true if a datagram is waiting
+     */
+    bool waitReadable(uint32_t timeoutMs);
+};
+
+#endif /* NET_MULTICASTHOST_HPP */
@@ -0,0 +1,120 @@
+/**
+ * @file net_tcpHost.cpp
+ * @brief Source file for net_tcpHost
+ *
+ * This file contains definitions for the net_tcpHost class and related data types and functions.
+ */
+
+#include "net_tcpHost.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdio.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+net_tcpHost::net_tcpHost(const char* host, uint16_t port) : _host(host), _port(port), _fd(-1) {}
+
+net_tcpHost::~net_tcpHost()
+{
+    disconnect();
+}
+
+sys_error_t net_tcpHost::connect()
+{
+    if (_fd >= 0)
+    {
+        return ERROR_SUCCESS;
+    }
+
+    char port[8];
+    snprintf(port, sizeof(port), "%u", static_cast<unsigned>(_port));
+    addrinfo  hints   = {};
+    addrinfo* results = nullptr;
+    hints.ai_family   = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(_host.c_str(), port, &hints, &results) != 0 || results == nullptr)
+    {
+        return ERROR_INVALID_ARG;
+    }
+
+    _fd = socket(AF_INET, SOCK_STREAM, 0);
+    bool connected = (_fd >= 0 && ::connect(_fd, results->ai_addr, results->ai_addrlen) == 0);
+    freeaddrinfo(results);
+
+    // Small packets go out at once, PUBACKs and pings are not held back
+    int noDelay = 1;
+    if (!connected || setsockopt(_fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay)) != 0 || fcntl(_fd, F_SETFL, fcntl(_fd, F_GETFL, 0) | O_NONBLOCK) != 0)
+    {
+        disconnect();
+        return ERROR_CONNECTION_FAILED;
+    }
+    return ERROR_SUCCESS;
+}
+
+sys_error_t net_tcpHost::sendData(const uint8_t* data, size_t length)
+{
+    if (_fd < 0)
+    {
+        return ERROR_CONNECTION_CLOSED;
+    }
+
+    size_t sent = 0;
+    while (sent < length)
+    {
+        ssize_t result = send(_fd, data + sent, length - sent, MSG_NOSIGNAL);
+        if (result > 0)
+        {
+            sent += static_cast<size_t>(result);
+            continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            return ERROR_TRANSMIT_FAILED;
+        }
+        if (sent == 0)
+        {
+            return ERROR_BUSY;
+        }
+        pollfd entry = {_fd, POLLOUT, 0};
+        if (::poll(&entry, 1, NET_TCP_SEND_TIMEOUT_MS) != 1)
+        {
+            return ERROR_TRANSMIT_FAILED;
+        }
+    }
+    return ERROR_SUCCESS;
+}
+
+sys_error_t net_tcpHost::receiveData(uint8_t* data, size_t maxLength, size_t& receivedLength)
+{
+    receivedLength = 0;
+    if (_fd < 0)
+    {
+        return ERROR_CONNECTION_CLOSED;
+    }
+    ssize_t received = recv(_fd, data, maxLength, 0);
+    if (received == 0 && maxLength > 0)
+    {
+        return ERROR_CONNECTION_CLOSED;
+    }
+    if (received < 0)
+    {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? ERROR_SUCCESS : ERROR_RECEIVE_FAILED;
+    }
+    receivedLength = static_cast<size_t>(received);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t net_tcpHost::disconnect()
+{
+    if (_fd >= 0)
+    {
+        close(_fd);
+        _fd = -1;
+    }
+    return ERROR_SUCCESS;
+}
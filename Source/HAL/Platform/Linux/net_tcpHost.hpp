@@ -0,0 +1,50 @@
+/**
+ * @file net_tcpHost.hpp
+ * @brief Header file for net_tcpHost
+ *
+ * This file contains declarations for the net_tcpHost class and related data types and functions.
+ */
+
+#ifndef NET_TCPHOST_HPP
+#define NET_TCPHOST_HPP
+
+#include "HAL/IHal.h"
+#include <string>
+
+#define NET_TCP_SEND_TIMEOUT_MS 1000 // a started packet is completed within this time or the connection is failed
+
+/**
+ * @brief Host TCP client connection
+ * connect() blocks until the connection is established, the socket is non-blocking afterwards. sendData() sends
+ * the whole buffer or nothing: ERROR_BUSY if the socket buffer is full, and once part of it is sent the rest is
+ * waited for, so a packet is never cut. receiveData() returns what is waiting, ERROR_CONNECTION_CLOSED once the
+ * peer closed the connection.
+ */
+class net_tcpHost : public IHAL_COM
+{
+private:
+    std::string _host;
+    uint16_t    _port;
+    int         _fd;
+
+public:
+    /**
+     * @brief Construct a new net_tcpHost object
+     *
+     * @param host - host name or IPv4 address of the peer
+     * @param port - TCP port of the peer
+     */
+    net_tcpHost(const char* host, uint16_t port);
+    ~net_tcpHost();
+
+    // Delete copy constructor and assignment operator
+    net_tcpHost(const net_tcpHost&)            = delete;
+    net_tcpHost& operator=(const net_tcpHost&) = delete;
+
+    sys_error_t connect() override;
+    sys_error_t sendData(const uint8_t* data, size_t length) override;
+    sys_error_t receiveData(uint8_t* data, size_t maxLength, size_t& receivedLength) override;
+    sys_error_t disconnect() override;
+};
+
+#endif /* NET_TCPHOST_HPP */
@@ -0,0 +1,89 @@
+/**
+ * @file net_udpHost.cpp
+ * @brief Source file for net_udpHost
+ *
+ * This file contains definitions for the net_udpHost class and related data types and functions.
+ */
+
+#include "net_udpHost.hpp"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+net_udpHost::net_udpHost(const char* host, uint16_t port) : _host(host), _port(port), _fd(-1) {}
+
+net_udpHost::~net_udpHost()
+{
+    disconnect();
+}
+
+sys_error_t net_udpHost::connect()
+{
+    if (_fd >= 0)
+    {
+        return ERROR_SUCCESS;
+    }
+
+    sockaddr_in address = {};
+    address.sin_family  = AF_INET;
+    address.sin_port    = htons(_port);
+    if (inet_pton(AF_INET, _host.c_str(), &address.sin_addr) != 1)
+    {
+        return ERROR_INVALID_ARG;
+    }
+
+    _fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (_fd < 0)
+    {
+        return ERROR_CONNECTION_FAILED;
+    }
+    if (fcntl(_fd, F_SETFL, fcntl(_fd, F_GETFL, 0) | O_NONBLOCK) != 0 || ::connect(_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        disconnect();
+        return ERROR_CONNECTION_FAILED;
+    }
+    return ERROR_SUCCESS;
+}
+
+sys_error_t net_udpHost::sendData(const uint8_t* data, size_t length)
+{
+    if (_fd < 0)
+    {
+        return ERROR_CONNECTION_CLOSED;
+    }
+    if (send(_fd, data, length, 0) == static_cast<ssize_t>(length))
+    {
+        return ERROR_SUCCESS;
+    }
+    return (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS) ? ERROR_BUSY : ERROR_TRANSMIT_FAILED;
+}
+
+sys_error_t net_udpHost::receiveData(uint8_t* data, size_t maxLength, size_t& receivedLength)
+{
+    receivedLength = 0;
+    if (_fd < 0)
+    {
+        return ERROR_CONNECTION_CLOSED;
+    }
+    ssize_t received = recv(_fd, data, maxLength, 0);
+    if (received < 0)
+    {
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? ERROR_SUCCESS : ERROR_RECEIVE_FAILED;
+    }
+    receivedLength = static_cast<size_t>(received);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t net_udpHost::disconnect()
+{
+    if (_fd >= 0)
+    {
+        close(_fd);
+        _fd = -1;
+    }
+    return ERROR_SUCCESS;
+}
@@ -0,0 +1,46 @@
+/**
+ * @file net_udpHost.hpp
+ * @brief Header file for net_udpHost
+ *
+ * This file contains declarations for the net_udpHost class and related data types and functions.
+ */
+
+#ifndef NET_UDPHOST_HPP
+#define NET_UDPHOST_HPP
+
+#include "HAL/IHal.h"
+#include <string>
+
+/**
+ * @brief Host UDP socket connected to one peer
+ * sendData() sends one datagram and never blocks: ERROR_BUSY if the socket buffer is full. receiveData() returns
+ * one datagram, or nothing if none is waiting.
+ */
+class net_udpHost : public IHAL_COM
+{
+private:
+    std::string _host;
+    uint16_t    _port;
+    int         _fd;
+
+public:
+    /**
+     * @brief Construct a new net_udpHost object
+     *
+     * @param host - IPv4 address of the peer
+     * @param port - UDP port of the peer
+     */
+    net_udpHost(const char* host, uint16_t port);
+    ~net_udpHost();
+
+    // Delete copy constructor and assignment operator
+    net_udpHost(const net_udpHost&)            = delete;
+    net_udpHost& operator=(const net_udpHost&) = delete;
+
+    sys_error_t connect() override;
+    sys_error_t sendData(const uint8_t* data, size_t length) override;
+    sys_error_t receiveData(uint8_t* data, size_t maxLength, size_t& receivedLength) override;
+    sys_error_t disconnect() override;
+};
+
+#endif /* NET_UDPHOST_HPP */
@@ -0,0 +1,85 @@
+/**
+ * @file cobs.cpp
+ * @brief Source file for cobs
+ *
+ * This file contains definitions for the Consistent Overhead Byte Stuffing (COBS) functions.
+ */
+
+#include "cobs.h"
+#include <string.h>
+
+namespace
+{
+constexpr uint8_t maxCode = 0xFF; // block of 254 data bytes not followed by a zero
+} // namespace
+
+cobs::encoder::encoder(uint8_t* output) : _output(output), _code(output), _write(output + 1), _count(1) {}
+
+void cobs::encoder::append(const uint8_t* data, size_t length)
+{
+    const uint8_t* end = data + length;
+    while (data < end)
+    {
+        // Copy the run up to the next zero or the end of the block at once
+        size_t         room = maxCode - _count;
+        size_t         left = end - data;
+        const uint8_t* zero = static_cast<const uint8_t*>(memchr(data, 0, (left < room) ? left : room));
+        size_t         run  = (zero != nullptr) ? static_cast<size_t>(zero - data) : ((left < room) ? left : room);
+
+        memcpy(_write, data, run);
+        _write += run;
+        _count = static_cast<uint8_t>(_count + run);
+        data += run;
+
+        if (zero != nullptr || _count == maxCode)
+        {
+            *_code = _count;
+            _code  = _write++;
+            _count = 1;
+            data += (zero != nullptr) ? 1 : 0;
+        }
+    }
+}
+
+size_t cobs::encoder::finish()
+{
+    *_code = _count;
+    return _write - _output;
+}
+
+size_t cobs::encode(const uint8_t* data, size_t length, uint8_t* output)
+{
+    encoder frame(output);
+    frame.append(data, length);
+    return frame.finish();
+}
+
+bool cobs::decode(const uint8_t* data, size_t length, uint8_t* output, size_t& decodedLength)
+{
+    size_t read  = 0;
+    size_t write = 0;
+    while (read < length)
+    {
+        uint8_t code = data[read++];
+        if (code == 0 || read + code - 1 > length)
+        {
+            return false;
+        }
+
+        size_t run = code - 1;
+        if (memchr(data + read, 0, run) != nullptr)
+        {
+            return false;
+        }
+        memmove(output + write, data + read, run);
+        read += run;
+        write += run;
+
+        if (code != maxCode && read < length)
+        {
+            output[write++] = 0;
+        }
+    }
+    decodedLength = write;
+    return true;
+}
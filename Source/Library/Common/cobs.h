@@ -0,0 +1,86 @@
+/**
+ * @file cobs.h
+ * @brief Header file for cobs
+ *
+ * This file contains declarations for the Consistent Overhead Byte Stuffing (COBS) functions.
+ */
+#ifndef COBS_H
+#define COBS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace cobs
+{
+/**
+ * @brief Worst case encoded size: one extra byte per 254 bytes plus the leading code byte
+ * The 0x00 frame delimiter is not included.
+ */
+inline size_t maxEncodedLength(size_t length)
+{
+    return length + length / 254 + 1;
+}
+
+/**
+ * @brief Streaming encoder writing into a caller provided buffer
+ * Data is appended in pieces (header, payload, checksum...) so a frame can be encoded straight
+ * into its destination, e.g. a span of the TX ring, without being assembled first.
+ * The buffer must hold maxEncodedLength() of all appended data.
+ */
+class encoder
+{
+private:
+    uint8_t* _output;
+    uint8_t* _code;  // position of the pending code byte
+    uint8_t* _write; // next data position
+    uint8_t  _count; // code value of the pending block
+
+public:
+    /**
+     * @brief Construct a new encoder object
+     *
+     * @param output - destination buffer
+     */
+    explicit encoder(uint8_t* output);
+
+    /**
+     * @brief Encode the next piece of the frame
+     *
+     * @param data - data to encode
+     * @param length - number of bytes
+     */
+    void append(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Close the frame
+     *
+     * @return size_t encoded length, without delimiter
+     */
+    size_t finish();
+};
+
+/**
+ * @brief Encode a buffer in one go
+ *
+ * @param data - data to encode
+ * @param length - number of bytes
+ * @param output - destination, at least maxEncodedLength(length) bytes
+ * @return size_t encoded length, without delimiter
+ */
+size_t encode(const uint8_t* data, size_t length, uint8_t* output);
+
+/**
+ * @brief Decode one frame (without delimiter)
+ * The output may be the input buffer itself, decoding in place is safe.
+ *
+ * @param data - encoded frame
+ * @param length - number of bytes
+ * @param output - destination, at least length bytes
+ * @param decodedLength - number of decoded bytes
+ * @return true frame is valid
+ * @return false frame contains a zero byte or a code pointing past its end
+ */
+bool decode(const uint8_t* data, size_t length, uint8_t* output, size_t& decodedLength);
+} // namespace cobs
+
+#endif /* COBS_H */
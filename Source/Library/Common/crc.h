@@ -0,0 +1,39 @@
+/**
+ * @file crc.h
+ * @brief Header file for crc
+ *
+ * This file contains declarations for the table driven checksum functions.
+ */
+#ifndef CRC_H
+#define CRC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace crc
+{
+/**
+ * @brief CRC-32 (IEEE 802.3, reflected 0xEDB88320)
+ * Calls can be chained: crc32(b, lenB, crc32(a, lenA)) equals the CRC of a followed by b.
+ * Long buffers are processed eight bytes at a time (slice-by-8), the extra 7 KiB of tables are built on first use.
+ *
+ * @param data - data to checksum
+ * @param length - number of bytes
+ * @param crc - result of the previous chunk, 0 to start a new checksum
+ * @return uint32_t
+ */
+uint32_t crc32(const void* data, size_t length, uint32_t crc = 0);
+
+/**
+ * @brief CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF)
+ * Calls can be chained: crc16(b, lenB, crc16(a, lenA)) equals the CRC of a followed by b.
+ *
+ * @param data - data to checksum
+ * @param length - number of bytes
+ * @param crc - result of the previous chunk, 0xFFFF to start a new checksum
+ * @return uint16_t
+ */
+uint16_t crc16(const void* data, size_t length, uint16_t crc = 0xFFFF);
+} // namespace crc
+
+#endif /* CRC_H */
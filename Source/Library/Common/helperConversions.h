@@ -7,11 +7,16 @@
 #ifndef HELPERCONVERSIONS_HPP
 #define HELPERCONVERSIONS_HPP
 
-#include <string>
+#include "Library/Common/textFormat.h"
 
 namespace mac
 {
-std::string convertToMac(uint8_t mac[6]);
-}
+typedef format::fixedString<FORMAT_MAC_SIZE> macString_t;
+
+/**
+ * @brief MAC address text, "24:0a:c4:00:11:22", kept in the returned object instead of the heap
+ */
+macString_t convertToMac(const uint8_t mac[6]);
+} // namespace mac
 
 #endif /* HELPERCONVERSIONS_HPP */
@@ -0,0 +1,134 @@
+/**
+ * @file lz.cpp
+ * @brief Source file for lz
+ *
+ * This file contains definitions for the LZ77 block compression functions.
+ */
+
+#include "lz.h"
+#include <string.h>
+
+namespace
+{
+constexpr size_t minMatch    = 4;
+constexpr size_t maxMatch    = 0x7F + minMatch;
+constexpr size_t maxLiterals = 0x80;
+constexpr size_t maxDistance = 0xFFFF;
+
+inline uint32_t hash4(const uint8_t* data)
+{
+    uint32_t value = static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) | (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+    return (value * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+// Emit the pending literals in runs of at most maxLiterals
+bool flushLiterals(const uint8_t* literals, size_t count, uint8_t* output, size_t capacity, size_t& used)
+{
+    while (count > 0)
+    {
+        size_t run = (count < maxLiterals) ? count : maxLiterals;
+        if (used + 1 + run > capacity)
+        {
+            return false;
+        }
+        output[used++] = static_cast<uint8_t>(run - 1);
+        memcpy(output + used, literals, run);
+        used += run;
+        literals += run;
+        count -= run;
+    }
+    return true;
+}
+} // namespace
+
+lz::compressor::compressor() : _table() {}
+
+size_t lz::compressor::compress(const uint8_t* data, size_t length, uint8_t* output, size_t capacity)
+{
+    if (length > maxDistance)
+    {
+        return 0;
+    }
+    memset(_table, 0, sizeof(_table));
+
+    size_t used     = 0;
+    size_t literal  = 0; // start of the pending literals
+    size_t position = 0;
+    while (position + minMatch <= length)
+    {
+        uint32_t hash      = hash4(data + position);
+        size_t   candidate = _table[hash];
+        _table[hash]       = static_cast<uint16_t>(position + 1);
+
+        if (candidate == 0 || memcmp(data + candidate - 1, data + position, minMatch) != 0)
+        {
+            position++;
+            continue;
+        }
+        candidate--;
+
+        size_t match = minMatch;
+        while (match < maxMatch && position + match < length && data[candidate + match] == data[position + match])
+        {
+            match++;
+        }
+
+        size_t distance = position - candidate;
+        if (!flushLiterals(data + literal, position - literal, output, capacity, used) || used + 3 > capacity)
+        {
+            return 0;
+        }
+        output[used++] = static_cast<uint8_t>(0x80 | (match - minMatch));
+        output[used++] = static_cast<uint8_t>(distance);
+        output[used++] = static_cast<uint8_t>(distance >> 8);
+        position += match;
+        literal = position;
+    }
+
+    if (!flushLiterals(data + literal, length - literal, output, capacity, used))
+    {
+        return 0;
+    }
+    return used;
+}
+
+size_t lz::decompress(const uint8_t* data, size_t length, uint8_t* output, size_t capacity)
+{
+    size_t read    = 0;
+    size_t written = 0;
+    while (read < length)
+    {
+        uint8_t token = data[read++];
+        if (token < 0x80)
+        {
+            size_t run = static_cast<size_t>(token) + 1;
+            if (read + run > length || written + run > capacity)
+            {
+                return 0;
+            }
+            memcpy(output + written, data + read, run);
+            read += run;
+            written += run;
+            continue;
+        }
+
+        if (read + 2 > length)
+        {
+            return 0;
+        }
+        size_t match    = (token & 0x7F) + minMatch;
+        size_t distance = static_cast<size_t>(data[read]) | (static_cast<size_t>(data[read + 1]) << 8);
+        read += 2;
+        if (distance == 0 || distance > written || written + match > capacity)
+        {
+            return 0;
+        }
+        // Byte by byte, a match may overlap the bytes it produces
+        for (size_t i = 0; i < match; i++)
+        {
+            output[written + i] = output[written - distance + i];
+        }
+        written += match;
+    }
+    return written;
+}
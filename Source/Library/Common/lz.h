@@ -0,0 +1,65 @@
+/**
+ * @file lz.h
+ * @brief Header file for lz
+ *
+ * This file contains declarations for the LZ77 block compression functions.
+ *
+ * A compressed block is a sequence of tokens:
+ *   0x00-0x7F: literal run of token + 1 bytes, which follow the token
+ *   0x80-0xFF: match of (token & 0x7F) + 4 bytes, followed by the little endian 16 bit distance back (1..65535)
+ * Blocks are compressed independently, there is no state between them.
+ */
+#ifndef LZ_H
+#define LZ_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define LZ_HASH_BITS 8 // entries of the match finder table, 2^bits
+
+namespace lz
+{
+/**
+ * @brief Worst case compressed size: one token per 128 literals
+ */
+inline size_t maxCompressedLength(size_t length)
+{
+    return length + (length + 127) / 128;
+}
+
+/**
+ * @brief Greedy compressor, the match finder table lives in the object instead of on the stack
+ */
+class compressor
+{
+private:
+    uint16_t _table[1 << LZ_HASH_BITS]; // last position + 1 of each 4 byte hash, 0 = none
+
+public:
+    compressor();
+
+    /**
+     * @brief Compress a block of at most 65535 bytes
+     *
+     * @param data - input
+     * @param length - number of bytes
+     * @param output - destination
+     * @param capacity - destination size
+     * @return size_t compressed length, 0 if it does not fit the destination
+     */
+    size_t compress(const uint8_t* data, size_t length, uint8_t* output, size_t capacity);
+};
+
+/**
+ * @brief Decompress a block
+ *
+ * @param data - compressed block
+ * @param length - number of bytes
+ * @param output - destination, must not overlap the input
+ * @param capacity - destination size
+ * @return size_t decompressed length, 0 if the block is malformed or does not fit the destination
+ */
+size_t decompress(const uint8_t* data, size_t length, uint8_t* output, size_t capacity);
+} // namespace lz
+
+#endif /* LZ_H */
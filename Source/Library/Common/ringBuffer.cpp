@@ -0,0 +1,130 @@
+/**
+ * @file ringBuffer.cpp
+ * @brief Source file for ringBuffer
+ *
+ * This file contains definitions for the ringBuffer class and related data types and functions.
+ */
+
+#include "ringBuffer.h"
+#include <string.h>
+
+ringBuffer::ringBuffer(uint8_t* storage, size_t capacity) : _storage(storage), _capacity(capacity), _mask(capacity - 1), _writePosition(0), _readPosition(0)
+{
+    // The mask only wraps a power of two, any other capacity leaves the ring without storage
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0)
+    {
+        _capacity = 0;
+        _mask     = 0;
+    }
+}
+
+ringBuffer::~ringBuffer()
+{
+    // destructor implementation
+}
+
+size_t ringBuffer::write(const uint8_t* data, size_t length)
+{
+    size_t written = 0;
+    while (written < length)
+    {
+        ringSpan_t span = writeSpan();
+        if (span.length == 0)
+        {
+            break;
+        }
+        size_t chunk = (span.length < length - written) ? span.length : length - written;
+        memcpy(span.data, data + written, chunk);
+        commit(chunk);
+        written += chunk;
+    }
+    return written;
+}
+
+size_t ringBuffer::read(uint8_t* data, size_t length)
+{
+    size_t done = 0;
+    while (done < length)
+    {
+        ringSpan_t span = readSpan();
+        if (span.length == 0)
+        {
+            break;
+        }
+        size_t chunk = (span.length < length - done) ? span.length : length - done;
+        memcpy(data + done, span.data, chunk);
+        consume(chunk);
+        done += chunk;
+    }
+    return done;
+}
+
+ringSpan_t ringBuffer::writeSpan()
+{
+    // Only the producer moves the write position, the consumer's position is acquired
+    size_t write  = _writePosition.load(std::memory_order_relaxed);
+    size_t read   = _readPosition.load(std::memory_order_acquire);
+    size_t free   = _capacity - (write - read);
+    size_t offset = write & _mask;
+    size_t toEnd  = _capacity - offset;
+
+    ringSpan_t span = {_storage + offset, (free < toEnd) ? free : toEnd};
+    return span;
+}
+
+void ringBuffer::commit(size_t length)
+{
+    _writePosition.store(_writePosition.load(std::memory_order_relaxed) + length, std::memory_order_release);
+}
+
+ringSpan_t ringBuffer::readSpan()
+{
+    size_t read   = _readPosition.load(std::memory_order_relaxed);
+    size_t write  = _writePosition.load(std::memory_order_acquire);
+    size_t used   = write - read;
+    size_t offset = read & _mask;
+    size_t toEnd  = _capacity - offset;
+
+    ringSpan_t span = {_storage + offset, (used < toEnd) ? used : toEnd};
+    return span;
+}
+
+void ringBuffer::consume(size_t length)
+{
+    _readPosition.store(_readPosition.load(std::memory_order_relaxed) + length, std::memory_order_release);
+}
+
+void ringBuffer::clear()
+{
+    _readPosition.store(_writePosition.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+size_t ringBuffer::size()
+{
+    return _writePosition.load(std::memory_order_acquire) - _readPosition.load(std::memory_order_acquire);
+}
+
+size_t ringBuffer::freeSpace()
+{
+    return _capacity - size();
+}
+
+size_t ringBuffer::capacity()
+{
+    return _capacity;
+}
+
+bool ringBuffer::isValid()
+{
+    return _capacity != 0;
+}
+
+size_t ringBuffer::writePosition()
+{
+    return _writePosition.load(std::memory_order_acquire);
+}
+
+size_t ringBuffer::readPosition()
+{
+    return _readPosition.load(std::memory_order_acquire);
+}
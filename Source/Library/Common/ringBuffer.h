@@ -0,0 +1,124 @@
+/**
+ * @file ringBuffer.h
+ * @brief Header file for ringBuffer
+ *
+ * This file contains declarations for the ringBuffer class and related data types and functions.
+ */
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Contiguous region of a buffer lent to the caller
+ */
+typedef struct
+{
+    uint8_t* data;
+    size_t   length;
+} ringSpan_t;
+
+/**
+ * @brief Lock-free single producer / single consumer byte ring
+ *
+ * One context may write (write(), writeSpan()/commit()) while another one reads (read(), readSpan()/consume())
+ * without any lock. Positions run freely and are masked on access, so the capacity must be a power of two.
+ * The span API lends the storage itself to the caller, which avoids the intermediate copy of write()/read().
+ */
+class ringBuffer
+{
+private:
+    uint8_t*            _storage;
+    size_t              _capacity;
+    size_t              _mask;
+    std::atomic<size_t> _writePosition;
+    std::atomic<size_t> _readPosition;
+
+public:
+    /**
+     * @brief Construct a new ringBuffer object
+     *
+     * @param storage - backing storage, owned by the caller
+     * @param capacity - storage size in bytes, power of two; any other size is rejected, see isValid()
+     */
+    ringBuffer(uint8_t* storage, size_t capacity);
+    ~ringBuffer();
+
+    // Delete copy constructor and assignment operator
+    ringBuffer(const ringBuffer&)            = delete;
+    ringBuffer& operator=(const ringBuffer&) = delete;
+
+    /**
+     * @brief Copy data into the ring (producer)
+     *
+     * @return size_t number of bytes written, less than length if the ring is full
+     */
+    size_t write(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Copy data out of the ring (consumer)
+     *
+     * @return size_t number of bytes read
+     */
+    size_t read(uint8_t* data, size_t length);
+
+    /**
+     * @brief Lend the largest contiguous free region to the producer
+     * The region is published with commit().
+     *
+     * @return ringSpan_t empty span if the ring is full
+     */
+    ringSpan_t writeSpan();
+
+    /**
+     * @brief Publish bytes written into the span returned by writeSpan()
+     *
+     * @param length - bytes to publish, at most the span length
+     */
+    void commit(size_t length);
+
+    /**
+     * @brief Lend the largest contiguous readable region to the consumer
+     * The region is released with consume().
+     *
+     * @return ringSpan_t empty span if the ring is empty
+     */
+    ringSpan_t readSpan();
+
+    /**
+     * @brief Release bytes of the span returned by readSpan()
+     *
+     * @param length - bytes to release, at most the readable size
+     */
+    void consume(size_t length);
+
+    /**
+     * @brief Drop all data, neither side may be active
+     */
+    void clear();
+
+    size_t size();
+    size_t freeSpace();
+    size_t capacity();
+
+    /**
+     * @brief Check the capacity given to the constructor
+     *
+     * @return bool false if it was not a power of two, the ring then has capacity 0 and takes no data
+     */
+    bool isValid();
+
+    /**
+     * @brief Total number of bytes ever committed, wraps around with size_t
+     */
+    size_t writePosition();
+
+    /**
+     * @brief Total number of bytes ever consumed, wraps around with size_t
+     */
+    size_t readPosition();
+};
+
+#endif /* RINGBUFFER_H */
@@ -0,0 +1,305 @@
+/**
+ * @file textFormat.cpp
+ * @brief Source file for textFormat
+ *
+ * This file contains definitions for the allocation free text formatting functions.
+ */
+
+#include "textFormat.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace
+{
+const char lowerDigits[] = "0123456789abcdef";
+const char upperDigits[] = "0123456789ABCDEF";
+
+// "00" to "99", two decimal digits per table lookup
+const char decimalPairs[] = "00010203040506070809"
+                            "10111213141516171819"
+                            "20212223242526272829"
+                            "30313233343536373839"
+                            "40414243444546474849"
+                            "50515253545556575859"
+                            "60616263646566676869"
+                            "70717273747576777879"
+                            "80818283848586878889"
+                            "90919293949596979899";
+} // namespace
+
+format::textWriter::textWriter(char* data, size_t size) : _data(data), _size(size), _length(0), _truncated(false)
+{
+    if (_size > 0)
+    {
+        _data[0] = '\0';
+    }
+}
+
+void format::textWriter::append(const char* text, size_t length)
+{
+    size_t space = (_size > _length) ? _size - _length - 1 : 0;
+    if (length > space)
+    {
+        length     = space;
+        _truncated = true;
+    }
+    if (length > 0)
+    {
+        memcpy(_data + _length, text, length);
+        _length += length;
+        _data[_length] = '\0';
+    }
+}
+
+void format::textWriter::append(const char* text)
+{
+    append(text, strlen(text));
+}
+
+void format::textWriter::append(char character)
+{
+    append(&character, 1);
+}
+
+void format::textWriter::print(const char* pattern, ...)
+{
+    size_t  space = (_size > _length) ? _size - _length : 0;
+    va_list args;
+    va_start(args, pattern);
+    int written = (space > 0) ? vsnprintf(_data + _length, space, pattern, args) : 0;
+    va_end(args);
+
+    // vsnprintf() returns the length it wanted to write
+    if (written < 0)
+    {
+        return;
+    }
+    if (static_cast<size_t>(written) >= space)
+    {
+        _truncated = true;
+        _length    = (space > 0) ? _size - 1 : _length;
+        return;
+    }
+    _length += static_cast<size_t>(written);
+}
+
+void format::textWriter::clear()
+{
+    _length    = 0;
+    _truncated = false;
+    if (_size > 0)
+    {
+        _data[0] = '\0';
+    }
+}
+
+void format::appendUnsigned(textWriter& out, uint64_t value)
+{
+    // Filled from the end, 20 digits hold UINT64_MAX
+    char  digits[20];
+    char* position = digits + sizeof(digits);
+    while (value >= 100)
+    {
+        size_t pair = static_cast<size_t>(value % 100) * 2;
+        value /= 100;
+        *--position = decimalPairs[pair + 1];
+        *--position = decimalPairs[pair];
+    }
+    if (value >= 10)
+    {
+        size_t pair = static_cast<size_t>(value) * 2;
+        *--position = decimalPairs[pair + 1];
+        *--position = decimalPairs[pair];
+    }
+    else
+    {
+        *--position = static_cast<char>('0' + value);
+    }
+    out.append(position, static_cast<size_t>(digits + sizeof(digits) - position));
+}
+
+void format::appendSigned(textWriter& out, int64_t value)
+{
+    if (value < 0)
+    {
+        out.append('-');
+        appendUnsigned(out, 0 - static_cast<uint64_t>(value));
+        return;
+    }
+    appendUnsigned(out, static_cast<uint64_t>(value));
+}
+
+void format::appendHexValue(textWriter& out, uint64_t value, size_t digits, bool upper)
+{
+    const char* table = upper ? upperDigits : lowerDigits;
+    char        text[16];
+    char*       position = text + sizeof(text);
+    do
+    {
+        *--position = table[value & 0x0F];
+        value >>= 4;
+    } while (value != 0);
+    while (position > text && static_cast<size_t>(text + sizeof(text) - position) < digits)
+    {
+        *--position = '0';
+    }
+    out.append(position, static_cast<size_t>(text + sizeof(text) - position));
+}
+
+void format::appendHex(textWriter& out, const void* data, size_t length, char separator, bool upper)
+{
+    const char*    table = upper ? upperDigits : lowerDigits;
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < length; i++)
+    {
+        char text[3] = {separator, table[bytes[i] >> 4], table[bytes[i] & 0x0F]};
+        bool skip    = (i == 0 || separator == '\0');
+        out.append(text + (skip ? 1 : 0), skip ? 2 : 3);
+    }
+}
+
+void format::appendMac(textWriter& out, const uint8_t mac[6], bool upper)
+{
+    appendHex(out, mac, 6, ':', upper);
+}
+
+void format::appendIpv4(textWriter& out, const uint8_t address[4])
+{
+    for (size_t i = 0; i < 4; i++)
+    {
+        if (i > 0)
+        {
+            out.append('.');
+        }
+        appendUnsigned(out, address[i]);
+    }
+}
+
+void format::appendArgument(textWriter& out, const char* value)
+{
+    out.append((value != nullptr) ? value : "(null)");
+}
+
+void format::appendArgument(textWriter& out, const std::string& value)
+{
+    out.append(value.data(), value.size());
+}
+
+void format::appendArgument(textWriter& out, char value)
+{
+    out.append(value);
+}
+
+void format::appendArgument(textWriter& out, bool value)
+{
+    out.append(value ? "true" : "false");
+}
+
+void format::appendArgument(textWriter& out, signed char value)
+{
+    appendSigned(out, value);
+}
+
+void format::appendArgument(textWriter& out, unsigned char value)
+{
+    appendUnsigned(out, value);
+}
+
+void format::appendArgument(textWriter& out, short value)
+{
+    appendSigned(out, value);
+}
+
+void format::appendArgument(textWriter& out, unsigned short value)
+{
+    appendUnsigned(out, value);
+}
+
+void format::appendArgument(textWriter& out, int value)
+{
+    appendSigned(out, value);
+}
+
+void format::appendArgument(textWriter& out, unsigned int value)
+{
+    appendUnsigned(out, value);
+}
+
+void format::appendArgument(textWriter& out, long value)
+{
+    appendSigned(out, value);
+}
+
+void format::appendArgument(textWriter& out, unsigned long value)
+{
+    appendUnsigned(out, value);
+}
+
+void format::appendArgument(textWriter& out, long long value)
+{
+    appendSigned(out, value);
+}
+
+void format::appendArgument(textWriter& out, unsigned long long value)
+{
+    appendUnsigned(out, value);
+}
+
+void format::appendArgument(textWriter& out, double value)
+{
+    // Not table driven, floating point values are rare on the log paths
+    char text[32];
+    int  length = snprintf(text, sizeof(text), "%g", value);
+    if (length > 0)
+    {
+        out.append(text, (static_cast<size_t>(length) < sizeof(text)) ? static_cast<size_t>(length) : sizeof(text) - 1);
+    }
+}
+
+void format::appendArgument(textWriter& out, const void* value)
+{
+    out.append("0x", 2);
+    appendHexValue(out, reinterpret_cast<uintptr_t>(value));
+}
+
+void format::appendArgument(textWriter& out, const hexArgument& value)
+{
+    appendHexValue(out, value.value, value.digits, value.upper);
+}
+
+void format::appendArgument(textWriter& out, const macArgument& value)
+{
+    appendMac(out, value.bytes, value.upper);
+}
+
+void format::appendArgument(textWriter& out, const ipv4Argument& value)
+{
+    appendIpv4(out, value.bytes);
+}
+
+const char* format::appendUntilPlaceholder(textWriter& out, const char* pattern)
+{
+    const char* start = pattern;
+    for (;; pattern++)
+    {
+        char current = *pattern;
+        if (current == '\0')
+        {
+            out.append(start, static_cast<size_t>(pattern - start));
+            return nullptr;
+        }
+        if ((current == '{' || current == '}') && pattern[1] == current)
+        {
+            // Escaped brace, one of the pair is kept
+            out.append(start, static_cast<size_t>(pattern - start) + 1);
+            start = ++pattern + 1;
+        }
+        else if (current == '{' && pattern[1] == '}')
+        {
+            out.append(start, static_cast<size_t>(pattern - start));
+            return pattern + 2;
+        }
+    }
+}
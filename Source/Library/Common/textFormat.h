@@ -0,0 +1,244 @@
+/**
+ * @file textFormat.h
+ * @brief Header file for textFormat
+ *
+ * This file contains declarations for the allocation free text formatting functions.
+ */
+#ifndef TEXTFORMAT_H
+#define TEXTFORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+namespace format
+{
+/**
+ * @brief Appends text to a caller provided buffer
+ * The text is always null terminated; what does not fit is dropped and truncated() is set.
+ */
+class textWriter
+{
+private:
+    char*  _data;
+    size_t _size; // terminator included
+    size_t _length;
+    bool   _truncated;
+
+public:
+    /**
+     * @brief Construct a new textWriter object
+     *
+     * @param data - buffer, the text is null terminated in it
+     * @param size - buffer size in bytes, terminator included
+     */
+    textWriter(char* data, size_t size);
+
+    void append(const char* text, size_t length);
+    void append(const char* text);
+    void append(char character);
+
+    /**
+     * @brief Append printf() style formatted text, e.g. for floating point columns of reports
+     */
+    void print(const char* pattern, ...) __attribute__((format(printf, 2, 3)));
+
+    /**
+     * @brief Drop the text, the buffer holds an empty string
+     */
+    void clear();
+
+    const char* c_str() const
+    {
+        return _data;
+    }
+    size_t length() const
+    {
+        return _length;
+    }
+    bool truncated() const
+    {
+        return _truncated;
+    }
+};
+
+/**
+ * @brief textWriter with its own buffer of N bytes, N - 1 characters
+ */
+template <size_t N> class fixedString : public textWriter
+{
+private:
+    char _storage[N];
+
+public:
+    fixedString() : textWriter(_storage, N) {}
+    fixedString(const fixedString& other) : textWriter(_storage, N)
+    {
+        append(other.c_str(), other.length());
+    }
+    fixedString& operator=(const fixedString& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            append(other.c_str(), other.length());
+        }
+        return *this;
+    }
+};
+
+#define FORMAT_MAC_SIZE  18 // "aa:bb:cc:dd:ee:ff" and the terminator
+#define FORMAT_IPV4_SIZE 16 // "255.255.255.255" and the terminator
+
+/**
+ * @brief Decimal digits of an unsigned integer, two digits per step from a lookup table
+ */
+void appendUnsigned(textWriter& out, uint64_t value);
+
+/**
+ * @brief Decimal digits of a signed integer, '-' first if it is negative
+ */
+void appendSigned(textWriter& out, int64_t value);
+
+/**
+ * @brief Hexadecimal digits of an integer, no prefix
+ *
+ * @param out - destination
+ * @param value - value
+ * @param digits - minimum number of digits, zero padded; 0 for as many as needed
+ * @param upper - upper case letters
+ */
+void appendHexValue(textWriter& out, uint64_t value, size_t digits = 0, bool upper = false);
+
+/**
+ * @brief Two hexadecimal digits per byte
+ *
+ * @param out - destination
+ * @param data - bytes
+ * @param length - number of bytes
+ * @param separator - put between the bytes, '\0' for none
+ * @param upper - upper case letters
+ */
+void appendHex(textWriter& out, const void* data, size_t length, char separator = '\0', bool upper = false);
+
+/**
+ * @brief MAC address, "24:0a:c4:00:11:22"
+ */
+void appendMac(textWriter& out, const uint8_t mac[6], bool upper = false);
+
+/**
+ * @brief IPv4 address in dotted decimal form
+ *
+ * @param out - destination
+ * @param address - address bytes, most significant first, as they are in network order in memory
+ */
+void appendIpv4(textWriter& out, const uint8_t address[4]);
+
+/**
+ * @brief Argument wrappers of formatTo(), e.g. formatTo(out, "{} at {}", mac(bytes), hex(value, 8))
+ */
+struct hexArgument
+{
+    uint64_t value;
+    size_t   digits;
+    bool     upper;
+};
+struct macArgument
+{
+    const uint8_t* bytes;
+    bool           upper;
+};
+struct ipv4Argument
+{
+    const uint8_t* bytes;
+};
+
+inline hexArgument hex(uint64_t value, size_t digits = 0, bool upper = false)
+{
+    return hexArgument{value, digits, upper};
+}
+inline macArgument mac(const uint8_t bytes[6], bool upper = false)
+{
+    return macArgument{bytes, upper};
+}
+inline ipv4Argument ipv4(const uint8_t bytes[4])
+{
+    return ipv4Argument{bytes};
+}
+
+void appendArgument(textWriter& out, const char* value);
+void appendArgument(textWriter& out, const std::string& value);
+void appendArgument(textWriter& out, char value);
+void appendArgument(textWriter& out, bool value);
+void appendArgument(textWriter& out, signed char value);
+void appendArgument(textWriter& out, unsigned char value);
+void appendArgument(textWriter& out, short value);
+void appendArgument(textWriter& out, unsigned short value);
+void appendArgument(textWriter& out, int value);
+void appendArgument(textWriter& out, unsigned int value);
+void appendArgument(textWriter& out, long value);
+void appendArgument(textWriter& out, unsigned long value);
+void appendArgument(textWriter& out, long long value);
+void appendArgument(textWriter& out, unsigned long long value);
+void appendArgument(textWriter& out, double value);
+void appendArgument(textWriter& out, const void* value);
+void appendArgument(textWriter& out, const hexArgument& value);
+void appendArgument(textWriter& out, const macArgument& value);
+void appendArgument(textWriter& out, const ipv4Argument& value);
+
+/**
+ * @brief Append the pattern up to its next "{}" placeholder, "{{" and "}}" stand for single braces
+ *
+ * @return const char* the pattern after the placeholder, nullptr if there is none left
+ */
+const char* appendUntilPlaceholder(textWriter& out, const char* pattern);
+
+/**
+ * @brief Append the rest of the pattern, placeholders without an argument are kept as they are
+ */
+inline void formatTo(textWriter& out, const char* pattern)
+{
+    while (pattern != nullptr)
+    {
+        pattern = appendUntilPlaceholder(out, pattern);
+        if (pattern != nullptr)
+        {
+            out.append("{}", 2);
+        }
+    }
+}
+
+/**
+ * @brief Append the pattern with every "{}" replaced by the next argument
+ * The argument types pick the formatter at compile time, nothing is allocated. Arguments without a placeholder are
+ * dropped.
+ *
+ * @param out - destination, e.g. a fixedString
+ * @param pattern - text with "{}" placeholders
+ * @param value - argument of the first placeholder
+ * @param args - arguments of the following placeholders
+ */
+template <typename T, typename... Args> void formatTo(textWriter& out, const char* pattern, const T& value, const Args&... args)
+{
+    pattern = appendUntilPlaceholder(out, pattern);
+    if (pattern != nullptr)
+    {
+        appendArgument(out, value);
+        formatTo(out, pattern, args...);
+    }
+}
+
+/**
+ * @brief formatTo() into a caller buffer
+ *
+ * @return size_t length of the text, without the terminator
+ */
+template <typename... Args> size_t formatTo(char* buffer, size_t size, const char* pattern, const Args&... args)
+{
+    textWriter out(buffer, size);
+    formatTo(out, pattern, args...);
+    return out.length();
+}
+} // namespace format
+
+#endif /* TEXTFORMAT_H */
@@ -0,0 +1,185 @@
+/**
+ * @file coreBalance.cpp
+ * @brief Source file for coreBalance
+ *
+ * This file contains definitions for the coreBalance class and related data types and functions.
+ */
+
+#include "coreBalance.h"
+#include "Library/Common/textFormat.h"
+
+namespace
+{
+const uint8_t realtimeBands   = (1u << TASK_BAND_REALTIME_IO) | (1u << TASK_BAND_ISR_DEFERRED);
+const uint8_t disturbingBands = (1u << TASK_BAND_NETWORK) | (1u << TASK_BAND_SYSTEM);
+
+void formatBands(format::textWriter& out, uint8_t bands, bool json)
+{
+    bool first = true;
+    for (uint8_t band = 0; band < TASK_BAND_COUNT; band++)
+    {
+        if ((bands & (1u << band)) != 0)
+        {
+            out.print(json ? "%s\"%s\"" : "%s%s", first ? "" : ",", taskBandName(static_cast<taskBand_t>(band)));
+            first = false;
+        }
+    }
+}
+} // namespace
+
+coreBalance::coreBalance(size_t cores) : _cores(cores), _floating(), _lastTotalRunTime(0), _samples(0) {}
+
+coreBalance::~coreBalance()
+{
+    // destructor implementation
+}
+
+void coreBalance::update(const taskSample_t* samples, size_t count, uint32_t totalRunTime)
+{
+    uint32_t elapsedRunTime = totalRunTime - _lastTotalRunTime;
+    bool     baseline       = (_samples == 0);
+
+    coreLoad_t empty = {0.0f, 0, 0, true};
+    for (coreLoad_t& core : _cores)
+    {
+        core = empty;
+    }
+    _floating = empty;
+
+    // Isolation needs the loads first, keep the busy bands apart
+    std::vector<uint8_t> busyBands(_cores.size(), 0);
+    uint8_t              floatingBusy = 0;
+
+    _current.clear();
+    for (size_t i = 0; i < count; i++)
+    {
+        const taskSample_t& sample  = samples[i];
+        previous_t          current = {sample.id, sample.runTime};
+        _current.push_back(current);
+        if (sample.priority == 0)
+        {
+            continue; // idle
+        }
+
+        const previous_t* previous = findPrevious(sample.id);
+        float             load     = 0.0f;
+        if (!baseline && previous != nullptr && elapsedRunTime > 0)
+        {
+            load = 100.0f * static_cast<float>(sample.runTime - previous->runTime) / static_cast<float>(elapsedRunTime);
+        }
+
+        bool        pinned = sample.core >= 0 && static_cast<size_t>(sample.core) < _cores.size();
+        coreLoad_t& target = pinned ? _cores[sample.core] : _floating;
+        uint8_t     band   = static_cast<uint8_t>(1u << taskBandOf(sample.priority));
+        target.load += load;
+        target.tasks++;
+        target.bands |= band;
+        if (load >= COREBALANCE_BUSY_PERCENT)
+        {
+            (pinned ? busyBands[sample.core] : floatingBusy) |= band;
+        }
+    }
+
+    // A busy floating task can land on any core, a floating realtime task can meet any busy task
+    uint8_t anyBusy = floatingBusy;
+    for (size_t i = 0; i < _cores.size(); i++)
+    {
+        _cores[i].isolated = (_cores[i].bands & realtimeBands) == 0 || ((busyBands[i] | floatingBusy) & disturbingBands) == 0;
+        anyBusy |= busyBands[i];
+    }
+    _floating.isolated = (_floating.bands & realtimeBands) == 0 || (anyBusy & disturbingBands) == 0;
+
+    _previous.swap(_current);
+    _lastTotalRunTime = totalRunTime;
+    _samples++;
+}
+
+size_t coreBalance::getCoreCount()
+{
+    return _cores.size();
+}
+
+coreLoad_t coreBalance::getCore(size_t core)
+{
+    coreLoad_t empty = {0.0f, 0, 0, true};
+    return (core < _cores.size()) ? _cores[core] : empty;
+}
+
+coreLoad_t coreBalance::getFloating()
+{
+    return _floating;
+}
+
+float coreBalance::getImbalance()
+{
+    if (_cores.empty())
+    {
+        return 0.0f;
+    }
+    float lowest  = _cores[0].load;
+    float highest = _cores[0].load;
+    for (const coreLoad_t& core : _cores)
+    {
+        lowest  = (core.load < lowest) ? core.load : lowest;
+        highest = (core.load > highest) ? core.load : highest;
+    }
+    return highest - lowest;
+}
+
+size_t coreBalance::formatText(char* buffer, size_t size)
+{
+    format::textWriter out(buffer, size);
+    for (size_t i = 0; i <= _cores.size(); i++)
+    {
+        const coreLoad_t& core = (i < _cores.size()) ? _cores[i] : _floating;
+        if (i < _cores.size())
+        {
+            out.print("core%u: ", static_cast<unsigned>(i));
+        }
+        else
+        {
+            out.print("floating: ");
+        }
+        out.print("%5.1f%% %u tasks [", core.load, static_cast<unsigned>(core.tasks));
+        formatBands(out, core.bands, false);
+        out.print("]%s\n", core.isolated ? "" : " realtime I/O shares the core with network/system load");
+    }
+    out.print("imbalance: %.1f%%\n", getImbalance());
+    return out.length();
+}
+
+size_t coreBalance::formatJson(char* buffer, size_t size)
+{
+    format::textWriter out(buffer, size);
+    out.print("{\"cores\":[");
+    for (size_t i = 0; i <= _cores.size(); i++)
+    {
+        const coreLoad_t& core = (i < _cores.size()) ? _cores[i] : _floating;
+        if (i == _cores.size())
+        {
+            out.print("],\"floating\":");
+        }
+        out.print("%s{", (i > 0 && i < _cores.size()) ? "," : "");
+        if (i < _cores.size())
+        {
+            out.print("\"core\":%u,", static_cast<unsigned>(i));
+        }
+        out.print("\"load\":%.1f,\"tasks\":%u,\"bands\":[", core.load, static_cast<unsigned>(core.tasks));
+        formatBands(out, core.bands, true);
+        out.print("],\"isolated\":%s}", core.isolated ? "true" : "false");
+    }
+    out.print(",\"imbalance\":%.1f}", getImbalance());
+    return out.length();
+}
+
+const coreBalance::previous_t* coreBalance::findPrevious(uintptr_t id)
+{
+    for (const previous_t& previous : _previous)
+    {
+        if (previous.id == id)
+        {
+            return &previous;
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file coreBalance.h
+ * @brief Header file for coreBalance
+ *
+ * This file contains declarations for the coreBalance class and related data types and functions.
+ */
+#ifndef COREBALANCE_H
+#define COREBALANCE_H
+
+#include "System/taskBands.h"
+#include "taskProfiler.h"
+
+#define COREBALANCE_BUSY_PERCENT 1.0f // a task below this load does not disturb the tasks sharing its core
+
+/**
+ * @brief Load of one core over the last sampling period
+ */
+typedef struct
+{
+    float    load;     // run time share of the tasks pinned to the core, 100 % is a busy core
+    uint32_t tasks;    // tasks pinned to the core, idle task excluded
+    uint8_t  bands;    // bit per taskBand_t of the pinned tasks
+    bool     isolated; // no busy network or system task shares the core with realtime I/O
+} coreLoad_t;
+
+/**
+ * @brief Core load balance and priority band placement from periodic task samples
+ *
+ * Uses the run time counters, core affinity and priority of taskSample_t. Tasks without affinity may run on
+ * any core and are reported as floating. The idle tasks (priority 0) are left out, the load is the busy time.
+ * Runs on the host, e.g. on samples recorded from the target, and on the target next to taskProfiler.
+ */
+class coreBalance
+{
+private:
+    typedef struct
+    {
+        uintptr_t id;
+        uint32_t  runTime;
+    } previous_t;
+
+    std::vector<coreLoad_t> _cores;
+    coreLoad_t              _floating;
+    std::vector<previous_t> _previous;
+    std::vector<previous_t> _current;
+    uint32_t                _lastTotalRunTime;
+    uint32_t                _samples;
+
+    const previous_t* findPrevious(uintptr_t id);
+
+public:
+    /**
+     * @brief Construct a new coreBalance object
+     *
+     * @param cores - number of cores (default 2)
+     */
+    explicit coreBalance(size_t cores = 2);
+    ~coreBalance();
+
+    /**
+     * @brief Feed a new sample of all tasks, the first one only sets the baseline
+     *
+     * @param samples - tasks
+     * @param count - number of tasks
+     * @param totalRunTime - total run time counter, same unit as taskSample_t::runTime
+     */
+    void update(const taskSample_t* samples, size_t count, uint32_t totalRunTime);
+
+    size_t     getCoreCount();
+    coreLoad_t getCore(size_t core);
+
+    /**
+     * @brief Load of the tasks without core affinity
+     */
+    coreLoad_t getFloating();
+
+    /**
+     * @brief Difference between the most and the least loaded core in percent
+     */
+    float getImbalance();
+
+    /**
+     * @brief Write one line per core and a summary
+     *
+     * @return size_t characters written, without the terminating null
+     */
+    size_t formatText(char* buffer, size_t size);
+
+    /**
+     * @brief Write the cores as a JSON object
+     *
+     * @return size_t characters written, without the terminating null
+     */
+    size_t formatJson(char* buffer, size_t size);
+};
+
+#endif /* COREBALANCE_H */
@@ -0,0 +1,358 @@
+/**
+ * @file flightRecorder.cpp
+ * @brief Source file for flightRecorder
+ *
+ * This file contains definitions for the flightRecorder class and related data types and functions.
+ */
+
+#include "flightRecorder.h"
+#include "Library/Common/crc.h"
+#include "Library/Common/textFormat.h"
+#include <atomic>
+#include <inttypes.h>
+#include <string.h>
+
+#if defined(ESP_PLATFORM)
+#include "esp_timer.h"
+#else
+#include <chrono>
+#endif
+
+namespace
+{
+constexpr uint16_t regionVersion = 1;
+
+const char* const eventNames[]  = {"BOOT", "LOG", "STATE", "WIFI", "HTTP", "USER"}; // indexed by flightEvent_t
+const char* const levelNames[]  = {"INFO", "WARNING", "ERROR"};                   // indexed by ILog::LogLevel
+const char* const httpMethods[] = {"DELETE", "GET", "HEAD", "POST", "PUT"};       // indexed by http_method
+
+#if defined(ESP_PLATFORM)
+inline uint32_t nowMs()
+{
+    return static_cast<uint32_t>(esp_timer_get_time() / 1000);
+}
+#else
+inline uint32_t nowMs()
+{
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+}
+#endif
+
+// Namespace scope rather than a function static: records in interrupts must not hit a guard variable
+flightRecorder systemFlight;
+
+// The region is plain memory that outlives the recorder, its sequence and head words are accessed atomically in place
+inline uint32_t loadAcquire(const uint32_t& word)
+{
+    return __atomic_load_n(&word, __ATOMIC_ACQUIRE);
+}
+
+inline void storeRelease(uint32_t& word, uint32_t value)
+{
+    __atomic_store_n(&word, value, __ATOMIC_RELEASE);
+}
+
+// Largest power of two not above count
+uint32_t floorPowerOfTwo(size_t count)
+{
+    uint32_t power = 1;
+    while (power <= count / 2)
+    {
+        power *= 2;
+    }
+    return power;
+}
+} // namespace
+
+flightRecorder::flightRecorder() : _header(nullptr), _records(nullptr), _mask(0), _previousFlight(false) {}
+
+flightRecorder::~flightRecorder()
+{
+    // destructor implementation
+}
+
+sys_error_t flightRecorder::attach(void* region, size_t size, uint16_t resetReason)
+{
+    if (region == nullptr || size < sizeof(flightRegionHeader_t) + 2 * sizeof(flightRecord_t))
+    {
+        return ERROR_INVALID_ARG;
+    }
+    flightRegionHeader_t* header   = static_cast<flightRegionHeader_t*>(region);
+    uint32_t              capacity = floorPowerOfTwo((size - sizeof(flightRegionHeader_t)) / sizeof(flightRecord_t));
+
+    // A region of another layout, or never written (power on), starts empty
+    _previousFlight = (header->magic == FLIGHT_MAGIC && header->version == regionVersion && header->recordSize == sizeof(flightRecord_t) && header->capacity == capacity);
+    if (!_previousFlight)
+    {
+        memset(region, 0, sizeof(flightRegionHeader_t) + capacity * sizeof(flightRecord_t));
+        header->magic      = FLIGHT_MAGIC;
+        header->version    = regionVersion;
+        header->recordSize = sizeof(flightRecord_t);
+        header->capacity   = capacity;
+    }
+    header->bootCount++;
+
+    _records = reinterpret_cast<flightRecord_t*>(header + 1);
+    _mask    = capacity - 1;
+    _header  = header;
+    record(FLIGHT_BOOT, resetReason, header->bootCount);
+    return ERROR_SUCCESS;
+}
+
+bool flightRecorder::isAttached()
+{
+    return _header != nullptr;
+}
+
+bool flightRecorder::hadPreviousFlight()
+{
+    return _previousFlight;
+}
+
+uint32_t flightRecorder::getCapacity()
+{
+    return (_header != nullptr) ? _mask + 1 : 0;
+}
+
+uint32_t flightRecorder::getBootCount()
+{
+    return (_header != nullptr) ? _header->bootCount : 0;
+}
+
+void flightRecorder::record(flightEvent_t event, uint16_t source, uint32_t arg, const char* text, size_t length)
+{
+    if (_header == nullptr)
+    {
+        return;
+    }
+
+    uint32_t        index = __atomic_fetch_add(&_header->head, 1, __ATOMIC_RELAXED);
+    flightRecord_t& slot  = _records[index & _mask];
+
+    // Readers copying this slot see the cleared sequence, or a changed one once it is published again
+    __atomic_store_n(&slot.sequence, 0, __ATOMIC_RELAXED);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (text != nullptr && length == 0)
+    {
+        length = strnlen(text, FLIGHT_TEXT_SIZE);
+    }
+    length      = (length < FLIGHT_TEXT_SIZE) ? length : FLIGHT_TEXT_SIZE;
+    slot.timeMs = nowMs();
+    slot.event  = event;
+    slot.length = static_cast<uint8_t>(length);
+    slot.source = source;
+    slot.arg    = arg;
+    if (length > 0)
+    {
+        memcpy(slot.text, text, length);
+    }
+    storeRelease(slot.sequence, index + 1);
+}
+
+void flightRecorder::clear()
+{
+    if (_header != nullptr)
+    {
+        memset(_records, 0, (_mask + 1) * sizeof(flightRecord_t));
+        __atomic_store_n(&_header->head, 0, __ATOMIC_RELEASE);
+    }
+}
+
+bool flightRecorder::readRecord(uint32_t index, flightRecord_t& record)
+{
+    const flightRecord_t& slot = _records[index & _mask];
+    if (loadAcquire(slot.sequence) != index + 1)
+    {
+        return false;
+    }
+    memcpy(&record, &slot, sizeof(record));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // Overwritten while copying
+    return __atomic_load_n(&slot.sequence, __ATOMIC_RELAXED) == index + 1;
+}
+
+size_t flightRecorder::getRecords(flightRecord_t* records, size_t maxRecords)
+{
+    if (_header == nullptr)
+    {
+        return 0;
+    }
+    uint32_t head  = loadAcquire(_header->head);
+    uint32_t count = (head > _mask) ? _mask + 1 : head;
+    if (count > maxRecords)
+    {
+        count = static_cast<uint32_t>(maxRecords);
+    }
+
+    size_t copied = 0;
+    for (uint32_t index = head - count; index != head; index++)
+    {
+        if (readRecord(index, records[copied]))
+        {
+            copied++;
+        }
+    }
+    return copied;
+}
+
+bool flightRecorder::print(const flightWriter_t& writer)
+{
+    if (_header == nullptr)
+    {
+        return false;
+    }
+    uint32_t head  = loadAcquire(_header->head);
+    uint32_t count = (head > _mask) ? _mask + 1 : head;
+
+    char           line[128];
+    flightRecord_t record;
+    for (uint32_t index = head - count; index != head; index++)
+    {
+        if (readRecord(index, record) && !writer(line, formatRecord(record, line, sizeof(line))))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+sys_error_t flightRecorder::persist(IHAL_MEM& memory, uint32_t address)
+{
+    if (_header == nullptr)
+    {
+        return ERROR_NOT_FOUND;
+    }
+    uint32_t head     = loadAcquire(_header->head);
+    uint32_t count    = (head > _mask) ? _mask + 1 : head;
+    size_t   dumpSize = sizeof(flightRegionHeader_t) + count * sizeof(flightRecord_t);
+    size_t   sector   = memory.getSectorSize();
+    if (sector == 0 || address % sector != 0)
+    {
+        return ERROR_INVALID_ARG;
+    }
+    if (address + dumpSize > memory.getSize())
+    {
+        return ERROR_OUT_OF_MEMORY;
+    }
+
+    for (size_t offset = 0; offset < dumpSize; offset += sector)
+    {
+        if (!memory.eraseSector(static_cast<uint32_t>(address + offset)))
+        {
+            return ERROR_WRITE_FAILED;
+        }
+    }
+
+    // Records one by one, there is no room for a copy of the ring on the stack of every caller
+    flightRegionHeader_t dump    = {};
+    uint32_t             written = 0;
+    uint32_t             next    = address + sizeof(flightRegionHeader_t);
+    flightRecord_t       record;
+    for (uint32_t index = head - count; index != head; index++)
+    {
+        if (!readRecord(index, record))
+        {
+            continue;
+        }
+        if (!memory.writeData(next, reinterpret_cast<const uint8_t*>(&record), sizeof(record)))
+        {
+            return ERROR_WRITE_FAILED;
+        }
+        dump.crc = crc::crc32(&record, sizeof(record), dump.crc);
+        next += sizeof(record);
+        written++;
+    }
+
+    dump.magic      = FLIGHT_MAGIC;
+    dump.version    = regionVersion;
+    dump.recordSize = sizeof(flightRecord_t);
+    dump.capacity   = _mask + 1;
+    dump.bootCount  = _header->bootCount;
+    dump.head       = written;
+    if (!memory.writeData(address, reinterpret_cast<const uint8_t*>(&dump), sizeof(dump)))
+    {
+        return ERROR_WRITE_FAILED;
+    }
+    return ERROR_SUCCESS;
+}
+
+sys_error_t flightRecorder::load(IHAL_MEM& memory, uint32_t address, flightRecord_t* records, size_t maxRecords, size_t& count)
+{
+    count                     = 0;
+    flightRegionHeader_t dump = {};
+    if (!memory.readData(address, reinterpret_cast<uint8_t*>(&dump), sizeof(dump)))
+    {
+        return ERROR_READ_FAILED;
+    }
+    if (dump.magic != FLIGHT_MAGIC || dump.version != regionVersion || dump.recordSize != sizeof(flightRecord_t) || dump.head > dump.capacity)
+    {
+        return ERROR_NOT_FOUND;
+    }
+    if (dump.head > maxRecords)
+    {
+        return ERROR_OUT_OF_MEMORY;
+    }
+    if (!memory.readData(address + sizeof(dump), reinterpret_cast<uint8_t*>(records), dump.head * sizeof(flightRecord_t)))
+    {
+        return ERROR_READ_FAILED;
+    }
+    if (crc::crc32(records, dump.head * sizeof(flightRecord_t)) != dump.crc)
+    {
+        return ERROR_DATA_CORRUPTED;
+    }
+    count = dump.head;
+    return ERROR_SUCCESS;
+}
+
+size_t flightRecorder::formatRecord(const flightRecord_t& record, char* buffer, size_t size)
+{
+    if (buffer == nullptr || size == 0)
+    {
+        return 0;
+    }
+    format::textWriter out(buffer, size);
+    int                text = (record.length < FLIGHT_TEXT_SIZE) ? record.length : FLIGHT_TEXT_SIZE;
+
+    out.print("%8" PRIu32 " %7" PRIu32 ".%03" PRIu32 " %-5s ", record.sequence, record.timeMs / 1000, record.timeMs % 1000, eventName(record.event));
+    switch (record.event)
+    {
+        case FLIGHT_BOOT:
+            out.print("boot %" PRIu32 ", reset reason %u", record.arg, record.source);
+            break;
+
+        case FLIGHT_LOG:
+            out.print("%s %.*s%s", (record.source < 3) ? levelNames[record.source] : "?", text, record.text, (record.arg > static_cast<uint32_t>(text)) ? "..." : "");
+            break;
+
+        case FLIGHT_PROCESS_STATE:
+            out.print("process 0x%08" PRIx32 " %u -> %u %.*s", record.arg, record.source >> 8, record.source & 0xFF, text, record.text);
+            break;
+
+        case FLIGHT_WIFI:
+            out.print("%.*s event %u, arg %" PRIu32, text, record.text, record.source, record.arg);
+            break;
+
+        case FLIGHT_HTTP:
+            out.print("%s %.*s, %" PRIu32 " bytes", (record.source < 5) ? httpMethods[record.source] : "?", text, record.text, record.arg);
+            break;
+
+        default:
+            out.print("source %u, arg %" PRIu32 " %.*s", record.source, record.arg, text, record.text);
+            break;
+    }
+    out.print("\n");
+    return out.length();
+}
+
+const char* flightRecorder::eventName(uint8_t event)
+{
+    return (event < FLIGHT_EVENT_MAX) ? eventNames[event] : "?";
+}
+
+flightRecorder& flight()
+{
+    return systemFlight;
+}
+
@@ -0,0 +1,197 @@
+/**
+ * @file flightRecorder.h
+ * @brief Header file for flightRecorder
+ *
+ * This file contains declarations for the flightRecorder class and related data types and functions.
+ */
+#ifndef FLIGHTRECORDER_H
+#define FLIGHTRECORDER_H
+
+#include "HAL/IHal.h"
+#include "System/error_definitions.h"
+#include <functional>
+#include <stddef.h>
+#include <stdint.h>
+
+#define FLIGHT_RECORDS     128        // power of two, records kept in the retained region of the system recorder
+#define FLIGHT_TEXT_SIZE   16         // text bytes of a record, longer texts are cut
+#define FLIGHT_MAGIC       0x31544C46 // "FLT1", region and persisted dump
+#define FLIGHT_REGION_SIZE (sizeof(flightRegionHeader_t) + FLIGHT_RECORDS * sizeof(flightRecord_t))
+
+/**
+ * @brief Kind of a flight record, meaning of its source and argument
+ */
+typedef enum : uint8_t
+{
+    FLIGHT_BOOT          = 0, // source: reset reason, arg: boot count
+    FLIGHT_LOG           = 1, // source: ILog::LogLevel, arg: message length, text: start of the message
+    FLIGHT_PROCESS_STATE = 2, // source: old state << 8 | new state, arg: process address, text: new state
+    FLIGHT_WIFI          = 3, // source: event id, arg: disconnect reason or IP address, text: event base
+    FLIGHT_HTTP          = 4, // source: method, arg: content length, text: URI
+    FLIGHT_USER          = 5, // application defined
+    FLIGHT_EVENT_MAX,
+} flightEvent_t;
+
+/**
+ * @brief One recorded event, 32 bytes
+ */
+typedef struct
+{
+    uint32_t sequence; // index of the record plus one, 0 while the record is written
+    uint32_t timeMs;   // milliseconds since boot
+    uint8_t  event;    // flightEvent_t
+    uint8_t  length;   // text bytes used
+    uint16_t source;
+    uint32_t arg;
+    char     text[FLIGHT_TEXT_SIZE]; // not null terminated
+} flightRecord_t;
+
+/**
+ * @brief Start of the retained region, followed by the records. Also the header of a persisted dump,
+ * where head is the number of records following it, oldest first. All fields are little endian.
+ */
+typedef struct
+{
+    uint32_t magic;      // FLIGHT_MAGIC
+    uint16_t version;    // 1
+    uint16_t recordSize; // sizeof(flightRecord_t)
+    uint32_t capacity;   // records in the ring
+    uint32_t bootCount;  // boots recorded into the region
+    uint32_t head;       // records ever written
+    uint32_t crc;        // dump only: CRC-32 of the records
+    uint32_t reserved[2];
+} flightRegionHeader_t;
+
+/**
+ * @brief Receives printed flight records, returns false to abort
+ */
+typedef std::function<bool(const void* data, size_t length)> flightWriter_t;
+
+/**
+ * @brief Ring of recent events in memory that survives a reset
+ *
+ * The ring lives in a region given by the platform: memory the startup code does not clear on the ESP32
+ * (RTC_NOINIT_ATTR/__NOINIT_ATTR), the mapping of a mem_mmapFile on the host. attach() keeps the records of the
+ * previous run if the region holds a valid ring, so after a crash they can be read, served or persisted.
+ * persist() writes them as a dump, a flightRegionHeader_t with the record count in head followed by the records.
+ *
+ * record() claims a slot with one atomic increment, so it can be called from tasks and interrupts alike without
+ * a lock. The sequence of a slot is cleared before and set after the slot is filled; readers skip slots whose
+ * sequence does not match or changes while they copy, so a record torn by a reset or an overwrite is never
+ * reported.
+ */
+class flightRecorder
+{
+private:
+    flightRegionHeader_t* _header;
+    flightRecord_t*       _records;
+    uint32_t              _mask;
+    bool                  _previousFlight;
+
+    bool readRecord(uint32_t index, flightRecord_t& record);
+
+public:
+    flightRecorder();
+    ~flightRecorder();
+
+    // Delete copy constructor and assignment operator
+    flightRecorder(const flightRecorder&)            = delete;
+    flightRecorder& operator=(const flightRecorder&) = delete;
+
+    /**
+     * @brief Start recording into a region and add a FLIGHT_BOOT record
+     * Call it once at startup, before other tasks record; records before are dropped.
+     *
+     * @param region - retained memory, 4 byte aligned, owned by the caller
+     * @param size - region size, holds a power of two number of records after the header
+     * @param resetReason - platform reset reason, stored in the boot record
+     * @return sys_error_t ERROR_INVALID_ARG if the region holds less than two records
+     */
+    sys_error_t attach(void* region, size_t size, uint16_t resetReason);
+
+    bool isAttached();
+
+    /**
+     * @brief Whether the region held records of a previous run when it was attached
+     */
+    bool hadPreviousFlight();
+
+    uint32_t getCapacity();
+    uint32_t getBootCount();
+
+    /**
+     * @brief Add a record, does nothing before attach()
+     *
+     * @param event - record kind
+     * @param source - see flightEvent_t
+     * @param arg - see flightEvent_t
+     * @param text - text, cut to FLIGHT_TEXT_SIZE bytes (optional)
+     * @param length - text length, strlen(text) if 0
+     */
+    void record(flightEvent_t event, uint16_t source, uint32_t arg, const char* text = nullptr, size_t length = 0);
+
+    /**
+     * @brief Drop all records, the boot count is kept
+     */
+    void clear();
+
+    /**
+     * @brief Copy the complete records, oldest first
+     *
+     * @param records - output
+     * @param maxRecords - output capacity, the newest records are copied if there are more
+     * @return size_t records copied
+     */
+    size_t getRecords(flightRecord_t* records, size_t maxRecords);
+
+    /**
+     * @brief Write the complete records oldest first, one text line each
+     *
+     * @param writer - output sink, called once per line
+     * @return true if the writer accepted all lines
+     */
+    bool print(const flightWriter_t& writer);
+
+    /**
+     * @brief Write the records as a dump to storage, e.g. after a reboot before they are overwritten
+     * The sectors are erased first and the header is written last, a dump cut by a reset is not loaded.
+     *
+     * @param memory - storage device
+     * @param address - dump address, sector aligned
+     * @return sys_error_t ERROR_OUT_OF_MEMORY if the dump does not fit the device
+     */
+    sys_error_t persist(IHAL_MEM& memory, uint32_t address);
+
+    /**
+     * @brief Read a dump written by persist()
+     *
+     * @param memory - storage device
+     * @param address - dump address
+     * @param records - output
+     * @param maxRecords - output capacity
+     * @param count - records read
+     * @return sys_error_t ERROR_NOT_FOUND if there is no valid dump, ERROR_OUT_OF_MEMORY if it has more records
+     */
+    static sys_error_t load(IHAL_MEM& memory, uint32_t address, flightRecord_t* records, size_t maxRecords, size_t& count);
+
+    /**
+     * @brief Format a record as one text line, with the trailing newline
+     *
+     * @return size_t characters written, without the terminating null
+     */
+    static size_t formatRecord(const flightRecord_t& record, char* buffer, size_t size);
+
+    /**
+     * @brief Get the name of a record kind
+     */
+    static const char* eventName(uint8_t event);
+};
+
+/**
+ * @brief The recorder of the system, attached at startup by proc_flight
+ *
+ * @return flightRecorder&
+ */
+flightRecorder& flight();
+
+#endif /* FLIGHTRECORDER_H */
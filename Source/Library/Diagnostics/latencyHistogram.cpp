@@ -0,0 +1,185 @@
+/**
+ * @file latencyHistogram.cpp
+ * @brief Source file for latencyHistogram
+ *
+ * This file contains definitions for the latencyHistogram class and related data types and functions.
+ */
+
+#include "latencyHistogram.h"
+#include "Library/Common/textFormat.h"
+#include <math.h>
+
+namespace
+{
+constexpr uint32_t halfBuckets      = latencyHistogram::subBuckets / 2;
+constexpr uint32_t distributionRows = 5; // rows per halving of the remaining share
+
+uint32_t highestBit(uint64_t value)
+{
+    uint32_t bit = 0;
+    while (value >>= 1)
+    {
+        bit++;
+    }
+    return bit;
+}
+} // namespace
+
+constexpr uint32_t latencyHistogram::subBucketBits;
+constexpr uint32_t latencyHistogram::subBuckets;
+
+latencyHistogram::latencyHistogram(uint64_t maxValue) : _maxValue(maxValue), _count(0), _min(UINT64_MAX), _max(0), _sum(0.0)
+{
+    _counts.assign(bucketIndex(maxValue) + 1, 0);
+}
+
+latencyHistogram::~latencyHistogram()
+{
+    // destructor implementation
+}
+
+// Values below subBuckets get a bucket each; above, a power of two range [2^n, 2^(n+1)) is split into
+// halfBuckets buckets of width 2^shift, numbered on from the previous range
+size_t latencyHistogram::bucketIndex(uint64_t value)
+{
+    if (value < subBuckets)
+    {
+        return static_cast<size_t>(value);
+    }
+    uint32_t shift = highestBit(value) - (subBucketBits - 1);
+    return static_cast<size_t>(shift) * halfBuckets + static_cast<size_t>(value >> shift);
+}
+
+uint64_t latencyHistogram::bucketHighest(size_t index)
+{
+    if (index < subBuckets)
+    {
+        return index;
+    }
+    uint32_t shift = static_cast<uint32_t>(index / halfBuckets) - 1;
+    uint64_t lower = static_cast<uint64_t>(index - shift * halfBuckets) << shift;
+    return lower + (1ull << shift) - 1;
+}
+
+void latencyHistogram::record(uint64_t value)
+{
+    if (value > _maxValue)
+    {
+        value = _maxValue;
+    }
+    _counts[bucketIndex(value)]++;
+    _count++;
+    _sum += static_cast<double>(value);
+    _min = (value < _min) ? value : _min;
+    _max = (value > _max) ? value : _max;
+}
+
+void latencyHistogram::merge(const latencyHistogram& other)
+{
+    size_t buckets = (other._counts.size() < _counts.size()) ? other._counts.size() : _counts.size();
+    for (size_t i = 0; i < buckets; i++)
+    {
+        _counts[i] += other._counts[i];
+    }
+    _count += other._count;
+    _sum += other._sum;
+    _min = (other._min < _min) ? other._min : _min;
+    _max = (other._max > _max) ? other._max : _max;
+}
+
+void latencyHistogram::reset()
+{
+    _counts.assign(_counts.size(), 0);
+    _count = 0;
+    _sum   = 0.0;
+    _min   = UINT64_MAX;
+    _max   = 0;
+}
+
+uint64_t latencyHistogram::getCount() const
+{
+    return _count;
+}
+
+uint64_t latencyHistogram::getMin() const
+{
+    return (_count > 0) ? _min : 0;
+}
+
+uint64_t latencyHistogram::getMax() const
+{
+    return _max;
+}
+
+double latencyHistogram::getMean() const
+{
+    return (_count > 0) ? _sum / static_cast<double>(_count) : 0.0;
+}
+
+uint64_t latencyHistogram::getPercentile(double percentile) const
+{
+    if (_count == 0)
+    {
+        return 0;
+    }
+    percentile = (percentile < 0.0) ? 0.0 : (percentile > 100.0) ? 100.0 : percentile;
+
+    // Smallest bucket that holds the rank, at least the first value
+    uint64_t rank  = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(_count) + 0.5);
+    rank           = (rank == 0) ? 1 : rank;
+    uint64_t total = 0;
+    for (size_t i = 0; i < _counts.size(); i++)
+    {
+        total += _counts[i];
+        if (total >= rank)
+        {
+            uint64_t highest = bucketHighest(i);
+            return (highest < _max) ? highest : _max;
+        }
+    }
+    return _max;
+}
+
+size_t latencyHistogram::formatSummary(char* buffer, size_t size, double unitDivisor, const char* unit) const
+{
+    format::textWriter out(buffer, size);
+    out.print("count %llu  min %.1f  mean %.1f  p50 %.1f  p90 %.1f  p99 %.1f  p99.9 %.1f  max %.1f %s", static_cast<unsigned long long>(_count), getMin() / unitDivisor,
+              getMean() / unitDivisor, getPercentile(50.0) / unitDivisor, getPercentile(90.0) / unitDivisor, getPercentile(99.0) / unitDivisor, getPercentile(99.9) / unitDivisor,
+              getMax() / unitDivisor, unit);
+    return out.length();
+}
+
+size_t latencyHistogram::formatDistribution(char* buffer, size_t size, double unitDivisor) const
+{
+    format::textWriter out(buffer, size);
+    out.print("%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+    if (_count == 0)
+    {
+        return out.length();
+    }
+
+    // Walk the buckets once, emitting a row each time the running total passes the next reporting percentile
+    double   reportPercentile = 0.0;
+    uint64_t total            = 0;
+    for (size_t i = 0; i < _counts.size() && total < _count; i++)
+    {
+        if (_counts[i] == 0)
+        {
+            continue;
+        }
+        total += _counts[i];
+        double   percentile = 100.0 * static_cast<double>(total) / static_cast<double>(_count);
+        uint64_t highest    = bucketHighest(i);
+        highest             = (highest < _max) ? highest : _max;
+        while (percentile >= reportPercentile && total < _count)
+        {
+            out.print("%12.3f %14.12f %10llu %14.2f\n", highest / unitDivisor, reportPercentile / 100.0, static_cast<unsigned long long>(total),
+                      100.0 / (100.0 - reportPercentile));
+            // distributionRows steps per halving: 0, 10, ..., 50, 55, ..., 75, 77.5, ...
+            double halvings = floor(log2(100.0 / (100.0 - reportPercentile)));
+            reportPercentile += 100.0 / (distributionRows * pow(2.0, halvings + 1.0));
+        }
+    }
+    out.print("%12.3f %14.12f %10llu %14s\n", _max / unitDivisor, 1.0, static_cast<unsigned long long>(_count), "inf");
+    return out.length();
+}
@@ -0,0 +1,95 @@
+/**
+ * @file latencyHistogram.h
+ * @brief Header file for latencyHistogram
+ *
+ * This file contains declarations for the latencyHistogram class and related data types and functions.
+ */
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief Log-linear latency histogram in the style of HdrHistogram
+ *
+ * Every power of two range is split into latencyHistogram::subBuckets equal buckets, so any recorded value is
+ * kept with a relative error below 1/subBuckets (0.8 %) over the whole range, in a fixed amount of memory.
+ * record() is O(1) and allocation free. Not thread safe, use one histogram per thread and merge() them.
+ */
+class latencyHistogram
+{
+public:
+    static constexpr uint32_t subBucketBits = 7;
+    static constexpr uint32_t subBuckets    = 1u << subBucketBits;
+
+private:
+    std::vector<uint32_t> _counts;
+    uint64_t              _maxValue;
+    uint64_t              _count;
+    uint64_t              _min;
+    uint64_t              _max;
+    double                _sum;
+
+    static size_t   bucketIndex(uint64_t value);
+    static uint64_t bucketHighest(size_t index);
+
+public:
+    /**
+     * @brief Construct a new latencyHistogram object
+     *
+     * @param maxValue - largest value kept exactly, larger values are recorded as maxValue (default 60 s in ns)
+     */
+    explicit latencyHistogram(uint64_t maxValue = 60000000000ull);
+    ~latencyHistogram();
+
+    /**
+     * @brief Add a value
+     */
+    void record(uint64_t value);
+
+    /**
+     * @brief Add all values of another histogram, both must have the same maxValue
+     */
+    void merge(const latencyHistogram& other);
+
+    void reset();
+
+    uint64_t getCount() const;
+    uint64_t getMin() const;
+    uint64_t getMax() const;
+    double   getMean() const;
+
+    /**
+     * @brief Get the value below or at which the given share of the values lies
+     *
+     * @param percentile - 0.0 to 100.0
+     * @return uint64_t highest value equivalent to the bucket, at most getMax(); 0 if empty
+     */
+    uint64_t getPercentile(double percentile) const;
+
+    /**
+     * @brief One line summary: count, min, mean, p50, p90, p99, p99.9 and max
+     *
+     * @param buffer - output buffer
+     * @param size - buffer size
+     * @param unitDivisor - values are divided by it, e.g. 1000 to print ns values in us
+     * @param unit - unit name printed after the values
+     * @return size_t characters written
+     */
+    size_t formatSummary(char* buffer, size_t size, double unitDivisor, const char* unit) const;
+
+    /**
+     * @brief Percentile distribution table in the HdrHistogram text format
+     * Rows are printed at percentiles that halve the remaining share (50, 75, 87.5, ...) up to 100 %.
+     *
+     * @param buffer - output buffer
+     * @param size - buffer size
+     * @param unitDivisor - values are divided by it
+     * @return size_t characters written
+     */
+    size_t formatDistribution(char* buffer, size_t size, double unitDivisor) const;
+};
+
+#endif /* LATENCYHISTOGRAM_H */
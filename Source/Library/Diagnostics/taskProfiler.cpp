@@ -0,0 +1,163 @@
+/**
+ * @file taskProfiler.cpp
+ * @brief Source file for taskProfiler
+ *
+ * This file contains definitions for the taskProfiler class and related data types and functions.
+ */
+
+#include "taskProfiler.h"
+#include "Library/Common/textFormat.h"
+
+namespace
+{
+const char* const systemBucketName = "system";
+} // namespace
+
+taskProfiler::taskProfiler(size_t maxProcesses) : _maxProcesses(maxProcesses), _lastTotalRunTime(0), _lastTimeMs(0), _samples(0)
+{
+    _names.reserve(maxProcesses);
+    _profiles.reserve(maxProcesses + 1);
+    processProfile_t system = {systemBucketName, 0, 0.0f, 0, 0, 0.0f};
+    _profiles.push_back(system);
+}
+
+taskProfiler::~taskProfiler()
+{
+    // destructor implementation
+}
+
+int16_t taskProfiler::addProcess(const char* name)
+{
+    if (_names.size() >= _maxProcesses)
+    {
+        return -1;
+    }
+
+    _names.push_back(name);
+    processProfile_t profile = {name, 0, 0.0f, 0, 0, 0.0f};
+    _profiles.insert(_profiles.end() - 1, profile);
+    return static_cast<int16_t>(_names.size() - 1);
+}
+
+void taskProfiler::update(const taskSample_t* samples, size_t count, uint32_t totalRunTime, uint32_t nowMs)
+{
+    uint32_t elapsedRunTime = totalRunTime - _lastTotalRunTime;
+    uint32_t elapsedMs      = nowMs - _lastTimeMs;
+    bool     baseline       = (_samples == 0);
+
+    for (processProfile_t& profile : _profiles)
+    {
+        profile.tasks             = 0;
+        profile.cpuPercent        = 0.0f;
+        profile.stackHeadroom     = 0;
+        profile.stackSize         = 0;
+        profile.switchesPerSecond = 0.0f;
+    }
+
+    _current.clear();
+    for (size_t i = 0; i < count; i++)
+    {
+        const taskSample_t& sample  = samples[i];
+        size_t              bucket  = (sample.process >= 0 && static_cast<size_t>(sample.process) < _names.size()) ? sample.process : _profiles.size() - 1;
+        processProfile_t&   profile = _profiles[bucket];
+
+        if (profile.tasks == 0 || sample.stackHighWater < profile.stackHeadroom)
+        {
+            profile.stackHeadroom = sample.stackHighWater;
+            profile.stackSize     = sample.stackSize;
+        }
+        profile.tasks++;
+
+        const previous_t* previous = findPrevious(sample.id);
+        if (!baseline && previous != nullptr)
+        {
+            if (elapsedRunTime > 0)
+            {
+                profile.cpuPercent += 100.0f * static_cast<float>(sample.runTime - previous->runTime) / static_cast<float>(elapsedRunTime);
+            }
+            if (elapsedMs > 0)
+            {
+                profile.switchesPerSecond += 1000.0f * static_cast<float>(sample.switches - previous->switches) / static_cast<float>(elapsedMs);
+            }
+        }
+
+        previous_t next = {sample.id, sample.runTime, sample.switches};
+        _current.push_back(next);
+    }
+
+    _previous.swap(_current);
+    _lastTotalRunTime = totalRunTime;
+    _lastTimeMs       = nowMs;
+    _samples++;
+}
+
+size_t taskProfiler::getProfileCount()
+{
+    return _profiles.size();
+}
+
+processProfile_t taskProfiler::getProfile(size_t index)
+{
+    processProfile_t empty = {};
+    return (index < _profiles.size()) ? _profiles[index] : empty;
+}
+
+size_t taskProfiler::formatText(char* buffer, size_t size)
+{
+    format::textWriter out(buffer, size);
+    for (const processProfile_t& profile : _profiles)
+    {
+        out.print("%-12s tasks %2u  cpu %5.1f%%  stack free %6u/%-6u  switches %7.1f/s\n", profile.name, static_cast<unsigned>(profile.tasks), profile.cpuPercent,
+                  static_cast<unsigned>(profile.stackHeadroom), static_cast<unsigned>(profile.stackSize), profile.switchesPerSecond);
+    }
+    return out.length();
+}
+
+size_t taskProfiler::formatJson(char* buffer, size_t size, bool* truncated)
+{
+    format::textWriter out(buffer, size);
+    bool               dropped = false;
+    if (size < 3)
+    {
+        if (truncated != nullptr)
+        {
+            *truncated = true;
+        }
+        return 0;
+    }
+
+    // Each profile is formatted aside and kept only if the closing bracket still fits behind it
+    out.append('[');
+    for (size_t i = 0; i < _profiles.size(); i++)
+    {
+        const processProfile_t&                           profile = _profiles[i];
+        format::fixedString<TASKPROFILER_JSON_ENTRY_SIZE> entry;
+        entry.print("%s{\"process\":\"%s\",\"tasks\":%u,\"cpuPercent\":%.1f,\"stackHeadroom\":%u,\"stackSize\":%u,\"switchesPerSecond\":%.1f}", (i > 0) ? "," : "",
+                    profile.name, static_cast<unsigned>(profile.tasks), profile.cpuPercent, static_cast<unsigned>(profile.stackHeadroom), static_cast<unsigned>(profile.stackSize),
+                    profile.switchesPerSecond);
+        if (entry.truncated() || out.length() + entry.length() + 2 > size)
+        {
+            dropped = true;
+            break;
+        }
+        out.append(entry.c_str(), entry.length());
+    }
+    out.append(']');
+    if (truncated != nullptr)
+    {
+        *truncated = dropped;
+    }
+    return out.length();
+}
+
+const taskProfiler::previous_t* taskProfiler::findPrevious(uintptr_t id)
+{
+    for (const previous_t& previous : _previous)
+    {
+        if (previous.id == id)
+        {
+            return &previous;
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file taskProfiler.h
+ * @brief Header file for taskProfiler
+ *
+ * This file contains declarations for the taskProfiler class and related data types and functions.
+ */
+#ifndef TASKPROFILER_H
+#define TASKPROFILER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#define TASKPROFILER_JSON_ENTRY_SIZE 192 // formatJson() bytes of one profile, process names up to 32 characters
+
+/**
+ * @brief One task as seen by the scheduler at sampling time
+ */
+typedef struct
+{
+    uintptr_t id;             // task handle
+    int16_t   process;        // index returned by addProcess(), -1 for tasks not owned by a process
+    char      name[16];       // task name
+    uint32_t  runTime;        // run time counter, wraps around
+    uint32_t  stackHighWater; // stack bytes never used since the task started
+    uint32_t  stackSize;      // configured stack in bytes, 0 if unknown
+    uint32_t  switches;       // times the task was switched in, wraps around, 0 if not traced
+    int8_t    core;           // core the task is pinned to, -1 for none
+    uint8_t   priority;       // current priority
+} taskSample_t;
+
+/**
+ * @brief Profile of one process over the last sampling period
+ */
+typedef struct
+{
+    const char* name;
+    uint32_t    tasks;             // tasks of the process seen in the last sample
+    float       cpuPercent;        // share of the elapsed run time, 100 % equals one busy core
+    uint32_t    stackHeadroom;     // smallest stack high water mark of its tasks in bytes
+    uint32_t    stackSize;         // configured stack of the task with the smallest headroom, 0 if unknown
+    float       switchesPerSecond; // context switches into its tasks
+} processProfile_t;
+
+/**
+ * @brief Turns periodic task samples into per-process CPU, stack and context switch figures
+ *
+ * The scheduler specific part (uxTaskGetSystemState() on the target) collects the samples and maps
+ * tasks to processes; this class keeps the previous counters and computes the deltas, so it runs on the host as well.
+ * Tasks that do not belong to a registered process are reported under "system".
+ */
+class taskProfiler
+{
+private:
+    typedef struct
+    {
+        uintptr_t id;
+        uint32_t  runTime;
+        uint32_t  switches;
+    } previous_t;
+
+    std::vector<const char*>      _names;
+    std::vector<processProfile_t> _profiles; // one more than _names: the system bucket
+    std::vector<previous_t>       _previous;
+    std::vector<previous_t>       _current; // next _previous, kept to reuse its storage
+    size_t                        _maxProcesses;
+    uint32_t                      _lastTotalRunTime;
+    uint32_t                      _lastTimeMs;
+    uint32_t                      _samples;
+
+    const previous_t* findPrevious(uintptr_t id);
+
+public:
+    /**
+     * @brief Construct a new taskProfiler object
+     *
+     * @param maxProcesses - maximum number of registered processes (default 16)
+     */
+    explicit taskProfiler(size_t maxProcesses = 16);
+    ~taskProfiler();
+
+    /**
+     * @brief Register a process
+     *
+     * @param name - process name, must stay valid
+     * @return int16_t process index for taskSample_t::process, -1 if the table is full
+     */
+    int16_t addProcess(const char* name);
+
+    /**
+     * @brief Feed a new sample of all tasks
+     * The first sample only sets the baseline, tasks seen for the first time count from the next sample on.
+     *
+     * @param samples - tasks
+     * @param count - number of tasks
+     * @param totalRunTime - total run time counter, same unit as taskSample_t::runTime
+     * @param nowMs - sampling time in milliseconds
+     */
+    void update(const taskSample_t* samples, size_t count, uint32_t totalRunTime, uint32_t nowMs);
+
+    /**
+     * @brief Get the number of profiles, registered processes plus the system bucket
+     *
+     * @return size_t
+     */
+    size_t getProfileCount();
+
+    /**
+     * @brief Get a profile
+     *
+     * @param index - profile index, the last one is the system bucket
+     * @return processProfile_t
+     */
+    processProfile_t getProfile(size_t index);
+
+    /**
+     * @brief Write the profiles as one log friendly line per process
+     *
+     * @param buffer - output buffer
+     * @param size - buffer size
+     * @return size_t characters written, without the terminating null
+     */
+    size_t formatText(char* buffer, size_t size);
+
+    /**
+     * @brief Write the profiles as a JSON array
+     *
+     * Only whole profiles are written and the array is always closed, profiles that do not fit are left out.
+     * (getProfileCount() + 1) * TASKPROFILER_JSON_ENTRY_SIZE bytes hold every profile.
+     *
+     * @param buffer - output buffer
+     * @param size - buffer size
+     * @param truncated - set to true if profiles were left out (optional)
+     * @return size_t characters written, without the terminating null, 0 if the buffer cannot hold "[]"
+     */
+    size_t formatJson(char* buffer, size_t size, bool* truncated = nullptr);
+};
+
+#endif /* TASKPROFILER_H */
@@ -0,0 +1,39 @@
+/**
+ * @file trace.cpp
+ * @brief Source file for trace
+ *
+ * This file contains definitions for the trace points and related data types and functions.
+ */
+
+#include "trace.h"
+
+#if defined(ESP_PLATFORM)
+#include "freertos/FreeRTOS.h"
+#endif
+
+namespace
+{
+#define TRACE_EVENT_NAME(_id, _name) _name,
+const char* const eventNames[] = {TRACE_EVENTS(TRACE_EVENT_NAME)};
+#undef TRACE_EVENT_NAME
+
+#if defined(ESP_PLATFORM)
+constexpr size_t traceCores = portNUM_PROCESSORS;
+#else
+constexpr size_t traceCores = 1;
+#endif
+
+// Namespace scope rather than function statics: trace points in interrupts must not hit a guard variable
+traceRecord_t storage[traceCores * TRACE_RECORDS_PER_CORE];
+traceBuffer   systemTrace(storage, TRACE_RECORDS_PER_CORE, traceCores, eventNames, TRACE_EVENT_MAX);
+} // namespace
+
+const char* traceEventName(uint16_t event)
+{
+    return (event < TRACE_EVENT_MAX) ? eventNames[event] : "unknown";
+}
+
+traceBuffer& tracer()
+{
+    return systemTrace;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file trace.h
+ * @brief Header file for trace
+ *
+ * This file contains declarations for the trace points and related data types and functions.
+ */
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "traceBuffer.h"
+
+// 1: trace points record into tracer(), 0: the TRACE_* macros expand to nothing and their arguments are not evaluated
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 0
+#endif
+
+/**
+ * @brief Trace events, X(id, name)
+ * New events are appended, the id is the position in this list.
+ */
+#define TRACE_EVENTS(X)                            \
+    X(GPIO_ISR, "io_gpio.isr")                     \
+    X(GPIO_DEBOUNCE, "io_gpio.debounce")           \
+    X(GPIO_LATENCY, "io_gpio.isr_to_listener")     \
+    X(BUTTON_EVENT, "Proc_Button.event")           \
+    X(LEDS_CYCLE, "Proc_Leds.cycle")               \
+    X(HTTP_WELCOME, "proc_httpServer.welcome")     \
+    X(HTTP_CONNECT, "proc_httpServer.connect")     \
+    X(HTTP_CTRL, "proc_httpServer.ctrl")           \
+    X(HTTP_TRACE_DUMP, "proc_httpServer.trace")    \
+    X(WIFI_EVENT, "cpx_wifi.wifi_event")           \
+    X(WIFI_IP_EVENT, "cpx_wifi.ip_event")          \
+    X(WIFI_POWER_SAVE, "cpx_wifi.apply_power_save")
+
+#define TRACE_EVENT_ENUM(_id, _name) TRACE_EVENT_##_id,
+
+typedef enum : uint16_t
+{
+    TRACE_EVENTS(TRACE_EVENT_ENUM) TRACE_EVENT_MAX,
+} traceEvent_t;
+
+#undef TRACE_EVENT_ENUM
+
+/**
+ * @brief Get the name of a trace event
+ *
+ * @param event - event id
+ * @return const char* "unknown" for ids out of range
+ */
+const char* traceEventName(uint16_t event);
+
+/**
+ * @brief The system trace buffer, TRACE_RECORDS_PER_CORE records for each core
+ *
+ * @return traceBuffer&
+ */
+traceBuffer& tracer();
+
+/**
+ * @brief Records a begin/end pair around a scope, for functions with several exits
+ */
+class traceScope
+{
+private:
+    uint16_t _event;
+    uint32_t _arg;
+
+public:
+    traceScope(uint16_t event, uint32_t arg) : _event(event), _arg(arg)
+    {
+        tracer().record(_event, TRACE_PHASE_BEGIN, _arg);
+    }
+
+    ~traceScope()
+    {
+        tracer().record(_event, TRACE_PHASE_END, _arg);
+    }
+
+    // Delete copy constructor and assignment operator
+    traceScope(const traceScope&)            = delete;
+    traceScope& operator=(const traceScope&) = delete;
+};
+
+#if TRACE_ENABLED
+#define TRACE_BEGIN(event, arg)      tracer().record(TRACE_EVENT_##event, TRACE_PHASE_BEGIN, static_cast<uint32_t>(arg))
+#define TRACE_END(event, arg)        tracer().record(TRACE_EVENT_##event, TRACE_PHASE_END, static_cast<uint32_t>(arg))
+#define TRACE_INSTANT(event, arg)    tracer().record(TRACE_EVENT_##event, TRACE_PHASE_INSTANT, static_cast<uint32_t>(arg))
+#define TRACE_ASYNC_BEGIN(event, id) tracer().record(TRACE_EVENT_##event, TRACE_PHASE_ASYNC_BEGIN, static_cast<uint32_t>(id))
+#define TRACE_ASYNC_END(event, id)   tracer().record(TRACE_EVENT_##event, TRACE_PHASE_ASYNC_END, static_cast<uint32_t>(id))
+#define TRACE_SCOPE(event, arg)      traceScope traceScope_##event(TRACE_EVENT_##event, static_cast<uint32_t>(arg))
+#else
+#define TRACE_BEGIN(event, arg)      do {} while (0)
+#define TRACE_END(event, arg)        do {} while (0)
+#define TRACE_INSTANT(event, arg)    do {} while (0)
+#define TRACE_ASYNC_BEGIN(event, id) do {} while (0)
+#define TRACE_ASYNC_END(event, id)   do {} while (0)
+#define TRACE_SCOPE(event, arg)      do {} while (0)
+#endif
+
+#endif /* TRACE_H */
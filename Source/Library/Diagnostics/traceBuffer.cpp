@@ -0,0 +1,195 @@
+/**
+ * @file traceBuffer.cpp
+ * @brief Source file for traceBuffer
+ *
+ * This file contains definitions for the traceBuffer class and related data types and functions.
+ */
+
+#include "traceBuffer.h"
+#include <string.h>
+
+#if defined(ESP_PLATFORM)
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#else
+#include <chrono>
+#include <thread>
+#endif
+
+namespace
+{
+constexpr uint16_t dumpVersion = 1;
+
+#if defined(ESP_PLATFORM)
+inline uint32_t readCycles()
+{
+    return esp_cpu_get_cycle_count();
+}
+
+inline uint8_t currentCore()
+{
+    return static_cast<uint8_t>(esp_cpu_get_core_id());
+}
+
+inline uint32_t currentTask()
+{
+    return xPortInIsrContext() ? 0 : reinterpret_cast<uint32_t>(xTaskGetCurrentTaskHandle());
+}
+#else
+// The host has no portable cycle counter, nanoseconds of the steady clock stand in for it
+inline uint32_t readCycles()
+{
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+inline uint8_t currentCore()
+{
+    return 0;
+}
+
+inline uint32_t currentTask()
+{
+    return static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1;
+}
+#endif
+} // namespace
+
+traceBuffer::traceBuffer(traceRecord_t* storage, uint32_t recordsPerCore, size_t cores, const char* const* eventNames, size_t eventCount)
+    : _cores((cores < TRACE_MAX_CORES) ? cores : TRACE_MAX_CORES), _mask(recordsPerCore - 1), _enabled(true), _eventNames(eventNames), _eventCount(eventCount)
+{
+    for (size_t core = 0; core < TRACE_MAX_CORES; core++)
+    {
+        _rings[core].records = (core < _cores) ? storage + core * recordsPerCore : nullptr;
+        _rings[core].head.store(0, std::memory_order_relaxed);
+    }
+}
+
+traceBuffer::~traceBuffer()
+{
+    // destructor implementation
+}
+
+void traceBuffer::record(uint16_t event, tracePhase_t phase, uint32_t arg)
+{
+    if (!_enabled.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    // The timestamp is taken before the slot is claimed, an interrupt in between leaves the two records
+    // at most its own duration out of order, which the signed delta unwrapping of the readers tolerates
+    uint32_t cycles = readCycles();
+    uint8_t  core   = currentCore();
+    if (core >= _cores)
+    {
+        return;
+    }
+    ring_t&        ring = _rings[core];
+    traceRecord_t& slot = ring.records[ring.head.fetch_add(1, std::memory_order_relaxed) & _mask];
+    slot.cycles         = cycles;
+    slot.event          = event;
+    slot.phase          = phase;
+    slot.core           = core;
+    slot.arg            = arg;
+    slot.task           = currentTask();
+}
+
+void traceBuffer::setEnabled(bool enabled)
+{
+    _enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool traceBuffer::isEnabled()
+{
+    return _enabled.load(std::memory_order_relaxed);
+}
+
+void traceBuffer::clear()
+{
+    for (size_t core = 0; core < _cores; core++)
+    {
+        _rings[core].head.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint32_t traceBuffer::getRecordCount(size_t core)
+{
+    if (core >= _cores)
+    {
+        return 0;
+    }
+    uint32_t head = _rings[core].head.load(std::memory_order_acquire);
+    return (head > _mask) ? _mask + 1 : head;
+}
+
+size_t traceBuffer::getRecords(size_t core, traceRecord_t* records, size_t maxRecords)
+{
+    uint32_t count = getRecordCount(core);
+    if (count > maxRecords)
+    {
+        count = static_cast<uint32_t>(maxRecords);
+    }
+    uint32_t head  = _rings[core].head.load(std::memory_order_acquire);
+    uint32_t first = head - count;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        records[i] = _rings[core].records[(first + i) & _mask];
+    }
+    return count;
+}
+
+bool traceBuffer::serialize(const traceWriter_t& writer)
+{
+    bool wasEnabled = _enabled.exchange(false);
+
+    traceDumpHeader_t header = {};
+    header.magic             = TRACE_DUMP_MAGIC;
+    header.version           = dumpVersion;
+    header.cores             = static_cast<uint16_t>(_cores);
+    header.cyclesPerUs       = cyclesPerUs();
+    header.recordsPerCore    = _mask + 1;
+    header.eventCount        = static_cast<uint32_t>(_eventCount);
+    for (size_t core = 0; core < _cores; core++)
+    {
+        uint32_t head = _rings[core].head.load(std::memory_order_acquire);
+        header.dropped += (head > _mask) ? head - (_mask + 1) : 0;
+    }
+
+    bool ok = writer(&header, sizeof(header));
+    for (size_t i = 0; ok && i < _eventCount; i++)
+    {
+        const char* name = (_eventNames[i] != nullptr) ? _eventNames[i] : "";
+        ok               = writer(name, strlen(name) + 1);
+    }
+
+    for (size_t core = 0; ok && core < _cores; core++)
+    {
+        uint32_t count = getRecordCount(core);
+        uint32_t first = _rings[core].head.load(std::memory_order_acquire) - count;
+        ok             = writer(&count, sizeof(count));
+
+        // Hand out the contiguous parts of the ring directly instead of copying them
+        while (ok && count > 0)
+        {
+            uint32_t offset = first & _mask;
+            uint32_t chunk  = (_mask + 1 - offset < count) ? _mask + 1 - offset : count;
+            ok              = writer(&_rings[core].records[offset], chunk * sizeof(traceRecord_t));
+            first += chunk;
+            count -= chunk;
+        }
+    }
+
+    _enabled.store(wasEnabled);
+    return ok;
+}
+
+uint32_t traceBuffer::cyclesPerUs()
+{
+#if defined(ESP_PLATFORM)
+    return esp_rom_get_cpu_ticks_per_us();
+#else
+    return 1000;
+#endif
+}
@@ -0,0 +1,155 @@
+/**
+ * @file traceBuffer.h
+ * @brief Header file for traceBuffer
+ *
+ * This file contains declarations for the traceBuffer class and related data types and functions.
+ */
+#ifndef TRACEBUFFER_H
+#define TRACEBUFFER_H
+
+#include <atomic>
+#include <functional>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TRACE_MAX_CORES        2
+#define TRACE_RECORDS_PER_CORE 512        // power of two, 8 KiB per core
+#define TRACE_DUMP_MAGIC       0x31435254 // "TRC1"
+
+/**
+ * @brief Kind of a trace record, the values are the Chrome trace_event phases
+ */
+typedef enum : uint8_t
+{
+    TRACE_PHASE_BEGIN       = 'B', // start of a span on the current task
+    TRACE_PHASE_END         = 'E', // end of the span started last on the current task
+    TRACE_PHASE_INSTANT     = 'i', // point event
+    TRACE_PHASE_ASYNC_BEGIN = 'b', // start of a span that may end on another task or core, arg is the span id
+    TRACE_PHASE_ASYNC_END   = 'e', // end of the async span with the same event and id
+} tracePhase_t;
+
+/**
+ * @brief One trace point hit, 16 bytes
+ */
+typedef struct
+{
+    uint32_t cycles; // cycle counter, wraps around, ordered per core
+    uint16_t event;  // event id, index into the name table
+    uint8_t  phase;  // tracePhase_t
+    uint8_t  core;
+    uint32_t arg;    // free argument, the span id of async events
+    uint32_t task;   // current task, 0 in interrupt context
+} traceRecord_t;
+
+/**
+ * @brief Header of a serialized trace, followed by the event names (each zero terminated) and for every core
+ * a uint32_t record count and the records of that core, oldest first. All fields are little endian.
+ */
+typedef struct
+{
+    uint32_t magic;          // TRACE_DUMP_MAGIC
+    uint16_t version;        // 1
+    uint16_t cores;          // number of per core record blocks
+    uint32_t cyclesPerUs;    // cycle counter rate
+    uint32_t recordsPerCore; // ring capacity
+    uint32_t eventCount;     // number of event names
+    uint32_t dropped;        // records overwritten before this dump
+} traceDumpHeader_t;
+
+/**
+ * @brief Receives serialized trace data, returns false to abort
+ */
+typedef std::function<bool(const void* data, size_t length)> traceWriter_t;
+
+/**
+ * @brief Per-core ring of trace records
+ *
+ * record() claims a slot with one atomic increment of the ring of the current core and fills it, so it can be
+ * called from tasks and interrupts alike without a lock. Old records are overwritten when the ring is full.
+ * The cycle counter is 32 bit; consecutive records of a core must be less than 2^31 cycles apart
+ * (about 9 s at 240 MHz) for serialize() readers to unwrap the timestamps.
+ */
+class traceBuffer
+{
+private:
+    typedef struct
+    {
+        traceRecord_t*        records;
+        std::atomic<uint32_t> head; // records ever written
+    } ring_t;
+
+    ring_t             _rings[TRACE_MAX_CORES];
+    size_t             _cores;
+    uint32_t           _mask;
+    std::atomic<bool>  _enabled;
+    const char* const* _eventNames;
+    size_t             _eventCount;
+
+public:
+    /**
+     * @brief Construct a new traceBuffer object
+     *
+     * @param storage - cores * recordsPerCore records, owned by the caller
+     * @param recordsPerCore - ring capacity per core, power of two
+     * @param cores - number of cores, at most TRACE_MAX_CORES
+     * @param eventNames - event names indexed by the event id, written into the dump
+     * @param eventCount - number of event names
+     */
+    traceBuffer(traceRecord_t* storage, uint32_t recordsPerCore, size_t cores, const char* const* eventNames, size_t eventCount);
+    ~traceBuffer();
+
+    // Delete copy constructor and assignment operator
+    traceBuffer(const traceBuffer&)            = delete;
+    traceBuffer& operator=(const traceBuffer&) = delete;
+
+    /**
+     * @brief Add a record to the ring of the current core
+     *
+     * @param event - event id
+     * @param phase - record kind
+     * @param arg - free argument, span id of async events
+     */
+    void record(uint16_t event, tracePhase_t phase, uint32_t arg);
+
+    /**
+     * @brief Start or stop recording, records in flight may still land after disabling
+     */
+    void setEnabled(bool enabled);
+    bool isEnabled();
+
+    /**
+     * @brief Drop all records, recording should be disabled
+     */
+    void clear();
+
+    /**
+     * @brief Number of records currently held by a core's ring
+     */
+    uint32_t getRecordCount(size_t core);
+
+    /**
+     * @brief Copy the records of a core, oldest first
+     *
+     * @param core - core index
+     * @param records - output, at least getRecordCount(core) records
+     * @param maxRecords - output capacity
+     * @return size_t records copied
+     */
+    size_t getRecords(size_t core, traceRecord_t* records, size_t maxRecords);
+
+    /**
+     * @brief Write the trace in the traceDumpHeader_t format, Scripts/trace_to_chrome.py converts it
+     * Recording is paused while the rings are copied out.
+     *
+     * @param writer - output sink
+     * @return true if the writer accepted all data
+     */
+    bool serialize(const traceWriter_t& writer);
+
+    /**
+     * @brief Cycle counter rate of the platform
+     */
+    static uint32_t cyclesPerUs();
+};
+
+#endif /* TRACEBUFFER_H */
@@ -0,0 +1,172 @@
+/**
+ * @file powerManager.cpp
+ * @brief Source file for powerManager
+ *
+ * This file contains definitions for the powerManager class and related data types and functions.
+ */
+
+#include "powerManager.h"
+#include "Library/Common/textFormat.h"
+#include <inttypes.h>
+
+namespace
+{
+const double usPerHour = 3600.0 * 1000000.0;
+
+double perHour(uint32_t wakeups, uint64_t nowUs)
+{
+    return (nowUs > 0) ? wakeups * usPerHour / static_cast<double>(nowUs) : 0.0;
+}
+
+// Milliseconds until a deadline, 0 if it is due
+uint64_t remainingMs(uint64_t deadline, uint64_t nowUs)
+{
+    return (deadline > nowUs) ? (deadline - nowUs) / 1000 : 0;
+}
+} // namespace
+
+powerManager::powerManager() : _clients(), _count(0) {}
+
+powerManager::~powerManager()
+{
+    // destructor implementation
+}
+
+sys_error_t powerManager::addClient(IPowerClient& client, const char* name)
+{
+    if (_count >= POWER_MAX_CLIENTS)
+    {
+        return ERROR_OUT_OF_MEMORY;
+    }
+    _clients[_count].client = &client;
+    _clients[_count].name   = name;
+    _count++;
+    return ERROR_SUCCESS;
+}
+
+size_t powerManager::getClientCount()
+{
+    return _count;
+}
+
+const char* powerManager::getClientName(size_t index)
+{
+    return (index < _count) ? _clients[index].name : nullptr;
+}
+
+uint32_t powerManager::getWakeups(size_t index, uint64_t nowUs)
+{
+    return (index < _count) ? _clients[index].client->getWakeups(nowUs) : 0;
+}
+
+uint32_t powerManager::getTotalWakeups(uint64_t nowUs)
+{
+    uint32_t total = 0;
+    for (size_t i = 0; i < _count; i++)
+    {
+        total += _clients[i].client->getWakeups(nowUs);
+    }
+    return total;
+}
+
+uint64_t powerManager::getNextDeadline(uint64_t nowUs, size_t* owner)
+{
+    uint64_t earliest = POWER_NO_DEADLINE;
+    for (size_t i = 0; i < _count; i++)
+    {
+        uint64_t deadline = _clients[i].client->getNextDeadline(nowUs);
+        if (deadline < earliest)
+        {
+            earliest = deadline;
+            if (owner != nullptr)
+            {
+                *owner = i;
+            }
+        }
+    }
+    return earliest;
+}
+
+uint64_t powerManager::getSleepTime(uint64_t nowUs)
+{
+    uint64_t deadline = getNextDeadline(nowUs);
+    if (deadline == POWER_NO_DEADLINE)
+    {
+        return POWER_NO_DEADLINE;
+    }
+    return (deadline > nowUs) ? deadline - nowUs : 0;
+}
+
+size_t powerManager::formatText(char* buffer, size_t size, uint64_t nowUs)
+{
+    if (buffer == nullptr || size == 0)
+    {
+        return 0;
+    }
+    format::textWriter out(buffer, size);
+
+    for (size_t i = 0; i < _count; i++)
+    {
+        uint32_t wakeups  = _clients[i].client->getWakeups(nowUs);
+        uint64_t deadline = _clients[i].client->getNextDeadline(nowUs);
+        out.print("%-16s %8" PRIu32 " wakeups %10.1f/h", _clients[i].name, wakeups, perHour(wakeups, nowUs));
+        if (deadline == POWER_NO_DEADLINE)
+        {
+            out.print("  next on event\n");
+        }
+        else
+        {
+            out.print("  next in %" PRIu64 " ms\n", remainingMs(deadline, nowUs));
+        }
+    }
+
+    size_t   owner    = 0;
+    uint64_t deadline = getNextDeadline(nowUs, &owner);
+    if (deadline == POWER_NO_DEADLINE)
+    {
+        out.print("sleep until the next event\n");
+    }
+    else
+    {
+        out.print("sleep %" PRIu64 " ms, woken by %s\n", remainingMs(deadline, nowUs), _clients[owner].name);
+    }
+    return out.length();
+}
+
+size_t powerManager::formatJson(char* buffer, size_t size, uint64_t nowUs)
+{
+    if (buffer == nullptr || size == 0)
+    {
+        return 0;
+    }
+    format::textWriter out(buffer, size);
+
+    out.print("{\"clients\":[");
+    for (size_t i = 0; i < _count; i++)
+    {
+        uint32_t wakeups  = _clients[i].client->getWakeups(nowUs);
+        uint64_t deadline = _clients[i].client->getNextDeadline(nowUs);
+        out.print("%s{\"name\":\"%s\",\"wakeups\":%" PRIu32 ",\"perHour\":%.1f,\"nextMs\":", (i > 0) ? "," : "", _clients[i].name, wakeups, perHour(wakeups, nowUs));
+        if (deadline == POWER_NO_DEADLINE)
+        {
+            out.print("null}");
+        }
+        else
+        {
+            out.print("%" PRIu64 "}", remainingMs(deadline, nowUs));
+        }
+    }
+
+    size_t   owner    = 0;
+    uint64_t deadline = getNextDeadline(nowUs, &owner);
+    out.print("],\"wakeups\":%" PRIu32 ",", getTotalWakeups(nowUs));
+    if (deadline == POWER_NO_DEADLINE)
+    {
+        out.print("\"sleepMs\":null,\"next\":null}");
+    }
+    else
+    {
+        out.print("\"sleepMs\":%" PRIu64 ",\"next\":\"%s\"}", remainingMs(deadline, nowUs), _clients[owner].name);
+    }
+    return out.length();
+}
@@ -0,0 +1,148 @@
+/**
+ * @file powerManager.h
+ * @brief Header file for powerManager
+ *
+ * This file contains declarations for the powerManager class and related data types and functions.
+ */
+#ifndef POWERMANAGER_H
+#define POWERMANAGER_H
+
+#include "System/error_definitions.h"
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#define POWER_MAX_CLIENTS 16
+#define POWER_NO_DEADLINE UINT64_MAX // the client only wakes up on events
+
+/**
+ * @brief Something that wakes the CPU up: a process, a driver
+ *
+ * A client tells when it next needs the CPU on its own, e.g. the next LED pattern transition, and counts the
+ * times its task actually woke up. Clients driven by events only (GPIO, queues) keep the default deadline.
+ */
+class IPowerClient
+{
+private:
+    std::atomic<uint32_t> _wakeups;
+
+public:
+    IPowerClient() : _wakeups(0) {}
+    virtual ~IPowerClient() {}
+
+    /**
+     * @brief Get the time of the next wakeup the client needs, not counting events
+     *
+     * @param nowUs - current time in microseconds since boot
+     * @return uint64_t absolute time in microseconds since boot, POWER_NO_DEADLINE if none
+     */
+    virtual uint64_t getNextDeadline(uint64_t nowUs)
+    {
+        return POWER_NO_DEADLINE;
+    }
+
+    /**
+     * @brief Get the number of wakeups so far
+     *
+     * @param nowUs - current time in microseconds since boot
+     * @return uint32_t
+     */
+    virtual uint32_t getWakeups(uint64_t nowUs)
+    {
+        return _wakeups.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Count one wakeup, called by the client task each time it leaves a blocking wait
+     */
+    void countWakeup()
+    {
+        _wakeups.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Collects the deadlines and wakeups of all clients
+ *
+ * The earliest deadline is how long the CPU may sleep: with tickless idle the scheduler sleeps until then by
+ * itself as long as every task blocks until its own deadline instead of polling. The manager only observes,
+ * it keeps no time of its own and never wakes anything up.
+ */
+class powerManager
+{
+private:
+    typedef struct
+    {
+        IPowerClient* client;
+        const char*   name;
+    } client_t;
+
+    client_t _clients[POWER_MAX_CLIENTS];
+    size_t   _count;
+
+public:
+    powerManager();
+    ~powerManager();
+
+    // Delete copy constructor and assignment operator
+    powerManager(const powerManager&)            = delete;
+    powerManager& operator=(const powerManager&) = delete;
+
+    /**
+     * @brief Add a client
+     *
+     * @param client - client, must outlive the manager
+     * @param name - name used in the reports, must outlive the manager
+     * @return sys_error_t ERROR_OUT_OF_MEMORY if POWER_MAX_CLIENTS are already added
+     */
+    sys_error_t addClient(IPowerClient& client, const char* name);
+
+    size_t      getClientCount();
+    const char* getClientName(size_t index);
+
+    /**
+     * @brief Get the wakeups of a client
+     *
+     * @param index - client index, in order of addClient()
+     * @param nowUs - current time in microseconds since boot
+     * @return uint32_t
+     */
+    uint32_t getWakeups(size_t index, uint64_t nowUs);
+
+    /**
+     * @brief Get the wakeups of all clients
+     */
+    uint32_t getTotalWakeups(uint64_t nowUs);
+
+    /**
+     * @brief Get the earliest deadline of all clients
+     *
+     * @param nowUs - current time in microseconds since boot
+     * @param owner - index of the client with the earliest deadline, unchanged if there is none (optional)
+     * @return uint64_t POWER_NO_DEADLINE if the CPU may sleep until the next event
+     */
+    uint64_t getNextDeadline(uint64_t nowUs, size_t* owner = nullptr);
+
+    /**
+     * @brief Get the time the CPU may sleep from now on
+     *
+     * @return uint64_t microseconds, 0 if a deadline is due, POWER_NO_DEADLINE if there is none
+     */
+    uint64_t getSleepTime(uint64_t nowUs);
+
+    /**
+     * @brief Write one line per client with its wakeups, wakeup rate and next deadline
+     *
+     * @return size_t characters written, without the terminating null
+     */
+    size_t formatText(char* buffer, size_t size, uint64_t nowUs);
+
+    /**
+     * @brief Write the clients as a JSON object
+     *
+     * @return size_t characters written, without the terminating null
+     */
+    size_t formatJson(char* buffer, size_t size, uint64_t nowUs);
+};
+
+#endif /* POWERMANAGER_H */
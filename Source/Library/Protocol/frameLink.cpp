@@ -0,0 +1,429 @@
+/**
+ * @file frameLink.cpp
+ * @brief Source file for frameLink
+ *
+ * This file contains definitions for the frameLink class and related data types and functions.
+ */
+
+#include "frameLink.h"
+#include "Library/Common/cobs.h"
+#include "Library/Common/crc.h"
+
+#include <string.h>
+
+namespace
+{
+constexpr uint8_t frameTypeData = 0x01;
+constexpr uint8_t frameTypeAck  = 0x02;
+constexpr uint8_t frameTypeNak  = 0x03;
+
+constexpr size_t  frameHeaderSize = 3;  // type, sequence, ack
+constexpr uint8_t maxWindow       = 64; // well below half the sequence space, old and new frames stay distinguishable
+} // namespace
+
+frameLinkConfig_t frameLinkDefaultConfig()
+{
+    frameLinkConfig_t config = {256, 8, FRAME_CRC16, 50};
+    return config;
+}
+
+frameLink::frameLink(com_stream& port, const frameLinkConfig_t& config)
+    : _port(port), _config(config), _crcSize((config.crc == FRAME_CRC32) ? 4 : 2), _handler(nullptr), _handlerContext(nullptr), _stats(), _now(0), _txBase(0), _txNext(0), _txTimer(0),
+      _rxExpected(0), _ackPending(false), _rxLength(0), _rxDiscard(false)
+{
+    if (_config.window == 0)
+    {
+        _config.window = 1;
+    }
+    else if (_config.window > maxWindow)
+    {
+        _config.window = maxWindow;
+    }
+
+    // Slots are indexed by sequence % window, which stays consistent across the wrap of the 8-bit sequence
+    // only if the window divides 256
+    while ((_config.window & (_config.window - 1)) != 0)
+    {
+        _config.window &= static_cast<uint8_t>(_config.window - 1);
+    }
+
+    // Slot lengths are stored in 16 bits
+    if (_config.maxPayload > UINT16_MAX)
+    {
+        _config.maxPayload = UINT16_MAX;
+    }
+
+    _txSlots.resize(_config.window * _config.maxPayload);
+    _txLengths.resize(_config.window);
+    _txPending.resize(_config.window);
+    _rxSlots.resize(_config.window * _config.maxPayload);
+    _rxLengths.resize(_config.window);
+    _rxStates.resize(_config.window, SLOT_EMPTY);
+    _rxFrame.resize(cobs::maxEncodedLength(frameHeaderSize + _config.maxPayload + _crcSize));
+}
+
+frameLink::~frameLink()
+{
+    // destructor implementation
+}
+
+void frameLink::setFrameHandler(frameHandler_t handler, void* context)
+{
+    _handlerContext = context;
+    _handler        = handler;
+}
+
+sys_error_t frameLink::send(const uint8_t* payload, size_t length, uint32_t nowMs)
+{
+    if (payload == nullptr && length > 0)
+    {
+        return ERROR_INVALID_ARG;
+    }
+    if (length > _config.maxPayload)
+    {
+        return ERROR_MESSAGE_TOO_LARGE;
+    }
+    if (static_cast<uint8_t>(_txNext - _txBase) >= _config.window)
+    {
+        return ERROR_BUSY;
+    }
+
+    _now          = nowMs;
+    uint8_t slot  = _txNext % _config.window;
+    uint8_t* copy = _txSlots.data() + slot * _config.maxPayload;
+    if (length > 0)
+    {
+        memcpy(copy, payload, length);
+    }
+    _txLengths[slot] = static_cast<uint16_t>(length);
+    if (_txBase == _txNext)
+    {
+        _txTimer = nowMs;
+    }
+
+    // Keep the sequence order on the wire, frames still waiting for room go first
+    _txPending[slot] = !flushPending() || !transmit(frameTypeData, _txNext, copy, length);
+    _txNext++;
+    _stats.framesSent++;
+    return ERROR_SUCCESS;
+}
+
+void frameLink::poll(uint32_t nowMs)
+{
+    _now = nowMs;
+    receive();
+
+    if (_txBase != _txNext && nowMs - _txTimer >= _config.retransmitTimeoutMs)
+    {
+        uint8_t slot = _txBase % _config.window;
+        if (!_txPending[slot])
+        {
+            _txPending[slot] = true;
+            _stats.retransmits++;
+        }
+        _txTimer = nowMs;
+    }
+    flushPending();
+
+    if (_ackPending && transmit(frameTypeAck, 0, nullptr, 0))
+    {
+        _stats.acksSent++;
+    }
+}
+
+bool frameLink::isIdle()
+{
+    return _txBase == _txNext;
+}
+
+frameLinkStats_t frameLink::getStats()
+{
+    return _stats;
+}
+
+bool frameLink::transmit(uint8_t type, uint8_t sequence, const uint8_t* payload, size_t length)
+{
+    size_t     required = cobs::maxEncodedLength(frameHeaderSize + length + _crcSize) + 1;
+    ringSpan_t span     = _port.txAcquire();
+    if (span.length < required)
+    {
+        // Not enough room before the end of the ring: fill it with empty frames and start over at the beginning
+        if (span.length == 0 || _port.txFree() < span.length + required)
+        {
+            return false;
+        }
+        memset(span.data, 0, span.length);
+        _port.txCommit(span.length);
+        span = _port.txAcquire();
+        if (span.length < required)
+        {
+            return false;
+        }
+    }
+
+    uint8_t       header[frameHeaderSize] = {type, sequence, _rxExpected};
+    uint8_t       check[4];
+    cobs::encoder frame(span.data);
+    frame.append(header, frameHeaderSize);
+    frame.append(payload, length);
+    if (_crcSize == 4)
+    {
+        uint32_t crc = crc::crc32(payload, length, crc::crc32(header, frameHeaderSize));
+        check[0]     = static_cast<uint8_t>(crc);
+        check[1]     = static_cast<uint8_t>(crc >> 8);
+        check[2]     = static_cast<uint8_t>(crc >> 16);
+        check[3]     = static_cast<uint8_t>(crc >> 24);
+    }
+    else
+    {
+        uint16_t crc = crc::crc16(payload, length, crc::crc16(header, frameHeaderSize));
+        check[0]     = static_cast<uint8_t>(crc);
+        check[1]     = static_cast<uint8_t>(crc >> 8);
+    }
+    frame.append(check, _crcSize);
+
+    size_t encoded       = frame.finish();
+    span.data[encoded++] = 0;
+    _port.txCommit(encoded);
+
+    // Every frame carries the cumulative acknowledgement
+    _ackPending = false;
+    return true;
+}
+
+bool frameLink::flushPending()
+{
+    for (uint8_t sequence = _txBase; sequence != _txNext; sequence++)
+    {
+        uint8_t slot = sequence % _config.window;
+        if (_txPending[slot])
+        {
+            if (!transmit(frameTypeData, sequence, _txSlots.data() + slot * _config.maxPayload, _txLengths[slot]))
+            {
+                return false;
+            }
+            _txPending[slot] = false;
+        }
+    }
+    return true;
+}
+
+void frameLink::receive()
+{
+    for (;;)
+    {
+        ringSpan_t span = _port.rxPeek();
+        if (span.length == 0)
+        {
+            return;
+        }
+
+        uint8_t* delimiter = static_cast<uint8_t*>(memchr(span.data, 0, span.length));
+        size_t   chunk     = (delimiter != nullptr) ? static_cast<size_t>(delimiter - span.data) : span.length;
+
+        if (delimiter != nullptr && _rxLength == 0 && !_rxDiscard)
+        {
+            // Common case: the whole frame is contiguous in the ring, decode it straight out of there
+            size_t decoded = 0;
+            if (chunk > 0)
+            {
+                if (chunk <= _rxFrame.size() && cobs::decode(span.data, chunk, _rxFrame.data(), decoded))
+                {
+                    handleFrame(_rxFrame.data(), decoded);
+                }
+                else
+                {
+                    _stats.badFrames++;
+                }
+            }
+            _port.rxRelease(chunk + 1);
+            continue;
+        }
+
+        if (!_rxDiscard && _rxLength + chunk <= _rxFrame.size())
+        {
+            memcpy(&_rxFrame[_rxLength], span.data, chunk);
+            _rxLength += chunk;
+        }
+        else if (!_rxDiscard)
+        {
+            _rxDiscard = true;
+            _stats.badFrames++;
+        }
+        _port.rxRelease(chunk + ((delimiter != nullptr) ? 1 : 0));
+
+        if (delimiter != nullptr)
+        {
+            size_t decoded = 0;
+            if (!_rxDiscard && _rxLength > 0)
+            {
+                if (cobs::decode(_rxFrame.data(), _rxLength, _rxFrame.data(), decoded))
+                {
+                    handleFrame(_rxFrame.data(), decoded);
+                }
+                else
+                {
+                    _stats.badFrames++;
+                }
+            }
+            _rxLength  = 0;
+            _rxDiscard = false;
+        }
+    }
+}
+
+void frameLink::handleFrame(uint8_t* frame, size_t length)
+{
+    if (length < frameHeaderSize + _crcSize)
+    {
+        _stats.badFrames++;
+        return;
+    }
+
+    size_t         payloadLength = length - frameHeaderSize - _crcSize;
+    const uint8_t* check         = frame + length - _crcSize;
+    bool           valid;
+    if (_crcSize == 4)
+    {
+        uint32_t received = static_cast<uint32_t>(check[0]) | (static_cast<uint32_t>(check[1]) << 8) | (static_cast<uint32_t>(check[2]) << 16) | (static_cast<uint32_t>(check[3]) << 24);
+        valid             = crc::crc32(frame, length - _crcSize) == received;
+    }
+    else
+    {
+        uint16_t received = static_cast<uint16_t>(check[0] | (check[1] << 8));
+        valid             = crc::crc16(frame, length - _crcSize) == received;
+    }
+    if (!valid)
+    {
+        _stats.badFrames++;
+        return;
+    }
+
+    handleAck(frame[2]);
+    switch (frame[0])
+    {
+        case frameTypeData:
+            if (payloadLength > _config.maxPayload)
+            {
+                _stats.badFrames++;
+                return;
+            }
+            handleData(frame[1], frame + frameHeaderSize, payloadLength);
+            break;
+
+        case frameTypeNak:
+            handleNak(frame[1]);
+            break;
+
+        case frameTypeAck:
+        default:
+            break;
+    }
+}
+
+void frameLink::handleData(uint8_t sequence, const uint8_t* payload, size_t length)
+{
+    uint8_t offset = static_cast<uint8_t>(sequence - _rxExpected);
+    _ackPending    = true;
+
+    if (offset >= 128)
+    {
+        // Already delivered, our acknowledgement got lost: acknowledge again
+        _stats.duplicates++;
+        return;
+    }
+    if (offset >= _config.window)
+    {
+        return;
+    }
+
+    uint8_t slot = sequence % _config.window;
+    if (offset == 0)
+    {
+        deliver(payload, length);
+        _rxStates[slot] = SLOT_EMPTY;
+        _rxExpected++;
+
+        // The gap is closed, hand over what was buffered behind it
+        for (slot = _rxExpected % _config.window; _rxStates[slot] == SLOT_BUFFERED; slot = _rxExpected % _config.window)
+        {
+            deliver(_rxSlots.data() + slot * _config.maxPayload, _rxLengths[slot]);
+            _rxStates[slot] = SLOT_EMPTY;
+            _rxExpected++;
+        }
+        return;
+    }
+
+    if (_rxStates[slot] == SLOT_BUFFERED)
+    {
+        _stats.duplicates++;
+        return;
+    }
+    if (length > 0)
+    {
+        memcpy(_rxSlots.data() + slot * _config.maxPayload, payload, length);
+    }
+    _rxLengths[slot] = static_cast<uint16_t>(length);
+    _rxStates[slot]  = SLOT_BUFFERED;
+    _stats.outOfOrder++;
+    requestMissing(sequence);
+}
+
+void frameLink::handleAck(uint8_t ack)
+{
+    uint8_t acknowledged = static_cast<uint8_t>(ack - _txBase);
+    uint8_t outstanding  = static_cast<uint8_t>(_txNext - _txBase);
+    if (acknowledged == 0 || acknowledged > outstanding)
+    {
+        return;
+    }
+
+    for (; _txBase != ack; _txBase++)
+    {
+        _txPending[_txBase % _config.window] = false;
+    }
+    _txTimer = _now;
+}
+
+void frameLink::handleNak(uint8_t sequence)
+{
+    uint8_t offset = static_cast<uint8_t>(sequence - _txBase);
+    if (offset >= static_cast<uint8_t>(_txNext - _txBase))
+    {
+        return;
+    }
+
+    uint8_t slot = sequence % _config.window;
+    if (!_txPending[slot])
+    {
+        _txPending[slot] = true;
+        _stats.retransmits++;
+    }
+}
+
+void frameLink::requestMissing(uint8_t sequence)
+{
+    for (uint8_t missing = _rxExpected; missing != sequence; missing++)
+    {
+        uint8_t slot = missing % _config.window;
+        if (_rxStates[slot] == SLOT_EMPTY)
+        {
+            if (!transmit(frameTypeNak, missing, nullptr, 0))
+            {
+                return;
+            }
+            _rxStates[slot] = SLOT_NAKED;
+            _stats.naksSent++;
+        }
+    }
+}
+
+void frameLink::deliver(const uint8_t* payload, size_t length)
+{
+    _stats.framesReceived++;
+    frameHandler_t handler = _handler;
+    if (handler != nullptr)
+    {
+        handler(payload, length, _handlerContext);
+    }
+}
@@ -0,0 +1,169 @@
+/**
+ * @file frameLink.h
+ * @brief Header file for frameLink
+ *
+ * This file contains declarations for the frameLink class and related data types and functions.
+ */
+#ifndef FRAMELINK_H
+#define FRAMELINK_H
+
+#include "HAL/Common/com_stream.hpp"
+#include <vector>
+
+/**
+ * @brief Checksum appended to every frame
+ */
+typedef enum : uint8_t
+{
+    FRAME_CRC16 = 0, // CRC-16/CCITT-FALSE, 2 bytes
+    FRAME_CRC32 = 1, // CRC-32, 4 bytes
+} frameCrc_t;
+
+/**
+ * @brief frameLink configuration
+ */
+typedef struct
+{
+    size_t     maxPayload;          // largest payload of a data frame, at most 65535
+    uint8_t    window;              // data frames in flight without acknowledgement, 1..64, rounded down to a power of two
+    frameCrc_t crc;                 // checksum type, both ends must agree
+    uint32_t   retransmitTimeoutMs; // resend the oldest unacknowledged frame after this time without progress
+} frameLinkConfig_t;
+
+/**
+ * @brief frameLink counters
+ */
+typedef struct
+{
+    uint32_t framesSent;     // data frames, first transmission
+    uint32_t framesReceived; // data frames delivered to the handler
+    uint32_t retransmits;    // data frames sent again after a NAK or a timeout
+    uint32_t acksSent;       // stand-alone acknowledgements, data frames carry one as well
+    uint32_t naksSent;       // retransmit requests for frames missing in the sequence
+    uint32_t badFrames;      // frames dropped because of COBS, length or CRC errors
+    uint32_t duplicates;     // data frames received again
+    uint32_t outOfOrder;     // data frames buffered until the missing ones arrive
+} frameLinkStats_t;
+
+/**
+ * @brief Payload handler, runs inside frameLink::poll()
+ */
+typedef void (*frameHandler_t)(const uint8_t* payload, size_t length, void* context);
+
+/**
+ * @brief Default configuration: 256 byte payloads, 8 frames in flight, CRC-16, 50 ms retransmit timeout
+ */
+frameLinkConfig_t frameLinkDefaultConfig();
+
+/**
+ * @brief Reliable, ordered datagram link on top of a com_stream port
+ *
+ * Frame layout before encoding: type, sequence, cumulative acknowledgement, payload, CRC (little endian).
+ * Frames are COBS encoded and terminated by a 0x00 byte, so the receiver resynchronises on the next
+ * delimiter after line noise. Frames are encoded straight into the TX ring of the port and decoded
+ * straight out of its RX ring, without an intermediate copy of the raw frame.
+ *
+ * Reliability uses selective repeat: the receiver buffers frames following a gap, asks for each missing
+ * sequence number with a NAK and delivers in order once the gap is closed. Only the missing frames are resent.
+ * A timeout on the oldest unacknowledged frame covers lost NAKs and acknowledgements.
+ *
+ * Not thread safe: send() and poll() are called from the same task. The port TX ring must hold at least
+ * two frames of maxPayload.
+ */
+class frameLink
+{
+private:
+    typedef enum : uint8_t
+    {
+        SLOT_EMPTY    = 0,
+        SLOT_BUFFERED = 1, // received ahead of a gap
+        SLOT_NAKED    = 2, // missing, retransmission requested
+    } rxSlotState_t;
+
+    com_stream&           _port;
+    frameLinkConfig_t     _config;
+    size_t                _crcSize;
+    frameHandler_t        _handler;
+    void*                 _handlerContext;
+    frameLinkStats_t      _stats;
+    uint32_t              _now;
+    std::vector<uint8_t>  _txSlots; // payload copies kept until acknowledged
+    std::vector<uint16_t> _txLengths;
+    std::vector<bool>     _txPending; // waiting for room in the TX ring or for a retransmission
+    uint8_t               _txBase;    // oldest unacknowledged sequence number
+    uint8_t               _txNext;    // next sequence number to assign
+    uint32_t              _txTimer;   // last time the window made progress
+    std::vector<uint8_t>  _rxSlots;
+    std::vector<uint16_t> _rxLengths;
+    std::vector<uint8_t>  _rxStates;
+    uint8_t               _rxExpected; // next sequence number to deliver
+    bool                  _ackPending;
+    std::vector<uint8_t>  _rxFrame; // frame split across the end of the RX ring
+    size_t                _rxLength;
+    bool                  _rxDiscard; // current frame is too long, skip up to the next delimiter
+
+    bool transmit(uint8_t type, uint8_t sequence, const uint8_t* payload, size_t length);
+    bool flushPending();
+    void receive();
+    void handleFrame(uint8_t* frame, size_t length);
+    void handleData(uint8_t sequence, const uint8_t* payload, size_t length);
+    void handleAck(uint8_t ack);
+    void handleNak(uint8_t sequence);
+    void requestMissing(uint8_t sequence);
+    void deliver(const uint8_t* payload, size_t length);
+
+public:
+    /**
+     * @brief Construct a new frameLink object
+     *
+     * @param port - connected stream port
+     * @param config - link configuration (default frameLinkDefaultConfig())
+     */
+    frameLink(com_stream& port, const frameLinkConfig_t& config = frameLinkDefaultConfig());
+    ~frameLink();
+
+    // Delete copy constructor and assignment operator
+    frameLink(const frameLink&)            = delete;
+    frameLink& operator=(const frameLink&) = delete;
+
+    /**
+     * @brief Set the handler for received payloads
+     *
+     * @param handler - called in order for every payload
+     * @param context - passed to the handler
+     */
+    void setFrameHandler(frameHandler_t handler, void* context);
+
+    /**
+     * @brief Queue a payload, it stays in the window until acknowledged
+     *
+     * @param payload - payload data
+     * @param length - payload length, at most maxPayload
+     * @param nowMs - current time in milliseconds
+     * @return sys_error_t ERROR_BUSY if the window is full, ERROR_MESSAGE_TOO_LARGE if the payload is too long
+     */
+    sys_error_t send(const uint8_t* payload, size_t length, uint32_t nowMs);
+
+    /**
+     * @brief Process received frames, acknowledge them and resend what the peer is missing
+     *
+     * @param nowMs - current time in milliseconds
+     */
+    void poll(uint32_t nowMs);
+
+    /**
+     * @brief Check if every sent payload has been acknowledged
+     *
+     * @return bool
+     */
+    bool isIdle();
+
+    /**
+     * @brief Get the link counters
+     *
+     * @return frameLinkStats_t
+     */
+    frameLinkStats_t getStats();
+};
+
+#endif /* FRAMELINK_H */
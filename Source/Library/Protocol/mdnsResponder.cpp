@@ -0,0 +1,663 @@
+/**
+ * @file mdnsResponder.cpp
+ * @brief Source file for mdnsResponder
+ *
+ * This file contains definitions for the mdnsResponder class and related data types and functions.
+ */
+
+#include "mdnsResponder.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace
+{
+constexpr size_t   headerSize     = 12;
+constexpr uint16_t typeA          = 1;
+constexpr uint16_t typePtr        = 12;
+constexpr uint16_t typeTxt        = 16;
+constexpr uint16_t typeSrv        = 33;
+constexpr uint16_t typeAny        = 255;
+constexpr uint16_t classIn        = 1;
+constexpr uint16_t classFlush     = 0x8000; // unique record, caches drop other records of the name and type
+constexpr uint16_t flagsResponse  = 0x8400; // QR and AA
+constexpr uint16_t flagsQuery     = 0x0000;
+constexpr size_t   maxPointerJump = 16;
+
+// Records of the responses, composed per cached response in responseLayouts
+enum : uint8_t
+{
+    RECORD_SERVICE_PTR     = 0,
+    RECORD_ENUMERATION_PTR = 1,
+    RECORD_SRV             = 2,
+    RECORD_TXT             = 3,
+    RECORD_A               = 4,
+};
+
+struct responseLayout_t
+{
+    uint8_t answers[5];
+    uint8_t answerCount;
+    uint8_t additionals[3];
+    uint8_t additionalCount;
+};
+
+// Indexed like mdnsResponder::_cache
+const responseLayout_t responseLayouts[] = {
+    {{RECORD_SERVICE_PTR}, 1, {RECORD_SRV, RECORD_TXT, RECORD_A}, 3},
+    {{RECORD_ENUMERATION_PTR}, 1, {}, 0},
+    {{RECORD_SRV, RECORD_TXT}, 2, {RECORD_A}, 1},
+    {{RECORD_A}, 1, {}, 0},
+    {{RECORD_SERVICE_PTR, RECORD_ENUMERATION_PTR, RECORD_SRV, RECORD_TXT, RECORD_A}, 5, {}, 0},
+};
+
+struct packetWriter_t
+{
+    uint8_t* data;
+    size_t   size;
+    size_t   length;
+    bool     overflow;
+};
+
+void putBytes(packetWriter_t& writer, const void* bytes, size_t length)
+{
+    if (writer.overflow || writer.length + length > writer.size)
+    {
+        writer.overflow = true;
+        return;
+    }
+    memcpy(writer.data + writer.length, bytes, length);
+    writer.length += length;
+}
+
+void putU16(packetWriter_t& writer, uint16_t value)
+{
+    uint8_t bytes[2] = {static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value)};
+    putBytes(writer, bytes, sizeof(bytes));
+}
+
+void putU32(packetWriter_t& writer, uint32_t value)
+{
+    uint8_t bytes[4] = {static_cast<uint8_t>(value >> 24), static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value)};
+    putBytes(writer, bytes, sizeof(bytes));
+}
+
+void putLabel(packetWriter_t& writer, const char* text, size_t length)
+{
+    if (length == 0 || length > 63)
+    {
+        writer.overflow = true;
+        return;
+    }
+    uint8_t prefix = static_cast<uint8_t>(length);
+    putBytes(writer, &prefix, 1);
+    putBytes(writer, text, length);
+}
+
+// Wire format of [label.]dotted.local, returns 0 if it does not fit
+size_t buildName(uint8_t* name, const char* label, const char* dotted)
+{
+    packetWriter_t writer = {name, MDNS_NAME_SIZE, 0, false};
+    if (label != nullptr)
+    {
+        putLabel(writer, label, strlen(label));
+    }
+    for (const char* part = dotted; part != nullptr && *part != '\0';)
+    {
+        const char* dot = strchr(part, '.');
+        size_t      length = (dot != nullptr) ? static_cast<size_t>(dot - part) : strlen(part);
+        putLabel(writer, part, length);
+        part = (dot != nullptr) ? dot + 1 : nullptr;
+    }
+    putLabel(writer, "local", 5);
+    uint8_t end = 0;
+    putBytes(writer, &end, 1);
+    return writer.overflow ? 0 : writer.length;
+}
+
+void putRecord(packetWriter_t& writer, const uint8_t* name, size_t nameLength, uint16_t type, bool unique, uint32_t ttl, const uint8_t* data, size_t length)
+{
+    putBytes(writer, name, nameLength);
+    putU16(writer, type);
+    putU16(writer, static_cast<uint16_t>(classIn | (unique ? classFlush : 0)));
+    putU32(writer, ttl);
+    putU16(writer, static_cast<uint16_t>(length));
+    putBytes(writer, data, length);
+}
+
+void putHeader(uint8_t* packet, uint16_t flags, uint16_t questions, uint16_t answers, uint16_t additionals)
+{
+    packetWriter_t writer = {packet, headerSize, 0, false};
+    putU16(writer, 0); // id, 0 in multicast DNS
+    putU16(writer, flags);
+    putU16(writer, questions);
+    putU16(writer, answers);
+    putU16(writer, 0);
+    putU16(writer, additionals);
+}
+
+uint16_t getU16(const uint8_t* data)
+{
+    return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+uint32_t getU32(const uint8_t* data)
+{
+    return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) | (static_cast<uint32_t>(data[2]) << 8) | data[3];
+}
+
+uint32_t typeBit(uint16_t type)
+{
+    switch (type)
+    {
+        case typeA:
+            return 1u << 0;
+        case typePtr:
+            return 1u << 1;
+        case typeTxt:
+            return 1u << 2;
+        case typeSrv:
+            return 1u << 3;
+        case typeAny:
+            return 0xFFFFFFFFu;
+        default:
+            return 0;
+    }
+}
+
+// Name at offset, compression pointers followed, in wire format; offset is moved past the name
+bool readName(const uint8_t* packet, size_t length, size_t& offset, uint8_t* name, size_t& nameLength)
+{
+    size_t position = offset;
+    size_t jumps    = 0;
+    bool   jumped   = false;
+    nameLength      = 0;
+    for (;;)
+    {
+        if (position >= length)
+        {
+            return false;
+        }
+        uint8_t label = packet[position];
+        if ((label & 0xC0) == 0xC0)
+        {
+            if (position + 1 >= length || ++jumps > maxPointerJump)
+            {
+                return false;
+            }
+            if (!jumped)
+            {
+                offset = position + 2;
+                jumped = true;
+            }
+            position = (static_cast<size_t>(label & 0x3F) << 8) | packet[position + 1];
+            continue;
+        }
+        if ((label & 0xC0) != 0 || position + 1 + label > length || nameLength + 1 + label > MDNS_NAME_SIZE)
+        {
+            return false;
+        }
+        memcpy(name + nameLength, packet + position, 1 + label);
+        nameLength += 1 + label;
+        position += 1 + label;
+        if (label == 0)
+        {
+            if (!jumped)
+            {
+                offset = position;
+            }
+            return true;
+        }
+    }
+}
+
+// DNS names compare without regard to ASCII case
+bool sameName(const uint8_t* a, size_t aLength, const uint8_t* b, size_t bLength)
+{
+    if (aLength != bLength)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < aLength; i++)
+    {
+        uint8_t x = (a[i] >= 'A' && a[i] <= 'Z') ? static_cast<uint8_t>(a[i] + 32) : a[i];
+        uint8_t y = (b[i] >= 'A' && b[i] <= 'Z') ? static_cast<uint8_t>(b[i] + 32) : b[i];
+        if (x != y)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Dotted form of a wire format name, without the trailing dot
+void nameToText(const uint8_t* name, char* text, size_t size)
+{
+    size_t length = 0;
+    for (size_t position = 0; name[position] != 0 && length + 1 < size; position += 1 + name[position])
+    {
+        if (position > 0)
+        {
+            text[length++] = '.';
+        }
+        for (size_t i = 1; i <= name[position] && length + 1 < size; i++)
+        {
+            text[length++] = static_cast<char>(name[position + i]);
+        }
+    }
+    text[length] = '\0';
+}
+
+// Calls visit(owner, ownerLength, type, ttl, rdataOffset, rdataLength) for every resource record, false if malformed
+template <typename Visitor> bool forEachRecord(const uint8_t* packet, size_t length, Visitor visit)
+{
+    if (length < headerSize)
+    {
+        return false;
+    }
+    size_t  offset = headerSize;
+    uint8_t name[MDNS_NAME_SIZE];
+    size_t  nameLength = 0;
+    for (uint16_t question = getU16(packet + 4); question > 0; question--)
+    {
+        if (!readName(packet, length, offset, name, nameLength) || offset + 4 > length)
+        {
+            return false;
+        }
+        offset += 4;
+    }
+
+    size_t records = static_cast<size_t>(getU16(packet + 6)) + getU16(packet + 8) + getU16(packet + 10);
+    for (; records > 0; records--)
+    {
+        if (!readName(packet, length, offset, name, nameLength) || offset + 10 > length)
+        {
+            return false;
+        }
+        uint16_t type        = getU16(packet + offset);
+        uint32_t ttl         = getU32(packet + offset + 4);
+        size_t   rdataLength = getU16(packet + offset + 8);
+        offset += 10;
+        if (offset + rdataLength > length)
+        {
+            return false;
+        }
+        if (!visit(name, nameLength, type, ttl, offset, rdataLength))
+        {
+            return true;
+        }
+        offset += rdataLength;
+    }
+    return true;
+}
+
+void copyLabel(char* destination, size_t size, const char* source)
+{
+    snprintf(destination, size, "%s", (source != nullptr) ? source : "");
+}
+} // namespace
+
+mdnsConfig_t mdnsDefaultConfig()
+{
+    mdnsConfig_t config;
+    config.hostname    = "esp32";
+    config.instance    = "esp32";
+    config.service     = "_http._tcp";
+    config.port        = 80;
+    config.hostTtlS    = 120;
+    config.serviceTtlS = 4500;
+    return config;
+}
+
+mdnsResponder::mdnsResponder(IHAL_COM& transport, const mdnsConfig_t& config)
+    : _transport(transport), _config(config), _txtLength(0), _address(), _ready(false), _cache(), _announceLeft(0), _announceMs(0), _announceInterval(0), _browseNameLength(0),
+      _handler(nullptr), _handlerContext(nullptr), _stats()
+{
+    copyLabel(_hostname, sizeof(_hostname), _config.hostname);
+    copyLabel(_instance, sizeof(_instance), _config.instance);
+    copyLabel(_service, sizeof(_service), _config.service);
+}
+
+mdnsResponder::~mdnsResponder()
+{
+    // destructor implementation
+}
+
+sys_error_t mdnsResponder::addTxt(const char* key, const char* value)
+{
+    size_t keyLength   = (key != nullptr) ? strlen(key) : 0;
+    size_t valueLength = (value != nullptr) ? strlen(value) : 0;
+    size_t length      = keyLength + ((value != nullptr) ? 1 + valueLength : 0);
+    if (keyLength == 0 || strchr(key, '=') != nullptr)
+    {
+        return ERROR_INVALID_ARG;
+    }
+    if (length > 255 || _txtLength + 1 + length > sizeof(_txt))
+    {
+        return ERROR_BUFFER_OVERFLOW;
+    }
+
+    _txt[_txtLength++] = static_cast<uint8_t>(length);
+    memcpy(_txt + _txtLength, key, keyLength);
+    if (value != nullptr)
+    {
+        _txt[_txtLength + keyLength] = '=';
+        memcpy(_txt + _txtLength + keyLength + 1, value, valueLength);
+    }
+    _txtLength += length;
+    return _ready ? buildCache() : ERROR_SUCCESS;
+}
+
+sys_error_t mdnsResponder::setAddress(const uint8_t address[4], uint32_t nowMs)
+{
+    memcpy(_address, address, sizeof(_address));
+    sys_error_t result = buildCache();
+    _ready             = (result == ERROR_SUCCESS);
+
+    // Announce at once, then after 1 s and 2 s
+    _announceLeft     = _ready ? MDNS_ANNOUNCE_COUNT : 0;
+    _announceMs       = nowMs;
+    _announceInterval = MDNS_RATE_LIMIT_MS;
+    return result;
+}
+
+void mdnsResponder::poll(uint32_t nowMs)
+{
+    for (;;)
+    {
+        size_t received = 0;
+        if (_transport.receiveData(_rx, sizeof(_rx), received) != ERROR_SUCCESS || received == 0)
+        {
+            break;
+        }
+        if (received < headerSize)
+        {
+            _stats.malformed++;
+            continue;
+        }
+        if ((getU16(_rx + 2) & 0x8000) != 0)
+        {
+            _stats.responses++;
+            handleResponse(_rx, received);
+        }
+        else
+        {
+            _stats.queries++;
+            handleQuery(_rx, received, nowMs);
+        }
+    }
+
+    if (_ready && _announceLeft > 0 && static_cast<int32_t>(nowMs - _announceMs) >= 0)
+    {
+        cachedResponse_t& announcement = _cache[CACHE_ANNOUNCEMENT];
+        if (send(announcement.packet, announcement.length))
+        {
+            _stats.announcements++;
+            for (cachedResponse_t& response : _cache)
+            {
+                response.sent   = true;
+                response.sentMs = nowMs;
+            }
+        }
+        _announceLeft--;
+        _announceMs = nowMs + _announceInterval;
+        _announceInterval *= 2;
+    }
+}
+
+uint32_t mdnsResponder::getNextDelayMs(uint32_t nowMs)
+{
+    if (!_ready || _announceLeft == 0)
+    {
+        return UINT32_MAX;
+    }
+    int32_t delay = static_cast<int32_t>(_announceMs - nowMs);
+    return (delay > 0) ? static_cast<uint32_t>(delay) : 0;
+}
+
+sys_error_t mdnsResponder::goodbye()
+{
+    if (!_ready)
+    {
+        return ERROR_INVALID_CONFIG;
+    }
+
+    // The announcement with every TTL cleared
+    uint8_t                 packet[MDNS_PACKET_SIZE];
+    const cachedResponse_t& announcement = _cache[CACHE_ANNOUNCEMENT];
+    memcpy(packet, announcement.packet, announcement.length);
+    forEachRecord(announcement.packet, announcement.length,
+                  [&packet](const uint8_t* name, size_t nameLength, uint16_t type, uint32_t ttl, size_t offset, size_t length)
+                  {
+                      memset(packet + offset - 6, 0, 4);
+                      return true;
+                  });
+    _announceLeft = 0;
+    return send(packet, announcement.length) ? ERROR_SUCCESS : ERROR_TRANSMIT_FAILED;
+}
+
+sys_error_t mdnsResponder::browse(const char* service, mdnsServiceHandler_t handler, void* context)
+{
+    _browseNameLength = buildName(_browseName, nullptr, service);
+    if (_browseNameLength == 0)
+    {
+        return ERROR_INVALID_ARG;
+    }
+    _handler        = handler;
+    _handlerContext = context;
+
+    uint8_t        packet[headerSize + MDNS_NAME_SIZE + 4];
+    packetWriter_t writer = {packet, sizeof(packet), headerSize, false};
+    putHeader(packet, flagsQuery, 1, 0, 0);
+    putBytes(writer, _browseName, _browseNameLength);
+    putU16(writer, typePtr);
+    putU16(writer, classIn);
+    return send(packet, writer.length) ? ERROR_SUCCESS : ERROR_TRANSMIT_FAILED;
+}
+
+mdnsStats_t mdnsResponder::getStats()
+{
+    return _stats;
+}
+
+sys_error_t mdnsResponder::buildCache()
+{
+    uint8_t serviceName[MDNS_NAME_SIZE];
+    uint8_t enumerationName[MDNS_NAME_SIZE];
+    uint8_t instanceName[MDNS_NAME_SIZE];
+    uint8_t hostName[MDNS_NAME_SIZE];
+    uint8_t srv[6 + MDNS_NAME_SIZE];
+    size_t  serviceLength     = buildName(serviceName, nullptr, _service);
+    size_t  enumerationLength = buildName(enumerationName, nullptr, "_services._dns-sd._udp");
+    size_t  instanceLength    = buildName(instanceName, _instance, _service);
+    size_t  hostLength        = buildName(hostName, _hostname, nullptr);
+    if (serviceLength == 0 || instanceLength == 0 || hostLength == 0)
+    {
+        return ERROR_INVALID_CONFIG;
+    }
+
+    // SRV: priority, weight, port, target; an empty TXT record is a single empty string
+    packetWriter_t srvWriter = {srv, sizeof(srv), 0, false};
+    putU16(srvWriter, 0);
+    putU16(srvWriter, 0);
+    putU16(srvWriter, _config.port);
+    putBytes(srvWriter, hostName, hostLength);
+    static const uint8_t emptyTxt = 0;
+    const uint8_t*       txt      = (_txtLength > 0) ? _txt : &emptyTxt;
+    size_t               txtLength = (_txtLength > 0) ? _txtLength : 1;
+
+    auto putKind = [&](packetWriter_t& writer, uint8_t kind)
+    {
+        switch (kind)
+        {
+            case RECORD_SERVICE_PTR:
+                putRecord(writer, serviceName, serviceLength, typePtr, false, _config.serviceTtlS, instanceName, instanceLength);
+                break;
+            case RECORD_ENUMERATION_PTR:
+                putRecord(writer, enumerationName, enumerationLength, typePtr, false, _config.serviceTtlS, serviceName, serviceLength);
+                break;
+            case RECORD_SRV:
+                putRecord(writer, instanceName, instanceLength, typeSrv, true, _config.hostTtlS, srv, srvWriter.length);
+                break;
+            case RECORD_TXT:
+                putRecord(writer, instanceName, instanceLength, typeTxt, true, _config.serviceTtlS, txt, txtLength);
+                break;
+            default:
+                putRecord(writer, hostName, hostLength, typeA, true, _config.hostTtlS, _address, sizeof(_address));
+                break;
+        }
+    };
+
+    const uint8_t* questionNames[CACHE_COUNT]   = {serviceName, enumerationName, instanceName, hostName, nullptr};
+    size_t         questionLengths[CACHE_COUNT] = {serviceLength, enumerationLength, instanceLength, hostLength, 0};
+    uint32_t       typeMasks[CACHE_COUNT]       = {typeBit(typePtr), typeBit(typePtr), typeBit(typeSrv) | typeBit(typeTxt), typeBit(typeA), 0};
+    for (size_t i = 0; i < CACHE_COUNT; i++)
+    {
+        cachedResponse_t&       response = _cache[i];
+        const responseLayout_t& layout   = responseLayouts[i];
+        packetWriter_t          writer   = {response.packet, sizeof(response.packet), headerSize, false};
+        putHeader(response.packet, flagsResponse, 0, layout.answerCount, layout.additionalCount);
+        for (size_t record = 0; record < layout.answerCount; record++)
+        {
+            putKind(writer, layout.answers[record]);
+        }
+        for (size_t record = 0; record < layout.additionalCount; record++)
+        {
+            putKind(writer, layout.additionals[record]);
+        }
+        if (writer.overflow)
+        {
+            return ERROR_BUFFER_OVERFLOW;
+        }
+
+        memcpy(response.name, questionNames[i], questionLengths[i]);
+        response.nameLength = questionLengths[i];
+        response.typeMask   = typeMasks[i];
+        response.length     = writer.length;
+        response.sent       = false;
+    }
+    return ERROR_SUCCESS;
+}
+
+bool mdnsResponder::send(const uint8_t* packet, size_t length)
+{
+    if (_transport.sendData(packet, length) != ERROR_SUCCESS)
+    {
+        _stats.sendFailures++;
+        return false;
+    }
+    return true;
+}
+
+void mdnsResponder::handleQuery(const uint8_t* packet, size_t length, uint32_t nowMs)
+{
+    if (!_ready)
+    {
+        return;
+    }
+
+    // Only the questions are parsed, the answer is sent from the cache
+    uint32_t matched   = 0;
+    size_t   offset    = headerSize;
+    uint16_t questions = getU16(packet + 4);
+    for (uint16_t question = 0; question < questions; question++)
+    {
+        uint8_t name[MDNS_NAME_SIZE];
+        size_t  nameLength = 0;
+        if (!readName(packet, length, offset, name, nameLength) || offset + 4 > length)
+        {
+            _stats.malformed++;
+            return;
+        }
+        uint32_t type = typeBit(getU16(packet + offset));
+        offset += 4;
+        for (size_t i = 0; i < CACHE_ANNOUNCEMENT; i++)
+        {
+            if ((_cache[i].typeMask & type) != 0 && sameName(name, nameLength, _cache[i].name, _cache[i].nameLength))
+            {
+                matched |= 1u << i;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < CACHE_ANNOUNCEMENT; i++)
+    {
+        cachedResponse_t& response = _cache[i];
+        if ((matched & (1u << i)) == 0)
+        {
+            continue;
+        }
+        if (response.sent && nowMs - response.sentMs < MDNS_RATE_LIMIT_MS)
+        {
+            _stats.rateLimited++;
+            continue;
+        }
+        if (send(response.packet, response.length))
+        {
+            _stats.answered++;
+            response.sent   = true;
+            response.sentMs = nowMs;
+        }
+    }
+}
+
+void mdnsResponder::handleResponse(const uint8_t* packet, size_t length)
+{
+    if (_handler == nullptr || _browseNameLength == 0)
+    {
+        return;
+    }
+
+    // PTR records of the browsed type name the instances, SRV and A records of the same packet resolve them
+    bool valid = forEachRecord(packet, length,
+                               [&](const uint8_t* owner, size_t ownerLength, uint16_t type, uint32_t ttl, size_t offset, size_t rdataLength)
+                               {
+                                   uint8_t instanceName[MDNS_NAME_SIZE];
+                                   size_t  instanceLength = 0;
+                                   size_t  nameOffset     = offset;
+                                   if (type != typePtr || !sameName(owner, ownerLength, _browseName, _browseNameLength) ||
+                                       !readName(packet, length, nameOffset, instanceName, instanceLength))
+                                   {
+                                       return true;
+                                   }
+
+                                   uint8_t hostName[MDNS_NAME_SIZE] = {0};
+                                   size_t  hostLength               = 0;
+                                   char    instance[MDNS_LABEL_SIZE];
+                                   char    host[MDNS_NAME_SIZE];
+                                   mdnsService_t service = {instance, host, 0, {0, 0, 0, 0}, ttl};
+                                   forEachRecord(packet, length,
+                                                 [&](const uint8_t* name, size_t nameLength, uint16_t recordType, uint32_t recordTtl, size_t recordOffset, size_t recordLength)
+                                                 {
+                                                     size_t targetOffset = recordOffset + 6;
+                                                     if (recordType == typeSrv && recordLength > 6 && sameName(name, nameLength, instanceName, instanceLength))
+                                                     {
+                                                         service.port = getU16(packet + recordOffset + 4);
+                                                         readName(packet, length, targetOffset, hostName, hostLength);
+                                                     }
+                                                     return true;
+                                                 });
+                                   forEachRecord(packet, length,
+                                                 [&](const uint8_t* name, size_t nameLength, uint16_t recordType, uint32_t recordTtl, size_t recordOffset, size_t recordLength)
+                                                 {
+                                                     if (recordType == typeA && recordLength == 4 && hostLength > 0 && sameName(name, nameLength, hostName, hostLength))
+                                                     {
+                                                         memcpy(service.address, packet + recordOffset, 4);
+                                                         return false;
+                                                     }
+                                                     return true;
+                                                 });
+
+                                   size_t labelLength = (instanceName[0] < sizeof(instance)) ? instanceName[0] : sizeof(instance) - 1;
+                                   memcpy(instance, instanceName + 1, labelLength);
+                                   instance[labelLength] = '\0';
+                                   nameToText(hostName, host, sizeof(host));
+                                   _stats.discovered++;
+                                   _handler(service, _handlerContext);
+                                   return true;
+                               });
+    if (!valid)
+    {
+        _stats.malformed++;
+    }
+}
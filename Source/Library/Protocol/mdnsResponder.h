@@ -0,0 +1,213 @@
+/**
+ * @file mdnsResponder.h
+ * @brief Header file for mdnsResponder
+ *
+ * This file contains declarations for the mdnsResponder class and related data types and functions.
+ */
+#ifndef MDNSRESPONDER_H
+#define MDNSRESPONDER_H
+
+#include "HAL/IHal.h"
+
+#define MDNS_PORT           5353
+#define MDNS_GROUP          "224.0.0.251"
+#define MDNS_PACKET_SIZE    512  // largest packet sent
+#define MDNS_RECEIVE_SIZE   1500 // largest packet received
+#define MDNS_NAME_SIZE      256  // name in wire format, the longest allowed by DNS
+#define MDNS_LABEL_SIZE     64   // host and instance label, terminator included
+#define MDNS_SERVICE_SIZE   32   // service type, e.g. "_http._tcp"
+#define MDNS_TXT_SIZE       192  // TXT record data
+#define MDNS_ANNOUNCE_COUNT 3    // announcements after an address change, 1 s then 2 s apart
+#define MDNS_RATE_LIMIT_MS  1000 // a cached response is multicast at most once per this period
+
+/**
+ * @brief mdnsResponder configuration
+ */
+typedef struct
+{
+    const char* hostname;    // host label, "<hostname>.local", copied
+    const char* instance;    // service instance label, may contain spaces and dots, copied
+    const char* service;     // service type, e.g. "_http._tcp", copied
+    uint16_t    port;        // port of the service
+    uint32_t    hostTtlS;    // TTL of the records with host names (A, SRV)
+    uint32_t    serviceTtlS; // TTL of the other records (PTR, TXT)
+} mdnsConfig_t;
+
+/**
+ * @brief Service instance found by browse()
+ */
+typedef struct
+{
+    const char* instance; // instance label, null terminated
+    const char* host;     // target host name in dotted form, e.g. "lamp.local"
+    uint16_t    port;
+    uint8_t     address[4]; // 0.0.0.0 if the response had no A record for the host
+    uint32_t    ttlS;       // 0: the instance left (goodbye)
+} mdnsService_t;
+
+/**
+ * @brief mdnsResponder counters
+ */
+typedef struct
+{
+    uint32_t queries;       // query packets received
+    uint32_t answered;      // cached responses sent
+    uint32_t rateLimited;   // responses not sent because the same one went out less than MDNS_RATE_LIMIT_MS ago
+    uint32_t announcements; // unsolicited responses sent
+    uint32_t responses;     // response packets received
+    uint32_t discovered;    // services reported to the browse handler
+    uint32_t malformed;     // packets that could not be parsed
+    uint32_t sendFailures;
+} mdnsStats_t;
+
+/**
+ * @brief Browse handler, runs inside mdnsResponder::poll()
+ */
+typedef void (*mdnsServiceHandler_t)(const mdnsService_t& service, void* context);
+
+/**
+ * @brief Default configuration: host "esp32", instance "esp32", service "_http._tcp" on port 80, TTLs 120 s and
+ * 4500 s as recommended by RFC 6762
+ */
+mdnsConfig_t mdnsDefaultConfig();
+
+/**
+ * @brief Multicast DNS responder advertising one DNS-SD service (RFC 6762, RFC 6763)
+ *
+ * Answers queries for the service type, the service instance, the host name and the DNS-SD service enumeration.
+ * The response packets are built once when the address is set and kept in a cache: a query is only parsed and
+ * matched against the cached questions, the matching packet is sent as it is. A cached response is multicast at most
+ * once per MDNS_RATE_LIMIT_MS, as RFC 6762 requires, and the records are announced MDNS_ANNOUNCE_COUNT times after an
+ * address change. Responses are always multicast, unicast (QU) and legacy unicast questions get the multicast answer.
+ * Name conflicts are not probed for, the host and instance names must be unique on the link.
+ *
+ * browse() sends a query for a service type, answers of other devices are reported to the browse handler.
+ *
+ * The transport sends to the mDNS group and returns received datagrams without blocking. Not thread safe: all
+ * methods are called from the same task.
+ */
+class mdnsResponder
+{
+private:
+    /**
+     * @brief Cached response, sent for questions of one name and the types in typeMask
+     */
+    typedef struct
+    {
+        uint8_t  name[MDNS_NAME_SIZE]; // question name in wire format
+        size_t   nameLength;
+        uint32_t typeMask; // bit per record type handled, see typeBit()
+        uint8_t  packet[MDNS_PACKET_SIZE];
+        size_t   length;
+        uint32_t sentMs;
+        bool     sent;
+    } cachedResponse_t;
+
+    enum : uint8_t
+    {
+        CACHE_SERVICE      = 0, // PTR <service>.local
+        CACHE_ENUMERATION  = 1, // PTR _services._dns-sd._udp.local
+        CACHE_INSTANCE     = 2, // SRV, TXT <instance>.<service>.local
+        CACHE_HOST         = 3, // A <hostname>.local
+        CACHE_ANNOUNCEMENT = 4, // every record, not matched against questions
+        CACHE_COUNT        = 5,
+    };
+
+    IHAL_COM&            _transport;
+    mdnsConfig_t         _config;
+    char                 _hostname[MDNS_LABEL_SIZE];
+    char                 _instance[MDNS_LABEL_SIZE];
+    char                 _service[MDNS_SERVICE_SIZE];
+    uint8_t              _txt[MDNS_TXT_SIZE];
+    size_t               _txtLength;
+    uint8_t              _address[4];
+    bool                 _ready; // address set, the cache is valid
+    cachedResponse_t     _cache[CACHE_COUNT];
+    size_t               _announceLeft;
+    uint32_t             _announceMs;
+    uint32_t             _announceInterval;
+    uint8_t              _rx[MDNS_RECEIVE_SIZE];
+    uint8_t              _browseName[MDNS_NAME_SIZE]; // service type browsed, in wire format
+    size_t               _browseNameLength;
+    mdnsServiceHandler_t _handler;
+    void*                _handlerContext;
+    mdnsStats_t          _stats;
+
+    sys_error_t buildCache();
+    bool        send(const uint8_t* packet, size_t length);
+    void        handleQuery(const uint8_t* packet, size_t length, uint32_t nowMs);
+    void        handleResponse(const uint8_t* packet, size_t length);
+
+public:
+    /**
+     * @brief Construct a new mdnsResponder object
+     *
+     * @param transport - datagram transport bound to the mDNS group and port, connected by the caller
+     * @param config - responder configuration (default mdnsDefaultConfig())
+     */
+    mdnsResponder(IHAL_COM& transport, const mdnsConfig_t& config = mdnsDefaultConfig());
+    ~mdnsResponder();
+
+    // Delete copy constructor and assignment operator
+    mdnsResponder(const mdnsResponder&)            = delete;
+    mdnsResponder& operator=(const mdnsResponder&) = delete;
+
+    /**
+     * @brief Add a key=value pair to the TXT record, before setAddress()
+     *
+     * @param key - key, without '='
+     * @param value - value, nullptr for a boolean key without '='
+     * @return sys_error_t ERROR_BUFFER_OVERFLOW if the pair does not fit the TXT record
+     */
+    sys_error_t addTxt(const char* key, const char* value);
+
+    /**
+     * @brief Set the IPv4 address of the host, build the cached responses and announce them
+     *
+     * @param address - address bytes, most significant first
+     * @param nowMs - current time in milliseconds
+     * @return sys_error_t ERROR_BUFFER_OVERFLOW if a response does not fit MDNS_PACKET_SIZE
+     */
+    sys_error_t setAddress(const uint8_t address[4], uint32_t nowMs);
+
+    /**
+     * @brief Answer received queries, report browsed services and send due announcements
+     *
+     * @param nowMs - current time in milliseconds
+     */
+    void poll(uint32_t nowMs);
+
+    /**
+     * @brief Get how long poll() may wait for a packet before an announcement is due
+     *
+     * @param nowMs - current time in milliseconds
+     * @return uint32_t milliseconds, UINT32_MAX if no announcement is pending
+     */
+    uint32_t getNextDelayMs(uint32_t nowMs);
+
+    /**
+     * @brief Send the records with TTL 0 so other hosts drop them, e.g. before stopping
+     *
+     * @return sys_error_t ERROR_INVALID_CONFIG if no address is set, ERROR_TRANSMIT_FAILED if the packet was not sent
+     */
+    sys_error_t goodbye();
+
+    /**
+     * @brief Query a service type, instances answering are reported to the browse handler
+     *
+     * @param service - service type, e.g. "_http._tcp", copied
+     * @param handler - called for every instance in received responses
+     * @param context - passed to the handler
+     * @return sys_error_t ERROR_TRANSMIT_FAILED if the query was not sent
+     */
+    sys_error_t browse(const char* service, mdnsServiceHandler_t handler, void* context);
+
+    /**
+     * @brief Get the counters
+     *
+     * @return mdnsStats_t
+     */
+    mdnsStats_t getStats();
+};
+
+#endif /* MDNSRESPONDER_H */
@@ -0,0 +1,786 @@
+/**
+ * @file mqttClient.cpp
+ * @brief Source file for mqttClient
+ *
+ * This file contains definitions for the mqttClient class and related data types and functions.
+ */
+
+#include "mqttClient.h"
+#include "Library/Common/crc.h"
+
+#include <algorithm>
+#include <string.h>
+
+namespace
+{
+// Packet types, high nibble of the first byte
+constexpr uint8_t packetConnect     = 0x10;
+constexpr uint8_t packetConnack     = 0x20;
+constexpr uint8_t packetPublish     = 0x30;
+constexpr uint8_t packetPuback      = 0x40;
+constexpr uint8_t packetSubscribe   = 0x82; // reserved flags 0010
+constexpr uint8_t packetSuback      = 0x90;
+constexpr uint8_t packetPingreq     = 0xC0;
+constexpr uint8_t packetPingresp    = 0xD0;
+constexpr uint8_t publishDup        = 0x08;
+constexpr uint8_t connectClean      = 0x02;
+constexpr uint8_t connectPassword   = 0x40;
+constexpr uint8_t connectUsername   = 0x80;
+constexpr size_t  maxTopicLength    = 255;
+constexpr size_t  maxRemainingBytes = 4;
+
+// Queue entry: size (2), flags (1), topic length (1), packet id (2), topic, payload
+constexpr size_t  entryHeaderSize = 6;
+constexpr uint8_t entryQos1       = 0x01;
+constexpr uint8_t entrySent       = 0x02;
+constexpr uint8_t entryDone       = 0x04; // QoS 0 sent or QoS 1 acknowledged, the space can be reused
+
+// Spill record: body length (2), body (qos, topic length, topic, payload), CRC-16 of the body (2)
+constexpr size_t spillOverhead = 4;
+
+struct entryHeader_t
+{
+    size_t   size;
+    uint8_t  flags;
+    uint8_t  topicLength;
+    uint16_t packetId;
+};
+
+size_t remainingLengthBytes(size_t remaining)
+{
+    size_t bytes = 1;
+    for (; remaining >= 128; remaining /= 128)
+    {
+        bytes++;
+    }
+    return bytes;
+}
+
+size_t publishPacketSize(size_t topicLength, size_t length, uint8_t qos)
+{
+    size_t remaining = 2 + topicLength + ((qos > 0) ? 2 : 0) + length;
+    return 1 + remainingLengthBytes(remaining) + remaining;
+}
+
+// Fixed header, returns its size
+size_t putHeader(uint8_t* buffer, uint8_t type, size_t remaining)
+{
+    size_t position    = 0;
+    buffer[position++] = type;
+    do
+    {
+        uint8_t digit = static_cast<uint8_t>(remaining % 128);
+        remaining /= 128;
+        buffer[position++] = static_cast<uint8_t>(digit | ((remaining > 0) ? 0x80 : 0));
+    } while (remaining > 0);
+    return position;
+}
+
+size_t putU16(uint8_t* buffer, uint16_t value)
+{
+    buffer[0] = static_cast<uint8_t>(value >> 8);
+    buffer[1] = static_cast<uint8_t>(value);
+    return 2;
+}
+
+size_t putString(uint8_t* buffer, const char* text, size_t length)
+{
+    putU16(buffer, static_cast<uint16_t>(length));
+    memcpy(buffer + 2, text, length);
+    return 2 + length;
+}
+
+uint16_t getU16(const uint8_t* buffer)
+{
+    return static_cast<uint16_t>((buffer[0] << 8) | buffer[1]);
+}
+} // namespace
+
+mqttConfig_t mqttDefaultConfig()
+{
+    mqttConfig_t config;
+    config.clientId         = "esp32";
+    config.username         = nullptr;
+    config.password         = nullptr;
+    config.keepAliveS       = 60;
+    config.cleanSession     = false;
+    config.connectTimeoutMs = 5000;
+    config.retryMinMs       = 1000;
+    config.retryMaxMs       = 60000;
+    return config;
+}
+
+mqttClient::mqttClient(IHAL_COM& transport, const mqttConfig_t& config)
+    : _transport(transport), _config(config), _state(MQTT_DISCONNECTED), _stateMs(0), _retryDelay(0), _lastSentMs(0), _pingPending(false), _pingSentMs(0), _packetId(0),
+      _tail(0), _send(0), _head(0), _inflight(0), _rxUsed(0), _rxSkip(0), _filterCount(0), _spill(nullptr), _spillAddress(0), _spillSize(0), _spillRead(0), _spillWrite(0),
+      _handler(nullptr), _handlerContext(nullptr), _stats()
+{
+    _config.clientId   = (_config.clientId != nullptr) ? _config.clientId : "";
+    _config.retryMinMs = std::max<uint32_t>(_config.retryMinMs, 1);
+    _config.retryMaxMs = std::max(_config.retryMaxMs, _config.retryMinMs);
+}
+
+mqttClient::~mqttClient()
+{
+    // destructor implementation
+}
+
+void mqttClient::setMessageHandler(mqttMessageHandler_t handler, void* context)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _handler        = handler;
+    _handlerContext = context;
+}
+
+sys_error_t mqttClient::setSpill(IHAL_MEM* memory, uint32_t address, size_t size)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _spill = nullptr;
+    if (memory == nullptr)
+    {
+        return ERROR_SUCCESS;
+    }
+    if (!memory->initialize())
+    {
+        return ERROR_INIT_FAILED;
+    }
+
+    size_t sectorSize = memory->getSectorSize();
+    if (sectorSize == 0 || size == 0 || address % sectorSize != 0 || size % sectorSize != 0 || address + size > memory->getSize())
+    {
+        return ERROR_INVALID_CONFIG;
+    }
+    for (size_t offset = 0; offset < size; offset += sectorSize)
+    {
+        if (!memory->eraseSector(static_cast<uint32_t>(address + offset)))
+        {
+            return ERROR_WRITE_FAILED;
+        }
+    }
+
+    _spill        = memory;
+    _spillAddress = address;
+    _spillSize    = size;
+    _spillRead    = 0;
+    _spillWrite   = 0;
+    return ERROR_SUCCESS;
+}
+
+sys_error_t mqttClient::subscribe(const char* filter)
+{
+    size_t length = (filter != nullptr) ? strlen(filter) : 0;
+    if (length == 0 || length >= MQTT_FILTER_SIZE)
+    {
+        return ERROR_INVALID_ARG;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_filterCount >= MQTT_MAX_SUBSCRIPTIONS)
+    {
+        return ERROR_OUT_OF_MEMORY;
+    }
+    memcpy(_filters[_filterCount], filter, length + 1);
+    _filterCount++;
+
+    // Otherwise sent with the others once connected
+    if (_state == MQTT_CONNECTED && !sendSubscribe(filter, _lastSentMs))
+    {
+        disconnect(_lastSentMs, false);
+    }
+    return ERROR_SUCCESS;
+}
+
+sys_error_t mqttClient::publish(const char* topic, const void* payload, size_t length, uint8_t qos)
+{
+    size_t topicLength = (topic != nullptr) ? strlen(topic) : 0;
+    if (topicLength == 0 || topicLength > maxTopicLength || qos > 1 || (payload == nullptr && length > 0))
+    {
+        return ERROR_INVALID_ARG;
+    }
+    if (publishPacketSize(topicLength, length, qos) > MQTT_MAX_PACKET)
+    {
+        return ERROR_MESSAGE_TOO_LARGE;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    const uint8_t*              bytes = static_cast<const uint8_t*>(payload);
+
+    // Once messages are spilled, new ones follow them so the order is kept
+    bool spillEmpty = (_spill == nullptr || _spillRead == _spillWrite);
+    if (spillEmpty && enqueue(topic, topicLength, bytes, length, qos))
+    {
+        _stats.published++;
+        return ERROR_SUCCESS;
+    }
+    if (_spill != nullptr && spillMessage(topic, topicLength, bytes, length, qos))
+    {
+        _stats.published++;
+        _stats.spilled++;
+        return ERROR_SUCCESS;
+    }
+    _stats.dropped++;
+    return ERROR_BUSY;
+}
+
+void mqttClient::poll(uint32_t nowMs)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    if (_state == MQTT_DISCONNECTED)
+    {
+        if (nowMs - _stateMs < _retryDelay)
+        {
+            return;
+        }
+        // Resolving and connecting may take long, publish() goes on meanwhile
+        lock.unlock();
+        sys_error_t connected = _transport.connect();
+        lock.lock();
+        if (connected != ERROR_SUCCESS || !sendConnect(nowMs))
+        {
+            disconnect(nowMs, true);
+            return;
+        }
+        _state   = MQTT_CONNECTING;
+        _stateMs = nowMs;
+    }
+
+    if (!receive(lock, nowMs))
+    {
+        return;
+    }
+
+    if (_state == MQTT_CONNECTING)
+    {
+        if (nowMs - _stateMs >= _config.connectTimeoutMs)
+        {
+            disconnect(nowMs, true);
+        }
+        return;
+    }
+
+    if (!sendQueued(nowMs))
+    {
+        return;
+    }
+
+    // The broker closes the connection after 1.5 keep alive periods without a packet from us
+    uint32_t keepAliveMs = static_cast<uint32_t>(_config.keepAliveS) * 1000;
+    if (keepAliveMs > 0)
+    {
+        if (_pingPending && nowMs - _pingSentMs >= keepAliveMs)
+        {
+            disconnect(nowMs, false);
+        }
+        else if (!_pingPending && nowMs - _lastSentMs >= keepAliveMs)
+        {
+            size_t length = putHeader(_tx, packetPingreq, 0);
+            if (!sendPacket(length, nowMs))
+            {
+                disconnect(nowMs, false);
+                return;
+            }
+            _pingPending = true;
+            _pingSentMs  = nowMs;
+        }
+    }
+}
+
+uint32_t mqttClient::getNextDelayMs(uint32_t nowMs)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    uint32_t                    elapsed = nowMs - _stateMs;
+    if (_state == MQTT_DISCONNECTED)
+    {
+        return (elapsed < _retryDelay) ? _retryDelay - elapsed : 0;
+    }
+    if (_state == MQTT_CONNECTING)
+    {
+        return (elapsed < _config.connectTimeoutMs) ? _config.connectTimeoutMs - elapsed : 0;
+    }
+
+    // A message sendQueued() left behind: the transport was busy, or it arrived after poll()
+    if (_send != _head)
+    {
+        uint8_t header[entryHeaderSize];
+        ringRead(_send, header, sizeof(header));
+        if ((header[2] & (entryDone | entryQos1)) != entryQos1 || _inflight < MQTT_MAX_INFLIGHT)
+        {
+            return 0;
+        }
+    }
+
+    uint32_t keepAliveMs = static_cast<uint32_t>(_config.keepAliveS) * 1000;
+    if (keepAliveMs == 0)
+    {
+        return UINT32_MAX;
+    }
+    uint32_t idle = nowMs - (_pingPending ? _pingSentMs : _lastSentMs);
+    return (idle < keepAliveMs) ? keepAliveMs - idle : 0;
+}
+
+mqttState_t mqttClient::getState()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _state;
+}
+
+bool mqttClient::isIdle()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _tail == _head && (_spill == nullptr || _spillRead == _spillWrite);
+}
+
+mqttStats_t mqttClient::getStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+void mqttClient::ringWrite(size_t position, const void* data, size_t length)
+{
+    const uint8_t* bytes  = static_cast<const uint8_t*>(data);
+    size_t         offset = position % MQTT_QUEUE_SIZE;
+    size_t         first  = std::min(length, MQTT_QUEUE_SIZE - offset);
+    memcpy(_queue + offset, bytes, first);
+    memcpy(_queue, bytes + first, length - first);
+}
+
+void mqttClient::ringRead(size_t position, void* data, size_t length)
+{
+    uint8_t* bytes  = static_cast<uint8_t*>(data);
+    size_t   offset = position % MQTT_QUEUE_SIZE;
+    size_t   first  = std::min(length, MQTT_QUEUE_SIZE - offset);
+    memcpy(bytes, _queue + offset, first);
+    memcpy(bytes + first, _queue, length - first);
+}
+
+bool mqttClient::enqueue(const char* topic, size_t topicLength, const uint8_t* payload, size_t length, uint8_t qos)
+{
+    size_t size = entryHeaderSize + topicLength + length;
+    if (size > MQTT_QUEUE_SIZE - (_head - _tail))
+    {
+        return false;
+    }
+
+    uint8_t header[entryHeaderSize] = {static_cast<uint8_t>(size), static_cast<uint8_t>(size >> 8), static_cast<uint8_t>((qos > 0) ? entryQos1 : 0), static_cast<uint8_t>(topicLength), 0, 0};
+    ringWrite(_head, header, sizeof(header));
+    ringWrite(_head + entryHeaderSize, topic, topicLength);
+    ringWrite(_head + entryHeaderSize + topicLength, payload, length);
+    _head += size;
+    return true;
+}
+
+bool mqttClient::spillMessage(const char* topic, size_t topicLength, const uint8_t* payload, size_t length, uint8_t qos)
+{
+    // Fits _tx: the PUBLISH packet of the message is not smaller
+    size_t bodyLength = 2 + topicLength + length;
+    size_t size       = spillOverhead + bodyLength;
+    if (_spillWrite + size > _spillSize)
+    {
+        return false;
+    }
+
+    uint8_t* body = _tx + 2;
+    putU16(_tx, static_cast<uint16_t>(bodyLength));
+    body[0] = qos;
+    body[1] = static_cast<uint8_t>(topicLength);
+    memcpy(body + 2, topic, topicLength);
+    memcpy(body + 2 + topicLength, payload, length);
+    putU16(body + bodyLength, crc::crc16(body, bodyLength));
+
+    if (!_spill->writeData(static_cast<uint32_t>(_spillAddress + _spillWrite), _tx, size))
+    {
+        return false;
+    }
+    _spillWrite += size;
+    return true;
+}
+
+void mqttClient::unspill()
+{
+    while (_spill != nullptr && _spillRead < _spillWrite)
+    {
+        uint8_t lengthBytes[2];
+        if (!_spill->readData(static_cast<uint32_t>(_spillAddress + _spillRead), lengthBytes, sizeof(lengthBytes)))
+        {
+            return;
+        }
+        size_t bodyLength = getU16(lengthBytes);
+        size_t size       = spillOverhead + bodyLength;
+        if (bodyLength < 3 || size > sizeof(_tx) || _spillRead + size > _spillWrite)
+        {
+            // Corrupted, the rest of the area cannot be followed
+            _spillRead = _spillWrite;
+            break;
+        }
+        if (entryHeaderSize + bodyLength - 2 > MQTT_QUEUE_SIZE - (_head - _tail))
+        {
+            return;
+        }
+
+        if (!_spill->readData(static_cast<uint32_t>(_spillAddress + _spillRead), _tx, size))
+        {
+            return;
+        }
+        const uint8_t* body        = _tx + 2;
+        size_t         topicLength = body[1];
+        _spillRead += size;
+        if (getU16(body + bodyLength) != crc::crc16(body, bodyLength) || 2 + topicLength > bodyLength)
+        {
+            _stats.dropped++;
+            continue;
+        }
+        enqueue(reinterpret_cast<const char*>(body + 2), topicLength, body + 2 + topicLength, bodyLength - 2 - topicLength, body[0]);
+    }
+
+    // Drained: erase what was written so the area can be written again
+    if (_spill != nullptr && _spillWrite > 0 && _spillRead == _spillWrite)
+    {
+        size_t sectorSize = _spill->getSectorSize();
+        for (size_t offset = 0; offset < _spillWrite; offset += sectorSize)
+        {
+            if (!_spill->eraseSector(static_cast<uint32_t>(_spillAddress + offset)))
+            {
+                // Left full, further messages are dropped instead of written over old data
+                _spillRead  = _spillSize;
+                _spillWrite = _spillSize;
+                return;
+            }
+        }
+        _spillRead  = 0;
+        _spillWrite = 0;
+    }
+}
+
+void mqttClient::advanceTail()
+{
+    while (_tail != _send)
+    {
+        uint8_t header[entryHeaderSize];
+        ringRead(_tail, header, sizeof(header));
+        if ((header[2] & entryDone) == 0)
+        {
+            break;
+        }
+        _tail += static_cast<size_t>(header[0] | (header[1] << 8));
+    }
+    unspill();
+}
+
+uint16_t mqttClient::nextPacketId()
+{
+    _packetId = static_cast<uint16_t>(_packetId + 1);
+    if (_packetId == 0)
+    {
+        _packetId = 1;
+    }
+    return _packetId;
+}
+
+bool mqttClient::sendPacket(size_t length, uint32_t nowMs)
+{
+    if (_transport.sendData(_tx, length) != ERROR_SUCCESS)
+    {
+        return false;
+    }
+    _lastSentMs = nowMs;
+    return true;
+}
+
+bool mqttClient::sendConnect(uint32_t nowMs)
+{
+    size_t clientIdLength = strlen(_config.clientId);
+    size_t usernameLength = (_config.username != nullptr) ? strlen(_config.username) : 0;
+    size_t passwordLength = (_config.password != nullptr) ? strlen(_config.password) : 0;
+    size_t remaining      = 10 + 2 + clientIdLength + ((_config.username != nullptr) ? 2 + usernameLength : 0) + ((_config.password != nullptr) ? 2 + passwordLength : 0);
+    if (1 + remainingLengthBytes(remaining) + remaining > sizeof(_tx))
+    {
+        return false;
+    }
+
+    uint8_t flags = static_cast<uint8_t>((_config.cleanSession ? connectClean : 0) | ((_config.username != nullptr) ? connectUsername : 0) |
+                                         ((_config.password != nullptr) ? connectPassword : 0));
+    size_t  length = putHeader(_tx, packetConnect, remaining);
+    length += putString(_tx + length, "MQTT", 4);
+    _tx[length++] = 4; // protocol level 3.1.1
+    _tx[length++] = flags;
+    length += putU16(_tx + length, _config.keepAliveS);
+    length += putString(_tx + length, _config.clientId, clientIdLength);
+    if (_config.username != nullptr)
+    {
+        length += putString(_tx + length, _config.username, usernameLength);
+    }
+    if (_config.password != nullptr)
+    {
+        length += putString(_tx + length, _config.password, passwordLength);
+    }
+    return sendPacket(length, nowMs);
+}
+
+bool mqttClient::sendSubscribe(const char* filter, uint32_t nowMs)
+{
+    size_t filterLength = strlen(filter);
+    size_t length       = putHeader(_tx, packetSubscribe, 2 + 2 + filterLength + 1);
+    length += putU16(_tx + length, nextPacketId());
+    length += putString(_tx + length, filter, filterLength);
+    _tx[length++] = 1; // requested QoS
+    return sendPacket(length, nowMs);
+}
+
+bool mqttClient::sendQueued(uint32_t nowMs)
+{
+    while (_send != _head)
+    {
+        uint8_t header[entryHeaderSize];
+        ringRead(_send, header, sizeof(header));
+        entryHeader_t entry = {static_cast<size_t>(header[0] | (header[1] << 8)), header[2], header[3], static_cast<uint16_t>(header[4] | (header[5] << 8))};
+        if ((entry.flags & entryDone) != 0)
+        {
+            _send += entry.size;
+            continue;
+        }
+
+        // Pipelined: up to MQTT_MAX_INFLIGHT publishes wait for their PUBACK at the same time
+        uint8_t qos = entry.flags & entryQos1;
+        if (qos > 0 && _inflight >= MQTT_MAX_INFLIGHT)
+        {
+            break;
+        }
+        bool resend = (entry.flags & entrySent) != 0;
+        if (qos > 0 && !resend)
+        {
+            entry.packetId = nextPacketId();
+        }
+
+        size_t payloadLength = entry.size - entryHeaderSize - entry.topicLength;
+        size_t remaining     = 2 + entry.topicLength + ((qos > 0) ? 2 : 0) + payloadLength;
+        size_t length        = putHeader(_tx, static_cast<uint8_t>(packetPublish | (resend ? publishDup : 0) | (qos << 1)), remaining);
+        length += putU16(_tx + length, entry.topicLength);
+        ringRead(_send + entryHeaderSize, _tx + length, entry.topicLength);
+        length += entry.topicLength;
+        if (qos > 0)
+        {
+            length += putU16(_tx + length, entry.packetId);
+        }
+        ringRead(_send + entryHeaderSize + entry.topicLength, _tx + length, payloadLength);
+        length += payloadLength;
+
+        sys_error_t result = _transport.sendData(_tx, length);
+        if (result == ERROR_BUSY)
+        {
+            break;
+        }
+        if (result != ERROR_SUCCESS)
+        {
+            disconnect(nowMs, false);
+            return false;
+        }
+        _lastSentMs = nowMs;
+        _stats.sent++;
+        _stats.resent += resend ? 1 : 0;
+
+        header[2] = static_cast<uint8_t>(entry.flags | entrySent | ((qos > 0) ? 0 : entryDone));
+        header[4] = static_cast<uint8_t>(entry.packetId);
+        header[5] = static_cast<uint8_t>(entry.packetId >> 8);
+        ringWrite(_send, header, sizeof(header));
+        _inflight += qos;
+        _send += entry.size;
+    }
+    advanceTail();
+    return true;
+}
+
+void mqttClient::acknowledge(uint16_t packetId)
+{
+    for (size_t position = _tail; position != _send;)
+    {
+        uint8_t header[entryHeaderSize];
+        ringRead(position, header, sizeof(header));
+        if ((header[2] & (entryQos1 | entrySent | entryDone)) == (entryQos1 | entrySent) && static_cast<uint16_t>(header[4] | (header[5] << 8)) == packetId)
+        {
+            header[2] |= entryDone;
+            ringWrite(position, header, sizeof(header));
+            _inflight--;
+            _stats.acknowledged++;
+            break;
+        }
+        position += static_cast<size_t>(header[0] | (header[1] << 8));
+    }
+    advanceTail();
+}
+
+void mqttClient::disconnect(uint32_t nowMs, bool failed)
+{
+    _transport.disconnect();
+    _stats.connectFailures += failed ? 1 : 0;
+
+    // Everything not acknowledged is sent again after reconnecting
+    _state       = MQTT_DISCONNECTED;
+    _stateMs     = nowMs;
+    _retryDelay  = (_retryDelay == 0) ? _config.retryMinMs : std::min(_retryDelay * 2, _config.retryMaxMs);
+    _send        = _tail;
+    _inflight    = 0;
+    _rxUsed      = 0;
+    _rxSkip      = 0;
+    _pingPending = false;
+}
+
+bool mqttClient::receive(std::unique_lock<std::mutex>& lock, uint32_t nowMs)
+{
+    for (;;)
+    {
+        size_t      received = 0;
+        sys_error_t result   = _transport.receiveData(_rx + _rxUsed, sizeof(_rx) - _rxUsed, received);
+        if (result != ERROR_SUCCESS)
+        {
+            disconnect(nowMs, _state == MQTT_CONNECTING);
+            return false;
+        }
+        if (received == 0)
+        {
+            return true;
+        }
+        _rxUsed += received;
+
+        size_t offset = 0;
+        while (offset < _rxUsed)
+        {
+            if (_rxSkip > 0)
+            {
+                size_t skipped = std::min(_rxSkip, _rxUsed - offset);
+                offset += skipped;
+                _rxSkip -= skipped;
+                continue;
+            }
+
+            // Fixed header: type and flags, then 1 to 4 bytes of remaining length
+            size_t remaining   = 0;
+            size_t headerBytes = 1;
+            bool   complete    = false;
+            while (!complete && headerBytes <= maxRemainingBytes && offset + headerBytes < _rxUsed)
+            {
+                uint8_t digit = _rx[offset + headerBytes];
+                remaining |= static_cast<size_t>(digit & 0x7F) << (7 * (headerBytes - 1));
+                complete = (digit & 0x80) == 0;
+                headerBytes++;
+            }
+            if (!complete)
+            {
+                if (headerBytes > maxRemainingBytes)
+                {
+                    disconnect(nowMs, _state == MQTT_CONNECTING);
+                    return false;
+                }
+                break;
+            }
+
+            size_t total = headerBytes + remaining;
+            if (total > sizeof(_rx))
+            {
+                _stats.oversized++;
+                _rxSkip = total;
+                continue;
+            }
+            if (_rxUsed - offset < total)
+            {
+                break;
+            }
+            if (!handlePacket(lock, static_cast<uint8_t>(_rx[offset] & 0xF0), static_cast<uint8_t>(_rx[offset] & 0x0F), _rx + offset + headerBytes, remaining, nowMs))
+            {
+                return false;
+            }
+            offset += total;
+        }
+        memmove(_rx, _rx + offset, _rxUsed - offset);
+        _rxUsed -= offset;
+    }
+}
+
+bool mqttClient::handlePacket(std::unique_lock<std::mutex>& lock, uint8_t type, uint8_t flags, const uint8_t* body, size_t length, uint32_t nowMs)
+{
+    if (_state == MQTT_CONNECTING)
+    {
+        // Return code 0 accepted, anything else refused
+        if (type != packetConnack || length != 2 || body[1] != 0)
+        {
+            disconnect(nowMs, true);
+            return false;
+        }
+        _state      = MQTT_CONNECTED;
+        _stateMs    = nowMs;
+        _retryDelay = 0;
+        _stats.connects++;
+        if ((body[0] & 0x01) != 0)
+        {
+            // The broker kept our subscriptions
+            _stats.sessionResumes++;
+            return true;
+        }
+        for (size_t i = 0; i < _filterCount; i++)
+        {
+            if (!sendSubscribe(_filters[i], nowMs))
+            {
+                disconnect(nowMs, false);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    switch (type)
+    {
+        case packetPublish:
+        {
+            uint8_t qos         = (flags >> 1) & 0x03;
+            size_t  topicLength = (length >= 2) ? getU16(body) : 0;
+            size_t  idLength    = (qos > 0) ? 2 : 0;
+            if (qos > 1 || length < 2 + topicLength + idLength)
+            {
+                // QoS 2 is never granted, we subscribe with QoS 1
+                disconnect(nowMs, false);
+                return false;
+            }
+            uint16_t             packetId = (qos > 0) ? getU16(body + 2 + topicLength) : 0;
+            mqttMessageHandler_t handler  = _handler;
+            void*                context  = _handlerContext;
+            _stats.received++;
+
+            // The handler may publish, _rx is only used by poll()
+            if (handler != nullptr)
+            {
+                lock.unlock();
+                handler(reinterpret_cast<const char*>(body + 2), topicLength, body + 2 + topicLength + idLength, length - 2 - topicLength - idLength, context);
+                lock.lock();
+                if (_state != MQTT_CONNECTED)
+                {
+                    // A subscribe() meanwhile failed and reset the connection
+                    return false;
+                }
+            }
+            if (qos > 0)
+            {
+                size_t ackLength = putHeader(_tx, packetPuback, 2);
+                ackLength += putU16(_tx + ackLength, packetId);
+                if (!sendPacket(ackLength, nowMs))
+                {
+                    disconnect(nowMs, false);
+                    return false;
+                }
+            }
+            return true;
+        }
+        case packetPuback:
+            if (length >= 2)
+            {
+                acknowledge(getU16(body));
+            }
+            return true;
+        case packetPingresp:
+            _pingPending = false;
+            return true;
+        case packetSuback:
+        default:
+            return true;
+    }
+}
@@ -0,0 +1,226 @@
+/**
+ * @file mqttClient.h
+ * @brief Header file for mqttClient
+ *
+ * This file contains declarations for the mqttClient class and related data types and functions.
+ */
+#ifndef MQTTCLIENT_H
+#define MQTTCLIENT_H
+
+#include "HAL/IHal.h"
+#include <mutex>
+
+#define MQTT_MAX_PACKET        512  // largest packet sent or received, larger incoming packets are skipped
+#define MQTT_MAX_INFLIGHT      16   // QoS 1 publishes sent and not yet acknowledged
+#define MQTT_QUEUE_SIZE        4096 // offline queue in bytes, a power of two; messages stay until sent (QoS 0) or acknowledged (QoS 1)
+#define MQTT_MAX_SUBSCRIPTIONS 8
+#define MQTT_FILTER_SIZE       64 // longest topic filter, terminator included
+
+/**
+ * @brief mqttClient configuration
+ */
+typedef struct
+{
+    const char* clientId;         // must stay valid, the broker keeps the session under this id
+    const char* username;         // nullptr for none, must stay valid
+    const char* password;         // nullptr for none, must stay valid
+    uint16_t    keepAliveS;       // 0 disables the keep alive
+    bool        cleanSession;     // false: the broker keeps subscriptions and QoS 1 state while offline
+    uint32_t    connectTimeoutMs; // CONNECT without CONNACK
+    uint32_t    retryMinMs;       // first reconnect delay, doubled after every failed attempt
+    uint32_t    retryMaxMs;       // reconnect delay limit
+} mqttConfig_t;
+
+/**
+ * @brief Connection state
+ */
+typedef enum : uint8_t
+{
+    MQTT_DISCONNECTED = 0, // waiting for the next connect attempt
+    MQTT_CONNECTING   = 1, // CONNECT sent
+    MQTT_CONNECTED    = 2, // CONNACK accepted
+} mqttState_t;
+
+/**
+ * @brief mqttClient counters
+ */
+typedef struct
+{
+    uint32_t published;      // messages accepted by publish()
+    uint32_t sent;           // PUBLISH packets sent, resent ones included
+    uint32_t resent;         // QoS 1 publishes sent again after a reconnect
+    uint32_t acknowledged;   // PUBACKs for our QoS 1 publishes
+    uint32_t dropped;        // messages lost because the queue and the spill area were full
+    uint32_t spilled;        // messages written to the spill area
+    uint32_t received;       // PUBLISH packets delivered to the handler
+    uint32_t oversized;      // incoming packets larger than MQTT_MAX_PACKET, skipped
+    uint32_t connects;       // accepted connections
+    uint32_t sessionResumes; // connections where the broker still had our session
+    uint32_t connectFailures;
+} mqttStats_t;
+
+/**
+ * @brief Incoming message handler, runs inside mqttClient::poll() without the client lock
+ */
+typedef void (*mqttMessageHandler_t)(const char* topic, size_t topicLength, const uint8_t* payload, size_t length, void* context);
+
+/**
+ * @brief Default configuration: client id "esp32", 60 s keep alive, persistent session, 5 s connect timeout,
+ * reconnect after 1 s up to 60 s
+ */
+mqttConfig_t mqttDefaultConfig();
+
+/**
+ * @brief MQTT 3.1.1 client on a byte stream transport (TCP)
+ *
+ * publish() only copies the message into a fixed ring, whether connected or not. poll() sends queued messages in
+ * order; QoS 1 publishes are pipelined up to MQTT_MAX_INFLIGHT without waiting for their PUBACKs and stay in the ring
+ * until acknowledged, so nothing is lost on a broken connection: after reconnecting they are sent again (DUP) with
+ * their packet id. With cleanSession false the broker resumes the session, otherwise the subscriptions are sent again.
+ * When the ring is full, messages can be spilled to an IHAL_MEM area and are moved back in order as the ring drains.
+ *
+ * The transport is connected by poll(), its sendData() must send the whole packet or nothing (ERROR_BUSY) and its
+ * receiveData() must not block. All public methods are thread safe; poll() is called from one task, when the
+ * transport is readable, after publish() and once getNextDelayMs() has passed.
+ */
+class mqttClient
+{
+private:
+    IHAL_COM&            _transport;
+    mqttConfig_t         _config;
+    mqttState_t          _state;
+    uint32_t             _stateMs;    // time of the last state change
+    uint32_t             _retryDelay; // next reconnect delay
+    uint32_t             _lastSentMs;
+    bool                 _pingPending;
+    uint32_t             _pingSentMs;
+    uint16_t             _packetId;
+    uint8_t              _queue[MQTT_QUEUE_SIZE];
+    size_t               _tail; // oldest message not acknowledged, positions only grow
+    size_t               _send; // next message to send
+    size_t               _head; // end of the queued messages
+    size_t               _inflight;
+    uint8_t              _tx[MQTT_MAX_PACKET];
+    uint8_t              _rx[MQTT_MAX_PACKET];
+    size_t               _rxUsed;
+    size_t               _rxSkip; // bytes of an oversized packet still to skip
+    char                 _filters[MQTT_MAX_SUBSCRIPTIONS][MQTT_FILTER_SIZE];
+    size_t               _filterCount;
+    IHAL_MEM*            _spill;
+    uint32_t             _spillAddress;
+    size_t               _spillSize;
+    size_t               _spillRead;  // offset of the oldest spilled message
+    size_t               _spillWrite; // offset after the newest spilled message
+    mqttMessageHandler_t _handler;
+    void*                _handlerContext;
+    mqttStats_t          _stats;
+    std::mutex           _mutex;
+
+    void        ringWrite(size_t position, const void* data, size_t length);
+    void        ringRead(size_t position, void* data, size_t length);
+    bool        enqueue(const char* topic, size_t topicLength, const uint8_t* payload, size_t length, uint8_t qos);
+    bool        spillMessage(const char* topic, size_t topicLength, const uint8_t* payload, size_t length, uint8_t qos);
+    void        unspill();
+    void        advanceTail();
+    uint16_t    nextPacketId();
+    bool        sendPacket(size_t length, uint32_t nowMs);
+    bool        sendConnect(uint32_t nowMs);
+    bool        sendSubscribe(const char* filter, uint32_t nowMs);
+    bool        sendQueued(uint32_t nowMs);
+    void        acknowledge(uint16_t packetId);
+    void        disconnect(uint32_t nowMs, bool failed);
+    bool        receive(std::unique_lock<std::mutex>& lock, uint32_t nowMs);
+    bool        handlePacket(std::unique_lock<std::mutex>& lock, uint8_t type, uint8_t flags, const uint8_t* body, size_t length, uint32_t nowMs);
+
+public:
+    /**
+     * @brief Construct a new mqttClient object
+     *
+     * @param transport - stream transport to the broker, connected by poll()
+     * @param config - client configuration (default mqttDefaultConfig())
+     */
+    mqttClient(IHAL_COM& transport, const mqttConfig_t& config = mqttDefaultConfig());
+    ~mqttClient();
+
+    // Delete copy constructor and assignment operator
+    mqttClient(const mqttClient&)            = delete;
+    mqttClient& operator=(const mqttClient&) = delete;
+
+    /**
+     * @brief Set the handler of incoming messages
+     *
+     * @param handler - called for every PUBLISH received, nullptr for none
+     * @param context - passed to the handler
+     */
+    void setMessageHandler(mqttMessageHandler_t handler, void* context);
+
+    /**
+     * @brief Spill messages to a memory area when the queue is full, before the first publish()
+     * The area is erased, spilled messages do not survive a restart.
+     *
+     * @param memory - memory device, nullptr to disable spilling
+     * @param address - start of the area, sector aligned
+     * @param size - size of the area, a multiple of the sector size
+     * @return sys_error_t ERROR_INVALID_CONFIG if the area does not fit the device, ERROR_WRITE_FAILED if it could not be erased
+     */
+    sys_error_t setSpill(IHAL_MEM* memory, uint32_t address, size_t size);
+
+    /**
+     * @brief Subscribe to a topic filter with QoS 1, now if connected, else on connect
+     *
+     * @param filter - topic filter, wildcards allowed
+     * @return sys_error_t ERROR_OUT_OF_MEMORY if MQTT_MAX_SUBSCRIPTIONS filters are set
+     */
+    sys_error_t subscribe(const char* filter);
+
+    /**
+     * @brief Queue a message, never waits for the network
+     *
+     * @param topic - topic name
+     * @param payload - payload data
+     * @param length - payload length
+     * @param qos - 0 or 1
+     * @return sys_error_t ERROR_MESSAGE_TOO_LARGE if the PUBLISH would exceed MQTT_MAX_PACKET, ERROR_BUSY if the
+     * queue and the spill area are full and the message is dropped
+     */
+    sys_error_t publish(const char* topic, const void* payload, size_t length, uint8_t qos = 1);
+
+    /**
+     * @brief Connect, send queued messages, process received packets and keep the connection alive
+     *
+     * @param nowMs - current time in milliseconds
+     */
+    void poll(uint32_t nowMs);
+
+    /**
+     * @brief Get how long poll() may wait for a packet before a reconnect, connect timeout or keep alive is due
+     *
+     * @param nowMs - current time in milliseconds
+     * @return uint32_t milliseconds, 0 if a queued message is waiting for the transport, UINT32_MAX if the keep
+     * alive is disabled and nothing is due
+     */
+    uint32_t getNextDelayMs(uint32_t nowMs);
+
+    /**
+     * @brief Get the connection state
+     *
+     * @return mqttState_t
+     */
+    mqttState_t getState();
+
+    /**
+     * @brief Check if every queued message has been sent and, for QoS 1, acknowledged
+     *
+     * @return bool
+     */
+    bool isIdle();
+
+    /**
+     * @brief Get the counters
+     *
+     * @return mqttStats_t
+     */
+    mqttStats_t getStats();
+};
+
+#endif /* MQTTCLIENT_H */
@@ -0,0 +1,220 @@
+/**
+ * @file syslogSink.cpp
+ * @brief Source file for syslogSink
+ *
+ * This file contains definitions for the syslogSink class and related data types and functions.
+ */
+
+#include "syslogSink.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(ESP_PLATFORM)
+#include "esp_timer.h"
+#else
+#include <chrono>
+#endif
+
+namespace
+{
+constexpr size_t   maxMsgId      = 32; // RFC 5424 MSGID length
+constexpr size_t   headerSize    = 160;
+constexpr uint32_t maxSequenceId = 2147483647u;
+
+#if defined(ESP_PLATFORM)
+inline uint32_t nowMs()
+{
+    return static_cast<uint32_t>(esp_timer_get_time() / 1000);
+}
+#else
+inline uint32_t nowMs()
+{
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+}
+#endif
+
+uint8_t severityOf(ILog::LogLevel level)
+{
+    switch (level)
+    {
+        case ILog::LogLevel::WARNING:
+            return 4;
+        case ILog::LogLevel::ERROR:
+            return 3;
+        default:
+            return 6; // informational
+    }
+}
+
+// Header fields are printable US-ASCII without spaces, "-" when empty
+void copyField(char* destination, size_t size, const char* source)
+{
+    size_t length = 0;
+    for (; source != nullptr && source[length] != '\0' && length + 1 < size; length++)
+    {
+        char c              = source[length];
+        destination[length] = (c > 32 && c < 127) ? c : '_';
+    }
+    if (length == 0)
+    {
+        destination[length++] = '-';
+    }
+    destination[length] = '\0';
+}
+} // namespace
+
+syslogConfig_t syslogDefaultConfig()
+{
+    syslogConfig_t config;
+    config.hostname = "esp32";
+    config.appName  = "app";
+    config.facility = 1;
+    return config;
+}
+
+syslogSink::syslogSink(IHAL_COM& transport, const syslogConfig_t& config)
+    : _transport(transport), _config(config), _lengths(), _head(0), _queued(0), _sequence(0), _stats(), _notify(nullptr), _notifyContext(nullptr)
+{
+    _config.facility = (_config.facility <= 23) ? _config.facility : 1;
+    copyField(_hostname, sizeof(_hostname), _config.hostname);
+    copyField(_appName, sizeof(_appName), _config.appName);
+}
+
+syslogSink::~syslogSink()
+{
+    // destructor implementation
+}
+
+void syslogSink::logInfo(const std::string& message)
+{
+    log(LogLevel::INFO, nullptr, message.data(), message.size());
+}
+
+void syslogSink::logWarning(const std::string& message)
+{
+    log(LogLevel::WARNING, nullptr, message.data(), message.size());
+}
+
+void syslogSink::logError(const std::string& message)
+{
+    log(LogLevel::ERROR, nullptr, message.data(), message.size());
+}
+
+void syslogSink::log(LogLevel level, const char* message, size_t length)
+{
+    log(level, nullptr, message, length);
+}
+
+void syslogSink::logToFile(const std::string& filename, LogLevel level, const std::string& message)
+{
+    log(level, filename.c_str(), message.data(), message.size());
+}
+
+sys_error_t syslogSink::log(LogLevel level, const char* msgId, const char* text, size_t length)
+{
+    char id[maxMsgId + 1];
+    char header[headerSize];
+    copyField(id, sizeof(id), msgId);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    uint32_t                    now      = nowMs();
+    uint32_t                    sequence = (_sequence % maxSequenceId) + 1;
+
+    int written = snprintf(header, sizeof(header), "<%u>1 - %s %s - %s [meta sequenceId=\"%u\" sysUpTime=\"%u\"] ", static_cast<unsigned>(_config.facility * 8 + severityOf(level)),
+                           _hostname, _appName, id, static_cast<unsigned>(sequence), static_cast<unsigned>(now / 10));
+    size_t headerLength = (written > 0) ? static_cast<size_t>(written) : 0;
+
+    if (_queued >= SYSLOG_QUEUE_DEPTH)
+    {
+        // The sequence number is used up, the collector sees the gap
+        _sequence = sequence;
+        _stats.droppedQueueFull++;
+        return ERROR_BUSY;
+    }
+
+    // One message per datagram (RFC 5426), the datagram length delimits it
+    size_t   slot     = (_head + _queued) % SYSLOG_QUEUE_DEPTH;
+    uint8_t* datagram = _datagrams[slot];
+    if (headerLength + length > SYSLOG_DATAGRAM_SIZE)
+    {
+        length = SYSLOG_DATAGRAM_SIZE - headerLength;
+        _stats.truncated++;
+    }
+    memcpy(datagram, header, headerLength);
+    if (length > 0)
+    {
+        memcpy(datagram + headerLength, text, length);
+    }
+
+    _lengths[slot] = static_cast<uint16_t>(headerLength + length);
+    _queued++;
+    _sequence = sequence;
+    _stats.records++;
+    if (_notify != nullptr)
+    {
+        _notify(_notifyContext);
+    }
+    return ERROR_SUCCESS;
+}
+
+sys_error_t syslogSink::poll()
+{
+    sys_error_t result = ERROR_SUCCESS;
+    while (true)
+    {
+        size_t slot = 0;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_queued == 0)
+            {
+                return result;
+            }
+            slot = _head;
+        }
+
+        // Queued datagrams are not written by log(), the send runs without the lock
+        sys_error_t sent = _transport.sendData(_datagrams[slot], _lengths[slot]);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (sent == ERROR_BUSY)
+        {
+            _stats.sendBusy++;
+            return ERROR_BUSY;
+        }
+        if (sent == ERROR_SUCCESS)
+        {
+            _stats.datagramsSent++;
+            _stats.bytesSent += _lengths[slot];
+        }
+        else
+        {
+            _stats.droppedSend++;
+            result = sent;
+        }
+        _lengths[slot] = 0;
+        _head          = (_head + 1) % SYSLOG_QUEUE_DEPTH;
+        _queued--;
+    }
+}
+
+void syslogSink::setNotify(syslogNotify_t notify, void* context)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _notify        = notify;
+    _notifyContext = context;
+}
+
+size_t syslogSink::getQueued()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _queued;
+}
+
+syslogStats_t syslogSink::getStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
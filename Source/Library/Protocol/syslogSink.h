@@ -0,0 +1,151 @@
+/**
+ * @file syslogSink.h
+ * @brief Header file for syslogSink
+ *
+ * This file contains declarations for the syslogSink class and related data types and functions.
+ */
+#ifndef SYSLOGSINK_H
+#define SYSLOGSINK_H
+
+#include "HAL/IHal.h"
+#include "System/ILog.h"
+#include <mutex>
+
+#define SYSLOG_DATAGRAM_SIZE 1200 // below the path MTU of common networks, datagrams are not fragmented
+#define SYSLOG_QUEUE_DEPTH   8    // messages waiting to be sent
+#define SYSLOG_HOSTNAME_SIZE 32
+#define SYSLOG_APP_NAME_SIZE 24
+
+/**
+ * @brief syslogSink configuration
+ */
+typedef struct
+{
+    const char* hostname; // HOSTNAME field, copied
+    const char* appName;  // APP-NAME field, copied
+    uint8_t     facility; // 0..23, 1 = user-level messages, 16..23 = local0..local7
+} syslogConfig_t;
+
+/**
+ * @brief syslogSink counters
+ */
+typedef struct
+{
+    uint32_t records;          // messages queued
+    uint32_t droppedQueueFull; // messages lost because the queue was full
+    uint32_t droppedSend;      // messages the transport failed to send
+    uint32_t truncated;        // messages cut to fit a datagram
+    uint32_t datagramsSent;
+    uint32_t bytesSent;
+    uint32_t sendBusy; // sends deferred because the transport could not take the datagram
+} syslogStats_t;
+
+/**
+ * @brief Called when a message is queued, so the sending task can wake up; runs in the logging context under the
+ * sink lock and must not block or log
+ */
+typedef void (*syslogNotify_t)(void* context);
+
+/**
+ * @brief Default configuration: "esp32" / "app", facility user
+ */
+syslogConfig_t syslogDefaultConfig();
+
+/**
+ * @brief ILog sink shipping log records to a syslog collector over a datagram transport (UDP)
+ *
+ * Every record becomes an RFC 5424 message: <PRI>1 - HOSTNAME APP-NAME - MSGID [meta sequenceId sysUpTime] MSG.
+ * The device usually has no wall clock, so TIMESTAMP is left out and the RFC 5424 "meta" element carries the
+ * uptime (hundredths of a second) and a sequence number, which shows the collector where records were lost.
+ * As RFC 5426 requires for UDP, each datagram carries exactly one message, without framing; a message longer than
+ * SYSLOG_DATAGRAM_SIZE is truncated.
+ *
+ * Messages wait in a queue of SYSLOG_QUEUE_DEPTH fixed datagram buffers until poll() sends them. The log methods
+ * only copy the record into a free buffer under a short lock and never wait for the transport; when the queue is
+ * full the record is dropped and counted. poll() runs in a low priority task, it sends outside of the lock and keeps
+ * a datagram queued while the transport reports ERROR_BUSY.
+ */
+class syslogSink : public ILog
+{
+private:
+    IHAL_COM&      _transport;
+    syslogConfig_t _config;
+    char           _hostname[SYSLOG_HOSTNAME_SIZE];
+    char           _appName[SYSLOG_APP_NAME_SIZE];
+    uint8_t        _datagrams[SYSLOG_QUEUE_DEPTH][SYSLOG_DATAGRAM_SIZE];
+    uint16_t       _lengths[SYSLOG_QUEUE_DEPTH];
+    size_t         _head;   // oldest datagram
+    size_t         _queued; // datagrams waiting to be sent
+    uint32_t       _sequence;
+    syslogStats_t  _stats;
+    syslogNotify_t _notify;
+    void*          _notifyContext;
+    std::mutex     _mutex;
+
+public:
+    /**
+     * @brief Construct a new syslogSink object
+     *
+     * @param transport - connected datagram transport, sendData() must not block
+     * @param config - sink configuration (default syslogDefaultConfig())
+     */
+    syslogSink(IHAL_COM& transport, const syslogConfig_t& config = syslogDefaultConfig());
+    ~syslogSink();
+
+    // Delete copy constructor and assignment operator
+    syslogSink(const syslogSink&)            = delete;
+    syslogSink& operator=(const syslogSink&) = delete;
+
+    void logInfo(const std::string& message) override;
+    void logWarning(const std::string& message) override;
+    void logError(const std::string& message) override;
+    void log(LogLevel level, const char* message, size_t length) override;
+
+    /**
+     * @brief Logs a message with the file name as MSGID
+     */
+    void logToFile(const std::string& filename, LogLevel level, const std::string& message) override;
+
+    /**
+     * @brief Queue a record as one datagram, does not allocate
+     *
+     * @param level - severity
+     * @param msgId - MSGID field, nullptr or empty for none
+     * @param text - message text, not null terminated
+     * @param length - text length
+     * @return sys_error_t ERROR_BUSY if the queue is full and the record is dropped
+     */
+    sys_error_t log(LogLevel level, const char* msgId, const char* text, size_t length);
+
+    /**
+     * @brief Send the queued datagrams
+     * Call from one task, when notified and again after a while if it returned ERROR_BUSY.
+     *
+     * @return sys_error_t ERROR_BUSY if the transport could not take every datagram
+     */
+    sys_error_t poll();
+
+    /**
+     * @brief Set the function waking up the task calling poll()
+     *
+     * @param notify - notification function, nullptr for none
+     * @param context - passed to the function
+     */
+    void setNotify(syslogNotify_t notify, void* context);
+
+    /**
+     * @brief Get the number of datagrams waiting to be sent
+     *
+     * @return size_t
+     */
+    size_t getQueued();
+
+    /**
+     * @brief Get the counters
+     *
+     * @return syslogStats_t
+     */
+    syslogStats_t getStats();
+};
+
+#endif /* SYSLOGSINK_H */
@@ -0,0 +1,323 @@
+/**
+ * @file simFreeRTOS.cpp
+ * @brief Source file for simFreeRTOS
+ *
+ * This file contains definitions of the FreeRTOS and esp_timer functions on a simKernel.
+ */
+
+#include "simFreeRTOS.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct simRtosTask
+{
+    simTaskHandle_t id;
+    TaskFunction_t  function;
+    void*           arg;
+    uint32_t        notifications;
+    bool            waiting;   // in ulTaskNotifyTake()
+    bool            suspended; // stops at the end of its current wait
+    bool            parked;    // blocked until vTaskResume()
+};
+
+struct simRtosQueue
+{
+    size_t                          itemSize;
+    simQueue<std::vector<uint8_t>> items;
+
+    simRtosQueue(simKernel& kernel, size_t length, size_t size) : itemSize(size), items(kernel, length) {}
+};
+
+struct simRtosTimer
+{
+    void*                   id;
+    TimerCallbackFunction_t callback;
+    simTimerHandle_t        timer;
+};
+
+namespace
+{
+simKernel*                                boundKernel = nullptr;
+std::vector<std::unique_ptr<simRtosTask>> boundTasks; // by simTaskHandle_t, empty for tasks created on the kernel directly
+
+simKernel& kernel()
+{
+    if (boundKernel == nullptr)
+    {
+        fputs("simFreeRTOS: FreeRTOS call without a simRtos binding\n", stderr);
+        abort();
+    }
+    return *boundKernel;
+}
+
+simRtosTask* currentTask()
+{
+    simTaskHandle_t id = kernel().getCurrentTask();
+    return (id >= 0 && static_cast<size_t>(id) < boundTasks.size()) ? boundTasks[id].get() : nullptr;
+}
+
+void parkIfSuspended(simRtosTask* task)
+{
+    while (task != nullptr && task->suspended)
+    {
+        task->parked = true;
+        kernel().block(SIM_WAIT_FOREVER);
+        task->parked = false;
+    }
+}
+} // namespace
+
+simRtos::simRtos(simKernel& kernel)
+{
+    boundKernel = &kernel;
+    boundTasks.clear();
+}
+
+simRtos::~simRtos()
+{
+    boundTasks.clear();
+    boundKernel = nullptr;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth, void* arg, UBaseType_t priority, TaskHandle_t* handle, BaseType_t core)
+{
+    std::unique_ptr<simRtosTask> task(new simRtosTask());
+    simRtosTask*                 entry = task.get();
+    entry->function                    = function;
+    entry->arg                         = arg;
+
+    size_t stackSize = (stackDepth > SIM_DEFAULT_STACK_SIZE) ? stackDepth : SIM_DEFAULT_STACK_SIZE;
+    entry->id        = kernel().createTask(name, [entry]() { entry->function(entry->arg); }, static_cast<uint8_t>((priority < UINT8_MAX) ? priority : UINT8_MAX), stackSize);
+    if (boundTasks.size() <= static_cast<size_t>(entry->id))
+    {
+        boundTasks.resize(entry->id + 1);
+    }
+    boundTasks[entry->id] = std::move(task);
+    if (handle != nullptr)
+    {
+        *handle = entry;
+    }
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stackDepth, void* arg, UBaseType_t priority, TaskHandle_t* handle)
+{
+    return xTaskCreatePinnedToCore(function, name, stackDepth, arg, priority, handle, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+    // Holders destroyed after the binding have nothing left to delete
+    if (boundKernel == nullptr)
+    {
+        return;
+    }
+    simRtosTask* entry = (task != NULL) ? task : currentTask();
+    if (entry != nullptr)
+    {
+        boundKernel->deleteTask(entry->id);
+    }
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    kernel().delay(ticks);
+    parkIfSuspended(currentTask());
+}
+
+void vTaskDelayUntil(TickType_t* previousWake, TickType_t period)
+{
+    *previousWake += period;
+    TickType_t wait = *previousWake - xTaskGetTickCount();
+    if (static_cast<int32_t>(wait) > 0)
+    {
+        vTaskDelay(wait);
+    }
+}
+
+TickType_t xTaskGetTickCount()
+{
+    return static_cast<TickType_t>(kernel().getTickCount());
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+    return currentTask();
+}
+
+void vTaskSuspend(TaskHandle_t task)
+{
+    simRtosTask* entry = (task != NULL) ? task : currentTask();
+    if (entry == nullptr)
+    {
+        return;
+    }
+    entry->suspended = true;
+    if (entry == currentTask())
+    {
+        parkIfSuspended(entry);
+    }
+}
+
+void vTaskResume(TaskHandle_t task)
+{
+    if (task == NULL)
+    {
+        return;
+    }
+    task->suspended = false;
+    if (task->parked)
+    {
+        kernel().wake(task->id);
+    }
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait)
+{
+    simRtosTask* task = currentTask();
+    if (task == nullptr)
+    {
+        return 0;
+    }
+    if (task->notifications == 0 && ticksToWait > 0)
+    {
+        task->waiting = true;
+        kernel().block(ticksToWait);
+        task->waiting = false;
+        parkIfSuspended(task);
+    }
+    uint32_t value = task->notifications;
+    if (value > 0)
+    {
+        task->notifications = (clearCountOnExit != pdFALSE) ? 0 : value - 1;
+    }
+    return value;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+    if (task == NULL)
+    {
+        return pdFAIL;
+    }
+    task->notifications++;
+    if (task->waiting)
+    {
+        kernel().wake(task->id);
+    }
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken)
+{
+    bool waiting = (task != NULL && task->waiting);
+    xTaskNotifyGive(task);
+    if (higherPriorityTaskWoken != nullptr && waiting)
+    {
+        *higherPriorityTaskWoken = pdTRUE;
+    }
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize)
+{
+    return new simRtosQueue(kernel(), length, itemSize);
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+    delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait)
+{
+    const uint8_t*       bytes = static_cast<const uint8_t*>(item);
+    std::vector<uint8_t> copy(bytes, bytes + queue->itemSize);
+    bool                 sent = queue->items.send(copy, ticksToWait);
+    parkIfSuspended(currentTask());
+    return sent ? pdPASS : pdFAIL;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* higherPriorityTaskWoken)
+{
+    return xQueueSend(queue, item, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticksToWait)
+{
+    std::vector<uint8_t> copy;
+    bool                 received = queue->items.receive(copy, ticksToWait);
+    if (received)
+    {
+        memcpy(item, copy.data(), queue->itemSize);
+    }
+    parkIfSuspended(currentTask());
+    return received ? pdPASS : pdFAIL;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+    return static_cast<UBaseType_t>(queue->items.size());
+}
+
+TimerHandle_t xTimerCreate(const char* name, TickType_t period, UBaseType_t autoReload, void* id, TimerCallbackFunction_t callback)
+{
+    simRtosTimer* timer = new simRtosTimer();
+    timer->id           = id;
+    timer->callback     = callback;
+    timer->timer        = kernel().createTimer(name, period, autoReload != pdFALSE, [timer]() { timer->callback(timer); });
+    return timer;
+}
+
+BaseType_t xTimerDelete(TimerHandle_t timer, TickType_t ticksToWait)
+{
+    if (timer == NULL)
+    {
+        return pdFAIL;
+    }
+    // Stopped, the kernel never calls back into the deleted holder
+    if (boundKernel != nullptr)
+    {
+        boundKernel->stopTimer(timer->timer);
+    }
+    delete timer;
+    return pdPASS;
+}
+
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t ticksToWait)
+{
+    kernel().startTimer(timer->timer);
+    return pdPASS;
+}
+
+BaseType_t xTimerStartFromISR(TimerHandle_t timer, BaseType_t* higherPriorityTaskWoken)
+{
+    return xTimerStart(timer, 0);
+}
+
+BaseType_t xTimerReset(TimerHandle_t timer, TickType_t ticksToWait)
+{
+    return xTimerStart(timer, ticksToWait);
+}
+
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t ticksToWait)
+{
+    kernel().stopTimer(timer->timer);
+    return pdPASS;
+}
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t timer)
+{
+    return kernel().isTimerActive(timer->timer) ? pdTRUE : pdFALSE;
+}
+
+void* pvTimerGetTimerID(TimerHandle_t timer)
+{
+    return timer->id;
+}
+
+int64_t esp_timer_get_time()
+{
+    return static_cast<int64_t>(kernel().getTickCount() * 1000000 / configTICK_RATE_HZ);
+}
@@ -0,0 +1,113 @@
+/**
+ * @file simFreeRTOS.h
+ * @brief Header file for simFreeRTOS
+ *
+ * This file contains the subset of the FreeRTOS and esp_timer API used by the processes, implemented on a simKernel.
+ * The fake FreeRTOS and esp_timer.h headers of Tests/Unit_Tests/Fake include it, so device code such as
+ * Proc_Leds, Proc_Button, io_gpio and rtosObjects builds unmodified on the host and runs in virtual time.
+ */
+#ifndef SIMFREERTOS_H
+#define SIMFREERTOS_H
+
+#include "simKernel.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define configTICK_RATE_HZ               1000 // the bound simKernel must use the default tick rate
+#define configMAX_PRIORITIES             25
+#define configSUPPORT_STATIC_ALLOCATION  0
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#define portNUM_PROCESSORS               2
+#define portMAX_DELAY                    SIM_WAIT_FOREVER
+#define tskNO_AFFINITY                   0x7FFFFFFF
+
+#define pdFALSE 0
+#define pdTRUE  1
+#define pdFAIL  pdFALSE
+#define pdPASS  pdTRUE
+
+#define pdMS_TO_TICKS(ms)    (static_cast<TickType_t>(static_cast<uint64_t>(ms) * configTICK_RATE_HZ / 1000))
+#define pdTICKS_TO_MS(ticks) (static_cast<uint32_t>(static_cast<uint64_t>(ticks) * 1000 / configTICK_RATE_HZ))
+#define portYIELD_FROM_ISR() // the kernel runs the woken task once the simulated interrupt returns
+
+typedef uint32_t TickType_t;
+typedef int      BaseType_t;
+typedef unsigned UBaseType_t;
+typedef uint8_t  StackType_t; // stack depths are in bytes, as on ESP-IDF
+
+typedef struct simRtosTask*  TaskHandle_t;
+typedef struct simRtosQueue* QueueHandle_t;
+typedef struct simRtosTimer* TimerHandle_t;
+
+typedef void (*TaskFunction_t)(void* arg);
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t timer);
+
+/**
+ * @brief Binds the FreeRTOS functions to a simKernel while it exists
+ *
+ * Declare it right after the kernel and before the objects creating tasks, queues and timers, so they are destroyed
+ * first. Only one binding may exist at a time. Interrupt handlers are simulated with simKernel::schedule(), the
+ * FromISR functions then run in kernel context.
+ */
+class simRtos
+{
+public:
+    /**
+     * @brief Bind the FreeRTOS functions to the kernel
+     *
+     * @param kernel - kernel with the default tick rate
+     */
+    explicit simRtos(simKernel& kernel);
+    ~simRtos();
+
+    // Delete copy constructor and assignment operator
+    simRtos(const simRtos&)            = delete;
+    simRtos& operator=(const simRtos&) = delete;
+};
+
+// Tasks; the stack is at least SIM_DEFAULT_STACK_SIZE, host code needs more than the device
+BaseType_t   xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth, void* arg, UBaseType_t priority, TaskHandle_t* handle, BaseType_t core);
+BaseType_t   xTaskCreate(TaskFunction_t function, const char* name, uint32_t stackDepth, void* arg, UBaseType_t priority, TaskHandle_t* handle);
+void         vTaskDelete(TaskHandle_t task);
+void         vTaskDelay(TickType_t ticks);
+void         vTaskDelayUntil(TickType_t* previousWake, TickType_t period);
+TickType_t   xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+
+/**
+ * @brief Suspend a task; a task suspended by another one stops when its current wait ends
+ */
+void vTaskSuspend(TaskHandle_t task);
+void vTaskResume(TaskHandle_t task);
+
+// Task notifications, as a counting semaphore
+uint32_t   ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+void       vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken);
+
+// Queues, items are copied in and out; the timeout must be 0 in kernel context
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize);
+void          vQueueDelete(QueueHandle_t queue);
+BaseType_t    xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticksToWait);
+BaseType_t    xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* higherPriorityTaskWoken);
+BaseType_t    xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticksToWait);
+UBaseType_t   uxQueueMessagesWaiting(QueueHandle_t queue);
+
+// Software timers, the callbacks run in kernel context and must not block
+TimerHandle_t xTimerCreate(const char* name, TickType_t period, UBaseType_t autoReload, void* id, TimerCallbackFunction_t callback);
+BaseType_t    xTimerDelete(TimerHandle_t timer, TickType_t ticksToWait);
+BaseType_t    xTimerStart(TimerHandle_t timer, TickType_t ticksToWait);
+BaseType_t    xTimerStartFromISR(TimerHandle_t timer, BaseType_t* higherPriorityTaskWoken);
+BaseType_t    xTimerReset(TimerHandle_t timer, TickType_t ticksToWait);
+BaseType_t    xTimerStop(TimerHandle_t timer, TickType_t ticksToWait);
+BaseType_t    xTimerIsTimerActive(TimerHandle_t timer);
+void*         pvTimerGetTimerID(TimerHandle_t timer);
+
+/**
+ * @brief Virtual time since the kernel started, like esp_timer_get_time()
+ *
+ * @return int64_t microseconds
+ */
+int64_t esp_timer_get_time();
+
+#endif /* SIMFREERTOS_H */
@@ -0,0 +1,142 @@
+/**
+ * @file simGpio.cpp
+ * @brief Source file for simGpio
+ *
+ * This file contains definitions of the ESP-IDF GPIO driver functions on a simulated bank of pins.
+ */
+
+#include "simGpio.h"
+
+namespace
+{
+typedef struct
+{
+    uint32_t        level;
+    gpio_mode_t     mode;
+    gpio_int_type_t intrType;
+    bool            intrEnabled;
+    gpio_isr_t      handler;
+    void*           arg;
+} simPin_t;
+
+simPin_t pins[GPIO_NUM_MAX];
+
+bool isPin(gpio_num_t gpio)
+{
+    return gpio >= GPIO_NUM_0 && gpio < GPIO_NUM_MAX;
+}
+
+bool triggers(gpio_int_type_t type, uint32_t from, uint32_t to)
+{
+    switch (type)
+    {
+        case GPIO_INTR_POSEDGE:
+        case GPIO_INTR_HIGH_LEVEL:
+            return from == 0 && to == 1;
+        case GPIO_INTR_NEGEDGE:
+        case GPIO_INTR_LOW_LEVEL:
+            return from == 1 && to == 0;
+        case GPIO_INTR_ANYEDGE:
+            return from != to;
+        default:
+            return false;
+    }
+}
+} // namespace
+
+esp_err_t gpio_config(const gpio_config_t* config)
+{
+    if (config == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (int gpio = 0; gpio < GPIO_NUM_MAX; gpio++)
+    {
+        if (config->pin_bit_mask & (1ULL << gpio))
+        {
+            pins[gpio].mode        = config->mode;
+            pins[gpio].intrType    = config->intr_type;
+            pins[gpio].intrEnabled = (config->intr_type != GPIO_INTR_DISABLE);
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t gpio_install_isr_service(int flags)
+{
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio, gpio_isr_t handler, void* arg)
+{
+    if (!isPin(gpio))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pins[gpio].handler = handler;
+    pins[gpio].arg     = arg;
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio)
+{
+    return gpio_isr_handler_add(gpio, nullptr, nullptr);
+}
+
+esp_err_t gpio_intr_enable(gpio_num_t gpio)
+{
+    if (!isPin(gpio))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pins[gpio].intrEnabled = true;
+    return ESP_OK;
+}
+
+esp_err_t gpio_intr_disable(gpio_num_t gpio)
+{
+    if (!isPin(gpio))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pins[gpio].intrEnabled = false;
+    return ESP_OK;
+}
+
+int gpio_get_level(gpio_num_t gpio)
+{
+    return isPin(gpio) ? static_cast<int>(pins[gpio].level) : 0;
+}
+
+esp_err_t gpio_set_level(gpio_num_t gpio, uint32_t level)
+{
+    if (!isPin(gpio))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    pins[gpio].level = (level != 0) ? 1 : 0;
+    return ESP_OK;
+}
+
+void simGpioDrive(gpio_num_t gpio, uint32_t level)
+{
+    if (!isPin(gpio))
+    {
+        return;
+    }
+    simPin_t& pin  = pins[gpio];
+    uint32_t  from = pin.level;
+    pin.level      = (level != 0) ? 1 : 0;
+    if (pin.intrEnabled && pin.handler != nullptr && triggers(pin.intrType, from, pin.level))
+    {
+        pin.handler(pin.arg);
+    }
+}
+
+void simGpioReset()
+{
+    for (simPin_t& pin : pins)
+    {
+        pin = simPin_t();
+    }
+}
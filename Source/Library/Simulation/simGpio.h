@@ -0,0 +1,144 @@
+/**
+ * @file simGpio.h
+ * @brief Header file for simGpio
+ *
+ * This file contains the subset of the ESP-IDF GPIO driver API used by io_gpio, on a simulated bank of pins.
+ * The fake driver/gpio.h of Tests/Unit_Tests/Fake includes it. Tests drive the inputs with simGpioDrive(), usually
+ * from a simKernel::schedule() callback, which runs the interrupt handler of the pin like the GPIO interrupt would.
+ */
+#ifndef SIMGPIO_H
+#define SIMGPIO_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+// From esp_err.h
+typedef int esp_err_t;
+
+#define ESP_OK              0
+#define ESP_FAIL            -1
+#define ESP_ERR_INVALID_ARG 0x102
+
+#define ESP_ERROR_CHECK(x)        \
+    do                            \
+    {                             \
+        if ((x) != ESP_OK)        \
+        {                         \
+            abort();              \
+        }                         \
+    } while (0)
+
+#define IRAM_ATTR
+#define ESP_INTR_FLAG_LEVEL1 (1 << 1)
+
+typedef enum
+{
+    GPIO_NUM_NC = -1,
+    GPIO_NUM_0  = 0,
+    GPIO_NUM_1,
+    GPIO_NUM_2,
+    GPIO_NUM_3,
+    GPIO_NUM_4,
+    GPIO_NUM_5,
+    GPIO_NUM_6,
+    GPIO_NUM_7,
+    GPIO_NUM_8,
+    GPIO_NUM_9,
+    GPIO_NUM_10,
+    GPIO_NUM_11,
+    GPIO_NUM_12,
+    GPIO_NUM_13,
+    GPIO_NUM_14,
+    GPIO_NUM_15,
+    GPIO_NUM_16,
+    GPIO_NUM_17,
+    GPIO_NUM_18,
+    GPIO_NUM_19,
+    GPIO_NUM_20,
+    GPIO_NUM_21,
+    GPIO_NUM_22,
+    GPIO_NUM_23,
+    GPIO_NUM_24,
+    GPIO_NUM_25,
+    GPIO_NUM_26,
+    GPIO_NUM_27,
+    GPIO_NUM_28,
+    GPIO_NUM_29,
+    GPIO_NUM_30,
+    GPIO_NUM_31,
+    GPIO_NUM_32,
+    GPIO_NUM_33,
+    GPIO_NUM_34,
+    GPIO_NUM_35,
+    GPIO_NUM_36,
+    GPIO_NUM_37,
+    GPIO_NUM_38,
+    GPIO_NUM_39,
+    GPIO_NUM_MAX,
+} gpio_num_t;
+
+typedef enum
+{
+    GPIO_MODE_DISABLE = 0,
+    GPIO_MODE_INPUT,
+    GPIO_MODE_OUTPUT,
+    GPIO_MODE_INPUT_OUTPUT,
+} gpio_mode_t;
+
+typedef enum
+{
+    GPIO_PULLUP_DISABLE = 0,
+    GPIO_PULLUP_ENABLE,
+} gpio_pullup_t;
+
+typedef enum
+{
+    GPIO_PULLDOWN_DISABLE = 0,
+    GPIO_PULLDOWN_ENABLE,
+} gpio_pulldown_t;
+
+typedef enum
+{
+    GPIO_INTR_DISABLE = 0,
+    GPIO_INTR_POSEDGE,
+    GPIO_INTR_NEGEDGE,
+    GPIO_INTR_ANYEDGE,
+    GPIO_INTR_LOW_LEVEL, // simulated as the edge into the level
+    GPIO_INTR_HIGH_LEVEL,
+} gpio_int_type_t;
+
+typedef struct
+{
+    uint64_t        pin_bit_mask;
+    gpio_mode_t     mode;
+    gpio_pullup_t   pull_up_en;
+    gpio_pulldown_t pull_down_en;
+    gpio_int_type_t intr_type;
+} gpio_config_t;
+
+typedef void (*gpio_isr_t)(void* arg);
+
+esp_err_t gpio_config(const gpio_config_t* config);
+esp_err_t gpio_install_isr_service(int flags);
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio, gpio_isr_t handler, void* arg);
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio);
+esp_err_t gpio_intr_enable(gpio_num_t gpio);
+esp_err_t gpio_intr_disable(gpio_num_t gpio);
+int       gpio_get_level(gpio_num_t gpio);
+esp_err_t gpio_set_level(gpio_num_t gpio, uint32_t level);
+
+/**
+ * @brief Drive an input pin from outside, runs its interrupt handler on a matching edge
+ * Edges while the interrupt of the pin is disabled are lost, as on the device.
+ *
+ * @param gpio - pin number
+ * @param level - 0 or 1
+ */
+void simGpioDrive(gpio_num_t gpio, uint32_t level);
+
+/**
+ * @brief Set every pin low, unconfigured and without interrupt handler
+ */
+void simGpioReset();
+
+#endif /* SIMGPIO_H */
@@ -0,0 +1,291 @@
+/**
+ * @file simKernel.cpp
+ * @brief Source file for simKernel
+ *
+ * This file contains definitions for the simKernel class and related data types and functions.
+ */
+
+#include "simKernel.h"
+
+simKernel::simKernel(uint32_t tickRateHz) : _tickRateHz((tickRateHz > 0) ? tickRateHz : 1000), _now(0), _sequence(0), _current(-1), _stats() {}
+
+simKernel::~simKernel()
+{
+    // destructor implementation
+}
+
+void simKernel::taskEntry(unsigned int kernelHigh, unsigned int kernelLow)
+{
+    // makecontext() only passes int arguments, the kernel pointer comes in two halves
+    uintptr_t  address = (static_cast<uintptr_t>(kernelHigh) << 16 << 16) | static_cast<uintptr_t>(kernelLow);
+    simKernel& kernel  = *reinterpret_cast<simKernel*>(address);
+    task_t&    task    = *kernel._tasks[kernel._current];
+
+    task.function();
+
+    task.state = TASK_FINISHED;
+    kernel._stats.tasksFinished++;
+    kernel.switchToKernel(); // never resumed
+}
+
+simTaskHandle_t simKernel::createTask(const char* name, callback_t function, uint8_t priority, size_t stackSize)
+{
+    std::unique_ptr<task_t> task(new task_t());
+    task->name       = (name != nullptr) ? name : "";
+    task->function   = function;
+    task->priority   = priority;
+    task->state      = TASK_READY;
+    task->generation = 0;
+    task->timedOut   = false;
+    task->stack.reset(new uint8_t[stackSize]);
+
+    getcontext(&task->context);
+    task->context.uc_stack.ss_sp   = task->stack.get();
+    task->context.uc_stack.ss_size = stackSize;
+    task->context.uc_link          = nullptr;
+    uintptr_t address              = reinterpret_cast<uintptr_t>(this);
+    makecontext(&task->context, reinterpret_cast<void (*)()>(taskEntry), 2, static_cast<unsigned int>(address >> 16 >> 16), static_cast<unsigned int>(address & 0xFFFFFFFFu));
+
+    simTaskHandle_t handle = static_cast<simTaskHandle_t>(_tasks.size());
+    _tasks.push_back(std::move(task));
+    push(_now, priority, EVENT_TASK, handle, 0);
+    return handle;
+}
+
+void simKernel::deleteTask(simTaskHandle_t task)
+{
+    if (task < 0 || static_cast<size_t>(task) >= _tasks.size() || _tasks[task]->state == TASK_FINISHED)
+    {
+        return;
+    }
+    task_t& entry = *_tasks[task];
+    entry.state   = TASK_FINISHED;
+    entry.generation++; // pending wake ups become stale
+    if (task == _current)
+    {
+        switchToKernel(); // never resumed
+    }
+}
+
+simTimerHandle_t simKernel::createTimer(const char* name, uint32_t periodTicks, bool autoReload, callback_t callback)
+{
+    timer_t timer = {(name != nullptr) ? name : "", (periodTicks > 0) ? periodTicks : 1, autoReload, false, 0, callback};
+    _timers.push_back(timer);
+    return static_cast<simTimerHandle_t>(_timers.size() - 1);
+}
+
+void simKernel::startTimer(simTimerHandle_t timer)
+{
+    if (timer < 0 || static_cast<size_t>(timer) >= _timers.size())
+    {
+        return;
+    }
+    timer_t& entry = _timers[timer];
+    entry.active   = true;
+    entry.generation++;
+    push(_now + entry.period, SIM_TIMER_PRIORITY, EVENT_TIMER, timer, entry.generation);
+}
+
+void simKernel::stopTimer(simTimerHandle_t timer)
+{
+    if (timer >= 0 && static_cast<size_t>(timer) < _timers.size())
+    {
+        _timers[timer].active = false;
+        _timers[timer].generation++;
+    }
+}
+
+bool simKernel::isTimerActive(simTimerHandle_t timer)
+{
+    return timer >= 0 && static_cast<size_t>(timer) < _timers.size() && _timers[timer].active;
+}
+
+void simKernel::schedule(uint32_t delayTicks, callback_t callback)
+{
+    size_t index;
+    if (!_freeCallbacks.empty())
+    {
+        index = _freeCallbacks.back();
+        _freeCallbacks.pop_back();
+        _callbacks[index] = callback;
+    }
+    else
+    {
+        index = _callbacks.size();
+        _callbacks.push_back(callback);
+    }
+    push(_now + delayTicks, SIM_TIMER_PRIORITY, EVENT_CALLBACK, static_cast<int32_t>(index), 0);
+}
+
+void simKernel::delay(uint32_t ticks)
+{
+    if (ticks == 0)
+    {
+        yield();
+        return;
+    }
+    uint64_t deadline = _now + ticks;
+    while (_now < deadline && _current >= 0)
+    {
+        block(static_cast<uint32_t>(deadline - _now));
+    }
+}
+
+void simKernel::delayUntil(uint64_t& previousWake, uint32_t period)
+{
+    previousWake += period;
+    if (previousWake > _now)
+    {
+        delay(static_cast<uint32_t>(previousWake - _now));
+    }
+}
+
+void simKernel::yield()
+{
+    block(0);
+}
+
+bool simKernel::block(uint32_t timeoutTicks)
+{
+    if (_current < 0)
+    {
+        return false; // kernel context can not block
+    }
+    task_t& task  = *_tasks[_current];
+    task.state    = TASK_BLOCKED;
+    task.timedOut = true; // cleared by wake()
+    task.generation++;
+    if (timeoutTicks != SIM_WAIT_FOREVER)
+    {
+        push(_now + timeoutTicks, task.priority, EVENT_TASK, _current, task.generation);
+    }
+    switchToKernel();
+    return !task.timedOut;
+}
+
+void simKernel::wake(simTaskHandle_t task)
+{
+    if (task < 0 || static_cast<size_t>(task) >= _tasks.size() || _tasks[task]->state != TASK_BLOCKED)
+    {
+        return;
+    }
+    task_t& entry  = *_tasks[task];
+    entry.state    = TASK_READY;
+    entry.timedOut = false;
+    entry.generation++; // the pending timeout becomes stale
+    push(_now, entry.priority, EVENT_TASK, task, entry.generation);
+}
+
+simTaskHandle_t simKernel::getCurrentTask()
+{
+    return _current;
+}
+
+uint64_t simKernel::getTickCount()
+{
+    return _now;
+}
+
+uint32_t simKernel::msToTicks(uint32_t ms)
+{
+    return static_cast<uint32_t>(static_cast<uint64_t>(ms) * _tickRateHz / 1000);
+}
+
+uint64_t simKernel::runFor(uint64_t ticks)
+{
+    uint64_t end       = _now + ticks;
+    uint64_t processed = 0;
+    while (!_events.empty() && _events.top().time <= end)
+    {
+        event_t event = _events.top();
+        _events.pop();
+        _now = event.time;
+        dispatch(event);
+        processed++;
+    }
+    _now = end;
+    return processed;
+}
+
+bool simKernel::runUntilIdle(uint64_t maxTicks)
+{
+    uint64_t end = _now + maxTicks;
+    while (!_events.empty() && _events.top().time <= end)
+    {
+        event_t event = _events.top();
+        _events.pop();
+        _now = event.time;
+        dispatch(event);
+    }
+    return _events.empty();
+}
+
+simStats_t simKernel::getStats()
+{
+    return _stats;
+}
+
+void simKernel::push(uint64_t time, uint8_t priority, eventType_t type, int32_t target, uint32_t generation)
+{
+    event_t event = {time, priority, _sequence++, type, target, generation};
+    _events.push(event);
+}
+
+void simKernel::dispatch(const event_t& event)
+{
+    switch (event.type)
+    {
+        case EVENT_TASK:
+        {
+            task_t& task = *_tasks[event.target];
+            if (task.state == TASK_FINISHED || task.generation != event.generation)
+            {
+                return; // woken earlier, the timeout is stale
+            }
+            task.state = TASK_READY;
+            _current   = event.target;
+            _stats.events++;
+            _stats.contextSwitches++;
+            swapcontext(&_kernelContext, &task.context);
+            _current = -1;
+        }
+        break;
+
+        case EVENT_TIMER:
+        {
+            timer_t& timer = _timers[event.target];
+            if (!timer.active || timer.generation != event.generation)
+            {
+                return; // stopped or restarted
+            }
+            if (timer.autoReload)
+            {
+                push(_now + timer.period, SIM_TIMER_PRIORITY, EVENT_TIMER, event.target, timer.generation);
+            }
+            else
+            {
+                timer.active = false;
+            }
+            // The callback may create timers, the vector entry must not be used after it
+            callback_t callback = timer.callback;
+            _stats.events++;
+            _stats.timerCallbacks++;
+            callback();
+        }
+        break;
+
+        case EVENT_CALLBACK:
+        {
+            callback_t callback = std::move(_callbacks[event.target]);
+            _freeCallbacks.push_back(static_cast<size_t>(event.target));
+            _stats.events++;
+            callback();
+        }
+        break;
+    }
+}
+
+void simKernel::switchToKernel()
+{
+    swapcontext(&_tasks[_current]->context, &_kernelContext);
+}
@@ -0,0 +1,355 @@
+/**
+ * @file simKernel.h
+ * @brief Header file for simKernel
+ *
+ * This file contains declarations for the simKernel class and related data types and functions.
+ */
+#ifndef SIMKERNEL_H
+#define SIMKERNEL_H
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <ucontext.h>
+#include <vector>
+
+#define SIM_WAIT_FOREVER       UINT32_MAX
+#define SIM_DEFAULT_STACK_SIZE (64 * 1024)
+#define SIM_TIMER_PRIORITY     UINT8_MAX // timer callbacks run before tasks woken at the same tick, like a high priority timer task
+
+typedef int32_t simTaskHandle_t;  // -1 = invalid
+typedef int32_t simTimerHandle_t; // -1 = invalid
+
+/**
+ * @brief Counters of a simKernel run
+ */
+typedef struct
+{
+    uint64_t events;          // task wake ups, timer expiries and scheduled callbacks processed
+    uint64_t contextSwitches; // switches into tasks
+    uint64_t timerCallbacks;
+    uint32_t tasksFinished; // task functions that returned
+} simStats_t;
+
+/**
+ * @brief Deterministic virtual-time kernel for the host
+ *
+ * Tasks are coroutines on their own stacks (ucontext) driven by one thread, so blocking code written like a FreeRTOS
+ * task (loop, vTaskDelay, xQueueReceive with timeout) runs unchanged in shape. Time only moves when every task is
+ * blocked: the kernel jumps straight to the next pending event, which makes an hour of 100 ms delays cost a few
+ * milliseconds. Events due at the same tick run by priority, then in the order they were scheduled, so every run is
+ * reproducible. One tick is 1 / tickRateHz seconds, 1 ms by default like configTICK_RATE_HZ = 1000.
+ * simFreeRTOS.h provides the FreeRTOS API on top of it, so the device tasks themselves run here.
+ *
+ * Objects on the stack of a task that never returns are not destroyed when the kernel is.
+ */
+class simKernel
+{
+public:
+    typedef std::function<void()> callback_t;
+
+private:
+    typedef enum : uint8_t
+    {
+        TASK_READY,
+        TASK_BLOCKED,
+        TASK_FINISHED,
+    } taskState_t;
+
+    typedef struct
+    {
+        std::string                name;
+        callback_t                 function;
+        uint8_t                    priority;
+        taskState_t                state;
+        uint32_t                   generation; // invalidates pending wake ups of an earlier wait
+        bool                       timedOut;
+        ucontext_t                 context;
+        std::unique_ptr<uint8_t[]> stack;
+    } task_t;
+
+    typedef struct
+    {
+        std::string name;
+        uint32_t    period;
+        bool        autoReload;
+        bool        active;
+        uint32_t    generation; // invalidates expiries of an earlier start
+        callback_t  callback;
+    } timer_t;
+
+    typedef enum : uint8_t
+    {
+        EVENT_TASK,
+        EVENT_TIMER,
+        EVENT_CALLBACK,
+    } eventType_t;
+
+    typedef struct
+    {
+        uint64_t    time;
+        uint8_t     priority;
+        uint64_t    sequence;
+        eventType_t type;
+        int32_t     target;     // task, timer or index into _callbacks
+        uint32_t    generation; // of the task or timer when the event was scheduled
+    } event_t;
+
+    struct laterEvent
+    {
+        bool operator()(const event_t& a, const event_t& b) const
+        {
+            if (a.time != b.time)
+            {
+                return a.time > b.time;
+            }
+            if (a.priority != b.priority)
+            {
+                return a.priority < b.priority;
+            }
+            return a.sequence > b.sequence;
+        }
+    };
+
+    uint32_t                                                       _tickRateHz;
+    uint64_t                                                       _now;
+    uint64_t                                                       _sequence;
+    std::vector<std::unique_ptr<task_t>>                           _tasks;
+    std::vector<timer_t>                                           _timers;
+    std::vector<callback_t>                                        _callbacks;
+    std::vector<size_t>                                            _freeCallbacks;
+    std::priority_queue<event_t, std::vector<event_t>, laterEvent> _events;
+    simTaskHandle_t                                                _current;
+    ucontext_t                                                     _kernelContext;
+    simStats_t                                                     _stats;
+
+    static void taskEntry(unsigned int kernelHigh, unsigned int kernelLow);
+
+    void push(uint64_t time, uint8_t priority, eventType_t type, int32_t target, uint32_t generation);
+    void dispatch(const event_t& event);
+    void switchToKernel();
+
+public:
+    /**
+     * @brief Construct a new simKernel object
+     *
+     * @param tickRateHz - ticks per simulated second (default 1000)
+     */
+    explicit simKernel(uint32_t tickRateHz = 1000);
+    ~simKernel();
+
+    // Delete copy constructor and assignment operator
+    simKernel(const simKernel&)            = delete;
+    simKernel& operator=(const simKernel&) = delete;
+
+    /**
+     * @brief Create a task, it first runs at the current tick once the kernel runs
+     *
+     * @param name - task name
+     * @param function - task body, the task finishes when it returns
+     * @param priority - higher runs first among tasks ready at the same tick
+     * @param stackSize - coroutine stack in bytes (default SIM_DEFAULT_STACK_SIZE)
+     * @return simTaskHandle_t
+     */
+    simTaskHandle_t createTask(const char* name, callback_t function, uint8_t priority, size_t stackSize = SIM_DEFAULT_STACK_SIZE);
+
+    /**
+     * @brief Finish a task without returning from its function, like vTaskDelete()
+     * Deleting the running task switches back to the kernel and does not return.
+     */
+    void deleteTask(simTaskHandle_t task);
+
+    /**
+     * @brief Create a software timer, stopped, like xTimerCreate()
+     *
+     * @param name - timer name
+     * @param periodTicks - period, at least 1
+     * @param autoReload - restart after every expiry
+     * @param callback - runs in kernel context, may send to queues and start timers but must not block
+     * @return simTimerHandle_t
+     */
+    simTimerHandle_t createTimer(const char* name, uint32_t periodTicks, bool autoReload, callback_t callback);
+
+    /**
+     * @brief (Re)start a timer, it expires one period from now, like xTimerStart()/xTimerReset()
+     */
+    void startTimer(simTimerHandle_t timer);
+    void stopTimer(simTimerHandle_t timer);
+    bool isTimerActive(simTimerHandle_t timer);
+
+    /**
+     * @brief Run a callback in kernel context after a delay, e.g. to inject an interrupt
+     *
+     * @param delayTicks - ticks from now, 0 runs it at the current tick after the already pending events
+     * @param callback - must not block
+     */
+    void schedule(uint32_t delayTicks, callback_t callback);
+
+    /**
+     * @brief Block the calling task, like vTaskDelay()
+     */
+    void delay(uint32_t ticks);
+
+    /**
+     * @brief Block the calling task until previousWake + period, like vTaskDelayUntil()
+     *
+     * @param previousWake - updated to the wake time
+     * @param period - ticks
+     */
+    void delayUntil(uint64_t& previousWake, uint32_t period);
+
+    /**
+     * @brief Let other tasks ready at the current tick run first
+     */
+    void yield();
+
+    /**
+     * @brief Block the calling task until wake() or the timeout
+     *
+     * @param timeoutTicks - SIM_WAIT_FOREVER for no timeout
+     * @return true if woken, false on timeout
+     */
+    bool block(uint32_t timeoutTicks);
+
+    /**
+     * @brief Make a blocked task ready at the current tick, no effect on other states
+     */
+    void wake(simTaskHandle_t task);
+
+    /**
+     * @brief Handle of the running task, -1 in kernel context (timer callbacks, scheduled callbacks)
+     */
+    simTaskHandle_t getCurrentTask();
+
+    /**
+     * @brief Current virtual time in ticks, like xTaskGetTickCount() without the wrap
+     */
+    uint64_t getTickCount();
+
+    /**
+     * @brief Convert milliseconds to ticks, like pdMS_TO_TICKS()
+     */
+    uint32_t msToTicks(uint32_t ms);
+
+    /**
+     * @brief Process events until the virtual time passes now + ticks
+     * Events due exactly at the end run as well; the time is left at the end.
+     *
+     * @return uint64_t events processed
+     */
+    uint64_t runFor(uint64_t ticks);
+
+    /**
+     * @brief Process events until none is pending or the time limit is reached
+     *
+     * @param maxTicks - limit from now
+     * @return true if the kernel ran out of events
+     */
+    bool runUntilIdle(uint64_t maxTicks);
+
+    simStats_t getStats();
+};
+
+/**
+ * @brief Bounded FIFO between tasks and callbacks of a simKernel, like a FreeRTOS queue
+ *
+ * @tparam T - item type, copied in and out
+ */
+template <typename T> class simQueue
+{
+private:
+    simKernel&                  _kernel;
+    size_t                      _length;
+    std::deque<T>               _items;
+    std::deque<simTaskHandle_t> _receivers;
+    std::deque<simTaskHandle_t> _senders;
+
+    static void wakeFirst(simKernel& kernel, std::deque<simTaskHandle_t>& waiting)
+    {
+        if (!waiting.empty())
+        {
+            kernel.wake(waiting.front());
+            waiting.pop_front();
+        }
+    }
+
+    // Wait in a list; a task that timed out takes itself off so a later wakeFirst() does not hit it
+    void wait(std::deque<simTaskHandle_t>& waiting, uint64_t deadline, uint32_t timeoutTicks)
+    {
+        simTaskHandle_t task = _kernel.getCurrentTask();
+        uint64_t        now  = _kernel.getTickCount();
+        waiting.push_back(task);
+        _kernel.block((timeoutTicks == SIM_WAIT_FOREVER) ? SIM_WAIT_FOREVER : static_cast<uint32_t>(deadline - now));
+        for (auto it = waiting.begin(); it != waiting.end(); ++it)
+        {
+            if (*it == task)
+            {
+                waiting.erase(it);
+                break;
+            }
+        }
+    }
+
+public:
+    simQueue(simKernel& kernel, size_t length) : _kernel(kernel), _length(length) {}
+
+    /**
+     * @brief Append an item, like xQueueSend()
+     *
+     * @param item - item to copy in
+     * @param timeoutTicks - wait for space; must be 0 in kernel context
+     * @return true if queued
+     */
+    bool send(const T& item, uint32_t timeoutTicks = 0)
+    {
+        uint64_t deadline = _kernel.getTickCount() + timeoutTicks;
+        while (_items.size() >= _length)
+        {
+            uint64_t now = _kernel.getTickCount();
+            if (timeoutTicks == 0 || _kernel.getCurrentTask() < 0 || (timeoutTicks != SIM_WAIT_FOREVER && now >= deadline))
+            {
+                return false;
+            }
+            wait(_senders, deadline, timeoutTicks);
+        }
+        _items.push_back(item);
+        wakeFirst(_kernel, _receivers);
+        return true;
+    }
+
+    /**
+     * @brief Take the oldest item, like xQueueReceive()
+     *
+     * @param item - output
+     * @param timeoutTicks - wait for an item; must be 0 in kernel context
+     * @return true if an item was received
+     */
+    bool receive(T& item, uint32_t timeoutTicks = SIM_WAIT_FOREVER)
+    {
+        uint64_t deadline = _kernel.getTickCount() + timeoutTicks;
+        while (_items.empty())
+        {
+            uint64_t now = _kernel.getTickCount();
+            if (timeoutTicks == 0 || _kernel.getCurrentTask() < 0 || (timeoutTicks != SIM_WAIT_FOREVER && now >= deadline))
+            {
+                return false;
+            }
+            wait(_receivers, deadline, timeoutTicks);
+        }
+        item = _items.front();
+        _items.pop_front();
+        wakeFirst(_kernel, _senders);
+        return true;
+    }
+
+    size_t size()
+    {
+        return _items.size();
+    }
+};
+
+#endif /* SIMKERNEL_H */
@@ -0,0 +1,750 @@
+/**
+ * @file kvStore.cpp
+ * @brief Source file for kvStore
+ *
+ * This file contains definitions for the kvStore class and related data types and functions.
+ */
+
+#include "kvStore.h"
+#include "Library/Common/crc.h"
+
+#include <algorithm>
+#include <stddef.h>
+#include <string.h>
+
+namespace
+{
+constexpr uint32_t sectorMagic           = 0x3153564B; // "KVS1"
+constexpr uint32_t emptyAddress          = 0xFFFFFFFF;
+constexpr uint8_t  recordErased          = 0xFF;
+constexpr uint8_t  recordValue           = 0x5A;
+constexpr uint8_t  recordDeleted         = 0x3C;
+constexpr size_t   recordHeaderSize      = 12;
+constexpr size_t   recordAlignment       = 4;  // flash word size
+constexpr size_t   copyChunkSize         = 64; // stack buffer used for scans and copies
+constexpr size_t   backgroundFreeSectors = 2;  // compactStep() keeps one sector more than the reserve
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t sequence;
+    uint32_t crc;
+} sectorHeader_t;
+
+size_t recordSize(size_t keyLength, size_t valueLength)
+{
+    size_t size = recordHeaderSize + keyLength + valueLength;
+    return (size + recordAlignment - 1) & ~(recordAlignment - 1);
+}
+
+// FNV-1a
+uint32_t hashKey(const char* key, size_t length)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= static_cast<uint8_t>(key[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+size_t keyLengthOf(const char* key)
+{
+    return (key == nullptr) ? 0 : strnlen(key, kvStore::maxKeyLength + 1);
+}
+} // namespace
+
+kvStore::kvStore(IHAL_MEM& memory, size_t maxKeys)
+    : _memory(memory), _maxKeys(maxKeys), _keyCount(0), _sectorSize(0), _freeSectors(0), _headSector(0), _nextSequence(0), _stats(), _mounted(false)
+{
+    static_assert(sizeof(recordHeader_t) == recordHeaderSize, "record header layout is part of the storage format");
+
+    // Keep the load factor at or below 50% so probe sequences stay short
+    size_t capacity = 2;
+    while (capacity < maxKeys * 2)
+    {
+        capacity <<= 1;
+    }
+    _index.resize(capacity);
+}
+
+kvStore::~kvStore()
+{
+    // destructor implementation
+}
+
+sys_error_t kvStore::mount()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    RETURN_ON_ERROR(prepare());
+
+    std::vector<uint32_t> usedSectors;
+    for (uint32_t sector = 0; sector < _sectors.size(); sector++)
+    {
+        sectorHeader_t header;
+        if (!_memory.readData(sector * _sectorSize, reinterpret_cast<uint8_t*>(&header), sizeof(header)))
+        {
+            return ERROR_READ_FAILED;
+        }
+
+        if (header.magic == sectorMagic && header.crc == crc::crc32(&header, offsetof(sectorHeader_t, crc)))
+        {
+            _sectors[sector].used     = true;
+            _sectors[sector].sequence = header.sequence;
+            _nextSequence             = std::max(_nextSequence, header.sequence + 1);
+            _freeSectors--;
+            usedSectors.push_back(sector);
+        }
+        else if (!isSectorBlank(sector))
+        {
+            // Interrupted erase or foreign data, free sectors must be blank
+            if (!_memory.eraseSector(sector * _sectorSize))
+            {
+                return ERROR_WRITE_FAILED;
+            }
+            _stats.sectorErases++;
+        }
+    }
+
+    // Replay the log from the oldest to the newest sector, later records win
+    std::sort(usedSectors.begin(), usedSectors.end(), [this](uint32_t a, uint32_t b) { return _sectors[a].sequence < _sectors[b].sequence; });
+    for (uint32_t sector : usedSectors)
+    {
+        RETURN_ON_ERROR(replaySector(sector));
+    }
+
+    if (usedSectors.empty())
+    {
+        RETURN_ON_ERROR(openSector(0));
+    }
+    else
+    {
+        _headSector = usedSectors.back();
+    }
+
+    // A compaction was interrupted after it took the reserve sector, finish it
+    if (_freeSectors == 0)
+    {
+        RETURN_ON_ERROR(compactSector(usedSectors.front()));
+    }
+
+    _mounted = true;
+    return ERROR_SUCCESS;
+}
+
+sys_error_t kvStore::format()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    RETURN_ON_ERROR(prepare());
+
+    for (uint32_t sector = 0; sector < _sectors.size(); sector++)
+    {
+        if (!_memory.eraseSector(sector * _sectorSize))
+        {
+            return ERROR_WRITE_FAILED;
+        }
+        _stats.sectorErases++;
+    }
+
+    RETURN_ON_ERROR(openSector(0));
+    _mounted = true;
+    return ERROR_SUCCESS;
+}
+
+sys_error_t kvStore::put(const char* key, const void* value, size_t length)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    size_t keyLength = keyLengthOf(key);
+    if (keyLength == 0 || keyLength > maxKeyLength || (value == nullptr && length > 0))
+    {
+        return ERROR_INVALID_ARG;
+    }
+    if (!_mounted)
+    {
+        return ERROR_INIT_FAILED;
+    }
+
+    uint32_t hash = hashKey(key, keyLength);
+    size_t   slot = findSlot(key, keyLength, hash);
+    if (_index[slot].address != emptyAddress)
+    {
+        recordHeader_t header;
+        if (readHeader(_index[slot].address, header) && valueEquals(_index[slot].address, header, value, length))
+        {
+            return ERROR_SUCCESS; // spare the flash
+        }
+    }
+    else if (_keyCount >= _maxKeys)
+    {
+        return ERROR_OUT_OF_MEMORY;
+    }
+
+    uint32_t address;
+    RETURN_ON_ERROR(appendRecord(recordValue, key, keyLength, hash, value, length, address));
+
+    // Compaction may have moved the previous record
+    slot = findSlot(key, keyLength, hash);
+    if (_index[slot].address != emptyAddress)
+    {
+        releaseRecord(_index[slot].address);
+    }
+    else
+    {
+        _index[slot].hash = hash;
+        _keyCount++;
+    }
+    _index[slot].address = address;
+    _sectors[address / _sectorSize].liveBytes += recordSize(keyLength, length);
+
+    return ERROR_SUCCESS;
+}
+
+sys_error_t kvStore::get(const char* key, void* value, size_t maxLength, size_t& length)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    size_t keyLength = keyLengthOf(key);
+    if (keyLength == 0 || keyLength > maxKeyLength)
+    {
+        return ERROR_INVALID_ARG;
+    }
+    if (!_mounted)
+    {
+        return ERROR_INIT_FAILED;
+    }
+
+    size_t slot = findSlot(key, keyLength, hashKey(key, keyLength));
+    if (_index[slot].address == emptyAddress)
+    {
+        return ERROR_NOT_FOUND;
+    }
+
+    recordHeader_t header;
+    if (!readHeader(_index[slot].address, header))
+    {
+        return ERROR_READ_FAILED;
+    }
+
+    length = header.valueLength;
+    if (length > maxLength)
+    {
+        return ERROR_BUFFER_OVERFLOW;
+    }
+    if (length > 0 && (value == nullptr || !_memory.readData(_index[slot].address + sizeof(header) + keyLength, static_cast<uint8_t*>(value), length)))
+    {
+        return ERROR_READ_FAILED;
+    }
+    return ERROR_SUCCESS;
+}
+
+sys_error_t kvStore::remove(const char* key)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    size_t keyLength = keyLengthOf(key);
+    if (keyLength == 0 || keyLength > maxKeyLength)
+    {
+        return ERROR_INVALID_ARG;
+    }
+    if (!_mounted)
+    {
+        return ERROR_INIT_FAILED;
+    }
+
+    uint32_t hash = hashKey(key, keyLength);
+    if (_index[findSlot(key, keyLength, hash)].address == emptyAddress)
+    {
+        return ERROR_NOT_FOUND;
+    }
+
+    uint32_t address;
+    RETURN_ON_ERROR(appendRecord(recordDeleted, key, keyLength, hash, nullptr, 0, address));
+
+    size_t slot = findSlot(key, keyLength, hash);
+    releaseRecord(_index[slot].address);
+    removeSlot(slot);
+    _keyCount--;
+
+    return ERROR_SUCCESS;
+}
+
+bool kvStore::contains(const char* key)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    size_t keyLength = keyLengthOf(key);
+    if (!_mounted || keyLength == 0 || keyLength > maxKeyLength)
+    {
+        return false;
+    }
+    return _index[findSlot(key, keyLength, hashKey(key, keyLength))].address != emptyAddress;
+}
+
+bool kvStore::needsCompaction()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return isCompactionDue();
+}
+
+sys_error_t kvStore::compactStep()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!isCompactionDue())
+    {
+        return ERROR_SUCCESS;
+    }
+    return compactSector(oldestSector());
+}
+
+size_t kvStore::getKeyCount()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _keyCount;
+}
+
+kvStoreStats_t kvStore::getStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+sys_error_t kvStore::prepare()
+{
+    _mounted = false;
+    if (!_memory.initialize())
+    {
+        return ERROR_INIT_FAILED;
+    }
+
+    _sectorSize        = _memory.getSectorSize();
+    size_t sectorCount = (_sectorSize > 0) ? _memory.getSize() / _sectorSize : 0;
+    if (sectorCount < 2 || _sectorSize < sizeof(sectorHeader_t) + recordSize(maxKeyLength, 0))
+    {
+        return ERROR_INVALID_CONFIG;
+    }
+
+    indexEntry_t emptyEntry = {0, emptyAddress};
+    sectorInfo_t freeSector = {0, 0, 0, false};
+    std::fill(_index.begin(), _index.end(), emptyEntry);
+    _sectors.assign(sectorCount, freeSector);
+    _keyCount     = 0;
+    _freeSectors  = sectorCount;
+    _headSector   = 0;
+    _nextSequence = 0;
+    return ERROR_SUCCESS;
+}
+
+sys_error_t kvStore::replaySector(uint32_t sector)
+{
+    uint32_t base   = sector * _sectorSize;
+    uint32_t offset = sizeof(sectorHeader_t);
+
+    while (offset + sizeof(recordHeader_t) <= _sectorSize)
+    {
+        recordHeader_t header;
+        if (!readHeader(base + offset, header))
+        {
+            return ERROR_READ_FAILED;
+        }
+
+        static const recordHeader_t erasedHeader = {recordErased, 0xFF, 0xFFFF, 0xFFFFFFFF, 0xFFFFFFFF};
+        if (memcmp(&header, &erasedHeader, sizeof(header)) == 0)
+        {
+            break; // end of the log in this sector
+        }
+        if (!isHeaderSane(offset, header))
+        {
+            offset = _sectorSize; // torn header, the rest of the sector can't be trusted
+            break;
+        }
+
+        // Records with a bad CRC are torn writes, their length is known so they are simply skipped
+        if (isRecordValid(base + offset, header))
+        {
+            char key[maxKeyLength];
+            if (!_memory.readData(base + offset + sizeof(header), reinterpret_cast<uint8_t*>(key), header.keyLength))
+            {
+                return ERROR_READ_FAILED;
+            }
+            RETURN_ON_ERROR(applyRecord(base + offset, header, key));
+        }
+        offset += recordSize(header.keyLength, header.valueLength);
+    }
+
+    _sectors[sector].writeOffset = offset;
+    return ERROR_SUCCESS;
+}
+
+sys_error_t kvStore::applyRecord(uint32_t address, const recordHeader_t& header, const char* key)
+{
+    size_t slot   = findSlot(key, header.keyLength, header.keyHash);
+    bool   exists = _index[slot].address != emptyAddress;
+
+    if (exists)
+    {
+        releaseRecord(_index[slot].address);
+    }
+
+    if (header.type == recordDeleted)
+    {
+        if (exists)
+        {
+            removeSlot(slot);
+            _keyCount--;
+        }
+        return ERROR_SUCCESS;
+    }
+
+    if (!exists)
+    {
+        if (_keyCount >= _maxKeys)
+        {
+            return ERROR_OUT_OF_MEMORY;
+        }
+        _index[slot].hash = header.keyHash;
+        _keyCount++;
+    }
+    _index[slot].address = address;
+    _sectors[address / _sectorSize].liveBytes += recordSize(header.keyLength, header.valueLength);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t kvStore::appendRecord(uint8_t type, const char* key, size_t keyLength, uint32_t hash, const void* value, size_t valueLength, uint32_t& address)
+{
+    size_t size = recordSize(keyLength, valueLength);
+    if (valueLength > 0xFFFF || size > _sectorSize - sizeof(sectorHeader_t))
+    {
+        return ERROR_MESSAGE_TOO_LARGE;
+    }
+    RETURN_ON_ERROR(reserveSpace(size));
+
+    recordHeader_t header;
+    header.type        = type;
+    header.keyLength   = static_cast<uint8_t>(keyLength);
+    header.valueLength = static_cast<uint16_t>(valueLength);
+    header.keyHash     = hash;
+    header.crc         = crc::crc32(&header, offsetof(recordHeader_t, crc));
+    header.crc         = crc::crc32(key, keyLength, header.crc);
+    header.crc         = crc::crc32(value, valueLength, header.crc);
+
+    // The space is consumed even if the write fails, programmed flash can't be written twice
+    sectorInfo_t& head = _sectors[_headSector];
+    address            = _headSector * _sectorSize + head.writeOffset;
+    head.writeOffset += size;
+
+    // Header first: a torn key or value fails the CRC and the known length lets mount skip it
+    bool written = writeRaw(address, &header, sizeof(header)) && writeRaw(address + sizeof(header), key, keyLength);
+    if (written && valueLength > 0)
+    {
+        written = writeRaw(address + sizeof(header) + keyLength, value, valueLength);
+    }
+    _stats.userBytesWritten += keyLength + valueLength;
+
+    return written ? ERROR_SUCCESS : ERROR_WRITE_FAILED;
+}
+
+sys_error_t kvStore::reserveSpace(size_t size)
+{
+    // Every compaction erases one sector, give up once each sector had its turn
+    for (size_t attempt = 0; attempt <= _sectors.size(); attempt++)
+    {
+        if (_sectors[_headSector].writeOffset + size <= _sectorSize)
+        {
+            return ERROR_SUCCESS;
+        }
+        if (_freeSectors > 1)
+        {
+            return openSector(nextFreeSector());
+        }
+        RETURN_ON_ERROR(compactSector(oldestSector()));
+    }
+    return ERROR_OUT_OF_MEMORY;
+}
+
+sys_error_t kvStore::openSector(uint32_t sector)
+{
+    sectorHeader_t header;
+    header.magic    = sectorMagic;
+    header.sequence = _nextSequence;
+    header.crc      = crc::crc32(&header, offsetof(sectorHeader_t, crc));
+
+    if (!writeRaw(sector * _sectorSize, &header, sizeof(header)))
+    {
+        return ERROR_WRITE_FAILED;
+    }
+
+    _nextSequence++;
+    _sectors[sector].used        = true;
+    _sectors[sector].sequence    = header.sequence;
+    _sectors[sector].writeOffset = sizeof(header);
+    _sectors[sector].liveBytes   = 0;
+    _headSector                  = sector;
+    _freeSectors--;
+    return ERROR_SUCCESS;
+}
+
+sys_error_t kvStore::compactSector(uint32_t sector)
+{
+    // The head can't be copied into itself
+    if (sector == _headSector)
+    {
+        if (_freeSectors == 0)
+        {
+            return ERROR_OUT_OF_MEMORY;
+        }
+        RETURN_ON_ERROR(openSector(nextFreeSector()));
+    }
+
+    uint32_t base   = sector * _sectorSize;
+    uint32_t offset = sizeof(sectorHeader_t);
+    while (offset < _sectors[sector].writeOffset)
+    {
+        recordHeader_t header;
+        if (!readHeader(base + offset, header) || !isHeaderSane(offset, header))
+        {
+            break;
+        }
+        size_t size = recordSize(header.keyLength, header.valueLength);
+
+        // Only records the index still points at survive, tombstones die with the oldest sector
+        char key[maxKeyLength];
+        if (header.type == recordValue && _memory.readData(base + offset + sizeof(header), reinterpret_cast<uint8_t*>(key), header.keyLength))
+        {
+            size_t slot = findSlot(key, header.keyLength, header.keyHash);
+            if (_index[slot].address == base + offset)
+            {
+                if (_sectors[_headSector].writeOffset + size > _sectorSize)
+                {
+                    if (_freeSectors == 0)
+                    {
+                        return ERROR_OUT_OF_MEMORY;
+                    }
+                    RETURN_ON_ERROR(openSector(nextFreeSector()));
+                }
+
+                sectorInfo_t& head        = _sectors[_headSector];
+                uint32_t      destination = _headSector * _sectorSize + head.writeOffset;
+                head.writeOffset += size;
+                RETURN_ON_ERROR(copyRecord(base + offset, destination, size));
+                head.liveBytes += size;
+                _index[slot].address = destination;
+            }
+        }
+        offset += size;
+    }
+
+    if (!_memory.eraseSector(base))
+    {
+        return ERROR_WRITE_FAILED;
+    }
+    sectorInfo_t freeSector = {0, 0, 0, false};
+    _sectors[sector]        = freeSector;
+    _freeSectors++;
+    _stats.sectorErases++;
+    _stats.compactions++;
+    return ERROR_SUCCESS;
+}
+
+sys_error_t kvStore::copyRecord(uint32_t source, uint32_t destination, size_t size)
+{
+    uint8_t buffer[copyChunkSize];
+    for (size_t done = 0; done < size; done += sizeof(buffer))
+    {
+        size_t chunk = std::min(sizeof(buffer), size - done);
+        if (!_memory.readData(source + done, buffer, chunk))
+        {
+            return ERROR_READ_FAILED;
+        }
+        if (!writeRaw(destination + done, buffer, chunk))
+        {
+            return ERROR_WRITE_FAILED;
+        }
+    }
+    return ERROR_SUCCESS;
+}
+
+bool kvStore::readHeader(uint32_t address, recordHeader_t& header)
+{
+    return _memory.readData(address, reinterpret_cast<uint8_t*>(&header), sizeof(header));
+}
+
+bool kvStore::isHeaderSane(uint32_t offset, const recordHeader_t& header)
+{
+    return (header.type == recordValue || header.type == recordDeleted) && header.keyLength > 0 && header.keyLength <= maxKeyLength &&
+           offset + recordSize(header.keyLength, header.valueLength) <= _sectorSize;
+}
+
+bool kvStore::isRecordValid(uint32_t address, const recordHeader_t& header)
+{
+    uint32_t crc       = crc::crc32(&header, offsetof(recordHeader_t, crc));
+    size_t   remaining = header.keyLength + header.valueLength;
+    uint32_t position  = address + sizeof(header);
+
+    uint8_t buffer[copyChunkSize];
+    while (remaining > 0)
+    {
+        size_t chunk = std::min(sizeof(buffer), remaining);
+        if (!_memory.readData(position, buffer, chunk))
+        {
+            return false;
+        }
+        crc = crc::crc32(buffer, chunk, crc);
+        position += chunk;
+        remaining -= chunk;
+    }
+    return crc == header.crc;
+}
+
+bool kvStore::isSectorBlank(uint32_t sector)
+{
+    uint8_t buffer[copyChunkSize];
+    for (size_t offset = 0; offset < _sectorSize; offset += sizeof(buffer))
+    {
+        size_t chunk = std::min(sizeof(buffer), _sectorSize - offset);
+        if (!_memory.readData(sector * _sectorSize + offset, buffer, chunk))
+        {
+            return false;
+        }
+        for (size_t i = 0; i < chunk; i++)
+        {
+            if (buffer[i] != 0xFF)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool kvStore::isCompactionDue()
+{
+    if (!_mounted || _freeSectors > backgroundFreeSectors)
+    {
+        return false;
+    }
+    uint32_t oldest = oldestSector();
+    if (oldest == _headSector)
+    {
+        return false;
+    }
+    const sectorInfo_t& info = _sectors[oldest];
+    return info.writeOffset - sizeof(sectorHeader_t) > info.liveBytes;
+}
+
+bool kvStore::valueEquals(uint32_t address, const recordHeader_t& header, const void* value, size_t length)
+{
+    if (header.valueLength != length)
+    {
+        return false;
+    }
+
+    const uint8_t* expected = static_cast<const uint8_t*>(value);
+    uint32_t       position = address + sizeof(header) + header.keyLength;
+
+    uint8_t buffer[copyChunkSize];
+    for (size_t done = 0; done < length; done += sizeof(buffer))
+    {
+        size_t chunk = std::min(sizeof(buffer), length - done);
+        if (!_memory.readData(position + done, buffer, chunk) || memcmp(buffer, expected + done, chunk) != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t kvStore::nextFreeSector()
+{
+    // Round-robin after the head, so erase cycles are spread over all sectors
+    for (uint32_t i = 1; i <= _sectors.size(); i++)
+    {
+        uint32_t sector = (_headSector + i) % _sectors.size();
+        if (!_sectors[sector].used)
+        {
+            return sector;
+        }
+    }
+    return _headSector;
+}
+
+uint32_t kvStore::oldestSector()
+{
+    uint32_t oldest = _headSector;
+    for (uint32_t sector = 0; sector < _sectors.size(); sector++)
+    {
+        if (_sectors[sector].used && _sectors[sector].sequence < _sectors[oldest].sequence)
+        {
+            oldest = sector;
+        }
+    }
+    return oldest;
+}
+
+size_t kvStore::findSlot(const char* key, size_t keyLength, uint32_t hash)
+{
+    size_t mask = _index.size() - 1;
+    size_t slot = hash & mask;
+
+    // Linear probing, the table is never more than half full
+    while (_index[slot].address != emptyAddress)
+    {
+        if (_index[slot].hash == hash)
+        {
+            recordHeader_t header;
+            char           storedKey[maxKeyLength];
+            uint32_t       address = _index[slot].address;
+            if (readHeader(address, header) && header.keyLength == keyLength && _memory.readData(address + sizeof(header), reinterpret_cast<uint8_t*>(storedKey), keyLength) &&
+                memcmp(storedKey, key, keyLength) == 0)
+            {
+                return slot;
+            }
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void kvStore::removeSlot(size_t slot)
+{
+    size_t mask = _index.size() - 1;
+
+    // Backward shift deletion keeps probe sequences intact without tombstones
+    for (;;)
+    {
+        _index[slot].address = emptyAddress;
+        size_t next          = slot;
+        for (;;)
+        {
+            next = (next + 1) & mask;
+            if (_index[next].address == emptyAddress)
+            {
+                return;
+            }
+            size_t home = _index[next].hash & mask;
+            bool   stay = (slot <= next) ? (slot < home && home <= next) : (slot < home || home <= next);
+            if (!stay)
+            {
+                break;
+            }
+        }
+        _index[slot] = _index[next];
+        slot         = next;
+    }
+}
+
+void kvStore::releaseRecord(uint32_t address)
+{
+    recordHeader_t header;
+    if (readHeader(address, header))
+    {
+        _sectors[address / _sectorSize].liveBytes -= recordSize(header.keyLength, header.valueLength);
+    }
+}
+
+bool kvStore::writeRaw(uint32_t address, const void* data, size_t length)
+{
+    _stats.flashBytesWritten += length;
+    return _memory.writeData(address, static_cast<const uint8_t*>(data), length);
+}
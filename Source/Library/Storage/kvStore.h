@@ -0,0 +1,195 @@
+/**
+ * @file kvStore.h
+ * @brief Header file for kvStore
+ *
+ * This file contains declarations for the kvStore class and related data types and functions.
+ */
+#ifndef KVSTORE_H
+#define KVSTORE_H
+
+#include "HAL/IHal.h"
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Write and wear counters of a kvStore
+ * Write amplification is flashBytesWritten / userBytesWritten.
+ */
+typedef struct
+{
+    uint32_t userBytesWritten;  // key and value bytes passed to put()/remove()
+    uint32_t flashBytesWritten; // bytes written to the memory device, headers and compaction copies included
+    uint32_t sectorErases;      // number of erased sectors
+    uint32_t compactions;       // number of compacted sectors
+} kvStoreStats_t;
+
+/**
+ * @brief Log-structured key/value store on top of an IHAL_MEM device
+ *
+ * Records are only ever appended, each one carries a CRC over its header, key and value.
+ * Sectors are filled round-robin and the oldest sector is compacted into the head of the log,
+ * so every sector sees the same number of erase cycles. One sector is always kept free for compaction.
+ * An in-RAM open addressing hash index maps each key to its latest record for O(1) lookups.
+ *
+ * All public methods are thread safe. compactStep() is meant to be called from a low priority task,
+ * so that put() rarely has to compact synchronously.
+ */
+class kvStore
+{
+public:
+    static constexpr size_t maxKeyLength = 32;
+
+private:
+    typedef struct
+    {
+        uint32_t hash;
+        uint32_t address; // address of the latest record of the key
+    } indexEntry_t;
+
+    typedef struct
+    {
+        uint32_t sequence;    // position of the sector in the log
+        uint32_t writeOffset; // first free byte inside the sector
+        uint32_t liveBytes;   // bytes of records that are still referenced by the index
+        bool     used;
+    } sectorInfo_t;
+
+    typedef struct
+    {
+        uint8_t  type;
+        uint8_t  keyLength;
+        uint16_t valueLength;
+        uint32_t keyHash;
+        uint32_t crc; // covers the fields above, the key and the value
+    } recordHeader_t;
+
+    IHAL_MEM&                 _memory;
+    std::vector<indexEntry_t> _index;
+    std::vector<sectorInfo_t> _sectors;
+    size_t                    _maxKeys;
+    size_t                    _keyCount;
+    size_t                    _sectorSize;
+    size_t                    _freeSectors;
+    uint32_t                  _headSector;
+    uint32_t                  _nextSequence;
+    kvStoreStats_t            _stats;
+    bool                      _mounted;
+    std::mutex                _mutex;
+
+    sys_error_t replaySector(uint32_t sector);
+    sys_error_t applyRecord(uint32_t address, const recordHeader_t& header, const char* key);
+    sys_error_t appendRecord(uint8_t type, const char* key, size_t keyLength, uint32_t hash, const void* value, size_t valueLength, uint32_t& address);
+    sys_error_t reserveSpace(size_t size);
+    sys_error_t openSector(uint32_t sector);
+    sys_error_t compactSector(uint32_t sector);
+    sys_error_t copyRecord(uint32_t source, uint32_t destination, size_t size);
+    bool        readHeader(uint32_t address, recordHeader_t& header);
+    bool        isHeaderSane(uint32_t offset, const recordHeader_t& header);
+    bool        isRecordValid(uint32_t address, const recordHeader_t& header);
+    bool        isSectorBlank(uint32_t sector);
+    bool        isCompactionDue();
+    bool        valueEquals(uint32_t address, const recordHeader_t& header, const void* value, size_t length);
+    uint32_t    nextFreeSector();
+    uint32_t    oldestSector();
+    size_t      findSlot(const char* key, size_t keyLength, uint32_t hash);
+    void        removeSlot(size_t slot);
+    void        releaseRecord(uint32_t address);
+    bool        writeRaw(uint32_t address, const void* data, size_t length);
+    sys_error_t prepare();
+
+public:
+    /**
+     * @brief Construct a new kvStore object
+     *
+     * @param memory - memory device, needs at least two sectors
+     * @param maxKeys - maximum number of keys, sizes the RAM index (default 64)
+     */
+    kvStore(IHAL_MEM& memory, size_t maxKeys = 64);
+    ~kvStore();
+
+    // Delete copy constructor and assignment operator
+    kvStore(const kvStore&)            = delete;
+    kvStore& operator=(const kvStore&) = delete;
+
+    /**
+     * @brief Scan the memory device and rebuild the index
+     * Blank or unreadable sectors are erased, a blank device is formatted.
+     *
+     * @return sys_error_t
+     */
+    sys_error_t mount();
+
+    /**
+     * @brief Erase every sector and drop all keys
+     *
+     * @return sys_error_t
+     */
+    sys_error_t format();
+
+    /**
+     * @brief Store a value, nothing is written if the key already holds the same value
+     *
+     * @param key - null terminated key, at most maxKeyLength characters
+     * @param value - value data
+     * @param length - value length in bytes
+     * @return sys_error_t
+     */
+    sys_error_t put(const char* key, const void* value, size_t length);
+
+    /**
+     * @brief Read a value
+     *
+     * @param key - null terminated key
+     * @param value - buffer for the value
+     * @param maxLength - size of the buffer
+     * @param length - set to the stored value length, also when the buffer is too small
+     * @return sys_error_t ERROR_NOT_FOUND if the key does not exist, ERROR_BUFFER_OVERFLOW if the buffer is too small
+     */
+    sys_error_t get(const char* key, void* value, size_t maxLength, size_t& length);
+
+    /**
+     * @brief Delete a key
+     *
+     * @param key - null terminated key
+     * @return sys_error_t ERROR_NOT_FOUND if the key does not exist
+     */
+    sys_error_t remove(const char* key);
+
+    /**
+     * @brief Check if a key exists
+     *
+     * @param key - null terminated key
+     * @return bool
+     */
+    bool contains(const char* key);
+
+    /**
+     * @brief Check if the free sector pool is low and the oldest sector holds garbage
+     *
+     * @return bool
+     */
+    bool needsCompaction();
+
+    /**
+     * @brief Compact the oldest sector if needsCompaction() is true
+     *
+     * @return sys_error_t
+     */
+    sys_error_t compactStep();
+
+    /**
+     * @brief Get the number of stored keys
+     *
+     * @return size_t
+     */
+    size_t getKeyCount();
+
+    /**
+     * @brief Get the write and wear counters
+     *
+     * @return kvStoreStats_t
+     */
+    kvStoreStats_t getStats();
+};
+
+#endif /* KVSTORE_H */
@@ -0,0 +1,1030 @@
+/**
+ * @file logStore.cpp
+ * @brief Source file for logStore
+ *
+ * This file contains definitions for the logStore class and related data types and functions.
+ */
+
+#include "logStore.h"
+#include "Library/Common/crc.h"
+
+#include <algorithm>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#if defined(ESP_PLATFORM)
+#include "esp_timer.h"
+#else
+#include <chrono>
+#endif
+
+namespace
+{
+constexpr uint8_t  entryDefine      = 0x01; // varint id, varint length, string
+constexpr uint8_t  entryFormat      = 0x02; // level, varint time, tag, format, arguments
+constexpr uint8_t  entryText        = 0x03; // level, varint time, tag, text
+constexpr uint8_t  blockCompressed  = 0x01;
+constexpr uint16_t blockErased      = 0xFFFF;
+constexpr size_t   tagSize          = 32; // longest tag, longer ones are cut
+constexpr size_t   decodeLineSize   = 512;
+constexpr char     levelLetters[]   = {'I', 'W', 'E'}; // indexed by ILog::LogLevel
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t sequence;
+    uint32_t segmentSize;
+    uint32_t crc;
+} segmentHeader_t;
+
+typedef struct
+{
+    uint16_t storedLength; // data bytes following the header
+    uint16_t rawLength;    // record bytes after decompression
+    uint8_t  flags;
+    uint8_t  reserved;
+    uint16_t crc; // CRC-16 of the fields above and the data
+} blockHeader_t;
+
+constexpr size_t blockOverhead = sizeof(blockHeader_t);
+
+// Length modifiers of a conversion, they decide the argument type
+typedef enum : uint8_t
+{
+    LENGTH_NONE,
+    LENGTH_HH,
+    LENGTH_H,
+    LENGTH_L,
+    LENGTH_LL,
+    LENGTH_Z,
+    LENGTH_J,
+    LENGTH_T,
+    LENGTH_LONG_DOUBLE,
+} lengthModifier_t;
+
+typedef enum : uint8_t
+{
+    ARG_NONE,     // %% or an unsupported conversion, which ends the argument list
+    ARG_SIGNED,   // d i c
+    ARG_UNSIGNED, // u o x X
+    ARG_POINTER,  // p
+    ARG_DOUBLE,   // f F e E g G a A
+    ARG_STRING,   // s
+} argKind_t;
+
+typedef struct
+{
+    const char*      begin; // the '%'
+    const char*      end;   // after the conversion character
+    bool             starWidth;
+    bool             starPrecision;
+    lengthModifier_t length;
+    argKind_t        kind;
+} conversion_t;
+
+#if defined(ESP_PLATFORM)
+inline uint32_t nowMs()
+{
+    return static_cast<uint32_t>(esp_timer_get_time() / 1000);
+}
+#else
+inline uint32_t nowMs()
+{
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+}
+#endif
+
+// FNV-1a
+uint32_t hashString(const char* text, size_t length)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= static_cast<uint8_t>(text[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool putByte(uint8_t* buffer, size_t& used, size_t size, uint8_t value)
+{
+    if (used >= size)
+    {
+        return false;
+    }
+    buffer[used++] = value;
+    return true;
+}
+
+// LEB128
+bool putVarint(uint8_t* buffer, size_t& used, size_t size, uint64_t value)
+{
+    do
+    {
+        uint8_t byte = static_cast<uint8_t>(value & 0x7F);
+        value >>= 7;
+        if (!putByte(buffer, used, size, (value != 0) ? (byte | 0x80) : byte))
+        {
+            return false;
+        }
+    } while (value != 0);
+    return true;
+}
+
+bool putSigned(uint8_t* buffer, size_t& used, size_t size, int64_t value)
+{
+    return putVarint(buffer, used, size, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+bool putBytes(uint8_t* buffer, size_t& used, size_t size, const void* data, size_t length)
+{
+    if (used + length > size)
+    {
+        return false;
+    }
+    memcpy(buffer + used, data, length);
+    used += length;
+    return true;
+}
+
+bool getVarint(const uint8_t* buffer, size_t size, size_t& read, uint64_t& value)
+{
+    value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+        if (read >= size)
+        {
+            return false;
+        }
+        uint8_t byte = buffer[read++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool getSigned(const uint8_t* buffer, size_t size, size_t& read, int64_t& value)
+{
+    uint64_t raw = 0;
+    if (!getVarint(buffer, size, read, raw))
+    {
+        return false;
+    }
+    value = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+    return true;
+}
+
+/**
+ * @brief Find the next conversion of a format, the same walk is done while encoding and decoding
+ *
+ * @return bool false at the end of the format
+ */
+bool nextConversion(const char*& position, const char* end, conversion_t& conversion)
+{
+    const char* percent = static_cast<const char*>(memchr(position, '%', end - position));
+    if (percent == nullptr || percent + 1 >= end)
+    {
+        position = end;
+        return false;
+    }
+
+    const char* p            = percent + 1;
+    conversion               = {};
+    conversion.begin         = percent;
+    while (p < end && strchr("-+ #0'", *p) != nullptr)
+    {
+        p++;
+    }
+    if (p < end && *p == '*')
+    {
+        conversion.starWidth = true;
+        p++;
+    }
+    while (p < end && *p >= '0' && *p <= '9')
+    {
+        p++;
+    }
+    if (p < end && *p == '.')
+    {
+        p++;
+        if (p < end && *p == '*')
+        {
+            conversion.starPrecision = true;
+            p++;
+        }
+        while (p < end && *p >= '0' && *p <= '9')
+        {
+            p++;
+        }
+    }
+
+    conversion.length = LENGTH_NONE;
+    if (p + 1 < end && p[0] == 'h' && p[1] == 'h')
+    {
+        conversion.length = LENGTH_HH;
+        p += 2;
+    }
+    else if (p + 1 < end && p[0] == 'l' && p[1] == 'l')
+    {
+        conversion.length = LENGTH_LL;
+        p += 2;
+    }
+    else if (p < end && strchr("hlzjtL", *p) != nullptr)
+    {
+        conversion.length = (*p == 'h') ? LENGTH_H : (*p == 'l') ? LENGTH_L : (*p == 'z') ? LENGTH_Z : (*p == 'j') ? LENGTH_J : (*p == 't') ? LENGTH_T : LENGTH_LONG_DOUBLE;
+        p++;
+    }
+
+    char type       = (p < end) ? *p : '\0';
+    conversion.kind = (type != '\0' && strchr("dic", type) != nullptr)        ? ARG_SIGNED
+                      : (type != '\0' && strchr("uoxX", type) != nullptr)     ? ARG_UNSIGNED
+                      : (type == 'p')                                         ? ARG_POINTER
+                      : (type != '\0' && strchr("fFeEgGaA", type) != nullptr) ? ARG_DOUBLE
+                      : (type == 's')                                         ? ARG_STRING
+                                                                              : ARG_NONE;
+    conversion.end  = (p < end) ? p + 1 : end;
+    position        = conversion.end;
+    return true;
+}
+
+// Encode the arguments of a format, false if they do not fit
+bool encodeArguments(const char* format, size_t length, va_list args, uint8_t* buffer, size_t& used, size_t size)
+{
+    const char*  position = format;
+    const char*  end      = format + length;
+    conversion_t conversion;
+    while (nextConversion(position, end, conversion))
+    {
+        if (conversion.kind == ARG_NONE)
+        {
+            if (conversion.end[-1] == '%')
+            {
+                continue;
+            }
+            return true;
+        }
+        if (conversion.starWidth && !putSigned(buffer, used, size, va_arg(args, int)))
+        {
+            return false;
+        }
+        if (conversion.starPrecision && !putSigned(buffer, used, size, va_arg(args, int)))
+        {
+            return false;
+        }
+
+        bool ok = true;
+        switch (conversion.kind)
+        {
+            case ARG_SIGNED:
+            {
+                int64_t value = (conversion.length == LENGTH_L)    ? va_arg(args, long)
+                                : (conversion.length == LENGTH_LL) ? va_arg(args, long long)
+                                : (conversion.length == LENGTH_Z)  ? static_cast<int64_t>(va_arg(args, size_t))
+                                : (conversion.length == LENGTH_J)  ? va_arg(args, intmax_t)
+                                : (conversion.length == LENGTH_T)  ? va_arg(args, ptrdiff_t)
+                                                                   : va_arg(args, int);
+                ok = putSigned(buffer, used, size, value);
+            }
+            break;
+
+            case ARG_UNSIGNED:
+            {
+                uint64_t value = (conversion.length == LENGTH_L)    ? va_arg(args, unsigned long)
+                                 : (conversion.length == LENGTH_LL) ? va_arg(args, unsigned long long)
+                                 : (conversion.length == LENGTH_Z)  ? va_arg(args, size_t)
+                                 : (conversion.length == LENGTH_J)  ? va_arg(args, uintmax_t)
+                                 : (conversion.length == LENGTH_T)  ? static_cast<uint64_t>(va_arg(args, ptrdiff_t))
+                                                                    : va_arg(args, unsigned int);
+                ok = putVarint(buffer, used, size, value);
+            }
+            break;
+
+            case ARG_POINTER:
+                ok = putVarint(buffer, used, size, reinterpret_cast<uintptr_t>(va_arg(args, void*)));
+                break;
+
+            case ARG_DOUBLE:
+            {
+                double value = (conversion.length == LENGTH_LONG_DOUBLE) ? static_cast<double>(va_arg(args, long double)) : va_arg(args, double);
+                ok           = putBytes(buffer, used, size, &value, sizeof(value));
+            }
+            break;
+
+            case ARG_STRING:
+            {
+                const char* text       = va_arg(args, const char*);
+                text                   = (text != nullptr) ? text : "(null)";
+                size_t      textLength = strnlen(text, LOG_STORE_STRING_SIZE);
+                ok                     = putVarint(buffer, used, size, textLength) && putBytes(buffer, used, size, text, textLength);
+            }
+            break;
+
+            default:
+                break;
+        }
+        if (!ok)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Rebuild the text of a format record, false if the arguments are malformed
+bool formatArguments(const std::string& format, const uint8_t* buffer, size_t size, size_t& read, std::string& text)
+{
+    const char*  position = format.data();
+    const char*  end      = format.data() + format.size();
+    conversion_t conversion;
+    char         piece[LOG_STORE_STRING_SIZE + 64];
+
+    while (true)
+    {
+        const char* start = position;
+        bool        found = nextConversion(position, end, conversion);
+        text.append(start, found ? conversion.begin - start : end - start);
+        if (!found)
+        {
+            return true;
+        }
+        if (conversion.kind == ARG_NONE)
+        {
+            if (conversion.end[-1] == '%')
+            {
+                text.push_back('%');
+                continue;
+            }
+            // Unsupported conversion, the encoder stopped here as well
+            text.append(conversion.begin, end - conversion.begin);
+            return true;
+        }
+
+        // Replace * by the stored width and precision
+        std::string spec;
+        for (const char* p = conversion.begin; p < conversion.end; p++)
+        {
+            if (*p != '*')
+            {
+                spec.push_back(*p);
+                continue;
+            }
+            int64_t value = 0;
+            if (!getSigned(buffer, size, read, value))
+            {
+                return false;
+            }
+            spec += std::to_string(value);
+        }
+
+        int written = 0;
+        switch (conversion.kind)
+        {
+            case ARG_SIGNED:
+            {
+                int64_t value = 0;
+                if (!getSigned(buffer, size, read, value))
+                {
+                    return false;
+                }
+                written = (conversion.length == LENGTH_L)    ? snprintf(piece, sizeof(piece), spec.c_str(), static_cast<long>(value))
+                          : (conversion.length == LENGTH_LL) ? snprintf(piece, sizeof(piece), spec.c_str(), static_cast<long long>(value))
+                          : (conversion.length == LENGTH_Z)  ? snprintf(piece, sizeof(piece), spec.c_str(), static_cast<size_t>(value))
+                          : (conversion.length == LENGTH_J)  ? snprintf(piece, sizeof(piece), spec.c_str(), static_cast<intmax_t>(value))
+                          : (conversion.length == LENGTH_T)  ? snprintf(piece, sizeof(piece), spec.c_str(), static_cast<ptrdiff_t>(value))
+                                                             : snprintf(piece, sizeof(piece), spec.c_str(), static_cast<int>(value));
+            }
+            break;
+
+            case ARG_UNSIGNED:
+            {
+                uint64_t value = 0;
+                if (!getVarint(buffer, size, read, value))
+                {
+                    return false;
+                }
+                written = (conversion.length == LENGTH_L)    ? snprintf(piece, sizeof(piece), spec.c_str(), static_cast<unsigned long>(value))
+                          : (conversion.length == LENGTH_LL) ? snprintf(piece, sizeof(piece), spec.c_str(), static_cast<unsigned long long>(value))
+                          : (conversion.length == LENGTH_Z)  ? snprintf(piece, sizeof(piece), spec.c_str(), static_cast<size_t>(value))
+                          : (conversion.length == LENGTH_J)  ? snprintf(piece, sizeof(piece), spec.c_str(), static_cast<uintmax_t>(value))
+                          : (conversion.length == LENGTH_T)  ? snprintf(piece, sizeof(piece), spec.c_str(), static_cast<ptrdiff_t>(value))
+                                                             : snprintf(piece, sizeof(piece), spec.c_str(), static_cast<unsigned int>(value));
+            }
+            break;
+
+            case ARG_POINTER:
+            {
+                uint64_t value = 0;
+                if (!getVarint(buffer, size, read, value))
+                {
+                    return false;
+                }
+                written = snprintf(piece, sizeof(piece), "0x%llx", static_cast<unsigned long long>(value));
+            }
+            break;
+
+            case ARG_DOUBLE:
+            {
+                double value = 0.0;
+                if (read + sizeof(value) > size)
+                {
+                    return false;
+                }
+                memcpy(&value, buffer + read, sizeof(value));
+                read += sizeof(value);
+                if (conversion.length == LENGTH_LONG_DOUBLE)
+                {
+                    written = snprintf(piece, sizeof(piece), spec.c_str(), static_cast<long double>(value));
+                }
+                else
+                {
+                    written = snprintf(piece, sizeof(piece), spec.c_str(), value);
+                }
+            }
+            break;
+
+            case ARG_STRING:
+            {
+                uint64_t length = 0;
+                if (!getVarint(buffer, size, read, length) || read + length > size)
+                {
+                    return false;
+                }
+                std::string value(reinterpret_cast<const char*>(buffer + read), static_cast<size_t>(length));
+                read += static_cast<size_t>(length);
+                written = snprintf(piece, sizeof(piece), spec.c_str(), value.c_str());
+            }
+            break;
+
+            default:
+                break;
+        }
+        if (written > 0)
+        {
+            text.append(piece, std::min(static_cast<size_t>(written), sizeof(piece) - 1));
+        }
+    }
+}
+
+// Dictionary reference: id + 1, or 0 followed by an inline string
+bool getString(const uint8_t* buffer, size_t size, size_t& read, const std::vector<std::string>& dictionary, std::string& text)
+{
+    uint64_t reference = 0;
+    if (!getVarint(buffer, size, read, reference))
+    {
+        return false;
+    }
+    if (reference != 0)
+    {
+        if (reference > dictionary.size())
+        {
+            return false;
+        }
+        text = dictionary[static_cast<size_t>(reference - 1)];
+        return true;
+    }
+    uint64_t length = 0;
+    if (!getVarint(buffer, size, read, length) || read + length > size)
+    {
+        return false;
+    }
+    text.assign(reinterpret_cast<const char*>(buffer + read), static_cast<size_t>(length));
+    read += static_cast<size_t>(length);
+    return true;
+}
+
+// Decode the entries of one block into lines
+bool decodeBlock(const uint8_t* buffer, size_t size, std::vector<std::string>& dictionary, const logStoreWriter_t& writer, bool& aborted)
+{
+    size_t read = 0;
+    while (read < size)
+    {
+        uint8_t type = buffer[read++];
+        if (type == entryDefine)
+        {
+            uint64_t id     = 0;
+            uint64_t length = 0;
+            if (!getVarint(buffer, size, read, id) || id >= LOG_STORE_DICT_ENTRIES || !getVarint(buffer, size, read, length) || read + length > size)
+            {
+                return false;
+            }
+            dictionary[static_cast<size_t>(id)].assign(reinterpret_cast<const char*>(buffer + read), static_cast<size_t>(length));
+            read += static_cast<size_t>(length);
+            continue;
+        }
+        if ((type != entryFormat && type != entryText) || read >= size)
+        {
+            return false;
+        }
+
+        uint8_t     level  = buffer[read++];
+        uint64_t    timeMs = 0;
+        std::string tag;
+        std::string text;
+        if (!getVarint(buffer, size, read, timeMs) || !getString(buffer, size, read, dictionary, tag) || !getString(buffer, size, read, dictionary, text))
+        {
+            return false;
+        }
+        if (type == entryFormat)
+        {
+            std::string format = text;
+            text.clear();
+            if (!formatArguments(format, buffer, size, read, text))
+            {
+                return false;
+            }
+        }
+
+        char        prefix[64];
+        int         length = snprintf(prefix, sizeof(prefix), "%c (%llu) ", (level < sizeof(levelLetters)) ? levelLetters[level] : '?', static_cast<unsigned long long>(timeMs));
+        std::string line   = std::string(prefix, static_cast<size_t>(length)) + tag + ": " + text + "\n";
+        if (!writer(line.c_str(), line.size()))
+        {
+            aborted = true;
+            return true;
+        }
+    }
+    return true;
+}
+} // namespace
+
+logStore::logStore(IHAL_MEM& memory, uint32_t baseAddress, size_t segmentSize, size_t segmentCount)
+    : _memory(memory), _baseAddress(baseAddress), _segmentSize(segmentSize), _segmentCount(segmentCount), _segment(0), _sequence(0), _writeOffset(0), _rotate(true), _mounted(false),
+      _blockUsed(0), _blockRecords(0), _dictCount(0), _stringsUsed(0), _stats()
+{
+    static_assert(sizeof(segmentHeader_t) == 16 && sizeof(blockHeader_t) == 8, "header layouts are part of the storage format");
+}
+
+logStore::~logStore()
+{
+    // destructor implementation
+}
+
+sys_error_t logStore::mount()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    RETURN_ON_ERROR(prepare());
+
+    // The newest segment is continued
+    bool found = false;
+    for (uint32_t segment = 0; segment < _segmentCount; segment++)
+    {
+        segmentHeader_t header;
+        if (!_memory.readData(segmentAddress(segment), reinterpret_cast<uint8_t*>(&header), sizeof(header)))
+        {
+            return ERROR_READ_FAILED;
+        }
+        if (header.magic == LOG_STORE_MAGIC && header.segmentSize == _segmentSize && header.crc == crc::crc32(&header, offsetof(segmentHeader_t, crc)) &&
+            (!found || header.sequence > _sequence))
+        {
+            found     = true;
+            _segment  = segment;
+            _sequence = header.sequence;
+        }
+    }
+
+    if (!found)
+    {
+        _segment  = static_cast<uint32_t>(_segmentCount - 1); // the first segment written is segment 0
+        _sequence = 0;
+        _mounted  = true;
+        return ERROR_SUCCESS;
+    }
+
+    // Skip the blocks written so far, a header that does not make sense ends the segment
+    size_t offset = sizeof(segmentHeader_t);
+    while (offset + blockOverhead <= _segmentSize)
+    {
+        blockHeader_t header;
+        if (!_memory.readData(segmentAddress(_segment) + offset, reinterpret_cast<uint8_t*>(&header), sizeof(header)))
+        {
+            return ERROR_READ_FAILED;
+        }
+        if (header.storedLength == blockErased && header.rawLength == blockErased)
+        {
+            // Ids are given out again from 0, the decoder takes the latest definition of an id
+            _writeOffset = offset;
+            _rotate      = false;
+            break;
+        }
+        if (header.storedLength > LOG_STORE_BLOCK_SIZE || offset + blockOverhead + header.storedLength > _segmentSize)
+        {
+            break;
+        }
+        offset += blockOverhead + header.storedLength;
+    }
+    _mounted = true;
+    return ERROR_SUCCESS;
+}
+
+sys_error_t logStore::format()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    RETURN_ON_ERROR(prepare());
+
+    size_t sectorSize = _memory.getSectorSize();
+    for (size_t offset = 0; offset < _segmentSize * _segmentCount; offset += sectorSize)
+    {
+        if (!_memory.eraseSector(static_cast<uint32_t>(_baseAddress + offset)))
+        {
+            return ERROR_WRITE_FAILED;
+        }
+    }
+    _segment  = static_cast<uint32_t>(_segmentCount - 1);
+    _sequence = 0;
+    _mounted  = true;
+    return ERROR_SUCCESS;
+}
+
+sys_error_t logStore::log(uint8_t level, const char* tag, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    sys_error_t result = logV(level, tag, format, args);
+    va_end(args);
+    return result;
+}
+
+sys_error_t logStore::logV(uint8_t level, const char* tag, const char* format, va_list args)
+{
+    va_list copy;
+    va_copy(copy, args);
+    sys_error_t result = record(entryFormat, level, tag, nullptr, 0, format, &copy);
+    va_end(copy);
+    return result;
+}
+
+sys_error_t logStore::logText(uint8_t level, const char* tag, const char* text, size_t length)
+{
+    return record(entryText, level, tag, text, length, nullptr, nullptr);
+}
+
+sys_error_t logStore::flush()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_mounted)
+    {
+        return ERROR_INIT_FAILED;
+    }
+    return writeBlock();
+}
+
+logStoreStats_t logStore::getStats()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+sys_error_t logStore::decode(const logStoreWriter_t& writer)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_mounted)
+    {
+        return ERROR_INIT_FAILED;
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> segments; // sequence, segment
+    for (uint32_t segment = 0; segment < _segmentCount; segment++)
+    {
+        segmentHeader_t header;
+        if (_memory.readData(segmentAddress(segment), reinterpret_cast<uint8_t*>(&header), sizeof(header)) && header.magic == LOG_STORE_MAGIC &&
+            header.segmentSize == _segmentSize && header.crc == crc::crc32(&header, offsetof(segmentHeader_t, crc)))
+        {
+            segments.push_back(std::make_pair(header.sequence, segment));
+        }
+    }
+    std::sort(segments.begin(), segments.end());
+
+    sys_error_t result = ERROR_SUCCESS;
+    uint8_t     stored[LOG_STORE_BLOCK_SIZE];
+    uint8_t     raw[LOG_STORE_BLOCK_SIZE];
+    for (const std::pair<uint32_t, uint32_t>& segment : segments)
+    {
+        std::vector<std::string> dictionary(LOG_STORE_DICT_ENTRIES);
+        uint32_t                 address = segmentAddress(segment.second);
+        size_t                   offset  = sizeof(segmentHeader_t);
+        while (offset + blockOverhead <= _segmentSize)
+        {
+            blockHeader_t header;
+            if (!_memory.readData(address + offset, reinterpret_cast<uint8_t*>(&header), sizeof(header)) || (header.storedLength == blockErased && header.rawLength == blockErased))
+            {
+                break;
+            }
+            if (header.storedLength > LOG_STORE_BLOCK_SIZE || header.rawLength > LOG_STORE_BLOCK_SIZE || offset + blockOverhead + header.storedLength > _segmentSize)
+            {
+                result = ERROR_DATA_CORRUPTED;
+                break;
+            }
+            offset += blockOverhead + header.storedLength;
+
+            // A block torn by a reset is left out, the next one starts after its stored length
+            if (!_memory.readData(address + offset - header.storedLength, stored, header.storedLength) ||
+                header.crc != crc::crc16(stored, header.storedLength, crc::crc16(&header, offsetof(blockHeader_t, crc))))
+            {
+                result = ERROR_DATA_CORRUPTED;
+                continue;
+            }
+            const uint8_t* data   = stored;
+            size_t         length = header.storedLength;
+            if ((header.flags & blockCompressed) != 0)
+            {
+                length = lz::decompress(stored, header.storedLength, raw, sizeof(raw));
+                data   = raw;
+            }
+            bool aborted = false;
+            if (length != header.rawLength || !decodeBlock(data, length, dictionary, writer, aborted))
+            {
+                result = ERROR_DATA_CORRUPTED;
+            }
+            if (aborted)
+            {
+                return ERROR_FAIL;
+            }
+        }
+    }
+    return result;
+}
+
+sys_error_t logStore::prepare()
+{
+    _mounted = false;
+    if (!_memory.initialize())
+    {
+        return ERROR_INIT_FAILED;
+    }
+
+    size_t sectorSize = _memory.getSectorSize();
+    if (_segmentCount < 2 || sectorSize == 0 || _baseAddress % sectorSize != 0 || _segmentSize % sectorSize != 0 ||
+        _segmentSize < sizeof(segmentHeader_t) + blockOverhead + LOG_STORE_BLOCK_SIZE || _baseAddress + _segmentSize * _segmentCount > _memory.getSize())
+    {
+        return ERROR_INVALID_CONFIG;
+    }
+
+    // Buffered records are lost, the next record starts a new segment
+    _blockUsed    = 0;
+    _blockRecords = 0;
+    _dictCount    = 0;
+    _stringsUsed  = 0;
+    _rotate       = true;
+    _writeOffset  = _segmentSize;
+    return ERROR_SUCCESS;
+}
+
+uint32_t logStore::segmentAddress(uint32_t segment)
+{
+    return static_cast<uint32_t>(_baseAddress + segment * _segmentSize);
+}
+
+uint32_t logStore::blockSequence()
+{
+    return _rotate ? _sequence + 1 : _sequence;
+}
+
+void logStore::openBlock()
+{
+    // The segment of a block is decided before its first record, definitions only hold within one segment
+    if (_blockUsed == 0 && _writeOffset + blockOverhead + LOG_STORE_BLOCK_SIZE > _segmentSize)
+    {
+        _rotate = true;
+    }
+    // The dictionary starts empty in every segment, strings which are no longer logged do not keep their slots
+    if (_blockUsed == 0 && _rotate)
+    {
+        _dictCount   = 0;
+        _stringsUsed = 0;
+    }
+}
+
+sys_error_t logStore::startSegment()
+{
+    uint32_t segment    = static_cast<uint32_t>((_segment + 1) % _segmentCount);
+    size_t   sectorSize = _memory.getSectorSize();
+    for (size_t offset = 0; offset < _segmentSize; offset += sectorSize)
+    {
+        if (!_memory.eraseSector(static_cast<uint32_t>(segmentAddress(segment) + offset)))
+        {
+            return ERROR_WRITE_FAILED;
+        }
+    }
+    _stats.segmentErases++;
+
+    segmentHeader_t header = {};
+    header.magic           = LOG_STORE_MAGIC;
+    header.sequence        = _sequence + 1;
+    header.segmentSize     = static_cast<uint32_t>(_segmentSize);
+    header.crc             = crc::crc32(&header, offsetof(segmentHeader_t, crc));
+    if (!_memory.writeData(segmentAddress(segment), reinterpret_cast<const uint8_t*>(&header), sizeof(header)))
+    {
+        return ERROR_WRITE_FAILED;
+    }
+    _stats.flashBytesWritten += sizeof(header);
+
+    _segment     = segment;
+    _sequence    = header.sequence;
+    _writeOffset = sizeof(header);
+    _rotate      = false;
+    return ERROR_SUCCESS;
+}
+
+sys_error_t logStore::writeBlock()
+{
+    if (_blockUsed == 0)
+    {
+        return ERROR_SUCCESS;
+    }
+
+    sys_error_t result = _rotate ? startSegment() : ERROR_SUCCESS;
+    if (result == ERROR_SUCCESS)
+    {
+        // Stored raw unless compression saves at least one byte
+        size_t        packed = _compressor.compress(_block, _blockUsed, _packed, _blockUsed - 1);
+        blockHeader_t header = {};
+        header.storedLength  = static_cast<uint16_t>((packed != 0) ? packed : _blockUsed);
+        header.rawLength     = static_cast<uint16_t>(_blockUsed);
+        header.flags         = (packed != 0) ? blockCompressed : 0;
+        const uint8_t* data  = (packed != 0) ? _packed : _block;
+        header.crc           = crc::crc16(data, header.storedLength, crc::crc16(&header, offsetof(blockHeader_t, crc)));
+
+        uint32_t address = segmentAddress(_segment) + static_cast<uint32_t>(_writeOffset);
+        if (_memory.writeData(address, reinterpret_cast<const uint8_t*>(&header), sizeof(header)) && _memory.writeData(address + sizeof(header), data, header.storedLength))
+        {
+            _writeOffset += sizeof(header) + header.storedLength;
+            _stats.flashBytesWritten += sizeof(header) + header.storedLength;
+            _stats.blocks++;
+            _stats.compressedBlocks += (packed != 0) ? 1 : 0;
+        }
+        else
+        {
+            // The rest of the segment may be programmed partially, continue in the next one
+            _writeOffset = _segmentSize;
+            result       = ERROR_WRITE_FAILED;
+        }
+    }
+
+    if (result != ERROR_SUCCESS)
+    {
+        _stats.dropped += _blockRecords;
+        _rotate = true;
+    }
+    _blockUsed    = 0;
+    _blockRecords = 0;
+    return result;
+}
+
+int logStore::findString(const char* text, size_t length, const void* key, uint32_t& hash)
+{
+    // Literals are found by address, the content is still compared as the address may be reused
+    for (size_t i = 0; key != nullptr && i < _dictCount; i++)
+    {
+        if (_dict[i].key == key && _dict[i].length == length && memcmp(_strings + _dict[i].offset, text, length) == 0)
+        {
+            return static_cast<int>(i);
+        }
+    }
+
+    hash = hashString(text, length);
+    for (size_t i = 0; i < _dictCount; i++)
+    {
+        dictEntry_t& entry = _dict[i];
+        if (entry.hash == hash && entry.length == length && memcmp(_strings + entry.offset, text, length) == 0)
+        {
+            entry.key = (key != nullptr) ? key : entry.key;
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+int logStore::addString(const char* text, size_t length, uint32_t hash, const void* key)
+{
+    if (_dictCount >= LOG_STORE_DICT_ENTRIES || _stringsUsed + length > LOG_STORE_DICT_BYTES)
+    {
+        return -1;
+    }
+    dictEntry_t& entry = _dict[_dictCount];
+    entry.key          = key;
+    entry.hash         = hash;
+    entry.segment      = 0;
+    entry.offset       = static_cast<uint16_t>(_stringsUsed);
+    entry.length       = static_cast<uint16_t>(length);
+    memcpy(_strings + _stringsUsed, text, length);
+    _stringsUsed += length;
+    return static_cast<int>(_dictCount++);
+}
+
+bool logStore::encodeString(const char* text, size_t length, const void* key, size_t& definesUsed, size_t& bodyUsed, uint16_t* defined, size_t& definedCount)
+{
+    uint32_t hash = 0;
+    int      id   = findString(text, length, key, hash);
+    if (id < 0)
+    {
+        id = addString(text, length, hash, key);
+    }
+    if (id < 0)
+    {
+        // Dictionary full, the string is written inline
+        return putVarint(_body, bodyUsed, sizeof(_body), 0) && putVarint(_body, bodyUsed, sizeof(_body), length) && putBytes(_body, bodyUsed, sizeof(_body), text, length);
+    }
+
+    if (_dict[id].segment != blockSequence())
+    {
+        if (!putByte(_record, definesUsed, sizeof(_record), entryDefine) || !putVarint(_record, definesUsed, sizeof(_record), static_cast<uint64_t>(id)) ||
+            !putVarint(_record, definesUsed, sizeof(_record), length) || !putBytes(_record, definesUsed, sizeof(_record), text, length))
+        {
+            return false;
+        }
+        defined[definedCount++] = static_cast<uint16_t>(id);
+    }
+    return putVarint(_body, bodyUsed, sizeof(_body), static_cast<uint64_t>(id) + 1);
+}
+
+size_t logStore::encode(uint8_t type, uint8_t level, const char* tag, const char* text, size_t length, const char* format, va_list* args, uint16_t* defined, size_t& definedCount)
+{
+    size_t definesUsed = 0;
+    size_t bodyUsed    = 0;
+    size_t tagLength   = strnlen(tag, tagSize);
+    definedCount       = 0;
+
+    bool ok = putByte(_body, bodyUsed, sizeof(_body), type) && putByte(_body, bodyUsed, sizeof(_body), level) && putVarint(_body, bodyUsed, sizeof(_body), nowMs()) &&
+              encodeString(tag, tagLength, nullptr, definesUsed, bodyUsed, defined, definedCount);
+    if (ok && type == entryFormat)
+    {
+        size_t  formatLength = strnlen(format, LOG_STORE_STRING_SIZE);
+        va_list copy;
+        va_copy(copy, *args);
+        ok = encodeString(format, formatLength, format, definesUsed, bodyUsed, defined, definedCount) && encodeArguments(format, formatLength, copy, _body, bodyUsed, sizeof(_body));
+        va_end(copy);
+    }
+    else if (ok)
+    {
+        ok = encodeString(text, std::min(length, static_cast<size_t>(LOG_STORE_STRING_SIZE)), nullptr, definesUsed, bodyUsed, defined, definedCount);
+    }
+
+    if (!ok || definesUsed + bodyUsed > sizeof(_record))
+    {
+        return 0;
+    }
+    memcpy(_record + definesUsed, _body, bodyUsed);
+    return definesUsed + bodyUsed;
+}
+
+sys_error_t logStore::record(uint8_t type, uint8_t level, const char* tag, const char* text, size_t length, const char* format, va_list* args)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_mounted)
+    {
+        return ERROR_INIT_FAILED;
+    }
+
+    uint16_t defined[2];
+    size_t   definedCount = 0;
+    openBlock();
+    size_t size = encode(type, level, tag, text, length, format, args, defined, definedCount);
+    if (size == 0 && type == entryFormat)
+    {
+        // Too long for a binary record, keep the formatted text instead
+        va_list copy;
+        va_copy(copy, *args);
+        int written = vsnprintf(_text, sizeof(_text), format, copy);
+        va_end(copy);
+        type = entryText;
+        text = _text;
+        size = encode(type, level, tag, _text, (written > 0) ? std::min(static_cast<size_t>(written), sizeof(_text) - 1) : 0, nullptr, nullptr, defined, definedCount);
+    }
+    if (size == 0)
+    {
+        _stats.dropped++;
+        return ERROR_MESSAGE_TOO_LARGE;
+    }
+
+    if (size > LOG_STORE_BLOCK_SIZE - _blockUsed)
+    {
+        // The block is full, a new one may start a new segment which needs its own definitions
+        sys_error_t result = writeBlock();
+        openBlock();
+        size = encode(type, level, tag, text, (type == entryText && text == _text) ? strnlen(_text, sizeof(_text)) : length, format, args, defined, definedCount);
+        if (result != ERROR_SUCCESS || size == 0)
+        {
+            _stats.dropped++;
+            return (result != ERROR_SUCCESS) ? result : ERROR_MESSAGE_TOO_LARGE;
+        }
+    }
+
+    memcpy(_block + _blockUsed, _record, size);
+    _blockUsed += size;
+    _blockRecords++;
+    for (size_t i = 0; i < definedCount; i++)
+    {
+        _dict[defined[i]].segment = blockSequence();
+    }
+    _stats.records++;
+    _stats.recordBytes += static_cast<uint32_t>(size);
+    return ERROR_SUCCESS;
+}
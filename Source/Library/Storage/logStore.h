@@ -0,0 +1,191 @@
+/**
+ * @file logStore.h
+ * @brief Header file for logStore
+ *
+ * This file contains declarations for the logStore class and related data types and functions.
+ */
+#ifndef LOGSTORE_H
+#define LOGSTORE_H
+
+#include "HAL/IHal.h"
+#include "Library/Common/lz.h"
+#include <functional>
+#include <mutex>
+#include <stdarg.h>
+
+#define LOG_STORE_MAGIC        0x31474F4C // "LOG1"
+#define LOG_STORE_BLOCK_SIZE   512        // record bytes buffered in RAM and written as one block
+#define LOG_STORE_RECORD_SIZE  192        // longest encoded record, dictionary definitions included
+#define LOG_STORE_STRING_SIZE  120        // longest string argument or inline text, longer ones are cut
+#define LOG_STORE_DICT_ENTRIES 64         // tags, format strings and texts kept in the dictionary
+#define LOG_STORE_DICT_BYTES   2048       // dictionary string storage
+
+/**
+ * @brief Write and compression counters of a logStore
+ * The compression ratio is recordBytes / (flashBytesWritten - header bytes).
+ */
+typedef struct
+{
+    uint32_t records;           // records accepted by log()/logText()
+    uint32_t dropped;           // records lost to a failed flush
+    uint32_t recordBytes;       // encoded record bytes, dictionary definitions included
+    uint32_t flashBytesWritten; // block and segment header bytes included
+    uint32_t blocks;            // blocks written
+    uint32_t compressedBlocks;  // blocks stored compressed
+    uint32_t segmentErases;     // segments erased to start a new one
+} logStoreStats_t;
+
+/**
+ * @brief Receives decoded log lines, returns false to abort
+ */
+typedef std::function<bool(const char* line, size_t length)> logStoreWriter_t;
+
+/**
+ * @brief Rotating binary log on top of an IHAL_MEM device
+ *
+ * The device is split into fixed size segments, written one after the other; when the last one is full the
+ * oldest one is erased and reused. Records are encoded into a RAM block and reach the device a block at a time,
+ * compressed with lz if that makes it smaller, so logging costs no storage access per line.
+ *
+ * Tags, format strings and texts are written once per segment as dictionary definitions and referred to by id,
+ * printf arguments are stored binary (integers as varints). Every segment can be decoded on its own, the text is
+ * only rebuilt by decode(), e.g. by the log_decode host tool from an image of the device.
+ *
+ * Layout: a segment starts with a 16 byte header (magic, sequence, segment size, CRC-32), followed by blocks of
+ * an 8 byte header (stored length, raw length, flags, CRC-16) and their data. All fields are little endian.
+ *
+ * All public methods are thread safe. flush() is meant to be called periodically from a low priority task, log()
+ * only writes to the device synchronously when the block in RAM is full.
+ */
+class logStore
+{
+private:
+    typedef struct
+    {
+        const void* key;     // address the string was last passed with, a fast path for literals
+        uint32_t    hash;    // FNV-1a of the string
+        uint32_t    segment; // sequence of the segment the string was last defined in, 0 = never
+        uint16_t    offset;  // position in _strings
+        uint16_t    length;
+    } dictEntry_t;
+
+    IHAL_MEM&       _memory;
+    uint32_t        _baseAddress;
+    size_t          _segmentSize;
+    size_t          _segmentCount;
+    uint32_t        _segment;     // segment written to
+    uint32_t        _sequence;    // sequence of the segment written to, 0 before the first one
+    size_t          _writeOffset; // next free byte in the segment
+    bool            _rotate;      // the block in RAM starts a new segment
+    bool            _mounted;
+    uint8_t         _block[LOG_STORE_BLOCK_SIZE];
+    size_t          _blockUsed;
+    uint32_t        _blockRecords; // records in the block, dropped if it cannot be written
+    uint8_t         _packed[LOG_STORE_BLOCK_SIZE];
+    lz::compressor  _compressor;
+    uint8_t         _record[LOG_STORE_RECORD_SIZE]; // record being encoded, definitions first
+    uint8_t         _body[LOG_STORE_RECORD_SIZE];
+    char            _text[LOG_STORE_STRING_SIZE + 1]; // formatted text of a record too long to encode
+    dictEntry_t     _dict[LOG_STORE_DICT_ENTRIES];
+    size_t          _dictCount;
+    char            _strings[LOG_STORE_DICT_BYTES];
+    size_t          _stringsUsed;
+    logStoreStats_t _stats;
+    std::mutex      _mutex;
+
+    sys_error_t prepare();
+    uint32_t    segmentAddress(uint32_t segment);
+    uint32_t    blockSequence();
+    void        openBlock();
+    sys_error_t writeBlock();
+    sys_error_t startSegment();
+    int         findString(const char* text, size_t length, const void* key, uint32_t& hash);
+    int         addString(const char* text, size_t length, uint32_t hash, const void* key);
+    bool        encodeString(const char* text, size_t length, const void* key, size_t& definesUsed, size_t& bodyUsed, uint16_t* defined, size_t& definedCount);
+    size_t      encode(uint8_t type, uint8_t level, const char* tag, const char* text, size_t length, const char* format, va_list* args, uint16_t* defined, size_t& definedCount);
+    sys_error_t record(uint8_t type, uint8_t level, const char* tag, const char* text, size_t length, const char* format, va_list* args);
+
+public:
+    /**
+     * @brief Construct a new logStore object
+     *
+     * @param memory - memory device
+     * @param baseAddress - start of the log area, sector aligned
+     * @param segmentSize - segment size, a multiple of the sector size holding at least one block
+     * @param segmentCount - number of segments, at least two
+     */
+    logStore(IHAL_MEM& memory, uint32_t baseAddress, size_t segmentSize, size_t segmentCount);
+    ~logStore();
+
+    // Delete copy constructor and assignment operator
+    logStore(const logStore&)            = delete;
+    logStore& operator=(const logStore&) = delete;
+
+    /**
+     * @brief Find the newest segment and the end of its blocks, new records are appended there
+     *
+     * @return sys_error_t ERROR_INVALID_CONFIG if the segments do not fit the device
+     */
+    sys_error_t mount();
+
+    /**
+     * @brief Erase all segments
+     *
+     * @return sys_error_t
+     */
+    sys_error_t format();
+
+    /**
+     * @brief Add a record built from a printf format and its arguments
+     * Supported conversions: d i u x X o c p s f F e E g G a A and %%, with flags, width, precision (also *) and
+     * the length modifiers hh h l ll z j t.
+     *
+     * @param level - severity, ILog::LogLevel
+     * @param tag - source of the record
+     * @param format - printf format
+     * @return sys_error_t ERROR_WRITE_FAILED if the full block could not be written, the record is dropped
+     */
+    sys_error_t log(uint8_t level, const char* tag, const char* format, ...) __attribute__((format(printf, 4, 5)));
+
+    /**
+     * @brief log() with a va_list
+     */
+    sys_error_t logV(uint8_t level, const char* tag, const char* format, va_list args);
+
+    /**
+     * @brief Add a record of a text which is already formatted
+     * Repeated texts are stored once per segment like format strings.
+     *
+     * @param level - severity, ILog::LogLevel
+     * @param tag - source of the record
+     * @param text - the text, not null terminated
+     * @param length - text length
+     * @return sys_error_t ERROR_WRITE_FAILED if the full block could not be written, the record is dropped
+     */
+    sys_error_t logText(uint8_t level, const char* tag, const char* text, size_t length);
+
+    /**
+     * @brief Write the records buffered in RAM to the device
+     *
+     * @return sys_error_t
+     */
+    sys_error_t flush();
+
+    /**
+     * @brief Decode all stored records, oldest segment first, one line each: "I (1234) tag: message\n"
+     * Records still in RAM are not included, call flush() first. Uses the heap, meant for the host.
+     *
+     * @param writer - output sink
+     * @return sys_error_t ERROR_DATA_CORRUPTED if a block could not be decoded, the other blocks are still written
+     */
+    sys_error_t decode(const logStoreWriter_t& writer);
+
+    /**
+     * @brief Get the write and compression counters
+     *
+     * @return logStoreStats_t
+     */
+    logStoreStats_t getStats();
+};
+
+#endif /* LOGSTORE_H */
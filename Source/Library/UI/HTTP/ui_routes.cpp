@@ -0,0 +1,65 @@
+/**
+ * @file ui_routes.cpp
+ * @brief Source file for ui_routes
+ *
+ * This file contains definitions for the request handling of the web UI routes.
+ */
+
+#include "ui_routes.h"
+#include "ui_welcome_wifi_connect.h"
+
+#include <string.h>
+
+bool uiFormValue(const char* form, size_t length, const char* key, char* value, size_t size)
+{
+    size_t keyLength = strlen(key);
+    size_t start     = 0;
+    while (start <= length)
+    {
+        const char* separator = static_cast<const char*>(memchr(form + start, '&', length - start));
+        size_t      end       = (separator != nullptr) ? static_cast<size_t>(separator - form) : length;
+        if (end - start > keyLength && form[start + keyLength] == '=' && memcmp(form + start, key, keyLength) == 0)
+        {
+            size_t valueLength = end - start - keyLength - 1;
+            if (valueLength >= size)
+            {
+                return false;
+            }
+            memcpy(value, form + start + keyLength + 1, valueLength);
+            value[valueLength] = '\0';
+            return true;
+        }
+        start = end + 1;
+    }
+    return false;
+}
+
+uiRouteResponse_t uiWelcomeRoute()
+{
+    uiRouteResponse_t response = {200, HTML_UI_WELCOME_WIFI_CONNECT_CONTENT};
+    return response;
+}
+
+uiRouteResponse_t uiConnectRoute(const char* form, size_t length, uiCredentials_t& credentials)
+{
+    uiRouteResponse_t response = {500, nullptr};
+    if (length < UI_CONNECT_FORM_SIZE && uiFormValue(form, length, "ssid", credentials.ssid, sizeof(credentials.ssid)) &&
+        uiFormValue(form, length, "password", credentials.password, sizeof(credentials.password)))
+    {
+        response.status = 200;
+        response.body   = "Connected";
+    }
+    return response;
+}
+
+uiRouteResponse_t uiCtrlRoute(const char* body, size_t length, bool& routesEnabled)
+{
+    uiRouteResponse_t response = {200, nullptr};
+    if (length == 0)
+    {
+        response.status = 400;
+        return response;
+    }
+    routesEnabled = (body[0] != '0');
+    return response;
+}
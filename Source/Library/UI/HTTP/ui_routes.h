@@ -0,0 +1,72 @@
+/**
+ * @file ui_routes.h
+ * @brief Header file for ui_routes
+ *
+ * This file contains the request handling of the web UI routes, shared by proc_httpServer on the device and
+ * by the host harnesses serving the same routes with net_httpHost.
+ */
+#ifndef UI_ROUTES_H
+#define UI_ROUTES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define UI_CONNECT_FORM_SIZE 256 // longest /connect body, terminator included
+#define UI_CREDENTIAL_SIZE   32  // longest SSID / password, terminator included
+
+/**
+ * @brief Answer of a route, the server sends it with its own API
+ */
+typedef struct
+{
+    int         status; // HTTP status code
+    const char* body;   // null terminated, nullptr for an empty body
+} uiRouteResponse_t;
+
+/**
+ * @brief Credentials posted to /connect
+ */
+typedef struct
+{
+    char ssid[UI_CREDENTIAL_SIZE];
+    char password[UI_CREDENTIAL_SIZE];
+} uiCredentials_t;
+
+/**
+ * @brief Find a key in an application/x-www-form-urlencoded body, like httpd_query_key_value()
+ *
+ * @param form - form text, not null terminated
+ * @param length - form length
+ * @param key - key to find
+ * @param value - buffer for the value, left undecoded
+ * @param size - buffer size, terminator included
+ * @return true if the key was found and its value fits
+ */
+bool uiFormValue(const char* form, size_t length, const char* key, char* value, size_t size);
+
+/**
+ * @brief GET /welcome: the Wi-Fi connect page
+ */
+uiRouteResponse_t uiWelcomeRoute();
+
+/**
+ * @brief POST /connect: the SSID and password of a "ssid=...&password=..." form
+ *
+ * @param form - request body, not null terminated
+ * @param length - body length, UI_CONNECT_FORM_SIZE or more is rejected
+ * @param credentials - the posted credentials on success
+ * @return uiRouteResponse_t 200 "Connected", 500 if the form is too long or a field is missing
+ */
+uiRouteResponse_t uiConnectRoute(const char* form, size_t length, uiCredentials_t& credentials);
+
+/**
+ * @brief PUT /ctrl: "0" takes /welcome and /connect offline, anything else brings them back
+ *
+ * @param body - request body, not null terminated
+ * @param length - body length
+ * @param routesEnabled - whether /welcome and /connect are served after the request
+ * @return uiRouteResponse_t 200 with an empty body, 400 without a body
+ */
+uiRouteResponse_t uiCtrlRoute(const char* body, size_t length, bool& routesEnabled);
+
+#endif /* UI_ROUTES_H */
@@ -6,10 +6,19 @@
  */
 
 #include "Proc_Button.hpp"
-#include <inttypes.h>
+#include "Library/Common/textFormat.h"
+#include "Library/Diagnostics/trace.h"
+#include "System/metrics.h"
+#include <stdio.h>
 
 namespace
 {
+const uint32_t pressBounds[] = {50, 100, 250, 500, 1000, 2000, 5000}; // ms
+
+metricCounter      buttonEvents("button_events_total", "GPIO events handled by the button listeners");
+metricCounter      buttonPresses("button_presses_total", "Completed button presses");
+metricHistogram<7> buttonPressDuration("button_press_duration_ms", "Duration of the button presses in milliseconds", pressBounds);
+metricGauge        buttonQueueDepth("button_queue_depth", "GPIO events left in the queue after the last one was taken");
 } // namespace
 
 /**
@@ -35,46 +44,54 @@ static void buttonListener(void* arg);
  */
 static void clearQueue(QueueHandle_t xQueue);
 
-Proc_Button::Proc_Button(std::vector<buttonData*>& buttons, uint32_t stackSize, uint8_t taskPriority) : _buttons(buttons), _stackSize(stackSize), _taskPriority(taskPriority)
+Proc_ButtonBase::Proc_ButtonBase(std::vector<buttonData*>& buttons, uint8_t taskPriority, int8_t core)
+    : _buttons(buttons), _taskPriority(taskPriority), _core(core), _pressHandler(nullptr), _pressContext(nullptr)
 {
     // constructor implementation
 }
 
-Proc_Button::~Proc_Button()
+Proc_ButtonBase::~Proc_ButtonBase()
 {
     // destructor implementation
 }
 
-sys_error_t Proc_Button::start()
+sys_error_t Proc_ButtonBase::start()
 {
+    if (_buttons.size() > getTaskCount())
+    {
+        return ERROR_INVALID_CONFIG;
+    }
+
     // Start the Button Listener
-    for (buttonData* button : _buttons)
+    for (size_t i = 0; i < _buttons.size(); i++)
     {
+        _buttons[i]->owner = this;
+
         // Create the Button Listener
-        xTaskCreate(buttonListener,             // Task function
-                    "button_listener_task",     // Task name
-                    _stackSize,                 // Stack size
-                    static_cast<void*>(button), // Task parameter
-                    _taskPriority,              // Task priority
-                    &(button->taskHandle));     // Task handle
+        RETURN_ON_ERROR(getTask(i).create(buttonListener,                  // Task function
+                                          "button_listener_task",          // Task name
+                                          static_cast<void*>(_buttons[i]), // Task parameter
+                                          _taskPriority,                   // Task priority
+                                          _core));                         // Task core
+        _buttons[i]->taskHandle = getTask(i).getHandle();
     }
     return ERROR_SUCCESS;
 }
-sys_error_t Proc_Button::stop()
+sys_error_t Proc_ButtonBase::stop()
 {
     // Stop the Button Listener
-    for (buttonData* button : _buttons)
+    for (size_t i = 0; i < _buttons.size() && i < getTaskCount(); i++)
     {
         // Delete the Button Listener
-        vTaskDelete(button->taskHandle);
-        button->taskHandle = NULL;
-        buttonDataClear(button);
+        getTask(i).remove();
+        _buttons[i]->taskHandle = NULL;
+        buttonDataClear(_buttons[i]);
     }
 
     return ERROR_SUCCESS;
 }
 
-sys_error_t Proc_Button::pause()
+sys_error_t Proc_ButtonBase::pause()
 {
     // Pause the Button Listener
     for (buttonData* button : _buttons)
@@ -85,7 +102,7 @@ sys_error_t Proc_Button::pause()
     return ERROR_SUCCESS;
 }
 
-sys_error_t Proc_Button::resume()
+sys_error_t Proc_ButtonBase::resume()
 {
     for (buttonData* button : _buttons)
     {
@@ -98,6 +115,53 @@ sys_error_t Proc_Button::resume()
     return ERROR_SUCCESS;
 }
 
+size_t Proc_ButtonBase::getTasks(processTask_t* tasks, size_t maxTasks)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < getTaskCount() && count < maxTasks; i++)
+    {
+        if (getTask(i).getHandle() != NULL)
+        {
+            tasks[count].handle    = getTask(i).getHandle();
+            tasks[count].stackSize = getTask(i).getStackSize() * sizeof(StackType_t);
+            count++;
+        }
+    }
+    return count;
+}
+
+uint32_t Proc_ButtonBase::getWakeups(uint64_t nowUs)
+{
+    uint32_t wakeups = 0;
+    for (buttonData* button : _buttons)
+    {
+        wakeups += button->wakeups;
+    }
+    return wakeups;
+}
+
+void Proc_ButtonBase::setPressHandler(buttonPressHandler_t handler, void* context)
+{
+    _pressHandler = handler;
+    _pressContext = context;
+}
+
+void Proc_ButtonBase::notifyPress(buttonData& button, uint32_t durationMs)
+{
+    if (_pressHandler == nullptr)
+    {
+        return;
+    }
+    for (size_t i = 0; i < _buttons.size(); i++)
+    {
+        if (_buttons[i] == &button)
+        {
+            _pressHandler(i, durationMs, _pressContext);
+            return;
+        }
+    }
+}
+
 // Button Listener
 // This task is responsible for processing the GPIO events
 // It reads the GPIO input and calculates the duration of the button press
@@ -113,20 +177,27 @@ sys_error_t Proc_Button::resume()
 
 static void buttonListener(void* arg)
 {
-    Proc_Button::buttonData& button = *static_cast<Proc_Button::buttonData*>(arg);
+    Proc_ButtonBase::buttonData& button = *static_cast<Proc_ButtonBase::buttonData*>(arg);
 
     gpio_num_t gpioNumber = button.gpio.getGpioNumber();
     button.changeTime     = xTaskGetTickCount(); // Get the current time
     button.gpio.get((static_cast<void*>(&button.prevState)));
     QueueHandle_t gpioEventQueue = button.gpio.getEventQueue();
 
-    printf("Waiting for button to be pressed!\n");
+    puts("Waiting for button to be pressed!");
     for (;;)
     {
         if (xQueueReceive(gpioEventQueue, &gpioNumber, portMAX_DELAY))
         {
+            button.wakeups++;
+            buttonEvents.inc();
+            buttonQueueDepth.set(static_cast<int32_t>(uxQueueMessagesWaiting(gpioEventQueue)));
+            TRACE_ASYNC_END(GPIO_LATENCY, gpioNumber);
+            TRACE_BEGIN(BUTTON_EVENT, gpioNumber);
             button.gpio.get(static_cast<void*>(&button.currentState));
-            printf("state: %d\n", button.currentState);
+            format::fixedString<64> text;
+            format::formatTo(text, "state: {}", button.currentState);
+            puts(text.c_str());
 
             // If the button is pressed and the previous state is not pressed
             // Record the time when the button is pressed
@@ -136,7 +207,15 @@ static void buttonListener(void* arg)
                 uint32_t now      = xTaskGetTickCount();
                 uint32_t duration = pdTICKS_TO_MS(now - button.changeTime); // Calculate the duration
 
-                printf("GPIO[%" PRIu32 "] intr, pressed state duration : %" PRIu32 "ms\n", (uint32_t)gpioNumber, duration);
+                text.clear();
+                format::formatTo(text, "GPIO[{}] intr, pressed state duration : {}ms", static_cast<uint32_t>(gpioNumber), duration);
+                puts(text.c_str());
+                buttonPresses.inc();
+                buttonPressDuration.observe(duration);
+                if (button.owner != nullptr)
+                {
+                    button.owner->notifyPress(button, duration);
+                }
             }
 
             // Update the previous state if the current state is different from the previous state
@@ -147,11 +226,12 @@ static void buttonListener(void* arg)
                 button.prevState  = button.currentState; // Update the previous state
                 button.changeTime = xTaskGetTickCount(); // Update the change time
             }
+            TRACE_END(BUTTON_EVENT, gpioNumber);
         }
     }
 }
 
-void Proc_Button::buttonDataClear(buttonData* button)
+void Proc_ButtonBase::buttonDataClear(buttonData* button)
 {
     button->changeTime   = xTaskGetTickCount();
     button->currentState = GPIO_LOW;
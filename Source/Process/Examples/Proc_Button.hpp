@@ -10,25 +10,37 @@
 
 #include "HAL/Platform/ESP32/io_gpio.hpp"
 #include "Process/IProcess.hpp"
+#include "System/rtosObjects.h"
 #include <vector>
 
-class Proc_Button : public IProcess
+class Proc_ButtonBase;
+
+/**
+ * @brief Button press handler, runs in the task of the button and must not block
+ */
+typedef void (*buttonPressHandler_t)(size_t index, uint32_t durationMs, void* context);
+
+class Proc_ButtonBase : public IProcess
 {
 public:
     typedef struct
     {
-        io_gpio&     gpio;
-        int          prevState;
-        int          currentState;
-        const int    pressedState;
-        uint32_t     changeTime;
-        TaskHandle_t taskHandle;
+        io_gpio&         gpio;
+        int              prevState;
+        int              currentState;
+        const int        pressedState;
+        uint32_t         changeTime;
+        TaskHandle_t     taskHandle;
+        uint32_t         wakeups; // GPIO events handled
+        Proc_ButtonBase* owner;   // set by start()
     } buttonData;
 
 private:
     std::vector<buttonData*>& _buttons;
-    uint32_t                  _stackSize;
     uint8_t                   _taskPriority;
+    int8_t                    _core;
+    buttonPressHandler_t      _pressHandler;
+    void*                     _pressContext;
 
     /**
      * @brief Button Data Clear
@@ -37,16 +49,32 @@ private:
      */
     void buttonDataClear(buttonData* button);
 
+protected:
+    /**
+     * @brief Get the holder of a button task, provided by Proc_Button<StackSize, MaxButtons>
+     *
+     * @param index - button index
+     * @return rtosTaskBase&
+     */
+    virtual rtosTaskBase& getTask(size_t index) = 0;
+
+    /**
+     * @brief Get the number of button tasks that can be created
+     *
+     * @return size_t
+     */
+    virtual size_t getTaskCount() = 0;
+
 public:
     /**
-     * @brief Construct a new Proc_Button object
+     * @brief Construct a new Proc_ButtonBase object
      *
      * @param button - vector of button data
-     * @param stackSize - stack size (default 2048) of each button task
-     * @param taskPriority - task priority (default 10)
+     * @param taskPriority - task priority
+     * @param core - core of the button tasks
      */
-    Proc_Button(std::vector<buttonData*>& button, uint32_t stackSize = 2048, uint8_t taskPriority = 10);
-    ~Proc_Button();
+    Proc_ButtonBase(std::vector<buttonData*>& button, uint8_t taskPriority, int8_t core);
+    ~Proc_ButtonBase();
 
     sys_error_t start() override;
 
@@ -55,6 +83,66 @@ public:
     sys_error_t pause() override;
 
     sys_error_t resume() override;
+
+    size_t getTasks(processTask_t* tasks, size_t maxTasks) override;
+
+    /**
+     * @brief Get the GPIO events handled by all buttons
+     * The buttons have no deadline, their tasks only wake up on GPIO events.
+     */
+    uint32_t getWakeups(uint64_t nowUs) override;
+
+    /**
+     * @brief Set the handler of completed presses, before start()
+     *
+     * @param handler - called with the button index and the press duration, nullptr for none
+     * @param context - passed to the handler
+     */
+    void setPressHandler(buttonPressHandler_t handler, void* context);
+
+    /**
+     * @brief Report a completed press of a button to the press handler, called by the button task
+     *
+     * @param button - button data
+     * @param durationMs - press duration in milliseconds
+     */
+    void notifyPress(buttonData& button, uint32_t durationMs);
+};
+
+/**
+ * @brief Button process with the stacks of its tasks, one task per button
+ *
+ * @tparam StackSize - stack size of each button task (default 2048)
+ * @tparam MaxButtons - maximum number of buttons (default 4)
+ */
+template <uint32_t StackSize = 2048, size_t MaxButtons = 4> class Proc_Button : public Proc_ButtonBase
+{
+private:
+    rtosTask<StackSize> _tasks[MaxButtons];
+
+protected:
+    rtosTaskBase& getTask(size_t index) override
+    {
+        return _tasks[index];
+    }
+
+    size_t getTaskCount() override
+    {
+        return MaxButtons;
+    }
+
+public:
+    /**
+     * @brief Construct a new Proc_Button object
+     *
+     * @param button - vector of button data, at most MaxButtons entries
+     * @param taskPriority - task priority (default realtime I/O, above the LEDs)
+     * @param core - core of the button tasks (default TASK_CORE_APP, away from Wi-Fi)
+     */
+    Proc_Button(std::vector<buttonData*>& button, uint8_t taskPriority = taskBandPriority(TASK_BAND_REALTIME_IO, 2), int8_t core = TASK_CORE_APP)
+        : Proc_ButtonBase(button, taskPriority, core)
+    {
+    }
 };
 
 #endif /* PROC_BUTTON_HPP */
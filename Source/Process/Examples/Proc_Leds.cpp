@@ -7,6 +7,9 @@
 
 #include "Proc_Leds.hpp"
 #include "HAL/Platform/ESP32/Library/logImpl.h"
+#include "Library/Diagnostics/trace.h"
+#include "System/metrics.h"
+#include <esp_timer.h>
 
 namespace
 {
@@ -18,11 +21,16 @@ constexpr uint16_t led_blink_toggle_rate = led_task_delay * 2;        // ms
 constexpr uint16_t led_blink_once_rate   = led_blink_toggle_rate * 2; // ms
 constexpr uint16_t led_blick_twice_rate  = led_blink_once_rate * 2;   // ms
 constexpr uint16_t led_blick_thrice_rate = led_blink_once_rate * 3;   // ms
+constexpr uint32_t led_restart           = UINT32_MAX;                // counter of an LED whose state was just set
+
+metricCounter ledTransitions("led_transitions_total", "LED toggles of the blink patterns");
+metricCounter ledStateChanges("led_state_changes_total", "LED states set by the application");
+metricGauge   ledsBlinking("leds_blinking", "LEDs running a blink pattern after the last LED cycle");
 } // namespace
 
 /**
  * @brief Task to handle the LEDs states
- * @param arg - vector of LED data
+ * @param arg - the Proc_LedsBase object
  */
 static void procLedsTask(void* arg);
 /**
@@ -30,74 +38,110 @@ static void procLedsTask(void* arg);
  *
  * @param led - LED data struct
  */
-static void toggle(Proc_Leds::ledData* led);
+static void toggle(Proc_LedsBase::ledData* led);
 
 /**
  * @brief Handle the LED blink state
  *
  * @param led - LED data struct
  * @param timeoutRate - the timeout rate for the LED
+ * @return true if the LED changed
+ */
+static bool handleBlink(Proc_LedsBase::ledData* led, uint32_t timeoutRate);
+
+/**
+ * @brief Run one 100 ms cycle of an LED
+ *
+ * @param led - LED data struct
+ * @return true if the LED changed
+ */
+static bool stepLed(Proc_LedsBase::ledData* led);
+
+/**
+ * @brief Get the number of cycles until the LED changes on its own
+ *
+ * @param led - LED data struct
+ * @return uint32_t 0 if the LED keeps its level
  */
-static void handleBlink(Proc_Leds::ledData* led, uint32_t timeoutRate);
+static uint32_t cyclesToChange(const Proc_LedsBase::ledData* led);
 
-Proc_Leds::Proc_Leds(std::vector<ledData*>& leds, uint32_t stackSize, uint8_t taskPriority) : _leds(leds), _stackSize(stackSize), _taskPriority(taskPriority)
+Proc_LedsBase::Proc_LedsBase(std::vector<ledData*>& leds, uint8_t taskPriority, int8_t core, io_port** ports, size_t portCount)
+    : _leds(leds), _taskPriority(taskPriority), _core(core), _ports(ports), _portCount(portCount), _nextDeadline(POWER_NO_DEADLINE)
 {
     // constructor implementation
 }
 
-Proc_Leds::~Proc_Leds()
+Proc_LedsBase::~Proc_LedsBase()
 {
     // destructor implementation
 }
 
-sys_error_t Proc_Leds::start()
+sys_error_t Proc_LedsBase::start()
 {
     // start the LED task
 
-    // Create the Button Listener
-    BaseType_t result = xTaskCreate(procLedsTask,               // Task function
-                                    "Leds_Task",                // Task name
-                                    _stackSize,                 // Stack size
-                                    static_cast<void*>(&_leds), // Task parameter
-                                    _taskPriority,              // Task priority
-                                    &_taskHandle);              // Task handle
+    sys_error_t result = getTask().create(procLedsTask,             // Task function
+                                          "Leds_Task",              // Task name
+                                          static_cast<void*>(this), // Task parameter
+                                          _taskPriority,            // Task priority
+                                          _core);                   // Task core
 
-    if (result != pdPASS)
+    if (result != ERROR_SUCCESS)
     {
         logger().log(ILog::LogLevel::ERROR, "Proc_Leds: Failed to create task!");
-        return ERROR_FAIL;
+        return result;
     }
     return ERROR_SUCCESS;
 }
 
-sys_error_t Proc_Leds::stop()
+sys_error_t Proc_LedsBase::stop()
 {
     // stop the LED task
-    vTaskDelete(_taskHandle);
+    getTask().remove();
+    setNextDeadline(POWER_NO_DEADLINE);
     return ERROR_SUCCESS;
 }
 
-sys_error_t Proc_Leds::pause()
+sys_error_t Proc_LedsBase::pause()
 {
-    vTaskSuspend(_taskHandle);
+    getTask().suspend();
+    setNextDeadline(POWER_NO_DEADLINE);
     return ERROR_SUCCESS;
 }
 
-sys_error_t Proc_Leds::resume()
+sys_error_t Proc_LedsBase::resume()
 {
-    vTaskResume(_taskHandle);
+    getTask().resume();
     return ERROR_SUCCESS;
 }
 
-sys_error_t Proc_Leds::setLedState(ledData& led, ledStateMachine state)
+size_t Proc_LedsBase::getTasks(processTask_t* tasks, size_t maxTasks)
+{
+    if (maxTasks == 0 || getTask().getHandle() == NULL)
+    {
+        return 0;
+    }
+    tasks[0].handle    = getTask().getHandle();
+    tasks[0].stackSize = getTask().getStackSize() * sizeof(StackType_t);
+    return 1;
+}
+
+uint64_t Proc_LedsBase::getNextDeadline(uint64_t nowUs)
+{
+    return _nextDeadline.load(std::memory_order_relaxed);
+}
+
+sys_error_t Proc_LedsBase::setLedState(ledData& led, ledStateMachine state)
 {
     // loop through the LEDs and find the corresponding LED to update its state
     for (ledData* _led : _leds)
     {
         if (_led == &led)
         {
-            _led->counter = 0;
+            _led->counter = led_restart;
             _led->state   = state;
+            getTask().notify();
+            ledStateChanges.inc();
 
             return ERROR_SUCCESS;
         }
@@ -106,92 +150,222 @@ sys_error_t Proc_Leds::setLedState(ledData& led, ledStateMachine state)
     return ERROR_INVALID_ARG;
 }
 
-static void toggle(Proc_Leds::ledData* led)
+std::vector<Proc_LedsBase::ledData*>& Proc_LedsBase::getLeds()
+{
+    return _leds;
+}
+
+uint32_t Proc_LedsBase::update(uint32_t steps)
+{
+    uint32_t next     = 0;
+    size_t   blinking = 0;
+    for (ledData* led : _leds)
+    {
+        bool restart = (led->counter == led_restart); // the new pattern starts now
+        if (restart)
+        {
+            led->counter = 0;
+        }
+
+        if (led->state == LED_OFF || led->state == LED_ON)
+        {
+            stepLed(led);
+        }
+        else if (!restart)
+        {
+            for (uint32_t step = 0; step < steps; step++)
+            {
+                if (stepLed(led))
+                {
+                    break;
+                }
+            }
+        }
+
+        uint32_t cycles = cyclesToChange(led);
+        if (cycles != 0)
+        {
+            blinking++;
+        }
+        if (cycles != 0 && (next == 0 || cycles < next))
+        {
+            next = cycles;
+        }
+    }
+    // LEDs on ports only staged their levels, they all change now
+    flushPorts();
+    ledsBlinking.set(static_cast<int32_t>(blinking));
+    return next;
+}
+
+void Proc_LedsBase::setNextDeadline(uint64_t deadline)
+{
+    _nextDeadline.store(deadline, std::memory_order_relaxed);
+}
+
+void Proc_LedsBase::flushPorts()
+{
+    for (size_t i = 0; i < _portCount; i++)
+    {
+        _ports[i]->flush();
+    }
+}
+
+static void toggle(Proc_LedsBase::ledData* led)
 {
     led->onOff = !led->onOff;
     led->gpio.set((void*)&(led->onOff));
+    ledTransitions.inc();
 }
 
-static void handleBlink(Proc_Leds::ledData* led, uint32_t timeoutRate)
+static bool handleBlink(Proc_LedsBase::ledData* led, uint32_t timeoutRate)
 {
     led->counter += led_task_delay;
     if (led->counter >= timeoutRate) // reset the counter and toggle the LED
     {
         led->counter = 0;
         toggle(led);
+        return true;
     }
+    return false;
 }
 
-static void handleBlinkTimesX(Proc_Leds::ledData* led, uint32_t timeoutRate)
+static bool handleBlinkTimesX(Proc_LedsBase::ledData* led, uint32_t timeoutRate)
 {
+    bool changed = false;
     led->counter += led_task_delay;
 
     if (led->counter % led_blink_toggle_rate == 0) // toggle the LED
     {
         toggle(led);
+        changed = true;
     }
 
     if (led->counter >= timeoutRate) // reset the LED state
     {
         led->counter = 0;
         led->state   = LED_OFF;
+        changed      = true;
     }
+    return changed;
 }
 
-void procLedsTask(void* arg)
+static bool stepLed(Proc_LedsBase::ledData* led)
 {
-    // get the LED data
-    std::vector<Proc_Leds::ledData*> leds = *static_cast<std::vector<Proc_Leds::ledData*>*>(arg);
-
-    printf("Leds Task Started!\n");
-    for (;;)
+    switch (led->state)
     {
-        // loop through the LEDs and update their states
-        for (auto led : leds)
+        case LED_OFF:
         {
+            uint8_t off = GPIO_LOW;
+            led->gpio.set((void*)&off);
+        }
+        break;
+        case LED_ON:
+        {
+            uint8_t on = GPIO_HIGH;
+            led->gpio.set((void*)&on);
+        }
+        break;
 
-            switch (led->state)
-            {
-                case LED_OFF:
-                {
-                    uint8_t off = GPIO_LOW;
-                    led->gpio.set((void*)&off);
-                }
-                break;
-                case LED_ON:
-                {
-                    uint8_t on = GPIO_HIGH;
-                    led->gpio.set((void*)&on);
-                }
-                break;
+        case LED_BLINK_SLOW:
+            return handleBlink(led, led_blink_slow_rate);
 
-                case LED_BLINK_SLOW:
-                    handleBlink(led, led_blink_slow_rate);
-                    break;
+        case LED_BLINK:
+            return handleBlink(led, led_blink_rate);
 
-                case LED_BLINK:
-                    handleBlink(led, led_blink_rate);
-                    break;
+        case LED_BLINK_FAST:
+            return handleBlink(led, led_blink_fast_rate);
 
-                case LED_BLINK_FAST:
-                    handleBlink(led, led_blink_fast_rate);
-                    break;
+        case LED_BLINK_ONCE:
+            return handleBlinkTimesX(led, led_blink_once_rate);
 
-                case LED_BLINK_ONCE:
-                    handleBlinkTimesX(led, led_blink_once_rate);
-                    break;
+        case LED_BLINK_TWICE:
+            return handleBlinkTimesX(led, led_blick_twice_rate);
 
-                case LED_BLINK_TWICE:
-                    handleBlinkTimesX(led, led_blick_twice_rate);
-                    break;
+        case LED_BLINK_THRICE:
+            return handleBlinkTimesX(led, led_blick_thrice_rate);
+        default:
+            break;
+    }
+    return false;
+}
 
-                case LED_BLINK_THRICE:
-                    handleBlinkTimesX(led, led_blick_thrice_rate);
-                    break;
-                default:
-                    break;
-            }
+static uint32_t cyclesToBlink(uint32_t counter, uint32_t timeoutRate)
+{
+    return (timeoutRate - counter + led_task_delay - 1) / led_task_delay;
+}
+
+static uint32_t cyclesToBlinkTimesX(uint32_t counter, uint32_t timeoutRate)
+{
+    uint32_t toToggle = (led_blink_toggle_rate - counter % led_blink_toggle_rate) / led_task_delay;
+    uint32_t toEnd    = cyclesToBlink(counter, timeoutRate);
+    return (toToggle < toEnd) ? toToggle : toEnd;
+}
+
+static uint32_t cyclesToChange(const Proc_LedsBase::ledData* led)
+{
+    switch (led->state)
+    {
+        case LED_BLINK_SLOW:
+            return cyclesToBlink(led->counter, led_blink_slow_rate);
+
+        case LED_BLINK:
+            return cyclesToBlink(led->counter, led_blink_rate);
+
+        case LED_BLINK_FAST:
+            return cyclesToBlink(led->counter, led_blink_fast_rate);
+
+        case LED_BLINK_ONCE:
+            return cyclesToBlinkTimesX(led->counter, led_blink_once_rate);
+
+        case LED_BLINK_TWICE:
+            return cyclesToBlinkTimesX(led->counter, led_blick_twice_rate);
+
+        case LED_BLINK_THRICE:
+            return cyclesToBlinkTimesX(led->counter, led_blick_thrice_rate);
+        default:
+            return 0;
+    }
+}
+
+void procLedsTask(void* arg)
+{
+    // the process outlives its task
+    Proc_LedsBase&   process   = *static_cast<Proc_LedsBase*>(arg);
+    const TickType_t cycle     = pdMS_TO_TICKS(led_task_delay);
+    TickType_t       lastCycle = xTaskGetTickCount();
+
+    printf("Leds Task Started!\n");
+    for (;;)
+    {
+        // whole cycles since the last one, setLedState() may wake the task in between
+        uint32_t steps = (xTaskGetTickCount() - lastCycle) / cycle;
+        lastCycle += steps * cycle;
+
+        TRACE_BEGIN(LEDS_CYCLE, process.getLeds().size());
+        uint32_t next = process.update(steps);
+        TRACE_END(LEDS_CYCLE, process.getLeds().size());
+
+        // Block until the next LED change instead of polling, with tickless idle the CPU sleeps meanwhile.
+        // With no blinking LED only setLedState() wakes the task up.
+        TickType_t wait = portMAX_DELAY;
+        if (next == 0)
+        {
+            process.setNextDeadline(POWER_NO_DEADLINE);
+        }
+        else
+        {
+            TickType_t elapsed = xTaskGetTickCount() - lastCycle;
+            wait               = (next * cycle > elapsed) ? next * cycle - elapsed : 0;
+            process.setNextDeadline(esp_timer_get_time() + static_cast<uint64_t>(pdTICKS_TO_MS(wait)) * 1000);
+        }
+        ulTaskNotifyTake(pdTRUE, wait);
+        process.countWakeup();
+
+        if (next == 0)
+        {
+            // nothing was running, a new pattern is timed from now
+            lastCycle = xTaskGetTickCount();
         }
-        vTaskDelay(pdMS_TO_TICKS(led_task_delay));
     }
-}
\ No newline at end of file
+}
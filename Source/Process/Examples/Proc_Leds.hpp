@@ -8,8 +8,11 @@
 #ifndef PROC_LEDS_HPP
 #define PROC_LEDS_HPP
 
+#include "HAL/Common/io_port.hpp"
 #include "HAL/Platform/ESP32/io_gpio.hpp"
 #include "Process/IProcess.hpp"
+#include "System/rtosObjects.h"
+#include <atomic>
 #include <stdbool.h>
 #include <vector>
 
@@ -28,13 +31,13 @@ typedef enum : uint8_t
     LED_BLINK_THRICE = 7, // LED is blinking thrice
 } ledStateMachine;
 
-class Proc_Leds : public IProcess
+class Proc_LedsBase : public IProcess
 {
 public:
     // private members
     typedef struct
     {
-        io_gpio&        gpio;
+        IHAL_IO&        gpio; // io_gpio, or io_portPin to update a group of LEDs at once
         ledStateMachine state;
         uint8_t         onOff;
         uint32_t        counter;
@@ -42,20 +45,32 @@ public:
 
 private:
     std::vector<ledData*>& _leds;
-    TaskHandle_t           _taskHandle;
-    uint32_t               _stackSize;
     uint8_t                _taskPriority;
+    int8_t                 _core;
+    io_port**              _ports;
+    size_t                 _portCount;
+    std::atomic<uint64_t>  _nextDeadline; // us since boot, POWER_NO_DEADLINE while no LED blinks
+
+protected:
+    /**
+     * @brief Get the holder of the LED task, provided by Proc_Leds<StackSize>
+     *
+     * @return rtosTaskBase&
+     */
+    virtual rtosTaskBase& getTask() = 0;
 
 public:
     /**
-     * @brief Construct a new Proc_Leds object
+     * @brief Construct a new Proc_LedsBase object
      *
      * @param leds - vector of LED data
-     * @param stackSize - stack size (default 10000)
-     * @param taskPriority - task priority (default 10)
+     * @param taskPriority - task priority
+     * @param core - core of the LED task
+     * @param ports - ports of the io_portPin LEDs, flushed once per cycle (optional)
+     * @param portCount - number of ports
      */
-    Proc_Leds(std::vector<ledData*>& leds, uint32_t stackSize = 10000, uint8_t taskPriority = 10);
-    ~Proc_Leds();
+    Proc_LedsBase(std::vector<ledData*>& leds, uint8_t taskPriority, int8_t core, io_port** ports = nullptr, size_t portCount = 0);
+    ~Proc_LedsBase();
 
     sys_error_t start() override;
 
@@ -65,15 +80,81 @@ public:
 
     sys_error_t resume() override;
 
+    size_t getTasks(processTask_t* tasks, size_t maxTasks) override;
+
+    uint64_t getNextDeadline(uint64_t nowUs) override;
+
     /**
      * @brief Set the Led State object
+     * The LED task is woken up, the new pattern starts right away.
      *
      * @param led
      * @param state
      * @return sys_error_t
      */
     sys_error_t setLedState(ledData& led, ledStateMachine state);
+
+    /**
+     * @brief Get the LEDs handled by the process
+     *
+     * @return std::vector<ledData*>&
+     */
+    std::vector<ledData*>& getLeds();
+
+    /**
+     * @brief Advance all LEDs, run by the LED task each time it wakes up
+     * A blinking LED changes at most once per call, after a late wakeup its pattern continues from now.
+     *
+     * @param steps - LED cycles of 100 ms elapsed since the previous call
+     * @return uint32_t cycles until the next LED change, 0 if no LED changes on its own
+     */
+    uint32_t update(uint32_t steps);
+
+    /**
+     * @brief Set the time the LED task wakes up next, for getNextDeadline()
+     *
+     * @param deadline - us since boot, POWER_NO_DEADLINE if it waits for setLedState()
+     */
+    void setNextDeadline(uint64_t deadline);
+
+    /**
+     * @brief Write the LED levels staged in the ports during a cycle, one port write each
+     */
+    void flushPorts();
+};
+
+/**
+ * @brief LED process with the stack of its task
+ *
+ * @tparam StackSize - stack size of the LED task (default 10000)
+ */
+template <uint32_t StackSize = 10000> class Proc_Leds : public Proc_LedsBase
+{
+private:
+    rtosTask<StackSize> _task;
+
+protected:
+    rtosTaskBase& getTask() override
+    {
+        return _task;
+    }
+
+public:
+    /**
+     * @brief Construct a new Proc_Leds object
+     *
+     * @param leds - vector of LED data
+     * @param taskPriority - task priority (default lowest realtime I/O priority)
+     * @param core - core of the LED task (default TASK_CORE_APP, away from Wi-Fi)
+     * @param ports - ports of the io_portPin LEDs, flushed once per cycle (optional)
+     * @param portCount - number of ports
+     */
+    Proc_Leds(std::vector<ledData*>& leds, uint8_t taskPriority = taskBandPriority(TASK_BAND_REALTIME_IO), int8_t core = TASK_CORE_APP, io_port** ports = nullptr, size_t portCount = 0)
+        : Proc_LedsBase(leds, taskPriority, core, ports, portCount)
+    {
+    }
 };
+
 // which one makes more sense
 
 // Attach one task for each led and control their state depending on the blink state or
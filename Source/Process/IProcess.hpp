@@ -8,9 +8,25 @@
 #ifndef IPROCESS_HPP
 #define IPROCESS_HPP
 
+#include "Library/Diagnostics/flightRecorder.h"
+#include "Library/Power/powerManager.h"
 #include "System/system.h"
 
-class IProcess
+/**
+ * @brief Task created by a process
+ */
+typedef struct
+{
+    TaskHandle_t handle;
+    uint32_t     stackSize; // bytes
+} processTask_t;
+
+/**
+ * @brief Process interface
+ * As a power client a process reports the next time its tasks need the CPU, see getNextDeadline().
+ * State changes are kept in the flight recorder.
+ */
+class IProcess : public IPowerClient
 {
 public:
     enum class State
@@ -21,18 +37,35 @@ public:
         STOPPED,
     };
 
+    IProcess() : _state(State::INITIALIZED) {}
     virtual ~IProcess() {}
 
     virtual sys_error_t start()  = 0;
     virtual sys_error_t stop()   = 0;
     virtual sys_error_t pause()  = 0;
     virtual sys_error_t resume() = 0;
+
+    /**
+     * @brief Get the tasks the process is running, used for profiling
+     *
+     * @param tasks - output array
+     * @param maxTasks - size of the array
+     * @return size_t number of tasks written
+     */
+    virtual size_t getTasks(processTask_t* tasks, size_t maxTasks)
+    {
+        return 0;
+    }
+
     State               getState()
     {
         return _state;
     }
     void setState(State state)
     {
+        static const char* const stateNames[] = {"INITIALIZED", "RUNNING", "PAUSED", "STOPPED"};
+        uint16_t                 transition   = static_cast<uint16_t>((static_cast<unsigned>(_state) << 8) | static_cast<unsigned>(state));
+        flight().record(FLIGHT_PROCESS_STATE, transition, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(this)), stateNames[static_cast<unsigned>(state)]);
         _state = state;
     }
 
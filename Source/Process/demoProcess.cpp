@@ -12,44 +12,96 @@
 
 /** INCLUDES ******************************************************************/
 #include "demoProcess.h"
+#include "esp_log.h"
 
-using namespace std;
 const char* processTag = "Demo Process 1";
-const char* tagTask1   = "Task1";
 /** TYPEDEFS ******************************************************************/
 
 /** MACROS ********************************************************************/
 #define TASK_DEMO_DELAY_INTERVAL 1000 // ms
-#define TASK_DEMO_1_QUEUE_SIZE   5
 /** VARIABLES *****************************************************************/
 
-/** LOCAL FUNCTION DECLARATIONS ***********************************************/
-static void  Delay(void);
-static void  taskDemo1(void* pvParameters);
-TaskHandle_t xHandle;
+namespace
+{
+const demoParams_t demoParams = {
+    10, // dummyValue
+};
+
+DemoProcess<demoProcess::stackSize> demoInstance(demoParams, demoProcess::priority, demoProcess::core);
+} // namespace
 
 /** INTERFACE FUNCTION DEFINITIONS ********************************************/
 
-uint32_t DemoProcess::start()
+DemoProcessBase::DemoProcessBase(const demoParams_t& params, uint8_t taskPriority, int8_t core) : _params(params), _taskPriority(taskPriority), _core(core) {}
+
+DemoProcessBase::~DemoProcessBase()
+{
+    // destructor implementation
+}
+
+sys_error_t DemoProcessBase::start()
 {
     ESP_LOGI(processTag, " Process Started!");
-    demoParams_t*       params = (demoParams_t*)this->_parameters;
-    const demoConsts_t* consts = (demoConsts_t*)this->_constants;
+    RETURN_ON_ERROR(getTask().create(taskDemo, "Task1", static_cast<void*>(this), _taskPriority, _core));
+    setState(State::RUNNING);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t DemoProcessBase::stop()
+{
+    getTask().remove();
+    setState(State::STOPPED);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t DemoProcessBase::pause()
+{
+    getTask().suspend();
+    setState(State::PAUSED);
+    return ERROR_SUCCESS;
+}
 
-    return EXIT_SUCCESS;
+sys_error_t DemoProcessBase::resume()
+{
+    getTask().resume();
+    setState(State::RUNNING);
+    return ERROR_SUCCESS;
 }
 
-uint32_t DemoProcess::suspend()
+size_t DemoProcessBase::getTasks(processTask_t* tasks, size_t maxTasks)
 {
-    return EXIT_SUCCESS;
+    if (maxTasks == 0 || getTask().getHandle() == NULL)
+    {
+        return 0;
+    }
+    tasks[0].handle    = getTask().getHandle();
+    tasks[0].stackSize = getTask().getStackSize() * sizeof(StackType_t);
+    return 1;
 }
-uint32_t DemoProcess::resume()
+
+sys_error_t demoProcess::start()
 {
-    return EXIT_SUCCESS;
+    return demoInstance.start();
 }
-uint32_t DemoProcess::terminate()
+
+sys_error_t demoProcess::stop()
 {
-    return EXIT_SUCCESS;
+    return demoInstance.stop();
+}
+
+IProcess& demoProcess::instance()
+{
+    return demoInstance;
 }
 
 /** LOCAL FUNCTION DEFINITIONS ************************************************/
+
+void DemoProcessBase::taskDemo(void* arg)
+{
+    DemoProcessBase& process = *static_cast<DemoProcessBase*>(arg);
+    for (;;)
+    {
+        ESP_LOGI(processTag, "dummyValue: %u", static_cast<unsigned>(process._params.dummyValue));
+        vTaskDelay(pdMS_TO_TICKS(TASK_DEMO_DELAY_INTERVAL));
+    }
+}
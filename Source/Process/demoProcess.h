@@ -12,7 +12,10 @@
 #define FILE_DEMOPROCESS_H
 
 /** INCLUDES ******************************************************************/
-#include "system.h"
+#include "IProcess.hpp"
+#include "System/processRegistry.h"
+#include "System/rtosObjects.h"
+
 /** CONSTANTS *****************************************************************/
 
 /** TYPEDEFS ******************************************************************/
@@ -22,36 +25,64 @@ struct demoParams_t
     uint32_t dummyValue;
 };
 
-struct demoConsts_t
+/**
+ * @brief Demo process, template of a process booted by the processRegistry
+ */
+class DemoProcessBase : public IProcess
 {
-    const uint32_t constDummyValue;
+private:
+    const demoParams_t& _params;
+    uint8_t             _taskPriority;
+    int8_t              _core;
+
+    static void taskDemo(void* arg);
+
+protected:
+    virtual rtosTaskBase& getTask() = 0;
+
+public:
+    DemoProcessBase(const demoParams_t& params, uint8_t taskPriority, int8_t core);
+    ~DemoProcessBase();
+
+    sys_error_t start() override;
+    sys_error_t stop() override;
+    sys_error_t pause() override;
+    sys_error_t resume() override;
+    size_t      getTasks(processTask_t* tasks, size_t maxTasks) override;
 };
 
-class DemoProcess : public Process
+/**
+ * @brief Demo process with the stack of its task
+ *
+ * @tparam StackSize - stack size of the demo task
+ */
+template <uint32_t StackSize> class DemoProcess : public DemoProcessBase
 {
 private:
+    rtosTask<StackSize> _task;
+
+protected:
+    rtosTaskBase& getTask() override
+    {
+        return _task;
+    }
+
 public:
-    DemoProcess(/* args */) {}
-    ~DemoProcess() {}
-    uint32_t start();
-    uint32_t suspend();
-    uint32_t resume();
-    uint32_t terminate();
+    DemoProcess(const demoParams_t& params, uint8_t taskPriority, int8_t core = PROCESS_CORE_ANY) : DemoProcessBase(params, taskPriority, core) {}
 };
 
-#define PROCESS_DEMO_CREATE(_name, _enum)                                                                                                                                                              \
-    DemoProcess  _name;                                                                                                                                                                                \
-    demoParams_t _name##Params = {                                                                                                                                                                     \
-        .dummyValue = 10,                                                                                                                                                                              \
-    };                                                                                                                                                                                                 \
-    demoConsts_t _name##Consts = {                                                                                                                                                                     \
-        .constDummyValue = 0,                                                                                                                                                                          \
-    };
-
-// _name._state = eProcessStateIdle;
-// _name._ID = _enum;
-// _name._parameters = &_name##Params;
-// _name._constants = &_name##Consts;
+/**
+ * @brief Descriptor of the demo process for the processRegistry, replaces PROCESS_DEMO_CREATE
+ * The instance and its parameters are statically allocated in demoProcess.cpp.
+ */
+struct demoProcess : processTraits<0, 2048, 5, PROCESS_CORE_ANY, processDependencies<>::mask, demoParams_t>
+{
+    static constexpr const char* name = "demo";
+
+    static sys_error_t start();
+    static sys_error_t stop();
+    static IProcess&   instance();
+};
 
 /** MACROS ********************************************************************/
 
@@ -0,0 +1,83 @@
+/**
+ * @file proc_flight.cpp
+ * @brief Source file for proc_flight
+ *
+ * This file contains definitions for the proc_flight class and related data types and functions.
+ */
+
+#include "proc_flight.hpp"
+#include "HAL/Platform/ESP32/Library/logImpl.h"
+#include <esp_attr.h>
+#include <esp_system.h>
+
+namespace
+{
+// Not cleared by the startup code, keeps its content over software, panic and watchdog resets
+__NOINIT_ATTR uint32_t flightRegion[(FLIGHT_REGION_SIZE + 3) / 4];
+} // namespace
+
+proc_flight::proc_flight(IHAL_MEM* storage, uint32_t address) : _storage(storage), _address(address)
+{
+    _uri          = {};
+    _uri.uri      = "/debug/flight";
+    _uri.method   = HTTP_GET;
+    _uri.handler  = httpHandler;
+    _uri.user_ctx = static_cast<void*>(this);
+    setState(IProcess::State::INITIALIZED);
+}
+
+proc_flight::~proc_flight()
+{
+    // destructor implementation
+}
+
+sys_error_t proc_flight::start()
+{
+    if (!flight().isAttached())
+    {
+        RETURN_ON_ERROR(flight().attach(flightRegion, sizeof(flightRegion), static_cast<uint16_t>(esp_reset_reason())));
+        // The previous flight ends with the reset, keep it before the ring wraps around
+        if (flight().hadPreviousFlight() && _storage != nullptr && flight().persist(*_storage, _address) != ERROR_SUCCESS)
+        {
+            logger().log(ILog::LogLevel::WARNING, "Flight: previous flight could not be persisted!");
+        }
+    }
+    setState(IProcess::State::RUNNING);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t proc_flight::stop()
+{
+    // Recording continues, the region stays attached
+    setState(IProcess::State::STOPPED);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t proc_flight::pause()
+{
+    return ERROR_NOT_IMPLEMENTED;
+}
+
+sys_error_t proc_flight::resume()
+{
+    return ERROR_NOT_IMPLEMENTED;
+}
+
+const httpd_uri_t* proc_flight::getUriHandler()
+{
+    return &_uri;
+}
+
+esp_err_t proc_flight::httpHandler(httpd_req_t* req)
+{
+    httpd_resp_set_type(req, "text/plain");
+
+    // One chunk per record, the ring is read in place while it is written
+    bool sent = flight().print([req](const void* data, size_t length)
+                               { return httpd_resp_send_chunk(req, static_cast<const char*>(data), length) == ESP_OK; });
+    if (!sent)
+    {
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
@@ -0,0 +1,65 @@
+/**
+ * @file proc_flight.hpp
+ * @brief Header file for proc_flight
+ *
+ * This file contains declarations for the proc_flight class and related data types and functions.
+ */
+
+#ifndef PROC_FLIGHT_HPP
+#define PROC_FLIGHT_HPP
+
+#include "IProcess.hpp"
+#include "Library/Diagnostics/flightRecorder.h"
+#include <esp_http_server.h>
+
+/**
+ * @brief Flight recorder process
+ *
+ * Attaches flight() to a region the startup code does not clear, so the last FLIGHT_RECORDS events (log records,
+ * process states, Wi-Fi events, HTTP requests) survive a panic, watchdog or software reset; a power loss clears
+ * them. After such a reset the previous flight is written to storage, if given, before new records overwrite it.
+ * The records are served as text at /debug/flight. The process has no task.
+ */
+class proc_flight : public IProcess
+{
+private:
+    IHAL_MEM*   _storage;
+    uint32_t    _address;
+    httpd_uri_t _uri;
+
+    static esp_err_t httpHandler(httpd_req_t* req);
+
+public:
+    /**
+     * @brief Construct a new proc_flight object
+     *
+     * @param storage - device the previous flight is persisted to, nullptr to keep it in memory only (optional)
+     * @param address - dump address on the device, sector aligned
+     */
+    proc_flight(IHAL_MEM* storage = nullptr, uint32_t address = 0);
+    ~proc_flight();
+
+    // Delete copy constructor and assignment operator
+    proc_flight(const proc_flight&)            = delete;
+    proc_flight& operator=(const proc_flight&) = delete;
+
+    /**
+     * @brief Attach the recorder, start it before the other processes so their states are recorded
+     */
+    sys_error_t start() override;
+
+    sys_error_t stop() override;
+
+    sys_error_t pause() override;
+
+    sys_error_t resume() override;
+
+    /**
+     * @brief Get the GET /debug/flight handler, to be added with proc_httpServer::addUriHandler()
+     *
+     * @return const httpd_uri_t*
+     */
+    const httpd_uri_t* getUriHandler();
+};
+
+#endif /* PROC_FLIGHT_HPP */
@@ -6,37 +6,75 @@
  */
 
 #include "proc_httpServer.hpp"
-#include "Library/UI/HTTP/ui_welcome_wifi_connect.h"
+#include "Library/Diagnostics/flightRecorder.h"
+#include "Library/Diagnostics/trace.h"
+#include "Library/UI/HTTP/ui_routes.h"
 // #include "Library/UI/HTTP/output_test1.h"
+#include "System/memoryPool.h"
+#include "System/metrics.h"
 #include "protocol_examples_utils.h"
 #include <esp_log.h>
 #include <sstream>
 #include <stdlib.h>
+#include <unistd.h>
 
 static const char* TAG = "example";
 #define MIN(x, y)                      ((x) < (y) ? (x) : (y))
 #define EXAMPLE_HTTP_QUERY_KEY_MAX_LEN (64)
 
+static metricCounter welcomeRequests("http_requests_total", "HTTP requests by URI", "uri=\"/welcome\"");
+static metricCounter connectRequests("http_requests_total", "HTTP requests by URI", "uri=\"/connect\"");
+static metricCounter ctrlRequests("http_requests_total", "HTTP requests by URI", "uri=\"/ctrl\"");
+static metricCounter metricsRequests("http_requests_total", "HTTP requests by URI", "uri=\"/metrics\"");
+static metricCounter httpSessions("http_sessions_total", "HTTP client sessions opened");
+static metricGauge   httpSessionsOpen("http_sessions_open", "HTTP client sessions currently open");
+
 static esp_err_t welcome_get_handler(httpd_req_t* req);
 static esp_err_t connect_post_handler(httpd_req_t* req);
 static esp_err_t ctrl_put_handler(httpd_req_t* req);
-
-static const httpd_uri_t welcome = {.uri     = "/welcome",
-                                    .method  = HTTP_GET,
-                                    .handler = welcome_get_handler,
-                                    /* Let's pass response string in user
-                                     * context to demonstrate it's usage */
-                                    .user_ctx = (void*)(HTML_UI_WELCOME_WIFI_CONNECT_CONTENT)};
+static esp_err_t session_open_handler(httpd_handle_t handle, int sockfd);
+static void      session_close_handler(httpd_handle_t handle, int sockfd);
+static void      wifi_ctx_free(void* ctx);
+static esp_err_t metrics_get_handler(httpd_req_t* req);
+static bool      metrics_chunk_writer(void* context, const char* data, size_t length);
+static void      flight_request(httpd_req_t* req);
+#if TRACE_ENABLED
+static esp_err_t trace_get_handler(httpd_req_t* req);
+#endif
+
+// The answers of /welcome, /connect and /ctrl come from Library/UI/HTTP/ui_routes.h, shared with the host load harness
+static const httpd_uri_t welcome = {.uri = "/welcome", .method = HTTP_GET, .handler = welcome_get_handler, .user_ctx = NULL};
 
 static const httpd_uri_t connect = {.uri = "/connect", .method = HTTP_POST, .handler = connect_post_handler, .user_ctx = NULL};
 
 static const httpd_uri_t ctrl = {.uri = "/ctrl", .method = HTTP_PUT, .handler = ctrl_put_handler, .user_ctx = NULL};
 
-proc_httpServer::proc_httpServer()
+// Prometheus text exposition of all registered metrics, see System/metrics.h
+static const httpd_uri_t metricsUri = {.uri = "/metrics", .method = HTTP_GET, .handler = metrics_get_handler, .user_ctx = NULL};
+
+#if TRACE_ENABLED
+// Binary dump of the trace buffer, converted by Scripts/trace_to_chrome.py
+static const httpd_uri_t trace = {.uri = "/debug/trace", .method = HTTP_GET, .handler = trace_get_handler, .user_ctx = NULL};
+#endif
+
+proc_httpServer::proc_httpServer(cpx_wifi* wifi, uint8_t taskPriority, int8_t core)
 {
     _server                  = NULL;
+    _wifi                    = wifi;
+    _extraUriCount           = 0;
     _config                  = HTTPD_DEFAULT_CONFIG();
     _config.lru_purge_enable = true;
+    _config.task_priority    = taskPriority;
+    _config.core_id          = (core >= 0 && core < portNUM_PROCESSORS) ? static_cast<BaseType_t>(core) : tskNO_AFFINITY;
+
+    // Sessions are counted, and keep the radio out of power save while at least one is open
+    _config.open_fn  = session_open_handler;
+    _config.close_fn = session_close_handler;
+    if (_wifi != nullptr)
+    {
+        _config.global_user_ctx         = static_cast<void*>(_wifi);
+        _config.global_user_ctx_free_fn = wifi_ctx_free;
+    }
     setState(IProcess::State::INITIALIZED);
 }
 
@@ -58,6 +96,14 @@ sys_error_t proc_httpServer::start()
         httpd_register_uri_handler(_server, &welcome);
         httpd_register_uri_handler(_server, &connect);
         httpd_register_uri_handler(_server, &ctrl);
+        httpd_register_uri_handler(_server, &metricsUri);
+#if TRACE_ENABLED
+        httpd_register_uri_handler(_server, &trace);
+#endif
+        for (size_t i = 0; i < _extraUriCount; i++)
+        {
+            httpd_register_uri_handler(_server, _extraUris[i]);
+        }
         setState(IProcess::State::RUNNING);
     }
     else
@@ -85,9 +131,73 @@ sys_error_t proc_httpServer::resume()
     return ERROR_NOT_IMPLEMENTED;
 }
 
+size_t proc_httpServer::getTasks(processTask_t* tasks, size_t maxTasks)
+{
+    // The server task is created by esp_http_server under the name "httpd"
+    TaskHandle_t handle = (_server != NULL) ? xTaskGetHandle("httpd") : NULL;
+    if (maxTasks == 0 || handle == NULL)
+    {
+        return 0;
+    }
+    tasks[0].handle    = handle;
+    tasks[0].stackSize = _config.stack_size;
+    return 1;
+}
+
+sys_error_t proc_httpServer::addUriHandler(const httpd_uri_t* uri)
+{
+    if (_extraUriCount >= HTTP_SERVER_MAX_EXTRA_URIS)
+    {
+        return ERROR_OUT_OF_MEMORY;
+    }
+    _extraUris[_extraUriCount++] = uri;
+    if (_server != NULL && httpd_register_uri_handler(_server, uri) != ESP_OK)
+    {
+        return ERROR_FAIL;
+    }
+    return ERROR_SUCCESS;
+}
+
+uint16_t proc_httpServer::getPort()
+{
+    return _config.server_port;
+}
+
+/* Called by httpd for every new client socket */
+static esp_err_t session_open_handler(httpd_handle_t handle, int sockfd)
+{
+    httpSessions.inc();
+    httpSessionsOpen.inc();
+    cpx_wifi* wifi = static_cast<cpx_wifi*>(httpd_get_global_user_ctx(handle));
+    if (wifi != nullptr)
+    {
+        wifi->requestLowLatency();
+    }
+    return ESP_OK;
+}
+
+/* Called by httpd when a client socket is closed, including LRU purges.
+ * Once close_fn is set, closing the socket is up to the handler. */
+static void session_close_handler(httpd_handle_t handle, int sockfd)
+{
+    httpSessionsOpen.dec();
+    cpx_wifi* wifi = static_cast<cpx_wifi*>(httpd_get_global_user_ctx(handle));
+    if (wifi != nullptr)
+    {
+        wifi->releaseLowLatency();
+    }
+    close(sockfd);
+}
+
+/* The wifi driver is not owned by httpd, it must not be freed on httpd_stop() */
+static void wifi_ctx_free(void* ctx) {}
+
 /* An HTTP GET handler */
 static esp_err_t welcome_get_handler(httpd_req_t* req)
 {
+    TRACE_SCOPE(HTTP_WELCOME, 0);
+    welcomeRequests.inc();
+    flight_request(req);
     char*  buf;
     size_t buf_len;
 
@@ -96,35 +206,35 @@ static esp_err_t welcome_get_handler(httpd_req_t* req)
     buf_len = httpd_req_get_hdr_value_len(req, "Host") + 1;
     if (buf_len > 1)
     {
-        buf = (char*)(malloc(buf_len));
+        buf = static_cast<char*>(systemPools().allocate(buf_len));
         /* Copy null terminated value string into buffer */
         if (httpd_req_get_hdr_value_str(req, "Host", buf, buf_len) == ESP_OK)
         {
             ESP_LOGI(TAG, "Found header => Host: %s", buf);
         }
-        free(buf);
+        systemPools().release(buf);
     }
 
     buf_len = httpd_req_get_hdr_value_len(req, "Test-Header-2") + 1;
     if (buf_len > 1)
     {
-        buf = (char*)(malloc(buf_len));
+        buf = static_cast<char*>(systemPools().allocate(buf_len));
         if (httpd_req_get_hdr_value_str(req, "Test-Header-2", buf, buf_len) == ESP_OK)
         {
             ESP_LOGI(TAG, "Found header => Test-Header-2: %s", buf);
         }
-        free(buf);
+        systemPools().release(buf);
     }
 
     buf_len = httpd_req_get_hdr_value_len(req, "Test-Header-1") + 1;
     if (buf_len > 1)
     {
-        buf = (char*)(malloc(buf_len));
+        buf = static_cast<char*>(systemPools().allocate(buf_len));
         if (httpd_req_get_hdr_value_str(req, "Test-Header-1", buf, buf_len) == ESP_OK)
         {
             ESP_LOGI(TAG, "Found header => Test-Header-1: %s", buf);
         }
-        free(buf);
+        systemPools().release(buf);
     }
 
     /* Read URL query string length and allocate memory for length + 1,
@@ -132,7 +242,7 @@ static esp_err_t welcome_get_handler(httpd_req_t* req)
     buf_len = httpd_req_get_url_query_len(req) + 1;
     if (buf_len > 1)
     {
-        buf = (char*)(malloc(buf_len));
+        buf = static_cast<char*>(systemPools().allocate(buf_len));
         if (httpd_req_get_url_query_str(req, buf, buf_len) == ESP_OK)
         {
             ESP_LOGI(TAG, "Found URL query => %s", buf);
@@ -157,17 +267,16 @@ static esp_err_t welcome_get_handler(httpd_req_t* req)
                 ESP_LOGI(TAG, "Decoded query parameter => %s", dec_param);
             }
         }
-        free(buf);
+        systemPools().release(buf);
     }
 
     /* Set some custom headers */
     httpd_resp_set_hdr(req, "Custom-Header-1", "Custom-Value-1");
     httpd_resp_set_hdr(req, "Custom-Header-2", "Custom-Value-2");
 
-    /* Send response with custom headers and body set as the
-     * string passed in user context*/
-    const char* resp_str = (const char*)req->user_ctx;
-    httpd_resp_send(req, resp_str, HTTPD_RESP_USE_STRLEN);
+    /* Send response with custom headers */
+    uiRouteResponse_t response = uiWelcomeRoute();
+    httpd_resp_send(req, response.body, HTTPD_RESP_USE_STRLEN);
 
     /* After sending the HTTP response the old HTTP request
      * headers are lost. Check if HTTP request headers can be read now. */
@@ -181,14 +290,22 @@ static esp_err_t welcome_get_handler(httpd_req_t* req)
 /* An HTTP POST handler */
 static esp_err_t connect_post_handler(httpd_req_t* req)
 {
-    char ssid[32], password[32];
+    TRACE_SCOPE(HTTP_CONNECT, req->content_len);
+    connectRequests.inc();
+    flight_request(req);
+    uiCredentials_t credentials;
 
     ESP_LOGI(TAG, "POST HANDLER TRIGGERED");
-    char content[256];
-    int  ret, remaining = req->content_len;
-    while (remaining > 0)
+    if (req->content_len >= UI_CONNECT_FORM_SIZE)
+    {
+        httpd_resp_send_500(req);
+        return ESP_FAIL;
+    }
+    char content[UI_CONNECT_FORM_SIZE];
+    int  ret, received = 0;
+    while (received < static_cast<int>(req->content_len))
     {
-        if ((ret = httpd_req_recv(req, content, MIN(remaining, sizeof(content)))) <= 0)
+        if ((ret = httpd_req_recv(req, content + received, req->content_len - received)) <= 0)
         {
             if (ret == HTTPD_SOCK_ERR_TIMEOUT)
             {
@@ -196,24 +313,19 @@ static esp_err_t connect_post_handler(httpd_req_t* req)
             }
             return ESP_FAIL;
         }
-        remaining -= ret;
+        received += ret;
     }
-    content[req->content_len] = '\0'; // null-terminate the received data
 
-    if (httpd_query_key_value(content, "ssid", ssid, sizeof(ssid)) == ESP_OK && httpd_query_key_value(content, "password", password, sizeof(password)) == ESP_OK)
-    {
-        // Do something with the received data, e.g. connect to the specified WiFi network
-        ESP_LOGI(TAG, "Received SSID: %s, password: %s", ssid, password);
-        // ...
-        httpd_resp_send(req, "Connected", HTTPD_RESP_USE_STRLEN);
-        return ESP_OK;
-    }
-    else
+    uiRouteResponse_t response = uiConnectRoute(content, received, credentials);
+    if (response.status != 200)
     {
         httpd_resp_send_500(req);
         return ESP_FAIL;
     }
-
+    // Do something with the received data, e.g. connect to the specified WiFi network
+    ESP_LOGI(TAG, "Received SSID: %s, password: %s", credentials.ssid, credentials.password);
+    // ...
+    httpd_resp_send(req, response.body, HTTPD_RESP_USE_STRLEN);
     return ESP_OK;
 }
 // httpd_query_key_value(req->uri, "ssid", ssid, sizeof(ssid));
@@ -290,6 +402,9 @@ esp_err_t http_404_error_handler(httpd_req_t* req, httpd_err_code_t err)
  */
 static esp_err_t ctrl_put_handler(httpd_req_t* req)
 {
+    TRACE_SCOPE(HTTP_CTRL, req->content_len);
+    ctrlRequests.inc();
+    flight_request(req);
     char buf;
     int  ret;
 
@@ -302,7 +417,9 @@ static esp_err_t ctrl_put_handler(httpd_req_t* req)
         return ESP_FAIL;
     }
 
-    if (buf == '0')
+    bool routesEnabled = true;
+    uiCtrlRoute(&buf, 1, routesEnabled);
+    if (!routesEnabled)
     {
         /* URI handlers can be unregistered using the uri string */
         ESP_LOGI(TAG, "Unregistering /welcome and /connect URIs");
@@ -324,3 +441,46 @@ static esp_err_t ctrl_put_handler(httpd_req_t* req)
     httpd_resp_send(req, NULL, 0);
     return ESP_OK;
 }
+
+#if TRACE_ENABLED
+static esp_err_t trace_get_handler(httpd_req_t* req)
+{
+    TRACE_INSTANT(HTTP_TRACE_DUMP, 0);
+    flight_request(req);
+    httpd_resp_set_type(req, "application/octet-stream");
+    httpd_resp_set_hdr(req, "Content-Disposition", "attachment; filename=\"trace.bin\"");
+
+    // Recording is paused while the rings are streamed out in place
+    bool sent = tracer().serialize([req](const void* data, size_t length)
+                                   { return httpd_resp_send_chunk(req, static_cast<const char*>(data), length) == ESP_OK; });
+    if (!sent)
+    {
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+#endif
+
+/* Keeps the request in the flight recorder, the URI is cut to FLIGHT_TEXT_SIZE characters */
+static void flight_request(httpd_req_t* req)
+{
+    flight().record(FLIGHT_HTTP, static_cast<uint16_t>(req->method), static_cast<uint32_t>(req->content_len), req->uri);
+}
+
+/* Streams the exposition into the response, one chunk per line */
+static bool metrics_chunk_writer(void* context, const char* data, size_t length)
+{
+    return httpd_resp_send_chunk(static_cast<httpd_req_t*>(context), data, length) == ESP_OK;
+}
+
+static esp_err_t metrics_get_handler(httpd_req_t* req)
+{
+    metricsRequests.inc();
+    flight_request(req);
+    httpd_resp_set_type(req, "text/plain; version=0.0.4");
+    if (!metrics().render(metrics_chunk_writer, static_cast<void*>(req)))
+    {
+        return ESP_FAIL;
+    }
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
@@ -8,17 +8,31 @@
 #ifndef PROC_HTTPSERVER_HPP
 #define PROC_HTTPSERVER_HPP
 
+#include "HAL/Platform/ESP32/cpx_wifi.h"
 #include "IProcess.hpp"
+#include "System/taskBands.h"
 #include <esp_http_server.h>
 
+#define HTTP_SERVER_MAX_EXTRA_URIS 4 // handlers added by other processes, the default config allows 8 in total
+
 class proc_httpServer : public IProcess
 {
 private:
-    httpd_handle_t _server;
-    httpd_config_t _config;
+    httpd_handle_t     _server;
+    httpd_config_t     _config;
+    cpx_wifi*          _wifi;
+    const httpd_uri_t* _extraUris[HTTP_SERVER_MAX_EXTRA_URIS];
+    size_t             _extraUriCount;
 
 public:
-    proc_httpServer();
+    /**
+     * @brief Construct a new proc_httpServer object
+     *
+     * @param wifi - optional wifi driver, a low-latency boost is held on it while clients are connected
+     * @param taskPriority - priority of the server task (default lowest network priority)
+     * @param core - core of the server task (default TASK_CORE_PROTOCOL, next to the Wi-Fi stack)
+     */
+    proc_httpServer(cpx_wifi* wifi = nullptr, uint8_t taskPriority = taskBandPriority(TASK_BAND_NETWORK), int8_t core = TASK_CORE_PROTOCOL);
     ~proc_httpServer();
 
     sys_error_t start() override;
@@ -28,6 +42,23 @@ public:
     sys_error_t pause() override;
 
     sys_error_t resume() override;
+
+    size_t getTasks(processTask_t* tasks, size_t maxTasks) override;
+
+    /**
+     * @brief Add a URI handler served by this server, e.g. a diagnostics endpoint of another process
+     *
+     * @param uri - handler description, must stay valid while the server runs
+     * @return sys_error_t ERROR_OUT_OF_MEMORY if HTTP_SERVER_MAX_EXTRA_URIS handlers were added already
+     */
+    sys_error_t addUriHandler(const httpd_uri_t* uri);
+
+    /**
+     * @brief Get the TCP port the server listens on
+     *
+     * @return uint16_t
+     */
+    uint16_t getPort();
 };
 
 #endif /* PROC_HTTPSERVER_HPP */
@@ -0,0 +1,173 @@
+/**
+ * @file proc_mdns.cpp
+ * @brief Source file for proc_mdns
+ *
+ * This file contains definitions for the proc_mdns class and related data types and functions.
+ */
+
+#include "proc_mdns.hpp"
+#include "HAL/Platform/ESP32/Library/logImpl.h"
+#include "Library/Common/helperConversions.h"
+#include <algorithm>
+#include <esp_app_desc.h>
+#include <esp_mac.h>
+#include <esp_netif.h>
+#include <esp_timer.h>
+#include <string.h>
+
+namespace
+{
+mdnsConfig_t serverConfig(proc_httpServer& server, const char* hostname, const char* instance)
+{
+    mdnsConfig_t config = mdnsDefaultConfig();
+    config.hostname     = hostname;
+    config.instance     = instance;
+    config.port         = server.getPort();
+    return config;
+}
+} // namespace
+
+proc_mdns::proc_mdns(proc_httpServer& server, const char* hostname, const char* instance, const char* capabilities, uint8_t taskPriority, int8_t core)
+    : _transport(MDNS_GROUP, MDNS_PORT), _responder(_transport, serverConfig(server, hostname, instance)), _address(), _connected(false), _taskPriority(taskPriority), _core(core),
+      _deadlineUs(POWER_NO_DEADLINE), _ipEvent(nullptr)
+{
+    uint8_t mac[6] = {0};
+    esp_read_mac(mac, ESP_MAC_WIFI_STA);
+    _responder.addTxt("fw", esp_app_get_description()->version);
+    _responder.addTxt("mac", mac::convertToMac(mac).c_str());
+    _responder.addTxt("caps", capabilities);
+    setState(IProcess::State::INITIALIZED);
+}
+
+proc_mdns::~proc_mdns()
+{
+    // destructor implementation
+}
+
+sys_error_t proc_mdns::start()
+{
+    RETURN_ON_ERROR(_task.create(mdnsTask, "mdns_task", static_cast<void*>(this), _taskPriority, _core));
+    if (esp_event_handler_instance_register(IP_EVENT, IP_EVENT_STA_GOT_IP, ipEventHandler, static_cast<void*>(this), &_ipEvent) != ESP_OK)
+    {
+        _task.remove();
+        return ERROR_INIT_FAILED;
+    }
+    setState(IProcess::State::RUNNING);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t proc_mdns::stop()
+{
+    esp_event_handler_instance_unregister(IP_EVENT, IP_EVENT_STA_GOT_IP, _ipEvent);
+    _task.remove();
+
+    // Browsers drop the records at once instead of after their TTL
+    if (_connected)
+    {
+        _responder.goodbye();
+    }
+    _transport.disconnect();
+    _connected = false;
+    memset(_address, 0, sizeof(_address));
+    setState(IProcess::State::STOPPED);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t proc_mdns::pause()
+{
+    _task.suspend();
+    setState(IProcess::State::PAUSED);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t proc_mdns::resume()
+{
+    _task.resume();
+    setState(IProcess::State::RUNNING);
+    return ERROR_SUCCESS;
+}
+
+size_t proc_mdns::getTasks(processTask_t* tasks, size_t maxTasks)
+{
+    if (maxTasks == 0 || _task.getHandle() == NULL)
+    {
+        return 0;
+    }
+    tasks[0].handle    = _task.getHandle();
+    tasks[0].stackSize = _task.getStackSize() * sizeof(StackType_t);
+    return 1;
+}
+
+uint64_t proc_mdns::getNextDeadline(uint64_t nowUs)
+{
+    return __atomic_load_n(&_deadlineUs, __ATOMIC_RELAXED);
+}
+
+mdnsStats_t proc_mdns::getStats()
+{
+    return _responder.getStats();
+}
+
+void proc_mdns::ipEventHandler(void* arg, esp_event_base_t eventBase, int32_t eventId, void* eventData)
+{
+    static_cast<proc_mdns*>(arg)->_task.notify();
+}
+
+bool proc_mdns::readAddress(uint8_t address[4])
+{
+    esp_netif_ip_info_t info;
+    esp_netif_t*        netif = esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
+    if (netif == nullptr || esp_netif_get_ip_info(netif, &info) != ESP_OK || info.ip.addr == 0)
+    {
+        return false;
+    }
+    // Stored in network order, the first byte is the most significant one
+    memcpy(address, &info.ip.addr, 4);
+    return true;
+}
+
+void proc_mdns::mdnsTask(void* arg)
+{
+    proc_mdns& process = *static_cast<proc_mdns*>(arg);
+    for (;;)
+    {
+        uint8_t address[4];
+        if (!readAddress(address))
+        {
+            // No address: nothing to announce, the IP event wakes the task
+            process._transport.disconnect();
+            process._connected = false;
+            memset(process._address, 0, sizeof(process._address));
+            __atomic_store_n(&process._deadlineUs, POWER_NO_DEADLINE, __ATOMIC_RELAXED);
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            process.countWakeup();
+            continue;
+        }
+
+        uint64_t nowUs = static_cast<uint64_t>(esp_timer_get_time());
+        uint32_t nowMs = static_cast<uint32_t>(nowUs / 1000);
+        if (memcmp(address, process._address, sizeof(address)) != 0)
+        {
+            // Joined again on the new address, then the records are announced
+            process._transport.disconnect();
+            process._connected = (process._transport.connect() == ERROR_SUCCESS);
+            if (!process._connected)
+            {
+                ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(MDNS_CONNECT_RETRY_MS));
+                process.countWakeup();
+                continue;
+            }
+            memcpy(process._address, address, sizeof(address));
+            if (process._responder.setAddress(address, nowMs) != ERROR_SUCCESS)
+            {
+                logger().log(ILog::LogLevel::ERROR, "mDNS: records do not fit a packet");
+            }
+        }
+
+        process._responder.poll(nowMs);
+        uint32_t delayMs = std::min<uint32_t>(process._responder.getNextDelayMs(nowMs), MDNS_ADDRESS_CHECK_MS);
+        __atomic_store_n(&process._deadlineUs, nowUs + static_cast<uint64_t>(delayMs) * 1000, __ATOMIC_RELAXED);
+        process._transport.waitReadable(delayMs);
+        process.countWakeup();
+    }
+}
@@ -0,0 +1,89 @@
+/**
+ * @file proc_mdns.hpp
+ * @brief Header file for proc_mdns
+ *
+ * This file contains declarations for the proc_mdns class and related data types and functions.
+ */
+
+#ifndef PROC_MDNS_HPP
+#define PROC_MDNS_HPP
+
+#include "HAL/Platform/ESP32/net_multicast.hpp"
+#include "IProcess.hpp"
+#include "Library/Protocol/mdnsResponder.h"
+#include "Process/proc_httpServer.hpp"
+#include "System/rtosObjects.h"
+#include <esp_event.h>
+
+#define MDNS_STACK_SIZE         6144
+#define MDNS_ADDRESS_CHECK_MS   10000 // the station address is compared at least this often
+#define MDNS_CONNECT_RETRY_MS   1000
+#define MDNS_DEFAULT_CAPABILITY "http,metrics"
+
+/**
+ * @brief mDNS process advertising the HTTP server
+ *
+ * Publishes "<instance>._http._tcp.local" on the port of proc_httpServer and "<hostname>.local" with the station
+ * address, so tools find the device with any DNS-SD browser (e.g. "avahi-browse -r _http._tcp" or "mdns_browse")
+ * instead of scanning the subnet. The TXT record carries the firmware version (fw), the station MAC (mac) and the
+ * capabilities (caps). Queries are answered from the response cache of mdnsResponder; the task sleeps in the socket
+ * until a packet arrives or an announcement is due and is woken when the station gets an address.
+ */
+class proc_mdns : public IProcess
+{
+private:
+    net_multicast                _transport;
+    mdnsResponder                _responder;
+    uint8_t                      _address[4]; // announced address, 0.0.0.0 while the station has none
+    bool                         _connected;
+    uint8_t                      _taskPriority;
+    int8_t                       _core;
+    uint64_t                     _deadlineUs;
+    esp_event_handler_instance_t _ipEvent;
+
+    rtosTask<MDNS_STACK_SIZE> _task;
+
+    static void mdnsTask(void* arg);
+    static void ipEventHandler(void* arg, esp_event_base_t eventBase, int32_t eventId, void* eventData);
+    static bool readAddress(uint8_t address[4]);
+
+public:
+    /**
+     * @brief Construct a new proc_mdns object
+     *
+     * @param server - HTTP server to advertise, its port is published
+     * @param hostname - host label, "<hostname>.local"
+     * @param instance - service instance name shown by browsers
+     * @param capabilities - value of the caps TXT key (default "http,metrics")
+     * @param taskPriority - task priority (default lowest background priority)
+     * @param core - core of the task (default PROCESS_CORE_ANY)
+     */
+    proc_mdns(proc_httpServer& server, const char* hostname, const char* instance, const char* capabilities = MDNS_DEFAULT_CAPABILITY,
+              uint8_t taskPriority = taskBandPriority(TASK_BAND_BACKGROUND), int8_t core = PROCESS_CORE_ANY);
+    ~proc_mdns();
+
+    // Delete copy constructor and assignment operator
+    proc_mdns(const proc_mdns&)            = delete;
+    proc_mdns& operator=(const proc_mdns&) = delete;
+
+    sys_error_t start() override;
+
+    sys_error_t stop() override;
+
+    sys_error_t pause() override;
+
+    sys_error_t resume() override;
+
+    size_t getTasks(processTask_t* tasks, size_t maxTasks) override;
+
+    uint64_t getNextDeadline(uint64_t nowUs) override;
+
+    /**
+     * @brief Get the counters of the responder
+     *
+     * @return mdnsStats_t
+     */
+    mdnsStats_t getStats();
+};
+
+#endif /* PROC_MDNS_HPP */
@@ -0,0 +1,168 @@
+/**
+ * @file proc_mqtt.cpp
+ * @brief Source file for proc_mqtt
+ *
+ * This file contains definitions for the proc_mqtt class and related data types and functions.
+ */
+
+#include "proc_mqtt.hpp"
+#include "HAL/Platform/ESP32/Library/logImpl.h"
+#include <esp_timer.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace
+{
+const char* const ledStateNames[] = {"off", "on", "blink_slow", "blink", "blink_fast", "blink_once", "blink_twice", "blink_thrice"}; // ledStateMachine order
+} // namespace
+
+proc_mqtt::proc_mqtt(const char* host, const char* prefix, Proc_ButtonBase* buttons, Proc_LedsBase* leds, uint16_t port, const mqttConfig_t& config, uint8_t taskPriority,
+                     int8_t core)
+    : _transport(host, port), _client(_transport, config), _buttons(buttons), _leds(leds), _taskPriority(taskPriority), _core(core), _deadlineUs(POWER_NO_DEADLINE)
+{
+    snprintf(_prefix, sizeof(_prefix), "%s", (prefix != nullptr) ? prefix : "");
+    if (_buttons != nullptr)
+    {
+        _buttons->setPressHandler(onPress, static_cast<void*>(this));
+    }
+    if (_leds != nullptr)
+    {
+        char filter[MQTT_FILTER_SIZE];
+        snprintf(filter, sizeof(filter), "%s/led/+/set", _prefix);
+        _client.setMessageHandler(onMessage, static_cast<void*>(this));
+        _client.subscribe(filter);
+    }
+    setState(IProcess::State::INITIALIZED);
+}
+
+proc_mqtt::~proc_mqtt()
+{
+    // destructor implementation
+}
+
+sys_error_t proc_mqtt::start()
+{
+    RETURN_ON_ERROR(_transport.initWake());
+    RETURN_ON_ERROR(_task.create(mqttTask, "mqtt_task", static_cast<void*>(this), _taskPriority, _core));
+    setState(IProcess::State::RUNNING);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t proc_mqtt::stop()
+{
+    _task.remove();
+    _transport.disconnect();
+    setState(IProcess::State::STOPPED);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t proc_mqtt::pause()
+{
+    // Presses keep being queued, the broker drops the connection after the keep alive
+    _task.suspend();
+    setState(IProcess::State::PAUSED);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t proc_mqtt::resume()
+{
+    _task.resume();
+    setState(IProcess::State::RUNNING);
+    return ERROR_SUCCESS;
+}
+
+size_t proc_mqtt::getTasks(processTask_t* tasks, size_t maxTasks)
+{
+    if (maxTasks == 0 || _task.getHandle() == NULL)
+    {
+        return 0;
+    }
+    tasks[0].handle    = _task.getHandle();
+    tasks[0].stackSize = _task.getStackSize() * sizeof(StackType_t);
+    return 1;
+}
+
+uint64_t proc_mqtt::getNextDeadline(uint64_t nowUs)
+{
+    return __atomic_load_n(&_deadlineUs, __ATOMIC_RELAXED);
+}
+
+mqttClient& proc_mqtt::getClient()
+{
+    return _client;
+}
+
+mqttStats_t proc_mqtt::getStats()
+{
+    return _client.getStats();
+}
+
+void proc_mqtt::onPress(size_t index, uint32_t durationMs, void* context)
+{
+    proc_mqtt& process = *static_cast<proc_mqtt*>(context);
+    char       topic[MQTT_PREFIX_SIZE + 24];
+    char       payload[12];
+    snprintf(topic, sizeof(topic), "%s/button/%u", process._prefix, static_cast<unsigned>(index));
+    int length = snprintf(payload, sizeof(payload), "%u", static_cast<unsigned>(durationMs));
+
+    // Queued even while offline, dropped only when the queue is full
+    if (process._client.publish(topic, payload, static_cast<size_t>(length), 1) == ERROR_SUCCESS)
+    {
+        process._transport.wake();
+    }
+}
+
+void proc_mqtt::onMessage(const char* topic, size_t topicLength, const uint8_t* payload, size_t length, void* context)
+{
+    proc_mqtt& process      = *static_cast<proc_mqtt*>(context);
+    size_t     prefixLength = strlen(process._prefix);
+
+    // <prefix>/led/<index>/set
+    if (topicLength < prefixLength + 9 || memcmp(topic, process._prefix, prefixLength) != 0 || memcmp(topic + prefixLength, "/led/", 5) != 0)
+    {
+        return;
+    }
+    size_t position = prefixLength + 5;
+    size_t index    = 0;
+    size_t digits   = 0;
+    for (; position < topicLength && topic[position] >= '0' && topic[position] <= '9' && digits < 3; position++, digits++)
+    {
+        index = index * 10 + static_cast<size_t>(topic[position] - '0');
+    }
+    if (digits == 0 || topicLength - position != 4 || memcmp(topic + position, "/set", 4) != 0)
+    {
+        return;
+    }
+
+    std::vector<Proc_LedsBase::ledData*>& leds = process._leds->getLeds();
+    for (size_t state = 0; state < sizeof(ledStateNames) / sizeof(ledStateNames[0]); state++)
+    {
+        if (strlen(ledStateNames[state]) == length && memcmp(ledStateNames[state], payload, length) == 0)
+        {
+            if (index < leds.size())
+            {
+                process._leds->setLedState(*leds[index], static_cast<ledStateMachine>(state));
+            }
+            return;
+        }
+    }
+    logger().log(ILog::LogLevel::WARNING, "MQTT: unknown LED state");
+}
+
+void proc_mqtt::mqttTask(void* arg)
+{
+    proc_mqtt& process = *static_cast<proc_mqtt*>(arg);
+    for (;;)
+    {
+        uint64_t nowUs = static_cast<uint64_t>(esp_timer_get_time());
+        uint32_t nowMs = static_cast<uint32_t>(nowUs / 1000);
+        process._client.poll(nowMs);
+
+        // Nothing to do before the broker sends, a button press wakes the wait or the client has a timer due
+        uint32_t delayMs = process._client.getNextDelayMs(nowMs);
+        delayMs          = (delayMs == 0) ? MQTT_BUSY_RETRY_MS : delayMs;
+        __atomic_store_n(&process._deadlineUs, (delayMs == UINT32_MAX) ? POWER_NO_DEADLINE : nowUs + static_cast<uint64_t>(delayMs) * 1000, __ATOMIC_RELAXED);
+        process._transport.waitReadable(delayMs);
+        process.countWakeup();
+    }
+}
@@ -0,0 +1,101 @@
+/**
+ * @file proc_mqtt.hpp
+ * @brief Header file for proc_mqtt
+ *
+ * This file contains declarations for the proc_mqtt class and related data types and functions.
+ */
+
+#ifndef PROC_MQTT_HPP
+#define PROC_MQTT_HPP
+
+#include "HAL/Platform/ESP32/net_tcp.hpp"
+#include "IProcess.hpp"
+#include "Library/Protocol/mqttClient.h"
+#include "Process/Examples/Proc_Button.hpp"
+#include "Process/Examples/Proc_Leds.hpp"
+#include "System/rtosObjects.h"
+
+#define MQTT_STACK_SIZE    4096
+#define MQTT_BUSY_RETRY_MS 50 // wait before sending again after lwIP had no room for a packet
+#define MQTT_DEFAULT_PORT  1883
+#define MQTT_PREFIX_SIZE   32
+
+/**
+ * @brief MQTT process connecting the buttons and LEDs to a broker
+ *
+ * Every completed button press is published with QoS 1 to "<prefix>/button/<index>", the payload is the press
+ * duration in milliseconds. Messages on "<prefix>/led/<index>/set" set the state of that LED, the payload is one of
+ * off, on, blink_slow, blink, blink_fast, blink_once, blink_twice, blink_thrice.
+ *
+ * The process task sleeps on the socket until the broker sends something or the next reconnect or keep alive of the
+ * client is due. Button tasks only queue the message in the mqttClient and wake the process task, which sends it;
+ * presses made while the broker is unreachable are kept in the offline queue and sent after reconnecting. Messages
+ * published through getClient() go out on the next wakeup.
+ */
+class proc_mqtt : public IProcess
+{
+private:
+    net_tcp          _transport;
+    mqttClient       _client;
+    Proc_ButtonBase* _buttons;
+    Proc_LedsBase*   _leds;
+    char             _prefix[MQTT_PREFIX_SIZE];
+    uint8_t          _taskPriority;
+    int8_t           _core;
+    uint64_t         _deadlineUs;
+
+    rtosTask<MQTT_STACK_SIZE> _task;
+
+    static void mqttTask(void* arg);
+    static void onPress(size_t index, uint32_t durationMs, void* context);
+    static void onMessage(const char* topic, size_t topicLength, const uint8_t* payload, size_t length, void* context);
+
+public:
+    /**
+     * @brief Construct a new proc_mqtt object
+     *
+     * @param host - host name or IPv4 address of the broker, must stay valid
+     * @param prefix - topic prefix, e.g. the device name
+     * @param buttons - button process whose presses are published, nullptr for none
+     * @param leds - LED process controlled by the broker, nullptr for none
+     * @param port - TCP port of the broker (default 1883)
+     * @param config - client configuration (default mqttDefaultConfig())
+     * @param taskPriority - task priority (default network priority)
+     * @param core - core of the task (default PROCESS_CORE_ANY)
+     */
+    proc_mqtt(const char* host, const char* prefix, Proc_ButtonBase* buttons, Proc_LedsBase* leds, uint16_t port = MQTT_DEFAULT_PORT,
+              const mqttConfig_t& config = mqttDefaultConfig(), uint8_t taskPriority = taskBandPriority(TASK_BAND_NETWORK), int8_t core = PROCESS_CORE_ANY);
+    ~proc_mqtt();
+
+    // Delete copy constructor and assignment operator
+    proc_mqtt(const proc_mqtt&)            = delete;
+    proc_mqtt& operator=(const proc_mqtt&) = delete;
+
+    sys_error_t start() override;
+
+    sys_error_t stop() override;
+
+    sys_error_t pause() override;
+
+    sys_error_t resume() override;
+
+    size_t getTasks(processTask_t* tasks, size_t maxTasks) override;
+
+    uint64_t getNextDeadline(uint64_t nowUs) override;
+
+    /**
+     * @brief Get the client, e.g. to publish or subscribe to more topics
+     *
+     * @return mqttClient&
+     */
+    mqttClient& getClient();
+
+    /**
+     * @brief Get the counters of the client
+     *
+     * @return mqttStats_t
+     */
+    mqttStats_t getStats();
+};
+
+#endif /* PROC_MQTT_HPP */
@@ -0,0 +1,130 @@
+/**
+ * @file proc_power.cpp
+ * @brief Source file for proc_power
+ *
+ * This file contains definitions for the proc_power class and related data types and functions.
+ */
+
+#include "proc_power.hpp"
+#include "HAL/Platform/ESP32/Library/logImpl.h"
+#include <esp_sleep.h>
+#include <esp_timer.h>
+
+proc_power::proc_power(int maxFreqMhz, int minFreqMhz, bool lightSleep)
+    : _wakeGpioCount(0), _maxFreqMhz(maxFreqMhz), _minFreqMhz(minFreqMhz), _lightSleep(lightSleep)
+{
+    _report[0]    = '\0';
+    _uri          = {};
+    _uri.uri      = "/debug/power";
+    _uri.method   = HTTP_GET;
+    _uri.handler  = httpHandler;
+    _uri.user_ctx = static_cast<void*>(this);
+    setState(IProcess::State::INITIALIZED);
+}
+
+proc_power::~proc_power()
+{
+    // destructor implementation
+}
+
+sys_error_t proc_power::start()
+{
+    for (size_t i = 0; i < _wakeGpioCount; i++)
+    {
+        if (gpio_wakeup_enable(_wakeGpios[i].gpio, _wakeGpios[i].high ? GPIO_INTR_HIGH_LEVEL : GPIO_INTR_LOW_LEVEL) != ESP_OK)
+        {
+            logger().log(ILog::LogLevel::ERROR, "Power: wake GPIO could not be set!");
+            return ERROR_INVALID_CONFIG;
+        }
+    }
+    if (_wakeGpioCount > 0 && esp_sleep_enable_gpio_wakeup() != ESP_OK)
+    {
+        return ERROR_INVALID_CONFIG;
+    }
+
+    RETURN_ON_ERROR(configure(_lightSleep));
+    setState(IProcess::State::RUNNING);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t proc_power::stop()
+{
+    RETURN_ON_ERROR(configure(false));
+    for (size_t i = 0; i < _wakeGpioCount; i++)
+    {
+        gpio_wakeup_disable(_wakeGpios[i].gpio);
+    }
+    setState(IProcess::State::STOPPED);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t proc_power::pause()
+{
+    RETURN_ON_ERROR(configure(false));
+    setState(IProcess::State::PAUSED);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t proc_power::resume()
+{
+    RETURN_ON_ERROR(configure(_lightSleep));
+    setState(IProcess::State::RUNNING);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t proc_power::addClient(const char* name, IPowerClient& client)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _manager.addClient(client, name);
+}
+
+sys_error_t proc_power::addWakeGpio(gpio_num_t gpio, bool high)
+{
+    if (_wakeGpioCount >= POWER_MAX_WAKE_GPIOS)
+    {
+        return ERROR_OUT_OF_MEMORY;
+    }
+    _wakeGpios[_wakeGpioCount].gpio = gpio;
+    _wakeGpios[_wakeGpioCount].high = high;
+    _wakeGpioCount++;
+    return ERROR_SUCCESS;
+}
+
+const httpd_uri_t* proc_power::getUriHandler()
+{
+    return &_uri;
+}
+
+size_t proc_power::report(char* buffer, size_t size, bool json)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    uint64_t                    now = esp_timer_get_time();
+    return json ? _manager.formatJson(buffer, size, now) : _manager.formatText(buffer, size, now);
+}
+
+sys_error_t proc_power::configure(bool lightSleep)
+{
+    esp_pm_config_t config    = {};
+    config.max_freq_mhz       = _maxFreqMhz;
+    config.min_freq_mhz       = lightSleep ? _minFreqMhz : _maxFreqMhz;
+    config.light_sleep_enable = lightSleep;
+
+    esp_err_t result = esp_pm_configure(&config);
+    if (result != ESP_OK)
+    {
+        // ESP_ERR_NOT_SUPPORTED without CONFIG_PM_ENABLE, light sleep also needs CONFIG_FREERTOS_USE_TICKLESS_IDLE
+        logger().log(ILog::LogLevel::ERROR, "Power: power management could not be configured!");
+        return (result == ESP_ERR_NOT_SUPPORTED) ? ERROR_NOT_SUPPORTED : ERROR_INVALID_CONFIG;
+    }
+    return ERROR_SUCCESS;
+}
+
+esp_err_t proc_power::httpHandler(httpd_req_t* req)
+{
+    proc_power& power = *static_cast<proc_power*>(req->user_ctx);
+
+    std::lock_guard<std::mutex> lock(power._mutex);
+    size_t                      length = power._manager.formatJson(power._report, sizeof(power._report), esp_timer_get_time());
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_send(req, power._report, length);
+}
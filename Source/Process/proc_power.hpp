@@ -0,0 +1,115 @@
+/**
+ * @file proc_power.hpp
+ * @brief Header file for proc_power
+ *
+ * This file contains declarations for the proc_power class and related data types and functions.
+ */
+
+#ifndef PROC_POWER_HPP
+#define PROC_POWER_HPP
+
+#include "IProcess.hpp"
+#include "Library/Power/powerManager.h"
+#include <driver/gpio.h>
+#include <esp_http_server.h>
+#include <esp_pm.h>
+#include <mutex>
+
+#define POWER_MAX_WAKE_GPIOS 8
+#define POWER_REPORT_SIZE    1024 // text/JSON report buffer
+
+/**
+ * @brief Power management process
+ *
+ * Enables dynamic frequency scaling and automatic light sleep: with tickless idle the idle task sleeps until the
+ * earliest timeout of all blocked tasks, or until a wake GPIO reaches its level. Nothing polls for this, each
+ * process blocks until its own next deadline (IPowerClient). The deadlines and wakeups of the added clients are
+ * reported on demand and served as JSON at /debug/power; the process has no task and never wakes the CPU itself.
+ * Needs CONFIG_PM_ENABLE and CONFIG_FREERTOS_USE_TICKLESS_IDLE.
+ */
+class proc_power : public IProcess
+{
+private:
+    typedef struct
+    {
+        gpio_num_t gpio;
+        bool       high; // wake up on the high level
+    } wakeGpio_t;
+
+    powerManager _manager;
+    wakeGpio_t   _wakeGpios[POWER_MAX_WAKE_GPIOS];
+    size_t       _wakeGpioCount;
+    int          _maxFreqMhz;
+    int          _minFreqMhz;
+    bool         _lightSleep;
+    char         _report[POWER_REPORT_SIZE];
+    httpd_uri_t  _uri;
+    std::mutex   _mutex;
+
+    static esp_err_t httpHandler(httpd_req_t* req);
+    sys_error_t      configure(bool lightSleep);
+
+public:
+    /**
+     * @brief Construct a new proc_power object
+     *
+     * @param maxFreqMhz - CPU frequency while a task runs (default 240)
+     * @param minFreqMhz - CPU frequency while idle, the APB frequency (default 40)
+     * @param lightSleep - sleep when idle (default true)
+     */
+    proc_power(int maxFreqMhz = 240, int minFreqMhz = 40, bool lightSleep = true);
+    ~proc_power();
+
+    // Delete copy constructor and assignment operator
+    proc_power(const proc_power&)            = delete;
+    proc_power& operator=(const proc_power&) = delete;
+
+    sys_error_t start() override;
+
+    /**
+     * @brief Stop sleeping, the CPU stays at the maximum frequency
+     */
+    sys_error_t stop() override;
+
+    sys_error_t pause() override;
+
+    sys_error_t resume() override;
+
+    /**
+     * @brief Add a process or driver to the power report
+     *
+     * @param name - name shown in the report, must stay valid
+     * @param client - the process or driver
+     * @return sys_error_t ERROR_OUT_OF_MEMORY if POWER_MAX_CLIENTS clients are added
+     */
+    sys_error_t addClient(const char* name, IPowerClient& client);
+
+    /**
+     * @brief Wake up from light sleep on a GPIO level, before start()
+     * ESP-IDF switches the pin to level interrupts, use it for pins whose handler reads the level on each event.
+     *
+     * @param gpio - pin
+     * @param high - wake up on the high level, else on the low level
+     * @return sys_error_t ERROR_OUT_OF_MEMORY if POWER_MAX_WAKE_GPIOS pins are added
+     */
+    sys_error_t addWakeGpio(gpio_num_t gpio, bool high);
+
+    /**
+     * @brief Get the GET /debug/power handler, to be added with proc_httpServer::addUriHandler()
+     *
+     * @return const httpd_uri_t*
+     */
+    const httpd_uri_t* getUriHandler();
+
+    /**
+     * @brief Write the wakeups and deadlines of the clients
+     *
+     * @param buffer - output buffer
+     * @param size - buffer size
+     * @param json - JSON instead of text lines
+     * @return size_t characters written
+     */
+    size_t report(char* buffer, size_t size, bool json);
+};
+
+#endif /* PROC_POWER_HPP */
@@ -0,0 +1,261 @@
+/**
+ * @file proc_profiler.cpp
+ * @brief Source file for proc_profiler
+ *
+ * This file contains definitions for the proc_profiler class and related data types and functions.
+ */
+
+#include "proc_profiler.hpp"
+#include "HAL/Platform/ESP32/Library/logImpl.h"
+#include <atomic>
+#include <string.h>
+
+namespace
+{
+constexpr size_t maxTasksPerProcess = 8;
+
+#if PROFILER_TRACE_SWITCHES
+typedef struct
+{
+    std::atomic<uintptr_t> task;
+    std::atomic<uint32_t>  switches;
+} switchCounter_t;
+
+// Open addressing table keyed by the task handle, slots are claimed once and never released
+switchCounter_t switchCounters[PROFILER_MAX_TASKS * 2];
+
+uint32_t switchCount(TaskHandle_t task)
+{
+    constexpr size_t slots = sizeof(switchCounters) / sizeof(switchCounters[0]);
+    uintptr_t        id    = reinterpret_cast<uintptr_t>(task);
+    for (size_t i = 0, slot = (id >> 4) % slots; i < slots; i++, slot = (slot + 1) % slots)
+    {
+        uintptr_t owner = switchCounters[slot].task.load(std::memory_order_relaxed);
+        if (owner == id)
+        {
+            return switchCounters[slot].switches.load(std::memory_order_relaxed);
+        }
+        if (owner == 0)
+        {
+            break;
+        }
+    }
+    return 0;
+}
+#else
+uint32_t switchCount(TaskHandle_t task)
+{
+    return 0;
+}
+#endif
+} // namespace
+
+#if PROFILER_TRACE_SWITCHES
+extern "C" void IRAM_ATTR profilerTaskSwitchedIn(void* task)
+{
+    constexpr size_t slots = sizeof(switchCounters) / sizeof(switchCounters[0]);
+    uintptr_t        id    = reinterpret_cast<uintptr_t>(task);
+    for (size_t i = 0, slot = (id >> 4) % slots; i < slots; i++, slot = (slot + 1) % slots)
+    {
+        uintptr_t owner = switchCounters[slot].task.load(std::memory_order_relaxed);
+        if (owner == 0)
+        {
+            // Both cores may race for the slot, the loser sees the winner's id
+            uintptr_t expected = 0;
+            switchCounters[slot].task.compare_exchange_strong(expected, id, std::memory_order_relaxed);
+            owner = (expected == 0) ? id : expected;
+        }
+        if (owner == id)
+        {
+            switchCounters[slot].switches.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+#endif
+
+proc_profiler::proc_profiler(uint32_t periodMs, bool logReport, uint8_t taskPriority, int8_t core)
+    : _profiler(PROFILER_MAX_PROCESSES), _cores(portNUM_PROCESSORS), _processCount(0), _periodMs(periodMs), _logReport(logReport), _taskPriority(taskPriority), _core(core)
+{
+    _report[0]        = '\0';
+    _uri              = {};
+    _uri.uri          = "/debug/tasks";
+    _uri.method       = HTTP_GET;
+    _uri.handler      = httpHandler;
+    _uri.user_ctx     = static_cast<void*>(this);
+    _coresUri         = _uri;
+    _coresUri.uri     = "/debug/cores";
+    _coresUri.handler = coresHandler;
+    setState(IProcess::State::INITIALIZED);
+}
+
+proc_profiler::~proc_profiler()
+{
+    // destructor implementation
+}
+
+sys_error_t proc_profiler::start()
+{
+    RETURN_ON_ERROR(_task.create(profilerTask, "profiler_task", static_cast<void*>(this), _taskPriority, _core));
+    setState(IProcess::State::RUNNING);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t proc_profiler::stop()
+{
+    _task.remove();
+    setState(IProcess::State::STOPPED);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t proc_profiler::pause()
+{
+    _task.suspend();
+    setState(IProcess::State::PAUSED);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t proc_profiler::resume()
+{
+    _task.resume();
+    setState(IProcess::State::RUNNING);
+    return ERROR_SUCCESS;
+}
+
+size_t proc_profiler::getTasks(processTask_t* tasks, size_t maxTasks)
+{
+    if (maxTasks == 0 || _task.getHandle() == NULL)
+    {
+        return 0;
+    }
+    tasks[0].handle    = _task.getHandle();
+    tasks[0].stackSize = _task.getStackSize() * sizeof(StackType_t);
+    return 1;
+}
+
+sys_error_t proc_profiler::addProcess(const char* name, IProcess& process)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    int16_t                     index = _profiler.addProcess(name);
+    if (index < 0 || _processCount >= PROFILER_MAX_PROCESSES)
+    {
+        return ERROR_OUT_OF_MEMORY;
+    }
+    _processes[_processCount].process = &process;
+    _processes[_processCount].index   = index;
+    _processCount++;
+    return ERROR_SUCCESS;
+}
+
+const httpd_uri_t* proc_profiler::getUriHandler()
+{
+    return &_uri;
+}
+
+const httpd_uri_t* proc_profiler::getCoresUriHandler()
+{
+    return &_coresUri;
+}
+
+size_t proc_profiler::report(char* buffer, size_t size, bool json)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return json ? _profiler.formatJson(buffer, size) : _profiler.formatText(buffer, size);
+}
+
+void proc_profiler::sample()
+{
+    uint32_t    totalRunTime = 0;
+    UBaseType_t count        = uxTaskGetSystemState(_status, PROFILER_MAX_TASKS, &totalRunTime);
+    if (count == 0)
+    {
+        logger().log(ILog::LogLevel::WARNING, "Profiler: more tasks than PROFILER_MAX_TASKS!");
+        return;
+    }
+
+    for (UBaseType_t i = 0; i < count; i++)
+    {
+        taskSample_t& sample = _samples[i];
+        sample.id             = reinterpret_cast<uintptr_t>(_status[i].xHandle);
+        sample.process        = -1;
+        sample.runTime        = _status[i].ulRunTimeCounter;
+        sample.stackHighWater = _status[i].usStackHighWaterMark * sizeof(StackType_t);
+        sample.stackSize      = 0;
+        sample.switches       = switchCount(_status[i].xHandle);
+        sample.priority       = static_cast<uint8_t>(_status[i].uxCurrentPriority);
+#if configTASKLIST_INCLUDE_COREID
+        sample.core = (_status[i].xCoreID >= 0 && _status[i].xCoreID < portNUM_PROCESSORS) ? static_cast<int8_t>(_status[i].xCoreID) : -1; // tskNO_AFFINITY
+#else
+        sample.core = -1;
+#endif
+        strncpy(sample.name, _status[i].pcTaskName, sizeof(sample.name) - 1);
+        sample.name[sizeof(sample.name) - 1] = '\0';
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Attribute the tasks to their processes
+    processTask_t tasks[maxTasksPerProcess];
+    for (size_t p = 0; p < _processCount; p++)
+    {
+        size_t taskCount = _processes[p].process->getTasks(tasks, maxTasksPerProcess);
+        for (size_t t = 0; t < taskCount; t++)
+        {
+            for (UBaseType_t i = 0; i < count; i++)
+            {
+                if (_samples[i].id == reinterpret_cast<uintptr_t>(tasks[t].handle))
+                {
+                    _samples[i].process   = _processes[p].index;
+                    _samples[i].stackSize = tasks[t].stackSize;
+                }
+            }
+        }
+    }
+
+    _profiler.update(_samples, count, totalRunTime, pdTICKS_TO_MS(xTaskGetTickCount()));
+    _cores.update(_samples, count, totalRunTime);
+    if (_logReport)
+    {
+        _profiler.formatText(_report, sizeof(_report));
+        logger().log(ILog::LogLevel::INFO, _report);
+        _cores.formatText(_report, sizeof(_report));
+        logger().log(ILog::LogLevel::INFO, _report);
+    }
+}
+
+void proc_profiler::profilerTask(void* arg)
+{
+    proc_profiler& profiler = *static_cast<proc_profiler*>(arg);
+    TickType_t     lastWake = xTaskGetTickCount();
+    for (;;)
+    {
+        profiler.sample();
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(profiler._periodMs));
+    }
+}
+
+esp_err_t proc_profiler::httpHandler(httpd_req_t* req)
+{
+    proc_profiler& profiler = *static_cast<proc_profiler*>(req->user_ctx);
+
+    // The report buffer is shared with the logging in sample(), hold the lock until it is sent
+    std::lock_guard<std::mutex> lock(profiler._mutex);
+    bool                        truncated = false;
+    size_t                      length    = profiler._profiler.formatJson(profiler._report, sizeof(profiler._report), &truncated);
+    if (truncated)
+    {
+        logger().log(ILog::LogLevel::WARNING, "Profiler: report buffer too small, processes left out");
+    }
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_send(req, profiler._report, length);
+}
+
+esp_err_t proc_profiler::coresHandler(httpd_req_t* req)
+{
+    proc_profiler& profiler = *static_cast<proc_profiler*>(req->user_ctx);
+
+    std::lock_guard<std::mutex> lock(profiler._mutex);
+    size_t                      length = profiler._cores.formatJson(profiler._report, sizeof(profiler._report));
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_send(req, profiler._report, length);
+}
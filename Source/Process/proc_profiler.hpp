@@ -0,0 +1,135 @@
+/**
+ * @file proc_profiler.hpp
+ * @brief Header file for proc_profiler
+ *
+ * This file contains declarations for the proc_profiler class and related data types and functions.
+ */
+
+#ifndef PROC_PROFILER_HPP
+#define PROC_PROFILER_HPP
+
+#include "IProcess.hpp"
+#include "Library/Diagnostics/coreBalance.h"
+#include "Library/Diagnostics/taskProfiler.h"
+#include "System/rtosObjects.h"
+#include <esp_http_server.h>
+#include <mutex>
+
+#define PROFILER_MAX_PROCESSES 16
+#define PROFILER_MAX_TASKS     32   // scheduler tasks that can be sampled, IDLE and driver tasks included
+#define PROFILER_REPORT_SIZE   ((PROFILER_MAX_PROCESSES + 1) * TASKPROFILER_JSON_ENTRY_SIZE) // text/JSON report buffer, every process and the system bucket
+#define PROFILER_STACK_SIZE    4096
+
+// 1: count context switches, needs traceTASK_SWITCHED_IN() to call profilerTaskSwitchedIn() with the task
+// switched in, e.g. in the FreeRTOS configuration of the project:
+//     #define traceTASK_SWITCHED_IN() profilerTaskSwitchedIn(pxCurrentTCB)
+#ifndef PROFILER_TRACE_SWITCHES
+#define PROFILER_TRACE_SWITCHES 0
+#endif
+
+#if PROFILER_TRACE_SWITCHES
+extern "C" void profilerTaskSwitchedIn(void* task);
+#endif
+
+/**
+ * @brief Task profiler process
+ *
+ * Periodically samples the run time and the stack high water mark of every scheduler task (uxTaskGetSystemState()),
+ * maps them to the registered processes through IProcess::getTasks() and reports per process CPU %, the smallest
+ * stack headroom and the context switch rate. The report is logged every period and served as JSON at /debug/tasks.
+ * The load of each core and the priority bands pinned to it are served at /debug/cores (see coreBalance), the core
+ * affinity of the tasks needs CONFIG_FREERTOS_VTASKLIST_INCLUDE_COREID.
+ * Needs CONFIG_FREERTOS_USE_TRACE_FACILITY and CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS.
+ */
+class proc_profiler : public IProcess
+{
+private:
+    typedef struct
+    {
+        IProcess* process;
+        int16_t   index;
+    } entry_t;
+
+    taskProfiler _profiler;
+    coreBalance  _cores;
+    entry_t      _processes[PROFILER_MAX_PROCESSES];
+    size_t       _processCount;
+    TaskStatus_t _status[PROFILER_MAX_TASKS];
+    taskSample_t _samples[PROFILER_MAX_TASKS];
+    char         _report[PROFILER_REPORT_SIZE];
+    uint32_t     _periodMs;
+    bool         _logReport;
+    uint8_t      _taskPriority;
+    int8_t       _core;
+    httpd_uri_t  _uri;
+    httpd_uri_t  _coresUri;
+    std::mutex   _mutex;
+
+    rtosTask<PROFILER_STACK_SIZE> _task;
+
+    static void      profilerTask(void* arg);
+    static esp_err_t httpHandler(httpd_req_t* req);
+    static esp_err_t coresHandler(httpd_req_t* req);
+    void             sample();
+
+public:
+    /**
+     * @brief Construct a new proc_profiler object
+     *
+     * @param periodMs - sampling period in milliseconds (default 10000)
+     * @param logReport - log the report after every sample (default true)
+     * @param taskPriority - task priority (default lowest background priority)
+     * @param core - core of the task (default PROCESS_CORE_ANY)
+     */
+    proc_profiler(uint32_t periodMs = 10000, bool logReport = true, uint8_t taskPriority = taskBandPriority(TASK_BAND_BACKGROUND), int8_t core = PROCESS_CORE_ANY);
+    ~proc_profiler();
+
+    // Delete copy constructor and assignment operator
+    proc_profiler(const proc_profiler&)            = delete;
+    proc_profiler& operator=(const proc_profiler&) = delete;
+
+    sys_error_t start() override;
+
+    sys_error_t stop() override;
+
+    sys_error_t pause() override;
+
+    sys_error_t resume() override;
+
+    size_t getTasks(processTask_t* tasks, size_t maxTasks) override;
+
+    /**
+     * @brief Register a process to profile, before start()
+     *
+     * @param name - process name shown in the report, must stay valid, up to 32 characters (see TASKPROFILER_JSON_ENTRY_SIZE)
+     * @param process - the process
+     * @return sys_error_t ERROR_OUT_OF_MEMORY if PROFILER_MAX_PROCESSES processes are registered
+     */
+    sys_error_t addProcess(const char* name, IProcess& process);
+
+    /**
+     * @brief Get the GET /debug/tasks handler, to be added with proc_httpServer::addUriHandler()
+     *
+     * @return const httpd_uri_t*
+     */
+    const httpd_uri_t* getUriHandler();
+
+    /**
+     * @brief Get the GET /debug/cores handler, to be added with proc_httpServer::addUriHandler()
+     *
+     * @return const httpd_uri_t*
+     */
+    const httpd_uri_t* getCoresUriHandler();
+
+    /**
+     * @brief Write the report of the last period
+     *
+     * @param buffer - output buffer
+     * @param size - buffer size
+     * @param json - JSON instead of text lines
+     * @return size_t characters written
+     */
+    size_t report(char* buffer, size_t size, bool json);
+};
+
+#endif /* PROC_PROFILER_HPP */
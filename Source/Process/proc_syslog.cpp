@@ -0,0 +1,97 @@
+/**
+ * @file proc_syslog.cpp
+ * @brief Source file for proc_syslog
+ *
+ * This file contains definitions for the proc_syslog class and related data types and functions.
+ */
+
+#include "proc_syslog.hpp"
+#include "HAL/Platform/ESP32/Library/logImpl.h"
+#include <esp_timer.h>
+
+proc_syslog::proc_syslog(const char* host, uint16_t port, const syslogConfig_t& config, uint8_t taskPriority, int8_t core)
+    : _transport(host, port), _sink(_transport, config), _taskPriority(taskPriority), _core(core), _deadlineUs(POWER_NO_DEADLINE)
+{
+    _sink.setNotify(notify, static_cast<void*>(this));
+    setState(IProcess::State::INITIALIZED);
+}
+
+proc_syslog::~proc_syslog()
+{
+    // destructor implementation
+}
+
+sys_error_t proc_syslog::start()
+{
+    RETURN_ON_ERROR(_transport.connect());
+    RETURN_ON_ERROR(_task.create(syslogTask, "syslog_task", static_cast<void*>(this), _taskPriority, _core));
+    loggerImpl().setRemote(&_sink);
+    setState(IProcess::State::RUNNING);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t proc_syslog::stop()
+{
+    loggerImpl().setRemote(nullptr);
+    _task.remove();
+    _transport.disconnect();
+    setState(IProcess::State::STOPPED);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t proc_syslog::pause()
+{
+    // Records keep being queued and are dropped once the queue is full
+    _task.suspend();
+    setState(IProcess::State::PAUSED);
+    return ERROR_SUCCESS;
+}
+
+sys_error_t proc_syslog::resume()
+{
+    _task.resume();
+    setState(IProcess::State::RUNNING);
+    return ERROR_SUCCESS;
+}
+
+size_t proc_syslog::getTasks(processTask_t* tasks, size_t maxTasks)
+{
+    if (maxTasks == 0 || _task.getHandle() == NULL)
+    {
+        return 0;
+    }
+    tasks[0].handle    = _task.getHandle();
+    tasks[0].stackSize = _task.getStackSize() * sizeof(StackType_t);
+    return 1;
+}
+
+uint64_t proc_syslog::getNextDeadline(uint64_t nowUs)
+{
+    return __atomic_load_n(&_deadlineUs, __ATOMIC_RELAXED);
+}
+
+syslogStats_t proc_syslog::getStats()
+{
+    return _sink.getStats();
+}
+
+void proc_syslog::notify(void* context)
+{
+    static_cast<proc_syslog*>(context)->_task.notify();
+}
+
+void proc_syslog::syslogTask(void* arg)
+{
+    proc_syslog& process = *static_cast<proc_syslog*>(arg);
+    for (;;)
+    {
+        // Nothing is logged from here, the records would come back to this sink
+        // Everything queued went out unless the transport was busy, new records notify the task
+        uint32_t delayMs = (process._sink.poll() == ERROR_BUSY) ? SYSLOG_RETRY_MS : UINT32_MAX;
+        uint64_t nowUs   = static_cast<uint64_t>(esp_timer_get_time());
+        __atomic_store_n(&process._deadlineUs, (delayMs == UINT32_MAX) ? POWER_NO_DEADLINE : nowUs + static_cast<uint64_t>(delayMs) * 1000, __ATOMIC_RELAXED);
+
+        ulTaskNotifyTake(pdTRUE, (delayMs == UINT32_MAX) ? portMAX_DELAY : pdMS_TO_TICKS(delayMs));
+        process.countWakeup();
+    }
+}
@@ -0,0 +1,80 @@
+/**
+ * @file proc_syslog.hpp
+ * @brief Header file for proc_syslog
+ *
+ * This file contains declarations for the proc_syslog class and related data types and functions.
+ */
+
+#ifndef PROC_SYSLOG_HPP
+#define PROC_SYSLOG_HPP
+
+#include "HAL/Platform/ESP32/net_udp.hpp"
+#include "IProcess.hpp"
+#include "Library/Protocol/syslogSink.h"
+#include "System/rtosObjects.h"
+
+#define SYSLOG_STACK_SIZE   3072
+#define SYSLOG_RETRY_MS     50 // wait after lwIP refused a datagram
+#define SYSLOG_DEFAULT_PORT 514
+
+/**
+ * @brief Remote logging process
+ *
+ * Ships every record of logger() to a syslog collector, one UDP datagram per record (see syslogSink), in addition
+ * to the console. Logging tasks only queue the record; the process task sleeps until it is notified and sends the
+ * queued datagrams. Records are dropped and counted when the collector cannot keep up, the logging tasks never wait
+ * for the network.
+ */
+class proc_syslog : public IProcess
+{
+private:
+    net_udp    _transport;
+    syslogSink _sink;
+    uint8_t    _taskPriority;
+    int8_t     _core;
+    uint64_t   _deadlineUs;
+
+    rtosTask<SYSLOG_STACK_SIZE> _task;
+
+    static void syslogTask(void* arg);
+    static void notify(void* context);
+
+public:
+    /**
+     * @brief Construct a new proc_syslog object
+     *
+     * @param host - IPv4 address of the collector, must stay valid
+     * @param port - UDP port of the collector (default 514)
+     * @param config - sink configuration (default syslogDefaultConfig())
+     * @param taskPriority - task priority (default lowest background priority)
+     * @param core - core of the task (default PROCESS_CORE_ANY)
+     */
+    proc_syslog(const char* host, uint16_t port = SYSLOG_DEFAULT_PORT, const syslogConfig_t& config = syslogDefaultConfig(),
+                uint8_t taskPriority = taskBandPriority(TASK_BAND_BACKGROUND), int8_t core = PROCESS_CORE_ANY);
+    ~proc_syslog();
+
+    // Delete copy constructor and assignment operator
+    proc_syslog(const proc_syslog&)            = delete;
+    proc_syslog& operator=(const proc_syslog&) = delete;
+
+    sys_error_t start() override;
+
+    sys_error_t stop() override;
+
+    sys_error_t pause() override;
+
+    sys_error_t resume() override;
+
+    size_t getTasks(processTask_t* tasks, size_t maxTasks) override;
+
+    uint64_t getNextDeadline(uint64_t nowUs) override;
+
+    /**
+     * @brief Get the counters of the sink
+     *
+     * @return syslogStats_t
+     */
+    syslogStats_t getStats();
+};
+
+#endif /* PROC_SYSLOG_HPP */
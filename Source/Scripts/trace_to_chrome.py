@@ -0,0 +1,93 @@
+import json
+import struct
+import sys
+
+# Converts a trace dump (traceBuffer::serialize(), e.g. GET /debug/trace) into Chrome trace_event JSON,
+# which chrome://tracing and https://ui.perfetto.dev open directly.
+
+HEADER_FORMAT = '<IHHIIII'
+RECORD_FORMAT = '<IHBBII'
+TRACE_DUMP_MAGIC = 0x31435254
+
+
+def read_dump(data):
+    magic, version, cores, cycles_per_us, records_per_core, event_count, dropped = struct.unpack_from(HEADER_FORMAT, data, 0)
+    if magic != TRACE_DUMP_MAGIC or version != 1:
+        raise ValueError('not a trace dump (magic 0x%08x, version %d)' % (magic, version))
+    offset = struct.calcsize(HEADER_FORMAT)
+
+    names = []
+    for _ in range(event_count):
+        end = data.index(b'\0', offset)
+        names.append(data[offset:end].decode('ascii', 'replace'))
+        offset = end + 1
+
+    records = []
+    record_size = struct.calcsize(RECORD_FORMAT)
+    for _ in range(cores):
+        (count,) = struct.unpack_from('<I', data, offset)
+        offset += 4
+        core_records = [struct.unpack_from(RECORD_FORMAT, data, offset + i * record_size) for i in range(count)]
+        offset += count * record_size
+        records.append(core_records)
+
+    return cycles_per_us, names, records, dropped
+
+
+def unwrap(core_records):
+    # 32 bit cycle counter: follow the signed difference between consecutive records of a core
+    # starting at the raw value of the first record, so cores whose counters run in step line up
+    result = []
+    previous = None
+    time = 0
+    for record in core_records:
+        cycles = record[0]
+        if previous is None:
+            time = cycles
+        else:
+            delta = (cycles - previous) & 0xFFFFFFFF
+            time += delta - (1 << 32) if delta & 0x80000000 else delta
+        previous = cycles
+        result.append((time, record))
+    return result
+
+
+def to_chrome(cycles_per_us, names, records):
+    events = []
+    for core_records in records:
+        for time, (cycles, event, phase, core, arg, task) in unwrap(core_records):
+            name = names[event] if event < len(names) else 'event_%d' % event
+            entry = {
+                'name': name,
+                'cat': name.split('.')[0],
+                'ph': chr(phase),
+                'ts': time / float(cycles_per_us),
+                'pid': core,
+                'tid': 'isr' if task == 0 else '0x%08x' % task,
+                'args': {'arg': arg},
+            }
+            if entry['ph'] in ('b', 'e'):
+                entry['id'] = arg
+            elif entry['ph'] == 'i':
+                entry['s'] = 't'
+            events.append(entry)
+    events.sort(key=lambda entry: entry['ts'])
+    return {'traceEvents': events, 'displayTimeUnit': 'ns'}
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 3:
+        print('usage: python trace_to_chrome.py trace.bin trace.json')
+        sys.exit(1)
+
+    with open(sys.argv[1], 'rb') as f:
+        cycles_per_us, names, records, dropped = read_dump(f.read())
+
+    with open(sys.argv[2], 'w') as f:
+        json.dump(to_chrome(cycles_per_us, names, records), f)
+
+    print(f'{sum(len(r) for r in records)} records written to {sys.argv[2]}, {dropped} overwritten before the dump')
+
+# Example command ->
+# curl -o trace.bin http://<device>/debug/trace
+# python trace_to_chrome.py trace.bin trace.json
@@ -1,8 +1,12 @@
 #ifndef ILOG_H
 #define ILOG_H
 
+#include "Library/Common/textFormat.h"
+#include "Library/Diagnostics/flightRecorder.h"
 #include <iostream>
 
+#define LOG_FORMAT_SIZE 192 // longest message of LogHandler::logFormat(), the rest is cut
+
 /**
  * @brief The ILog class is a platform interface for logging messages with different severity levels.
  */
@@ -43,11 +47,34 @@ public:
     virtual void logError(const std::string& message) = 0;
 
     /**
-     * @brief
-     *
-     * @param filename
-     * @param level
-     * @param message
+     * @brief Logs a message that is not held in a std::string.
+     * The default copies it into one for logInfo()/logWarning()/logError(), sinks override it to skip the allocation.
+     * @param level The severity level of the message.
+     * @param message The message text, not null terminated.
+     * @param length The message length.
+     */
+    virtual void log(LogLevel level, const char* message, size_t length)
+    {
+        std::string copy(message, length);
+        switch (level)
+        {
+            case LogLevel::INFO:
+                logInfo(copy);
+                break;
+            case LogLevel::WARNING:
+                logWarning(copy);
+                break;
+            case LogLevel::ERROR:
+                logError(copy);
+                break;
+        }
+    }
+
+    /**
+     * @brief Logs a message to persistent storage instead of the console.
+     * @param filename Name of the log stream the message belongs to.
+     * @param level The severity level of the message.
+     * @param message The message to log.
      */
     virtual void logToFile(const std::string& filename, LogLevel level, const std::string& message) = 0;
 };
@@ -75,12 +102,14 @@ public:
 
     /**
      * @brief Logs a message with the given severity level.
+     * The start of the message is also kept in the flight recorder.
      *
      * @param level The severity level of the message to log.
      * @param message The message to log.
      */
     void log(ILog::LogLevel level, const std::string& message)
     {
+        flight().record(FLIGHT_LOG, static_cast<uint16_t>(level), static_cast<uint32_t>(message.size()), message.data(), message.size());
         switch (level)
         {
             case ILog::LogLevel::INFO:
@@ -94,6 +123,48 @@ public:
                 break;
         }
     }
+
+    /**
+     * @brief Logs a message held in a buffer, handed to the sink without a std::string.
+     * The start of the message is also kept in the flight recorder.
+     *
+     * @param level The severity level of the message to log.
+     * @param message The message text, not null terminated.
+     * @param length The message length.
+     */
+    void log(ILog::LogLevel level, const char* message, size_t length)
+    {
+        flight().record(FLIGHT_LOG, static_cast<uint16_t>(level), static_cast<uint32_t>(length), message, length);
+        _logImpl->log(level, message, length);
+    }
+
+    /**
+     * @brief Logs a message formatted with format::formatTo(), e.g. logFormat(level, "AID {} joined", aid)
+     * The message is formatted on the stack, without streams; sinks overriding ILog::log(level, message, length)
+     * take it without a heap buffer.
+     *
+     * @param level The severity level of the message to log.
+     * @param pattern The message with "{}" placeholders.
+     * @param args The values of the placeholders.
+     */
+    template <typename... Args> void logFormat(ILog::LogLevel level, const char* pattern, const Args&... args)
+    {
+        format::fixedString<LOG_FORMAT_SIZE> message;
+        format::formatTo(message, pattern, args...);
+        log(level, message.c_str(), message.length());
+    }
+
+    /**
+     * @brief Logs a message to persistent storage.
+     *
+     * @param filename Name of the log stream the message belongs to.
+     * @param level The severity level of the message to log.
+     * @param message The message to log.
+     */
+    void logToFile(const std::string& filename, ILog::LogLevel level, const std::string& message)
+    {
+        _logImpl->logToFile(filename, level, message);
+    }
 };
 
 #endif // ILOG_H
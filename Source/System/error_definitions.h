@@ -45,16 +45,17 @@
 typedef enum
 {
     // General error codes
-    ERROR_SUCCESS         = 0,  // Succesful
-    ERROR_FAIL            = -1, // Generic failure
-    ERROR_INVALID_ARG     = -2, // Invalid argument passed to a function
-    ERROR_TIMEOUT         = -3, // Operation timed out
-    ERROR_MEMORY          = -4, // Memory allocation or deallocation failure
-    ERROR_IO              = -5, // Input/output error
-    ERROR_NOT_SUPPORTED   = -6, // The operation or feature is not supported
-    ERROR_NOT_IMPLEMENTED = -7, // Not implemented yet
-    ERROR_INVALID_CONFIG  = -8, // Invalid configuration of the module
-    ERROR_UNKNOWN         = -9, // Unknown or unspecified error
+    ERROR_SUCCESS         = 0,   // Succesful
+    ERROR_FAIL            = -1,  // Generic failure
+    ERROR_INVALID_ARG     = -2,  // Invalid argument passed to a function
+    ERROR_TIMEOUT         = -3,  // Operation timed out
+    ERROR_MEMORY          = -4,  // Memory allocation or deallocation failure
+    ERROR_IO              = -5,  // Input/output error
+    ERROR_NOT_SUPPORTED   = -6,  // The operation or feature is not supported
+    ERROR_NOT_IMPLEMENTED = -7,  // Not implemented yet
+    ERROR_INVALID_CONFIG  = -8,  // Invalid configuration of the module
+    ERROR_UNKNOWN         = -9,  // Unknown or unspecified error
+    ERROR_NOT_FOUND       = -10, // Requested item does not exist
 
     // Error codes related to hardware and peripherals
     ERROR_INIT_FAILED  = -100, // Hardware initialization failure
@@ -0,0 +1,281 @@
+/**
+ * @file memoryPool.cpp
+ * @brief Source file for memoryPool
+ *
+ * This file contains definitions for the memoryPool class and related data types and functions.
+ */
+
+#include "memoryPool.h"
+#include <stdlib.h>
+
+poolLock::poolLock()
+{
+#if defined(ESP_PLATFORM)
+    portMUX_TYPE unlocked = portMUX_INITIALIZER_UNLOCKED;
+    _mux                  = unlocked;
+#else
+    _flag.clear();
+#endif
+}
+
+void poolLock::lock()
+{
+#if defined(ESP_PLATFORM)
+    portENTER_CRITICAL(&_mux);
+#else
+    while (_flag.test_and_set(std::memory_order_acquire))
+    {
+    }
+#endif
+}
+
+void poolLock::unlock()
+{
+#if defined(ESP_PLATFORM)
+    portEXIT_CRITICAL(&_mux);
+#else
+    _flag.clear(std::memory_order_release);
+#endif
+}
+
+void poolLock::lockFromISR()
+{
+#if defined(ESP_PLATFORM)
+    portENTER_CRITICAL_ISR(&_mux);
+#else
+    lock();
+#endif
+}
+
+void poolLock::unlockFromISR()
+{
+#if defined(ESP_PLATFORM)
+    portEXIT_CRITICAL_ISR(&_mux);
+#else
+    unlock();
+#endif
+}
+
+memoryPool::memoryPool(void* storage, size_t blockSize, size_t blockCount)
+    : _storage(static_cast<uint8_t*>(storage)), _blockSize(alignedSize(blockSize)), _blockCount(blockCount), _freeList(nullptr), _stats()
+{
+    _stats.blockSize  = static_cast<uint32_t>(_blockSize);
+    _stats.blockCount = static_cast<uint32_t>(_blockCount);
+
+    // Thread the free list through the blocks, lowest address first
+    for (size_t i = _blockCount; i > 0; i--)
+    {
+        void* block                 = _storage + (i - 1) * _blockSize;
+        *static_cast<void**>(block) = _freeList;
+        _freeList                   = block;
+    }
+}
+
+memoryPool::~memoryPool()
+{
+    // destructor implementation
+}
+
+void* memoryPool::allocate()
+{
+    _lock.lock();
+    void* block = pop();
+    if (block == nullptr)
+    {
+        _stats.failures++;
+    }
+    _lock.unlock();
+    return block;
+}
+
+void memoryPool::release(void* block)
+{
+    if (block == nullptr)
+    {
+        return;
+    }
+    _lock.lock();
+    push(block);
+    _lock.unlock();
+}
+
+void* memoryPool::allocateFromISR()
+{
+    _lock.lockFromISR();
+    void* block = pop();
+    if (block == nullptr)
+    {
+        _stats.failures++;
+    }
+    _lock.unlockFromISR();
+    return block;
+}
+
+void* memoryPool::tryAllocateFromISR()
+{
+    _lock.lockFromISR();
+    void* block = pop();
+    _lock.unlockFromISR();
+    return block;
+}
+
+void memoryPool::releaseFromISR(void* block)
+{
+    if (block == nullptr)
+    {
+        return;
+    }
+    _lock.lockFromISR();
+    push(block);
+    _lock.unlockFromISR();
+}
+
+bool memoryPool::owns(const void* block)
+{
+    const uint8_t* address = static_cast<const uint8_t*>(block);
+    return address >= _storage && address < _storage + _blockSize * _blockCount;
+}
+
+size_t memoryPool::getBlockSize()
+{
+    return _blockSize;
+}
+
+memoryPoolStats_t memoryPool::getStats()
+{
+    _lock.lock();
+    memoryPoolStats_t stats = _stats;
+    _lock.unlock();
+    return stats;
+}
+
+void* memoryPool::pop()
+{
+    void* block = _freeList;
+    if (block == nullptr)
+    {
+        return nullptr;
+    }
+
+    _freeList = *static_cast<void**>(block);
+    _stats.allocations++;
+    _stats.inUse++;
+    if (_stats.inUse > _stats.highWater)
+    {
+        _stats.highWater = _stats.inUse;
+    }
+    return block;
+}
+
+void memoryPool::push(void* block)
+{
+    *static_cast<void**>(block) = _freeList;
+    _freeList                   = block;
+    _stats.inUse--;
+}
+
+memoryPools::memoryPools(memoryPool* const* pools, size_t count) : _pools(pools), _count(count), _heapFallbacks(0), _failures(0) {}
+
+memoryPools::~memoryPools()
+{
+    // destructor implementation
+}
+
+void* memoryPools::allocate(size_t size)
+{
+    void* block = nullptr;
+    for (size_t i = 0; i < _count && block == nullptr; i++)
+    {
+        if (_pools[i]->getBlockSize() >= size)
+        {
+            block = _pools[i]->tryAllocateFromISR();
+        }
+    }
+    if (block == nullptr)
+    {
+        _heapFallbacks++;
+        block = malloc(size);
+        if (block == nullptr)
+        {
+            _failures++;
+        }
+    }
+    return block;
+}
+
+void memoryPools::release(void* block)
+{
+    for (size_t i = 0; i < _count; i++)
+    {
+        if (_pools[i]->owns(block))
+        {
+            _pools[i]->release(block);
+            return;
+        }
+    }
+    free(block);
+}
+
+void* memoryPools::allocateFromISR(size_t size)
+{
+    // A larger class is preferred over the heap when the fitting one is empty
+    for (size_t i = 0; i < _count; i++)
+    {
+        if (_pools[i]->getBlockSize() >= size)
+        {
+            void* block = _pools[i]->tryAllocateFromISR();
+            if (block != nullptr)
+            {
+                return block;
+            }
+        }
+    }
+    _failures++;
+    return nullptr;
+}
+
+void memoryPools::releaseFromISR(void* block)
+{
+    for (size_t i = 0; i < _count; i++)
+    {
+        if (_pools[i]->owns(block))
+        {
+            _pools[i]->releaseFromISR(block);
+            return;
+        }
+    }
+}
+
+size_t memoryPools::getPoolCount()
+{
+    return _count;
+}
+
+memoryPoolStats_t memoryPools::getPoolStats(size_t index)
+{
+    memoryPoolStats_t empty = {};
+    return (index < _count) ? _pools[index]->getStats() : empty;
+}
+
+uint32_t memoryPools::getHeapFallbacks()
+{
+    return _heapFallbacks;
+}
+
+uint32_t memoryPools::getFailures()
+{
+    return _failures;
+}
+
+memoryPools& systemPools()
+{
+    static staticMemoryPool<32, 64>  pool32;
+    static staticMemoryPool<64, 32>  pool64;
+    static staticMemoryPool<128, 16> pool128;
+    static staticMemoryPool<256, 8>  pool256;
+    static staticMemoryPool<512, 4>  pool512;
+
+    static memoryPool* const pools[] = {&pool32, &pool64, &pool128, &pool256, &pool512};
+    static memoryPools       instance(pools, sizeof(pools) / sizeof(pools[0]));
+    return instance;
+}
@@ -0,0 +1,272 @@
+/**
+ * @file memoryPool.h
+ * @brief Header file for memoryPool
+ *
+ * This file contains declarations for the memoryPool class and related data types and functions.
+ */
+#ifndef MEMORYPOOL_H
+#define MEMORYPOOL_H
+
+#include <atomic>
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#if defined(ESP_PLATFORM)
+#include "freertos/FreeRTOS.h"
+#endif
+
+/**
+ * @brief Counters of a memoryPool
+ */
+typedef struct
+{
+    uint32_t blockSize;
+    uint32_t blockCount;
+    uint32_t inUse;       // blocks currently allocated
+    uint32_t highWater;   // largest inUse seen since start
+    uint32_t allocations; // successful allocations
+    uint32_t failures;    // allocate() calls refused because the pool was empty, see memoryPools::getFailures() for a set
+} memoryPoolStats_t;
+
+/**
+ * @brief Short critical section usable from tasks and interrupts
+ * A core-local critical section on the ESP32 (interrupts masked, spinlock for the other core), a spinlock on the host.
+ */
+class poolLock
+{
+private:
+#if defined(ESP_PLATFORM)
+    portMUX_TYPE _mux;
+#else
+    std::atomic_flag _flag;
+#endif
+
+public:
+    poolLock();
+
+    void lock();
+    void unlock();
+    void lockFromISR();
+    void unlockFromISR();
+};
+
+/**
+ * @brief Pool of equally sized blocks on caller provided storage
+ *
+ * Free blocks form an intrusive singly linked list, so allocate() and release() are O(1)
+ * and the pool never fragments. The FromISR variants may be called from interrupt handlers.
+ */
+class memoryPool
+{
+private:
+    uint8_t*          _storage;
+    size_t            _blockSize;
+    size_t            _blockCount;
+    void*             _freeList;
+    memoryPoolStats_t _stats;
+    poolLock          _lock;
+
+    void* pop();
+    void  push(void* block);
+
+    // memoryPools tries the next class before it counts a failure
+    friend class memoryPools;
+    void* tryAllocateFromISR();
+
+public:
+    static constexpr size_t alignment = 8; // blocks are suitable for any scalar type
+
+    /**
+     * @brief Round a block size up to the pool alignment
+     */
+    static constexpr size_t alignedSize(size_t size)
+    {
+        return (size < sizeof(void*)) ? alignedSize(sizeof(void*)) : (size + alignment - 1) / alignment * alignment;
+    }
+
+    /**
+     * @brief Construct a new memoryPool object
+     *
+     * @param storage - alignedSize(blockSize) * blockCount bytes, aligned to memoryPool::alignment
+     * @param blockSize - usable size of a block
+     * @param blockCount - number of blocks
+     */
+    memoryPool(void* storage, size_t blockSize, size_t blockCount);
+    ~memoryPool();
+
+    // Delete copy constructor and assignment operator
+    memoryPool(const memoryPool&)            = delete;
+    memoryPool& operator=(const memoryPool&) = delete;
+
+    /**
+     * @brief Take a block
+     *
+     * @return void* nullptr if the pool is empty
+     */
+    void* allocate();
+
+    /**
+     * @brief Give a block back
+     *
+     * @param block - block returned by allocate(), nullptr is ignored
+     */
+    void release(void* block);
+
+    void* allocateFromISR();
+    void  releaseFromISR(void* block);
+
+    /**
+     * @brief Check if a pointer is a block of this pool
+     *
+     * @return bool
+     */
+    bool owns(const void* block);
+
+    size_t            getBlockSize();
+    memoryPoolStats_t getStats();
+};
+
+/**
+ * @brief memoryPool with its storage inside the object, e.g. for static allocation
+ */
+template <size_t BlockSize, size_t BlockCount> class staticMemoryPool : public memoryPool
+{
+private:
+    alignas(memoryPool::alignment) uint8_t _buffer[memoryPool::alignedSize(BlockSize) * BlockCount];
+
+public:
+    staticMemoryPool() : memoryPool(_buffer, BlockSize, BlockCount) {}
+};
+
+/**
+ * @brief Set of pools with increasing block sizes
+ * A request is served by the smallest pool that fits and has a free block. Requests no pool can serve
+ * fall back to the heap in task context and are counted, so the pool sizes can be tuned from the numbers.
+ */
+class memoryPools
+{
+private:
+    memoryPool* const*    _pools;
+    size_t                _count;
+    std::atomic<uint32_t> _heapFallbacks;
+    std::atomic<uint32_t> _failures;
+
+public:
+    /**
+     * @brief Construct a new memoryPools object
+     *
+     * @param pools - pools sorted by ascending block size
+     * @param count - number of pools
+     */
+    memoryPools(memoryPool* const* pools, size_t count);
+    ~memoryPools();
+
+    // Delete copy constructor and assignment operator
+    memoryPools(const memoryPools&)            = delete;
+    memoryPools& operator=(const memoryPools&) = delete;
+
+    /**
+     * @brief Allocate from the smallest fitting pool, from the heap if none can serve the request
+     *
+     * @param size - requested size in bytes
+     * @return void* nullptr only if the heap is exhausted as well
+     */
+    void* allocate(size_t size);
+
+    /**
+     * @brief Release memory returned by allocate()
+     *
+     * @param block - memory to release, nullptr is ignored
+     */
+    void release(void* block);
+
+    /**
+     * @brief Allocate from the pools only, for interrupt handlers
+     *
+     * @return void* nullptr if no pool can serve the request
+     */
+    void* allocateFromISR(size_t size);
+
+    /**
+     * @brief Release memory returned by allocateFromISR()
+     */
+    void releaseFromISR(void* block);
+
+    size_t            getPoolCount();
+    memoryPoolStats_t getPoolStats(size_t index);
+    uint32_t          getHeapFallbacks();
+
+    /**
+     * @brief Number of requests neither a pool nor the heap could serve
+     *
+     * @return uint32_t
+     */
+    uint32_t getFailures();
+};
+
+/**
+ * @brief System wide size classes: 32, 64, 128, 256 and 512 byte blocks
+ *
+ * @return memoryPools&
+ */
+memoryPools& systemPools();
+
+/**
+ * @brief STL allocator on top of systemPools()
+ */
+template <typename T> class poolAllocator
+{
+public:
+    typedef T value_type;
+
+    poolAllocator() {}
+    template <typename U> poolAllocator(const poolAllocator<U>&) {}
+
+    template <typename U> struct rebind
+    {
+        typedef poolAllocator<U> other;
+    };
+
+    /**
+     * @brief Allocate count objects, never returns nullptr
+     * Throws std::bad_alloc if count * sizeof(T) overflows or no memory is left; aborts instead when exceptions are
+     * disabled, e.g. in the default ESP-IDF configuration.
+     */
+    T* allocate(size_t count)
+    {
+        void* block = (count <= SIZE_MAX / sizeof(T)) ? systemPools().allocate(count * sizeof(T)) : nullptr;
+        if (block == nullptr)
+        {
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+            throw std::bad_alloc();
+#else
+            abort();
+#endif
+        }
+        return static_cast<T*>(block);
+    }
+
+    void deallocate(T* block, size_t)
+    {
+        systemPools().release(block);
+    }
+};
+
+template <typename T, typename U> bool operator==(const poolAllocator<T>&, const poolAllocator<U>&)
+{
+    return true;
+}
+
+template <typename T, typename U> bool operator!=(const poolAllocator<T>&, const poolAllocator<U>&)
+{
+    return false;
+}
+
+template <typename T> using poolVector = std::vector<T, poolAllocator<T>>;
+typedef std::basic_string<char, std::char_traits<char>, poolAllocator<char>> poolString;
+
+#endif /* MEMORYPOOL_H */
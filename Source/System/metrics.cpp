@@ -0,0 +1,248 @@
+/**
+ * @file metrics.cpp
+ * @brief Source file for metrics
+ *
+ * This file contains definitions for the metrics classes and related data types and functions.
+ */
+
+#include "metrics.h"
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace
+{
+const char* const typeNames[] = {"counter", "gauge", "histogram"}; // indexed by metricType_t
+} // namespace
+
+metricsStream::metricsStream(metricsWriter_t writer, void* context) : _writer(writer), _context(context), _ok(true) {}
+
+bool metricsStream::print(const char* format, ...)
+{
+    if (!_ok)
+    {
+        return false;
+    }
+
+    char    line[METRICS_LINE_SIZE];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+
+    if (length < 0)
+    {
+        _ok = false;
+        return false;
+    }
+    // A cut line is still sent, ending with the newline the format asked for
+    if (static_cast<size_t>(length) >= sizeof(line))
+    {
+        length                 = sizeof(line) - 1;
+        line[sizeof(line) - 2] = '\n';
+    }
+    _ok = _writer(_context, line, static_cast<size_t>(length));
+    return _ok;
+}
+
+bool metricsStream::sample(const char* name, const char* suffix, const char* labels, const char* extraLabel, int64_t value)
+{
+    bool        hasLabels = (labels != nullptr && labels[0] != '\0');
+    bool        hasExtra  = (extraLabel != nullptr && extraLabel[0] != '\0');
+    const char* open      = (hasLabels || hasExtra) ? "{" : "";
+    const char* separator = (hasLabels && hasExtra) ? "," : "";
+    const char* close     = (hasLabels || hasExtra) ? "}" : "";
+    return print("%s%s%s%s%s%s%s %" PRId64 "\n", name, (suffix != nullptr) ? suffix : "", open, hasLabels ? labels : "", separator, hasExtra ? extraLabel : "", close, value);
+}
+
+bool metricsStream::ok()
+{
+    return _ok;
+}
+
+metric::metric(const char* name, const char* help, const char* labels, metricType_t type, metricsRegistry& registry)
+    : _name(name), _help(help), _labels(labels), _type(type), _registry(registry), _next(nullptr)
+{
+    _registry.add(this);
+}
+
+metric::~metric()
+{
+    _registry.remove(this);
+}
+
+const char* metric::getName() const
+{
+    return _name;
+}
+
+const char* metric::getHelp() const
+{
+    return _help;
+}
+
+const char* metric::getLabels() const
+{
+    return _labels;
+}
+
+metricType_t metric::getType() const
+{
+    return _type;
+}
+
+metricsRegistry::metricsRegistry() : _head(nullptr) {}
+
+metricsRegistry::~metricsRegistry()
+{
+    // destructor implementation
+}
+
+void metricsRegistry::add(metric* item)
+{
+    metric* head = _head.load(std::memory_order_relaxed);
+    do
+    {
+        item->_next = head;
+    } while (!_head.compare_exchange_weak(head, item, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void metricsRegistry::remove(metric* item)
+{
+    metric* head = _head.load(std::memory_order_acquire);
+    if (head == item)
+    {
+        _head.store(item->_next, std::memory_order_release);
+        return;
+    }
+    for (metric* previous = head; previous != nullptr; previous = previous->_next)
+    {
+        if (previous->_next == item)
+        {
+            previous->_next = item->_next;
+            return;
+        }
+    }
+}
+
+size_t metricsRegistry::getCount()
+{
+    size_t count = 0;
+    for (metric* item = _head.load(std::memory_order_acquire); item != nullptr; item = item->_next)
+    {
+        count++;
+    }
+    return count;
+}
+
+const metric* metricsRegistry::find(const char* name)
+{
+    for (metric* item = _head.load(std::memory_order_acquire); item != nullptr; item = item->_next)
+    {
+        if (strcmp(item->_name, name) == 0)
+        {
+            return item;
+        }
+    }
+    return nullptr;
+}
+
+bool metricsRegistry::render(metricsWriter_t writer, void* context)
+{
+    metricsStream stream(writer, context);
+    metric*       head = _head.load(std::memory_order_acquire);
+
+    for (metric* item = head; item != nullptr && stream.ok(); item = item->_next)
+    {
+        // The family was rendered with its first member
+        if (find(item->_name) != item)
+        {
+            continue;
+        }
+
+        stream.print("# HELP %s %s\n", item->_name, item->_help);
+        stream.print("# TYPE %s %s\n", item->_name, typeNames[item->_type]);
+        for (metric* member = item; member != nullptr; member = member->_next)
+        {
+            if (strcmp(member->_name, item->_name) == 0)
+            {
+                member->renderSamples(stream);
+            }
+        }
+    }
+    return stream.ok();
+}
+
+metricsRegistry& metrics()
+{
+    // Constructed on first use, static metrics of other modules may be constructed before this module
+    static metricsRegistry registry;
+    return registry;
+}
+
+metricCounter::metricCounter(const char* name, const char* help, const char* labels, metricsRegistry& registry) : metric(name, help, labels, METRIC_COUNTER, registry), _value(0) {}
+
+bool metricCounter::renderSamples(metricsStream& stream) const
+{
+    return stream.sample(getName(), nullptr, getLabels(), nullptr, get());
+}
+
+metricGauge::metricGauge(const char* name, const char* help, const char* labels, metricsRegistry& registry) : metric(name, help, labels, METRIC_GAUGE, registry), _value(0) {}
+
+bool metricGauge::renderSamples(metricsStream& stream) const
+{
+    return stream.sample(getName(), nullptr, getLabels(), nullptr, get());
+}
+
+metricHistogramBase::metricHistogramBase(const char* name, const char* help, const uint32_t* bounds, std::atomic<uint32_t>* counts, size_t bucketCount, const char* labels, metricsRegistry& registry)
+    : metric(name, help, labels, METRIC_HISTOGRAM, registry), _bounds(bounds), _counts(counts), _bucketCount(bucketCount), _sum(0)
+{
+}
+
+void metricHistogramBase::observe(uint32_t value)
+{
+    size_t bucket = 0;
+    while (bucket < _bucketCount && value > _bounds[bucket])
+    {
+        bucket++;
+    }
+    _counts[bucket].fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+uint32_t metricHistogramBase::getCount() const
+{
+    uint32_t count = 0;
+    for (size_t bucket = 0; bucket <= _bucketCount; bucket++)
+    {
+        count += _counts[bucket].load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+uint32_t metricHistogramBase::getSum() const
+{
+    return _sum.load(std::memory_order_relaxed);
+}
+
+uint32_t metricHistogramBase::getBucket(size_t bucket) const
+{
+    return (bucket <= _bucketCount) ? _counts[bucket].load(std::memory_order_relaxed) : 0;
+}
+
+bool metricHistogramBase::renderSamples(metricsStream& stream) const
+{
+    char     le[24];
+    uint32_t cumulative = 0;
+    for (size_t bucket = 0; bucket < _bucketCount; bucket++)
+    {
+        cumulative += getBucket(bucket);
+        snprintf(le, sizeof(le), "le=\"%" PRIu32 "\"", _bounds[bucket]);
+        stream.sample(getName(), "_bucket", getLabels(), le, cumulative);
+    }
+    cumulative += getBucket(_bucketCount);
+    stream.sample(getName(), "_bucket", getLabels(), "le=\"+Inf\"", cumulative);
+    stream.sample(getName(), "_sum", getLabels(), nullptr, getSum());
+    return stream.sample(getName(), "_count", getLabels(), nullptr, cumulative);
+}
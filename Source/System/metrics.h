@@ -0,0 +1,302 @@
+/**
+ * @file metrics.h
+ * @brief Header file for metrics
+ *
+ * This file contains declarations for the metrics classes and related data types and functions.
+ *
+ * Modules define their metrics as static objects, which register themselves at startup:
+ *
+ *     static metricCounter buttonEvents("button_events_total", "GPIO events handled by the button listeners");
+ *     ...
+ *     buttonEvents.inc();
+ *
+ * Updates are single relaxed atomic operations on 32 bit values, lock-free on the ESP32 and safe in interrupts.
+ * metricsRegistry::render() writes all metrics in the Prometheus text exposition format line by line to a
+ * writer, e.g. httpd_resp_send_chunk(), without building the response in memory.
+ */
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#define METRICS_LINE_SIZE 192 // longest exposition line, rendered on the stack
+
+/**
+ * @brief Metric types of the exposition format
+ */
+typedef enum : uint8_t
+{
+    METRIC_COUNTER   = 0, // only goes up, wraps around at 2^32 which a scraper sees as a reset
+    METRIC_GAUGE     = 1, // goes up and down
+    METRIC_HISTOGRAM = 2, // counts of observations in fixed buckets, their sum and count
+} metricType_t;
+
+/**
+ * @brief Destination of the rendered exposition
+ *
+ * @param context - writer context passed to render()
+ * @param data - text, not null terminated
+ * @param length - text length
+ * @return bool false to stop rendering
+ */
+typedef bool (*metricsWriter_t)(void* context, const char* data, size_t length);
+
+/**
+ * @brief Line formatter handed to the metrics while rendering
+ */
+class metricsStream
+{
+private:
+    metricsWriter_t _writer;
+    void*           _context;
+    bool            _ok;
+
+public:
+    metricsStream(metricsWriter_t writer, void* context);
+
+    /**
+     * @brief Format one line and pass it to the writer, nothing is written once the writer failed
+     *
+     * @return bool false if the writer failed
+     */
+    bool print(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+    /**
+     * @brief Write one sample line: name[suffix]{labels[,extraLabel]} value
+     *
+     * @param name - metric name
+     * @param suffix - appended to the name, e.g. "_bucket" (optional)
+     * @param labels - constant labels of the metric (optional)
+     * @param extraLabel - label of the sample, e.g. le="10" (optional)
+     * @param value - sample value
+     * @return bool false if the writer failed
+     */
+    bool sample(const char* name, const char* suffix, const char* labels, const char* extraLabel, int64_t value);
+
+    bool ok();
+};
+
+class metricsRegistry;
+
+/**
+ * @brief Base of all metrics
+ * Metrics with the same name and different labels form a family, rendered under one HELP and TYPE header.
+ */
+class metric
+{
+private:
+    const char*      _name;
+    const char*      _help;
+    const char*      _labels;
+    metricType_t     _type;
+    metricsRegistry& _registry;
+    metric*          _next;
+
+    friend class metricsRegistry;
+
+protected:
+    /**
+     * @brief Construct a new metric object and add it to the registry
+     *
+     * @param name - metric name, [a-zA-Z_:][a-zA-Z0-9_:]*, must stay valid
+     * @param help - description, must stay valid
+     * @param labels - constant labels, e.g. "core=\"0\"", nullptr for none, must stay valid
+     * @param type - metric type
+     * @param registry - registry the metric is added to
+     */
+    metric(const char* name, const char* help, const char* labels, metricType_t type, metricsRegistry& registry);
+
+public:
+    virtual ~metric();
+
+    // Delete copy constructor and assignment operator
+    metric(const metric&)            = delete;
+    metric& operator=(const metric&) = delete;
+
+    const char*  getName() const;
+    const char*  getHelp() const;
+    const char*  getLabels() const;
+    metricType_t getType() const;
+
+    /**
+     * @brief Write the sample lines of the metric
+     *
+     * @return bool false if the writer failed
+     */
+    virtual bool renderSamples(metricsStream& stream) const = 0;
+};
+
+/**
+ * @brief List of metrics
+ * Adding a metric is lock-free, so static metrics of any module can register before the scheduler starts.
+ * Removing one (a metric going out of scope) must not race with adding or rendering.
+ */
+class metricsRegistry
+{
+private:
+    std::atomic<metric*> _head;
+
+public:
+    metricsRegistry();
+    ~metricsRegistry();
+
+    // Delete copy constructor and assignment operator
+    metricsRegistry(const metricsRegistry&)            = delete;
+    metricsRegistry& operator=(const metricsRegistry&) = delete;
+
+    void add(metric* item);
+    void remove(metric* item);
+
+    size_t getCount();
+
+    /**
+     * @brief Find the first metric of a family
+     *
+     * @return const metric* nullptr if there is none
+     */
+    const metric* find(const char* name);
+
+    /**
+     * @brief Write all metrics in the Prometheus text exposition format (version 0.0.4), family by family
+     *
+     * @param writer - destination, called once per line
+     * @param context - writer context
+     * @return bool false if the writer failed
+     */
+    bool render(metricsWriter_t writer, void* context);
+};
+
+/**
+ * @brief The registry of the system, where metrics are added by default
+ */
+metricsRegistry& metrics();
+
+/**
+ * @brief Counter, e.g. of events or errors
+ */
+class metricCounter : public metric
+{
+private:
+    std::atomic<uint32_t> _value;
+
+public:
+    metricCounter(const char* name, const char* help, const char* labels = nullptr, metricsRegistry& registry = metrics());
+
+    void inc()
+    {
+        _value.fetch_add(1, std::memory_order_relaxed);
+    }
+    void add(uint32_t value)
+    {
+        _value.fetch_add(value, std::memory_order_relaxed);
+    }
+    uint32_t get() const
+    {
+        return _value.load(std::memory_order_relaxed);
+    }
+
+    bool renderSamples(metricsStream& stream) const override;
+};
+
+/**
+ * @brief Gauge, e.g. a queue depth or a connection state
+ */
+class metricGauge : public metric
+{
+private:
+    std::atomic<int32_t> _value;
+
+public:
+    metricGauge(const char* name, const char* help, const char* labels = nullptr, metricsRegistry& registry = metrics());
+
+    void set(int32_t value)
+    {
+        _value.store(value, std::memory_order_relaxed);
+    }
+    void add(int32_t value)
+    {
+        _value.fetch_add(value, std::memory_order_relaxed);
+    }
+    void inc()
+    {
+        add(1);
+    }
+    void dec()
+    {
+        add(-1);
+    }
+    int32_t get() const
+    {
+        return _value.load(std::memory_order_relaxed);
+    }
+
+    bool renderSamples(metricsStream& stream) const override;
+};
+
+/**
+ * @brief Histogram with fixed buckets, storage provided by metricHistogram<Buckets>
+ * Only the bucket of an observation is incremented, the cumulative counts are summed up while rendering.
+ */
+class metricHistogramBase : public metric
+{
+private:
+    const uint32_t*        _bounds;
+    std::atomic<uint32_t>* _counts; // one per bound plus +Inf
+    size_t                 _bucketCount;
+    std::atomic<uint32_t>  _sum;
+
+protected:
+    metricHistogramBase(const char* name, const char* help, const uint32_t* bounds, std::atomic<uint32_t>* counts, size_t bucketCount, const char* labels, metricsRegistry& registry);
+
+public:
+    /**
+     * @brief Record a value, in the unit of the bucket bounds
+     */
+    void observe(uint32_t value);
+
+    uint32_t getCount() const;
+    uint32_t getSum() const;
+
+    /**
+     * @brief Get the observations of one bucket, not cumulative
+     *
+     * @param bucket - bucket index, bucketCount for +Inf
+     */
+    uint32_t getBucket(size_t bucket) const;
+
+    bool renderSamples(metricsStream& stream) const override;
+};
+
+/**
+ * @brief Histogram with fixed buckets
+ *
+ * @tparam Buckets - number of upper bounds, an implicit +Inf bucket is added
+ */
+template <size_t Buckets> class metricHistogram : public metricHistogramBase
+{
+private:
+    std::atomic<uint32_t> _storage[Buckets + 1];
+
+public:
+    /**
+     * @brief Construct a new metricHistogram object
+     *
+     * @param name - metric name, must stay valid
+     * @param help - description, must stay valid
+     * @param bounds - inclusive upper bounds in increasing order, must stay valid
+     * @param labels - constant labels, nullptr for none (optional)
+     * @param registry - registry the metric is added to (default metrics())
+     */
+    metricHistogram(const char* name, const char* help, const uint32_t (&bounds)[Buckets], const char* labels = nullptr, metricsRegistry& registry = metrics())
+        : metricHistogramBase(name, help, bounds, _storage, Buckets, labels, registry)
+    {
+        for (std::atomic<uint32_t>& count : _storage)
+        {
+            count.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+#endif /* METRICS_H */
@@ -0,0 +1,240 @@
+/**
+ * @file processRegistry.h
+ * @brief Header file for processRegistry
+ *
+ * This file contains declarations for the processRegistry class and related data types and functions.
+ *
+ * Each process is described by a type with its ID, task stack size, priority, core affinity, dependencies and
+ * parameter struct as compile time constants (see processTraits), plus static start()/stop() functions acting
+ * on a statically allocated instance:
+ *
+ *     struct wifiProcess : processTraits<1, 4096, 12, 0, processDependencies<>::mask, wifiParams_t>
+ *     {
+ *         static constexpr const char* name = "wifi";
+ *         static sys_error_t start();
+ *         static sys_error_t stop();
+ *     };
+ *
+ * processRegistry<wifiProcess, httpProcess, ...> turns the list into a constant table in flash. The list is the
+ * boot order: IDs must be unique and a process must come after all of its dependencies, both are checked by
+ * the compiler. Nothing is registered or allocated at runtime.
+ */
+#ifndef PROCESSREGISTRY_H
+#define PROCESSREGISTRY_H
+
+#include "error_definitions.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define PROCESS_MAX_COUNT 32 // IDs are bits of a dependency mask
+#define PROCESS_CORE_ANY  -1 // no core affinity
+
+#define PROCESS_BIT(id) (static_cast<uint32_t>(1) << (id))
+
+typedef uint8_t processId_t;
+
+/**
+ * @brief Entry of the process table
+ */
+typedef struct
+{
+    processId_t id;
+    const char* name;
+    uint32_t    stackSize; // bytes
+    uint8_t     priority;
+    int8_t      core;    // PROCESS_CORE_ANY or core number
+    uint32_t    depends; // PROCESS_BIT() of the processes that must run first
+    sys_error_t (*start)();
+    sys_error_t (*stop)();
+} processDescriptor_t;
+
+/**
+ * @brief Result of starting one process
+ */
+typedef struct
+{
+    processId_t id;
+    sys_error_t result;  // ERROR_INIT_FAILED without a start attempt if a dependency failed
+    uint32_t    startUs; // time spent in start()
+} processBootRecord_t;
+
+/**
+ * @brief Microsecond clock used to time the boot, e.g. esp_timer_get_time()
+ */
+typedef uint64_t (*processClock_t)();
+
+/**
+ * @brief Compile time constants of a process, base of its descriptor type
+ *
+ * @tparam Id - unique ID, below PROCESS_MAX_COUNT
+ * @tparam StackSize - stack of the process task in bytes
+ * @tparam Priority - priority of the process task
+ * @tparam Core - core affinity, PROCESS_CORE_ANY for none
+ * @tparam Depends - processDependencies<...>::mask of the processes that must be started first
+ * @tparam Params - parameter struct of the process
+ */
+template <processId_t Id, uint32_t StackSize, uint8_t Priority, int8_t Core, uint32_t Depends, typename Params> struct processTraits
+{
+    static_assert(Id < PROCESS_MAX_COUNT, "processTraits: the ID does not fit in a dependency mask");
+
+    static constexpr processId_t id        = Id;
+    static constexpr uint32_t    stackSize = StackSize;
+    static constexpr uint8_t     priority  = Priority;
+    static constexpr int8_t      core      = Core;
+    static constexpr uint32_t    depends   = Depends;
+    typedef Params               params_t;
+};
+
+/**
+ * @brief Dependency mask of a list of process descriptors
+ */
+template <typename... Processes> struct processDependencies;
+
+template <> struct processDependencies<>
+{
+    static constexpr uint32_t mask = 0;
+};
+
+template <typename First, typename... Rest> struct processDependencies<First, Rest...>
+{
+    static constexpr uint32_t mask = PROCESS_BIT(First::id) | processDependencies<Rest...>::mask;
+};
+
+/**
+ * @brief Compile time checks of a boot order
+ */
+template <typename... Processes> struct processOrder;
+
+template <> struct processOrder<>
+{
+    static constexpr bool uniqueIds(uint32_t seen)
+    {
+        return true;
+    }
+    static constexpr bool dependenciesFirst(uint32_t started)
+    {
+        return true;
+    }
+};
+
+template <typename First, typename... Rest> struct processOrder<First, Rest...>
+{
+    static constexpr bool uniqueIds(uint32_t seen)
+    {
+        return (seen & PROCESS_BIT(First::id)) == 0 && processOrder<Rest...>::uniqueIds(seen | PROCESS_BIT(First::id));
+    }
+    static constexpr bool dependenciesFirst(uint32_t started)
+    {
+        return (First::depends & ~started) == 0 && processOrder<Rest...>::dependenciesFirst(started | PROCESS_BIT(First::id));
+    }
+};
+
+/**
+ * @brief Static process table, booted in list order
+ *
+ * @tparam Processes - process descriptor types in boot order
+ */
+template <typename... Processes> class processRegistry
+{
+    static_assert(sizeof...(Processes) > 0, "processRegistry: no process");
+    static_assert(sizeof...(Processes) <= PROCESS_MAX_COUNT, "processRegistry: too many processes");
+    static_assert(processOrder<Processes...>::uniqueIds(0), "processRegistry: two processes have the same ID");
+    static_assert(processOrder<Processes...>::dependenciesFirst(0), "processRegistry: a process is listed before one of its dependencies");
+
+private:
+    static const processDescriptor_t _table[sizeof...(Processes)];
+
+public:
+    static constexpr size_t count = sizeof...(Processes);
+
+    /**
+     * @brief The process table, in boot order
+     */
+    static const processDescriptor_t* getTable()
+    {
+        return _table;
+    }
+
+    /**
+     * @brief Find a process by ID
+     *
+     * @return const processDescriptor_t* nullptr if the ID is not in the table
+     */
+    static const processDescriptor_t* find(processId_t id)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            if (_table[i].id == id)
+            {
+                return &_table[i];
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Start all processes in table order
+     * A process whose dependency failed is not started and fails as well; the others still start.
+     *
+     * @param records - start result and time of each process, count entries in table order (optional)
+     * @param clock - microsecond clock for the start times (optional)
+     * @return sys_error_t ERROR_SUCCESS or the first error
+     */
+    static sys_error_t boot(processBootRecord_t* records = nullptr, processClock_t clock = nullptr)
+    {
+        sys_error_t first   = ERROR_SUCCESS;
+        uint32_t    started = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            const processDescriptor_t& process = _table[i];
+            sys_error_t                result  = ERROR_INIT_FAILED;
+            uint64_t                   begin   = (clock != nullptr) ? clock() : 0;
+            if ((process.depends & ~started) == 0)
+            {
+                result = process.start();
+            }
+            uint64_t end = (clock != nullptr) ? clock() : 0;
+
+            if (result == ERROR_SUCCESS)
+            {
+                started |= PROCESS_BIT(process.id);
+            }
+            else if (first == ERROR_SUCCESS)
+            {
+                first = result;
+            }
+            if (records != nullptr)
+            {
+                records[i].id      = process.id;
+                records[i].result  = result;
+                records[i].startUs = static_cast<uint32_t>(end - begin);
+            }
+        }
+        return first;
+    }
+
+    /**
+     * @brief Stop all processes in reverse table order, dependents before their dependencies
+     *
+     * @return sys_error_t ERROR_SUCCESS or the first error
+     */
+    static sys_error_t shutdown()
+    {
+        sys_error_t first = ERROR_SUCCESS;
+        for (size_t i = count; i > 0; i--)
+        {
+            sys_error_t result = _table[i - 1].stop();
+            if (result != ERROR_SUCCESS && first == ERROR_SUCCESS)
+            {
+                first = result;
+            }
+        }
+        return first;
+    }
+};
+
+template <typename... Processes>
+const processDescriptor_t processRegistry<Processes...>::_table[sizeof...(Processes)] = {
+    {Processes::id, Processes::name, Processes::stackSize, Processes::priority, Processes::core, Processes::depends, &Processes::start, &Processes::stop}...};
+
+#endif /* PROCESSREGISTRY_H */
@@ -0,0 +1,113 @@
+/**
+ * @file rtosObjects.cpp
+ * @brief Source file for rtosObjects
+ *
+ * This file contains definitions for the FreeRTOS task, queue and timer holders.
+ */
+
+#include "rtosObjects.h"
+
+#if SYSTEM_STATIC_ALLOCATION
+rtosTaskBase::rtosTaskBase(uint32_t stackSize, StackType_t* stack) : _handle(NULL), _stackSize(stackSize), _stack(stack), _control() {}
+#else
+rtosTaskBase::rtosTaskBase(uint32_t stackSize, StackType_t* stack) : _handle(NULL), _stackSize(stackSize)
+{
+    (void)stack; // the stack comes from the heap
+}
+#endif
+
+rtosTaskBase::~rtosTaskBase()
+{
+    remove();
+}
+
+sys_error_t rtosTaskBase::create(TaskFunction_t function, const char* name, void* arg, UBaseType_t priority, int8_t core)
+{
+    if (_handle != NULL)
+    {
+        return ERROR_DEVICE_BUSY;
+    }
+
+    // A core that does not exist, e.g. on single core parts, leaves the choice to the scheduler
+    BaseType_t affinity = (core >= 0 && core < portNUM_PROCESSORS) ? static_cast<BaseType_t>(core) : tskNO_AFFINITY;
+#if SYSTEM_STATIC_ALLOCATION
+    _handle = xTaskCreateStaticPinnedToCore(function, name, _stackSize, arg, priority, _stack, &_control, affinity);
+#else
+    if (xTaskCreatePinnedToCore(function, name, _stackSize, arg, priority, &_handle, affinity) != pdPASS)
+    {
+        _handle = NULL;
+    }
+#endif
+    return (_handle != NULL) ? ERROR_SUCCESS : ERROR_OUT_OF_MEMORY;
+}
+
+void rtosTaskBase::remove()
+{
+    if (_handle != NULL)
+    {
+        vTaskDelete(_handle);
+        _handle = NULL;
+    }
+}
+
+void rtosTaskBase::suspend()
+{
+    if (_handle != NULL)
+    {
+        vTaskSuspend(_handle);
+    }
+}
+
+void rtosTaskBase::resume()
+{
+    if (_handle != NULL)
+    {
+        vTaskResume(_handle);
+    }
+}
+
+void rtosTaskBase::notify()
+{
+    if (_handle != NULL)
+    {
+        xTaskNotifyGive(_handle);
+    }
+}
+
+TaskHandle_t rtosTaskBase::getHandle()
+{
+    return _handle;
+}
+
+uint32_t rtosTaskBase::getStackSize()
+{
+    return _stackSize;
+}
+
+rtosTimer::rtosTimer() : _handle(NULL) {}
+
+rtosTimer::~rtosTimer()
+{
+    if (_handle != NULL)
+    {
+        xTimerDelete(_handle, portMAX_DELAY);
+    }
+}
+
+TimerHandle_t rtosTimer::create(const char* name, TickType_t period, bool autoReload, void* id, TimerCallbackFunction_t callback)
+{
+    if (_handle == NULL)
+    {
+#if SYSTEM_STATIC_ALLOCATION
+        _handle = xTimerCreateStatic(name, period, autoReload ? pdTRUE : pdFALSE, id, callback, &_control);
+#else
+        _handle = xTimerCreate(name, period, autoReload ? pdTRUE : pdFALSE, id, callback);
+#endif
+    }
+    return _handle;
+}
+
+TimerHandle_t rtosTimer::getHandle()
+{
+    return _handle;
+}
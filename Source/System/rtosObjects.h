@@ -0,0 +1,181 @@
+/**
+ * @file rtosObjects.h
+ * @brief Header file for rtosObjects
+ *
+ * This file contains declarations for the FreeRTOS task, queue and timer holders.
+ *
+ * With SYSTEM_STATIC_ALLOCATION set, each holder carries the storage of its object and creates it
+ * with the *Static FreeRTOS API. Declared as members of statically allocated processes and drivers,
+ * all task stacks, queue buffers and control blocks end up in .bss: the memory budget is checked by
+ * the linker and boot does not depend on the heap. Without it the same holders use the heap API.
+ */
+#ifndef RTOSOBJECTS_H
+#define RTOSOBJECTS_H
+
+#include "System/system.h"
+#include "System/taskBands.h"
+
+#if SYSTEM_STATIC_ALLOCATION && !configSUPPORT_STATIC_ALLOCATION
+#error "SYSTEM_STATIC_ALLOCATION needs configSUPPORT_STATIC_ALLOCATION in the FreeRTOS configuration"
+#endif
+
+/**
+ * @brief Task holder, the stack size is provided by rtosTask<StackSize>
+ */
+class rtosTaskBase
+{
+private:
+    TaskHandle_t _handle;
+    uint32_t     _stackSize;
+#if SYSTEM_STATIC_ALLOCATION
+    StackType_t* _stack;
+    StaticTask_t _control;
+#endif
+
+protected:
+    rtosTaskBase(uint32_t stackSize, StackType_t* stack);
+
+public:
+    virtual ~rtosTaskBase();
+
+    // Delete copy constructor and assignment operator
+    rtosTaskBase(const rtosTaskBase&)            = delete;
+    rtosTaskBase& operator=(const rtosTaskBase&) = delete;
+
+    /**
+     * @brief Create the task, fails if it is already running
+     *
+     * @param function - task function
+     * @param name - task name
+     * @param arg - task parameter
+     * @param priority - task priority, see taskBands.h
+     * @param core - core to pin the task to, PROCESS_CORE_ANY to let the scheduler choose (default)
+     * @return sys_error_t
+     */
+    sys_error_t create(TaskFunction_t function, const char* name, void* arg, UBaseType_t priority, int8_t core = PROCESS_CORE_ANY);
+
+    /**
+     * @brief Delete the task, its storage can be reused by create()
+     */
+    void remove();
+
+    void suspend();
+    void resume();
+
+    /**
+     * @brief Wake the task up from ulTaskNotifyTake()
+     */
+    void notify();
+
+    TaskHandle_t getHandle();
+    uint32_t     getStackSize();
+};
+
+/**
+ * @brief Task holder with its stack
+ *
+ * @tparam StackSize - stack depth as passed to xTaskCreate (bytes on ESP-IDF)
+ */
+template <uint32_t StackSize> class rtosTask : public rtosTaskBase
+{
+private:
+#if SYSTEM_STATIC_ALLOCATION
+    StackType_t _stack[StackSize];
+
+public:
+    rtosTask() : rtosTaskBase(StackSize, _stack) {}
+#else
+public:
+    rtosTask() : rtosTaskBase(StackSize, nullptr) {}
+#endif
+};
+
+/**
+ * @brief Queue holder with its item buffer
+ *
+ * @tparam T - item type
+ * @tparam Length - maximum number of items
+ */
+template <typename T, size_t Length> class rtosQueue
+{
+private:
+    QueueHandle_t _handle;
+#if SYSTEM_STATIC_ALLOCATION
+    StaticQueue_t _control;
+    uint8_t       _storage[Length * sizeof(T)];
+#endif
+
+public:
+    rtosQueue() : _handle(NULL) {}
+
+    ~rtosQueue()
+    {
+        if (_handle != NULL)
+        {
+            vQueueDelete(_handle);
+        }
+    }
+
+    // Delete copy constructor and assignment operator
+    rtosQueue(const rtosQueue&)            = delete;
+    rtosQueue& operator=(const rtosQueue&) = delete;
+
+    /**
+     * @brief Create the queue once
+     *
+     * @return QueueHandle_t NULL if the heap is exhausted (dynamic mode only)
+     */
+    QueueHandle_t create()
+    {
+        if (_handle == NULL)
+        {
+#if SYSTEM_STATIC_ALLOCATION
+            _handle = xQueueCreateStatic(Length, sizeof(T), _storage, &_control);
+#else
+            _handle = xQueueCreate(Length, sizeof(T));
+#endif
+        }
+        return _handle;
+    }
+
+    QueueHandle_t getHandle()
+    {
+        return _handle;
+    }
+};
+
+/**
+ * @brief Software timer holder
+ */
+class rtosTimer
+{
+private:
+    TimerHandle_t _handle;
+#if SYSTEM_STATIC_ALLOCATION
+    StaticTimer_t _control;
+#endif
+
+public:
+    rtosTimer();
+    ~rtosTimer();
+
+    // Delete copy constructor and assignment operator
+    rtosTimer(const rtosTimer&)            = delete;
+    rtosTimer& operator=(const rtosTimer&) = delete;
+
+    /**
+     * @brief Create the timer once, must not be called from an interrupt
+     *
+     * @param name - timer name
+     * @param period - period in ticks
+     * @param autoReload - restart the timer after it expired
+     * @param id - timer id, read back with pvTimerGetTimerID()
+     * @param callback - timer callback, runs in the timer service task
+     * @return TimerHandle_t NULL if the heap is exhausted (dynamic mode only)
+     */
+    TimerHandle_t create(const char* name, TickType_t period, bool autoReload, void* id, TimerCallbackFunction_t callback);
+
+    TimerHandle_t getHandle();
+};
+
+#endif /* RTOSOBJECTS_H */
@@ -43,7 +43,7 @@
 #include <thread>
 
 //** Process Architecture Includes **//
-// #include "process.h"
+#include "processRegistry.h"
 
 ///** uController Includes **///
 // #include "esp_log.h"
@@ -54,31 +54,19 @@
 
 #define QUEUE_SIZE   32 // Default Queue List Size
 
-/** TYPEDEFS ******************************************************************/
-
-typedef enum
-{
-    //**Demo App **//
-    eTaskDemo1 = 0,
-
-    //**Demo App2 **//
-    eTaskDemo2,
-
-    eTaskMax,
-} eTaskID_t;
+// 1: tasks, queues and timers of processes and HAL drivers use the FreeRTOS *Static API with storage
+// inside their owning objects (see rtosObjects.h), 0: they are allocated from the heap at runtime
+#ifndef SYSTEM_STATIC_ALLOCATION
+#define SYSTEM_STATIC_ALLOCATION 0
+#endif
 
-typedef enum
-{
-    eProcessDemo1 = 1,
-    eProcessDemo2,
-    eProcessMax,
-} eProcessID_t;
+/** TYPEDEFS ******************************************************************/
 
 typedef struct
 {
-    eProcessID_t senderProcess; ///> Sender Process ID
-    eTaskID_t    senderTask;    ///> Sender Task ID
-    uint32_t     data;          ///> Data pointer
+    processId_t senderProcess; ///> Sender Process ID, processTraits::id of its descriptor
+    uint8_t     senderTask;    ///> Sender Task index within the process
+    uint32_t    data;          ///> Data pointer
 } Message_t;
 
 /** MACROS ********************************************************************/
@@ -0,0 +1,81 @@
+/**
+ * @file taskBands.h
+ * @brief Header file for taskBands
+ *
+ * This file contains declarations for the task priority bands and core roles.
+ *
+ * Task priorities are planned in bands instead of picking numbers per process. On ESP-IDF the
+ * system tasks sit above and between them: lwIP at 18, esp_timer at 22, Wi-Fi at 23 and IPC at 24,
+ * with the Wi-Fi stack pinned to core 0. Latency sensitive I/O is pinned to the other core, so a
+ * Wi-Fi burst can not delay it no matter the priorities.
+ */
+#ifndef TASKBANDS_H
+#define TASKBANDS_H
+
+#include <stdint.h>
+
+#define TASK_CORE_PROTOCOL 0 // Wi-Fi, lwIP and network processes
+#define TASK_CORE_APP      1 // realtime I/O, isolated from network bursts
+
+/**
+ * @brief Priority bands, lowest to highest
+ */
+typedef enum : uint8_t
+{
+    TASK_BAND_BACKGROUND = 0, // 1-4: profiling, logging, housekeeping
+    TASK_BAND_NETWORK,        // 5-9: servers and clients on top of lwIP
+    TASK_BAND_REALTIME_IO,    // 10-17: GPIO listeners, LED and actuator loops
+    TASK_BAND_ISR_DEFERRED,   // 19-21: work handed over by interrupt handlers
+    TASK_BAND_SYSTEM,         // idle, lwIP, esp_timer, Wi-Fi, IPC: owned by ESP-IDF
+    TASK_BAND_COUNT,
+} taskBand_t;
+
+/**
+ * @brief Lowest priority of a band
+ */
+constexpr uint8_t taskBandLowest(taskBand_t band)
+{
+    return (band == TASK_BAND_BACKGROUND) ? 1 : (band == TASK_BAND_NETWORK) ? 5 : (band == TASK_BAND_REALTIME_IO) ? 10 : (band == TASK_BAND_ISR_DEFERRED) ? 19 : 22;
+}
+
+/**
+ * @brief Highest priority of a band
+ */
+constexpr uint8_t taskBandHighest(taskBand_t band)
+{
+    return (band == TASK_BAND_BACKGROUND) ? 4 : (band == TASK_BAND_NETWORK) ? 9 : (band == TASK_BAND_REALTIME_IO) ? 17 : (band == TASK_BAND_ISR_DEFERRED) ? 21 : 24;
+}
+
+/**
+ * @brief Priority inside a band, usable in processTraits
+ *
+ * @param band - priority band
+ * @param level - steps above the lowest priority of the band, clamped to the band
+ */
+constexpr uint8_t taskBandPriority(taskBand_t band, uint8_t level = 0)
+{
+    return (taskBandLowest(band) + level > taskBandHighest(band)) ? taskBandHighest(band) : static_cast<uint8_t>(taskBandLowest(band) + level);
+}
+
+/**
+ * @brief Band of a priority, priorities outside the application bands belong to the system
+ */
+inline taskBand_t taskBandOf(uint32_t priority)
+{
+    for (uint8_t band = TASK_BAND_BACKGROUND; band < TASK_BAND_SYSTEM; band++)
+    {
+        if (priority >= taskBandLowest(static_cast<taskBand_t>(band)) && priority <= taskBandHighest(static_cast<taskBand_t>(band)))
+        {
+            return static_cast<taskBand_t>(band);
+        }
+    }
+    return TASK_BAND_SYSTEM;
+}
+
+inline const char* taskBandName(taskBand_t band)
+{
+    static const char* const names[TASK_BAND_COUNT] = {"background", "network", "realtime_io", "isr_deferred", "system"};
+    return (band < TASK_BAND_COUNT) ? names[band] : "unknown";
+}
+
+#endif /* TASKBANDS_H */
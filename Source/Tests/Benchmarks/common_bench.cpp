@@ -0,0 +1,87 @@
+#include "Library/Common/cobs.h"
+#include "Library/Common/crc.h"
+#include "Library/Common/helperConversions.h"
+#include "Library/Common/textFormat.h"
+#include "benchmark/benchmark.h"
+
+#include <stdio.h>
+#include <vector>
+
+static void BM_ConvertToMac(benchmark::State& state)
+{
+    uint8_t address[6] = {0x24, 0x6f, 0x28, 0xa1, 0xb2, 0xc3};
+    for (auto _ : state)
+    {
+        mac::macString_t text = mac::convertToMac(address);
+        benchmark::DoNotOptimize(text);
+        address[5]++;
+    }
+}
+BENCHMARK(BM_ConvertToMac);
+
+static void BM_FormatLogMessage(benchmark::State& state)
+{
+    uint8_t  address[6] = {0x24, 0x6f, 0x28, 0xa1, 0xb2, 0xc3};
+    uint16_t aid        = 1;
+    for (auto _ : state)
+    {
+        format::fixedString<64> text;
+        format::formatTo(text, "Station {} join, AID= {}", format::mac(address), aid++);
+        benchmark::DoNotOptimize(text);
+    }
+}
+BENCHMARK(BM_FormatLogMessage);
+
+static void BM_SnprintfLogMessage(benchmark::State& state)
+{
+    uint8_t  address[6] = {0x24, 0x6f, 0x28, 0xa1, 0xb2, 0xc3};
+    uint16_t aid        = 1;
+    for (auto _ : state)
+    {
+        char text[64];
+        snprintf(text, sizeof(text), "Station %02x:%02x:%02x:%02x:%02x:%02x join, AID= %u", address[0], address[1], address[2], address[3], address[4], address[5], aid++);
+        benchmark::DoNotOptimize(text);
+    }
+}
+BENCHMARK(BM_SnprintfLogMessage);
+
+static void BM_Crc32(benchmark::State& state)
+{
+    std::vector<uint8_t> data(state.range(0), 0xA5);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(crc::crc32(data.data(), data.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Crc32)->Arg(16)->Arg(256)->Arg(4096);
+
+static void BM_Crc16(benchmark::State& state)
+{
+    std::vector<uint8_t> data(state.range(0), 0xA5);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(crc::crc16(data.data(), data.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Crc16)->Arg(16)->Arg(256);
+
+static void BM_CobsRoundTrip(benchmark::State& state)
+{
+    std::vector<uint8_t> data(state.range(0));
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<uint8_t>(i * 7); // a zero every 256 bytes
+    }
+    std::vector<uint8_t> encoded(cobs::maxEncodedLength(data.size()));
+    std::vector<uint8_t> decoded(data.size());
+    for (auto _ : state)
+    {
+        size_t encodedLength = cobs::encode(data.data(), data.size(), encoded.data());
+        size_t decodedLength = 0;
+        benchmark::DoNotOptimize(cobs::decode(encoded.data(), encodedLength, decoded.data(), decodedLength));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CobsRoundTrip)->Arg(64)->Arg(1024);
@@ -0,0 +1,42 @@
+#include "Library/Diagnostics/taskProfiler.h"
+#include "Library/Diagnostics/trace.h"
+#include "benchmark/benchmark.h"
+
+#include <string.h>
+
+static void BM_TraceRecord(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        tracer().record(TRACE_EVENT_GPIO_ISR, TRACE_PHASE_INSTANT, 4);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TraceRecord);
+
+static void BM_TaskProfilerUpdate(benchmark::State& state)
+{
+    taskProfiler profiler;
+    profiler.addProcess("leds");
+    profiler.addProcess("button");
+
+    taskSample_t samples[24] = {};
+    for (size_t i = 0; i < 24; i++)
+    {
+        samples[i].id      = i + 1;
+        samples[i].process = static_cast<int16_t>(i % 3) - 1;
+        snprintf(samples[i].name, sizeof(samples[i].name), "task%u", static_cast<unsigned>(i));
+    }
+
+    uint32_t now = 0;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < 24; i++)
+        {
+            samples[i].runTime += 1000;
+        }
+        now += 1000;
+        profiler.update(samples, 24, now * 24, now);
+    }
+}
+BENCHMARK(BM_TaskProfilerUpdate);
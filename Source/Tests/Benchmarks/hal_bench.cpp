@@ -0,0 +1,60 @@
+#include "HAL/Platform/Linux/io_hostGpio.hpp"
+#include "HAL/Platform/Linux/io_hostGpioPort.hpp"
+#include "benchmark/benchmark.h"
+
+#include <vector>
+
+typedef io_hostGpio<2, IO_DIRECTION_OUTPUT> ledPin;
+
+// The LED loop of Proc_Leds through the virtual interface
+static void BM_PinVirtualSet(benchmark::State& state)
+{
+    io_pinAdapter<ledPin> adapter;
+    IHAL_IO*              gpio = &adapter;
+    benchmark::DoNotOptimize(gpio);
+    uint8_t level = 0;
+    for (auto _ : state)
+    {
+        level ^= 1;
+        gpio->set(&level);
+    }
+}
+BENCHMARK(BM_PinVirtualSet);
+
+static void BM_PinStaticSet(benchmark::State& state)
+{
+    uint8_t level = 0;
+    for (auto _ : state)
+    {
+        level ^= 1;
+        ledPin::set(level);
+    }
+}
+BENCHMARK(BM_PinStaticSet);
+
+// 32 LEDs pin by pin against one port write
+static void BM_PinsOneByOne(benchmark::State& state)
+{
+    std::vector<io_pinAdapter<ledPin>> pins(32);
+    uint8_t                            level = 0;
+    for (auto _ : state)
+    {
+        level ^= 1;
+        for (auto& pin : pins)
+        {
+            IHAL_IO& gpio = pin;
+            gpio.set(&level);
+        }
+    }
+}
+BENCHMARK(BM_PinsOneByOne);
+
+static void BM_PortWrite32(benchmark::State& state)
+{
+    io_hostGpioPort port(0xFFFFFFFFull, 0);
+    for (auto _ : state)
+    {
+        port.toggle(0xFFFFFFFFull);
+    }
+}
+BENCHMARK(BM_PortWrite32);
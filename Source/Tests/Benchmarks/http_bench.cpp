@@ -0,0 +1,101 @@
+#include "HAL/Platform/Linux/net_httpHost.hpp"
+#include "Library/UI/HTTP/ui_routes.h"
+#include "benchmark/benchmark.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string.h>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static const char connectForm[] = "ssid=home-network&password=correct-horse-battery";
+
+static void BM_FormValue(benchmark::State& state)
+{
+    char value[UI_CREDENTIAL_SIZE];
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(uiFormValue(connectForm, sizeof(connectForm) - 1, "password", value, sizeof(value)));
+    }
+}
+BENCHMARK(BM_FormValue);
+
+static void BM_ConnectRoute(benchmark::State& state)
+{
+    uiCredentials_t credentials;
+    for (auto _ : state)
+    {
+        uiRouteResponse_t response = uiConnectRoute(connectForm, sizeof(connectForm) - 1, credentials);
+        benchmark::DoNotOptimize(response);
+    }
+}
+BENCHMARK(BM_ConnectRoute);
+
+// Request parsing, routing and the answer of net_httpHost, one keep-alive connection over loopback
+static void BM_HttpConnectRequest(benchmark::State& state)
+{
+    net_httpHost server;
+    server.addUriHandler("/connect", "POST",
+                         [](const httpHostRequest_t& request, httpHostResponse_t& response)
+                         {
+                             uiCredentials_t   credentials;
+                             uiRouteResponse_t route = uiConnectRoute(request.body.data(), request.body.size(), credentials);
+                             response.status         = route.status;
+                             response.body           = (route.body != nullptr) ? route.body : "";
+                         });
+    if (server.start() != ERROR_SUCCESS)
+    {
+        state.SkipWithError("server did not start");
+        return;
+    }
+
+    int                fd      = socket(AF_INET, SOCK_STREAM, 0);
+    int                noDelay = 1;
+    struct sockaddr_in address = {};
+    address.sin_family         = AF_INET;
+    address.sin_port           = htons(server.getPort());
+    address.sin_addr.s_addr    = htonl(INADDR_LOOPBACK);
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    if (connect(fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        server.stop();
+        state.SkipWithError("connect failed");
+        return;
+    }
+
+    std::string request = "POST /connect HTTP/1.1\r\nHost: bench\r\nContent-Type: application/x-www-form-urlencoded\r\nContent-Length: " +
+                          std::to_string(sizeof(connectForm) - 1) + "\r\n\r\n" + connectForm;
+    std::string response;
+    char        buffer[512];
+    for (auto _ : state)
+    {
+        if (send(fd, request.data(), request.size(), 0) != static_cast<ssize_t>(request.size()))
+        {
+            state.SkipWithError("send failed");
+            break;
+        }
+        // The answer ends with the route's body
+        response.clear();
+        while (response.size() < 9 || response.compare(response.size() - 9, 9, "Connected") != 0)
+        {
+            ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+            if (received <= 0)
+            {
+                break;
+            }
+            response.append(buffer, static_cast<size_t>(received));
+        }
+        if (response.compare(0, 12, "HTTP/1.1 200") != 0)
+        {
+            state.SkipWithError("unexpected response");
+            break;
+        }
+    }
+    close(fd);
+    server.stop();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HttpConnectRequest);
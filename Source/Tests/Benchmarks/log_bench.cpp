@@ -0,0 +1,78 @@
+#include "System/ILog.h"
+#include "benchmark/benchmark.h"
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+// Sink that only looks at the message, so the cost measured is the one of the callers and the handler
+class nullLog : public ILog
+{
+public:
+    size_t bytes = 0;
+
+    void logInfo(const std::string& message) override
+    {
+        bytes += message.size();
+    }
+    void logWarning(const std::string& message) override
+    {
+        bytes += message.size();
+    }
+    void logError(const std::string& message) override
+    {
+        bytes += message.size();
+    }
+    void log(LogLevel level, const char* message, size_t length) override
+    {
+        bytes += length;
+    }
+    void logToFile(const std::string& filename, LogLevel level, const std::string& message) override {}
+};
+} // namespace
+
+static void BM_LogLiteral(benchmark::State& state)
+{
+    nullLog    sink;
+    LogHandler handler(&sink);
+    for (auto _ : state)
+    {
+        handler.log(ILog::LogLevel::INFO, "WiFi Started!");
+    }
+    benchmark::DoNotOptimize(sink.bytes);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogLiteral);
+
+// The pattern used across the processes: build the message with a stringstream, then log it
+static void BM_LogStringStream(benchmark::State& state)
+{
+    nullLog    sink;
+    LogHandler handler(&sink);
+    uint32_t   port = 80;
+    for (auto _ : state)
+    {
+        std::stringstream ss;
+        ss << "Starting server on port: " << port;
+        handler.log(ILog::LogLevel::INFO, ss.str());
+    }
+    benchmark::DoNotOptimize(sink.bytes);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogStringStream);
+
+// The same message with logFormat(): formatted on the stack and handed to the sink without a std::string
+static void BM_LogFormat(benchmark::State& state)
+{
+    nullLog    sink;
+    LogHandler handler(&sink);
+    uint32_t   port = 80;
+    for (auto _ : state)
+    {
+        handler.logFormat(ILog::LogLevel::INFO, "Starting server on port: {}", port);
+    }
+    benchmark::DoNotOptimize(sink.bytes);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogFormat);
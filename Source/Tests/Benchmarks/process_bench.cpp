@@ -0,0 +1,124 @@
+#include "HAL/Platform/Linux/io_hostGpio.hpp"
+#include "HAL/Platform/Linux/io_hostGpioPort.hpp"
+#include "Library/Simulation/simFreeRTOS.h"
+#include "Library/Simulation/simGpio.h"
+#include "Library/Simulation/simKernel.h"
+#include "Process/Examples/Proc_Button.hpp"
+#include "Process/Examples/Proc_Leds.hpp"
+#include "benchmark/benchmark.h"
+
+#include <fcntl.h>
+#include <memory>
+#include <stdio.h>
+#include <unistd.h>
+#include <vector>
+
+typedef io_hostGpio<2, IO_DIRECTION_OUTPUT> ledPin;
+
+namespace
+{
+// The button listener prints every event as it does on the device console, kept out of the benchmark report
+class quietStdout
+{
+private:
+    int _saved;
+
+public:
+    quietStdout()
+    {
+        fflush(stdout);
+        _saved   = dup(STDOUT_FILENO);
+        int null = open("/dev/null", O_WRONLY);
+        dup2(null, STDOUT_FILENO);
+        close(null);
+    }
+    ~quietStdout()
+    {
+        fflush(stdout);
+        dup2(_saved, STDOUT_FILENO);
+        close(_saved);
+    }
+};
+} // namespace
+
+// One LED task cycle of Proc_Leds, every LED blinking on its own pin
+static void BM_LedUpdatePins(benchmark::State& state)
+{
+    std::vector<io_pinAdapter<ledPin>>   pins(state.range(0));
+    std::vector<Proc_LedsBase::ledData>  data;
+    std::vector<Proc_LedsBase::ledData*> leds;
+    data.reserve(pins.size());
+    for (auto& pin : pins)
+    {
+        data.push_back({pin, LED_BLINK_FAST, 0, 0});
+        leds.push_back(&data.back());
+    }
+    Proc_Leds<> process(leds);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(process.update(1));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LedUpdatePins)->Arg(1)->Arg(8)->Arg(32);
+
+// The same cycle with the LEDs staged on one port and flushed with a single write
+static void BM_LedUpdatePort(benchmark::State& state)
+{
+    io_hostGpioPort                          port(0xFFFFFFFFull, 0);
+    io_port*                                 ports[] = {&port};
+    std::vector<std::unique_ptr<io_portPin>> pins;
+    std::vector<Proc_LedsBase::ledData>      data;
+    std::vector<Proc_LedsBase::ledData*>     leds;
+    data.reserve(state.range(0));
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        pins.emplace_back(new io_portPin(port, static_cast<uint8_t>(i)));
+        data.push_back({*pins.back(), LED_BLINK_FAST, 0, 0});
+        leds.push_back(&data.back());
+    }
+    Proc_Leds<> process(leds, taskBandPriority(TASK_BAND_REALTIME_IO), TASK_CORE_APP, ports, 1);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(process.update(1));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LedUpdatePort)->Arg(8)->Arg(32);
+
+// A full press through the interrupt, the GPIO queue and the listener task on the simKernel shim
+static void BM_ButtonPress(benchmark::State& state)
+{
+    quietStdout quiet;
+    simKernel   kernel;
+    simRtos     rtos(kernel);
+    simGpioReset();
+
+    gpio_config_t config = {};
+    config.pin_bit_mask  = 1ULL << GPIO_NUM_4;
+    config.mode          = GPIO_MODE_INPUT;
+    config.intr_type     = GPIO_INTR_ANYEDGE;
+    simGpioDrive(GPIO_NUM_4, GPIO_HIGH);
+    io_gpio gpio(GPIO_NUM_4, &config);
+    gpio.init();
+
+    Proc_ButtonBase::buttonData               button  = {gpio, GPIO_HIGH, GPIO_HIGH, GPIO_LOW, 0, NULL, 0, nullptr};
+    std::vector<Proc_ButtonBase::buttonData*> buttons = {&button};
+    Proc_Button<>                             process(buttons);
+    uint32_t                                  presses = 0;
+    process.setPressHandler([](size_t index, uint32_t durationMs, void* context) { (*static_cast<uint32_t*>(context))++; }, &presses);
+    process.start();
+    kernel.runFor(1);
+
+    // Edges 60 ms apart, past the 50 ms the interrupt stays off after each one
+    for (auto _ : state)
+    {
+        kernel.schedule(1, []() { simGpioDrive(GPIO_NUM_4, GPIO_LOW); });
+        kernel.schedule(61, []() { simGpioDrive(GPIO_NUM_4, GPIO_HIGH); });
+        kernel.runFor(121);
+    }
+    process.stop();
+    state.counters["presses"] = presses;
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ButtonPress);
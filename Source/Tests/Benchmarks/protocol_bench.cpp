@@ -0,0 +1,117 @@
+#include "HAL/Platform/Linux/com_pty.hpp"
+#include "Library/Protocol/frameLink.h"
+#include "benchmark/benchmark.h"
+
+#include <chrono>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+namespace
+{
+uint32_t nowMs()
+{
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void countFrames(const uint8_t* payload, size_t length, void* context)
+{
+    (*static_cast<size_t*>(context))++;
+}
+
+// Both ends of a pty pair with a frameLink on each, the device sends to the host
+struct ptyLink
+{
+    uint8_t           storage[4][4096];
+    com_pty           host;
+    com_pty           device;
+    frameLinkConfig_t config;
+    frameLink         sender;
+    frameLink         receiver;
+    size_t            received;
+
+    ptyLink()
+        : host(storage[0], sizeof(storage[0]), storage[1], sizeof(storage[1])), device(storage[2], sizeof(storage[2]), storage[3], sizeof(storage[3]), connectHost(), 3000000),
+          config(windowConfig()), sender(device, config), receiver(host, config), received(0)
+    {
+        receiver.setFrameHandler(countFrames, &received);
+    }
+    ~ptyLink()
+    {
+        device.disconnect();
+        host.disconnect();
+    }
+
+    const char* connectHost()
+    {
+        return (host.connect() == ERROR_SUCCESS) ? host.getSlaveName() : "";
+    }
+    static frameLinkConfig_t windowConfig()
+    {
+        frameLinkConfig_t config = frameLinkDefaultConfig();
+        config.window            = 16;
+        return config;
+    }
+
+    void poll()
+    {
+        receiver.poll(nowMs());
+        sender.poll(nowMs());
+    }
+};
+} // namespace
+
+// Throughput of 240 byte frames over a pty pair at 3 Mbit/s
+static void BM_FrameLinkPtyThroughput(benchmark::State& state)
+{
+    ptyLink link;
+    if (link.device.connect() != ERROR_SUCCESS)
+    {
+        state.SkipWithError("no pty available");
+        return;
+    }
+    std::vector<uint8_t> payload(240, 0xA5);
+    for (auto _ : state)
+    {
+        // One window of frames, delivered and acknowledged
+        for (size_t i = 0; i < link.config.window; i++)
+        {
+            while (link.sender.send(payload.data(), payload.size(), nowMs()) != ERROR_SUCCESS)
+            {
+                link.poll();
+            }
+        }
+        uint32_t timeout = nowMs() + 1000;
+        while (!link.sender.isIdle() && nowMs() < timeout)
+        {
+            link.poll();
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(link.received));
+    state.SetBytesProcessed(static_cast<int64_t>(link.received * payload.size()));
+    state.counters["retransmits"] = link.sender.getStats().retransmits;
+}
+BENCHMARK(BM_FrameLinkPtyThroughput)->UseRealTime();
+
+// Round trip of a single frame: send, deliver, acknowledge
+static void BM_FrameLinkPtyRoundTrip(benchmark::State& state)
+{
+    ptyLink link;
+    if (link.device.connect() != ERROR_SUCCESS)
+    {
+        state.SkipWithError("no pty available");
+        return;
+    }
+    std::vector<uint8_t> payload(32, 0x5A);
+    for (auto _ : state)
+    {
+        link.sender.send(payload.data(), payload.size(), nowMs());
+        uint32_t timeout = nowMs() + 1000;
+        while (!link.sender.isIdle() && nowMs() < timeout)
+        {
+            link.poll();
+        }
+    }
+}
+BENCHMARK(BM_FrameLinkPtyRoundTrip)->UseRealTime();
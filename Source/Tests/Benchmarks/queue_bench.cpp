@@ -0,0 +1,79 @@
+#include "Library/Common/ringBuffer.h"
+#include "benchmark/benchmark.h"
+
+#include <atomic>
+#include <thread>
+
+namespace
+{
+// 4 byte messages like the GPIO event queue carries
+void send(ringBuffer& ring, uint32_t message)
+{
+    while (ring.write(reinterpret_cast<const uint8_t*>(&message), sizeof(message)) == 0)
+    {
+        std::this_thread::yield();
+    }
+}
+
+uint32_t receive(ringBuffer& ring)
+{
+    uint32_t message = 0;
+    while (ring.size() < sizeof(message))
+    {
+        std::this_thread::yield();
+    }
+    ring.read(reinterpret_cast<uint8_t*>(&message), sizeof(message));
+    return message;
+}
+} // namespace
+
+static void BM_RingBufferThroughput(benchmark::State& state)
+{
+    uint8_t    storage[1024];
+    ringBuffer ring(storage, sizeof(storage));
+    uint32_t   message = 0;
+    for (auto _ : state)
+    {
+        ring.write(reinterpret_cast<const uint8_t*>(&message), sizeof(message));
+        ring.read(reinterpret_cast<uint8_t*>(&message), sizeof(message));
+        message++;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RingBufferThroughput);
+
+// Request/response between two threads, the cost of handing an event to another task and getting the answer
+static void BM_RingBufferRoundTrip(benchmark::State& state)
+{
+    uint8_t    requestStorage[64];
+    uint8_t    responseStorage[64];
+    ringBuffer requests(requestStorage, sizeof(requestStorage));
+    ringBuffer responses(responseStorage, sizeof(responseStorage));
+
+    std::thread echo(
+        [&]()
+        {
+            for (;;)
+            {
+                uint32_t message = receive(requests);
+                send(responses, message);
+                if (message == UINT32_MAX)
+                {
+                    return;
+                }
+            }
+        });
+
+    uint32_t message = 0;
+    for (auto _ : state)
+    {
+        send(requests, message);
+        benchmark::DoNotOptimize(receive(responses));
+        message = (message + 1) % UINT32_MAX;
+    }
+    send(requests, UINT32_MAX);
+    receive(responses);
+    echo.join();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RingBufferRoundTrip)->UseRealTime();
@@ -0,0 +1,85 @@
+#include "HAL/Platform/Linux/mem_ramDisk.hpp"
+#include "Library/Storage/kvStore.h"
+#include "Library/Storage/logStore.h"
+#include "System/memoryPool.h"
+#include "benchmark/benchmark.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static void BM_KvStorePut(benchmark::State& state)
+{
+    mem_ramDisk memory(memDefaultGeometry(64 * 1024));
+    kvStore     store(memory);
+    store.mount();
+
+    uint32_t value = 0;
+    char     key[16];
+    for (auto _ : state)
+    {
+        snprintf(key, sizeof(key), "key.%u", value % 16);
+        store.put(key, &value, sizeof(value));
+        store.compactStep();
+        value++;
+    }
+    state.counters["flash_bytes_per_put"] = benchmark::Counter(static_cast<double>(store.getStats().flashBytesWritten) / state.iterations());
+}
+BENCHMARK(BM_KvStorePut);
+
+static void BM_KvStoreGet(benchmark::State& state)
+{
+    mem_ramDisk memory(memDefaultGeometry(64 * 1024));
+    kvStore     store(memory);
+    store.mount();
+    uint32_t value = 42;
+    store.put("wifi.channel", &value, sizeof(value));
+
+    size_t length = 0;
+    for (auto _ : state)
+    {
+        store.get("wifi.channel", &value, sizeof(value), length);
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_KvStoreGet);
+
+static void BM_LogStoreLog(benchmark::State& state)
+{
+    mem_ramDisk memory(memDefaultGeometry(64 * 1024));
+    logStore    store(memory, 0, 16 * 1024, 4);
+    store.mount();
+
+    uint32_t value = 0;
+    for (auto _ : state)
+    {
+        store.log(0, "sensor", "reading %u, state %s", value, "ok");
+        value++;
+    }
+    store.flush();
+    logStoreStats_t stats        = store.getStats();
+    state.counters["record_bytes"] = benchmark::Counter(static_cast<double>(stats.recordBytes) / state.iterations());
+    state.counters["flash_bytes"]  = benchmark::Counter(static_cast<double>(stats.flashBytesWritten) / state.iterations());
+}
+BENCHMARK(BM_LogStoreLog);
+
+static void BM_MemoryPoolAllocate(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        void* block = systemPools().allocate(static_cast<size_t>(state.range(0)));
+        benchmark::DoNotOptimize(block);
+        systemPools().release(block);
+    }
+}
+BENCHMARK(BM_MemoryPoolAllocate)->Arg(32)->Arg(512);
+
+static void BM_HeapAllocate(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        void* block = malloc(static_cast<size_t>(state.range(0)));
+        benchmark::DoNotOptimize(block);
+        free(block);
+    }
+}
+BENCHMARK(BM_HeapAllocate)->Arg(32)->Arg(512);
@@ -0,0 +1,208 @@
+/**
+ * @file httpLoad.cpp
+ * @brief HTTP load and latency harness
+ *
+ * Drives the routes of proc_httpServer with net_httpLoad and fails (exit code 1) when a latency or throughput
+ * threshold is exceeded. Without --host the routes are served on localhost by net_httpHost through the same
+ * handling as the device (Library/UI/HTTP/ui_routes.h); with --host a running device is measured.
+ *
+ * http_load [--host H --port P] [--method M] [--path P] [--body B] [--connections N] [--requests N]
+ *           [--no-keepalive] [--timeout-ms T] [--max-p50-us X] [--max-p99-us X] [--min-rps X] [--distribution]
+ */
+
+#include "HAL/Platform/Linux/net_httpHost.hpp"
+#include "HAL/Platform/Linux/net_httpLoad.hpp"
+#include "Library/UI/HTTP/ui_routes.h"
+
+#include <atomic>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+namespace
+{
+typedef struct
+{
+    double maxP50Us; // 0 = no limit
+    double maxP99Us; // 0 = no limit
+    double minRps;   // 0 = no limit
+} thresholds_t;
+
+// PUT /ctrl takes /welcome and /connect offline like on the device, where they are unregistered
+std::atomic<bool> routesEnabled(true);
+
+void send(const uiRouteResponse_t& route, httpHostResponse_t& response)
+{
+    response.status = route.status;
+    response.body   = (route.body != nullptr) ? route.body : "";
+}
+
+bool available(const char* uri, httpHostResponse_t& response)
+{
+    if (routesEnabled.load())
+    {
+        return true;
+    }
+    response.status = 404;
+    response.body   = std::string(uri) + " URI is not available";
+    return false;
+}
+
+// The routes of proc_httpServer, answered by the same ui_routes functions
+void addDeviceRoutes(net_httpHost& server)
+{
+    server.addUriHandler("/welcome", "GET",
+                         [](const httpHostRequest_t& request, httpHostResponse_t& response)
+                         {
+                             if (available("/welcome", response))
+                             {
+                                 send(uiWelcomeRoute(), response);
+                             }
+                         });
+    server.addUriHandler("/connect", "POST",
+                         [](const httpHostRequest_t& request, httpHostResponse_t& response)
+                         {
+                             uiCredentials_t credentials;
+                             if (available("/connect", response))
+                             {
+                                 send(uiConnectRoute(request.body.data(), request.body.size(), credentials), response);
+                             }
+                         });
+    server.addUriHandler("/ctrl", "PUT",
+                         [](const httpHostRequest_t& request, httpHostResponse_t& response)
+                         {
+                             bool enabled = routesEnabled.load();
+                             send(uiCtrlRoute(request.body.data(), request.body.size(), enabled), response);
+                             routesEnabled.store(enabled);
+                         });
+}
+
+bool check(const char* name, double value, double limit, bool upper)
+{
+    if (limit <= 0.0 || (upper ? value <= limit : value >= limit))
+    {
+        return true;
+    }
+    printf("FAIL: %s %.1f %s limit %.1f\n", name, value, upper ? "above" : "below", limit);
+    return false;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    httpLoadConfig_t config       = httpLoadDefaultConfig();
+    thresholds_t     thresholds   = {0.0, 0.0, 0.0};
+    bool             external     = false;
+    bool             distribution = false;
+    config.path                   = "/welcome";
+
+    static const struct option options[] = {
+        {"host", required_argument, nullptr, 'h'},
+        {"port", required_argument, nullptr, 'p'},
+        {"method", required_argument, nullptr, 'm'},
+        {"path", required_argument, nullptr, 'u'},
+        {"body", required_argument, nullptr, 'b'},
+        {"connections", required_argument, nullptr, 'c'},
+        {"requests", required_argument, nullptr, 'n'},
+        {"no-keepalive", no_argument, nullptr, 'k'},
+        {"timeout-ms", required_argument, nullptr, 't'},
+        {"max-p50-us", required_argument, nullptr, '5'},
+        {"max-p99-us", required_argument, nullptr, '9'},
+        {"min-rps", required_argument, nullptr, 'r'},
+        {"distribution", no_argument, nullptr, 'd'},
+        {nullptr, 0, nullptr, 0},
+    };
+
+    int option;
+    while ((option = getopt_long(argc, argv, "", options, nullptr)) != -1)
+    {
+        switch (option)
+        {
+            case 'h':
+                config.host = optarg;
+                external    = true;
+                break;
+            case 'p':
+                config.port = static_cast<uint16_t>(atoi(optarg));
+                break;
+            case 'm':
+                config.method = optarg;
+                break;
+            case 'u':
+                config.path = optarg;
+                break;
+            case 'b':
+                config.body = optarg;
+                break;
+            case 'c':
+                config.connections = static_cast<uint32_t>(atoi(optarg));
+                break;
+            case 'n':
+                config.requests = static_cast<uint32_t>(atoi(optarg));
+                break;
+            case 'k':
+                config.keepAlive = false;
+                break;
+            case 't':
+                config.timeoutMs = static_cast<uint32_t>(atoi(optarg));
+                break;
+            case '5':
+                thresholds.maxP50Us = atof(optarg);
+                break;
+            case '9':
+                thresholds.maxP99Us = atof(optarg);
+                break;
+            case 'r':
+                thresholds.minRps = atof(optarg);
+                break;
+            case 'd':
+                distribution = true;
+                break;
+            default:
+                return 2;
+        }
+    }
+
+    net_httpHost server; // free port, --port applies to --host
+    if (!external)
+    {
+        addDeviceRoutes(server);
+        if (server.start() != ERROR_SUCCESS)
+        {
+            printf("Local server could not be started\n");
+            return 2;
+        }
+        config.host = "127.0.0.1";
+        config.port = server.getPort();
+    }
+
+    net_httpLoad load;
+    if (load.run(config) != ERROR_SUCCESS)
+    {
+        printf("Load run could not be started\n");
+        return 2;
+    }
+
+    httpLoadResult_t        result    = load.getResult();
+    const latencyHistogram& histogram = load.getHistogram();
+    std::vector<char>       text(64 * 1024);
+
+    printf("%s %s on %s:%u, %u connections, %s\n", config.method, config.path, config.host, static_cast<unsigned>(config.port), static_cast<unsigned>(config.connections),
+           config.keepAlive ? "keep-alive" : "connection per request");
+    printf("completed %u  non-2xx %u  errors %u  connects %u  %.1f requests/s\n", static_cast<unsigned>(result.completed), static_cast<unsigned>(result.non2xx),
+           static_cast<unsigned>(result.errors), static_cast<unsigned>(result.connects), result.requestsPerSecond);
+    histogram.formatSummary(text.data(), text.size(), 1000.0, "us");
+    printf("latency %s\n", text.data());
+    if (distribution)
+    {
+        histogram.formatDistribution(text.data(), text.size(), 1000.0);
+        printf("\n%s", text.data());
+    }
+
+    bool passed = check("errors", result.errors, 0.5, true);
+    passed &= check("p50 us", histogram.getPercentile(50.0) / 1000.0, thresholds.maxP50Us, true);
+    passed &= check("p99 us", histogram.getPercentile(99.0) / 1000.0, thresholds.maxP99Us, true);
+    passed &= check("requests/s", result.requestsPerSecond, thresholds.minRps, false);
+    return passed ? 0 : 1;
+}
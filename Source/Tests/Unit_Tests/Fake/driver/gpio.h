@@ -0,0 +1,7 @@
+// Fake of the ESP-IDF header for host builds, see Library/Simulation/simGpio.h
+#ifndef FAKE_DRIVER_GPIO_H
+#define FAKE_DRIVER_GPIO_H
+
+#include "Library/Simulation/simGpio.h"
+
+#endif /* FAKE_DRIVER_GPIO_H */
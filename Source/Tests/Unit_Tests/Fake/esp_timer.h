@@ -0,0 +1,7 @@
+// Fake of the ESP-IDF header for host builds, see Library/Simulation/simFreeRTOS.h
+#ifndef FAKE_ESP_TIMER_H
+#define FAKE_ESP_TIMER_H
+
+#include "Library/Simulation/simFreeRTOS.h"
+
+#endif /* FAKE_ESP_TIMER_H */
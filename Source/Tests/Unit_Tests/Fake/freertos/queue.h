@@ -0,0 +1,7 @@
+// Fake of the FreeRTOS header for host builds, see Library/Simulation/simFreeRTOS.h
+#ifndef FAKE_FREERTOS_QUEUE_H
+#define FAKE_FREERTOS_QUEUE_H
+
+#include "Library/Simulation/simFreeRTOS.h"
+
+#endif /* FAKE_FREERTOS_QUEUE_H */
@@ -0,0 +1,110 @@
+#include "Library/Common/cobs.h"
+#include "Library/Common/crc.h"
+#include "gtest/gtest.h"
+
+#include <string.h>
+#include <vector>
+
+namespace
+{
+std::vector<uint8_t> roundTrip(const std::vector<uint8_t>& data)
+{
+    std::vector<uint8_t> encoded(cobs::maxEncodedLength(data.size()));
+    size_t               length = cobs::encode(data.data(), data.size(), encoded.data());
+    EXPECT_LE(length, encoded.size());
+    EXPECT_EQ(memchr(encoded.data(), 0, length), nullptr);
+
+    // Decode in place
+    size_t decoded = 0;
+    EXPECT_TRUE(cobs::decode(encoded.data(), length, encoded.data(), decoded));
+    return std::vector<uint8_t>(encoded.begin(), encoded.begin() + decoded);
+}
+} // namespace
+
+TEST(CobsTest, KnownEncodings)
+{
+    const uint8_t data[]     = {0x11, 0x22, 0x00, 0x33};
+    const uint8_t expected[] = {0x03, 0x11, 0x22, 0x02, 0x33};
+    uint8_t       encoded[8];
+    ASSERT_EQ(cobs::encode(data, sizeof(data), encoded), sizeof(expected));
+    EXPECT_EQ(memcmp(encoded, expected, sizeof(expected)), 0);
+
+    const uint8_t zeros[] = {0x00, 0x00};
+    ASSERT_EQ(cobs::encode(zeros, sizeof(zeros), encoded), 3u);
+    EXPECT_EQ(encoded[0], 0x01);
+    EXPECT_EQ(encoded[1], 0x01);
+    EXPECT_EQ(encoded[2], 0x01);
+}
+
+TEST(CobsTest, RoundTripsLongRuns)
+{
+    for (size_t length : {0u, 1u, 253u, 254u, 255u, 508u, 1000u})
+    {
+        std::vector<uint8_t> noZeros(length);
+        std::vector<uint8_t> mixed(length);
+        for (size_t i = 0; i < length; i++)
+        {
+            noZeros[i] = static_cast<uint8_t>(i % 255 + 1);
+            mixed[i]   = static_cast<uint8_t>(i * 13);
+        }
+        EXPECT_EQ(roundTrip(noZeros), noZeros) << length;
+        EXPECT_EQ(roundTrip(mixed), mixed) << length;
+    }
+}
+
+TEST(CobsTest, StreamingMatchesOneShot)
+{
+    std::vector<uint8_t> data(600);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<uint8_t>((i % 7 == 0) ? 0 : i);
+    }
+
+    std::vector<uint8_t> oneShot(cobs::maxEncodedLength(data.size()));
+    std::vector<uint8_t> pieces(oneShot.size());
+    size_t               length = cobs::encode(data.data(), data.size(), oneShot.data());
+
+    cobs::encoder encoder(pieces.data());
+    encoder.append(data.data(), 3);
+    encoder.append(data.data() + 3, 300);
+    encoder.append(data.data() + 303, data.size() - 303);
+    ASSERT_EQ(encoder.finish(), length);
+    EXPECT_EQ(memcmp(oneShot.data(), pieces.data(), length), 0);
+}
+
+TEST(CobsTest, RejectsBrokenFrames)
+{
+    size_t        decoded     = 0;
+    uint8_t       output[8];
+    const uint8_t zero[]      = {0x03, 0x11, 0x00};
+    const uint8_t truncated[] = {0x05, 0x11, 0x22};
+    EXPECT_FALSE(cobs::decode(zero, sizeof(zero), output, decoded));
+    EXPECT_FALSE(cobs::decode(truncated, sizeof(truncated), output, decoded));
+}
+
+TEST(CrcTest, CheckValues)
+{
+    const char check[] = "123456789";
+    EXPECT_EQ(crc::crc32(check, 9), 0xCBF43926u);
+    EXPECT_EQ(crc::crc16(check, 9), 0x29B1u);
+    EXPECT_EQ(crc::crc16(check + 4, 5, crc::crc16(check, 4)), 0x29B1u);
+}
+
+TEST(CrcTest, SlicedMatchesBytewise)
+{
+    std::vector<uint8_t> data(1027);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+
+    // Chunks below the slicing threshold take the byte-wise path
+    uint32_t chained = 0;
+    for (size_t offset = 0; offset < data.size(); offset += 5)
+    {
+        size_t length = (data.size() - offset < 5) ? data.size() - offset : 5;
+        chained       = crc::crc32(&data[offset], length, chained);
+    }
+    EXPECT_EQ(crc::crc32(data.data(), data.size()), chained);
+    EXPECT_EQ(crc::crc32(data.data() + 1, data.size() - 1, crc::crc32(data.data(), 1)), chained);
+}
@@ -0,0 +1,138 @@
+#include "HAL/Platform/Linux/com_pty.hpp"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <chrono>
+#include <fcntl.h>
+#include <memory>
+#include <poll.h>
+#include <string.h>
+#include <thread>
+#include <unistd.h>
+
+namespace
+{
+struct eventLog_t
+{
+    std::atomic<uint32_t> mask;
+};
+
+void recordEvent(comEvent_t event, void* context)
+{
+    static_cast<eventLog_t*>(context)->mask |= 1u << event;
+}
+
+template <typename Condition> bool waitFor(Condition condition)
+{
+    for (int i = 0; i < 1000 && !condition(); i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return condition();
+}
+
+size_t readAll(int fd, uint8_t* data, size_t length)
+{
+    size_t done = 0;
+    while (done < length)
+    {
+        struct pollfd pfd = {fd, POLLIN, 0};
+        if (poll(&pfd, 1, 1000) <= 0)
+        {
+            break;
+        }
+        ssize_t received = read(fd, data + done, length - done);
+        if (received <= 0)
+        {
+            break;
+        }
+        done += received;
+    }
+    return done;
+}
+} // namespace
+
+class ComPtyTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _port.reset(new com_pty(_txStorage, sizeof(_txStorage), _rxStorage, sizeof(_rxStorage)));
+        _events.mask = 0;
+        _port->setEventCallback(recordEvent, &_events);
+        ASSERT_EQ(_port->connect(), ERROR_SUCCESS);
+        _remote = open(_port->getSlaveName(), O_RDWR | O_NOCTTY);
+        ASSERT_GE(_remote, 0);
+    }
+
+    void TearDown() override
+    {
+        close(_remote);
+        _port->disconnect();
+    }
+
+    uint8_t                  _txStorage[256];
+    uint8_t                  _rxStorage[256];
+    std::unique_ptr<com_pty> _port;
+    eventLog_t               _events;
+    int                      _remote;
+};
+
+TEST_F(ComPtyTest, ReceivesFromRemote)
+{
+    uint8_t data[64];
+    for (uint8_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = i;
+    }
+    ASSERT_EQ(write(_remote, data, sizeof(data)), static_cast<ssize_t>(sizeof(data)));
+    ASSERT_TRUE(waitFor([this]() { return _port->rxAvailable() == 64; }));
+
+    // Parse in place, then release
+    ringSpan_t span = _port->rxPeek();
+    ASSERT_EQ(span.length, 64u);
+    EXPECT_EQ(memcmp(span.data, data, sizeof(data)), 0);
+    _port->rxRelease(span.length);
+    EXPECT_EQ(_port->rxAvailable(), 0u);
+
+    // The line goes idle after the burst
+    EXPECT_TRUE(waitFor([this]() { return (_events.mask & (1u << COM_EVENT_RX_IDLE)) != 0; }));
+}
+
+TEST_F(ComPtyTest, HalfBufferEvent)
+{
+    uint8_t data[128] = {0};
+    ASSERT_EQ(write(_remote, data, sizeof(data)), static_cast<ssize_t>(sizeof(data)));
+    EXPECT_TRUE(waitFor([this]() { return (_events.mask & (1u << COM_EVENT_RX_HALF)) != 0; }));
+
+    size_t  received = 0;
+    uint8_t out[128];
+    ASSERT_EQ(_port->receiveData(out, sizeof(out), received), ERROR_SUCCESS);
+    EXPECT_EQ(received, sizeof(data));
+    EXPECT_EQ(_port->getStats().rxBytes, sizeof(data));
+}
+
+TEST_F(ComPtyTest, TransmitsToRemote)
+{
+    uint8_t data[200];
+    for (uint8_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = static_cast<uint8_t>(255 - i);
+    }
+    ASSERT_EQ(_port->sendData(data, sizeof(data)), ERROR_SUCCESS);
+
+    uint8_t out[200];
+    ASSERT_EQ(readAll(_remote, out, sizeof(out)), sizeof(out));
+    EXPECT_EQ(memcmp(out, data, sizeof(data)), 0);
+    EXPECT_TRUE(waitFor([this]() { return (_events.mask & (1u << COM_EVENT_TX_DONE)) != 0; }));
+
+    // Build a message in place
+    ringSpan_t span = _port->txAcquire();
+    ASSERT_GE(span.length, 4u);
+    memcpy(span.data, "ping", 4);
+    ASSERT_EQ(_port->txCommit(4), ERROR_SUCCESS);
+    ASSERT_EQ(readAll(_remote, out, 4), 4u);
+    EXPECT_EQ(memcmp(out, "ping", 4), 0);
+
+    EXPECT_EQ(_port->sendData(data, 300), ERROR_MESSAGE_TOO_LARGE);
+}
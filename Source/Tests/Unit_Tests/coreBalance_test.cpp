@@ -0,0 +1,78 @@
+#include "Library/Diagnostics/coreBalance.h"
+#include "gtest/gtest.h"
+
+#include <string.h>
+
+namespace
+{
+taskSample_t makeSample(uintptr_t id, int8_t core, uint8_t priority, uint32_t runTime)
+{
+    taskSample_t sample = {};
+    sample.id           = id;
+    sample.process      = -1;
+    sample.runTime      = runTime;
+    sample.core         = core;
+    sample.priority     = priority;
+    return sample;
+}
+} // namespace
+
+TEST(CoreBalanceTest, BandPriorities)
+{
+    static_assert(taskBandPriority(TASK_BAND_REALTIME_IO) == 10, "lowest of the band");
+    static_assert(taskBandPriority(TASK_BAND_NETWORK, 2) == 7, "inside the band");
+    static_assert(taskBandPriority(TASK_BAND_BACKGROUND, 10) == 4, "clamped to the band");
+
+    EXPECT_EQ(taskBandOf(0), TASK_BAND_SYSTEM);
+    EXPECT_EQ(taskBandOf(5), TASK_BAND_NETWORK);
+    EXPECT_EQ(taskBandOf(18), TASK_BAND_SYSTEM); // lwIP
+    EXPECT_EQ(taskBandOf(20), TASK_BAND_ISR_DEFERRED);
+    EXPECT_EQ(taskBandOf(23), TASK_BAND_SYSTEM); // Wi-Fi
+}
+
+TEST(CoreBalanceTest, LoadPerCore)
+{
+    coreBalance balance(2);
+
+    // wifi on core 0, button listener on core 1, http floating, idle tasks on both
+    taskSample_t first[] = {makeSample(1, 0, 23, 0), makeSample(2, 1, 11, 0), makeSample(3, -1, 5, 0), makeSample(4, 0, 0, 0), makeSample(5, 1, 0, 0)};
+    balance.update(first, 5, 0);
+    EXPECT_EQ(balance.getCore(0).load, 0.0f); // baseline only
+
+    taskSample_t second[] = {makeSample(1, 0, 23, 40000), makeSample(2, 1, 11, 5000), makeSample(3, -1, 5, 500), makeSample(4, 0, 0, 60000), makeSample(5, 1, 0, 95000)};
+    balance.update(second, 5, 100000);
+
+    EXPECT_NEAR(balance.getCore(0).load, 40.0f, 0.01f);
+    EXPECT_NEAR(balance.getCore(1).load, 5.0f, 0.01f);
+    EXPECT_NEAR(balance.getFloating().load, 0.5f, 0.01f);
+    EXPECT_NEAR(balance.getImbalance(), 35.0f, 0.01f);
+    EXPECT_EQ(balance.getCore(0).tasks, 1u);
+    EXPECT_EQ(balance.getCore(1).bands, 1u << TASK_BAND_REALTIME_IO);
+
+    // The http task is below the busy threshold, the button listener is isolated from Wi-Fi
+    EXPECT_TRUE(balance.getCore(1).isolated);
+}
+
+TEST(CoreBalanceTest, RealtimeSharingWithWifiIsReported)
+{
+    coreBalance balance(2);
+
+    taskSample_t first[] = {makeSample(1, 0, 23, 0), makeSample(2, 0, 11, 0), makeSample(3, -1, 12, 0)};
+    balance.update(first, 3, 0);
+    taskSample_t second[] = {makeSample(1, 0, 23, 30000), makeSample(2, 0, 11, 1000), makeSample(3, -1, 12, 1000)};
+    balance.update(second, 3, 100000);
+
+    EXPECT_FALSE(balance.getCore(0).isolated);
+    EXPECT_TRUE(balance.getCore(1).isolated);
+    EXPECT_FALSE(balance.getFloating().isolated); // may run on core 0
+
+    char text[256];
+    balance.formatText(text, sizeof(text));
+    EXPECT_NE(strstr(text, "core0:  31.0% 2 tasks [realtime_io,system] realtime I/O shares the core"), nullptr);
+
+    char json[512];
+    balance.formatJson(json, sizeof(json));
+    EXPECT_STREQ(json, "{\"cores\":[{\"core\":0,\"load\":31.0,\"tasks\":2,\"bands\":[\"realtime_io\",\"system\"],\"isolated\":false},"
+                       "{\"core\":1,\"load\":0.0,\"tasks\":0,\"bands\":[],\"isolated\":true}],"
+                       "\"floating\":{\"load\":1.0,\"tasks\":1,\"bands\":[\"realtime_io\"],\"isolated\":false},\"imbalance\":31.0}");
+}
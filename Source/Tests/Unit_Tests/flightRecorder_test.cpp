@@ -0,0 +1,214 @@
+#include "HAL/Platform/Linux/mem_mmapFile.hpp"
+#include "HAL/Platform/Linux/mem_ramDisk.hpp"
+#include "Library/Diagnostics/flightRecorder.h"
+#include "gtest/gtest.h"
+
+#include <string.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+class FlightRecorderTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _path = "/tmp/flightRecorder_test_" + std::to_string(getpid()) + ".bin";
+        unlink(_path.c_str());
+    }
+
+    void TearDown() override
+    {
+        unlink(_path.c_str());
+    }
+
+    std::string _path;
+};
+
+TEST_F(FlightRecorderTest, RecordsAreThirtyTwoBytes)
+{
+    EXPECT_EQ(sizeof(flightRecord_t), 32u);
+    EXPECT_EQ(sizeof(flightRegionHeader_t), 32u);
+}
+
+TEST_F(FlightRecorderTest, KeepsTheNewestRecords)
+{
+    uint32_t       region[(sizeof(flightRegionHeader_t) + 8 * sizeof(flightRecord_t)) / 4] = {};
+    flightRecorder recorder;
+    ASSERT_EQ(recorder.attach(region, sizeof(region), 3), ERROR_SUCCESS);
+    EXPECT_FALSE(recorder.hadPreviousFlight());
+    EXPECT_EQ(recorder.getCapacity(), 8u);
+    EXPECT_EQ(recorder.getBootCount(), 1u);
+
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        recorder.record(FLIGHT_USER, 0, i, "a text longer than a record holds");
+    }
+
+    flightRecord_t records[8];
+    ASSERT_EQ(recorder.getRecords(records, 8), 8u);
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        EXPECT_EQ(records[i].arg, 12 + i);
+        EXPECT_EQ(records[i].sequence, 14 + i); // after the boot record
+        EXPECT_EQ(records[i].length, FLIGHT_TEXT_SIZE);
+    }
+    EXPECT_EQ(memcmp(records[0].text, "a text longer th", FLIGHT_TEXT_SIZE), 0);
+}
+
+TEST_F(FlightRecorderTest, SurvivesReboot)
+{
+    {
+        mem_mmapFile file(_path.c_str(), 4096);
+        ASSERT_TRUE(file.initialize());
+        flightRecorder recorder;
+        ASSERT_EQ(recorder.attach(file.getMapping(), FLIGHT_REGION_SIZE, 1), ERROR_SUCCESS);
+        recorder.record(FLIGHT_PROCESS_STATE, (0 << 8) | 1, 0x1234, "RUNNING");
+        recorder.record(FLIGHT_LOG, 2, 40, "Proc_Leds: LED not found!");
+    }
+
+    // Same region after the reset, the previous flight is still there
+    mem_mmapFile file(_path.c_str(), 4096);
+    ASSERT_TRUE(file.initialize());
+    flightRecorder recorder;
+    ASSERT_EQ(recorder.attach(file.getMapping(), FLIGHT_REGION_SIZE, 4), ERROR_SUCCESS);
+    EXPECT_TRUE(recorder.hadPreviousFlight());
+    EXPECT_EQ(recorder.getBootCount(), 2u);
+
+    flightRecord_t records[FLIGHT_RECORDS];
+    ASSERT_EQ(recorder.getRecords(records, FLIGHT_RECORDS), 4u);
+    EXPECT_EQ(records[0].event, FLIGHT_BOOT);
+    EXPECT_EQ(records[1].event, FLIGHT_PROCESS_STATE);
+    EXPECT_EQ(records[2].event, FLIGHT_LOG);
+    EXPECT_EQ(records[3].event, FLIGHT_BOOT);
+    EXPECT_EQ(records[3].source, 4u);
+    EXPECT_EQ(records[3].arg, 2u);
+
+    char line[128];
+    flightRecorder::formatRecord(records[2], line, sizeof(line));
+    EXPECT_NE(strstr(line, "LOG   ERROR Proc_Leds: LED n..."), nullptr);
+}
+
+TEST_F(FlightRecorderTest, SkipsTornRecords)
+{
+    uint32_t       region[(sizeof(flightRegionHeader_t) + 8 * sizeof(flightRecord_t)) / 4] = {};
+    flightRecorder recorder;
+    ASSERT_EQ(recorder.attach(region, sizeof(region), 0), ERROR_SUCCESS);
+    recorder.record(FLIGHT_WIFI, 5, 201);
+    recorder.record(FLIGHT_WIFI, 4, 0);
+
+    // Reset while the last record was written: its sequence was still cleared
+    flightRecord_t* slots = reinterpret_cast<flightRecord_t*>(reinterpret_cast<flightRegionHeader_t*>(region) + 1);
+    slots[2].sequence     = 0;
+
+    flightRecorder rebooted;
+    ASSERT_EQ(rebooted.attach(region, sizeof(region), 0), ERROR_SUCCESS);
+    flightRecord_t records[8];
+    ASSERT_EQ(rebooted.getRecords(records, 8), 3u);
+    EXPECT_EQ(records[1].source, 5u);
+    EXPECT_EQ(records[2].event, FLIGHT_BOOT);
+}
+
+TEST_F(FlightRecorderTest, PersistsAndLoads)
+{
+    uint32_t       region[FLIGHT_REGION_SIZE / 4] = {};
+    flightRecorder recorder;
+    ASSERT_EQ(recorder.attach(region, sizeof(region), 0), ERROR_SUCCESS);
+    recorder.record(FLIGHT_HTTP, 1, 0, "/metrics");
+
+    memGeometry_t geometry = memDefaultGeometry(16 * 1024);
+    geometry.sectorSize    = 1024;
+    mem_ramDisk memory(geometry);
+    ASSERT_TRUE(memory.initialize());
+
+    flightRecord_t records[FLIGHT_RECORDS];
+    size_t         count = 0;
+    EXPECT_EQ(flightRecorder::load(memory, 4096, records, FLIGHT_RECORDS, count), ERROR_NOT_FOUND);
+    EXPECT_EQ(recorder.persist(memory, 100), ERROR_INVALID_ARG);
+    EXPECT_EQ(recorder.persist(memory, 15 * 1024 + 1024), ERROR_OUT_OF_MEMORY);
+
+    ASSERT_EQ(recorder.persist(memory, 4096), ERROR_SUCCESS);
+    ASSERT_EQ(flightRecorder::load(memory, 4096, records, FLIGHT_RECORDS, count), ERROR_SUCCESS);
+    ASSERT_EQ(count, 2u);
+    EXPECT_EQ(records[1].event, FLIGHT_HTTP);
+    EXPECT_EQ(memcmp(records[1].text, "/metrics", 8), 0);
+    EXPECT_EQ(flightRecorder::load(memory, 4096, records, 1, count), ERROR_OUT_OF_MEMORY);
+
+    // A reset before the header was written leaves no dump
+    memory.injectWriteFault(2, 0);
+    EXPECT_EQ(recorder.persist(memory, 4096), ERROR_WRITE_FAILED);
+    EXPECT_EQ(flightRecorder::load(memory, 4096, records, FLIGHT_RECORDS, count), ERROR_NOT_FOUND);
+}
+
+TEST_F(FlightRecorderTest, PrintsOneLinePerRecord)
+{
+    uint32_t       region[FLIGHT_REGION_SIZE / 4] = {};
+    flightRecorder recorder;
+    EXPECT_FALSE(recorder.print([](const void*, size_t) { return true; }));
+    ASSERT_EQ(recorder.attach(region, sizeof(region), 0), ERROR_SUCCESS);
+    recorder.record(FLIGHT_HTTP, 3, 42, "/connect");
+
+    std::string text;
+    ASSERT_TRUE(recorder.print(
+        [&text](const void* data, size_t length)
+        {
+            text.append(static_cast<const char*>(data), length);
+            return true;
+        }));
+    EXPECT_NE(text.find("BOOT  boot 1, reset reason 0\n"), std::string::npos);
+    EXPECT_NE(text.find("HTTP  POST /connect, 42 bytes\n"), std::string::npos);
+}
+
+TEST_F(FlightRecorderTest, ConcurrentWritersNeverTearRecords)
+{
+    uint32_t       region[FLIGHT_REGION_SIZE / 4] = {};
+    flightRecorder recorder;
+    ASSERT_EQ(recorder.attach(region, sizeof(region), 0), ERROR_SUCCESS);
+
+    std::vector<std::thread> writers;
+    for (uint16_t writer = 0; writer < 4; writer++)
+    {
+        writers.emplace_back(
+            [&recorder, writer]()
+            {
+                char text[FLIGHT_TEXT_SIZE];
+                for (uint32_t i = 0; i < 20000; i++)
+                {
+                    memset(text, 'a' + writer, sizeof(text));
+                    recorder.record(FLIGHT_USER, writer, i, text, sizeof(text));
+                }
+            });
+    }
+
+    // Every record read while the ring is overwritten is complete, slots being written are left out
+    flightRecord_t records[FLIGHT_RECORDS];
+    size_t         checked = 0;
+    auto           check   = [&recorder, &records, &checked]()
+    {
+        size_t count = recorder.getRecords(records, FLIGHT_RECORDS);
+        for (size_t i = 0; i < count; i++)
+        {
+            if (records[i].event != FLIGHT_USER)
+            {
+                continue;
+            }
+            for (size_t c = 0; c < FLIGHT_TEXT_SIZE; c++)
+            {
+                EXPECT_EQ(records[i].text[c], 'a' + records[i].source);
+            }
+            checked++;
+        }
+    };
+    for (int pass = 0; pass < 200; pass++)
+    {
+        check();
+    }
+    for (std::thread& writer : writers)
+    {
+        writer.join();
+    }
+    checked = 0;
+    check();
+    EXPECT_EQ(checked, static_cast<size_t>(FLIGHT_RECORDS));
+}
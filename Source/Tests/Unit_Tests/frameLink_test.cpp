@@ -0,0 +1,357 @@
+#include "HAL/Platform/Linux/com_pty.hpp"
+#include "Library/Protocol/frameLink.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// In-memory wire between two ports, can corrupt one byte of every n-th frame
+class loopbackPort : public com_stream
+{
+private:
+    uint8_t  _txStorage[4096];
+    uint8_t  _rxStorage[4096];
+    uint32_t _frames;
+    size_t   _frameOffset;
+
+protected:
+    void kickTx() override
+    {
+        ringSpan_t span = txDmaSpan();
+        while (span.length > 0)
+        {
+            ringSpan_t target = peer->rxDmaSpan();
+            size_t     length = std::min(span.length, target.length);
+            if (length == 0)
+            {
+                return;
+            }
+            for (size_t i = 0; i < length; i++)
+            {
+                uint8_t byte = span.data[i];
+                if (byte == 0)
+                {
+                    _frames++;
+                    _frameOffset = 0;
+                }
+                else if (corruptEvery > 0 && _frames % corruptEvery == corruptEvery - 1 && _frameOffset++ == 4)
+                {
+                    byte = (byte == 0xFF) ? 0xFE : byte + 1;
+                }
+                target.data[i] = byte;
+            }
+            peer->rxDmaComplete(length);
+            txDmaComplete(length);
+            span = txDmaSpan();
+        }
+    }
+
+public:
+    loopbackPort* peer;
+    uint32_t      corruptEvery;
+
+    loopbackPort() : com_stream(_txStorage, sizeof(_txStorage), _rxStorage, sizeof(_rxStorage)), _frames(0), _frameOffset(0), peer(nullptr), corruptEvery(0) {}
+
+    sys_error_t connect() override
+    {
+        return ERROR_SUCCESS;
+    }
+
+    sys_error_t disconnect() override
+    {
+        return ERROR_SUCCESS;
+    }
+
+    void pump()
+    {
+        kickTx();
+    }
+};
+
+struct received_t
+{
+    std::vector<uint32_t> sequence;
+    bool                  intact = true;
+};
+
+void collect(const uint8_t* payload, size_t length, void* context)
+{
+    received_t* received = static_cast<received_t*>(context);
+    uint32_t    value    = 0;
+    memcpy(&value, payload, sizeof(value));
+    for (size_t i = sizeof(value); i < length; i++)
+    {
+        received->intact &= payload[i] == static_cast<uint8_t>(value + i);
+    }
+    received->sequence.push_back(value);
+}
+
+std::vector<uint8_t> makePayload(uint32_t value, size_t length)
+{
+    std::vector<uint8_t> payload(length);
+    memcpy(payload.data(), &value, sizeof(value));
+    for (size_t i = sizeof(value); i < length; i++)
+    {
+        payload[i] = static_cast<uint8_t>(value + i);
+    }
+    return payload;
+}
+
+uint32_t nowMs()
+{
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+} // namespace
+
+TEST(FrameLinkTest, DeliversInOrderOverCleanLink)
+{
+    loopbackPort a, b;
+    a.peer = &b;
+    b.peer = &a;
+    frameLink  sender(a);
+    frameLink  receiver(b);
+    received_t received;
+    receiver.setFrameHandler(collect, &received);
+
+    uint32_t now = 0;
+    for (uint32_t i = 0; i < 500; now++)
+    {
+        std::vector<uint8_t> payload = makePayload(i, 4 + i % 200);
+        if (sender.send(payload.data(), payload.size(), now) == ERROR_SUCCESS)
+        {
+            i++;
+        }
+        receiver.poll(now);
+        sender.poll(now);
+    }
+    for (int i = 0; i < 10; i++, now++)
+    {
+        receiver.poll(now);
+        sender.poll(now);
+    }
+
+    ASSERT_EQ(received.sequence.size(), 500u);
+    for (uint32_t i = 0; i < 500; i++)
+    {
+        ASSERT_EQ(received.sequence[i], i);
+    }
+    EXPECT_TRUE(received.intact);
+    EXPECT_TRUE(sender.isIdle());
+    EXPECT_EQ(sender.getStats().retransmits, 0u);
+}
+
+TEST(FrameLinkTest, SelectiveRetransmitRepairsCorruption)
+{
+    loopbackPort a, b;
+    a.peer         = &b;
+    b.peer         = &a;
+    a.corruptEvery = 7;
+
+    frameLinkConfig_t config = frameLinkDefaultConfig();
+    config.crc               = FRAME_CRC32;
+    frameLink  sender(a, config);
+    frameLink  receiver(b, config);
+    received_t received;
+    receiver.setFrameHandler(collect, &received);
+
+    uint32_t now = 0;
+    for (uint32_t i = 0; i < 300; now++)
+    {
+        std::vector<uint8_t> payload = makePayload(i, 64);
+        if (sender.send(payload.data(), payload.size(), now) == ERROR_SUCCESS)
+        {
+            i++;
+        }
+        receiver.poll(now);
+        sender.poll(now);
+    }
+    for (int i = 0; i < 2000 && !sender.isIdle(); i++, now++)
+    {
+        receiver.poll(now);
+        sender.poll(now);
+    }
+
+    ASSERT_EQ(received.sequence.size(), 300u);
+    for (uint32_t i = 0; i < 300; i++)
+    {
+        ASSERT_EQ(received.sequence[i], i);
+    }
+    EXPECT_TRUE(received.intact);
+    EXPECT_GT(receiver.getStats().badFrames, 0u);
+    EXPECT_GT(receiver.getStats().naksSent, 0u);
+    EXPECT_GT(sender.getStats().retransmits, 0u);
+    EXPECT_LT(sender.getStats().retransmits, 300u);
+}
+
+// Sequence numbers wrap at 256, a window that does not divide it must not mix up the slots
+TEST(FrameLinkTest, WindowNotPowerOfTwoSurvivesSequenceWrap)
+{
+    for (uint8_t window : {10, 12, 20, 48})
+    {
+        loopbackPort a, b;
+        a.peer         = &b;
+        b.peer         = &a;
+        a.corruptEvery = 5;
+
+        frameLinkConfig_t config = frameLinkDefaultConfig();
+        config.maxPayload        = 64;
+        config.window            = window;
+        frameLink  sender(a, config);
+        frameLink  receiver(b, config);
+        received_t received;
+        receiver.setFrameHandler(collect, &received);
+
+        // Fill the whole window before the receiver runs, so every burst has losses and reordering
+        uint32_t now = 0;
+        for (uint32_t i = 0; i < 700; now++)
+        {
+            for (;;)
+            {
+                std::vector<uint8_t> payload = makePayload(i, 8 + i % 56);
+                if (i == 700 || sender.send(payload.data(), payload.size(), now) != ERROR_SUCCESS)
+                {
+                    break;
+                }
+                i++;
+            }
+            receiver.poll(now);
+            sender.poll(now);
+        }
+        for (int i = 0; i < 5000 && !sender.isIdle(); i++, now++)
+        {
+            receiver.poll(now);
+            sender.poll(now);
+        }
+
+        ASSERT_EQ(received.sequence.size(), 700u) << "window " << static_cast<unsigned>(window);
+        for (uint32_t i = 0; i < 700; i++)
+        {
+            ASSERT_EQ(received.sequence[i], i) << "window " << static_cast<unsigned>(window);
+        }
+        EXPECT_TRUE(received.intact) << "window " << static_cast<unsigned>(window);
+        EXPECT_GT(receiver.getStats().outOfOrder, 0u);
+    }
+}
+
+// Empty frames carry no payload buffer, also while they wait behind a gap
+TEST(FrameLinkTest, EmptyPayloadsWithoutSlots)
+{
+    loopbackPort a, b;
+    a.peer         = &b;
+    b.peer         = &a;
+    a.corruptEvery = 3;
+
+    frameLinkConfig_t config = frameLinkDefaultConfig();
+    config.maxPayload        = 0;
+    frameLink           sender(a, config);
+    frameLink           receiver(b, config);
+    std::vector<size_t> lengths;
+    receiver.setFrameHandler([](const uint8_t* payload, size_t length, void* context) { static_cast<std::vector<size_t>*>(context)->push_back(length); }, &lengths);
+
+    EXPECT_EQ(sender.send(nullptr, 1, 0), ERROR_INVALID_ARG);
+    uint32_t now = 0;
+    for (uint32_t i = 0; i < 100; now++)
+    {
+        while (i < 100 && sender.send(nullptr, 0, now) == ERROR_SUCCESS)
+        {
+            i++;
+        }
+        receiver.poll(now);
+        sender.poll(now);
+    }
+    for (int i = 0; i < 5000 && !sender.isIdle(); i++, now++)
+    {
+        receiver.poll(now);
+        sender.poll(now);
+    }
+
+    EXPECT_EQ(lengths, std::vector<size_t>(100, 0));
+    EXPECT_GT(receiver.getStats().outOfOrder, 0u);
+}
+
+TEST(FrameLinkTest, MaxPayloadIsLimitedTo16Bits)
+{
+    loopbackPort a;
+    a.peer = &a;
+
+    frameLinkConfig_t config = frameLinkDefaultConfig();
+    config.maxPayload        = 100000;
+    config.window            = 1;
+    frameLink            sender(a, config);
+    std::vector<uint8_t> payload(UINT16_MAX + 1);
+    EXPECT_EQ(sender.send(payload.data(), payload.size(), 0), ERROR_MESSAGE_TOO_LARGE);
+    EXPECT_EQ(sender.send(payload.data(), UINT16_MAX, 0), ERROR_SUCCESS);
+}
+
+TEST(FrameLinkTest, ResynchronisesAfterLineNoise)
+{
+    loopbackPort a, b;
+    a.peer = &b;
+    b.peer = &a;
+    frameLink  receiver(b);
+    received_t received;
+    receiver.setFrameHandler(collect, &received);
+
+    const uint8_t noise[] = {0x13, 0x37, 0x00, 0x05, 0xFF, 0x00};
+    a.sendData(noise, sizeof(noise));
+
+    frameLink            sender(a);
+    std::vector<uint8_t> payload = makePayload(0, 16);
+    ASSERT_EQ(sender.send(payload.data(), payload.size(), 0), ERROR_SUCCESS);
+    receiver.poll(0);
+
+    ASSERT_EQ(received.sequence.size(), 1u);
+    EXPECT_EQ(receiver.getStats().badFrames, 2u);
+}
+
+// Real serial port path: the frames cross a pty pair, throughput and latency are in Tests/Benchmarks
+TEST(FrameLinkTest, DeliversOverPtyPair)
+{
+    uint8_t storage[4][4096];
+    com_pty host(storage[0], sizeof(storage[0]), storage[1], sizeof(storage[1]));
+    ASSERT_EQ(host.connect(), ERROR_SUCCESS);
+    com_pty device(storage[2], sizeof(storage[2]), storage[3], sizeof(storage[3]), host.getSlaveName(), 3000000);
+    ASSERT_EQ(device.connect(), ERROR_SUCCESS);
+
+    frameLinkConfig_t config = frameLinkDefaultConfig();
+    config.window            = 16;
+    frameLink  sender(device, config);
+    frameLink  receiver(host, config);
+    received_t received;
+    receiver.setFrameHandler(collect, &received);
+
+    const uint32_t frames  = 100;
+    uint32_t       sent    = 0;
+    uint32_t       timeout = nowMs() + 5000;
+    while ((received.sequence.size() < frames || !sender.isIdle()) && nowMs() < timeout)
+    {
+        if (sent < frames)
+        {
+            std::vector<uint8_t> payload = makePayload(sent, 240);
+            if (sender.send(payload.data(), payload.size(), nowMs()) == ERROR_SUCCESS)
+            {
+                sent++;
+                continue;
+            }
+        }
+        receiver.poll(nowMs());
+        sender.poll(nowMs());
+        std::this_thread::yield();
+    }
+
+    ASSERT_EQ(received.sequence.size(), frames);
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        ASSERT_EQ(received.sequence[i], i);
+    }
+    EXPECT_TRUE(received.intact);
+    EXPECT_TRUE(sender.isIdle());
+
+    device.disconnect();
+    host.disconnect();
+}
@@ -0,0 +1,188 @@
+#include "HAL/Common/io_mcp23017Port.hpp"
+#include "HAL/Common/io_shiftRegisterPort.hpp"
+#include "HAL/Platform/Linux/com_mcp23017Sim.hpp"
+#include "HAL/Platform/Linux/com_shiftRegisterSim.hpp"
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+// Shift register chain whose bus fails on demand
+class flakySpi : public IHAL_SPI
+{
+public:
+    com_shiftRegisterSim chain;
+    bool                 failing;
+
+    explicit flakySpi(size_t registers) : chain(registers), failing(false) {}
+
+    sys_error_t transfer(const uint8_t* txData, uint8_t* rxData, size_t length) override
+    {
+        return failing ? ERROR_DEVICE_UNRESPONSIVE : chain.transfer(txData, rxData, length);
+    }
+};
+} // namespace
+
+TEST(IoExpanderTest, SixtyFourLedsInOneTransfer)
+{
+    com_shiftRegisterSim bus(8);
+    io_shiftRegisterPort port(bus, 8);
+    ASSERT_EQ(port.init(), ERROR_SUCCESS);
+
+    std::vector<std::unique_ptr<io_portPin>> leds;
+    for (uint8_t i = 0; i < 64; i++)
+    {
+        leds.emplace_back(new io_portPin(port, i));
+    }
+
+    // One update cycle: every LED writes its level, the bus sees one transfer
+    uint32_t before = bus.getStats().transactions;
+    for (uint8_t i = 0; i < 64; i++)
+    {
+        uint8_t level = (i % 3 == 0) ? 1 : 0;
+        leds[i]->set(&level);
+    }
+    EXPECT_TRUE(port.flush());
+    EXPECT_EQ(bus.getStats().transactions - before, 1u);
+    EXPECT_EQ(bus.getOutputs(), 0x9249249249249249ull);
+
+    // A cycle without changes does not touch the bus
+    for (uint8_t i = 0; i < 64; i++)
+    {
+        uint8_t level = (i % 3 == 0) ? 1 : 0;
+        leds[i]->set(&level);
+    }
+    EXPECT_FALSE(port.flush());
+    EXPECT_EQ(bus.getStats().transactions - before, 1u);
+}
+
+TEST(IoExpanderTest, ShortChainKeepsItsWidth)
+{
+    com_shiftRegisterSim bus(2);
+    io_shiftRegisterPort port(bus, 2);
+
+    port.set(0xFFFFFFull);
+    EXPECT_EQ(port.getOutputs(), 0xFFFFull);
+    EXPECT_EQ(bus.getOutputs(), 0xFFFFull);
+    EXPECT_EQ(bus.getStats().bytes, 2u);
+}
+
+TEST(IoExpanderTest, Mcp23017InputsInOneTransactionPerScan)
+{
+    com_mcp23017Sim bus;
+    bus.addDevice(0x20);
+    io_mcp23017Port port(bus, 0x20, 0x00FF, 0xFF00);
+    ASSERT_EQ(port.init(), ERROR_SUCCESS);
+
+    std::vector<std::unique_ptr<io_portPin>> buttons;
+    for (uint8_t i = 8; i < 16; i++)
+    {
+        buttons.emplace_back(new io_portPin(port, i));
+    }
+
+    // Buttons pull to ground, open inputs read high through the pull-ups
+    bus.setInputs(0x20, 0x0300, 0x0000);
+    uint32_t before = bus.getStats().transactions;
+    port.read();
+    int levels[8];
+    for (size_t i = 0; i < buttons.size(); i++)
+    {
+        buttons[i]->get(&levels[i]);
+    }
+    EXPECT_EQ(bus.getStats().transactions - before, 1u);
+    EXPECT_EQ(levels[0], 0);
+    EXPECT_EQ(levels[1], 0);
+    EXPECT_EQ(levels[2], 1);
+    EXPECT_EQ(levels[7], 1);
+}
+
+TEST(IoExpanderTest, Mcp23017WritesOnlyChangedLatches)
+{
+    com_mcp23017Sim bus;
+    bus.addDevice(0x21);
+    io_mcp23017Port port(bus, 0x21, 0xFFFF, 0);
+    ASSERT_EQ(port.init(), ERROR_SUCCESS);
+
+    busStats_t before = bus.getStats();
+    port.set(0x0081);
+    EXPECT_EQ(bus.getOutputs(0x21), 0x0081u);
+    EXPECT_EQ(bus.getStats().transactions - before.transactions, 1u);
+    EXPECT_EQ(bus.getStats().bytes - before.bytes, 3u); // address, register, OLATA
+
+    port.toggle(0xFFFF);
+    EXPECT_EQ(bus.getOutputs(0x21), 0xFF7Eu);
+    EXPECT_EQ(bus.getStats().transactions - before.transactions, 2u);
+}
+
+TEST(IoExpanderTest, SixtyFourButtonsOnFourExpanders)
+{
+    com_mcp23017Sim                               bus;
+    std::vector<std::unique_ptr<io_mcp23017Port>> ports;
+    for (uint8_t address = 0x20; address < 0x24; address++)
+    {
+        bus.addDevice(address);
+        ports.emplace_back(new io_mcp23017Port(bus, address, 0, 0xFFFF));
+        ASSERT_EQ(ports.back()->init(), ERROR_SUCCESS);
+    }
+    bus.setInputs(0x22, 0x0010, 0);
+
+    // One scan of all 64 buttons
+    uint32_t before  = bus.getStats().transactions;
+    uint32_t pressed = 0;
+    for (auto& port : ports)
+    {
+        io_portMask_t levels = port->read();
+        for (uint8_t pin = 0; pin < MCP23017_PIN_COUNT; pin++)
+        {
+            pressed += ((levels & IO_PORT_PIN(pin)) == 0) ? 1 : 0;
+        }
+    }
+    EXPECT_EQ(bus.getStats().transactions - before, 4u);
+    EXPECT_EQ(pressed, 1u);
+}
+
+TEST(IoExpanderTest, MissingDeviceCountsBusErrors)
+{
+    com_mcp23017Sim bus;
+    io_mcp23017Port port(bus, 0x27, 0x00FF, 0xFF00);
+
+    EXPECT_EQ(port.init(), ERROR_DEVICE_UNRESPONSIVE);
+    port.set(0x01);
+    port.read();
+    EXPECT_EQ(port.getBusErrors(), 2u);
+    EXPECT_EQ(port.getStats().errors, 1u);
+}
+
+TEST(IoExpanderTest, FailedWriteIsRetriedByFlush)
+{
+    flakySpi             bus(1);
+    io_shiftRegisterPort port(bus, 1);
+    io_portPin           led(port, 3);
+    ASSERT_EQ(port.init(), ERROR_SUCCESS);
+
+    // A failed write keeps the old levels and leaves the pins dirty
+    bus.failing = true;
+    EXPECT_EQ(port.set(0x01), ERROR_DEVICE_UNRESPONSIVE);
+    uint8_t on = 1;
+    led.set(&on);
+    EXPECT_FALSE(port.flush());
+    EXPECT_EQ(port.getOutputs(), 0u);
+    EXPECT_EQ(port.getBusErrors(), 2u);
+    EXPECT_EQ(port.getStats().errors, 2u);
+
+    bus.failing = false;
+    EXPECT_TRUE(port.flush());
+    EXPECT_EQ(port.getOutputs(), 0x09u);
+    EXPECT_EQ(bus.chain.getOutputs(), 0x09u);
+    EXPECT_FALSE(port.flush());
+
+    // A direct write replaces a level still waiting for a retry
+    bus.failing = true;
+    EXPECT_EQ(port.clear(0x08), ERROR_DEVICE_UNRESPONSIVE);
+    bus.failing = false;
+    EXPECT_EQ(port.set(0x08), ERROR_SUCCESS);
+    EXPECT_FALSE(port.flush());
+    EXPECT_EQ(bus.chain.getOutputs(), 0x09u);
+}
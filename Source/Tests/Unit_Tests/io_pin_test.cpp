@@ -0,0 +1,59 @@
+#include "HAL/Platform/Linux/io_hostGpio.hpp"
+#include "gtest/gtest.h"
+
+#include <type_traits>
+
+typedef io_hostGpio<2, IO_DIRECTION_OUTPUT> ledPin;
+typedef io_hostGpio<40, IO_DIRECTION_INPUT> buttonPin;
+
+class IoPinTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        hostGpioReset();
+    }
+};
+
+TEST_F(IoPinTest, StaticPinDrivesRegister)
+{
+    ledPin::set(1);
+    EXPECT_EQ(hostGpio().out, 1u << 2);
+    EXPECT_EQ(ledPin::get(), 1u);
+
+    ledPin::set(0);
+    EXPECT_EQ(hostGpio().out, 0u);
+    EXPECT_EQ(hostGpio().writes, 2u);
+}
+
+TEST_F(IoPinTest, StaticPinReadsInputRegister)
+{
+    EXPECT_EQ(buttonPin::get(), 0u);
+    hostGpio().in = static_cast<uint64_t>(1) << 40;
+    EXPECT_EQ(buttonPin::get(), 1u);
+}
+
+TEST_F(IoPinTest, StaticPinHasNoState)
+{
+    EXPECT_TRUE(std::is_empty<ledPin>::value);
+}
+
+TEST_F(IoPinTest, AdapterKeepsIhalIoSemantics)
+{
+    io_pinAdapter<ledPin>    led;
+    io_pinAdapter<buttonPin> button;
+    IHAL_IO&                 output = led;
+    IHAL_IO&                 input  = button;
+
+    uint8_t on = 1;
+    EXPECT_EQ(output.set(&on), ERROR_SUCCESS);
+    int level = 0;
+    output.get(&level);
+    EXPECT_EQ(level, 1);
+
+    EXPECT_EQ(input.set(&on), ERROR_NOT_SUPPORTED);
+    EXPECT_EQ(input.set(nullptr), ERROR_NULL_POINTER);
+    hostGpio().in = static_cast<uint64_t>(1) << 40;
+    input.get(&level);
+    EXPECT_EQ(level, 1);
+}
@@ -0,0 +1,128 @@
+#include "HAL/Platform/Linux/io_hostGpioPort.hpp"
+#include "gtest/gtest.h"
+
+namespace
+{
+constexpr io_portMask_t outputs = 0xFFFFFFFFull; // pins 0-31
+constexpr io_portMask_t inputs  = 0xFFull << 32; // pins 32-39
+} // namespace
+
+class IoPortTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        hostGpioReset();
+    }
+};
+
+TEST_F(IoPortTest, ThirtyTwoOutputsInOneWrite)
+{
+    io_hostGpioPort port(outputs, inputs);
+    ASSERT_EQ(port.init(), ERROR_SUCCESS);
+
+    port.set(outputs);
+    EXPECT_EQ(hostGpio().out, outputs);
+    EXPECT_EQ(hostGpio().writes, 1u);
+    EXPECT_EQ(port.getStats().writes, 1u);
+}
+
+TEST_F(IoPortTest, SetClearToggleMasks)
+{
+    io_hostGpioPort port(outputs, inputs);
+
+    port.set(0x0F);
+    port.clear(0x03);
+    EXPECT_EQ(hostGpio().out, 0x0Cu);
+
+    port.toggle(0xFF);
+    EXPECT_EQ(hostGpio().out, 0xF3u);
+    EXPECT_EQ(port.getOutputs(), 0xF3u);
+
+    port.write(0xF0, 0x50);
+    EXPECT_EQ(hostGpio().out, 0x53u);
+    EXPECT_EQ(hostGpio().writes, 4u);
+}
+
+TEST_F(IoPortTest, OnlyOwnedPinsAreDriven)
+{
+    io_hostGpioPort port(0x0F, 0);
+
+    port.set(0xFF);
+    EXPECT_EQ(hostGpio().out, 0x0Fu);
+
+    // Nothing changes, no access
+    port.set(0x0F);
+    EXPECT_EQ(hostGpio().writes, 1u);
+}
+
+TEST_F(IoPortTest, InputSnapshot)
+{
+    io_hostGpioPort port(outputs, inputs);
+
+    hostGpio().in = (0xA5ull << 32) | 0x1;
+    EXPECT_EQ(port.read(), 0xA5ull << 32);
+
+    // The snapshot stays until the next read
+    hostGpio().in = 0;
+    EXPECT_EQ(port.getInputs(), 0xA5ull << 32);
+    EXPECT_EQ(port.getStats().reads, 1u);
+}
+
+TEST_F(IoPortTest, PinsStageUntilFlush)
+{
+    io_hostGpioPort port(outputs, inputs);
+    io_portPin      led0(port, 0);
+    io_portPin      led5(port, 5);
+    IHAL_IO&        gpio0 = led0;
+    IHAL_IO&        gpio5 = led5;
+
+    uint8_t on = 1;
+    EXPECT_EQ(gpio0.set(&on), ERROR_SUCCESS);
+    EXPECT_EQ(gpio5.set(&on), ERROR_SUCCESS);
+    EXPECT_EQ(hostGpio().out, 0u);
+
+    EXPECT_TRUE(port.flush());
+    EXPECT_EQ(hostGpio().out, 0x21u);
+    EXPECT_EQ(hostGpio().writes, 1u);
+
+    // Unchanged levels are not written again
+    EXPECT_EQ(gpio0.set(&on), ERROR_SUCCESS);
+    EXPECT_FALSE(port.flush());
+
+    int level = 0;
+    gpio5.get(&level);
+    EXPECT_EQ(level, 1);
+}
+
+TEST_F(IoPortTest, InputPinReadsSnapshot)
+{
+    io_hostGpioPort port(outputs, inputs);
+    io_portPin      button(port, 33);
+
+    uint8_t on = 1;
+    EXPECT_EQ(button.set(&on), ERROR_NOT_SUPPORTED);
+
+    hostGpio().in = IO_PORT_PIN(33);
+    int level     = 0;
+    button.get(&level);
+    EXPECT_EQ(level, 0);
+
+    port.read();
+    button.get(&level);
+    EXPECT_EQ(level, 1);
+}
+
+TEST_F(IoPortTest, WholePortThroughIhalIo)
+{
+    io_hostGpioPort port(outputs, inputs);
+    IHAL_IO&        io = port;
+
+    io_portMask_t levels = 0xDEADBEEF;
+    EXPECT_EQ(io.set(&levels), ERROR_SUCCESS);
+    EXPECT_EQ(hostGpio().out, 0xDEADBEEFu);
+
+    hostGpio().in = 0x42ull << 32;
+    io.get(&levels);
+    EXPECT_EQ(levels, 0x42ull << 32);
+}
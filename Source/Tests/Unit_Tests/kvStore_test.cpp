@@ -0,0 +1,155 @@
+#include "HAL/Platform/Linux/mem_mmapFile.hpp"
+#include "Library/Storage/kvStore.h"
+#include "gtest/gtest.h"
+
+#include <stdio.h>
+#include <string>
+#include <unistd.h>
+
+class KvStoreTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _path = "/tmp/kvStore_test_" + std::to_string(getpid()) + ".bin";
+        unlink(_path.c_str());
+    }
+
+    void TearDown() override
+    {
+        unlink(_path.c_str());
+    }
+
+    std::string _path;
+};
+
+TEST_F(KvStoreTest, PutGetRemove)
+{
+    mem_mmapFile memory(_path.c_str(), 4 * 1024, 1024);
+    kvStore      store(memory);
+    ASSERT_EQ(store.mount(), ERROR_SUCCESS);
+
+    const char ssid[] = "home-network";
+    ASSERT_EQ(store.put("wifi.ssid", ssid, sizeof(ssid)), ERROR_SUCCESS);
+
+    char   buffer[32];
+    size_t length = 0;
+    ASSERT_EQ(store.get("wifi.ssid", buffer, sizeof(buffer), length), ERROR_SUCCESS);
+    EXPECT_EQ(length, sizeof(ssid));
+    EXPECT_STREQ(buffer, ssid);
+
+    EXPECT_EQ(store.get("wifi.ssid", buffer, 4, length), ERROR_BUFFER_OVERFLOW);
+    EXPECT_EQ(store.get("wifi.pass", buffer, sizeof(buffer), length), ERROR_NOT_FOUND);
+
+    ASSERT_EQ(store.remove("wifi.ssid"), ERROR_SUCCESS);
+    EXPECT_FALSE(store.contains("wifi.ssid"));
+    EXPECT_EQ(store.remove("wifi.ssid"), ERROR_NOT_FOUND);
+    EXPECT_EQ(store.getKeyCount(), 0u);
+}
+
+TEST_F(KvStoreTest, SameValueIsNotRewritten)
+{
+    mem_mmapFile memory(_path.c_str(), 4 * 1024, 1024);
+    kvStore      store(memory);
+    ASSERT_EQ(store.mount(), ERROR_SUCCESS);
+
+    uint32_t mode = 3;
+    ASSERT_EQ(store.put("led.mode", &mode, sizeof(mode)), ERROR_SUCCESS);
+    uint32_t written = store.getStats().flashBytesWritten;
+
+    ASSERT_EQ(store.put("led.mode", &mode, sizeof(mode)), ERROR_SUCCESS);
+    EXPECT_EQ(store.getStats().flashBytesWritten, written);
+}
+
+TEST_F(KvStoreTest, ValuesSurviveRemount)
+{
+    {
+        mem_mmapFile memory(_path.c_str(), 4 * 1024, 1024);
+        kvStore      store(memory);
+        ASSERT_EQ(store.mount(), ERROR_SUCCESS);
+
+        uint32_t value = 1;
+        ASSERT_EQ(store.put("button.0", &value, sizeof(value)), ERROR_SUCCESS);
+        value = 2;
+        ASSERT_EQ(store.put("button.0", &value, sizeof(value)), ERROR_SUCCESS);
+        ASSERT_EQ(store.put("button.1", &value, sizeof(value)), ERROR_SUCCESS);
+        ASSERT_EQ(store.remove("button.1"), ERROR_SUCCESS);
+    }
+
+    mem_mmapFile memory(_path.c_str(), 4 * 1024, 1024);
+    kvStore      store(memory);
+    ASSERT_EQ(store.mount(), ERROR_SUCCESS);
+
+    uint32_t value  = 0;
+    size_t   length = 0;
+    ASSERT_EQ(store.get("button.0", &value, sizeof(value), length), ERROR_SUCCESS);
+    EXPECT_EQ(value, 2u);
+    EXPECT_FALSE(store.contains("button.1"));
+    EXPECT_EQ(store.getKeyCount(), 1u);
+}
+
+TEST_F(KvStoreTest, CompactionKeepsLatestValues)
+{
+    mem_mmapFile memory(_path.c_str(), 4 * 1024, 512);
+    kvStore      store(memory, 16);
+    ASSERT_EQ(store.mount(), ERROR_SUCCESS);
+
+    // Enough churn to wrap around the device several times
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        char key[16];
+        snprintf(key, sizeof(key), "key.%u", i % 10);
+        ASSERT_EQ(store.put(key, &i, sizeof(i)), ERROR_SUCCESS);
+        store.compactStep();
+    }
+
+    kvStoreStats_t stats = store.getStats();
+    EXPECT_GT(stats.compactions, 0u);
+    EXPECT_GE(stats.flashBytesWritten, stats.userBytesWritten);
+
+    mem_mmapFile reopened(_path.c_str(), 4 * 1024, 512);
+    kvStore      remounted(reopened, 16);
+    ASSERT_EQ(remounted.mount(), ERROR_SUCCESS);
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        char     key[16];
+        uint32_t value  = 0;
+        size_t   length = 0;
+        snprintf(key, sizeof(key), "key.%u", i);
+        ASSERT_EQ(remounted.get(key, &value, sizeof(value), length), ERROR_SUCCESS);
+        EXPECT_EQ(value, 1990 + i);
+    }
+}
+
+TEST_F(KvStoreTest, CorruptRecordIsSkipped)
+{
+    {
+        mem_mmapFile memory(_path.c_str(), 4 * 1024, 1024);
+        kvStore      store(memory);
+        ASSERT_EQ(store.mount(), ERROR_SUCCESS);
+
+        uint32_t value = 7;
+        ASSERT_EQ(store.put("a", &value, sizeof(value)), ERROR_SUCCESS);
+        value = 8;
+        ASSERT_EQ(store.put("a", &value, sizeof(value)), ERROR_SUCCESS);
+    }
+
+    // Clear a bit in the value of the second record: sector header (12) + first record (20) + header (12) + key (1)
+    {
+        mem_mmapFile memory(_path.c_str(), 4 * 1024, 1024);
+        ASSERT_TRUE(memory.initialize());
+        uint8_t byte = 0;
+        ASSERT_TRUE(memory.readData(12 + 20 + 12 + 1, &byte, 1));
+        byte &= ~0x08;
+        ASSERT_TRUE(memory.writeData(12 + 20 + 12 + 1, &byte, 1));
+    }
+
+    mem_mmapFile memory(_path.c_str(), 4 * 1024, 1024);
+    kvStore      store(memory);
+    ASSERT_EQ(store.mount(), ERROR_SUCCESS);
+
+    uint32_t value  = 0;
+    size_t   length = 0;
+    ASSERT_EQ(store.get("a", &value, sizeof(value), length), ERROR_SUCCESS);
+    EXPECT_EQ(value, 7u);
+}
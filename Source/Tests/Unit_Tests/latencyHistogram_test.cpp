@@ -0,0 +1,96 @@
+#include "Library/Diagnostics/latencyHistogram.h"
+#include "gtest/gtest.h"
+
+#include <string.h>
+
+TEST(LatencyHistogramTest, SmallValuesAreExact)
+{
+    latencyHistogram histogram;
+    for (uint64_t value = 1; value <= 100; value++)
+    {
+        histogram.record(value);
+    }
+    EXPECT_EQ(histogram.getCount(), 100u);
+    EXPECT_EQ(histogram.getMin(), 1u);
+    EXPECT_EQ(histogram.getMax(), 100u);
+    EXPECT_DOUBLE_EQ(histogram.getMean(), 50.5);
+    EXPECT_EQ(histogram.getPercentile(50.0), 50u);
+    EXPECT_EQ(histogram.getPercentile(99.0), 99u);
+    EXPECT_EQ(histogram.getPercentile(100.0), 100u);
+    EXPECT_EQ(histogram.getPercentile(0.0), 1u);
+}
+
+TEST(LatencyHistogramTest, LargeValuesKeepRelativePrecision)
+{
+    latencyHistogram histogram;
+    for (uint64_t value = 1000; value <= 1000000000; value *= 10)
+    {
+        histogram.record(value);
+        uint64_t reported = histogram.getPercentile(100.0);
+        EXPECT_EQ(reported, value); // clipped to the max
+
+        latencyHistogram single;
+        single.record(value);
+        single.record(value * 2); // moves the max out of the way of the first bucket
+        uint64_t low = single.getPercentile(50.0);
+        EXPECT_GE(low, value);
+        EXPECT_LE(static_cast<double>(low - value), static_cast<double>(value) / latencyHistogram::subBuckets * 2);
+    }
+}
+
+TEST(LatencyHistogramTest, PercentilesOfSkewedDistribution)
+{
+    latencyHistogram histogram;
+    for (int i = 0; i < 990; i++)
+    {
+        histogram.record(100000); // 100 us
+    }
+    for (int i = 0; i < 10; i++)
+    {
+        histogram.record(20000000); // 20 ms outliers
+    }
+    EXPECT_NEAR(static_cast<double>(histogram.getPercentile(50.0)), 100000.0, 1000.0);
+    EXPECT_NEAR(static_cast<double>(histogram.getPercentile(99.0)), 100000.0, 1000.0);
+    EXPECT_NEAR(static_cast<double>(histogram.getPercentile(99.5)), 20000000.0, 200000.0);
+}
+
+TEST(LatencyHistogramTest, MergeAndClamp)
+{
+    latencyHistogram first(1000000);
+    latencyHistogram second(1000000);
+    first.record(10);
+    second.record(20);
+    second.record(5000000); // beyond maxValue
+    first.merge(second);
+
+    EXPECT_EQ(first.getCount(), 3u);
+    EXPECT_EQ(first.getMin(), 10u);
+    EXPECT_EQ(first.getMax(), 1000000u);
+
+    first.reset();
+    EXPECT_EQ(first.getCount(), 0u);
+    EXPECT_EQ(first.getPercentile(50.0), 0u);
+}
+
+TEST(LatencyHistogramTest, Format)
+{
+    latencyHistogram histogram;
+    for (uint64_t value = 1; value <= 1000; value++)
+    {
+        histogram.record(value * 1000);
+    }
+
+    char buffer[4096];
+    histogram.formatSummary(buffer, sizeof(buffer), 1000.0, "us");
+    EXPECT_NE(strstr(buffer, "count 1000"), nullptr);
+    EXPECT_NE(strstr(buffer, "max 1000.0 us"), nullptr);
+
+    size_t length = histogram.formatDistribution(buffer, sizeof(buffer), 1000.0);
+    EXPECT_EQ(strlen(buffer), length);
+    EXPECT_NE(strstr(buffer, "0.500000000000"), nullptr);
+    EXPECT_NE(strstr(buffer, "0.750000000000"), nullptr);
+    EXPECT_NE(strstr(buffer, "inf"), nullptr);
+
+    // Truncation keeps the buffer terminated
+    EXPECT_EQ(histogram.formatDistribution(buffer, 16, 1000.0), 15u);
+}
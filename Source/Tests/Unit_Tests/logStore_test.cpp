@@ -0,0 +1,187 @@
+#include "HAL/Platform/Linux/mem_mmapFile.hpp"
+#include "Library/Storage/logStore.h"
+#include "gtest/gtest.h"
+
+#include <stdio.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+// Decoded lines without the timestamp: "I tag: message"
+sys_error_t decodeLines(logStore& store, std::vector<std::string>& lines)
+{
+    lines.clear();
+    return store.decode(
+        [&lines](const char* line, size_t length)
+        {
+            std::string text(line, length);
+            size_t      open  = text.find(" (");
+            size_t      close = text.find(") ");
+            lines.push_back(text.substr(0, open) + " " + text.substr(close + 2, text.size() - close - 3));
+            return true;
+        });
+}
+} // namespace
+
+class LogStoreTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _path = "/tmp/logStore_test_" + std::to_string(getpid()) + ".bin";
+        unlink(_path.c_str());
+    }
+
+    void TearDown() override
+    {
+        unlink(_path.c_str());
+    }
+
+    std::string _path;
+};
+
+TEST_F(LogStoreTest, FormatsRoundTrip)
+{
+    mem_mmapFile memory(_path.c_str(), 8 * 1024, 1024);
+    logStore     store(memory, 0, 2048, 4);
+    ASSERT_EQ(store.mount(), ERROR_SUCCESS);
+
+    ASSERT_EQ(store.log(0, "wifi", "connected to %s, rssi %d dBm", "home", -67), ERROR_SUCCESS);
+    ASSERT_EQ(store.log(1, "heap", "free %u of %lu bytes (%.1f%%)", 1234u, 65536ul, 1.9), ERROR_SUCCESS);
+    ASSERT_EQ(store.log(2, "sensor", "[%-6s|%*d|%08llx|%c]", "t1", 5, 42, 0xDEADBEEFull, 'x'), ERROR_SUCCESS);
+    ASSERT_EQ(store.log(0, "size", "%zu %hhd %lld", sizeof(int), static_cast<signed char>(-3), -9000000000ll), ERROR_SUCCESS);
+    const char text[] = "already formatted text";
+    ASSERT_EQ(store.logText(0, "main", text, sizeof(text) - 1), ERROR_SUCCESS);
+    ASSERT_EQ(store.flush(), ERROR_SUCCESS);
+
+    std::vector<std::string> lines;
+    ASSERT_EQ(decodeLines(store, lines), ERROR_SUCCESS);
+    ASSERT_EQ(lines.size(), 5u);
+    EXPECT_EQ(lines[0], "I wifi: connected to home, rssi -67 dBm");
+    EXPECT_EQ(lines[1], "W heap: free 1234 of 65536 bytes (1.9%)");
+    EXPECT_EQ(lines[2], "E sensor: [t1    |   42|deadbeef|x]");
+    EXPECT_EQ(lines[3], "I size: 4 -3 -9000000000");
+    EXPECT_EQ(lines[4], "I main: already formatted text");
+}
+
+TEST_F(LogStoreTest, RepeatedRecordsAreSmall)
+{
+    mem_mmapFile memory(_path.c_str(), 8 * 1024, 1024);
+    logStore     store(memory, 0, 4096, 2);
+    ASSERT_EQ(store.mount(), ERROR_SUCCESS);
+
+    for (int i = 0; i < 100; i++)
+    {
+        ASSERT_EQ(store.log(0, "process", "temperature sensor reading %d", i), ERROR_SUCCESS);
+    }
+    ASSERT_EQ(store.flush(), ERROR_SUCCESS);
+
+    // Tag and format are defined once, a record holds the ids, the time and the argument
+    logStoreStats_t stats = store.getStats();
+    EXPECT_EQ(stats.records, 100u);
+    EXPECT_LT(stats.recordBytes, 100u * 10u);
+    EXPECT_GT(stats.compressedBlocks, 0u);
+    EXPECT_LT(stats.flashBytesWritten, stats.recordBytes);
+
+    std::vector<std::string> lines;
+    ASSERT_EQ(decodeLines(store, lines), ERROR_SUCCESS);
+    ASSERT_EQ(lines.size(), 100u);
+    EXPECT_EQ(lines[99], "I process: temperature sensor reading 99");
+}
+
+TEST_F(LogStoreTest, OldestSegmentIsReused)
+{
+    mem_mmapFile memory(_path.c_str(), 8 * 1024, 1024);
+    logStore     store(memory, 1024, 2048, 3);
+    ASSERT_EQ(store.mount(), ERROR_SUCCESS);
+
+    char text[64];
+    for (int i = 0; i < 2000; i++)
+    {
+        // Texts which do not compress well, so the segments fill up
+        int length = snprintf(text, sizeof(text), "%08x %d", static_cast<unsigned>(i * 2654435761u), i);
+        ASSERT_EQ(store.logText(0, "t", text, static_cast<size_t>(length)), ERROR_SUCCESS);
+    }
+    ASSERT_EQ(store.flush(), ERROR_SUCCESS);
+    EXPECT_GT(store.getStats().segmentErases, 3u);
+
+    // The newest records are kept in order, each segment decodes on its own
+    std::vector<std::string> lines;
+    ASSERT_EQ(decodeLines(store, lines), ERROR_SUCCESS);
+    ASSERT_GT(lines.size(), 10u);
+    ASSERT_LT(lines.size(), 2000u);
+    int first = atoi(lines[0].c_str() + lines[0].rfind(' '));
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+        EXPECT_EQ(atoi(lines[i].c_str() + lines[i].rfind(' ')), first + static_cast<int>(i));
+    }
+    EXPECT_EQ(first + static_cast<int>(lines.size()), 2000);
+}
+
+TEST_F(LogStoreTest, RecordsSurviveRemount)
+{
+    {
+        mem_mmapFile memory(_path.c_str(), 8 * 1024, 1024);
+        logStore     store(memory, 0, 2048, 4);
+        ASSERT_EQ(store.mount(), ERROR_SUCCESS);
+        ASSERT_EQ(store.log(0, "boot", "first boot %d", 1), ERROR_SUCCESS);
+        ASSERT_EQ(store.log(0, "boot", "second line"), ERROR_SUCCESS);
+        ASSERT_EQ(store.flush(), ERROR_SUCCESS);
+        ASSERT_EQ(store.log(0, "boot", "lost, never flushed"), ERROR_SUCCESS);
+    }
+
+    mem_mmapFile memory(_path.c_str(), 8 * 1024, 1024);
+    logStore     store(memory, 0, 2048, 4);
+    ASSERT_EQ(store.mount(), ERROR_SUCCESS);
+    ASSERT_EQ(store.log(0, "boot", "first boot %d", 2), ERROR_SUCCESS);
+    ASSERT_EQ(store.flush(), ERROR_SUCCESS);
+    EXPECT_EQ(store.getStats().segmentErases, 0u);
+
+    std::vector<std::string> lines;
+    ASSERT_EQ(decodeLines(store, lines), ERROR_SUCCESS);
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_EQ(lines[0], "I boot: first boot 1");
+    EXPECT_EQ(lines[1], "I boot: second line");
+    EXPECT_EQ(lines[2], "I boot: first boot 2");
+}
+
+TEST_F(LogStoreTest, CorruptBlockIsSkipped)
+{
+    mem_mmapFile memory(_path.c_str(), 8 * 1024, 1024);
+    logStore     store(memory, 0, 2048, 4);
+    ASSERT_EQ(store.mount(), ERROR_SUCCESS);
+    ASSERT_EQ(store.log(0, "a", "first block"), ERROR_SUCCESS);
+    ASSERT_EQ(store.flush(), ERROR_SUCCESS);
+    ASSERT_EQ(store.log(0, "b", "second block %d", 2), ERROR_SUCCESS);
+    ASSERT_EQ(store.flush(), ERROR_SUCCESS);
+
+    // Clear a bit in the data of the first block: segment header (16) + block header (8)
+    uint8_t byte = 0;
+    ASSERT_TRUE(memory.readData(16 + 8 + 4, &byte, 1));
+    ASSERT_NE(byte, 0);
+    byte &= static_cast<uint8_t>(byte - 1);
+    ASSERT_TRUE(memory.writeData(16 + 8 + 4, &byte, 1));
+
+    std::vector<std::string> lines;
+    EXPECT_EQ(decodeLines(store, lines), ERROR_DATA_CORRUPTED);
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_EQ(lines[0], "I b: second block 2");
+}
+
+TEST_F(LogStoreTest, InvalidLayoutIsRejected)
+{
+    mem_mmapFile memory(_path.c_str(), 8 * 1024, 1024);
+
+    logStore unaligned(memory, 512, 2048, 2);
+    EXPECT_EQ(unaligned.mount(), ERROR_INVALID_CONFIG);
+
+    logStore tooLarge(memory, 0, 4096, 3);
+    EXPECT_EQ(tooLarge.mount(), ERROR_INVALID_CONFIG);
+
+    logStore oneSegment(memory, 0, 4096, 1);
+    EXPECT_EQ(oneSegment.mount(), ERROR_INVALID_CONFIG);
+
+    EXPECT_EQ(oneSegment.log(0, "x", "not mounted"), ERROR_INIT_FAILED);
+}
@@ -0,0 +1,80 @@
+#include "Library/Common/lz.h"
+#include "gtest/gtest.h"
+
+#include <string.h>
+#include <vector>
+
+namespace
+{
+std::vector<uint8_t> roundTrip(const std::vector<uint8_t>& data, size_t& compressedLength)
+{
+    lz::compressor       compressor;
+    std::vector<uint8_t> packed(lz::maxCompressedLength(data.size()));
+    compressedLength = compressor.compress(data.data(), data.size(), packed.data(), packed.size());
+    EXPECT_GT(compressedLength, 0u);
+
+    std::vector<uint8_t> output(data.size());
+    size_t               length = lz::decompress(packed.data(), compressedLength, output.data(), output.size());
+    output.resize(length);
+    return output;
+}
+} // namespace
+
+TEST(LzTest, RepetitiveDataShrinks)
+{
+    std::vector<uint8_t> data;
+    const char           line[] = "I (1234) wifi: connected to access point\n";
+    for (int i = 0; i < 10; i++)
+    {
+        data.insert(data.end(), line, line + sizeof(line) - 1);
+    }
+
+    size_t compressed = 0;
+    EXPECT_EQ(roundTrip(data, compressed), data);
+    EXPECT_LT(compressed, data.size() / 4);
+}
+
+TEST(LzTest, RandomDataRoundTrips)
+{
+    std::vector<uint8_t> data(1000);
+    uint32_t             state = 12345;
+    for (uint8_t& byte : data)
+    {
+        state = state * 1103515245u + 12345u;
+        byte  = static_cast<uint8_t>(state >> 24);
+    }
+
+    size_t compressed = 0;
+    EXPECT_EQ(roundTrip(data, compressed), data);
+    EXPECT_LE(compressed, lz::maxCompressedLength(data.size()));
+}
+
+TEST(LzTest, OverlappingMatch)
+{
+    std::vector<uint8_t> data(300, 'a');
+    size_t               compressed = 0;
+    EXPECT_EQ(roundTrip(data, compressed), data);
+    EXPECT_LT(compressed, 16u);
+}
+
+TEST(LzTest, SmallCapacityFails)
+{
+    const uint8_t  data[] = "no repetition here";
+    uint8_t        packed[8];
+    lz::compressor compressor;
+    EXPECT_EQ(compressor.compress(data, sizeof(data), packed, sizeof(packed)), 0u);
+}
+
+TEST(LzTest, MalformedBlockIsRejected)
+{
+    uint8_t output[16];
+
+    const uint8_t truncatedLiteral[] = {0x05, 'a', 'b'};
+    EXPECT_EQ(lz::decompress(truncatedLiteral, sizeof(truncatedLiteral), output, sizeof(output)), 0u);
+
+    const uint8_t distanceTooFar[] = {0x00, 'a', 0x80, 0x02, 0x00};
+    EXPECT_EQ(lz::decompress(distanceTooFar, sizeof(distanceTooFar), output, sizeof(output)), 0u);
+
+    const uint8_t tooLong[] = {0x00, 'a', 0xFF, 0x01, 0x00};
+    EXPECT_EQ(lz::decompress(tooLong, sizeof(tooLong), output, sizeof(output)), 0u);
+}
@@ -0,0 +1,260 @@
+#include "HAL/Platform/Linux/net_multicastHost.hpp"
+#include "Library/Protocol/mdnsResponder.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Link shared by the bus transports, every datagram reaches every member, the sender included
+struct bus_t
+{
+    std::vector<std::deque<std::string>*> members;
+};
+
+class busTransport : public IHAL_COM
+{
+public:
+    bus_t&                  bus;
+    std::deque<std::string> inbox;
+    std::vector<std::string> sent;
+
+    explicit busTransport(bus_t& link) : bus(link)
+    {
+        bus.members.push_back(&inbox);
+    }
+
+    sys_error_t connect() override
+    {
+        return ERROR_SUCCESS;
+    }
+    sys_error_t sendData(const uint8_t* data, size_t length) override
+    {
+        std::string datagram(reinterpret_cast<const char*>(data), length);
+        sent.push_back(datagram);
+        for (std::deque<std::string>* member : bus.members)
+        {
+            member->push_back(datagram);
+        }
+        return ERROR_SUCCESS;
+    }
+    sys_error_t receiveData(uint8_t* data, size_t maxLength, size_t& receivedLength) override
+    {
+        receivedLength = 0;
+        if (!inbox.empty())
+        {
+            receivedLength = std::min(maxLength, inbox.front().size());
+            memcpy(data, inbox.front().data(), receivedLength);
+            inbox.pop_front();
+        }
+        return ERROR_SUCCESS;
+    }
+    sys_error_t disconnect() override
+    {
+        return ERROR_SUCCESS;
+    }
+};
+
+struct found_t
+{
+    std::string instance;
+    std::string host;
+    uint16_t    port;
+    std::string address;
+    uint32_t    ttlS;
+};
+
+void collect(const mdnsService_t& service, void* context)
+{
+    found_t found = {service.instance, service.host, service.port,
+                     std::to_string(service.address[0]) + "." + std::to_string(service.address[1]) + "." + std::to_string(service.address[2]) + "." + std::to_string(service.address[3]),
+                     service.ttlS};
+    static_cast<std::vector<found_t>*>(context)->push_back(found);
+}
+
+// Query with the given questions, names in wire format
+std::string query(const std::vector<std::pair<std::string, uint16_t>>& questions)
+{
+    std::string packet("\0\0\0\0\0\0\0\0\0\0\0\0", 12);
+    packet[5] = static_cast<char>(questions.size());
+    for (const auto& question : questions)
+    {
+        packet += question.first;
+        packet += std::string("\0", 1) + static_cast<char>(question.second) + std::string("\0\1", 2);
+    }
+    return packet;
+}
+
+const uint8_t lampAddress[4] = {192, 168, 1, 50};
+
+mdnsConfig_t lampConfig()
+{
+    mdnsConfig_t config = mdnsDefaultConfig();
+    config.hostname     = "lamp";
+    config.instance     = "Living Room Lamp";
+    return config;
+}
+// Let the announcements after setAddress() at 0 go out
+void announce(mdnsResponder& responder)
+{
+    for (uint32_t nowMs : {0u, 1000u, 3000u})
+    {
+        responder.poll(nowMs);
+    }
+}
+} // namespace
+
+TEST(MdnsResponderTest, BrowseResolvesAdvertisedService)
+{
+    bus_t         bus;
+    busTransport  lampLink(bus);
+    busTransport  toolLink(bus);
+    mdnsResponder lamp(lampLink, lampConfig());
+    mdnsResponder tool(toolLink, mdnsDefaultConfig());
+    ASSERT_EQ(lamp.addTxt("fw", "1.2.3"), ERROR_SUCCESS);
+    ASSERT_EQ(lamp.addTxt("mac", "24:0a:c4:00:11:22"), ERROR_SUCCESS);
+    ASSERT_EQ(lamp.addTxt("caps", "http,metrics"), ERROR_SUCCESS);
+    ASSERT_EQ(lamp.setAddress(lampAddress, 0), ERROR_SUCCESS);
+    announce(lamp);
+    toolLink.inbox.clear();
+    lampLink.inbox.clear();
+
+    std::vector<found_t> found;
+    ASSERT_EQ(tool.browse("_http._tcp", collect, &found), ERROR_SUCCESS);
+    lamp.poll(5000);
+    tool.poll(5000);
+    ASSERT_EQ(found.size(), 1u);
+    EXPECT_EQ(found[0].instance, "Living Room Lamp");
+    EXPECT_EQ(found[0].host, "lamp.local");
+    EXPECT_EQ(found[0].port, 80);
+    EXPECT_EQ(found[0].address, "192.168.1.50");
+    EXPECT_EQ(found[0].ttlS, 4500u);
+
+    // The TXT record travels with the answer
+    const std::string& answer = lampLink.sent.back();
+    EXPECT_NE(answer.find("\x08" "fw=1.2.3"), std::string::npos);
+    EXPECT_NE(answer.find("\x15mac=24:0a:c4:00:11:22"), std::string::npos);
+    EXPECT_NE(answer.find("\x11" "caps=http,metrics"), std::string::npos);
+}
+
+TEST(MdnsResponderTest, QueriesAreAnsweredFromTheCacheAndRateLimited)
+{
+    bus_t         bus;
+    busTransport  lampLink(bus);
+    busTransport  toolLink(bus);
+    mdnsResponder lamp(lampLink, lampConfig());
+    ASSERT_EQ(lamp.setAddress(lampAddress, 0), ERROR_SUCCESS);
+    announce(lamp);
+    lampLink.sent.clear();
+
+    // Upper case and a compression pointer to "local" of the first question
+    std::string host = std::string("\x04LAMP\x05local", 11) + std::string("\0", 1);
+    std::string packet = query({{host, 1}});
+    packet[5]          = 2;
+    packet += std::string("\x05_http\x04_tcp\xC0\x11", 13) + std::string("\0\x0C\0\x01", 4);
+    toolLink.sendData(reinterpret_cast<const uint8_t*>(packet.data()), packet.size());
+    lamp.poll(5000);
+    ASSERT_EQ(lampLink.sent.size(), 2u);
+
+    // The same packets again, byte for byte, only once per second
+    std::vector<std::string> first = lampLink.sent;
+    toolLink.sendData(reinterpret_cast<const uint8_t*>(packet.data()), packet.size());
+    lamp.poll(5500);
+    EXPECT_EQ(lampLink.sent.size(), 2u);
+    toolLink.sendData(reinterpret_cast<const uint8_t*>(packet.data()), packet.size());
+    lamp.poll(6000);
+    ASSERT_EQ(lampLink.sent.size(), 4u);
+    EXPECT_EQ(lampLink.sent[2], first[0]);
+    EXPECT_EQ(lampLink.sent[3], first[1]);
+
+    // Names of other hosts and unsupported types are not answered
+    std::string other = query({{std::string("\x05other\x05local", 12) + std::string("\0", 1), 1}, {host, 28}});
+    toolLink.sendData(reinterpret_cast<const uint8_t*>(other.data()), other.size());
+    toolLink.sendData(reinterpret_cast<const uint8_t*>("\0\0\0"), 3);
+    lamp.poll(9000);
+    EXPECT_EQ(lampLink.sent.size(), 4u);
+
+    mdnsStats_t stats = lamp.getStats();
+    EXPECT_EQ(stats.answered, 4u);
+    EXPECT_EQ(stats.rateLimited, 2u);
+    EXPECT_EQ(stats.malformed, 1u);
+}
+
+TEST(MdnsResponderTest, AnnouncementsBackOffAndGoodbyeClearsTtl)
+{
+    bus_t         bus;
+    busTransport  lampLink(bus);
+    busTransport  toolLink(bus);
+    mdnsResponder lamp(lampLink, lampConfig());
+    mdnsResponder tool(toolLink, mdnsDefaultConfig());
+    std::vector<found_t> found;
+    tool.browse("_http._tcp", collect, &found);
+    lampLink.inbox.clear();
+    EXPECT_EQ(lamp.getNextDelayMs(0), UINT32_MAX);
+
+    ASSERT_EQ(lamp.setAddress(lampAddress, 100), ERROR_SUCCESS);
+    EXPECT_EQ(lamp.getNextDelayMs(100), 0u);
+    lamp.poll(100);
+    EXPECT_EQ(lamp.getNextDelayMs(100), 1000u);
+    lamp.poll(1099);
+    lamp.poll(1100);
+    EXPECT_EQ(lamp.getNextDelayMs(1100), 2000u);
+    lamp.poll(3100);
+    EXPECT_EQ(lamp.getNextDelayMs(3100), UINT32_MAX);
+    EXPECT_EQ(lamp.getStats().announcements, 3u);
+
+    tool.poll(3100);
+    ASSERT_EQ(found.size(), 3u);
+    EXPECT_EQ(found[2].address, "192.168.1.50");
+
+    ASSERT_EQ(lamp.goodbye(), ERROR_SUCCESS);
+    tool.poll(3200);
+    ASSERT_EQ(found.size(), 4u);
+    EXPECT_EQ(found[3].instance, "Living Room Lamp");
+    EXPECT_EQ(found[3].ttlS, 0u);
+}
+
+TEST(MdnsResponderTest, TxtRecordIsBounded)
+{
+    bus_t         bus;
+    busTransport  link(bus);
+    mdnsResponder responder(link);
+    std::string   value(MDNS_TXT_SIZE, 'v');
+    EXPECT_EQ(responder.addTxt("big", value.c_str()), ERROR_BUFFER_OVERFLOW);
+    EXPECT_EQ(responder.addTxt("a=b", "c"), ERROR_INVALID_ARG);
+    EXPECT_EQ(responder.addTxt("debug", nullptr), ERROR_SUCCESS);
+    EXPECT_EQ(responder.goodbye(), ERROR_INVALID_CONFIG);
+}
+
+// Real sockets on a port next to 5353, so a running avahi does not answer
+TEST(MdnsResponderTest, HostMulticast)
+{
+    net_multicastHost lampLink(MDNS_GROUP, 15353);
+    net_multicastHost toolLink(MDNS_GROUP, 15353);
+    if (lampLink.connect() != ERROR_SUCCESS || toolLink.connect() != ERROR_SUCCESS)
+    {
+        GTEST_SKIP() << "no multicast route";
+    }
+    mdnsResponder lamp(lampLink, lampConfig());
+    mdnsResponder tool(toolLink, mdnsDefaultConfig());
+    ASSERT_EQ(lamp.setAddress(lampAddress, 0), ERROR_SUCCESS);
+
+    std::vector<found_t> found;
+    ASSERT_EQ(tool.browse("_http._tcp", collect, &found), ERROR_SUCCESS);
+    for (uint32_t nowMs = 0; nowMs < 2000 && found.empty(); nowMs += 10)
+    {
+        lampLink.waitReadable(10);
+        lamp.poll(nowMs);
+        tool.poll(nowMs);
+    }
+    if (found.empty())
+    {
+        GTEST_SKIP() << "multicast is not looped back";
+    }
+    EXPECT_EQ(found[0].instance, "Living Room Lamp");
+    EXPECT_EQ(found[0].address, "192.168.1.50");
+}
@@ -0,0 +1,99 @@
+#include "HAL/Platform/Linux/mem_ramDisk.hpp"
+#include "Library/Storage/kvStore.h"
+#include "gtest/gtest.h"
+
+TEST(MemFlashSimTest, WritesOnlyClearBits)
+{
+    mem_ramDisk memory(memDefaultGeometry(8 * 1024));
+    ASSERT_TRUE(memory.initialize());
+
+    uint8_t data = 0x0F;
+    ASSERT_TRUE(memory.writeData(10, &data, 1));
+    data = 0xF0;
+    ASSERT_TRUE(memory.writeData(10, &data, 1));
+
+    uint8_t read = 0xAA;
+    ASSERT_TRUE(memory.readData(10, &read, 1));
+    EXPECT_EQ(read, 0x00);
+    EXPECT_EQ(memory.getStats().bitConflicts, 1u);
+
+    ASSERT_TRUE(memory.eraseSector(100));
+    ASSERT_TRUE(memory.readData(10, &read, 1));
+    EXPECT_EQ(read, 0xFF);
+    EXPECT_EQ(memory.getSectorEraseCount(0), 1u);
+    EXPECT_EQ(memory.getSectorEraseCount(1), 0u);
+}
+
+TEST(MemFlashSimTest, CountsPagesAndSimulatedTime)
+{
+    memTiming_t timing = {1, 100, 1000};
+    mem_ramDisk memory(memDefaultGeometry(8 * 1024), timing);
+    ASSERT_TRUE(memory.initialize());
+
+    uint8_t data[16] = {};
+    ASSERT_TRUE(memory.writeData(250, data, sizeof(data))); // crosses the first page boundary
+    ASSERT_TRUE(memory.readData(0, data, sizeof(data)));
+    ASSERT_TRUE(memory.eraseSector(0));
+
+    memStats_t stats = memory.getStats();
+    EXPECT_EQ(stats.pagePrograms, 2u);
+    EXPECT_EQ(stats.bytesWritten, 16u);
+    EXPECT_EQ(stats.bytesRead, 16u);
+    EXPECT_EQ(stats.simulatedNs, 2u * 100 + 16u * 1 + 1000u);
+    EXPECT_FALSE(memory.readData(8 * 1024 - 4, data, sizeof(data)));
+}
+
+TEST(MemFlashSimTest, InjectedFaults)
+{
+    mem_ramDisk memory(memDefaultGeometry(8 * 1024));
+    ASSERT_TRUE(memory.initialize());
+
+    uint8_t data[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    memory.injectWriteFault(1, 3);
+    EXPECT_TRUE(memory.writeData(0, data, sizeof(data)));
+    EXPECT_FALSE(memory.writeData(16, data, sizeof(data)));
+
+    uint8_t read[8];
+    ASSERT_TRUE(memory.readData(16, read, sizeof(read)));
+    EXPECT_EQ(read[2], 3);
+    EXPECT_EQ(read[3], 0xFF);
+
+    memory.injectEraseFault(0);
+    EXPECT_FALSE(memory.eraseSector(0));
+    EXPECT_TRUE(memory.eraseSector(0));
+
+    memory.injectReadBitFlip(1, 0x80);
+    ASSERT_TRUE(memory.readData(0, read, 2));
+    EXPECT_EQ(read[1], 0xFF ^ 0x80);
+    EXPECT_EQ(memory.getStats().injectedFaults, 2u);
+}
+
+TEST(MemFlashSimTest, KvStoreSurvivesTornWrite)
+{
+    memGeometry_t geometry = memDefaultGeometry(4 * 1024);
+    geometry.sectorSize    = 1024;
+    mem_ramDisk memory(geometry);
+
+    {
+        kvStore store(memory);
+        ASSERT_EQ(store.mount(), ERROR_SUCCESS);
+        uint32_t value = 1;
+        ASSERT_EQ(store.put("key", &value, sizeof(value)), ERROR_SUCCESS);
+
+        // Power loss after the record header of the next put, the value never makes it
+        value = 2;
+        memory.injectWriteFault(1, 0);
+        EXPECT_EQ(store.put("key", &value, sizeof(value)), ERROR_WRITE_FAILED);
+    }
+
+    kvStore store(memory);
+    ASSERT_EQ(store.mount(), ERROR_SUCCESS);
+    uint32_t value  = 0;
+    size_t   length = 0;
+    ASSERT_EQ(store.get("key", &value, sizeof(value), length), ERROR_SUCCESS);
+    EXPECT_EQ(value, 1u);
+
+    value = 3;
+    ASSERT_EQ(store.put("key", &value, sizeof(value)), ERROR_SUCCESS);
+    EXPECT_EQ(memory.getStats().bitConflicts, 0u);
+}
@@ -0,0 +1,123 @@
+#include "System/memoryPool.h"
+#include "gtest/gtest.h"
+
+#include <list>
+#include <thread>
+
+TEST(MemoryPoolTest, AllocateReleaseAndStats)
+{
+    staticMemoryPool<24, 4> pool;
+    EXPECT_EQ(pool.getBlockSize(), 24u);
+
+    void* blocks[4];
+    for (void*& block : blocks)
+    {
+        block = pool.allocate();
+        ASSERT_NE(block, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(block) % memoryPool::alignment, 0u);
+        EXPECT_TRUE(pool.owns(block));
+    }
+    EXPECT_EQ(pool.allocate(), nullptr);
+
+    pool.release(blocks[2]);
+    EXPECT_EQ(pool.allocateFromISR(), blocks[2]);
+    for (void* block : blocks)
+    {
+        pool.release(block);
+    }
+
+    memoryPoolStats_t stats = pool.getStats();
+    EXPECT_EQ(stats.inUse, 0u);
+    EXPECT_EQ(stats.highWater, 4u);
+    EXPECT_EQ(stats.allocations, 5u);
+    EXPECT_EQ(stats.failures, 1u);
+
+    int local = 0;
+    EXPECT_FALSE(pool.owns(&local));
+}
+
+TEST(MemoryPoolTest, SizeClassesAndFallback)
+{
+    staticMemoryPool<16, 1> small;
+    staticMemoryPool<64, 1> large;
+    memoryPool* const       list[] = {&small, &large};
+    memoryPools             pools(list, 2);
+
+    void* a = pools.allocate(10);
+    void* b = pools.allocate(10); // small class is empty, served by the larger one
+    void* c = pools.allocate(10); // both empty, heap
+    void* d = pools.allocate(1000);
+    EXPECT_TRUE(small.owns(a));
+    EXPECT_TRUE(large.owns(b));
+    EXPECT_FALSE(small.owns(c) || large.owns(c));
+    EXPECT_EQ(pools.getHeapFallbacks(), 2u);
+    EXPECT_EQ(pools.allocateFromISR(10), nullptr);
+
+    pools.release(a);
+    pools.release(b);
+    pools.release(c);
+    pools.release(d);
+    EXPECT_EQ(pools.getPoolStats(0).inUse, 0u);
+    EXPECT_EQ(pools.getPoolStats(1).inUse, 0u);
+    // Requests served by a larger class or the heap are not failures, only the ISR request nothing could serve
+    EXPECT_EQ(pools.getPoolStats(0).failures, 0u);
+    EXPECT_EQ(pools.getPoolStats(1).failures, 0u);
+    EXPECT_EQ(pools.getFailures(), 1u);
+}
+
+TEST(MemoryPoolTest, AllocatorRejectsImpossibleRequests)
+{
+    poolAllocator<uint64_t> allocator;
+    EXPECT_THROW(allocator.allocate(SIZE_MAX / 4), std::bad_alloc); // count * 8 overflows
+    EXPECT_THROW(allocator.allocate(SIZE_MAX / 16), std::bad_alloc); // no heap that large
+    EXPECT_GE(systemPools().getFailures(), 1u);
+
+    uint64_t* values = allocator.allocate(4);
+    ASSERT_NE(values, nullptr);
+    allocator.deallocate(values, 4);
+}
+
+TEST(MemoryPoolTest, StlContainersUseSystemPools)
+{
+    uint32_t before = systemPools().getPoolStats(0).allocations;
+    {
+        std::list<int, poolAllocator<int>> values;
+        for (int i = 0; i < 10; i++)
+        {
+            values.push_back(i);
+        }
+        poolVector<uint16_t> vector(20, 7);
+        poolString           text("pooled string that does not fit the small buffer");
+        EXPECT_EQ(values.size(), 10u);
+        EXPECT_EQ(vector[19], 7u);
+        EXPECT_EQ(text.substr(0, 6), "pooled");
+    }
+    EXPECT_GE(systemPools().getPoolStats(0).allocations, before + 10);
+    for (size_t i = 0; i < systemPools().getPoolCount(); i++)
+    {
+        EXPECT_EQ(systemPools().getPoolStats(i).inUse, 0u);
+    }
+}
+
+TEST(MemoryPoolTest, ConcurrentUse)
+{
+    staticMemoryPool<32, 16> pool;
+    auto                     worker = [&pool]()
+    {
+        for (int i = 0; i < 20000; i++)
+        {
+            void* block = pool.allocate();
+            if (block != nullptr)
+            {
+                pool.release(block);
+            }
+        }
+    };
+    std::thread first(worker);
+    std::thread second(worker);
+    first.join();
+    second.join();
+
+    EXPECT_EQ(pool.getStats().inUse, 0u);
+    EXPECT_LE(pool.getStats().highWater, 2u);
+}
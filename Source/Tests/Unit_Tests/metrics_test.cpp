@@ -0,0 +1,120 @@
+#include "System/metrics.h"
+#include "gtest/gtest.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+bool appendWriter(void* context, const char* data, size_t length)
+{
+    static_cast<std::string*>(context)->append(data, length);
+    return true;
+}
+
+typedef struct
+{
+    size_t lines;
+    size_t limit;
+} limitedWriter_t;
+
+bool limitedWriter(void* context, const char* data, size_t length)
+{
+    limitedWriter_t& writer = *static_cast<limitedWriter_t*>(context);
+    return ++writer.lines < writer.limit;
+}
+} // namespace
+
+TEST(MetricsTest, Exposition)
+{
+    metricsRegistry    registry;
+    metricCounter      requests("http_requests_total", "HTTP requests handled", "uri=\"/welcome\"", registry);
+    metricCounter      connects("http_requests_total", "HTTP requests handled", "uri=\"/connect\"", registry);
+    metricGauge        queue("button_queue_depth", "GPIO events waiting", nullptr, registry);
+    const uint32_t     bounds[] = {100, 500, 1000};
+    metricHistogram<3> press("button_press_duration_ms", "Button press durations", bounds, nullptr, registry);
+
+    requests.add(3);
+    connects.inc();
+    queue.set(4);
+    queue.dec();
+    press.observe(50);
+    press.observe(100); // bounds are inclusive
+    press.observe(700);
+    press.observe(5000);
+    EXPECT_EQ(registry.getCount(), 4u);
+    EXPECT_EQ(press.getCount(), 4u);
+    EXPECT_EQ(press.getBucket(0), 2u);
+    EXPECT_EQ(press.getBucket(3), 1u);
+
+    std::string text;
+    ASSERT_TRUE(registry.render(appendWriter, &text));
+
+    // one header per family, both members under it
+    size_t help = text.find("# HELP http_requests_total HTTP requests handled\n# TYPE http_requests_total counter\n");
+    ASSERT_NE(help, std::string::npos);
+    EXPECT_EQ(text.find("# HELP http_requests_total", help + 1), std::string::npos);
+    EXPECT_NE(text.find("http_requests_total{uri=\"/welcome\"} 3\n"), std::string::npos);
+    EXPECT_NE(text.find("http_requests_total{uri=\"/connect\"} 1\n"), std::string::npos);
+
+    EXPECT_NE(text.find("# TYPE button_queue_depth gauge\nbutton_queue_depth 3\n"), std::string::npos);
+
+    EXPECT_NE(text.find("# TYPE button_press_duration_ms histogram\n"
+                        "button_press_duration_ms_bucket{le=\"100\"} 2\n"
+                        "button_press_duration_ms_bucket{le=\"500\"} 2\n"
+                        "button_press_duration_ms_bucket{le=\"1000\"} 3\n"
+                        "button_press_duration_ms_bucket{le=\"+Inf\"} 4\n"
+                        "button_press_duration_ms_sum 5850\n"
+                        "button_press_duration_ms_count 4\n"),
+              std::string::npos);
+}
+
+TEST(MetricsTest, RegistrationAndWriterFailure)
+{
+    metricsRegistry registry;
+    {
+        metricCounter scoped("scoped_total", "Removed when out of scope", nullptr, registry);
+        EXPECT_EQ(registry.find("scoped_total"), &scoped);
+    }
+    EXPECT_EQ(registry.find("scoped_total"), nullptr);
+    EXPECT_EQ(registry.getCount(), 0u);
+
+    metricCounter first("first_total", "First", nullptr, registry);
+    metricCounter second("second_total", "Second", nullptr, registry);
+
+    // rendering stops at the first failed write
+    limitedWriter_t writer = {0, 2};
+    EXPECT_FALSE(registry.render(limitedWriter, &writer));
+    EXPECT_EQ(writer.lines, 2u);
+
+    // the default registry is shared by all static metrics
+    EXPECT_EQ(&metrics(), &metrics());
+}
+
+TEST(MetricsTest, ConcurrentUpdates)
+{
+    metricsRegistry    registry;
+    metricCounter      events("events_total", "Events", nullptr, registry);
+    const uint32_t     bounds[] = {10};
+    metricHistogram<1> values("values", "Values", bounds, nullptr, registry);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&]() {
+            for (uint32_t i = 0; i < 100000; i++)
+            {
+                events.inc();
+                values.observe(i % 20);
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(events.get(), 400000u);
+    EXPECT_EQ(values.getCount(), 400000u);
+    EXPECT_EQ(values.getBucket(0), 4u * 55000u);
+}
@@ -0,0 +1,456 @@
+#include "HAL/Platform/Linux/mem_ramDisk.hpp"
+#include "HAL/Platform/Linux/net_tcpHost.hpp"
+#include "Library/Protocol/mqttClient.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+// PUBLISH packet seen by the broker
+struct publishPacket_t
+{
+    std::string topic;
+    std::string payload;
+    uint16_t    packetId;
+    uint8_t     qos;
+    bool        dup;
+};
+
+// In-memory broker: answers CONNECT, SUBSCRIBE and PINGREQ, acknowledges QoS 1 publishes when autoAck is set
+class fakeBroker : public IHAL_COM
+{
+public:
+    bool                         online         = true;
+    bool                         connected      = false;
+    bool                         sessionPresent = false;
+    bool                         autoAck        = true;
+    bool                         answerPings    = true;
+    size_t                       connects       = 0;
+    size_t                       pings          = 0;
+    std::vector<publishPacket_t> published;
+    std::vector<std::string>     subscribed;
+    std::vector<uint16_t>        acked; // PUBACKs from the client
+    std::deque<uint8_t>          toClient;
+
+    sys_error_t connect() override
+    {
+        if (!online)
+        {
+            return ERROR_CONNECTION_FAILED;
+        }
+        connected = true;
+        toClient.clear();
+        return ERROR_SUCCESS;
+    }
+
+    sys_error_t sendData(const uint8_t* data, size_t length) override
+    {
+        if (!connected)
+        {
+            return ERROR_CONNECTION_CLOSED;
+        }
+        // One packet per call, remaining length below 16384
+        size_t         header = (data[1] & 0x80) ? 3 : 2;
+        const uint8_t* body   = data + header;
+        switch (data[0] & 0xF0)
+        {
+            case 0x10:
+                connects++;
+                reply({0x20, 0x02, static_cast<uint8_t>(sessionPresent ? 1 : 0), 0x00});
+                break;
+            case 0x30:
+            {
+                publishPacket_t packet;
+                size_t          topicLength = (body[0] << 8) | body[1];
+                packet.qos                  = (data[0] >> 1) & 0x03;
+                packet.dup                  = (data[0] & 0x08) != 0;
+                packet.topic.assign(reinterpret_cast<const char*>(body + 2), topicLength);
+                size_t position = 2 + topicLength;
+                packet.packetId = 0;
+                if (packet.qos > 0)
+                {
+                    packet.packetId = static_cast<uint16_t>((body[position] << 8) | body[position + 1]);
+                    position += 2;
+                }
+                packet.payload.assign(reinterpret_cast<const char*>(body + position), length - header - position);
+                published.push_back(packet);
+                if (packet.qos > 0 && autoAck)
+                {
+                    ack(packet.packetId);
+                }
+                break;
+            }
+            case 0x40:
+                acked.push_back(static_cast<uint16_t>((body[0] << 8) | body[1]));
+                break;
+            case 0x80:
+                subscribed.push_back(std::string(reinterpret_cast<const char*>(body + 4), (body[2] << 8) | body[3]));
+                reply({0x90, 0x03, body[0], body[1], 0x01});
+                break;
+            case 0xC0:
+                pings++;
+                if (answerPings)
+                {
+                    reply({0xD0, 0x00});
+                }
+                break;
+        }
+        return ERROR_SUCCESS;
+    }
+
+    sys_error_t receiveData(uint8_t* data, size_t maxLength, size_t& receivedLength) override
+    {
+        receivedLength = 0;
+        if (!connected)
+        {
+            return ERROR_CONNECTION_CLOSED;
+        }
+        while (receivedLength < maxLength && !toClient.empty())
+        {
+            data[receivedLength++] = toClient.front();
+            toClient.pop_front();
+        }
+        return ERROR_SUCCESS;
+    }
+
+    sys_error_t disconnect() override
+    {
+        connected = false;
+        return ERROR_SUCCESS;
+    }
+
+    void reply(const std::vector<uint8_t>& packet)
+    {
+        toClient.insert(toClient.end(), packet.begin(), packet.end());
+    }
+
+    void ack(uint16_t packetId)
+    {
+        reply({0x40, 0x02, static_cast<uint8_t>(packetId >> 8), static_cast<uint8_t>(packetId)});
+    }
+
+    void deliver(const std::string& topic, const std::string& payload, uint16_t packetId)
+    {
+        std::vector<uint8_t> packet = {0x32, static_cast<uint8_t>(2 + topic.size() + 2 + payload.size()), 0, static_cast<uint8_t>(topic.size())};
+        packet.insert(packet.end(), topic.begin(), topic.end());
+        packet.push_back(static_cast<uint8_t>(packetId >> 8));
+        packet.push_back(static_cast<uint8_t>(packetId));
+        packet.insert(packet.end(), payload.begin(), payload.end());
+        reply(packet);
+    }
+};
+
+mqttConfig_t testConfig()
+{
+    mqttConfig_t config = mqttDefaultConfig();
+    config.clientId     = "unit";
+    config.keepAliveS   = 0;
+    return config;
+}
+} // namespace
+
+TEST(MqttClientTest, Qos1PublishesArePipelined)
+{
+    fakeBroker broker;
+    broker.autoAck = false;
+    mqttClient client(broker, testConfig());
+
+    for (int i = 0; i < MQTT_MAX_INFLIGHT + 4; i++)
+    {
+        std::string payload = std::to_string(i);
+        ASSERT_EQ(client.publish("dev/button/0", payload.data(), payload.size(), 1), ERROR_SUCCESS);
+    }
+    // The fake broker answers at once, CONNACK is handled by the same poll
+    client.poll(0);
+    ASSERT_EQ(client.getState(), MQTT_CONNECTED);
+
+    // The window is full without a single PUBACK
+    ASSERT_EQ(broker.published.size(), static_cast<size_t>(MQTT_MAX_INFLIGHT));
+    client.poll(20);
+    EXPECT_EQ(broker.published.size(), static_cast<size_t>(MQTT_MAX_INFLIGHT));
+
+    // Acknowledging the first ones opens the window for the rest
+    for (int i = 0; i < 4; i++)
+    {
+        broker.ack(broker.published[i].packetId);
+    }
+    client.poll(30);
+    ASSERT_EQ(broker.published.size(), static_cast<size_t>(MQTT_MAX_INFLIGHT + 4));
+    for (size_t i = 0; i < broker.published.size(); i++)
+    {
+        EXPECT_EQ(broker.published[i].payload, std::to_string(i));
+        EXPECT_EQ(broker.published[i].qos, 1);
+        EXPECT_FALSE(broker.published[i].dup);
+    }
+    EXPECT_FALSE(client.isIdle());
+
+    for (size_t i = 4; i < broker.published.size(); i++)
+    {
+        broker.ack(broker.published[i].packetId);
+    }
+    client.poll(40);
+    EXPECT_TRUE(client.isIdle());
+
+    mqttStats_t stats = client.getStats();
+    EXPECT_EQ(stats.published, static_cast<uint32_t>(MQTT_MAX_INFLIGHT + 4));
+    EXPECT_EQ(stats.acknowledged, static_cast<uint32_t>(MQTT_MAX_INFLIGHT + 4));
+    EXPECT_EQ(stats.connects, 1u);
+}
+
+TEST(MqttClientTest, OfflineQueueIsResentAfterReconnect)
+{
+    fakeBroker broker;
+    broker.online  = false;
+    broker.autoAck = false;
+    mqttClient client(broker, testConfig());
+    ASSERT_EQ(client.subscribe("dev/led/+/set"), ERROR_SUCCESS);
+
+    client.publish("dev/status", "boot", 4, 0);
+    client.publish("dev/button/0", "120", 3, 1);
+    client.publish("dev/button/1", "80", 2, 1);
+
+    // Reconnect attempts back off: 1 s, then 2 s
+    client.poll(0);
+    client.poll(999);
+    client.poll(1000);
+    client.poll(2999);
+    EXPECT_EQ(client.getStats().connectFailures, 2u);
+    broker.online = true;
+    client.poll(3000);
+    client.poll(3001);
+    ASSERT_EQ(client.getState(), MQTT_CONNECTED);
+    ASSERT_EQ(broker.published.size(), 3u);
+    ASSERT_EQ(broker.subscribed.size(), 1u);
+    EXPECT_EQ(broker.subscribed[0], "dev/led/+/set");
+    uint16_t firstId = broker.published[1].packetId;
+    broker.ack(firstId);
+    client.poll(3002);
+
+    // The connection breaks before the second PUBACK, the session is resumed
+    broker.disconnect();
+    broker.sessionPresent = true;
+    client.poll(3010);
+    EXPECT_EQ(client.getState(), MQTT_DISCONNECTED);
+    client.poll(4010);
+    client.poll(4011);
+    ASSERT_EQ(client.getState(), MQTT_CONNECTED);
+    ASSERT_EQ(broker.published.size(), 4u);
+    EXPECT_EQ(broker.published[3].topic, "dev/button/1");
+    EXPECT_EQ(broker.published[3].packetId, broker.published[2].packetId);
+    EXPECT_TRUE(broker.published[3].dup);
+    EXPECT_EQ(broker.subscribed.size(), 1u);
+
+    broker.ack(broker.published[3].packetId);
+    client.poll(4012);
+    EXPECT_TRUE(client.isIdle());
+    mqttStats_t stats = client.getStats();
+    EXPECT_EQ(stats.resent, 1u);
+    EXPECT_EQ(stats.sessionResumes, 1u);
+}
+
+TEST(MqttClientTest, IncomingPublishIsDeliveredAndAcknowledged)
+{
+    fakeBroker               broker;
+    mqttClient               client(broker, testConfig());
+    std::vector<std::string> messages;
+    client.setMessageHandler(
+        [](const char* topic, size_t topicLength, const uint8_t* payload, size_t length, void* context)
+        {
+            auto& list = *static_cast<std::vector<std::string>*>(context);
+            list.push_back(std::string(topic, topicLength) + "=" + std::string(reinterpret_cast<const char*>(payload), length));
+        },
+        &messages);
+
+    client.poll(0);
+    client.poll(1);
+    ASSERT_EQ(client.getState(), MQTT_CONNECTED);
+    ASSERT_EQ(client.subscribe("dev/led/+/set"), ERROR_SUCCESS);
+    EXPECT_EQ(broker.subscribed.size(), 1u);
+
+    broker.deliver("dev/led/2/set", "blink_fast", 77);
+    broker.deliver("dev/led/0/set", "off", 78);
+    client.poll(2);
+    ASSERT_EQ(messages.size(), 2u);
+    EXPECT_EQ(messages[0], "dev/led/2/set=blink_fast");
+    EXPECT_EQ(messages[1], "dev/led/0/set=off");
+    EXPECT_EQ(broker.acked, (std::vector<uint16_t>{77, 78}));
+}
+
+TEST(MqttClientTest, FullQueueSpillsToMemoryInOrder)
+{
+    mem_ramDisk   flash(memDefaultGeometry(64 * 1024));
+    fakeBroker    broker;
+    broker.online = false;
+    mqttClient client(broker, testConfig());
+    ASSERT_EQ(client.setSpill(&flash, 8192, 16384), ERROR_SUCCESS);
+
+    // Three times what the queue holds
+    std::string payload(200, 'p');
+    size_t      count = 3 * MQTT_QUEUE_SIZE / 200;
+    for (size_t i = 0; i < count; i++)
+    {
+        std::string message = std::to_string(i) + payload;
+        ASSERT_EQ(client.publish("dev/log", message.data(), message.size(), 1), ERROR_SUCCESS);
+    }
+    EXPECT_GT(client.getStats().spilled, count / 2);
+
+    broker.online = true;
+    for (uint32_t now = 0; now < 100 && !client.isIdle(); now++)
+    {
+        client.poll(now);
+    }
+    EXPECT_TRUE(client.isIdle());
+    ASSERT_EQ(broker.published.size(), count);
+    for (size_t i = 0; i < count; i++)
+    {
+        EXPECT_EQ(broker.published[i].payload, std::to_string(i) + payload);
+    }
+
+    // Drained: the area was erased and takes messages again
+    EXPECT_GT(flash.getStats().eraseOps, 4u);
+    EXPECT_EQ(client.getStats().dropped, 0u);
+}
+
+TEST(MqttClientTest, KeepAliveDetectsDeadBroker)
+{
+    fakeBroker   broker;
+    mqttConfig_t config = testConfig();
+    config.keepAliveS   = 1;
+    mqttClient client(broker, config);
+    client.poll(0);
+    client.poll(1);
+    ASSERT_EQ(client.getState(), MQTT_CONNECTED);
+
+    client.poll(1001);
+    EXPECT_EQ(broker.pings, 1u);
+    client.poll(1002);
+    EXPECT_EQ(client.getState(), MQTT_CONNECTED);
+
+    broker.answerPings = false;
+    client.poll(2002);
+    EXPECT_EQ(broker.pings, 2u);
+    client.poll(3002);
+    EXPECT_EQ(client.getState(), MQTT_DISCONNECTED);
+}
+
+TEST(MqttClientTest, NextDelayFollowsRetryAndKeepAlive)
+{
+    fakeBroker   broker;
+    broker.online       = false;
+    mqttConfig_t config = testConfig();
+    config.keepAliveS   = 1;
+    mqttClient client(broker, config);
+
+    // Offline: nothing to do until the reconnect is due
+    client.poll(0);
+    ASSERT_EQ(client.getState(), MQTT_DISCONNECTED);
+    uint32_t retryMs = client.getNextDelayMs(0);
+    EXPECT_GT(retryMs, 0u);
+    EXPECT_EQ(client.getNextDelayMs(retryMs / 2), retryMs - retryMs / 2);
+    EXPECT_EQ(client.getNextDelayMs(retryMs), 0u);
+
+    broker.online = true;
+    client.poll(retryMs);
+    client.poll(retryMs + 1);
+    ASSERT_EQ(client.getState(), MQTT_CONNECTED);
+
+    // Connected and idle: the next ping, then the ping response timeout
+    uint32_t sentMs = retryMs;
+    EXPECT_EQ(client.getNextDelayMs(sentMs + 400), 600u);
+    broker.answerPings = false;
+    client.poll(sentMs + 1000);
+    ASSERT_EQ(broker.pings, 1u);
+    client.poll(sentMs + 1001);
+    EXPECT_EQ(client.getNextDelayMs(sentMs + 1500), 500u);
+    EXPECT_EQ(client.getNextDelayMs(sentMs + 2000), 0u);
+
+    // A message published between two polls is sent at once
+    ASSERT_EQ(client.publish("dev/button/0", "1", 1, 0), ERROR_SUCCESS);
+    EXPECT_EQ(client.getNextDelayMs(sentMs + 1500), 0u);
+}
+
+TEST(MqttClientTest, NextDelayWithoutKeepAlive)
+{
+    fakeBroker broker;
+    mqttClient client(broker, testConfig());
+    client.poll(0);
+    client.poll(1);
+    ASSERT_EQ(client.getState(), MQTT_CONNECTED);
+    EXPECT_EQ(client.getNextDelayMs(10000), UINT32_MAX);
+}
+
+// Needs a broker on 127.0.0.1:1883, e.g. "mosquitto -p 1883"
+TEST(MqttClientTest, LocalBroker)
+{
+    net_tcpHost probe("127.0.0.1", 1883);
+    if (probe.connect() != ERROR_SUCCESS)
+    {
+        GTEST_SKIP() << "no MQTT broker on 127.0.0.1:1883";
+    }
+    probe.disconnect();
+
+    std::string  prefix          = "unit/" + std::to_string(getpid());
+    std::string  subscriberId    = prefix + "/sub";
+    std::string  publisherId     = prefix + "/pub";
+    mqttConfig_t subscriberConfig = testConfig();
+    mqttConfig_t publisherConfig  = testConfig();
+    subscriberConfig.clientId     = subscriberId.c_str();
+    publisherConfig.clientId      = publisherId.c_str();
+
+    net_tcpHost              subscriberTransport("127.0.0.1", 1883);
+    net_tcpHost              publisherTransport("127.0.0.1", 1883);
+    mqttClient               subscriber(subscriberTransport, subscriberConfig);
+    mqttClient               publisher(publisherTransport, publisherConfig);
+    std::vector<std::string> received;
+    subscriber.setMessageHandler([](const char* topic, size_t topicLength, const uint8_t* payload, size_t length, void* context)
+                                 { static_cast<std::vector<std::string>*>(context)->push_back(std::string(reinterpret_cast<const char*>(payload), length)); },
+                                 &received);
+    std::string filter = prefix + "/#";
+    ASSERT_EQ(subscriber.subscribe(filter.c_str()), ERROR_SUCCESS);
+
+    uint32_t nowMs    = 0;
+    auto     pollBoth = [&](uint32_t rounds, std::function<bool()> done)
+    {
+        for (uint32_t i = 0; i < rounds && !done(); i++, nowMs += 10)
+        {
+            subscriber.poll(nowMs);
+            publisher.poll(nowMs);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    };
+    pollBoth(200, [&]() { return subscriber.getState() == MQTT_CONNECTED && publisher.getState() == MQTT_CONNECTED; });
+    ASSERT_EQ(subscriber.getState(), MQTT_CONNECTED);
+
+    // Let the SUBACK arrive before publishing
+    pollBoth(20, []() { return false; });
+    std::string topic = prefix + "/button/0";
+    for (int i = 0; i < 40; i++)
+    {
+        std::string payload = std::to_string(i);
+        ASSERT_EQ(publisher.publish(topic.c_str(), payload.data(), payload.size(), 1), ERROR_SUCCESS);
+    }
+    pollBoth(300, [&]() { return received.size() >= 40 && publisher.isIdle(); });
+    ASSERT_EQ(received.size(), 40u);
+    for (int i = 0; i < 40; i++)
+    {
+        EXPECT_EQ(received[i], std::to_string(i));
+    }
+    EXPECT_TRUE(publisher.isIdle());
+
+    // The broker kept the session of the subscriber, messages published meanwhile are delivered after reconnecting
+    subscriberTransport.disconnect();
+    pollBoth(1, []() { return false; });
+    EXPECT_EQ(subscriber.getState(), MQTT_DISCONNECTED);
+    publisher.publish(topic.c_str(), "offline", 7, 1);
+    pollBoth(300, [&]() { return received.size() >= 41; });
+    ASSERT_EQ(received.size(), 41u);
+    EXPECT_EQ(received[40], "offline");
+    EXPECT_EQ(subscriber.getStats().sessionResumes, 1u);
+}
@@ -0,0 +1,101 @@
+#include "HAL/Platform/Linux/net_httpHost.hpp"
+#include "HAL/Platform/Linux/net_httpLoad.hpp"
+#include "gtest/gtest.h"
+
+class HttpLoadTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _server.addUriHandler("/welcome", "GET", [](const httpHostRequest_t& request, httpHostResponse_t& response) { response.body = "<html>welcome</html>"; });
+        _server.addUriHandler("/connect", "POST",
+                              [](const httpHostRequest_t& request, httpHostResponse_t& response)
+                              {
+                                  std::string ssid, password;
+                                  if (httpHostQueryValue(request.body, "ssid", ssid) && httpHostQueryValue(request.body, "password", password))
+                                  {
+                                      response.body = "Connected";
+                                  }
+                                  else
+                                  {
+                                      response.status = 500;
+                                  }
+                              });
+        ASSERT_EQ(_server.start(), ERROR_SUCCESS);
+    }
+
+    void TearDown() override
+    {
+        _server.stop();
+    }
+
+    httpLoadConfig_t config(const char* method, const char* path)
+    {
+        httpLoadConfig_t config = httpLoadDefaultConfig();
+        config.port             = _server.getPort();
+        config.method           = method;
+        config.path             = path;
+        config.connections      = 4;
+        config.requests         = 200;
+        return config;
+    }
+
+    net_httpHost _server;
+};
+
+TEST(HttpHostTest, QueryValue)
+{
+    std::string value;
+    EXPECT_TRUE(httpHostQueryValue("ssid=home&password=secret", "password", value));
+    EXPECT_EQ(value, "secret");
+    EXPECT_TRUE(httpHostQueryValue("ssid=&x=1", "ssid", value));
+    EXPECT_EQ(value, "");
+    EXPECT_FALSE(httpHostQueryValue("myssid=home", "ssid", value));
+    EXPECT_FALSE(httpHostQueryValue("", "ssid", value));
+}
+
+TEST_F(HttpLoadTest, KeepAliveReusesConnections)
+{
+    net_httpLoad load;
+    ASSERT_EQ(load.run(config("GET", "/welcome")), ERROR_SUCCESS);
+
+    httpLoadResult_t result = load.getResult();
+    EXPECT_EQ(result.completed, 200u);
+    EXPECT_EQ(result.errors, 0u);
+    EXPECT_EQ(result.non2xx, 0u);
+    EXPECT_EQ(result.connects, 4u);
+    EXPECT_GT(result.requestsPerSecond, 0.0);
+    EXPECT_EQ(load.getHistogram().getCount(), 200u);
+    EXPECT_EQ(_server.getStats().requests, 200u);
+}
+
+TEST_F(HttpLoadTest, ConnectionPerRequest)
+{
+    httpLoadConfig_t load = config("POST", "/connect");
+    load.body             = "ssid=home&password=secret";
+    load.keepAlive        = false;
+
+    net_httpLoad generator;
+    ASSERT_EQ(generator.run(load), ERROR_SUCCESS);
+
+    httpLoadResult_t result = generator.getResult();
+    EXPECT_EQ(result.completed, 200u);
+    EXPECT_EQ(result.errors, 0u);
+    EXPECT_EQ(result.non2xx, 0u);
+    EXPECT_EQ(result.connects, 200u);
+    EXPECT_EQ(_server.getStats().connections, 200u);
+}
+
+TEST_F(HttpLoadTest, StatusAndConnectFailuresAreCounted)
+{
+    net_httpLoad load;
+    ASSERT_EQ(load.run(config("GET", "/missing")), ERROR_SUCCESS);
+    EXPECT_EQ(load.getResult().non2xx, 200u);
+
+    httpLoadConfig_t refused = config("GET", "/welcome");
+    refused.requests         = 3;
+    _server.stop();
+    ASSERT_EQ(load.run(refused), ERROR_SUCCESS);
+    EXPECT_EQ(load.getResult().errors, 3u);
+    EXPECT_EQ(load.getResult().completed, 0u);
+}
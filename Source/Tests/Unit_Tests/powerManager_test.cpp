@@ -0,0 +1,142 @@
+#include "Library/Power/powerManager.h"
+#include "gtest/gtest.h"
+
+#include <string.h>
+
+namespace
+{
+const uint64_t msUs   = 1000;
+const uint64_t hourUs = 3600 * 1000 * msUs;
+
+// Blinks with a period until a time, then keeps its level like an LED set to LED_ON
+class blinkClient : public IPowerClient
+{
+private:
+    uint64_t _periodUs;
+    uint64_t _untilUs;
+    uint64_t _next;
+
+public:
+    blinkClient(uint64_t periodUs, uint64_t untilUs) : _periodUs(periodUs), _untilUs(untilUs), _next(periodUs) {}
+
+    uint64_t getNextDeadline(uint64_t nowUs) override
+    {
+        return (_next <= _untilUs) ? _next : POWER_NO_DEADLINE;
+    }
+
+    void wake(uint64_t nowUs)
+    {
+        countWakeup();
+        _next = nowUs + _periodUs;
+    }
+};
+
+// Sleeps until the earliest deadline or the next event, wakes the owner up
+void runUntil(powerManager& manager, blinkClient** clients, uint64_t& now, uint64_t endUs, uint64_t eventUs, IPowerClient* eventClient)
+{
+    while (now < endUs)
+    {
+        size_t   owner    = 0;
+        uint64_t deadline = manager.getNextDeadline(now, &owner);
+        if (eventClient != nullptr && eventUs < deadline && eventUs >= now)
+        {
+            now = eventUs;
+            eventClient->countWakeup();
+            eventClient = nullptr;
+            continue;
+        }
+        if (deadline >= endUs)
+        {
+            now = endUs;
+            break;
+        }
+        now = deadline;
+        clients[owner]->wake(now);
+    }
+}
+} // namespace
+
+TEST(PowerManagerTest, EarliestDeadline)
+{
+    powerManager manager;
+    blinkClient  slow(1000 * msUs, hourUs);
+    blinkClient  fast(100 * msUs, hourUs);
+    IPowerClient events;
+
+    EXPECT_EQ(manager.getNextDeadline(0), POWER_NO_DEADLINE);
+    EXPECT_EQ(manager.getSleepTime(0), POWER_NO_DEADLINE);
+
+    ASSERT_EQ(manager.addClient(events, "button"), ERROR_SUCCESS);
+    EXPECT_EQ(manager.getNextDeadline(0), POWER_NO_DEADLINE); // event driven only
+
+    ASSERT_EQ(manager.addClient(slow, "slow"), ERROR_SUCCESS);
+    ASSERT_EQ(manager.addClient(fast, "fast"), ERROR_SUCCESS);
+    size_t owner = 0;
+    EXPECT_EQ(manager.getNextDeadline(0, &owner), 100 * msUs);
+    EXPECT_EQ(owner, 2u);
+    EXPECT_STREQ(manager.getClientName(owner), "fast");
+    EXPECT_EQ(manager.getSleepTime(40 * msUs), 60 * msUs);
+    EXPECT_EQ(manager.getSleepTime(150 * msUs), 0u); // overdue
+    EXPECT_EQ(manager.getClientName(3), nullptr);
+
+    for (int i = 3; i < POWER_MAX_CLIENTS; i++)
+    {
+        ASSERT_EQ(manager.addClient(events, "more"), ERROR_SUCCESS);
+    }
+    EXPECT_EQ(manager.addClient(events, "full"), ERROR_OUT_OF_MEMORY);
+    EXPECT_EQ(manager.getClientCount(), static_cast<size_t>(POWER_MAX_CLIENTS));
+}
+
+TEST(PowerManagerTest, IdleBatteryHour)
+{
+    // An LED blinks for 10 s after boot, a button is pressed once, then nothing happens for the rest of the hour
+    powerManager manager;
+    blinkClient  leds(500 * msUs, 10000 * msUs);
+    IPowerClient button;
+    blinkClient* clients[] = {&leds};
+    ASSERT_EQ(manager.addClient(leds, "leds"), ERROR_SUCCESS);
+    ASSERT_EQ(manager.addClient(button, "button"), ERROR_SUCCESS);
+
+    uint64_t now = 0;
+    runUntil(manager, clients, now, hourUs, 1800 * 1000 * msUs, &button);
+
+    EXPECT_EQ(now, hourUs);
+    EXPECT_EQ(manager.getWakeups(0, now), 20u); // a wakeup per transition instead of one per 100 ms cycle
+    EXPECT_EQ(manager.getWakeups(1, now), 1u);
+    EXPECT_EQ(manager.getTotalWakeups(now), 21u);
+    EXPECT_EQ(manager.getNextDeadline(now), POWER_NO_DEADLINE); // sleeps until the next event
+
+    // Another idle hour costs no wakeup at all
+    runUntil(manager, clients, now, 2 * hourUs, 0, nullptr);
+    EXPECT_EQ(manager.getTotalWakeups(now), 21u);
+}
+
+TEST(PowerManagerTest, Report)
+{
+    powerManager manager;
+    blinkClient  leds(500 * msUs, hourUs);
+    IPowerClient button;
+    manager.addClient(leds, "leds");
+    manager.addClient(button, "button");
+    leds.wake(0);
+    button.countWakeup();
+
+    char buffer[512];
+    size_t length = manager.formatJson(buffer, sizeof(buffer), 100 * msUs);
+    EXPECT_EQ(length, strlen(buffer));
+    EXPECT_NE(strstr(buffer, "{\"name\":\"leds\",\"wakeups\":1,"), nullptr);
+    EXPECT_NE(strstr(buffer, "\"nextMs\":400}"), nullptr);
+    EXPECT_NE(strstr(buffer, "{\"name\":\"button\",\"wakeups\":1,\"perHour\":36000.0,\"nextMs\":null}"), nullptr);
+    EXPECT_NE(strstr(buffer, "\"wakeups\":2,\"sleepMs\":400,\"next\":\"leds\"}"), nullptr);
+
+    length = manager.formatText(buffer, sizeof(buffer), 100 * msUs);
+    EXPECT_EQ(length, strlen(buffer));
+    EXPECT_NE(strstr(buffer, "next on event"), nullptr);
+    EXPECT_NE(strstr(buffer, "sleep 400 ms, woken by leds"), nullptr);
+
+    // truncated, still terminated
+    char small[16];
+    length = manager.formatJson(small, sizeof(small), 100 * msUs);
+    EXPECT_EQ(length, sizeof(small) - 1);
+    EXPECT_EQ(strlen(small), sizeof(small) - 1);
+}
@@ -0,0 +1,130 @@
+#include "System/processRegistry.h"
+#include "gtest/gtest.h"
+
+#include <string>
+#include <type_traits>
+
+namespace
+{
+std::string events;
+uint64_t    now      = 0;
+bool        failWifi = false;
+
+uint64_t fakeClock()
+{
+    return now;
+}
+
+typedef struct
+{
+    uint32_t port;
+} httpParams_t;
+
+struct wifiProcess : processTraits<3, 4096, 12, 0, processDependencies<>::mask, int>
+{
+    static constexpr const char* name = "wifi";
+    static sys_error_t start()
+    {
+        now += 1500;
+        events += "+wifi";
+        return failWifi ? ERROR_NETWORK_UNAVAILABLE : ERROR_SUCCESS;
+    }
+    static sys_error_t stop()
+    {
+        events += "-wifi";
+        return ERROR_SUCCESS;
+    }
+};
+
+struct httpProcess : processTraits<7, 8192, 5, PROCESS_CORE_ANY, processDependencies<wifiProcess>::mask, httpParams_t>
+{
+    static constexpr const char* name = "http";
+    static sys_error_t start()
+    {
+        now += 200;
+        events += "+http";
+        return ERROR_SUCCESS;
+    }
+    static sys_error_t stop()
+    {
+        events += "-http";
+        return ERROR_SUCCESS;
+    }
+};
+
+struct ledsProcess : processTraits<1, 2048, 10, 1, processDependencies<>::mask, int>
+{
+    static constexpr const char* name = "leds";
+    static sys_error_t start()
+    {
+        now += 30;
+        events += "+leds";
+        return ERROR_SUCCESS;
+    }
+    static sys_error_t stop()
+    {
+        events += "-leds";
+        return ERROR_SUCCESS;
+    }
+};
+
+typedef processRegistry<wifiProcess, ledsProcess, httpProcess> registry;
+} // namespace
+
+class ProcessRegistryTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        events.clear();
+        now      = 0;
+        failWifi = false;
+    }
+};
+
+TEST_F(ProcessRegistryTest, TableHoldsDescriptors)
+{
+    static_assert(registry::count == 3, "three processes");
+    static_assert(httpProcess::depends == PROCESS_BIT(3), "http depends on wifi");
+    static_assert(std::is_same<httpProcess::params_t, httpParams_t>::value, "parameter struct");
+
+    const processDescriptor_t* http = registry::find(7);
+    ASSERT_NE(http, nullptr);
+    EXPECT_STREQ(http->name, "http");
+    EXPECT_EQ(http->stackSize, 8192u);
+    EXPECT_EQ(http->priority, 5u);
+    EXPECT_EQ(http->core, PROCESS_CORE_ANY);
+    EXPECT_EQ(registry::getTable()[1].core, 1);
+    EXPECT_EQ(registry::find(2), nullptr);
+}
+
+TEST_F(ProcessRegistryTest, BootsInOrderAndTimesEachProcess)
+{
+    processBootRecord_t records[registry::count];
+    EXPECT_EQ(registry::boot(records, fakeClock), ERROR_SUCCESS);
+    EXPECT_EQ(events, "+wifi+leds+http");
+
+    EXPECT_EQ(records[0].id, 3u);
+    EXPECT_EQ(records[0].startUs, 1500u);
+    EXPECT_EQ(records[1].startUs, 30u);
+    EXPECT_EQ(records[2].startUs, 200u);
+    EXPECT_EQ(records[2].result, ERROR_SUCCESS);
+}
+
+TEST_F(ProcessRegistryTest, FailedDependencySkipsDependents)
+{
+    failWifi = true;
+    processBootRecord_t records[registry::count];
+    EXPECT_EQ(registry::boot(records, fakeClock), ERROR_NETWORK_UNAVAILABLE);
+    EXPECT_EQ(events, "+wifi+leds");
+    EXPECT_EQ(records[1].result, ERROR_SUCCESS);
+    EXPECT_EQ(records[2].result, ERROR_INIT_FAILED);
+}
+
+TEST_F(ProcessRegistryTest, ShutdownInReverseOrder)
+{
+    registry::boot();
+    events.clear();
+    EXPECT_EQ(registry::shutdown(), ERROR_SUCCESS);
+    EXPECT_EQ(events, "-http-leds-wifi");
+}
@@ -0,0 +1,128 @@
+#include "Library/Common/ringBuffer.h"
+#include "gtest/gtest.h"
+
+#include <string.h>
+#include <thread>
+
+TEST(RingBufferTest, WriteReadWrapsAround)
+{
+    uint8_t    storage[16];
+    ringBuffer ring(storage, sizeof(storage));
+
+    uint8_t data[12];
+    for (uint8_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = i;
+    }
+
+    uint8_t out[16];
+    for (int round = 0; round < 5; round++)
+    {
+        ASSERT_EQ(ring.write(data, sizeof(data)), sizeof(data));
+        EXPECT_EQ(ring.size(), sizeof(data));
+        ASSERT_EQ(ring.read(out, sizeof(out)), sizeof(data));
+        EXPECT_EQ(memcmp(out, data, sizeof(data)), 0);
+    }
+
+    // Partial write when full
+    EXPECT_EQ(ring.write(data, sizeof(data)), sizeof(data));
+    EXPECT_EQ(ring.write(data, sizeof(data)), 4u);
+    EXPECT_EQ(ring.freeSpace(), 0u);
+}
+
+TEST(RingBufferTest, CapacityMustBeAPowerOfTwo)
+{
+    uint8_t    storage[24];
+    ringBuffer ring(storage, sizeof(storage));
+    EXPECT_FALSE(ring.isValid());
+    EXPECT_EQ(ring.capacity(), 0u);
+    EXPECT_EQ(ring.write(storage, 8), 0u);
+    EXPECT_EQ(ring.writeSpan().length, 0u);
+    EXPECT_EQ(ring.readSpan().length, 0u);
+
+    ringBuffer empty(storage, 0);
+    EXPECT_FALSE(empty.isValid());
+    ringBuffer valid(storage, 16);
+    EXPECT_TRUE(valid.isValid());
+    EXPECT_EQ(valid.capacity(), 16u);
+}
+
+TEST(RingBufferTest, SpansAreContiguousUpToTheEnd)
+{
+    uint8_t    storage[16];
+    ringBuffer ring(storage, sizeof(storage));
+
+    uint8_t data[10] = {0};
+    uint8_t out[10];
+    ring.write(data, sizeof(data));
+    ring.read(out, sizeof(out));
+
+    // Write position is at 10: the free region is split at the end of the storage
+    ringSpan_t span = ring.writeSpan();
+    EXPECT_EQ(span.data, storage + 10);
+    EXPECT_EQ(span.length, 6u);
+    memset(span.data, 0xAA, span.length);
+    ring.commit(span.length);
+
+    span = ring.writeSpan();
+    EXPECT_EQ(span.data, storage);
+    EXPECT_EQ(span.length, 10u);
+    memset(span.data, 0xBB, 2);
+    ring.commit(2);
+
+    span = ring.readSpan();
+    EXPECT_EQ(span.length, 6u);
+    EXPECT_EQ(span.data[0], 0xAA);
+    ring.consume(span.length);
+
+    span = ring.readSpan();
+    EXPECT_EQ(span.length, 2u);
+    EXPECT_EQ(span.data[1], 0xBB);
+    ring.consume(2);
+    EXPECT_EQ(ring.readSpan().length, 0u);
+}
+
+TEST(RingBufferTest, SingleProducerSingleConsumer)
+{
+    uint8_t    storage[64];
+    ringBuffer ring(storage, sizeof(storage));
+
+    const uint32_t total = 100000;
+    std::thread    producer(
+        [&ring, total]()
+        {
+            uint32_t sent = 0;
+            while (sent < total)
+            {
+                uint8_t value = static_cast<uint8_t>(sent * 7);
+                if (ring.write(&value, 1) == 0)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                sent++;
+            }
+        });
+
+    uint32_t received = 0;
+    bool     inOrder  = true;
+    while (received < total)
+    {
+        ringSpan_t span = ring.readSpan();
+        for (size_t i = 0; i < span.length; i++)
+        {
+            inOrder &= span.data[i] == static_cast<uint8_t>((received + i) * 7);
+        }
+        ring.consume(span.length);
+        received += span.length;
+        if (span.length == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(inOrder);
+    EXPECT_EQ(ring.writePosition(), total);
+    EXPECT_EQ(ring.readPosition(), total);
+}
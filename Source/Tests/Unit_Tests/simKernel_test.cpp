@@ -0,0 +1,247 @@
+#include "Library/Simulation/simFreeRTOS.h"
+#include "Library/Simulation/simGpio.h"
+#include "Library/Simulation/simKernel.h"
+#include "Process/Examples/Proc_Button.hpp"
+#include "Process/Examples/Proc_Leds.hpp"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace
+{
+// LED counting the level changes written by Proc_Leds
+class countingLed : public IHAL_IO
+{
+public:
+    uint8_t  level   = 0;
+    uint32_t toggles = 0;
+
+    void get(void* data) override
+    {
+        *static_cast<uint8_t*>(data) = level;
+    }
+    sys_error_t set(void* data) override
+    {
+        uint8_t value = *static_cast<uint8_t*>(data);
+        toggles += (value != level) ? 1 : 0;
+        level = value;
+        return ERROR_SUCCESS;
+    }
+};
+
+// Results of the ulTaskNotifyTake() calls of a task
+typedef struct
+{
+    uint32_t   taken[3];
+    TickType_t wokeAt[3];
+} notifyWaits_t;
+} // namespace
+
+TEST(SimKernelTest, DelaysRunInVirtualTimeOrder)
+{
+    simKernel                kernel;
+    std::vector<std::string> order;
+
+    kernel.createTask("slow", [&]() { kernel.delay(30); order.push_back("slow@" + std::to_string(kernel.getTickCount())); }, 1);
+    kernel.createTask("fast", [&]() { kernel.delay(10); order.push_back("fast@" + std::to_string(kernel.getTickCount())); }, 1);
+
+    EXPECT_TRUE(kernel.runUntilIdle(1000));
+    ASSERT_EQ(order.size(), 2u);
+    EXPECT_EQ(order[0], "fast@10");
+    EXPECT_EQ(order[1], "slow@30");
+    EXPECT_EQ(kernel.getStats().tasksFinished, 2u);
+}
+
+TEST(SimKernelTest, HigherPriorityRunsFirstOnSameTick)
+{
+    simKernel                kernel;
+    std::vector<std::string> order;
+
+    kernel.createTask("low", [&]() { kernel.delay(5); order.push_back("low"); }, 1);
+    kernel.createTask("high", [&]() { kernel.delay(5); order.push_back("high"); }, 3);
+    kernel.createTask("mid", [&]() { kernel.delay(5); order.push_back("mid"); }, 2);
+
+    kernel.runUntilIdle(100);
+    ASSERT_EQ(order.size(), 3u);
+    EXPECT_EQ(order[0], "high");
+    EXPECT_EQ(order[1], "mid");
+    EXPECT_EQ(order[2], "low");
+}
+
+TEST(SimKernelTest, AutoReloadTimerFiresEveryPeriod)
+{
+    simKernel        kernel;
+    uint32_t         fired = 0;
+    simTimerHandle_t timer = kernel.createTimer("tick", 10, true, [&]() { fired++; });
+
+    kernel.startTimer(timer);
+    kernel.runFor(105);
+    EXPECT_EQ(fired, 10u);
+    EXPECT_EQ(kernel.getTickCount(), 105u);
+
+    kernel.stopTimer(timer);
+    kernel.runFor(100);
+    EXPECT_EQ(fired, 10u);
+    EXPECT_FALSE(kernel.isTimerActive(timer));
+}
+
+TEST(SimKernelTest, QueueReceiveTimesOut)
+{
+    simKernel     kernel;
+    simQueue<int> queue(kernel, 2);
+    bool          received = true;
+    uint64_t      wokeAt   = 0;
+
+    kernel.createTask("listener", [&]() {
+        int item = 0;
+        received = queue.receive(item, 25);
+        wokeAt   = kernel.getTickCount();
+    }, 1);
+
+    kernel.runUntilIdle(1000);
+    EXPECT_FALSE(received);
+    EXPECT_EQ(wokeAt, 25u);
+}
+
+TEST(SimKernelTest, QueueWakesBlockedReceiver)
+{
+    simKernel     kernel;
+    simQueue<int> queue(kernel, 2);
+    int           item   = 0;
+    uint64_t      wokeAt = 0;
+
+    kernel.createTask("listener", [&]() {
+        queue.receive(item);
+        wokeAt = kernel.getTickCount();
+    }, 1);
+    kernel.schedule(40, [&]() { queue.send(7); });
+
+    kernel.runUntilIdle(1000);
+    EXPECT_EQ(item, 7);
+    EXPECT_EQ(wokeAt, 40u);
+}
+
+TEST(SimKernelTest, FreeRTOSShimNotificationsAndTimeouts)
+{
+    simKernel kernel;
+    simRtos   rtos(kernel);
+    notifyWaits_t waits;
+    TaskHandle_t  waiter = NULL;
+
+    xTaskCreate([](void* arg) {
+        notifyWaits_t& waits = *static_cast<notifyWaits_t*>(arg);
+        for (int i = 0; i < 3; i++)
+        {
+            waits.taken[i]  = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+            waits.wokeAt[i] = xTaskGetTickCount();
+        }
+    }, "waiter", 2048, &waits, 1, &waiter);
+    ASSERT_NE(waiter, static_cast<TaskHandle_t>(NULL));
+
+    // Two notifications before the task runs are taken at once, then one from a simulated interrupt
+    xTaskNotifyGive(waiter);
+    xTaskNotifyGive(waiter);
+    kernel.schedule(30, [&]() { vTaskNotifyGiveFromISR(waiter, nullptr); });
+    kernel.runUntilIdle(1000);
+
+    EXPECT_EQ(waits.taken[0], 2u);
+    EXPECT_EQ(waits.wokeAt[0], 0u);
+    EXPECT_EQ(waits.taken[1], 1u);
+    EXPECT_EQ(waits.wokeAt[1], 30u);
+    EXPECT_EQ(waits.taken[2], 0u);
+    EXPECT_EQ(waits.wokeAt[2], 130u);
+    EXPECT_EQ(esp_timer_get_time(), 130000);
+}
+
+TEST(SimKernelTest, SimulatedHourOfLedBlinking)
+{
+    simKernel                            kernel;
+    simRtos                              rtos(kernel);
+    countingLed                          pin;
+    Proc_LedsBase::ledData               led  = {pin, LED_OFF, 0, 0};
+    std::vector<Proc_LedsBase::ledData*> leds = {&led};
+    Proc_Leds<>                          process(leds);
+
+    // The real LED task, tickless: it sleeps until the next LED change
+    ASSERT_EQ(process.start(), ERROR_SUCCESS);
+    process.setLedState(led, LED_BLINK);
+
+    auto start = std::chrono::steady_clock::now();
+    kernel.runFor(kernel.msToTicks(60 * 60 * 1000));
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    // 250 ms on, 250 ms off; one wakeup per toggle and one for setLedState()
+    EXPECT_EQ(pin.toggles, 60u * 60u * 1000u / 500u);
+    EXPECT_EQ(process.getWakeups(0), pin.toggles + 1);
+    EXPECT_EQ(process.getNextDeadline(0), static_cast<uint64_t>(esp_timer_get_time()) + 500000u);
+    EXPECT_LT(elapsed, 2000);
+
+    // Without a blinking LED the task only wakes up for setLedState()
+    uint32_t wakeups = process.getWakeups(0);
+    process.setLedState(led, LED_OFF);
+    kernel.runFor(kernel.msToTicks(60 * 60 * 1000));
+    EXPECT_EQ(process.getNextDeadline(0), POWER_NO_DEADLINE);
+    EXPECT_EQ(process.getWakeups(0), wakeups + 1);
+    EXPECT_EQ(pin.level, GPIO_LOW);
+}
+
+TEST(SimKernelTest, DebouncedButtonPressDurations)
+{
+    simKernel kernel;
+    simRtos   rtos(kernel);
+    simGpioReset();
+
+    // Active low button on io_gpio, released at start
+    gpio_config_t config = {};
+    config.pin_bit_mask  = 1ULL << GPIO_NUM_4;
+    config.mode          = GPIO_MODE_INPUT;
+    config.intr_type     = GPIO_INTR_ANYEDGE;
+    simGpioDrive(GPIO_NUM_4, GPIO_HIGH);
+    io_gpio gpio(GPIO_NUM_4, &config);
+    ASSERT_EQ(gpio.init(), ERROR_SUCCESS);
+
+    Proc_ButtonBase::buttonData               button  = {gpio, GPIO_HIGH, GPIO_HIGH, GPIO_LOW, 0, NULL, 0, nullptr};
+    std::vector<Proc_ButtonBase::buttonData*> buttons = {&button};
+    Proc_Button<>                             process(buttons);
+    std::vector<uint32_t>                     durations;
+    process.setPressHandler([](size_t index, uint32_t durationMs, void* context) { static_cast<std::vector<uint32_t>*>(context)->push_back(durationMs); }, &durations);
+    ASSERT_EQ(process.start(), ERROR_SUCCESS);
+
+    // A press with contact bounce, then a 2 s press
+    kernel.schedule(100, []() { simGpioDrive(GPIO_NUM_4, GPIO_LOW); });
+    kernel.schedule(103, []() { simGpioDrive(GPIO_NUM_4, GPIO_HIGH); });
+    kernel.schedule(105, []() { simGpioDrive(GPIO_NUM_4, GPIO_LOW); });
+    kernel.schedule(405, []() { simGpioDrive(GPIO_NUM_4, GPIO_HIGH); });
+    kernel.schedule(1000, []() { simGpioDrive(GPIO_NUM_4, GPIO_LOW); });
+    kernel.schedule(3000, []() { simGpioDrive(GPIO_NUM_4, GPIO_HIGH); });
+    kernel.runFor(5000);
+
+    // The bounces fall into the 50 ms the interrupt stays off, the first press counts from its first edge
+    ASSERT_EQ(durations.size(), 2u);
+    EXPECT_EQ(durations[0], 305u);
+    EXPECT_EQ(durations[1], 2000u);
+    EXPECT_EQ(process.getWakeups(0), 4u);
+}
+
+TEST(SimKernelTest, MillionTimerEvents)
+{
+    simKernel kernel;
+    uint64_t  fired = 0;
+    for (uint32_t i = 1; i <= 10; i++)
+    {
+        kernel.startTimer(kernel.createTimer("stress", i, true, [&]() { fired++; }));
+    }
+
+    // 10 timers with periods 1..10 over 350000 ticks fire about a million times
+    kernel.runFor(350000);
+    uint64_t expected = 0;
+    for (uint32_t i = 1; i <= 10; i++)
+    {
+        expected += 350000 / i;
+    }
+    EXPECT_EQ(fired, expected);
+    EXPECT_EQ(kernel.getStats().timerCallbacks, expected);
+    EXPECT_GT(expected, 1000000u);
+}
@@ -0,0 +1,174 @@
+#include "HAL/Platform/Linux/net_udpHost.hpp"
+#include "Library/Protocol/syslogSink.h"
+#include "gtest/gtest.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+// Transport which refuses datagrams while busy is set
+class busyTransport : public IHAL_COM
+{
+public:
+    bool                     busy = true;
+    std::vector<std::string> sent;
+
+    sys_error_t connect() override
+    {
+        return ERROR_SUCCESS;
+    }
+    sys_error_t sendData(const uint8_t* data, size_t length) override
+    {
+        if (busy)
+        {
+            return ERROR_BUSY;
+        }
+        sent.push_back(std::string(reinterpret_cast<const char*>(data), length));
+        return ERROR_SUCCESS;
+    }
+    sys_error_t receiveData(uint8_t* data, size_t maxLength, size_t& receivedLength) override
+    {
+        receivedLength = 0;
+        return ERROR_SUCCESS;
+    }
+    sys_error_t disconnect() override
+    {
+        return ERROR_SUCCESS;
+    }
+};
+
+syslogConfig_t testConfig()
+{
+    syslogConfig_t config = syslogDefaultConfig();
+    config.hostname       = "node 1";
+    config.appName        = "test";
+    return config;
+}
+} // namespace
+
+class SyslogSinkTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _listener           = socket(AF_INET, SOCK_DGRAM, 0);
+        sockaddr_in address = {};
+        address.sin_family  = AF_INET;
+        address.sin_port    = 0;
+        inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+        ASSERT_EQ(bind(_listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+        socklen_t length = sizeof(address);
+        ASSERT_EQ(getsockname(_listener, reinterpret_cast<sockaddr*>(&address), &length), 0);
+        _port = ntohs(address.sin_port);
+    }
+
+    void TearDown() override
+    {
+        close(_listener);
+    }
+
+    std::string receive()
+    {
+        pollfd entry = {_listener, POLLIN, 0};
+        if (::poll(&entry, 1, 1000) != 1)
+        {
+            return std::string();
+        }
+        char    buffer[2048];
+        ssize_t received = recv(_listener, buffer, sizeof(buffer), 0);
+        return std::string(buffer, received > 0 ? static_cast<size_t>(received) : 0);
+    }
+
+    int      _listener;
+    uint16_t _port;
+};
+
+TEST_F(SyslogSinkTest, EachRecordIsOneDatagram)
+{
+    net_udpHost transport("127.0.0.1", _port);
+    ASSERT_EQ(transport.connect(), ERROR_SUCCESS);
+    syslogSink sink(transport, testConfig());
+    LogHandler handler(&sink);
+    int        notified = 0;
+    sink.setNotify([](void* context) { (*static_cast<int*>(context))++; }, &notified);
+
+    handler.log(ILog::LogLevel::INFO, "WiFi Started!");
+    handler.log(ILog::LogLevel::WARNING, "RSSI low");
+    handler.logToFile("ota", ILog::LogLevel::ERROR, "image rejected");
+    EXPECT_EQ(sink.getQueued(), 3u);
+    EXPECT_EQ(notified, 3);
+
+    EXPECT_EQ(sink.poll(), ERROR_SUCCESS);
+    EXPECT_EQ(sink.getQueued(), 0u);
+
+    // No framing, the datagram is the message
+    std::string first = receive();
+    EXPECT_EQ(first.find("<14>1 - node_1 test - - [meta sequenceId=\"1\" sysUpTime=\""), 0u);
+    EXPECT_EQ(first.substr(first.size() - 15), "] WiFi Started!");
+    EXPECT_EQ(receive().find("<12>1 - node_1 test - - [meta sequenceId=\"2\""), 0u);
+    std::string third = receive();
+    EXPECT_EQ(third.find("<11>1 - node_1 test - ota [meta sequenceId=\"3\""), 0u);
+    EXPECT_EQ(third.substr(third.size() - 16), "] image rejected");
+
+    syslogStats_t stats = sink.getStats();
+    EXPECT_EQ(stats.records, 3u);
+    EXPECT_EQ(stats.datagramsSent, 3u);
+}
+
+TEST_F(SyslogSinkTest, FormattedRecordsReachTheSink)
+{
+    busyTransport transport;
+    syslogSink    sink(transport, testConfig());
+    LogHandler    handler(&sink);
+
+    handler.logFormat(ILog::LogLevel::WARNING, "AID {} joined, RSSI {}", 3u, -71);
+    transport.busy = false;
+    EXPECT_EQ(sink.poll(), ERROR_SUCCESS);
+
+    ASSERT_EQ(transport.sent.size(), 1u);
+    EXPECT_EQ(transport.sent[0].find("<12>1 - node_1 test - - "), 0u);
+    EXPECT_EQ(transport.sent[0].substr(transport.sent[0].size() - 24), "] AID 3 joined, RSSI -71");
+}
+
+TEST_F(SyslogSinkTest, FullQueueDropsWithoutBlocking)
+{
+    busyTransport transport;
+    syslogSink    sink(transport, testConfig());
+
+    // Longer than a datagram, every record is truncated
+    std::string text(SYSLOG_DATAGRAM_SIZE, 'y');
+    for (int i = 0; i < SYSLOG_QUEUE_DEPTH + 3; i++)
+    {
+        sink.log(ILog::LogLevel::INFO, "bulk", text.data(), text.size());
+    }
+    EXPECT_EQ(sink.log(ILog::LogLevel::INFO, "bulk", "late", 4), ERROR_BUSY);
+
+    syslogStats_t stats = sink.getStats();
+    EXPECT_EQ(stats.records, static_cast<uint32_t>(SYSLOG_QUEUE_DEPTH));
+    EXPECT_EQ(stats.truncated, static_cast<uint32_t>(SYSLOG_QUEUE_DEPTH));
+    EXPECT_EQ(stats.droppedQueueFull, 4u);
+
+    // Backpressure: the datagrams stay queued while the transport is busy
+    EXPECT_EQ(sink.poll(), ERROR_BUSY);
+    EXPECT_EQ(sink.getQueued(), static_cast<size_t>(SYSLOG_QUEUE_DEPTH));
+
+    transport.busy = false;
+    EXPECT_EQ(sink.poll(), ERROR_SUCCESS);
+    ASSERT_EQ(transport.sent.size(), static_cast<size_t>(SYSLOG_QUEUE_DEPTH));
+    for (const std::string& datagram : transport.sent)
+    {
+        EXPECT_EQ(datagram.size(), static_cast<size_t>(SYSLOG_DATAGRAM_SIZE));
+        EXPECT_EQ(datagram.find("<14>1 - node_1 test - bulk "), 0u);
+    }
+
+    // The sequence numbers show the collector the gap
+    sink.log(ILog::LogLevel::INFO, "bulk", "after", 5);
+    EXPECT_EQ(sink.poll(), ERROR_SUCCESS);
+    EXPECT_NE(transport.sent.back().find("sequenceId=\"13\""), std::string::npos);
+}
@@ -0,0 +1,145 @@
+#include "Library/Diagnostics/taskProfiler.h"
+#include "gtest/gtest.h"
+
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+taskSample_t makeSample(uintptr_t id, int16_t process, uint32_t runTime, uint32_t highWater, uint32_t switches)
+{
+    taskSample_t sample   = {};
+    sample.id             = id;
+    sample.process        = process;
+    sample.runTime        = runTime;
+    sample.stackHighWater = highWater;
+    sample.stackSize      = 4096;
+    sample.switches       = switches;
+    snprintf(sample.name, sizeof(sample.name), "task%u", static_cast<unsigned>(id));
+    return sample;
+}
+} // namespace
+
+TEST(TaskProfilerTest, CpuStackAndSwitchesPerProcess)
+{
+    taskProfiler profiler;
+    int16_t      leds   = profiler.addProcess("leds");
+    int16_t      button = profiler.addProcess("button");
+    ASSERT_EQ(leds, 0);
+    ASSERT_EQ(button, 1);
+
+    taskSample_t first[] = {makeSample(1, leds, 1000, 3000, 10), makeSample(2, button, 0, 900, 0), makeSample(3, button, 0, 700, 0), makeSample(4, -1, 5000, 500, 100)};
+    profiler.update(first, 4, 10000, 0);
+    EXPECT_EQ(profiler.getProfile(0).cpuPercent, 0.0f); // baseline only
+
+    // 1 s later, 100000 run time units elapsed
+    taskSample_t second[] = {makeSample(1, leds, 26000, 2800, 60), makeSample(2, button, 10000, 900, 20), makeSample(3, button, 0, 650, 30), makeSample(4, -1, 55000, 500, 200)};
+    profiler.update(second, 4, 110000, 1000);
+
+    ASSERT_EQ(profiler.getProfileCount(), 3u);
+    processProfile_t ledsProfile   = profiler.getProfile(0);
+    processProfile_t buttonProfile = profiler.getProfile(1);
+    processProfile_t system        = profiler.getProfile(2);
+
+    EXPECT_STREQ(ledsProfile.name, "leds");
+    EXPECT_NEAR(ledsProfile.cpuPercent, 25.0f, 0.01f);
+    EXPECT_EQ(ledsProfile.stackHeadroom, 2800u);
+    EXPECT_NEAR(ledsProfile.switchesPerSecond, 50.0f, 0.01f);
+
+    EXPECT_EQ(buttonProfile.tasks, 2u);
+    EXPECT_NEAR(buttonProfile.cpuPercent, 10.0f, 0.01f);
+    EXPECT_EQ(buttonProfile.stackHeadroom, 650u);
+    EXPECT_NEAR(buttonProfile.switchesPerSecond, 50.0f, 0.01f);
+
+    EXPECT_STREQ(system.name, "system");
+    EXPECT_NEAR(system.cpuPercent, 50.0f, 0.01f);
+}
+
+TEST(TaskProfilerTest, CountersWrapAround)
+{
+    taskProfiler profiler;
+    int16_t      process = profiler.addProcess("p");
+
+    taskSample_t first = makeSample(1, process, 0xFFFFF000u, 100, 0xFFFFFFF0u);
+    profiler.update(&first, 1, 0xFFFFE000u, 0xFFFFFC18u);
+    taskSample_t second = makeSample(1, process, 0x00000800u, 100, 0x00000010u);
+    profiler.update(&second, 1, 0x00002000u, 1000);
+
+    EXPECT_NEAR(profiler.getProfile(0).cpuPercent, 0x1800 * 100.0f / 0x4000, 0.01f);
+    EXPECT_NEAR(profiler.getProfile(0).switchesPerSecond, 16.0f, 0.01f); // 32 switches in 2 s
+}
+
+TEST(TaskProfilerTest, Formatting)
+{
+    taskProfiler profiler(1);
+    EXPECT_EQ(profiler.addProcess("http"), 0);
+    EXPECT_EQ(profiler.addProcess("full"), -1);
+
+    taskSample_t sample = makeSample(7, 0, 0, 1234, 0);
+    profiler.update(&sample, 1, 0, 0);
+
+    char json[2 * TASKPROFILER_JSON_ENTRY_SIZE];
+    bool truncated = true;
+    profiler.formatJson(json, sizeof(json), &truncated);
+    EXPECT_FALSE(truncated);
+    EXPECT_NE(strstr(json, "{\"process\":\"http\",\"tasks\":1,"), nullptr);
+    EXPECT_NE(strstr(json, "\"stackHeadroom\":1234"), nullptr);
+    EXPECT_EQ(json[0], '[');
+    EXPECT_EQ(json[strlen(json) - 1], ']');
+
+    char   text[256];
+    size_t length = profiler.formatText(text, sizeof(text));
+    EXPECT_EQ(length, strlen(text));
+    EXPECT_NE(std::string(text).find("system"), std::string::npos);
+
+    // Truncation keeps the buffer terminated, the JSON array stays valid
+    char small[16];
+    EXPECT_EQ(profiler.formatText(small, sizeof(small)), sizeof(small) - 1);
+    EXPECT_EQ(strlen(small), sizeof(small) - 1);
+    EXPECT_EQ(profiler.formatJson(small, sizeof(small), &truncated), 2u);
+    EXPECT_STREQ(small, "[]");
+    EXPECT_TRUE(truncated);
+    EXPECT_EQ(profiler.formatJson(small, 2, &truncated), 0u);
+    EXPECT_STREQ(small, "");
+}
+
+TEST(TaskProfilerTest, JsonKeepsWholeProfiles)
+{
+    const size_t              processes = 16;
+    taskProfiler              profiler(processes);
+    std::vector<std::string>  names;
+    std::vector<taskSample_t> samples;
+    for (size_t i = 0; i < processes; i++)
+    {
+        names.push_back(std::string(31, 'a') + static_cast<char>('a' + i));
+    }
+    for (size_t i = 0; i < processes; i++)
+    {
+        int16_t process = profiler.addProcess(names[i].c_str());
+        samples.push_back(makeSample(i + 1, process, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu));
+    }
+    profiler.update(samples.data(), samples.size(), 0, 0);
+    profiler.update(samples.data(), samples.size(), 1, 1);
+
+    // Room for every profile
+    std::vector<char> full((processes + 1) * TASKPROFILER_JSON_ENTRY_SIZE);
+    bool              truncated = true;
+    size_t            length    = profiler.formatJson(full.data(), full.size(), &truncated);
+    EXPECT_FALSE(truncated);
+    EXPECT_EQ(length, strlen(full.data()));
+    EXPECT_NE(strstr(full.data(), "{\"process\":\"system\""), nullptr);
+
+    // Only whole profiles otherwise
+    for (size_t size = 3; size < length; size += 97)
+    {
+        std::vector<char> part(size);
+        size_t            written = profiler.formatJson(part.data(), part.size(), &truncated);
+        std::string       json(part.data());
+        EXPECT_TRUE(truncated);
+        EXPECT_EQ(written, json.size());
+        EXPECT_LT(written, size);
+        EXPECT_EQ(std::string(full.data(), json.size() - 1), json.substr(0, json.size() - 1));
+        EXPECT_TRUE(json == "[]" || json.compare(json.size() - 2, 2, "}]") == 0) << json;
+    }
+}
@@ -0,0 +1,112 @@
+#include "Library/Common/helperConversions.h"
+#include "Library/Common/textFormat.h"
+#include "gtest/gtest.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+
+TEST(TextFormatTest, IntegersMatchPrintf)
+{
+    const long long values[] = {0, 7, 9, 10, 99, 100, 101, 999, 1000, 65535, -1, -10, -100, 2147483647LL, -2147483648LL, INT64_MAX, INT64_MIN};
+    for (long long value : values)
+    {
+        char expected[32];
+        snprintf(expected, sizeof(expected), "%lld", value);
+        format::fixedString<32> text;
+        format::appendSigned(text, value);
+        EXPECT_STREQ(text.c_str(), expected);
+    }
+
+    format::fixedString<32> text;
+    format::appendUnsigned(text, UINT64_MAX);
+    EXPECT_STREQ(text.c_str(), "18446744073709551615");
+}
+
+TEST(TextFormatTest, HexMacAndIpv4)
+{
+    const uint8_t bytes[6] = {0x24, 0x0a, 0xc4, 0x00, 0x11, 0xff};
+    EXPECT_STREQ(mac::convertToMac(bytes).c_str(), "24:0a:c4:00:11:ff");
+
+    format::fixedString<64> text;
+    format::appendMac(text, bytes, true);
+    text.append(' ');
+    format::appendHex(text, bytes, 3);
+    text.append(' ');
+    format::appendHexValue(text, 0xBEEF, 8, true);
+    text.append(' ');
+    format::appendHexValue(text, 0);
+    EXPECT_STREQ(text.c_str(), "24:0A:C4:00:11:FF 240ac4 0000BEEF 0");
+
+    const uint8_t address[4] = {192, 168, 0, 255};
+    text.clear();
+    format::appendIpv4(text, address);
+    EXPECT_STREQ(text.c_str(), "192.168.0.255");
+    EXPECT_EQ(text.length(), 13u);
+}
+
+TEST(TextFormatTest, FormatToPlaceholders)
+{
+    const uint8_t bytes[6]   = {0x24, 0x0a, 0xc4, 0x00, 0x11, 0x22};
+    const uint8_t address[4] = {10, 0, 0, 1};
+    std::string   name("lamp");
+    uint8_t       aid  = 3;
+    int8_t        rssi = -67;
+
+    format::fixedString<128> text;
+    format::formatTo(text, "Station {} join, AID= {} rssi {} {} at {} flags {} {} {}", format::mac(bytes), aid, rssi, name, format::ipv4(address), format::hex(0x1F, 4), true, 'x');
+    EXPECT_STREQ(text.c_str(), "Station 24:0a:c4:00:11:22 join, AID= 3 rssi -67 lamp at 10.0.0.1 flags 001f true x");
+
+    // Escaped braces, placeholders without arguments, arguments without placeholders
+    text.clear();
+    format::formatTo(text, "{{{}}} {} {}", 1u);
+    EXPECT_STREQ(text.c_str(), "{1} {} {}");
+    text.clear();
+    format::formatTo(text, "none", 1, 2);
+    EXPECT_STREQ(text.c_str(), "none");
+
+    char   buffer[16];
+    size_t length = format::formatTo(buffer, sizeof(buffer), "{}/{}", 1.5, static_cast<const char*>(nullptr));
+    EXPECT_STREQ(buffer, "1.5/(null)");
+    EXPECT_EQ(length, 10u);
+}
+
+TEST(TextFormatTest, TruncatesAtCapacity)
+{
+    format::fixedString<8> text;
+    format::formatTo(text, "{}-{}", 12345, 67890);
+    EXPECT_STREQ(text.c_str(), "12345-6");
+    EXPECT_EQ(text.length(), 7u);
+    EXPECT_TRUE(text.truncated());
+
+    // Copies keep their own buffer
+    format::fixedString<8> copy(text);
+    text.clear();
+    EXPECT_STREQ(copy.c_str(), "12345-6");
+    EXPECT_STREQ(text.c_str(), "");
+    EXPECT_FALSE(text.truncated());
+
+    char               small[4] = {'x', 'x', 'x', 'x'};
+    format::textWriter writer(small, sizeof(small));
+    format::appendHex(writer, "\x01\x02\x03", 3, ':');
+    EXPECT_STREQ(small, "01:");
+}
+
+TEST(TextFormatTest, PrintAppendsAndTruncates)
+{
+    format::fixedString<12> text;
+    text.print("%5.1f%%", 12.34);
+    text.print(" %s", "load");
+    EXPECT_STREQ(text.c_str(), " 12.3% load");
+    EXPECT_FALSE(text.truncated());
+
+    text.print("%d", 42);
+    EXPECT_STREQ(text.c_str(), " 12.3% load");
+    EXPECT_EQ(text.length(), 11u);
+    EXPECT_TRUE(text.truncated());
+
+    format::textWriter empty(nullptr, 0);
+    empty.print("%d", 1);
+    EXPECT_EQ(empty.length(), 0u);
+    EXPECT_TRUE(empty.truncated());
+}
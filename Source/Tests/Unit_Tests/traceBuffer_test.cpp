@@ -0,0 +1,131 @@
+#define TRACE_ENABLED 1
+
+#include "Library/Diagnostics/trace.h"
+#include "gtest/gtest.h"
+
+#include <string.h>
+#include <vector>
+
+namespace
+{
+const char* const testEvents[] = {"first", "second"};
+
+std::vector<uint8_t> serialize(traceBuffer& buffer)
+{
+    std::vector<uint8_t> dump;
+    EXPECT_TRUE(buffer.serialize(
+        [&dump](const void* data, size_t length)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            dump.insert(dump.end(), bytes, bytes + length);
+            return true;
+        }));
+    return dump;
+}
+} // namespace
+
+TEST(TraceBufferTest, RecordsAreSixteenBytes)
+{
+    EXPECT_EQ(sizeof(traceRecord_t), 16u);
+}
+
+TEST(TraceBufferTest, RecordsInOrder)
+{
+    traceRecord_t storage[8];
+    traceBuffer   buffer(storage, 8, 1, testEvents, 2);
+
+    buffer.record(0, TRACE_PHASE_BEGIN, 7);
+    buffer.record(1, TRACE_PHASE_INSTANT, 8);
+    buffer.record(0, TRACE_PHASE_END, 9);
+
+    traceRecord_t records[8];
+    ASSERT_EQ(buffer.getRecords(0, records, 8), 3u);
+    EXPECT_EQ(records[0].phase, TRACE_PHASE_BEGIN);
+    EXPECT_EQ(records[1].event, 1u);
+    EXPECT_EQ(records[2].arg, 9u);
+    EXPECT_EQ(records[0].task, records[2].task);
+    EXPECT_NE(records[0].task, 0u);
+    EXPECT_LE(static_cast<int32_t>(records[0].cycles - records[2].cycles), 0);
+}
+
+TEST(TraceBufferTest, FullRingKeepsNewest)
+{
+    traceRecord_t storage[4];
+    traceBuffer   buffer(storage, 4, 1, testEvents, 2);
+
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        buffer.record(0, TRACE_PHASE_INSTANT, i);
+    }
+
+    traceRecord_t records[4];
+    ASSERT_EQ(buffer.getRecords(0, records, 4), 4u);
+    EXPECT_EQ(records[0].arg, 6u);
+    EXPECT_EQ(records[3].arg, 9u);
+
+    buffer.setEnabled(false);
+    buffer.record(0, TRACE_PHASE_INSTANT, 10);
+    buffer.getRecords(0, records, 4);
+    EXPECT_EQ(records[3].arg, 9u);
+
+    buffer.clear();
+    EXPECT_EQ(buffer.getRecordCount(0), 0u);
+}
+
+TEST(TraceBufferTest, SerializeLayout)
+{
+    traceRecord_t storage[4];
+    traceBuffer   buffer(storage, 4, 1, testEvents, 2);
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        buffer.record(1, TRACE_PHASE_INSTANT, i);
+    }
+
+    std::vector<uint8_t> dump = serialize(buffer);
+    traceDumpHeader_t    header;
+    ASSERT_GE(dump.size(), sizeof(header));
+    memcpy(&header, dump.data(), sizeof(header));
+    EXPECT_EQ(header.magic, static_cast<uint32_t>(TRACE_DUMP_MAGIC));
+    EXPECT_EQ(header.cores, 1u);
+    EXPECT_EQ(header.eventCount, 2u);
+    EXPECT_EQ(header.dropped, 2u);
+
+    size_t offset = sizeof(header);
+    EXPECT_STREQ(reinterpret_cast<const char*>(&dump[offset]), "first");
+    offset += strlen("first") + 1;
+    EXPECT_STREQ(reinterpret_cast<const char*>(&dump[offset]), "second");
+    offset += strlen("second") + 1;
+
+    uint32_t count = 0;
+    memcpy(&count, &dump[offset], sizeof(count));
+    offset += sizeof(count);
+    ASSERT_EQ(count, 4u);
+    ASSERT_EQ(dump.size(), offset + count * sizeof(traceRecord_t));
+
+    // The wrapped ring comes out oldest first
+    traceRecord_t record;
+    memcpy(&record, &dump[offset], sizeof(record));
+    EXPECT_EQ(record.arg, 2u);
+    memcpy(&record, &dump[offset + 3 * sizeof(record)], sizeof(record));
+    EXPECT_EQ(record.arg, 5u);
+    EXPECT_TRUE(buffer.isEnabled());
+}
+
+TEST(TraceBufferTest, MacrosUseSystemTrace)
+{
+    tracer().clear();
+    {
+        TRACE_SCOPE(HTTP_WELCOME, 1);
+        TRACE_ASYNC_BEGIN(GPIO_LATENCY, 4);
+    }
+    TRACE_ASYNC_END(GPIO_LATENCY, 4);
+
+    traceRecord_t records[4];
+    ASSERT_EQ(tracer().getRecords(0, records, 4), 4u);
+    EXPECT_EQ(records[0].event, TRACE_EVENT_HTTP_WELCOME);
+    EXPECT_EQ(records[1].phase, TRACE_PHASE_ASYNC_BEGIN);
+    EXPECT_EQ(records[2].phase, TRACE_PHASE_END);
+    EXPECT_EQ(records[3].arg, 4u);
+    EXPECT_STREQ(traceEventName(TRACE_EVENT_GPIO_LATENCY), "io_gpio.isr_to_listener");
+    EXPECT_STREQ(traceEventName(TRACE_EVENT_MAX), "unknown");
+}
@@ -0,0 +1,57 @@
+#include "Library/UI/HTTP/ui_routes.h"
+#include "gtest/gtest.h"
+
+#include <string.h>
+#include <string>
+
+TEST(UiRoutesTest, FormValues)
+{
+    const char* form   = "ssid=home&password=secret&empty=";
+    size_t      length = strlen(form);
+    char        value[8];
+
+    EXPECT_TRUE(uiFormValue(form, length, "ssid", value, sizeof(value)));
+    EXPECT_STREQ(value, "home");
+    EXPECT_TRUE(uiFormValue(form, length, "empty", value, sizeof(value)));
+    EXPECT_STREQ(value, "");
+    EXPECT_FALSE(uiFormValue(form, length, "pass", value, sizeof(value)));
+    EXPECT_FALSE(uiFormValue(form, length, "id", value, sizeof(value)));
+
+    // Values that do not fit are not found, like httpd_query_key_value()
+    EXPECT_FALSE(uiFormValue(form, length, "password", value, 6));
+    EXPECT_TRUE(uiFormValue(form, length, "password", value, 7));
+
+    // Only the given length is looked at
+    EXPECT_FALSE(uiFormValue(form, 9, "password", value, sizeof(value)));
+}
+
+TEST(UiRoutesTest, ConnectNeedsBothFields)
+{
+    uiCredentials_t   credentials;
+    std::string       form     = "ssid=home&password=secret";
+    uiRouteResponse_t response = uiConnectRoute(form.data(), form.size(), credentials);
+    EXPECT_EQ(response.status, 200);
+    EXPECT_STREQ(response.body, "Connected");
+    EXPECT_STREQ(credentials.ssid, "home");
+    EXPECT_STREQ(credentials.password, "secret");
+
+    form = "ssid=home";
+    EXPECT_EQ(uiConnectRoute(form.data(), form.size(), credentials).status, 500);
+
+    form = "ssid=home&password=" + std::string(UI_CONNECT_FORM_SIZE, 'x');
+    EXPECT_EQ(uiConnectRoute(form.data(), form.size(), credentials).status, 500);
+}
+
+TEST(UiRoutesTest, CtrlTogglesRoutes)
+{
+    bool enabled = true;
+    EXPECT_EQ(uiCtrlRoute("0", 1, enabled).status, 200);
+    EXPECT_FALSE(enabled);
+    EXPECT_EQ(uiCtrlRoute("1", 1, enabled).status, 200);
+    EXPECT_TRUE(enabled);
+    EXPECT_EQ(uiCtrlRoute("", 0, enabled).status, 400);
+    EXPECT_TRUE(enabled);
+
+    EXPECT_EQ(uiWelcomeRoute().status, 200);
+    EXPECT_NE(strstr(uiWelcomeRoute().body, "<html>"), nullptr);
+}
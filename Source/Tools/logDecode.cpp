@@ -0,0 +1,95 @@
+/**
+ * @file logDecode.cpp
+ * @brief Log store decoder
+ *
+ * Prints the records of a logStore image as text, oldest first, e.g. of the log partition read back from a device
+ * with "esptool.py read_flash <offset> <size> log.bin". The layout options must match the logStore on the device.
+ * Exits with 1 when a block could not be decoded, the other blocks are still printed.
+ *
+ * log_decode --image FILE [--base ADDRESS] --segment-size BYTES --segments N [--sector-size BYTES] [--stats]
+ */
+
+#include "HAL/Platform/Linux/mem_mmapFile.hpp"
+#include "Library/Storage/logStore.h"
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+int main(int argc, char** argv)
+{
+    const char* image        = nullptr;
+    uint32_t    baseAddress  = 0;
+    size_t      segmentSize  = 0;
+    size_t      segmentCount = 0;
+    size_t      sectorSize   = 4096;
+    bool        stats        = false;
+
+    static const struct option options[] = {
+        {"image", required_argument, nullptr, 'i'},
+        {"base", required_argument, nullptr, 'b'},
+        {"segment-size", required_argument, nullptr, 's'},
+        {"segments", required_argument, nullptr, 'n'},
+        {"sector-size", required_argument, nullptr, 'e'},
+        {"stats", no_argument, nullptr, 't'},
+        {nullptr, 0, nullptr, 0},
+    };
+
+    int option;
+    while ((option = getopt_long(argc, argv, "", options, nullptr)) != -1)
+    {
+        switch (option)
+        {
+            case 'i':
+                image = optarg;
+                break;
+            case 'b':
+                baseAddress = static_cast<uint32_t>(strtoul(optarg, nullptr, 0));
+                break;
+            case 's':
+                segmentSize = static_cast<size_t>(strtoul(optarg, nullptr, 0));
+                break;
+            case 'n':
+                segmentCount = static_cast<size_t>(strtoul(optarg, nullptr, 0));
+                break;
+            case 'e':
+                sectorSize = static_cast<size_t>(strtoul(optarg, nullptr, 0));
+                break;
+            case 't':
+                stats = true;
+                break;
+            default:
+                return 2;
+        }
+    }
+
+    struct stat fileStat;
+    if (image == nullptr || stat(image, &fileStat) != 0)
+    {
+        printf("Image could not be opened\n");
+        return 2;
+    }
+
+    // Mounting only reads, the image is left unchanged
+    mem_mmapFile memory(image, static_cast<size_t>(fileStat.st_size), sectorSize);
+    logStore     store(memory, baseAddress, segmentSize, segmentCount);
+    if (store.mount() != ERROR_SUCCESS)
+    {
+        printf("Log store could not be mounted, check the layout options\n");
+        return 2;
+    }
+
+    size_t      lines  = 0;
+    sys_error_t result = store.decode(
+        [&lines](const char* line, size_t length)
+        {
+            lines++;
+            return fwrite(line, 1, length, stdout) == length;
+        });
+    if (stats)
+    {
+        printf("%zu records, %s\n", lines, (result == ERROR_SUCCESS) ? "no errors" : "corrupted blocks skipped");
+    }
+    return (result == ERROR_SUCCESS) ? 0 : 1;
+}